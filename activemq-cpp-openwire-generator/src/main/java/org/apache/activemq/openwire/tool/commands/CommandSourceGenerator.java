@@ -183,7 +183,7 @@ public class CommandSourceGenerator extends CommandCodeGenerator {
         if (isHashable()) {
             out.println("////////////////////////////////////////////////////////////////////////////////");
             out.println("int " + getClassName() + "::getHashCode() const {");
-            out.println("    return decaf::util::HashCode<std::string>()(this->toString());");
+            generateHashCodeBody(out);
             out.println("}");
             out.println("");
         }
@@ -466,12 +466,20 @@ public class CommandSourceGenerator extends CommandCodeGenerator {
             }
             out.println("////////////////////////////////////////////////////////////////////////////////");
             out.println("void " + getClassName() + "::" + setter+"(" + constNess + type+ " " + parameterName +") {");
-            out.println("    this->"+parameterName+" = "+parameterName+";");
+            generateSetterBody(out, property, parameterName);
             out.println("}");
             out.println("");
         }
     }
 
+    protected void generateSetterBody( PrintWriter out, JProperty property, String parameterName ) {
+        out.println("    this->"+parameterName+" = "+parameterName+";");
+    }
+
+    protected void generateHashCodeBody( PrintWriter out ) {
+        out.println("    return decaf::util::HashCode<std::string>()(this->toString());");
+    }
+
     protected void generateCompareToBody( PrintWriter out ) {
         for( JProperty property : getProperties() ) {
 
@@ -490,7 +498,8 @@ public class CommandSourceGenerator extends CommandCodeGenerator {
                 out.println("    }");
                 out.println("");
             } else if( property.getType().getSimpleName().equals("String") ) {
-                out.println("    int "+parameterName+"Comp = StringUtils::compareIgnoreCase(this->"+parameterName+".c_str(), value."+parameterName+".c_str());");
+                out.println("    int "+parameterName+"Comp = this->"+parameterName+" == value."+parameterName+" ? 0 :");
+                out.println("        StringUtils::compareIgnoreCase(this->"+parameterName+".c_str(), value."+parameterName+".c_str());");
                 out.println("    if ("+parameterName+"Comp != 0) {");
                 out.println("        return "+parameterName+"Comp;");
                 out.println("    }");
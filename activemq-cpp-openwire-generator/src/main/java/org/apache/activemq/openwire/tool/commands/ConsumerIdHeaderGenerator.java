@@ -23,6 +23,7 @@ public class ConsumerIdHeaderGenerator extends CommandHeaderGenerator {
 
     protected void populateIncludeFilesSet() {
         Set<String> includes = getIncludeFiles();
+        includes.add("<activemq/util/IdPrefix.h>");
         includes.add("<activemq/commands/SessionId.h>");
 
         super.populateIncludeFilesSet();
@@ -43,11 +44,31 @@ public class ConsumerIdHeaderGenerator extends CommandHeaderGenerator {
         out.println("");
         out.println("        mutable Pointer<SessionId> parentId;");
         out.println("");
+        out.println("        // Interned session prefix, formatted key and hash code.  They are built once all");
+        out.println("        // fields are known by the constructors, copyDataStructure and afterUnmarshal, the");
+        out.println("        // setters only discard them so the const accessors never write.  Edits made");
+        out.println("        // through the non-const getConnectionId no longer match the prefix.");
+        out.println("        Pointer<const activemq::util::IdPrefix> prefix;");
+        out.println("        std::string key;");
+        out.println("        int hashCode;");
+        out.println("");
+        out.println("        void updateKey();");
+        out.println("");
+        out.println("        bool isKeyCurrent() const;");
+        out.println("");
+        out.println("        std::string formatKey() const;");
+        out.println("");
+        out.println("        int computeHashCode() const;");
+        out.println("");
+        out.println("        friend class SessionId;");
+        out.println("");
     }
 
     protected void generateAdditonalMembers( PrintWriter out ) {
         out.println("        const Pointer<SessionId>& getParentId() const;");
         out.println("");
+        out.println("        virtual void afterUnmarshal(wireformat::WireFormat* wireFormat);");
+        out.println("");
 
         super.generateAdditonalMembers( out );
     }
@@ -19,6 +19,8 @@ package org.apache.activemq.openwire.tool.commands;
 import java.io.PrintWriter;
 import java.util.Set;
 
+import org.codehaus.jam.JProperty;
+
 public class ConsumerIdSourceGenerator extends CommandSourceGenerator {
 
     protected void generateAdditionalConstructors( PrintWriter out ) {
@@ -30,6 +32,9 @@ public class ConsumerIdSourceGenerator extends CommandSourceGenerator {
         out.println("    this->connectionId = sessionId.getConnectionId();");
         out.println("    this->sessionId = sessionId.getValue();");
         out.println("    this->value = consumerId;");
+        out.println("");
+        out.println("    this->prefix = sessionId.prefix;");
+        out.println("    this->updateKey();");
         out.println("}");
         out.println("");
 
@@ -37,7 +42,7 @@ public class ConsumerIdSourceGenerator extends CommandSourceGenerator {
     }
 
     protected String generateInitializerList() {
-        return super.generateInitializerList() + ", parentId()";
+        return super.generateInitializerList() + ", parentId(), prefix(), key(\"\"), hashCode(0)";
     }
 
     protected void generateAdditionalMethods( PrintWriter out ) {
@@ -50,6 +55,38 @@ public class ConsumerIdSourceGenerator extends CommandSourceGenerator {
         out.println("}");
         out.println("");
 
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("void ConsumerId::afterUnmarshal(wireformat::WireFormat* wireFormat AMQCPP_UNUSED) {");
+        out.println("    this->updateKey();");
+        out.println("}");
+        out.println("");
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("void ConsumerId::updateKey() {");
+        out.println("");
+        out.println("    if (this->prefix == NULL || !this->prefix->matches(this->connectionId, this->sessionId)) {");
+        out.println("        this->prefix = activemq::util::IdPrefixTable::intern(this->connectionId, this->sessionId);");
+        out.println("    }");
+        out.println("");
+        out.println("    this->key = this->prefix->formatKey(this->value);");
+        out.println("    this->hashCode = this->prefix->hashKey(this->value);");
+        out.println("}");
+        out.println("");
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("bool ConsumerId::isKeyCurrent() const {");
+        out.println("    return this->prefix != NULL && this->prefix->matches(this->connectionId, this->sessionId);");
+        out.println("}");
+        out.println("");
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("std::string ConsumerId::formatKey() const {");
+        out.println("    return activemq::util::IdPrefix(this->connectionId, this->sessionId).formatKey(this->value);");
+        out.println("}");
+        out.println("");
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("int ConsumerId::computeHashCode() const {");
+        out.println("    return activemq::util::IdPrefix(this->connectionId, this->sessionId).hashKey(this->value);");
+        out.println("}");
+        out.println("");
+
         super.generateAdditionalMethods(out);
     }
 
@@ -58,17 +95,42 @@ public class ConsumerIdSourceGenerator extends CommandSourceGenerator {
         super.populateIncludeFilesSet();
 
         Set<String> includes = getIncludeFiles();
-        includes.add("<sstream>");
+        includes.add("<activemq/util/IdPrefixTable.h>");
+        includes.add("<decaf/lang/Long.h>");
     }
 
     protected void generateToStringBody( PrintWriter out ) {
-        out.println("    ostringstream stream;" );
+        out.println("    if (this->isKeyCurrent()) {");
+        out.println("        return this->key;");
+        out.println("    }");
+        out.println("");
+        out.println("    return this->formatKey();");
+    }
+
+    protected void generateSetterBody( PrintWriter out, JProperty property, String parameterName ) {
+        super.generateSetterBody(out, property, parameterName);
+        out.println("    this->prefix.reset();");
+    }
+
+    protected void generateCopyDataStructureBody( PrintWriter out ) {
+        super.generateCopyDataStructureBody(out);
+        out.println("");
+        out.println("    if (srcPtr->isKeyCurrent()) {");
+        out.println("        this->prefix = srcPtr->prefix;");
+        out.println("        this->key = srcPtr->key;");
+        out.println("        this->hashCode = srcPtr->hashCode;");
+        out.println("    } else {");
+        out.println("        this->updateKey();");
+        out.println("    }");
+    }
+
+    protected void generateHashCodeBody( PrintWriter out ) {
         out.println("");
-        out.println("    stream << this->connectionId << \":\"");
-        out.println("           << this->sessionId << \":\"");
-        out.println("           << this->value;");
+        out.println("    if (this->isKeyCurrent()) {");
+        out.println("        return this->hashCode;");
+        out.println("    }");
         out.println("");
-        out.println("    return stream.str();");
+        out.println("    return this->computeHashCode();");
     }
 
 }
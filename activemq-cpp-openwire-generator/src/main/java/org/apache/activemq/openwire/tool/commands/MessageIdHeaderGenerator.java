@@ -49,13 +49,28 @@ public class MessageIdHeaderGenerator extends CommandHeaderGenerator {
 
         out.println("    private:");
         out.println("");
-        out.println("        mutable std::string key;");
+        out.println("        // Formatted key and hash code, built from the producer id's key once all fields");
+        out.println("        // are known by the constructors, copyDataStructure, setValue and afterUnmarshal,");
+        out.println("        // the setters only discard them so the const accessors never write.  They are");
+        out.println("        // only used while the key still starts with the producer id's current key.");
+        out.println("        std::string key;");
+        out.println("        int hashCode;");
+        out.println("");
+        out.println("        void updateKey();");
+        out.println("");
+        out.println("        bool isKeyCurrent() const;");
+        out.println("");
+        out.println("        std::string formatKey() const;");
+        out.println("");
+        out.println("        int computeHashCode() const;");
         out.println("");
     }
 
     protected void generateAdditonalMembers( PrintWriter out ) {
         out.println("        void setValue(const std::string& key);");
         out.println("");
+        out.println("        virtual void afterUnmarshal(wireformat::WireFormat* wireFormat);");
+        out.println("");
 
         super.generateAdditonalMembers( out );
     }
@@ -19,6 +19,8 @@ package org.apache.activemq.openwire.tool.commands;
 import java.io.PrintWriter;
 import java.util.Set;
 
+import org.codehaus.jam.JProperty;
+
 public class MessageIdSourceGenerator extends CommandSourceGenerator {
 
     protected void generateAdditionalConstructors( PrintWriter out ) {
@@ -36,6 +38,8 @@ public class MessageIdSourceGenerator extends CommandSourceGenerator {
         out.println("");
         out.println("    this->producerId = producerInfo->getProducerId();");
         out.println("    this->producerSequenceId = producerSequenceId;");
+        out.println("");
+        out.println("    this->updateKey();");
         out.println("}");
         out.println("");
         out.println("////////////////////////////////////////////////////////////////////////////////");
@@ -44,6 +48,8 @@ public class MessageIdSourceGenerator extends CommandSourceGenerator {
         out.println("");
         out.println("    this->producerId = producerId;");
         out.println("    this->producerSequenceId = producerSequenceId;");
+        out.println("");
+        out.println("    this->updateKey();");
         out.println("}");
         out.println("");
         out.println("////////////////////////////////////////////////////////////////////////////////");
@@ -52,16 +58,14 @@ public class MessageIdSourceGenerator extends CommandSourceGenerator {
         out.println("");
         out.println("    this->producerId.reset(new ProducerId(producerId));");
         out.println("    this->producerSequenceId = producerSequenceId;");
+        out.println("");
+        out.println("    this->updateKey();");
         out.println("}");
         out.println("");
 
         super.generateAdditionalConstructors(out);
     }
 
-    protected String generateInitializerList() {
-        return super.generateInitializerList() + ", key(\"\")";
-    }
-
     protected void generateAdditionalMethods( PrintWriter out ) {
         out.println("////////////////////////////////////////////////////////////////////////////////");
         out.println("void MessageId::setValue(const std::string& key) {");
@@ -77,7 +81,59 @@ public class MessageIdSourceGenerator extends CommandSourceGenerator {
         out.println("    }");
         out.println("");
         out.println("    this->producerId.reset(new ProducerId(messageKey));");
-        out.println("    this->key = messageKey;");
+        out.println("    this->updateKey();");
+        out.println("}");
+        out.println("");
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("void MessageId::afterUnmarshal(wireformat::WireFormat* wireFormat AMQCPP_UNUSED) {");
+        out.println("    this->updateKey();");
+        out.println("}");
+        out.println("");
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("void MessageId::updateKey() {");
+        out.println("");
+        out.println("    if (this->producerId == NULL || !this->textView.empty()) {");
+        out.println("        this->key.clear();");
+        out.println("        return;");
+        out.println("    }");
+        out.println("");
+        out.println("    this->key = this->formatKey();");
+        out.println("    this->hashCode = this->computeHashCode();");
+        out.println("}");
+        out.println("");
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("bool MessageId::isKeyCurrent() const {");
+        out.println("");
+        out.println("    if (this->key.empty() || this->producerId == NULL || !this->producerId->isKeyCurrent()) {");
+        out.println("        return false;");
+        out.println("    }");
+        out.println("");
+        out.println("    const std::string& producerKey = this->producerId->key;");
+        out.println("    return this->key.length() > producerKey.length() && this->key[producerKey.length()] == ':' &&");
+        out.println("           this->key.compare(0, producerKey.length(), producerKey) == 0;");
+        out.println("}");
+        out.println("");
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("std::string MessageId::formatKey() const {");
+        out.println("");
+        out.println("    std::string sequence = Long::toString(this->producerSequenceId);");
+        out.println("");
+        out.println("    std::string result;");
+        out.println("    if (this->producerId->isKeyCurrent()) {");
+        out.println("        result.reserve(this->producerId->key.length() + sequence.length() + 1);");
+        out.println("        result.append(this->producerId->key);");
+        out.println("    } else {");
+        out.println("        result = this->producerId->toString();");
+        out.println("    }");
+        out.println("    result.append(1, ':').append(sequence);");
+        out.println("");
+        out.println("    return result;");
+        out.println("}");
+        out.println("");
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("int MessageId::computeHashCode() const {");
+        out.println("    int result = this->producerId->getHashCode();");
+        out.println("    return 31 * result + decaf::util::HashCode<long long>()(this->producerSequenceId);");
         out.println("}");
         out.println("");
 
@@ -90,24 +146,60 @@ public class MessageIdSourceGenerator extends CommandSourceGenerator {
 
         Set<String> includes = getIncludeFiles();
         includes.add("<decaf/lang/Long.h>");
-        includes.add("<sstream>");
     }
 
     protected void generateToStringBody( PrintWriter out ) {
-        out.println("    if (key.empty()) {");
-        out.println("        if (!textView.empty()) {");
-        out.println("            if (textView.find_first_of(\"ID:\") == 0) {");
-        out.println("                key = textView;");
-        out.println("            } else {");
-        out.println("                key = \"ID:\" + textView;");
-        out.println("            }");
+        out.println("    if (!textView.empty()) {");
+        out.println("        if (textView.find_first_of(\"ID:\") == 0) {");
+        out.println("            return textView;");
         out.println("        } else {");
-        out.println("            this->key = this->producerId->toString() + \":\" + ");
-        out.println("                        Long::toString(this->producerSequenceId);");
+        out.println("            return \"ID:\" + textView;");
+        out.println("        }");
+        out.println("    }");
+        out.println("");
+        out.println("    if (this->isKeyCurrent()) {");
+        out.println("        return this->key;");
+        out.println("    }");
+        out.println("");
+        out.println("    return this->formatKey();");
+    }
+
+    protected String generateInitializerList() {
+        return super.generateInitializerList() + ", key(\"\"), hashCode(0)";
+    }
+
+    protected void generateSetterBody( PrintWriter out, JProperty property, String parameterName ) {
+        super.generateSetterBody(out, property, parameterName);
+
+        // The broker sequence isn't part of the key.
+        if (!property.getSimpleName().equals("BrokerSequenceId")) {
+            out.println("    this->key.clear();");
+        }
+    }
+
+    protected void generateCopyDataStructureBody( PrintWriter out ) {
+        super.generateCopyDataStructureBody(out);
+        out.println("");
+        out.println("    if (srcPtr->isKeyCurrent()) {");
+        out.println("        this->key = srcPtr->key;");
+        out.println("        this->hashCode = srcPtr->hashCode;");
+        out.println("    } else {");
+        out.println("        this->updateKey();");
+        out.println("    }");
+    }
+
+    protected void generateHashCodeBody( PrintWriter out ) {
+        out.println("");
+        out.println("    if (this->producerId != NULL && this->textView.empty()) {");
+        out.println("");
+        out.println("        if (this->isKeyCurrent()) {");
+        out.println("            return this->hashCode;");
         out.println("        }");
+        out.println("");
+        out.println("        return this->computeHashCode();");
         out.println("    }");
         out.println("");
-        out.println("    return this->key;");
+        out.println("    return decaf::util::HashCode<std::string>()(this->toString());");
     }
 
 }
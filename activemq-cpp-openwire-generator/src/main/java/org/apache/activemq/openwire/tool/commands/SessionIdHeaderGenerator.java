@@ -23,6 +23,7 @@ public class SessionIdHeaderGenerator extends CommandHeaderGenerator {
 
     protected void populateIncludeFilesSet() {
         Set<String> includes = getIncludeFiles();
+        includes.add("<activemq/util/IdPrefix.h>");
         includes.add("<activemq/commands/ConnectionId.h>");
 
         super.populateIncludeFilesSet();
@@ -54,11 +55,30 @@ public class SessionIdHeaderGenerator extends CommandHeaderGenerator {
         out.println("");
         out.println("        mutable Pointer<ConnectionId> parentId;");
         out.println("");
+        out.println("        // Interned prefix, which is this id's key and hash code.  It is found once all");
+        out.println("        // fields are known by the constructors, copyDataStructure and afterUnmarshal, the");
+        out.println("        // setters only discard it so the const accessors never write.  Edits made");
+        out.println("        // through the non-const getConnectionId no longer match the prefix.");
+        out.println("        Pointer<const activemq::util::IdPrefix> prefix;");
+        out.println("");
+        out.println("        void updateKey();");
+        out.println("");
+        out.println("        bool isKeyCurrent() const;");
+        out.println("");
+        out.println("        std::string formatKey() const;");
+        out.println("");
+        out.println("        int computeHashCode() const;");
+        out.println("");
+        out.println("        friend class ProducerId;");
+        out.println("        friend class ConsumerId;");
+        out.println("");
     }
 
     protected void generateAdditonalMembers( PrintWriter out ) {
         out.println("        const Pointer<ConnectionId>& getParentId() const;");
         out.println("");
+        out.println("        virtual void afterUnmarshal(wireformat::WireFormat* wireFormat);");
+        out.println("");
 
         super.generateAdditonalMembers( out );
     }
@@ -19,6 +19,8 @@ package org.apache.activemq.openwire.tool.commands;
 import java.io.PrintWriter;
 import java.util.Set;
 
+import org.codehaus.jam.JProperty;
+
 public class SessionIdSourceGenerator extends CommandSourceGenerator {
 
     protected void populateIncludeFilesSet() {
@@ -26,21 +28,46 @@ public class SessionIdSourceGenerator extends CommandSourceGenerator {
         includes.add("<activemq/commands/ProducerId.h>");
         includes.add("<activemq/commands/ConsumerId.h>");
         includes.add("<activemq/commands/ConnectionId.h>");
-        includes.add("<sstream>");
+        includes.add("<activemq/util/IdPrefixTable.h>");
+        includes.add("<decaf/lang/Long.h>");
 
         super.populateIncludeFilesSet();
     }
 
     protected void generateToStringBody( PrintWriter out ) {
-        out.println("    ostringstream stream;" );
+        out.println("    if (this->isKeyCurrent()) {");
+        out.println("        return this->prefix->getText();");
+        out.println("    }");
         out.println("");
-        out.println("    stream << this->connectionId << \":\" << this->value;");
+        out.println("    return this->formatKey();");
+    }
+
+    protected void generateSetterBody( PrintWriter out, JProperty property, String parameterName ) {
+        super.generateSetterBody(out, property, parameterName);
+        out.println("    this->prefix.reset();");
+    }
+
+    protected void generateCopyDataStructureBody( PrintWriter out ) {
+        super.generateCopyDataStructureBody(out);
         out.println("");
-        out.println("    return stream.str();");
+        out.println("    if (srcPtr->isKeyCurrent()) {");
+        out.println("        this->prefix = srcPtr->prefix;");
+        out.println("    } else {");
+        out.println("        this->updateKey();");
+        out.println("    }");
+    }
+
+    protected void generateHashCodeBody( PrintWriter out ) {
+        out.println("");
+        out.println("    if (this->isKeyCurrent()) {");
+        out.println("        return this->prefix->getHashCode();");
+        out.println("    }");
+        out.println("");
+        out.println("    return this->computeHashCode();");
     }
 
     protected String generateInitializerList() {
-        return super.generateInitializerList() + ", parentId()";
+        return super.generateInitializerList() + ", parentId(), prefix()";
     }
 
     protected void generateAdditionalConstructors( PrintWriter out ) {
@@ -51,6 +78,8 @@ public class SessionIdSourceGenerator extends CommandSourceGenerator {
         out.println("");
         out.println("    this->connectionId = connectionId->getValue();");
         out.println("    this->value = sessionId;");
+        out.println("");
+        out.println("    this->updateKey();");
         out.println("}");
         out.println("");
         out.println("////////////////////////////////////////////////////////////////////////////////");
@@ -59,6 +88,9 @@ public class SessionIdSourceGenerator extends CommandSourceGenerator {
         out.println("");
         out.println("    this->connectionId = producerId->getConnectionId();");
         out.println("    this->value = producerId->getSessionId();");
+        out.println("");
+        out.println("    this->prefix = producerId->prefix;");
+        out.println("    this->updateKey();");
         out.println("}");
         out.println("");
         out.println("////////////////////////////////////////////////////////////////////////////////");
@@ -67,6 +99,9 @@ public class SessionIdSourceGenerator extends CommandSourceGenerator {
         out.println("");
         out.println("    this->connectionId = consumerId->getConnectionId();");
         out.println("    this->value = consumerId->getSessionId();");
+        out.println("");
+        out.println("    this->prefix = consumerId->prefix;");
+        out.println("    this->updateKey();");
         out.println("}");
         out.println("");
 
@@ -83,6 +118,35 @@ public class SessionIdSourceGenerator extends CommandSourceGenerator {
         out.println("}");
         out.println("");
 
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("void SessionId::afterUnmarshal(wireformat::WireFormat* wireFormat AMQCPP_UNUSED) {");
+        out.println("    this->updateKey();");
+        out.println("}");
+        out.println("");
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("void SessionId::updateKey() {");
+        out.println("");
+        out.println("    if (this->prefix == NULL || !this->prefix->matches(this->connectionId, this->value)) {");
+        out.println("        this->prefix = activemq::util::IdPrefixTable::intern(this->connectionId, this->value);");
+        out.println("    }");
+        out.println("}");
+        out.println("");
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("bool SessionId::isKeyCurrent() const {");
+        out.println("    return this->prefix != NULL && this->prefix->matches(this->connectionId, this->value);");
+        out.println("}");
+        out.println("");
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("std::string SessionId::formatKey() const {");
+        out.println("    return activemq::util::IdPrefix(this->connectionId, this->value).getText();");
+        out.println("}");
+        out.println("");
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("int SessionId::computeHashCode() const {");
+        out.println("    return activemq::util::IdPrefix(this->connectionId, this->value).getHashCode();");
+        out.println("}");
+        out.println("");
+
         super.generateAdditionalMethods(out);
     }
 
@@ -23,6 +23,7 @@ import org.codehaus.jam.JClass;
 import org.codehaus.jam.JProperty;
 
 import java.io.PrintWriter;
+import java.io.StringWriter;
 import java.util.ArrayList;
 import java.util.Collections;
 import java.util.Comparator;
@@ -43,6 +44,19 @@ public class AmqCppMarshallingClassesGenerator extends AmqCppMarshallingHeadersG
         return className;
     }
 
+    /**
+     * Checks if the class is one of the ids that build their key and hash code
+     * once all fields are set, the unmarshal methods then call afterUnmarshal.
+     * @returns true if the unmarshal methods must call afterUnmarshal.
+     */
+    protected boolean isKeyedId() {
+
+        String name = jclass.getSimpleName();
+
+        return name.equals("SessionId") || name.equals("ProducerId") ||
+               name.equals("ConsumerId") || name.equals("MessageId");
+    }
+
     /**
      * Checks if the tightMarshal1 method needs an casted version of its
      * dataStructure argument and then returns true or false to indicate this
@@ -115,6 +129,22 @@ public class AmqCppMarshallingClassesGenerator extends AmqCppMarshallingHeadersG
         return false;
     }
 
+    /**
+     * Prints the given block of generated code with one less level of
+     * indentation, used to reuse the tight body generators for the fast path
+     * functions which have no try block around their bodies.
+     */
+    protected void printOutdented(PrintWriter out, String text) {
+
+        if( text.length() == 0 ) {
+            return;
+        }
+
+        for( String line : text.split("\\r?\\n") ) {
+            out.println( line.startsWith("    ") ? line.substring(4) : line );
+        }
+    }
+
     //////////////////////////////////////////////////////////////////////////////////////
     // This section is for the tight wire format encoding generator
     //////////////////////////////////////////////////////////////////////////////////////
@@ -619,6 +649,7 @@ out.println("");
 
     List<JProperty> properties = getProperties();
     boolean marshallerAware = isMarshallerAware();
+    boolean keyedId = isKeyedId();
     if( !properties.isEmpty() || marshallerAware ) {
 
         String properClassName = getProperClassName( jclass.getSimpleName() );
@@ -639,7 +670,7 @@ out.println("");
 
     generateTightUnmarshalBody(out);
 
-    if( marshallerAware ) {
+    if( marshallerAware || keyedId ) {
 out.println("");
 out.println("        info->afterUnmarshal( wireFormat );");
     }
@@ -715,6 +746,69 @@ out.println("    }");
 out.println("    AMQ_CATCH_RETHROW(decaf::io::IOException)" );
 out.println("    AMQ_CATCH_EXCEPTION_CONVERT( exceptions::ActiveMQException, decaf::io::IOException)" );
 out.println("    AMQ_CATCHALL_THROW(decaf::io::IOException)" );
+out.println("}");
+out.println("");
+out.println("///////////////////////////////////////////////////////////////////////////////");
+out.println("void "+className+"::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {");
+out.println("");
+out.println("    "+baseClass+"::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);");
+out.println("");
+
+    if( !properties.isEmpty() || marshallerAware ) {
+
+        String properClassName = getProperClassName( jclass.getSimpleName() );
+out.println("    "+properClassName+"* info =");
+out.println("        static_cast<"+properClassName+"*>(dataStructure);");
+    }
+
+    if( marshallerAware ) {
+out.println("    info->beforeUnmarshal(wireFormat);");
+out.println("");
+    }
+
+    if( checkNeedsWireFormatVersion() ) {
+        out.println("");
+        out.println("    int wireVersion = wireFormat->getVersion();");
+        out.println("");
+    }
+
+    StringWriter fastUnmarshalBody = new StringWriter();
+    generateTightUnmarshalBody(new PrintWriter(fastUnmarshalBody, true));
+    printOutdented(out, fastUnmarshalBody.toString());
+
+    if( marshallerAware || keyedId ) {
+out.println("");
+out.println("    info->afterUnmarshal( wireFormat );");
+    }
+
+out.println("}");
+out.println("");
+out.println("///////////////////////////////////////////////////////////////////////////////");
+out.println("void "+className+"::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {");
+out.println("");
+out.println("    "+baseClass+"::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);");
+out.println("");
+
+    if( checkNeedsInfoPointerTM2() ) {
+        String properClassName = getProperClassName( jclass.getSimpleName() );
+out.println("    "+properClassName+"* info =");
+out.println("        static_cast<"+properClassName+"*>(dataStructure);");
+    }
+
+    if( checkNeedsWireFormatVersion() ) {
+        out.println("");
+        out.println("    int wireVersion = wireFormat->getVersion();");
+        out.println("");
+    }
+
+    StringWriter fastMarshal2Body = new StringWriter();
+    generateTightMarshal2Body(new PrintWriter(fastMarshal2Body, true));
+    printOutdented(out, fastMarshal2Body.toString());
+
+    if( marshallerAware ) {
+out.println("    info->afterMarshal(wireFormat);");
+    }
+
 out.println("}");
 out.println("");
 out.println("///////////////////////////////////////////////////////////////////////////////");
@@ -742,7 +836,7 @@ out.println("        info->beforeUnmarshal(wireFormat);");
 
     generateLooseUnmarshalBody(out);
 
-    if( marshallerAware ) {
+    if( marshallerAware || keyedId ) {
 out.println("        info->afterUnmarshal(wireFormat);");
     }
 
@@ -828,7 +922,8 @@ out.println("void MarshallerFactory::configure(OpenWireFormat* format) {");
 out.println("");
 
         for ( JClass jclass : list ) {
-out.println("    format->addMarshaller(new "+jclass.getSimpleName()+"Marshaller());");
+        String marshaller = jclass.getSimpleName()+"Marshaller";
+out.println("    format->addMarshaller(new "+marshaller+"(), &"+marshaller+"::fastTightUnmarshal, &"+marshaller+"::fastTightMarshal2);");
         }
 
 out.println("}");
@@ -243,6 +243,8 @@ out.println("#include <activemq/util/Config.h>");
 out.println("#include <activemq/commands/DataStructure.h>");
 out.println("#include <activemq/wireformat/openwire/OpenWireFormat.h>");
 out.println("#include <activemq/wireformat/openwire/utils/BooleanStream.h>");
+out.println("#include <activemq/wireformat/openwire/utils/FrameReader.h>");
+out.println("#include <activemq/wireformat/openwire/utils/FrameWriter.h>");
 out.println("");
 out.println("namespace activemq {");
 out.println("namespace wireformat {");
@@ -285,6 +287,16 @@ out.println("                                   commands::DataStructure* dataStr
 out.println("                                   decaf::io::DataOutputStream* dataOut,");
 out.println("                                   utils::BooleanStream* bs);");
 out.println("");
+out.println("        static void fastTightUnmarshal(OpenWireFormat* wireFormat,");
+out.println("                                       commands::DataStructure* dataStructure,");
+out.println("                                       utils::FrameReader* dataIn,");
+out.println("                                       utils::BooleanStream* bs);");
+out.println("");
+out.println("        static void fastTightMarshal2(OpenWireFormat* wireFormat,");
+out.println("                                      commands::DataStructure* dataStructure,");
+out.println("                                      utils::FrameWriter* dataOut,");
+out.println("                                      utils::BooleanStream* bs);");
+out.println("");
 out.println("        virtual void looseUnmarshal(OpenWireFormat* wireFormat,");
 out.println("                                    commands::DataStructure* dataStructure,");
 out.println("                                    decaf::io::DataInputStream* dataIn);");
@@ -71,6 +71,10 @@ namespace cmsutil {
             return consumer->receiveNoWait();
         }
 
+        virtual std::vector<cms::Message*> receiveBatch(int maxMessages, int millisecs) {
+            return consumer->receiveBatch(maxMessages, millisecs);
+        }
+
         virtual void setMessageListener(cms::MessageListener* listener) {
             consumer->setMessageListener(listener);
         }
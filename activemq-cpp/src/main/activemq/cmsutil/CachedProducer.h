@@ -131,6 +131,22 @@ namespace cmsutil {
             return producer->getMessageTransformer();
         }
 
+        virtual bool trySend(cms::Message* message) {
+            return producer->trySend(message);
+        }
+
+        virtual bool trySend(const cms::Destination* destination, cms::Message* message) {
+            return producer->trySend(destination, message);
+        }
+
+        virtual void setProducerWindowListener(cms::ProducerWindowListener* listener) {
+            producer->setProducerWindowListener(listener);
+        }
+
+        virtual cms::ProducerWindowListener* getProducerWindowListener() const {
+            return producer->getProducerWindowListener();
+        }
+
     };
 
 }}
@@ -0,0 +1,1279 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PooledConnectionFactory.h"
+
+#include <activemq/cmsutil/PooledSession.h>
+#include <activemq/cmsutil/ResourceLifecycleManager.h>
+#include <activemq/cmsutil/SessionPool.h>
+#include <activemq/core/ActiveMQConnection.h>
+#include <activemq/util/MetricsRegistry.h>
+#include <cms/CMSException.h>
+#include <cms/DeliveryMode.h>
+#include <cms/ExceptionListener.h>
+#include <cms/IllegalStateException.h>
+#include <cms/Message.h>
+#include <cms/MessageConsumer.h>
+#include <cms/MessageProducer.h>
+#include <decaf/lang/Pointer.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+
+#include <list>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::cmsutil;
+using namespace decaf::lang;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::atomic;
+
+/**
+ * A catch-all that throws an CMSException.
+ */
+#define POOLEDCONNECTIONFACTORY_CATCHALL() \
+    catch( cms::CMSException& ex ){ \
+        throw; \
+    } catch( ... ){ \
+        throw cms::CMSException("caught unknown exception", NULL); \
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    /**
+     * Counts a lease in the metrics of the leased connection when it is an
+     * ActiveMQConnection that has metrics enabled.
+     */
+    void recordLease(cms::Connection* connection, bool hit) {
+
+        activemq::core::ActiveMQConnection* amqConnection =
+            dynamic_cast<activemq::core::ActiveMQConnection*>(connection);
+
+        if (amqConnection != NULL) {
+            activemq::util::MetricsRegistry* metrics = amqConnection->getMetrics();
+            if (metrics != NULL) {
+                metrics->increment(hit ? activemq::util::MetricsRegistry::POOL_HITS :
+                                         activemq::util::MetricsRegistry::POOL_MISSES);
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const int PooledConnectionFactory::DEFAULT_MAX_CONNECTIONS = 1;
+const int PooledConnectionFactory::DEFAULT_MAXIMUM_ACTIVE_SESSION_PER_CONNECTION = 500;
+const long long PooledConnectionFactory::DEFAULT_IDLE_TIMEOUT = 30 * 1000;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace cmsutil {
+
+    /**
+     * One pooled connection slot.  The entries live as long as the factory so the
+     * lock free idle list can never reference a deleted entry, evicting a connection
+     * only closes it and leaves the entry empty for the next connection.
+     */
+    class ConnectionEntry : public cms::ExceptionListener {
+    private:
+
+        ConnectionEntry(const ConnectionEntry&);
+        ConnectionEntry& operator=(const ConnectionEntry&);
+
+    public:
+
+        static const int NUM_SESSION_POOLS = (int) cms::Session::INDIVIDUAL_ACKNOWLEDGE + 1;
+
+        PooledConnectionFactory* parent;
+
+        // Guards opening and closing the connection along with its key.
+        Mutex mutex;
+        std::string key;
+        cms::Connection* connection;
+        ResourceLifecycleManager* resources;
+        SessionPool* sessionPools[NUM_SESSION_POOLS];
+        long long closedSessionsCreated;
+        long long closedSessionsTaken;
+
+        AtomicInteger leases;
+        AtomicInteger activeSessions;
+        AtomicBoolean idle;
+        AtomicBoolean failed;
+        volatile long long lastUsed;
+
+        Mutex listenersMutex;
+        std::list<LeasedConnection*> listeners;
+
+    public:
+
+        ConnectionEntry(PooledConnectionFactory* parent) :
+            cms::ExceptionListener(), parent(parent), mutex(), key(), connection(NULL), resources(NULL),
+            closedSessionsCreated(0), closedSessionsTaken(0), leases(), activeSessions(), idle(),
+            failed(), lastUsed(0), listenersMutex(), listeners() {
+
+            for (int ix = 0; ix < NUM_SESSION_POOLS; ++ix) {
+                sessionPools[ix] = NULL;
+            }
+        }
+
+        virtual ~ConnectionEntry() {
+            try {
+                close();
+            } catch (...) {}
+        }
+
+        /**
+         * Takes over a new connection, must be called with the mutex held.
+         */
+        void open(const std::string& key, cms::Connection* connection) {
+
+            this->resources = new ResourceLifecycleManager();
+            this->resources->addConnection(connection);
+
+            for (int ix = 0; ix < NUM_SESSION_POOLS; ++ix) {
+                sessionPools[ix] = new SessionPool(connection, (cms::Session::AcknowledgeMode) ix, resources);
+            }
+
+            this->key = key;
+            this->connection = connection;
+            this->failed.set(false);
+            this->lastUsed = System::currentTimeMillis();
+            this->connection->setExceptionListener(this);
+        }
+
+        /**
+         * Closes the connection and everything created from it, must be called with
+         * the mutex held once the connection and its sessions are no longer leased.
+         */
+        void close() {
+
+            if (connection == NULL) {
+                return;
+            }
+
+            try {
+                connection->setExceptionListener(NULL);
+            } catch (...) {}
+
+            for (int ix = 0; ix < NUM_SESSION_POOLS; ++ix) {
+                closedSessionsCreated += sessionPools[ix]->getSessionsCreated();
+                closedSessionsTaken += sessionPools[ix]->getSessionsTaken();
+                delete sessionPools[ix];
+                sessionPools[ix] = NULL;
+            }
+
+            try {
+                resources->destroy();
+            } catch (...) {}
+
+            delete resources;
+            resources = NULL;
+            connection = NULL;
+            key.clear();
+            failed.set(false);
+        }
+
+        bool isEvictable(long long now, long long idleTimeout) const {
+            return connection != NULL && leases.get() == 0 && activeSessions.get() == 0 &&
+                   (failed.get() || (idleTimeout > 0 && now - lastUsed >= idleTimeout));
+        }
+
+        long long getSessionsCreated() const {
+            long long result = closedSessionsCreated;
+            for (int ix = 0; ix < NUM_SESSION_POOLS && connection != NULL; ++ix) {
+                result += sessionPools[ix]->getSessionsCreated();
+            }
+            return result;
+        }
+
+        long long getSessionsTaken() const {
+            long long result = closedSessionsTaken;
+            for (int ix = 0; ix < NUM_SESSION_POOLS && connection != NULL; ++ix) {
+                result += sessionPools[ix]->getSessionsTaken();
+            }
+            return result;
+        }
+
+        virtual void onException(const cms::CMSException& ex);
+
+    };
+
+    /**
+     * The resources created through a lease that are closed along with it.  Each resource
+     * shares the list so that one deleted first can remove itself from it.
+     */
+    class LeasedResources {
+    private:
+
+        Mutex mutex;
+        std::list<cms::Closeable*> resources;
+
+    private:
+
+        LeasedResources(const LeasedResources&);
+        LeasedResources& operator=(const LeasedResources&);
+
+    public:
+
+        LeasedResources() : mutex(), resources() {}
+
+        void add(cms::Closeable* resource) {
+            synchronized(&mutex) {
+                resources.push_back(resource);
+            }
+        }
+
+        /**
+         * Removes a resource that is being deleted, waits for a concurrent closeAll that
+         * may still be closing it.
+         */
+        void remove(cms::Closeable* resource) {
+            synchronized(&mutex) {
+                resources.remove(resource);
+            }
+        }
+
+        void closeAll() {
+            synchronized(&mutex) {
+                std::list<cms::Closeable*>::const_iterator iter = resources.begin();
+                for (; iter != resources.end(); ++iter) {
+                    try {
+                        (*iter)->close();
+                    } catch (...) {}
+                }
+                resources.clear();
+            }
+        }
+    };
+
+    /**
+     * A consumer created through a leased session, it is closed when the session is
+     * returned to the pool so that it stops receiving messages on the pooled session.
+     */
+    class LeasedConsumer : public cms::MessageConsumer {
+    private:
+
+        Pointer<LeasedResources> owner;
+        cms::MessageConsumer* consumer;
+
+    private:
+
+        LeasedConsumer(const LeasedConsumer&);
+        LeasedConsumer& operator=(const LeasedConsumer&);
+
+    public:
+
+        LeasedConsumer(Pointer<LeasedResources> owner, cms::MessageConsumer* consumer) :
+            cms::MessageConsumer(), owner(owner), consumer(consumer) {
+
+            owner->add(this);
+        }
+
+        virtual ~LeasedConsumer() {
+            owner->remove(this);
+            delete consumer;
+        }
+
+        virtual void close() {
+            consumer->close();
+        }
+
+        virtual void start() {
+            consumer->start();
+        }
+
+        virtual void stop() {
+            consumer->stop();
+        }
+
+        virtual cms::Message* receive() {
+            return consumer->receive();
+        }
+
+        virtual cms::Message* receive(int millisecs) {
+            return consumer->receive(millisecs);
+        }
+
+        virtual cms::Message* receiveNoWait() {
+            return consumer->receiveNoWait();
+        }
+
+        virtual std::vector<cms::Message*> receiveBatch(int maxMessages, int millisecs) {
+            return consumer->receiveBatch(maxMessages, millisecs);
+        }
+
+        virtual void setMessageListener(cms::MessageListener* listener) {
+            consumer->setMessageListener(listener);
+        }
+
+        virtual cms::MessageListener* getMessageListener() const {
+            return consumer->getMessageListener();
+        }
+
+        virtual std::string getMessageSelector() const {
+            return consumer->getMessageSelector();
+        }
+
+        virtual void setMessageTransformer(cms::MessageTransformer* transformer) {
+            consumer->setMessageTransformer(transformer);
+        }
+
+        virtual cms::MessageTransformer* getMessageTransformer() const {
+            return consumer->getMessageTransformer();
+        }
+
+        virtual void setMessageAvailableListener(cms::MessageAvailableListener* listener) {
+            consumer->setMessageAvailableListener(listener);
+        }
+
+        virtual cms::MessageAvailableListener* getMessageAvailableListener() const {
+            return consumer->getMessageAvailableListener();
+        }
+    };
+
+    /**
+     * A lease's view of a producer cached by the pooled session.  The settings belong to
+     * the lease and are passed with every send, so they never change the cached producer
+     * that the session's next lease gets.
+     */
+    class LeasedProducer : public cms::MessageProducer {
+    private:
+
+        cms::MessageProducer* producer;
+        int deliveryMode;
+        int priority;
+        long long timeToLive;
+        bool disableMessageID;
+        bool disableMessageTimeStamp;
+        cms::MessageTransformer* transformer;
+        cms::ProducerWindowListener* windowListener;
+
+    private:
+
+        LeasedProducer(const LeasedProducer&);
+        LeasedProducer& operator=(const LeasedProducer&);
+
+        /**
+         * Applies the settings that can't be passed to a send, the pooled session is only
+         * used by one lease at a time.
+         */
+        cms::MessageProducer* apply() {
+            producer->setDisableMessageID(disableMessageID);
+            producer->setDisableMessageTimeStamp(disableMessageTimeStamp);
+            producer->setMessageTransformer(transformer);
+            producer->setProducerWindowListener(windowListener);
+            return producer;
+        }
+
+    public:
+
+        LeasedProducer(cms::MessageProducer* producer) :
+            cms::MessageProducer(), producer(producer), deliveryMode(cms::DeliveryMode::PERSISTENT),
+            priority(cms::Message::DEFAULT_MSG_PRIORITY), timeToLive(cms::Message::DEFAULT_TIME_TO_LIVE),
+            disableMessageID(false), disableMessageTimeStamp(false), transformer(producer->getMessageTransformer()),
+            windowListener(NULL) {
+        }
+
+        virtual ~LeasedProducer() {}
+
+        /**
+         * Does nothing, the cached producer stays open for the pooled session.
+         */
+        virtual void close() {}
+
+        virtual void send(cms::Message* message) {
+            apply()->send(message, deliveryMode, priority, timeToLive);
+        }
+
+        virtual void send(cms::Message* message, cms::AsyncCallback* onComplete) {
+            apply()->send(message, deliveryMode, priority, timeToLive, onComplete);
+        }
+
+        virtual void send(cms::Message* message, int deliveryMode, int priority, long long timeToLive) {
+            apply()->send(message, deliveryMode, priority, timeToLive);
+        }
+
+        virtual void send(cms::Message* message, int deliveryMode, int priority, long long timeToLive,
+                          cms::AsyncCallback* onComplete) {
+            apply()->send(message, deliveryMode, priority, timeToLive, onComplete);
+        }
+
+        virtual void send(const cms::Destination* destination, cms::Message* message) {
+            apply()->send(destination, message, deliveryMode, priority, timeToLive);
+        }
+
+        virtual void send(const cms::Destination* destination, cms::Message* message,
+                          cms::AsyncCallback* onComplete) {
+            apply()->send(destination, message, deliveryMode, priority, timeToLive, onComplete);
+        }
+
+        virtual void send(const cms::Destination* destination, cms::Message* message,
+                          int deliveryMode, int priority, long long timeToLive) {
+            apply()->send(destination, message, deliveryMode, priority, timeToLive);
+        }
+
+        virtual void send(const cms::Destination* destination, cms::Message* message,
+                          int deliveryMode, int priority, long long timeToLive, cms::AsyncCallback* onComplete) {
+            apply()->send(destination, message, deliveryMode, priority, timeToLive, onComplete);
+        }
+
+        virtual bool trySend(cms::Message* message) {
+            // There is no trySend that takes the settings.
+            apply()->setDeliveryMode(deliveryMode);
+            producer->setPriority(priority);
+            producer->setTimeToLive(timeToLive);
+            return producer->trySend(message);
+        }
+
+        virtual bool trySend(const cms::Destination* destination, cms::Message* message) {
+            apply()->setDeliveryMode(deliveryMode);
+            producer->setPriority(priority);
+            producer->setTimeToLive(timeToLive);
+            return producer->trySend(destination, message);
+        }
+
+        virtual void setDeliveryMode(int mode) {
+            this->deliveryMode = mode;
+        }
+
+        virtual int getDeliveryMode() const {
+            return deliveryMode;
+        }
+
+        virtual void setDisableMessageID(bool value) {
+            this->disableMessageID = value;
+        }
+
+        virtual bool getDisableMessageID() const {
+            return disableMessageID;
+        }
+
+        virtual void setDisableMessageTimeStamp(bool value) {
+            this->disableMessageTimeStamp = value;
+        }
+
+        virtual bool getDisableMessageTimeStamp() const {
+            return disableMessageTimeStamp;
+        }
+
+        virtual void setPriority(int priority) {
+            this->priority = priority;
+        }
+
+        virtual int getPriority() const {
+            return priority;
+        }
+
+        virtual void setTimeToLive(long long time) {
+            this->timeToLive = time;
+        }
+
+        virtual long long getTimeToLive() const {
+            return timeToLive;
+        }
+
+        virtual void setMessageTransformer(cms::MessageTransformer* transformer) {
+            this->transformer = transformer;
+        }
+
+        virtual cms::MessageTransformer* getMessageTransformer() const {
+            return transformer;
+        }
+
+        virtual void setProducerWindowListener(cms::ProducerWindowListener* listener) {
+            this->windowListener = listener;
+        }
+
+        virtual cms::ProducerWindowListener* getProducerWindowListener() const {
+            return windowListener;
+        }
+    };
+
+    /**
+     * A session taken from one of a pooled connection's SessionPools, closing or
+     * deleting it hands the session back to the pool.
+     */
+    class LeasedSession : public cms::Session {
+    private:
+
+        ConnectionEntry* entry;
+        PooledSession* session;
+        Pointer<LeasedResources> owner;
+        Pointer<LeasedResources> consumers;
+        AtomicBoolean closed;
+
+    private:
+
+        LeasedSession(const LeasedSession&);
+        LeasedSession& operator=(const LeasedSession&);
+
+        PooledSession* get() const {
+            if (closed.get()) {
+                throw cms::IllegalStateException("The session is closed", NULL);
+            }
+            return session;
+        }
+
+    public:
+
+        LeasedSession(ConnectionEntry* entry, PooledSession* session, Pointer<LeasedResources> owner) :
+            cms::Session(), entry(entry), session(session), owner(owner),
+            consumers(new LeasedResources()), closed() {
+
+            owner->add(this);
+        }
+
+        virtual ~LeasedSession() {
+            try {
+                close();
+            } catch (...) {}
+
+            owner->remove(this);
+        }
+
+        virtual void close() {
+
+            if (!closed.compareAndSet(false, true)) {
+                return;
+            }
+
+            // The consumers would keep receiving on the session after it is handed out again.
+            consumers->closeAll();
+
+            try {
+                // Anything left uncommitted must not leak into the next lease.
+                if (session->isTransacted()) {
+                    session->rollback();
+                }
+            } catch (...) {
+                entry->failed.set(true);
+            }
+
+            session->close();
+            entry->activeSessions.decrementAndGet();
+        }
+
+        virtual void start() {
+            get()->start();
+        }
+
+        virtual void stop() {
+            get()->stop();
+        }
+
+        virtual void commit() {
+            get()->commit();
+        }
+
+        virtual void rollback() {
+            get()->rollback();
+        }
+
+        virtual void recover() {
+            get()->recover();
+        }
+
+        virtual cms::MessageConsumer* createConsumer(const cms::Destination* destination) {
+            return new LeasedConsumer(consumers, get()->createConsumer(destination));
+        }
+
+        virtual cms::MessageConsumer* createConsumer(const cms::Destination* destination,
+                                                     const std::string& selector) {
+            return new LeasedConsumer(consumers, get()->createConsumer(destination, selector));
+        }
+
+        virtual cms::MessageConsumer* createConsumer(const cms::Destination* destination,
+                                                     const std::string& selector,
+                                                     bool noLocal) {
+            return new LeasedConsumer(consumers, get()->createConsumer(destination, selector, noLocal));
+        }
+
+        virtual cms::MessageConsumer* createDurableConsumer(const cms::Topic* destination,
+                                                            const std::string& name,
+                                                            const std::string& selector,
+                                                            bool noLocal = false) {
+            return new LeasedConsumer(consumers, get()->createDurableConsumer(destination, name, selector, noLocal));
+        }
+
+        /**
+         * Producers for a destination are cached by the pooled session, the caller
+         * owns a wrapper with its own settings whose close leaves the cached producer open.
+         */
+        virtual cms::MessageProducer* createProducer(const cms::Destination* destination) {
+            if (destination == NULL) {
+                return get()->createProducer(destination);
+            }
+            return new LeasedProducer(get()->createCachedProducer(destination));
+        }
+
+        virtual cms::QueueBrowser* createBrowser(const cms::Queue* queue) {
+            return get()->createBrowser(queue);
+        }
+
+        virtual cms::QueueBrowser* createBrowser(const cms::Queue* queue, const std::string& selector) {
+            return get()->createBrowser(queue, selector);
+        }
+
+        virtual cms::Queue* createQueue(const std::string& queueName) {
+            return get()->createQueue(queueName);
+        }
+
+        virtual cms::Topic* createTopic(const std::string& topicName) {
+            return get()->createTopic(topicName);
+        }
+
+        virtual cms::TemporaryQueue* createTemporaryQueue() {
+            return get()->createTemporaryQueue();
+        }
+
+        virtual cms::TemporaryTopic* createTemporaryTopic() {
+            return get()->createTemporaryTopic();
+        }
+
+        virtual cms::Message* createMessage() {
+            return get()->createMessage();
+        }
+
+        virtual cms::BytesMessage* createBytesMessage() {
+            return get()->createBytesMessage();
+        }
+
+        virtual cms::BytesMessage* createBytesMessage(const unsigned char* bytes, int bytesSize) {
+            return get()->createBytesMessage(bytes, bytesSize);
+        }
+
+        virtual cms::StreamMessage* createStreamMessage() {
+            return get()->createStreamMessage();
+        }
+
+        virtual cms::TextMessage* createTextMessage() {
+            return get()->createTextMessage();
+        }
+
+        virtual cms::TextMessage* createTextMessage(const std::string& text) {
+            return get()->createTextMessage(text);
+        }
+
+        virtual cms::MapMessage* createMapMessage() {
+            return get()->createMapMessage();
+        }
+
+        virtual cms::Session::AcknowledgeMode getAcknowledgeMode() const {
+            return get()->getAcknowledgeMode();
+        }
+
+        virtual bool isTransacted() const {
+            return get()->isTransacted();
+        }
+
+        virtual void unsubscribe(const std::string& name) {
+            get()->unsubscribe(name);
+        }
+
+        virtual void setMessageTransformer(cms::MessageTransformer* transformer) {
+            get()->setMessageTransformer(transformer);
+        }
+
+        virtual cms::MessageTransformer* getMessageTransformer() const {
+            return get()->getMessageTransformer();
+        }
+    };
+
+    /**
+     * A lease on a pooled connection, closing or deleting it returns the connection
+     * to the pool.
+     */
+    class LeasedConnection : public cms::Connection {
+    private:
+
+        PooledConnectionFactory* parent;
+        ConnectionEntry* entry;
+        cms::ExceptionListener* listener;
+        cms::MessageTransformer* transformer;
+        Pointer<LeasedResources> sessions;
+        AtomicBoolean closed;
+
+    private:
+
+        LeasedConnection(const LeasedConnection&);
+        LeasedConnection& operator=(const LeasedConnection&);
+
+        void checkClosed() const {
+            if (closed.get()) {
+                throw cms::IllegalStateException("The connection is closed", NULL);
+            }
+        }
+
+    public:
+
+        LeasedConnection(PooledConnectionFactory* parent, ConnectionEntry* entry) :
+            cms::Connection(), parent(parent), entry(entry), listener(NULL),
+            transformer(entry->connection->getMessageTransformer()), sessions(new LeasedResources()), closed() {
+
+            synchronized(&entry->listenersMutex) {
+                entry->listeners.push_back(this);
+            }
+        }
+
+        virtual ~LeasedConnection() {
+            try {
+                close();
+            } catch (...) {}
+        }
+
+        virtual void close() {
+            if (closed.compareAndSet(false, true)) {
+
+                // Sessions still open go back to their pools before the connection does.
+                sessions->closeAll();
+
+                synchronized(&entry->listenersMutex) {
+                    entry->listeners.remove(this);
+                }
+                parent->release(entry);
+            }
+        }
+
+        virtual void start() {
+            checkClosed();
+            entry->connection->start();
+        }
+
+        /**
+         * Does nothing, the pooled connection keeps running for its other users.
+         */
+        virtual void stop() {
+            checkClosed();
+        }
+
+        virtual const cms::ConnectionMetaData* getMetaData() const {
+            checkClosed();
+            return entry->connection->getMetaData();
+        }
+
+        virtual cms::Session* createSession() {
+            return createSession(cms::Session::AUTO_ACKNOWLEDGE);
+        }
+
+        virtual cms::Session* createSession(cms::Session::AcknowledgeMode ackMode) {
+
+            checkClosed();
+
+            if ((int) ackMode < 0 || (int) ackMode >= ConnectionEntry::NUM_SESSION_POOLS) {
+                throw cms::CMSException("Invalid acknowledge mode", NULL);
+            }
+
+            int maximum = parent->getMaximumActiveSessionPerConnection();
+            if (entry->activeSessions.incrementAndGet() > maximum && maximum > 0) {
+                entry->activeSessions.decrementAndGet();
+                throw cms::IllegalStateException("The maximum number of active sessions is in use", NULL);
+            }
+
+            try {
+                PooledSession* session = entry->sessionPools[(int) ackMode]->takeSession();
+                session->setMessageTransformer(transformer);
+                return new LeasedSession(entry, session, sessions);
+            } catch (...) {
+                entry->activeSessions.decrementAndGet();
+                throw;
+            }
+        }
+
+        virtual std::string getClientID() const {
+            checkClosed();
+            return entry->connection->getClientID();
+        }
+
+        virtual void setClientID(const std::string& clientID AMQCPP_UNUSED) {
+            throw cms::IllegalStateException("Cannot set the client id of a pooled connection", NULL);
+        }
+
+        virtual cms::ExceptionListener* getExceptionListener() const {
+            return listener;
+        }
+
+        virtual void setExceptionListener(cms::ExceptionListener* listener) {
+            this->listener = listener;
+        }
+
+        virtual cms::MessageTransformer* getMessageTransformer() const {
+            return transformer;
+        }
+
+        virtual void setMessageTransformer(cms::MessageTransformer* transformer) {
+            this->transformer = transformer;
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    void ConnectionEntry::onException(const cms::CMSException& ex) {
+
+        // The connection is not handed out again once its current users are done.
+        failed.set(true);
+
+        std::list<cms::ExceptionListener*> targets;
+        synchronized(&listenersMutex) {
+            std::list<LeasedConnection*>::const_iterator iter = listeners.begin();
+            for (; iter != listeners.end(); ++iter) {
+                if ((*iter)->getExceptionListener() != NULL) {
+                    targets.push_back((*iter)->getExceptionListener());
+                }
+            }
+        }
+
+        if (parent->getExceptionListener() != NULL) {
+            targets.push_back(parent->getExceptionListener());
+        }
+
+        std::list<cms::ExceptionListener*>::const_iterator iter = targets.begin();
+        for (; iter != targets.end(); ++iter) {
+            try {
+                (*iter)->onException(ex);
+            } catch (...) {}
+        }
+    }
+
+}}
+
+////////////////////////////////////////////////////////////////////////////////
+PooledConnectionFactory::PooledConnectionFactory(cms::ConnectionFactory* connectionFactory, bool own) :
+    cms::ConnectionFactory(),
+    connectionFactory(connectionFactory),
+    ownsFactory(own),
+    maxConnections(DEFAULT_MAX_CONNECTIONS),
+    maximumActiveSessionPerConnection(DEFAULT_MAXIMUM_ACTIVE_SESSION_PER_CONNECTION),
+    idleTimeout(DEFAULT_IDLE_TIMEOUT),
+    lastEvictionTime(0),
+    initialized(),
+    mutex(),
+    entries(),
+    idleSlots(NULL),
+    connectionsCreated(),
+    connectionLeases(),
+    connectionPoolHits() {
+
+    if (connectionFactory == NULL) {
+        throw cms::CMSException("connection factory is NULL", NULL);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PooledConnectionFactory::PooledConnectionFactory(const std::string& brokerURI) :
+    cms::ConnectionFactory(),
+    connectionFactory(NULL),
+    ownsFactory(true),
+    maxConnections(DEFAULT_MAX_CONNECTIONS),
+    maximumActiveSessionPerConnection(DEFAULT_MAXIMUM_ACTIVE_SESSION_PER_CONNECTION),
+    idleTimeout(DEFAULT_IDLE_TIMEOUT),
+    lastEvictionTime(0),
+    initialized(),
+    mutex(),
+    entries(),
+    idleSlots(NULL),
+    connectionsCreated(),
+    connectionLeases(),
+    connectionPoolHits() {
+
+    this->connectionFactory = cms::ConnectionFactory::createCMSConnectionFactory(brokerURI);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PooledConnectionFactory::~PooledConnectionFactory() {
+
+    try {
+
+        std::vector<ConnectionEntry*>::iterator iter = entries.begin();
+        for (; iter != entries.end(); ++iter) {
+            synchronized(&(*iter)->mutex) {
+                (*iter)->close();
+            }
+            delete *iter;
+        }
+
+        entries.clear();
+        delete [] idleSlots;
+
+        if (ownsFactory) {
+            delete connectionFactory;
+        }
+    } catch (...) {
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+cms::Connection* PooledConnectionFactory::createConnection() {
+    return lease(true, "", "");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+cms::Connection* PooledConnectionFactory::createConnection(const std::string& username, const std::string& password) {
+    return lease(false, username, password);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+cms::Connection* PooledConnectionFactory::createConnection(const std::string& username,
+                                                           const std::string& password,
+                                                           const std::string& clientId) {
+    return connectionFactory->createConnection(username, password, clientId);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledConnectionFactory::setExceptionListener(cms::ExceptionListener* listener) {
+    connectionFactory->setExceptionListener(listener);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+cms::ExceptionListener* PooledConnectionFactory::getExceptionListener() const {
+    return connectionFactory->getExceptionListener();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledConnectionFactory::setMessageTransformer(cms::MessageTransformer* transformer) {
+    connectionFactory->setMessageTransformer(transformer);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+cms::MessageTransformer* PooledConnectionFactory::getMessageTransformer() const {
+    return connectionFactory->getMessageTransformer();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledConnectionFactory::setMaxConnections(int value) {
+
+    synchronized(&mutex) {
+
+        if (initialized.get()) {
+            throw cms::IllegalStateException(
+                "The maximum number of connections must be set before the first connection is leased", NULL);
+        }
+
+        if (value < 1) {
+            throw cms::CMSException("The maximum number of connections must be at least one", NULL);
+        }
+
+        this->maxConnections = value;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledConnectionFactory::initialize() {
+
+    if (initialized.get()) {
+        return;
+    }
+
+    synchronized(&mutex) {
+
+        if (!initialized.get()) {
+
+            for (int i = 0; i < maxConnections; ++i) {
+                entries.push_back(new ConnectionEntry(this));
+            }
+
+            // One slot per entry so an idle connection always finds room.
+            idleSlots = new AtomicReference<ConnectionEntry>[maxConnections];
+            lastEvictionTime = System::currentTimeMillis();
+            initialized.set(true);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int PooledConnectionFactory::getAffinity() const {
+    unsigned long long id = (unsigned long long) Thread::currentThread()->getId();
+    return (int) (id % (unsigned long long) maxConnections);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ConnectionEntry* PooledConnectionFactory::claimIdle(const std::string& key, bool reuseOtherKeys) {
+
+    int start = getAffinity();
+
+    for (int i = 0; i < maxConnections; ++i) {
+
+        AtomicReference<ConnectionEntry>& slot = idleSlots[(start + i) % maxConnections];
+        ConnectionEntry* entry = slot.get();
+
+        // Only look at the entry once it is ours, another thread may claim it first.
+        if (entry == NULL || !slot.compareAndSet(entry, NULL)) {
+            continue;
+        }
+
+        entry->idle.set(false);
+
+        bool claimed = false;
+        bool keep = true;
+
+        synchronized(&entry->mutex) {
+
+            bool unused = entry->leases.get() == 0 && entry->activeSessions.get() == 0;
+
+            if (entry->connection == NULL) {
+                // Evicted while it was on the idle list.
+                keep = false;
+            } else if (!entry->failed.get() && entry->key == key) {
+                entry->leases.incrementAndGet();
+                claimed = true;
+            } else if (unused && (entry->failed.get() || reuseOtherKeys)) {
+                entry->close();
+                keep = false;
+            }
+
+            // An emptied entry is reserved for the caller to open.
+            if (!keep && reuseOtherKeys && entry->connection == NULL) {
+                entry->leases.incrementAndGet();
+                claimed = true;
+            }
+        }
+
+        if (claimed) {
+            return entry;
+        } else if (keep) {
+            offerIdle(entry);
+        }
+    }
+
+    return NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledConnectionFactory::offerIdle(ConnectionEntry* entry) {
+
+    if (!entry->idle.compareAndSet(false, true)) {
+        return;
+    }
+
+    // Prefer the calling thread's own slot so it finds this connection again first.
+    int start = getAffinity();
+    for (int i = 0; i < maxConnections; ++i) {
+        if (idleSlots[(start + i) % maxConnections].compareAndSet(NULL, entry)) {
+            return;
+        }
+    }
+
+    entry->idle.set(false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+cms::Connection* PooledConnectionFactory::lease(bool defaultCredentials,
+                                                const std::string& username,
+                                                const std::string& password) {
+
+    try {
+
+        initialize();
+
+        bool evict = false;
+        if (idleTimeout > 0) {
+            long long now = System::currentTimeMillis();
+            synchronized(&mutex) {
+                if (now - lastEvictionTime >= idleTimeout) {
+                    lastEvictionTime = now;
+                    evict = true;
+                }
+            }
+        }
+
+        if (evict) {
+            evictIdleConnections();
+        }
+
+        std::string key = defaultCredentials ? std::string() : "user:" + username + "\npassword:" + password;
+
+        connectionLeases.incrementAndGet();
+
+        ConnectionEntry* entry = claimIdle(key, false);
+        if (entry != NULL) {
+            connectionPoolHits.incrementAndGet();
+            recordLease(entry->connection, true);
+            return new LeasedConnection(this, entry);
+        }
+
+        int start = getAffinity();
+
+        // Open a new connection while there is room in the pool.
+        for (int i = 0; i < maxConnections && entry == NULL; ++i) {
+            ConnectionEntry* candidate = entries[(start + i) % maxConnections];
+            synchronized(&candidate->mutex) {
+                if (candidate->connection == NULL) {
+                    candidate->open(key, defaultCredentials ? connectionFactory->createConnection() :
+                                                              connectionFactory->createConnection(username, password));
+                    candidate->leases.incrementAndGet();
+                    connectionsCreated.incrementAndGet();
+                    recordLease(candidate->connection, false);
+                    entry = candidate;
+                }
+            }
+        }
+
+        // Share a busy connection that was opened with the same credentials.
+        for (int i = 0; i < maxConnections && entry == NULL; ++i) {
+            ConnectionEntry* candidate = entries[(start + i) % maxConnections];
+            synchronized(&candidate->mutex) {
+                if (candidate->connection != NULL && !candidate->failed.get() && candidate->key == key) {
+                    candidate->leases.incrementAndGet();
+                    connectionPoolHits.incrementAndGet();
+                    recordLease(candidate->connection, true);
+                    entry = candidate;
+                }
+            }
+        }
+
+        // Close an idle connection that belongs to other credentials to make room.
+        if (entry == NULL && (entry = claimIdle(key, true)) != NULL) {
+            synchronized(&entry->mutex) {
+                if (entry->connection != NULL) {
+                    connectionPoolHits.incrementAndGet();
+                    recordLease(entry->connection, true);
+                } else {
+                    try {
+                        entry->open(key, defaultCredentials ? connectionFactory->createConnection() :
+                                                              connectionFactory->createConnection(username, password));
+                        connectionsCreated.incrementAndGet();
+                        recordLease(entry->connection, false);
+                    } catch (...) {
+                        entry->leases.decrementAndGet();
+                        throw;
+                    }
+                }
+            }
+        }
+
+        if (entry == NULL) {
+            throw cms::IllegalStateException("All pooled connections are in use by other credentials", NULL);
+        }
+
+        return new LeasedConnection(this, entry);
+    }
+    POOLEDCONNECTIONFACTORY_CATCHALL()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledConnectionFactory::release(ConnectionEntry* entry) {
+
+    entry->lastUsed = System::currentTimeMillis();
+
+    if (entry->leases.decrementAndGet() > 0) {
+        return;
+    }
+
+    if (entry->failed.get()) {
+        synchronized(&entry->mutex) {
+            if (entry->isEvictable(entry->lastUsed, idleTimeout)) {
+                entry->close();
+            }
+        }
+    } else {
+        offerIdle(entry);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledConnectionFactory::evictIdleConnections() {
+
+    if (!initialized.get()) {
+        return;
+    }
+
+    long long now = System::currentTimeMillis();
+
+    // Closed entries still on the idle list are dropped by the next thread that claims them.
+    std::vector<ConnectionEntry*>::iterator iter = entries.begin();
+    for (; iter != entries.end(); ++iter) {
+        synchronized(&(*iter)->mutex) {
+            if ((*iter)->isEvictable(now, idleTimeout)) {
+                (*iter)->close();
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int PooledConnectionFactory::getConnectionCount() const {
+
+    int result = 0;
+    if (!initialized.get()) {
+        return result;
+    }
+
+    std::vector<ConnectionEntry*>::const_iterator iter = entries.begin();
+    for (; iter != entries.end(); ++iter) {
+        synchronized(&(*iter)->mutex) {
+            if ((*iter)->connection != NULL) {
+                result++;
+            }
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int PooledConnectionFactory::getIdleConnectionCount() const {
+
+    int result = 0;
+    if (!initialized.get()) {
+        return result;
+    }
+
+    std::vector<ConnectionEntry*>::const_iterator iter = entries.begin();
+    for (; iter != entries.end(); ++iter) {
+        synchronized(&(*iter)->mutex) {
+            if ((*iter)->connection != NULL && (*iter)->leases.get() == 0) {
+                result++;
+            }
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long PooledConnectionFactory::getSessionLeases() const {
+
+    long long result = 0;
+    if (!initialized.get()) {
+        return result;
+    }
+
+    std::vector<ConnectionEntry*>::const_iterator iter = entries.begin();
+    for (; iter != entries.end(); ++iter) {
+        synchronized(&(*iter)->mutex) {
+            result += (*iter)->getSessionsTaken();
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long PooledConnectionFactory::getSessionPoolHits() const {
+
+    long long result = 0;
+    if (!initialized.get()) {
+        return result;
+    }
+
+    std::vector<ConnectionEntry*>::const_iterator iter = entries.begin();
+    for (; iter != entries.end(); ++iter) {
+        synchronized(&(*iter)->mutex) {
+            result += (*iter)->getSessionsTaken() - (*iter)->getSessionsCreated();
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,294 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CMSUTIL_POOLEDCONNECTIONFACTORY_H_
+#define _ACTIVEMQ_CMSUTIL_POOLEDCONNECTIONFACTORY_H_
+
+#include <activemq/util/Config.h>
+#include <cms/ConnectionFactory.h>
+#include <cms/Connection.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/atomic/AtomicBoolean.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+#include <decaf/util/concurrent/atomic/AtomicReference.h>
+#include <string>
+#include <vector>
+
+namespace activemq {
+namespace cmsutil {
+
+    // Forward declarations.
+    class ConnectionEntry;
+    class LeasedConnection;
+
+    /**
+     * A cms::ConnectionFactory that keeps the connections it creates open and leases
+     * them out again, so short lived users don't pay for a new connection and its
+     * handshake every time.  Closing a connection obtained from this factory returns
+     * it to the pool, and its sessions are taken from a SessionPool per acknowledge
+     * mode just like the ones a CmsTemplate uses.  Producers created on those sessions
+     * for a specific destination are cached with the session and only closed when its
+     * connection leaves the pool.
+     *
+     * Idle connections are kept on a lock free list, a thread first looks at the slot
+     * it returned its last connection to so it tends to get the same one back.  Once
+     * the maximum number of connections is open, new leases share the open connection
+     * for the same credentials that the calling thread maps to.  Connections that have
+     * been idle for longer than the idle timeout, or that reported an error, are closed
+     * the next time the pool is used.
+     *
+     * Connections requested with a client id are never pooled since the broker only
+     * allows one connection per client id, they are passed through to the wrapped
+     * factory.  All leased connections must be closed before this factory is destroyed.
+     * This class is thread-safe.
+     *
+     * @since 3.10
+     */
+    class AMQCPP_API PooledConnectionFactory : public cms::ConnectionFactory {
+    private:
+
+        friend class LeasedConnection;
+
+        cms::ConnectionFactory* connectionFactory;
+
+        bool ownsFactory;
+
+        int maxConnections;
+
+        int maximumActiveSessionPerConnection;
+
+        long long idleTimeout;
+
+        // Guarded by the mutex.
+        long long lastEvictionTime;
+
+        decaf::util::concurrent::atomic::AtomicBoolean initialized;
+
+        decaf::util::concurrent::Mutex mutex;
+
+        std::vector<ConnectionEntry*> entries;
+
+        decaf::util::concurrent::atomic::AtomicReference<ConnectionEntry>* idleSlots;
+
+        decaf::util::concurrent::atomic::AtomicInteger connectionsCreated;
+
+        decaf::util::concurrent::atomic::AtomicInteger connectionLeases;
+
+        decaf::util::concurrent::atomic::AtomicInteger connectionPoolHits;
+
+    public:
+
+        /** The default maximum number of pooled connections. */
+        static const int DEFAULT_MAX_CONNECTIONS;
+
+        /** The default maximum number of sessions leased from one connection at a time. */
+        static const int DEFAULT_MAXIMUM_ACTIVE_SESSION_PER_CONNECTION;
+
+        /** The default time in milliseconds an unused connection stays open. */
+        static const long long DEFAULT_IDLE_TIMEOUT;
+
+    private:
+
+        PooledConnectionFactory(const PooledConnectionFactory&);
+        PooledConnectionFactory& operator=(const PooledConnectionFactory&);
+
+    public:
+
+        /**
+         * Creates a pool on top of the given connection factory.
+         *
+         * @param connectionFactory
+         *      The factory used to create the pooled connections.
+         * @param own
+         *      If true this pool deletes the factory when it is destroyed.
+         */
+        PooledConnectionFactory(cms::ConnectionFactory* connectionFactory, bool own = false);
+
+        /**
+         * Creates a pool of connections to the broker at the given URI.
+         *
+         * @param brokerURI
+         *      The URI of the broker the pooled connections connect to.
+         *
+         * @throws CMSException if the factory for the URI cannot be created.
+         */
+        PooledConnectionFactory(const std::string& brokerURI);
+
+        /**
+         * Closes all pooled connections.
+         */
+        virtual ~PooledConnectionFactory();
+
+        /**
+         * Leases a connection using the wrapped factory's default credentials.
+         *
+         * @return a connection that is returned to the pool when it is closed.
+         *
+         * @throws CMSException if no connection can be leased.
+         */
+        virtual cms::Connection* createConnection();
+
+        /**
+         * Leases a connection for the given credentials, connections are only shared
+         * between users of the same credentials.
+         *
+         * @return a connection that is returned to the pool when it is closed.
+         *
+         * @throws CMSException if no connection can be leased.
+         */
+        virtual cms::Connection* createConnection(const std::string& username, const std::string& password);
+
+        /**
+         * Creates a new connection from the wrapped factory, connections with a client
+         * id are not pooled.
+         *
+         * @throws CMSException if the connection cannot be created.
+         */
+        virtual cms::Connection* createConnection(const std::string& username,
+                                                  const std::string& password,
+                                                  const std::string& clientId);
+
+        virtual void setExceptionListener(cms::ExceptionListener* listener);
+
+        virtual cms::ExceptionListener* getExceptionListener() const;
+
+        virtual void setMessageTransformer(cms::MessageTransformer* transformer);
+
+        virtual cms::MessageTransformer* getMessageTransformer() const;
+
+        /**
+         * Sets the maximum number of connections this pool keeps open, this must be
+         * configured before the first connection is leased.
+         *
+         * @param value
+         *      The maximum number of connections, must be at least one.
+         *
+         * @throws IllegalStateException if a connection has already been leased.
+         */
+        void setMaxConnections(int value);
+
+        /**
+         * @return the maximum number of connections this pool keeps open.
+         */
+        int getMaxConnections() const {
+            return this->maxConnections;
+        }
+
+        /**
+         * Sets the maximum number of sessions that can be leased from one pooled
+         * connection at the same time, zero or less means no limit.
+         *
+         * @param value
+         *      The maximum number of active sessions per connection.
+         */
+        void setMaximumActiveSessionPerConnection(int value) {
+            this->maximumActiveSessionPerConnection = value;
+        }
+
+        /**
+         * @return the maximum number of sessions that can be leased from one connection.
+         */
+        int getMaximumActiveSessionPerConnection() const {
+            return this->maximumActiveSessionPerConnection;
+        }
+
+        /**
+         * Sets how long in milliseconds an unused connection is kept open, zero or less
+         * keeps idle connections open until this factory is destroyed.
+         *
+         * @param value
+         *      The idle timeout in milliseconds.
+         */
+        void setIdleTimeout(long long value) {
+            this->idleTimeout = value;
+        }
+
+        /**
+         * @return how long in milliseconds an unused connection is kept open.
+         */
+        long long getIdleTimeout() const {
+            return this->idleTimeout;
+        }
+
+        /**
+         * Closes the pooled connections that are not leased and have been idle for longer
+         * than the idle timeout or that have reported an error.  This is also done while
+         * leasing connections so it only needs to be called to release idle connections
+         * of a pool that is no longer being used.
+         */
+        void evictIdleConnections();
+
+        /**
+         * @return the number of connections currently open in this pool.
+         */
+        int getConnectionCount() const;
+
+        /**
+         * @return the number of open connections that are not leased.
+         */
+        int getIdleConnectionCount() const;
+
+        /**
+         * @return the number of connections created by this pool.
+         */
+        int getConnectionsCreated() const {
+            return this->connectionsCreated.get();
+        }
+
+        /**
+         * @return the number of connections leased from this pool.
+         */
+        int getConnectionLeases() const {
+            return this->connectionLeases.get();
+        }
+
+        /**
+         * @return the number of connection leases that were served by an open connection.
+         */
+        int getConnectionPoolHits() const {
+            return this->connectionPoolHits.get();
+        }
+
+        /**
+         * @return the number of sessions leased from the pooled connections.
+         */
+        long long getSessionLeases() const;
+
+        /**
+         * @return the number of session leases that were served by an already open session.
+         */
+        long long getSessionPoolHits() const;
+
+    private:
+
+        cms::Connection* lease(bool defaultCredentials, const std::string& username, const std::string& password);
+
+        void release(ConnectionEntry* entry);
+
+        void initialize();
+
+        int getAffinity() const;
+
+        ConnectionEntry* claimIdle(const std::string& key, bool reuseOtherKeys);
+
+        void offerIdle(ConnectionEntry* entry);
+
+    };
+
+}}
+
+#endif /*_ACTIVEMQ_CMSUTIL_POOLEDCONNECTIONFACTORY_H_*/
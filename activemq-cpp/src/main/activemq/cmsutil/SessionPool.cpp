@@ -30,7 +30,8 @@ SessionPool::SessionPool(cms::Connection* connection,
       mutex(),
       available(),
       sessions(),
-      acknowledgeMode(ackMode) {
+      acknowledgeMode(ackMode),
+      takeCount(0) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -57,6 +58,7 @@ PooledSession* SessionPool::takeSession() {
     synchronized(&mutex) {
 
         PooledSession* pooledSession = NULL;
+        takeCount++;
 
         // If there are no sessions available, create a new one and return it.
         if (available.size() == 0) {
@@ -98,3 +100,23 @@ void SessionPool::returnSession(PooledSession* session) {
         available.push_back(session);
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+long long SessionPool::getSessionsCreated() {
+
+    synchronized(&mutex) {
+        return (long long) sessions.size();
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long SessionPool::getSessionsTaken() {
+
+    synchronized(&mutex) {
+        return takeCount;
+    }
+
+    return 0;
+}
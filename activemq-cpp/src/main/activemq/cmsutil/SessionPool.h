@@ -51,6 +51,8 @@ namespace cmsutil {
 
         cms::Session::AcknowledgeMode acknowledgeMode;
 
+        long long takeCount;
+
     private:
 
         SessionPool(const SessionPool&);
@@ -99,6 +101,21 @@ namespace cmsutil {
             return resourceLifecycleManager;
         }
 
+        /**
+         * @return the number of sessions this pool has created.
+         *
+         * @since 3.10
+         */
+        virtual long long getSessionsCreated();
+
+        /**
+         * @return the number of times a session was taken from this pool, the
+         *         difference to getSessionsCreated is the number of pool hits.
+         *
+         * @since 3.10
+         */
+        virtual long long getSessionsTaken();
+
     };
 
 }}
@@ -181,13 +181,16 @@ int ActiveMQBytesMessage::getBodyLength() const {
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQBytesMessage::clearBody() {
 
-    // Invoke base class's version.
-    ActiveMQMessageTemplate<cms::BytesMessage>::clearBody();
-
+    // Drop the output stream first, a compressing stream writes its trailer into
+    // the content when it is destroyed so the content can only be cleared after.
     this->dataOut.reset(NULL);
     this->bytesOut = NULL;
     this->dataIn.reset(NULL);
     this->length = 0;
+    this->compressed = false;
+
+    // Invoke base class's version.
+    ActiveMQMessageTemplate<cms::BytesMessage>::clearBody();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -589,31 +592,21 @@ void ActiveMQBytesMessage::storeContent() {
 
     try {
 
-        if (this->dataOut.get() != NULL && this->bytesOut->size() > 0) {
+        if (this->dataOut.get() != NULL) {
 
+            // The body was written straight into the content, closing the stream finishes
+            // any compression and leaves nothing to copy.
             this->dataOut->close();
 
-            if (!this->compressed) {
-
-                std::pair<unsigned char*, int> array = this->bytesOut->toByteArray();
-                this->setContent(std::vector<unsigned char>(array.first, array.first + array.second));
-                delete[] array.first;
-
-            } else {
-
-                ByteArrayOutputStream buffer;
-                DataOutputStream doBuffer(&buffer);
-
-                // Start by writing the length of the written data before compression.
-                doBuffer.writeInt((int) this->length);
-
-                // Now write the Compressed bytes.
-                this->bytesOut->writeTo(&doBuffer);
+            if (this->compressed) {
 
-                // Now store the annotated content.
-                std::pair<unsigned char*, int> array = buffer.toByteArray();
-                this->setContent(std::vector<unsigned char>(array.first, array.first + array.second));
-                delete[] array.first;
+                // Compressed content starts with the length of the data before compression,
+                // space for it was reserved when writing started.
+                std::vector<unsigned char>& content = this->getContent();
+                content[0] = (unsigned char) ((this->length >> 24) & 0xFF);
+                content[1] = (unsigned char) ((this->length >> 16) & 0xFF);
+                content[2] = (unsigned char) ((this->length >> 8) & 0xFF);
+                content[3] = (unsigned char) (this->length & 0xFF);
             }
 
             this->dataOut.reset(NULL);
@@ -659,13 +652,24 @@ void ActiveMQBytesMessage::initializeWriting() {
     try {
         if (this->dataOut.get() == NULL) {
             this->length = 0;
-            this->bytesOut = new ByteArrayOutputStream();
+
+            std::vector<unsigned char>& content = this->getContent();
+            content.clear();
+
+            this->bytesOut = new activemq::io::ByteVectorOutputStream(content);
 
             OutputStream* os = this->bytesOut;
 
+            // The new body replaces any previous one so it's only compressed if the
+            // connection compresses it now.
+            this->compressed = false;
+
             if (this->connection != NULL && this->connection->isUseCompression()) {
                 this->compressed = true;
 
+                // Room for the uncompressed length, filled in by storeContent.
+                content.resize(4, 0);
+
                 Deflater* deflator = new Deflater(this->connection->getCompressionLevel());
 
                 os = new DeflaterOutputStream(os, deflator, true, true);
@@ -20,7 +20,7 @@
 
 #include <activemq/util/Config.h>
 #include <activemq/commands/ActiveMQMessageTemplate.h>
-#include <decaf/io/ByteArrayOutputStream.h>
+#include <activemq/io/ByteVectorOutputStream.h>
 #include <decaf/io/DataInputStream.h>
 #include <decaf/io/DataOutputStream.h>
 #include <cms/BytesMessage.h>
@@ -35,10 +35,10 @@ namespace commands {
     private:
 
         /**
-         * OutputStream that wraps around the command's content when in
+         * OutputStream that writes directly into the command's content when in
          * write-only mode.
          */
-        decaf::io::ByteArrayOutputStream* bytesOut;
+        activemq::io::ByteVectorOutputStream* bytesOut;
 
         /**
          * DataInputStream wrapper around the input stream.
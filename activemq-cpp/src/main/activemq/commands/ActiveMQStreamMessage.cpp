@@ -15,6 +15,7 @@
  * limitations under the License.
  */
 #include <activemq/commands/ActiveMQStreamMessage.h>
+#include <activemq/io/ByteVectorOutputStream.h>
 #include <activemq/util/PrimitiveValueNode.h>
 #include <activemq/util/CMSExceptionSupport.h>
 #include <activemq/util/MarshallingSupport.h>
@@ -36,7 +37,6 @@
 #include <decaf/lang/Long.h>
 #include <decaf/lang/Double.h>
 #include <decaf/lang/Float.h>
-#include <decaf/io/ByteArrayOutputStream.h>
 #include <decaf/io/ByteArrayInputStream.h>
 #include <decaf/io/BufferedInputStream.h>
 #include <decaf/util/zip/DeflaterOutputStream.h>
@@ -74,8 +74,8 @@ namespace commands {
 
     public:
 
-        // Holds the contents of the message once written.
-        decaf::io::ByteArrayOutputStream* bytesOut;
+        // Writes the body directly into the message's content.
+        activemq::io::ByteVectorOutputStream* bytesOut;
 
         // When reading an array of bytes this value indicates how many bytes
         // are left unread since the last readBytes call.
@@ -157,13 +157,16 @@ bool ActiveMQStreamMessage::equals(const DataStructure* value) const {
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQStreamMessage::clearBody() {
 
-    // Invoke base class's version.
-    ActiveMQMessageTemplate<cms::StreamMessage>::clearBody();
-
+    // Drop the output stream first, a compressing stream writes its trailer into
+    // the content when it is destroyed so the content can only be cleared after.
     this->dataIn.reset(NULL);
     this->dataOut.reset(NULL);
     this->impl->bytesOut = NULL;
     this->impl->remainingBytes = -1;
+    this->compressed = false;
+
+    // Invoke base class's version.
+    ActiveMQMessageTemplate<cms::StreamMessage>::clearBody();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -944,14 +947,10 @@ void ActiveMQStreamMessage::storeContent() {
 
     if (this->dataOut.get() != NULL) {
 
+        // The body was written straight into the content, closing the stream finishes
+        // any compression and leaves nothing to copy.
         this->dataOut->close();
 
-        if (this->impl->bytesOut->size() > 0) {
-            std::pair<unsigned char*, int> array = this->impl->bytesOut->toByteArray();
-            this->setContent(std::vector<unsigned char>(array.first, array.first + array.second));
-            delete[] array.first;
-        }
-
         this->dataOut.reset(NULL);
         this->impl->bytesOut = NULL;
     }
@@ -982,10 +981,18 @@ void ActiveMQStreamMessage::initializeWriting() {
     this->failIfReadOnlyBody();
     try {
         if (this->dataOut.get() == NULL) {
-            this->impl->bytesOut = new ByteArrayOutputStream();
+
+            std::vector<unsigned char>& content = this->getContent();
+            content.clear();
+
+            this->impl->bytesOut = new activemq::io::ByteVectorOutputStream(content);
 
             OutputStream* os = this->impl->bytesOut;
 
+            // The new body replaces any previous one so it's only compressed if the
+            // connection compresses it now.
+            this->compressed = false;
+
             if (this->connection != NULL && this->connection->isUseCompression()) {
                 this->compressed = true;
 
@@ -168,7 +168,8 @@ int ConnectionId::compareTo(const ConnectionId& value) const {
         return 0;
     }
 
-    int valueComp = StringUtils::compareIgnoreCase(this->value.c_str(), value.value.c_str());
+    int valueComp = this->value == value.value ? 0 :
+        StringUtils::compareIgnoreCase(this->value.c_str(), value.value.c_str());
     if (valueComp != 0) {
         return valueComp;
     }
@@ -18,10 +18,11 @@
 #include <activemq/commands/ConsumerId.h>
 #include <activemq/exceptions/ActiveMQException.h>
 #include <activemq/state/CommandVisitor.h>
+#include <activemq/util/IdPrefixTable.h>
 #include <decaf/internal/util/StringUtils.h>
+#include <decaf/lang/Long.h>
 #include <decaf/lang/exceptions/NullPointerException.h>
 #include <decaf/util/HashCode.h>
-#include <sstream>
 
 using namespace std;
 using namespace activemq;
@@ -43,24 +44,27 @@ using namespace decaf::internal::util;
 
 ////////////////////////////////////////////////////////////////////////////////
 ConsumerId::ConsumerId() :
-    BaseDataStructure(), connectionId(""), sessionId(0), value(0), parentId() {
+    BaseDataStructure(), connectionId(""), sessionId(0), value(0), parentId(), prefix(), key(""), hashCode(0) {
 
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ConsumerId::ConsumerId(const ConsumerId& other) :
-    BaseDataStructure(), connectionId(""), sessionId(0), value(0), parentId() {
+    BaseDataStructure(), connectionId(""), sessionId(0), value(0), parentId(), prefix(), key(""), hashCode(0) {
 
     this->copyDataStructure(&other);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ConsumerId::ConsumerId(const SessionId& sessionId, long long consumerId) :
-    BaseDataStructure(), connectionId(""), sessionId(0), value(0), parentId() {
+    BaseDataStructure(), connectionId(""), sessionId(0), value(0), parentId(), prefix(), key(""), hashCode(0) {
 
     this->connectionId = sessionId.getConnectionId();
     this->sessionId = sessionId.getValue();
     this->value = consumerId;
+
+    this->prefix = sessionId.prefix;
+    this->updateKey();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -99,6 +103,14 @@ void ConsumerId::copyDataStructure(const DataStructure* src) {
     this->setConnectionId(srcPtr->getConnectionId());
     this->setSessionId(srcPtr->getSessionId());
     this->setValue(srcPtr->getValue());
+
+    if (srcPtr->isKeyCurrent()) {
+        this->prefix = srcPtr->prefix;
+        this->key = srcPtr->key;
+        this->hashCode = srcPtr->hashCode;
+    } else {
+        this->updateKey();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -109,13 +121,11 @@ unsigned char ConsumerId::getDataStructureType() const {
 ////////////////////////////////////////////////////////////////////////////////
 std::string ConsumerId::toString() const {
 
-    ostringstream stream;
-
-    stream << this->connectionId << ":"
-           << this->sessionId << ":"
-           << this->value;
+    if (this->isKeyCurrent()) {
+        return this->key;
+    }
 
-    return stream.str();
+    return this->formatKey();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -159,6 +169,7 @@ std::string& ConsumerId::getConnectionId() {
 ////////////////////////////////////////////////////////////////////////////////
 void ConsumerId::setConnectionId(const std::string& connectionId) {
     this->connectionId = connectionId;
+    this->prefix.reset();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -169,6 +180,7 @@ long long ConsumerId::getSessionId() const {
 ////////////////////////////////////////////////////////////////////////////////
 void ConsumerId::setSessionId(long long sessionId) {
     this->sessionId = sessionId;
+    this->prefix.reset();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -179,6 +191,7 @@ long long ConsumerId::getValue() const {
 ////////////////////////////////////////////////////////////////////////////////
 void ConsumerId::setValue(long long value) {
     this->value = value;
+    this->prefix.reset();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -188,7 +201,8 @@ int ConsumerId::compareTo(const ConsumerId& value) const {
         return 0;
     }
 
-    int connectionIdComp = StringUtils::compareIgnoreCase(this->connectionId.c_str(), value.connectionId.c_str());
+    int connectionIdComp = this->connectionId == value.connectionId ? 0 :
+        StringUtils::compareIgnoreCase(this->connectionId.c_str(), value.connectionId.c_str());
     if (connectionIdComp != 0) {
         return connectionIdComp;
     }
@@ -231,7 +245,12 @@ ConsumerId& ConsumerId::operator= (const ConsumerId& other) {
 
 ////////////////////////////////////////////////////////////////////////////////
 int ConsumerId::getHashCode() const {
-    return decaf::util::HashCode<std::string>()(this->toString());
+
+    if (this->isKeyCurrent()) {
+        return this->hashCode;
+    }
+
+    return this->computeHashCode();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -242,3 +261,33 @@ const Pointer<SessionId>& ConsumerId::getParentId() const {
     return this->parentId;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ConsumerId::afterUnmarshal(wireformat::WireFormat* wireFormat AMQCPP_UNUSED) {
+    this->updateKey();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ConsumerId::updateKey() {
+
+    if (this->prefix == NULL || !this->prefix->matches(this->connectionId, this->sessionId)) {
+        this->prefix = activemq::util::IdPrefixTable::intern(this->connectionId, this->sessionId);
+    }
+
+    this->key = this->prefix->formatKey(this->value);
+    this->hashCode = this->prefix->hashKey(this->value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ConsumerId::isKeyCurrent() const {
+    return this->prefix != NULL && this->prefix->matches(this->connectionId, this->sessionId);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string ConsumerId::formatKey() const {
+    return activemq::util::IdPrefix(this->connectionId, this->sessionId).formatKey(this->value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ConsumerId::computeHashCode() const {
+    return activemq::util::IdPrefix(this->connectionId, this->sessionId).hashKey(this->value);
+}
@@ -26,6 +26,7 @@
 #include <activemq/commands/BaseDataStructure.h>
 #include <activemq/commands/SessionId.h>
 #include <activemq/util/Config.h>
+#include <activemq/util/IdPrefix.h>
 #include <decaf/lang/Comparable.h>
 #include <decaf/lang/Pointer.h>
 #include <string>
@@ -62,6 +63,24 @@ namespace commands {
 
         mutable Pointer<SessionId> parentId;
 
+        // Interned session prefix, formatted key and hash code.  They are built once all
+        // fields are known by the constructors, copyDataStructure and afterUnmarshal, the
+        // setters only discard them so the const accessors never write.  Edits made
+        // through the non-const getConnectionId no longer match the prefix.
+        Pointer<const activemq::util::IdPrefix> prefix;
+        std::string key;
+        int hashCode;
+
+        void updateKey();
+
+        bool isKeyCurrent() const;
+
+        std::string formatKey() const;
+
+        int computeHashCode() const;
+
+        friend class SessionId;
+
     public:
 
         ConsumerId();
@@ -84,6 +103,8 @@ namespace commands {
 
         const Pointer<SessionId>& getParentId() const;
 
+        virtual void afterUnmarshal(wireformat::WireFormat* wireFormat);
+
         virtual const std::string& getConnectionId() const;
         virtual std::string& getConnectionId();
         virtual void setConnectionId(const std::string& connectionId);
@@ -22,7 +22,6 @@
 #include <decaf/lang/Long.h>
 #include <decaf/lang/exceptions/NullPointerException.h>
 #include <decaf/util/HashCode.h>
-#include <sstream>
 
 using namespace std;
 using namespace activemq;
@@ -44,46 +43,52 @@ using namespace decaf::internal::util;
 
 ////////////////////////////////////////////////////////////////////////////////
 MessageId::MessageId() :
-    BaseDataStructure(), textView(""), producerId(NULL), producerSequenceId(0), brokerSequenceId(0), key("") {
+    BaseDataStructure(), textView(""), producerId(NULL), producerSequenceId(0), brokerSequenceId(0), key(""), hashCode(0) {
 
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 MessageId::MessageId(const MessageId& other) :
-    BaseDataStructure(), textView(""), producerId(NULL), producerSequenceId(0), brokerSequenceId(0), key("") {
+    BaseDataStructure(), textView(""), producerId(NULL), producerSequenceId(0), brokerSequenceId(0), key(""), hashCode(0) {
 
     this->copyDataStructure(&other);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 MessageId::MessageId(const std::string& messageKey) :
-    BaseDataStructure(), textView(""), producerId(NULL), producerSequenceId(0), brokerSequenceId(0), key("") {
+    BaseDataStructure(), textView(""), producerId(NULL), producerSequenceId(0), brokerSequenceId(0), key(""), hashCode(0) {
 
     this->setValue(messageKey);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 MessageId::MessageId(const Pointer<ProducerInfo>& producerInfo, long long producerSequenceId) :
-    BaseDataStructure(), textView(""), producerId(NULL), producerSequenceId(0), brokerSequenceId(0), key("") {
+    BaseDataStructure(), textView(""), producerId(NULL), producerSequenceId(0), brokerSequenceId(0), key(""), hashCode(0) {
 
     this->producerId = producerInfo->getProducerId();
     this->producerSequenceId = producerSequenceId;
+
+    this->updateKey();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 MessageId::MessageId(const Pointer<ProducerId>& producerId, long long producerSequenceId) :
-    BaseDataStructure(), textView(""), producerId(NULL), producerSequenceId(0), brokerSequenceId(0), key("") {
+    BaseDataStructure(), textView(""), producerId(NULL), producerSequenceId(0), brokerSequenceId(0), key(""), hashCode(0) {
 
     this->producerId = producerId;
     this->producerSequenceId = producerSequenceId;
+
+    this->updateKey();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 MessageId::MessageId(const std::string& producerId, long long producerSequenceId) :
-    BaseDataStructure(), textView(""), producerId(NULL), producerSequenceId(0), brokerSequenceId(0), key("") {
+    BaseDataStructure(), textView(""), producerId(NULL), producerSequenceId(0), brokerSequenceId(0), key(""), hashCode(0) {
 
     this->producerId.reset(new ProducerId(producerId));
     this->producerSequenceId = producerSequenceId;
+
+    this->updateKey();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -123,6 +128,13 @@ void MessageId::copyDataStructure(const DataStructure* src) {
     this->setProducerId(srcPtr->getProducerId());
     this->setProducerSequenceId(srcPtr->getProducerSequenceId());
     this->setBrokerSequenceId(srcPtr->getBrokerSequenceId());
+
+    if (srcPtr->isKeyCurrent()) {
+        this->key = srcPtr->key;
+        this->hashCode = srcPtr->hashCode;
+    } else {
+        this->updateKey();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -133,20 +145,19 @@ unsigned char MessageId::getDataStructureType() const {
 ////////////////////////////////////////////////////////////////////////////////
 std::string MessageId::toString() const {
 
-    if (key.empty()) {
-        if (!textView.empty()) {
-            if (textView.find_first_of("ID:") == 0) {
-                key = textView;
-            } else {
-                key = "ID:" + textView;
-            }
+    if (!textView.empty()) {
+        if (textView.find_first_of("ID:") == 0) {
+            return textView;
         } else {
-            this->key = this->producerId->toString() + ":" + 
-                        Long::toString(this->producerSequenceId);
+            return "ID:" + textView;
         }
     }
 
-    return this->key;
+    if (this->isKeyCurrent()) {
+        return this->key;
+    }
+
+    return this->formatKey();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -197,6 +208,7 @@ std::string& MessageId::getTextView() {
 ////////////////////////////////////////////////////////////////////////////////
 void MessageId::setTextView(const std::string& textView) {
     this->textView = textView;
+    this->key.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -212,6 +224,7 @@ decaf::lang::Pointer<ProducerId>& MessageId::getProducerId() {
 ////////////////////////////////////////////////////////////////////////////////
 void MessageId::setProducerId(const decaf::lang::Pointer<ProducerId>& producerId) {
     this->producerId = producerId;
+    this->key.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -222,6 +235,7 @@ long long MessageId::getProducerSequenceId() const {
 ////////////////////////////////////////////////////////////////////////////////
 void MessageId::setProducerSequenceId(long long producerSequenceId) {
     this->producerSequenceId = producerSequenceId;
+    this->key.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -241,7 +255,8 @@ int MessageId::compareTo(const MessageId& value) const {
         return 0;
     }
 
-    int textViewComp = StringUtils::compareIgnoreCase(this->textView.c_str(), value.textView.c_str());
+    int textViewComp = this->textView == value.textView ? 0 :
+        StringUtils::compareIgnoreCase(this->textView.c_str(), value.textView.c_str());
     if (textViewComp != 0) {
         return textViewComp;
     }
@@ -289,6 +304,16 @@ MessageId& MessageId::operator= (const MessageId& other) {
 
 ////////////////////////////////////////////////////////////////////////////////
 int MessageId::getHashCode() const {
+
+    if (this->producerId != NULL && this->textView.empty()) {
+
+        if (this->isKeyCurrent()) {
+            return this->hashCode;
+        }
+
+        return this->computeHashCode();
+    }
+
     return decaf::util::HashCode<std::string>()(this->toString());
 }
 
@@ -306,6 +331,58 @@ void MessageId::setValue(const std::string& key) {
     }
 
     this->producerId.reset(new ProducerId(messageKey));
-    this->key = messageKey;
+    this->updateKey();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageId::afterUnmarshal(wireformat::WireFormat* wireFormat AMQCPP_UNUSED) {
+    this->updateKey();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageId::updateKey() {
+
+    if (this->producerId == NULL || !this->textView.empty()) {
+        this->key.clear();
+        return;
+    }
+
+    this->key = this->formatKey();
+    this->hashCode = this->computeHashCode();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool MessageId::isKeyCurrent() const {
+
+    if (this->key.empty() || this->producerId == NULL || !this->producerId->isKeyCurrent()) {
+        return false;
+    }
+
+    const std::string& producerKey = this->producerId->key;
+    return this->key.length() > producerKey.length() && this->key[producerKey.length()] == ':' &&
+           this->key.compare(0, producerKey.length(), producerKey) == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string MessageId::formatKey() const {
+
+    std::string sequence = Long::toString(this->producerSequenceId);
+
+    std::string result;
+    if (this->producerId->isKeyCurrent()) {
+        result.reserve(this->producerId->key.length() + sequence.length() + 1);
+        result.append(this->producerId->key);
+    } else {
+        result = this->producerId->toString();
+    }
+    result.append(1, ':').append(sequence);
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int MessageId::computeHashCode() const {
+    int result = this->producerId->getHashCode();
+    return 31 * result + decaf::util::HashCode<long long>()(this->producerSequenceId);
 }
 
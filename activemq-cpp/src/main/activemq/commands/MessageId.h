@@ -62,7 +62,20 @@ namespace commands {
 
     private:
 
-        mutable std::string key;
+        // Formatted key and hash code, built from the producer id's key once all fields
+        // are known by the constructors, copyDataStructure, setValue and afterUnmarshal,
+        // the setters only discard them so the const accessors never write.  They are
+        // only used while the key still starts with the producer id's current key.
+        std::string key;
+        int hashCode;
+
+        void updateKey();
+
+        bool isKeyCurrent() const;
+
+        std::string formatKey() const;
+
+        int computeHashCode() const;
 
     public:
 
@@ -92,6 +105,8 @@ namespace commands {
 
         void setValue(const std::string& key);
 
+        virtual void afterUnmarshal(wireformat::WireFormat* wireFormat);
+
         virtual const std::string& getTextView() const;
         virtual std::string& getTextView();
         virtual void setTextView(const std::string& textView);
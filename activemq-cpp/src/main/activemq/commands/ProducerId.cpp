@@ -18,11 +18,11 @@
 #include <activemq/commands/ProducerId.h>
 #include <activemq/exceptions/ActiveMQException.h>
 #include <activemq/state/CommandVisitor.h>
+#include <activemq/util/IdPrefixTable.h>
 #include <decaf/internal/util/StringUtils.h>
 #include <decaf/lang/Long.h>
 #include <decaf/lang/exceptions/NullPointerException.h>
 #include <decaf/util/HashCode.h>
-#include <sstream>
 
 using namespace std;
 using namespace activemq;
@@ -44,29 +44,32 @@ using namespace decaf::internal::util;
 
 ////////////////////////////////////////////////////////////////////////////////
 ProducerId::ProducerId() :
-    BaseDataStructure(), connectionId(""), value(0), sessionId(0), parentId() {
+    BaseDataStructure(), connectionId(""), value(0), sessionId(0), parentId(), prefix(), key(""), hashCode(0) {
 
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ProducerId::ProducerId(const ProducerId& other) :
-    BaseDataStructure(), connectionId(""), value(0), sessionId(0), parentId() {
+    BaseDataStructure(), connectionId(""), value(0), sessionId(0), parentId(), prefix(), key(""), hashCode(0) {
 
     this->copyDataStructure(&other);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ProducerId::ProducerId( const SessionId& sessionId, long long consumerId ) : 
-    BaseDataStructure(), connectionId(""), value(0), sessionId(0), parentId() {
+    BaseDataStructure(), connectionId(""), value(0), sessionId(0), parentId(), prefix(), key(""), hashCode(0) {
 
     this->connectionId = sessionId.getConnectionId();
     this->sessionId = sessionId.getValue();
     this->value = consumerId;
+
+    this->prefix = sessionId.prefix;
+    this->updateKey();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ProducerId::ProducerId(std::string producerKey) :
-    BaseDataStructure(), connectionId(""), value(0), sessionId(0), parentId() {
+    BaseDataStructure(), connectionId(""), value(0), sessionId(0), parentId(), prefix(), key(""), hashCode(0) {
 
     // Parse off the producerId
     std::size_t p = producerKey.rfind( ':' );
@@ -115,6 +118,14 @@ void ProducerId::copyDataStructure(const DataStructure* src) {
     this->setConnectionId(srcPtr->getConnectionId());
     this->setValue(srcPtr->getValue());
     this->setSessionId(srcPtr->getSessionId());
+
+    if (srcPtr->isKeyCurrent()) {
+        this->prefix = srcPtr->prefix;
+        this->key = srcPtr->key;
+        this->hashCode = srcPtr->hashCode;
+    } else {
+        this->updateKey();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -125,13 +136,11 @@ unsigned char ProducerId::getDataStructureType() const {
 ////////////////////////////////////////////////////////////////////////////////
 std::string ProducerId::toString() const {
 
-    ostringstream stream;
-
-    stream << this->connectionId << ":"
-           << this->sessionId << ":"
-           << this->value;
+    if (this->isKeyCurrent()) {
+        return this->key;
+    }
 
-    return stream.str();
+    return this->formatKey();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -175,6 +184,7 @@ std::string& ProducerId::getConnectionId() {
 ////////////////////////////////////////////////////////////////////////////////
 void ProducerId::setConnectionId(const std::string& connectionId) {
     this->connectionId = connectionId;
+    this->prefix.reset();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -185,6 +195,7 @@ long long ProducerId::getValue() const {
 ////////////////////////////////////////////////////////////////////////////////
 void ProducerId::setValue(long long value) {
     this->value = value;
+    this->prefix.reset();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -195,6 +206,7 @@ long long ProducerId::getSessionId() const {
 ////////////////////////////////////////////////////////////////////////////////
 void ProducerId::setSessionId(long long sessionId) {
     this->sessionId = sessionId;
+    this->prefix.reset();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -204,7 +216,8 @@ int ProducerId::compareTo(const ProducerId& value) const {
         return 0;
     }
 
-    int connectionIdComp = StringUtils::compareIgnoreCase(this->connectionId.c_str(), value.connectionId.c_str());
+    int connectionIdComp = this->connectionId == value.connectionId ? 0 :
+        StringUtils::compareIgnoreCase(this->connectionId.c_str(), value.connectionId.c_str());
     if (connectionIdComp != 0) {
         return connectionIdComp;
     }
@@ -247,7 +260,12 @@ ProducerId& ProducerId::operator= (const ProducerId& other) {
 
 ////////////////////////////////////////////////////////////////////////////////
 int ProducerId::getHashCode() const {
-    return decaf::util::HashCode<std::string>()(this->toString());
+
+    if (this->isKeyCurrent()) {
+        return this->hashCode;
+    }
+
+    return this->computeHashCode();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -271,4 +289,46 @@ void ProducerId::setProducerSessionKey( std::string sessionKey ) {
 
     // The rest is the value
     this->connectionId = sessionKey;
+    this->updateKey();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProducerId::afterUnmarshal(wireformat::WireFormat* wireFormat AMQCPP_UNUSED) {
+    this->updateKey();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProducerId::updateKey() {
+
+    if (this->prefix == NULL || !this->prefix->matches(this->connectionId, this->sessionId)) {
+        this->prefix = activemq::util::IdPrefixTable::intern(this->connectionId, this->sessionId);
+    }
+
+    this->key = this->prefix->formatKey(this->value);
+    this->hashCode = this->prefix->hashKey(this->value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const std::string* ProducerId::getCachedKey() const {
+
+    if (this->isKeyCurrent()) {
+        return &this->key;
+    }
+
+    return NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ProducerId::isKeyCurrent() const {
+    return this->prefix != NULL && this->prefix->matches(this->connectionId, this->sessionId);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string ProducerId::formatKey() const {
+    return activemq::util::IdPrefix(this->connectionId, this->sessionId).formatKey(this->value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ProducerId::computeHashCode() const {
+    return activemq::util::IdPrefix(this->connectionId, this->sessionId).hashKey(this->value);
 }
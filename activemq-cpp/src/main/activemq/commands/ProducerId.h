@@ -26,6 +26,7 @@
 #include <activemq/commands/BaseDataStructure.h>
 #include <activemq/commands/SessionId.h>
 #include <activemq/util/Config.h>
+#include <activemq/util/IdPrefix.h>
 #include <decaf/lang/Comparable.h>
 #include <decaf/lang/Pointer.h>
 #include <string>
@@ -62,6 +63,25 @@ namespace commands {
 
         mutable Pointer<SessionId> parentId;
 
+        // Interned session prefix, formatted key and hash code.  They are built once all
+        // fields are known by the constructors, copyDataStructure and afterUnmarshal, the
+        // setters only discard them so the const accessors never write.  Edits made
+        // through the non-const getConnectionId no longer match the prefix.
+        Pointer<const activemq::util::IdPrefix> prefix;
+        std::string key;
+        int hashCode;
+
+        void updateKey();
+
+        bool isKeyCurrent() const;
+
+        std::string formatKey() const;
+
+        int computeHashCode() const;
+
+        friend class SessionId;
+        friend class MessageId;
+
     public:
 
         ProducerId();
@@ -88,6 +108,18 @@ namespace commands {
 
         void setProducerSessionKey(std::string sessionKey);
 
+        virtual void afterUnmarshal(wireformat::WireFormat* wireFormat);
+
+        /**
+         * Returns the key built for this id without copying it, the text is the same
+         * as the value returned from toString.
+         *
+         * @return the cached key or NULL if the id was changed since the key was built.
+         *
+         * @since 3.10
+         */
+        const std::string* getCachedKey() const;
+
         virtual const std::string& getConnectionId() const;
         virtual std::string& getConnectionId();
         virtual void setConnectionId(const std::string& connectionId);
@@ -21,10 +21,11 @@
 #include <activemq/commands/SessionId.h>
 #include <activemq/exceptions/ActiveMQException.h>
 #include <activemq/state/CommandVisitor.h>
+#include <activemq/util/IdPrefixTable.h>
 #include <decaf/internal/util/StringUtils.h>
+#include <decaf/lang/Long.h>
 #include <decaf/lang/exceptions/NullPointerException.h>
 #include <decaf/util/HashCode.h>
-#include <sstream>
 
 using namespace std;
 using namespace activemq;
@@ -46,39 +47,47 @@ using namespace decaf::internal::util;
 
 ////////////////////////////////////////////////////////////////////////////////
 SessionId::SessionId() :
-    BaseDataStructure(), connectionId(""), value(0), parentId() {
+    BaseDataStructure(), connectionId(""), value(0), parentId(), prefix() {
 
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 SessionId::SessionId(const SessionId& other) :
-    BaseDataStructure(), connectionId(""), value(0), parentId() {
+    BaseDataStructure(), connectionId(""), value(0), parentId(), prefix() {
 
     this->copyDataStructure(&other);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 SessionId::SessionId(const ConnectionId* connectionId, long long sessionId) :
-    BaseDataStructure(), connectionId(""), value(0), parentId() {
+    BaseDataStructure(), connectionId(""), value(0), parentId(), prefix() {
 
     this->connectionId = connectionId->getValue();
     this->value = sessionId;
+
+    this->updateKey();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 SessionId::SessionId(const ProducerId* producerId) :
-    BaseDataStructure(), connectionId(""), value(0), parentId() {
+    BaseDataStructure(), connectionId(""), value(0), parentId(), prefix() {
 
     this->connectionId = producerId->getConnectionId();
     this->value = producerId->getSessionId();
+
+    this->prefix = producerId->prefix;
+    this->updateKey();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 SessionId::SessionId(const ConsumerId* consumerId) :
-    BaseDataStructure(), connectionId(""), value(0), parentId() {
+    BaseDataStructure(), connectionId(""), value(0), parentId(), prefix() {
 
     this->connectionId = consumerId->getConnectionId();
     this->value = consumerId->getSessionId();
+
+    this->prefix = consumerId->prefix;
+    this->updateKey();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -116,6 +125,12 @@ void SessionId::copyDataStructure(const DataStructure* src) {
 
     this->setConnectionId(srcPtr->getConnectionId());
     this->setValue(srcPtr->getValue());
+
+    if (srcPtr->isKeyCurrent()) {
+        this->prefix = srcPtr->prefix;
+    } else {
+        this->updateKey();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -126,11 +141,11 @@ unsigned char SessionId::getDataStructureType() const {
 ////////////////////////////////////////////////////////////////////////////////
 std::string SessionId::toString() const {
 
-    ostringstream stream;
-
-    stream << this->connectionId << ":" << this->value;
+    if (this->isKeyCurrent()) {
+        return this->prefix->getText();
+    }
 
-    return stream.str();
+    return this->formatKey();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -171,6 +186,7 @@ std::string& SessionId::getConnectionId() {
 ////////////////////////////////////////////////////////////////////////////////
 void SessionId::setConnectionId(const std::string& connectionId) {
     this->connectionId = connectionId;
+    this->prefix.reset();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -181,6 +197,7 @@ long long SessionId::getValue() const {
 ////////////////////////////////////////////////////////////////////////////////
 void SessionId::setValue(long long value) {
     this->value = value;
+    this->prefix.reset();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -190,7 +207,8 @@ int SessionId::compareTo(const SessionId& value) const {
         return 0;
     }
 
-    int connectionIdComp = StringUtils::compareIgnoreCase(this->connectionId.c_str(), value.connectionId.c_str());
+    int connectionIdComp = this->connectionId == value.connectionId ? 0 :
+        StringUtils::compareIgnoreCase(this->connectionId.c_str(), value.connectionId.c_str());
     if (connectionIdComp != 0) {
         return connectionIdComp;
     }
@@ -227,7 +245,12 @@ SessionId& SessionId::operator= (const SessionId& other) {
 
 ////////////////////////////////////////////////////////////////////////////////
 int SessionId::getHashCode() const {
-    return decaf::util::HashCode<std::string>()(this->toString());
+
+    if (this->isKeyCurrent()) {
+        return this->prefix->getHashCode();
+    }
+
+    return this->computeHashCode();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -238,3 +261,30 @@ const Pointer<ConnectionId>& SessionId::getParentId() const {
     return this->parentId;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void SessionId::afterUnmarshal(wireformat::WireFormat* wireFormat AMQCPP_UNUSED) {
+    this->updateKey();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SessionId::updateKey() {
+
+    if (this->prefix == NULL || !this->prefix->matches(this->connectionId, this->value)) {
+        this->prefix = activemq::util::IdPrefixTable::intern(this->connectionId, this->value);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool SessionId::isKeyCurrent() const {
+    return this->prefix != NULL && this->prefix->matches(this->connectionId, this->value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string SessionId::formatKey() const {
+    return activemq::util::IdPrefix(this->connectionId, this->value).getText();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int SessionId::computeHashCode() const {
+    return activemq::util::IdPrefix(this->connectionId, this->value).getHashCode();
+}
@@ -26,6 +26,7 @@
 #include <activemq/commands/BaseDataStructure.h>
 #include <activemq/commands/ConnectionId.h>
 #include <activemq/util/Config.h>
+#include <activemq/util/IdPrefix.h>
 #include <decaf/lang/Comparable.h>
 #include <decaf/lang/Pointer.h>
 #include <string>
@@ -64,6 +65,23 @@ namespace commands {
 
         mutable Pointer<ConnectionId> parentId;
 
+        // Interned prefix, which is this id's key and hash code.  It is found once all
+        // fields are known by the constructors, copyDataStructure and afterUnmarshal, the
+        // setters only discard it so the const accessors never write.  Edits made
+        // through the non-const getConnectionId no longer match the prefix.
+        Pointer<const activemq::util::IdPrefix> prefix;
+
+        void updateKey();
+
+        bool isKeyCurrent() const;
+
+        std::string formatKey() const;
+
+        int computeHashCode() const;
+
+        friend class ProducerId;
+        friend class ConsumerId;
+
     public:
 
         SessionId();
@@ -90,6 +108,8 @@ namespace commands {
 
         const Pointer<ConnectionId>& getParentId() const;
 
+        virtual void afterUnmarshal(wireformat::WireFormat* wireFormat);
+
         virtual const std::string& getConnectionId() const;
         virtual std::string& getConnectionId();
         virtual void setConnectionId(const std::string& connectionId);
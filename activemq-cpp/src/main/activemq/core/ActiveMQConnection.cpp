@@ -25,7 +25,9 @@
 #include <activemq/core/ActiveMQMessageAudit.h>
 #include <activemq/core/ActiveMQDestinationSource.h>
 #include <activemq/core/AdvisoryConsumer.h>
+#include <activemq/core/TopicFanOut.h>
 #include <activemq/core/ConnectionAudit.h>
+#include <activemq/core/MessageSpool.h>
 #include <activemq/core/kernels/ActiveMQSessionKernel.h>
 #include <activemq/core/kernels/ActiveMQProducerKernel.h>
 #include <activemq/core/policies/DefaultPrefetchPolicy.h>
@@ -35,6 +37,9 @@
 #include <activemq/exceptions/ConnectionFailedException.h>
 #include <activemq/util/CMSExceptionSupport.h>
 #include <activemq/util/IdGenerator.h>
+#include <activemq/util/BlockSequenceGenerator.h>
+#include <activemq/util/MetricsReporter.h>
+#include <activemq/transport/IOTransport.h>
 #include <activemq/transport/failover/FailoverTransport.h>
 #include <activemq/transport/ResponseCallback.h>
 #include <activemq/transport/DefaultTransportListener.h>
@@ -74,6 +79,8 @@
 #include <activemq/commands/SessionInfo.h>
 #include <activemq/commands/WireFormatInfo.h>
 
+#include <iostream>
+
 using namespace std;
 using namespace cms;
 using namespace activemq;
@@ -154,9 +161,9 @@ namespace core {
         Pointer<Scheduler> scheduler;
         Pointer<ExecutorService> executor;
 
-        util::LongSequenceGenerator sessionIds;
-        util::LongSequenceGenerator consumerIdGenerator;
-        util::LongSequenceGenerator tempDestinationIds;
+        util::BlockSequenceGenerator sessionIds;
+        util::BlockSequenceGenerator consumerIdGenerator;
+        util::BlockSequenceGenerator tempDestinationIds;
         util::LongSequenceGenerator localTransactionIds;
 
         std::string brokerURL;
@@ -193,6 +200,11 @@ namespace core {
         long long optimizedAckScheduledAckInterval;
         long long consumerFailoverRedeliveryWaitPeriod;
         bool consumerExpiryCheckEnabled;
+        bool topicFanOut;
+        bool metricsEnabled;
+        long long metricsReportInterval;
+        util::MetricsReporter::Format metricsReportFormat;
+        std::ostream* metricsReportStream;
 
         std::auto_ptr<PrefetchPolicy> defaultPrefetchPolicy;
         std::auto_ptr<RedeliveryPolicy> defaultRedeliveryPolicy;
@@ -207,6 +219,10 @@ namespace core {
         Pointer<AtomicInteger> protocolVersion;
         Pointer<CountDownLatch> brokerInfoReceived;
         Pointer<AdvisoryConsumer> advisoryConsumer;
+        Pointer<TopicFanOut> fanOut;
+        Pointer<util::MetricsRegistry> metrics;
+        util::MetricsReporter* metricsReporter;
+        decaf::util::concurrent::Mutex metricsMutex;
 
         Pointer<Exception> firstFailureError;
 
@@ -221,6 +237,14 @@ namespace core {
 
         ConnectionAudit connectionAudit;
 
+        std::string spoolDirectory;
+        int spoolSegmentSize;
+        Pointer<MessageSpool> spool;
+        decaf::util::concurrent::Mutex spoolMutex;
+        AtomicBoolean spoolEnabled;
+        AtomicBoolean transportInterrupted;
+        AtomicBoolean spoolReplayScheduled;
+
         ConnectionConfig(const Pointer<transport::Transport> transport,
                          const Pointer<decaf::util::Properties> properties) :
                              properties(properties),
@@ -263,6 +287,11 @@ namespace core {
                              optimizedAckScheduledAckInterval(0),
                              consumerFailoverRedeliveryWaitPeriod(0),
                              consumerExpiryCheckEnabled(true),
+                             topicFanOut(false),
+                             metricsEnabled(false),
+                             metricsReportInterval(0),
+                             metricsReportFormat(util::MetricsReporter::TEXT),
+                             metricsReportStream(&std::clog),
                              defaultPrefetchPolicy(NULL),
                              defaultRedeliveryPolicy(NULL),
                              exceptionListener(NULL),
@@ -273,13 +302,24 @@ namespace core {
                              transportInterruptionProcessingComplete(),
                              brokerInfoReceived(),
                              advisoryConsumer(),
+                             fanOut(),
+                             metrics(),
+                             metricsReporter(NULL),
+                             metricsMutex(),
                              firstFailureError(),
                              dispatchers(),
                              activeProducers(),
                              sessionsLock(),
                              activeSessions(),
                              transportListeners(),
-                             activeTempDestinations() {
+                             activeTempDestinations(),
+                             spoolDirectory(),
+                             spoolSegmentSize(MessageSpool::DEFAULT_SEGMENT_SIZE),
+                             spool(),
+                             spoolMutex(),
+                             spoolEnabled(),
+                             transportInterrupted(),
+                             spoolReplayScheduled() {
 
             this->defaultPrefetchPolicy.reset(new DefaultPrefetchPolicy());
             this->defaultRedeliveryPolicy.reset(new DefaultRedeliveryPolicy());
@@ -438,11 +478,34 @@ namespace core {
         }
     };
 
+    class ReplaySpoolRunnable : public Runnable {
+    private:
+
+        ActiveMQConnection* connection;
+
+    private:
+
+        ReplaySpoolRunnable(const ReplaySpoolRunnable&);
+        ReplaySpoolRunnable& operator= (const ReplaySpoolRunnable&);
+
+    public:
+
+        ReplaySpoolRunnable(ActiveMQConnection* connection) : Runnable(), connection(connection) {}
+        virtual ~ReplaySpoolRunnable() {}
+
+        virtual void run() {
+            try {
+                this->connection->replaySpool();
+            } catch(...) {}
+        }
+    };
+
     class AsyncResponseCallback : public ResponseCallback {
     private:
 
         ConnectionConfig* config;
         cms::AsyncCallback* callback;
+        Pointer<cms::AsyncCallback> owned;
 
     private:
 
@@ -452,7 +515,11 @@ namespace core {
     public:
 
         AsyncResponseCallback(ConnectionConfig* config, cms::AsyncCallback* callback) :
-            ResponseCallback(), config(config), callback(callback) {
+            ResponseCallback(), config(config), callback(callback), owned() {
+        }
+
+        AsyncResponseCallback(ConnectionConfig* config, const Pointer<cms::AsyncCallback>& callback) :
+            ResponseCallback(), config(config), callback(callback.get()), owned(callback) {
         }
 
         virtual ~AsyncResponseCallback() {
@@ -500,6 +567,7 @@ ActiveMQConnection::ActiveMQConnection(const Pointer<transport::Transport> trans
     configuration->connectionAudit.setCheckForDuplicates(transport->isFaultTolerant());
 
     this->config = configuration.release();
+    this->config->fanOut.reset(new TopicFanOut(this));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -573,9 +641,8 @@ cms::Session* ActiveMQConnection::createSession(cms::Session::AcknowledgeMode ac
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<SessionId> ActiveMQConnection::getNextSessionId() {
 
-    decaf::lang::Pointer<SessionId> sessionId(new SessionId());
-    sessionId->setConnectionId(this->config->connectionInfo->getConnectionId()->getValue());
-    sessionId->setValue(this->config->sessionIds.getNextSequenceId());
+    decaf::lang::Pointer<SessionId> sessionId(new SessionId(
+        this->config->connectionInfo->getConnectionId().get(), this->config->sessionIds.getNextSequenceId()));
 
     return sessionId;
 }
@@ -792,6 +859,21 @@ void ActiveMQConnection::close() {
             }
         }
 
+        // Whatever is still spooled stays on disk for the next run.
+        try {
+            synchronized(&this->config->spoolMutex) {
+                if (this->config->spool != NULL) {
+                    this->config->spool->close();
+                }
+            }
+        } catch (Exception& error) {
+            if (!hasException) {
+                ex = error;
+                ex.setMark(__FILE__, __LINE__);
+                hasException = true;
+            }
+        }
+
         // Once current deliveries are done this stops the delivery
         // of any new messages.
         this->started.set(false);
@@ -1072,6 +1154,12 @@ void ActiveMQConnection::onCommand(const Pointer<Command> command) {
                         message->setReadOnlyProperties(true);
                         message->setRedeliveryCounter(dispatch->getRedeliveryCounter());
                         message->setConnection(this);
+
+                        util::MetricsRegistry* metrics = getMetrics();
+                        if (metrics != NULL) {
+                            metrics->increment(util::MetricsRegistry::MESSAGES_RECEIVED);
+                            metrics->increment(util::MetricsRegistry::BYTES_RECEIVED, message->getSize());
+                        }
                     }
 
                     dispatcher->dispatch(dispatch);
@@ -1086,9 +1174,11 @@ void ActiveMQConnection::onCommand(const Pointer<Command> command) {
             Pointer<ActiveMQProducerKernel> producer;
             synchronized(&this->config->activeProducers) {
                 producer = this->config->activeProducers.get(producerAck->getProducerId());
-                if (producer != NULL) {
-                    producer->onProducerAck(*producerAck);
-                }
+            }
+
+            // The ack can notify a ProducerWindowListener, don't hold the lock while it runs.
+            if (producer != NULL) {
+                producer->onProducerAck(*producerAck);
             }
 
         } else if (command->isWireFormatInfo()) {
@@ -1125,9 +1215,18 @@ void ActiveMQConnection::onCommand(const Pointer<Command> command) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void ActiveMQConnection::onWireFormatInfo(Pointer<commands::Command> command AMQCPP_UNUSED) {
-    this->config->brokerWireFormatInfo = command.dynamicCast<WireFormatInfo>();
-    this->config->protocolVersion->set(this->config->brokerWireFormatInfo->getVersion());
+void ActiveMQConnection::onWireFormatInfo(Pointer<commands::Command> command) {
+
+    Pointer<WireFormatInfo> info = command.dynamicCast<WireFormatInfo>();
+
+    // Some WireFormats hand settings to the Transport this way, those aren't from the broker.
+    const activemq::util::PrimitiveMap& properties = info->getProperties();
+    if (properties.containsKey("TransportOnly") && properties.getBool("TransportOnly")) {
+        return;
+    }
+
+    this->config->brokerWireFormatInfo = info;
+    this->config->protocolVersion->set(info->getVersion());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1211,8 +1310,11 @@ void ActiveMQConnection::onClientInternalException(const decaf::lang::Exception&
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQConnection::transportInterrupted() {
 
+    this->config->transportInterrupted.set(true);
     this->config->transportInterruptionProcessingComplete->set(0);
 
+    this->config->fanOut->transportInterrupted();
+
     this->config->sessionsLock.readLock().lock();
     try {
         std::auto_ptr<Iterator<Pointer<ActiveMQSessionKernel> > > sessions(this->config->activeSessions.iterator());
@@ -1239,6 +1341,14 @@ void ActiveMQConnection::transportInterrupted() {
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQConnection::transportResumed() {
 
+    this->config->transportInterrupted.set(false);
+
+    util::MetricsRegistry* metrics = getMetrics();
+    if (metrics != NULL) {
+        metrics->increment(util::MetricsRegistry::RECONNECTS);
+        attachTransportMetrics();
+    }
+
     synchronized(&this->config->transportListeners) {
         Pointer<Iterator<TransportListener*> > iter(this->config->transportListeners.iterator());
         while (iter->hasNext()) {
@@ -1248,6 +1358,8 @@ void ActiveMQConnection::transportResumed() {
             }
         }
     }
+
+    this->scheduleSpoolReplay();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1315,6 +1427,28 @@ void ActiveMQConnection::asyncRequest(Pointer<Command> command, cms::AsyncCallba
     AMQ_CATCHALL_THROW(ActiveMQException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::asyncRequest(Pointer<Command> command, const Pointer<cms::AsyncCallback>& onComplete) {
+
+    try {
+
+        if (onComplete == NULL) {
+            this->syncRequest(command);
+            return;
+        }
+
+        checkClosedOrFailed();
+
+        Pointer<ResponseCallback> callback(new AsyncResponseCallback(this->config, onComplete));
+        this->config->transport->asyncRequest(command, callback);
+    }
+    AMQ_CATCH_RETHROW(ActiveMQException)
+    AMQ_CATCH_EXCEPTION_CONVERT(IOException, ActiveMQException)
+    AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::exceptions::UnsupportedOperationException, ActiveMQException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, ActiveMQException)
+    AMQ_CATCHALL_THROW(ActiveMQException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQConnection::checkClosed() const {
     if (this->isClosed()) {
@@ -1358,12 +1492,13 @@ void ActiveMQConnection::ensureConnectionInfoSent() {
 
             this->config->isConnectionInfoSentToBroker = true;
 
-            Pointer<SessionId> sessionId(new SessionId(this->config->connectionInfo->getConnectionId().get(), -1));
-            Pointer<ConsumerId> consumerId(new ConsumerId(*sessionId, this->config->consumerIdGenerator.getNextSequenceId()));
             if (this->config->watchTopicAdvisories) {
-                this->config->advisoryConsumer.reset(new AdvisoryConsumer(this, consumerId));
+                this->config->advisoryConsumer.reset(new AdvisoryConsumer(this, getNextConnectionConsumerId()));
             }
         }
+
+        // Forward anything an earlier run left in the spool now that the broker knows us.
+        this->scheduleSpoolReplay();
     }
     AMQ_CATCH_RETHROW(ActiveMQException)
     AMQ_CATCH_EXCEPTION_CONVERT(Exception, ActiveMQException)
@@ -1960,3 +2095,325 @@ bool ActiveMQConnection::isConsumerExpiryCheckEnabled() {
 void ActiveMQConnection::setConsumerExpiryCheckEnabled(bool consumerExpiryCheckEnabled) {
     this->config->consumerExpiryCheckEnabled = consumerExpiryCheckEnabled;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+std::string ActiveMQConnection::getSpoolDirectory() const {
+    return this->config->spoolDirectory;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setSpoolDirectory(const std::string& directory) {
+
+    try {
+
+        synchronized(&this->config->spoolMutex) {
+
+            this->config->spoolEnabled.set(false);
+
+            if (this->config->spool != NULL) {
+                this->config->spool->close();
+                this->config->spool.reset(NULL);
+            }
+
+            this->config->spoolDirectory = directory;
+
+            if (!directory.empty()) {
+                Pointer<MessageSpool> spool(new MessageSpool(directory, this->config->spoolSegmentSize));
+                spool->open();
+                this->config->spool = spool;
+                this->config->spoolEnabled.set(true);
+            }
+        }
+
+        if (this->config->isConnectionInfoSentToBroker) {
+            this->scheduleSpoolReplay();
+        }
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQConnection::getSpoolSegmentSize() const {
+    return this->config->spoolSegmentSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setSpoolSegmentSize(int segmentSize) {
+    this->config->spoolSegmentSize = segmentSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQConnection::getSpooledMessageCount() const {
+
+    synchronized(&this->config->spoolMutex) {
+        if (this->config->spool != NULL && this->config->spool->isOpen()) {
+            return this->config->spool->size();
+        }
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnection::isTopicFanOut() const {
+    return this->config->topicFanOut;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setTopicFanOut(bool topicFanOut) {
+    this->config->topicFanOut = topicFanOut;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TopicFanOut* ActiveMQConnection::getTopicFanOut() const {
+    return this->config->fanOut.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+activemq::util::MetricsRegistry* ActiveMQConnection::getMetrics() const {
+
+    if (!this->config->metricsEnabled) {
+        return NULL;
+    }
+
+    return this->config->metrics.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnection::isMetricsEnabled() const {
+    return this->config->metricsEnabled;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setMetricsEnabled(bool metricsEnabled) {
+
+    synchronized(&this->config->metricsMutex) {
+
+        // The registry is never released once created so the hot paths can use it
+        // without holding a reference of their own.
+        if (metricsEnabled && this->config->metrics == NULL) {
+            this->config->metrics.reset(new util::MetricsRegistry());
+        }
+
+        this->config->metricsEnabled = metricsEnabled;
+    }
+
+    attachTransportMetrics();
+    updateMetricsReporter();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+activemq::util::MetricsSnapshot ActiveMQConnection::getMetricsSnapshot() const {
+
+    synchronized(&this->config->metricsMutex) {
+        if (this->config->metrics != NULL) {
+            return this->config->metrics->snapshot();
+        }
+    }
+
+    return util::MetricsSnapshot();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long ActiveMQConnection::getMetricsReportInterval() const {
+    return this->config->metricsReportInterval;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setMetricsReportInterval(long long interval) {
+    this->config->metricsReportInterval = interval;
+    updateMetricsReporter();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string ActiveMQConnection::getMetricsReportFormat() const {
+    return this->config->metricsReportFormat == util::MetricsReporter::JSON ? "json" : "text";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setMetricsReportFormat(const std::string& format) {
+    this->config->metricsReportFormat = util::MetricsReporter::parseFormat(format);
+    updateMetricsReporter();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setMetricsReportStream(std::ostream* stream) {
+    this->config->metricsReportStream = stream;
+    updateMetricsReporter();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::updateMetricsReporter() {
+
+    try {
+
+        synchronized(&this->config->metricsMutex) {
+
+            Pointer<Scheduler> scheduler = this->config->scheduler;
+            if (scheduler == NULL || !scheduler->isStarted()) {
+                return;
+            }
+
+            // The scheduler owns the reporter and destroys it once cancelled.
+            if (this->config->metricsReporter != NULL) {
+                scheduler->cancel(this->config->metricsReporter);
+                this->config->metricsReporter = NULL;
+            }
+
+            if (this->config->metricsEnabled && this->config->metricsReportInterval > 0 &&
+                this->config->metricsReportStream != NULL) {
+
+                this->config->metricsReporter = new util::MetricsReporter(
+                    this->config->metrics, this->config->metricsReportStream, this->config->metricsReportFormat);
+                scheduler->executePeriodically(this->config->metricsReporter, this->config->metricsReportInterval);
+            }
+        }
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::attachTransportMetrics() {
+
+    try {
+
+        IOTransport* ioTransport = dynamic_cast<IOTransport*>(this->config->transport->narrow(typeid(IOTransport)));
+        if (ioTransport != NULL) {
+            ioTransport->setMetrics(getMetrics());
+        }
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<ConsumerId> ActiveMQConnection::getNextConnectionConsumerId() {
+    SessionId sessionId(this->config->connectionInfo->getConnectionId().get(), -1);
+    return Pointer<ConsumerId>(new ConsumerId(sessionId, this->config->consumerIdGenerator.getNextSequenceId()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnection::spoolMessage(const Pointer<commands::Message>& message) {
+
+    try {
+
+        // Cheap test for the common case where spooling isn't enabled.
+        if (!this->config->spoolEnabled.get()) {
+            return false;
+        }
+
+        synchronized(&this->config->spoolMutex) {
+
+            Pointer<MessageSpool> spool = this->config->spool;
+            if (spool == NULL || !spool->isOpen()) {
+                return false;
+            }
+
+            // While older messages wait in the spool new ones must queue up behind them.
+            if (!this->config->transportInterrupted.get() && spool->isEmpty()) {
+                return false;
+            }
+
+            // The producer is told the send succeeded, so the record has to survive
+            // a crash of the machine and not only of this process.
+            spool->append(message);
+            spool->sync();
+        }
+
+        if (!this->config->transportInterrupted.get()) {
+            this->scheduleSpoolReplay();
+        }
+
+        return true;
+    }
+    AMQ_CATCH_RETHROW(ActiveMQException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, ActiveMQException)
+    AMQ_CATCHALL_THROW(ActiveMQException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::scheduleSpoolReplay() {
+
+    if (!this->config->spoolEnabled.get() || this->config->transportInterrupted.get() || this->closing.get()) {
+        return;
+    }
+
+    if (this->getSpooledMessageCount() == 0) {
+        return;
+    }
+
+    if (this->config->spoolReplayScheduled.compareAndSet(false, true)) {
+        try {
+            this->config->executor->execute(new ReplaySpoolRunnable(this));
+        } catch (Exception& ex) {
+            this->config->spoolReplayScheduled.set(false);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::replaySpool() {
+
+    // Cleared first so that a resume that arrives while this runs queues another pass.
+    this->config->spoolReplayScheduled.set(false);
+
+    while (true) {
+        try {
+            if (!this->forwardSpooledMessage()) {
+                return;
+            }
+        } catch (Exception& ex) {
+            // An unreadable record was dropped, report it and carry on with the rest.
+            this->onAsyncException(ex);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnection::forwardSpooledMessage() {
+
+    Pointer<MessageSpool> spool;
+    Pointer<commands::Message> message;
+
+    synchronized(&this->config->spoolMutex) {
+
+        spool = this->config->spool;
+        if (spool == NULL || !spool->isOpen() || this->closing.get() || this->config->transportInterrupted.get()) {
+            return false;
+        }
+
+        message = spool->peek();
+        if (message == NULL) {
+            return false;
+        }
+    }
+
+    // The record stays in the spool until the broker has it, new sends see a non
+    // empty spool and queue up behind it so they can't overtake it.  The lock is not
+    // held while waiting on the broker so that producers only ever wait on the disk.
+    unsigned int timeout = this->config->sendTimeout > 0 ? this->config->sendTimeout : this->config->closeTimeout;
+
+    Pointer<Response> response;
+    try {
+        checkClosedOrFailed();
+        response = this->config->transport->request(message, timeout);
+    } catch (Exception& ex) {
+        // Left in the spool, the next resume forwards it again.
+        return false;
+    }
+
+    synchronized(&this->config->spoolMutex) {
+        if (spool != this->config->spool || !spool->isOpen()) {
+            return false;
+        }
+
+        spool->remove();
+    }
+
+    // A message the broker refused would block the spool forever if it was kept.
+    ExceptionResponse* exceptionResponse = dynamic_cast<ExceptionResponse*>(response.get());
+    if (exceptionResponse != NULL) {
+        throw exceptionResponse->getException()->createExceptionObject();
+    }
+
+    return true;
+}
@@ -26,6 +26,8 @@
 #include <activemq/commands/ConsumerInfo.h>
 #include <activemq/commands/SessionId.h>
 #include <activemq/exceptions/ActiveMQException.h>
+#include <activemq/util/MetricsRegistry.h>
+#include <activemq/util/MetricsSnapshot.h>
 #include <activemq/transport/Transport.h>
 #include <activemq/transport/TransportListener.h>
 #include <activemq/threads/Scheduler.h>
@@ -41,6 +43,7 @@
 
 #include <string>
 #include <memory>
+#include <ostream>
 
 namespace activemq {
 namespace core {
@@ -49,8 +52,10 @@ namespace core {
 
     class ActiveMQSession;
     class ConnectionConfig;
+    class MessageSpool;
     class PrefetchPolicy;
     class RedeliveryPolicy;
+    class TopicFanOut;
 
     /**
      * Concrete connection used for all connectors to the
@@ -163,6 +168,28 @@ namespace core {
          */
         virtual void removeDispatcher(const Pointer<commands::ConsumerId>& consumer);
 
+        /**
+         * Creates a ConsumerId for a consumer that belongs to this Connection rather than
+         * to one of its Sessions, such as the advisory consumer.
+         *
+         * @return a new ConsumerId unique within this Connection.
+         */
+        Pointer<commands::ConsumerId> getNextConnectionConsumerId();
+
+        /**
+         * @return the TopicFanOut that manages the topic subscriptions shared by this
+         *         Connection's consumers.
+         */
+        TopicFanOut* getTopicFanOut() const;
+
+        /**
+         * @return the registry that this Connection and the objects it owns record their
+         *         metrics in, or NULL when metrics are disabled.
+         *
+         * @since 3.10
+         */
+        util::MetricsRegistry* getMetrics() const;
+
         /**
          * If supported sends a message pull request to the service provider asking
          * for the delivery of a new message.  This is used in the case where the
@@ -822,6 +849,149 @@ namespace core {
          */
         void setConsumerExpiryCheckEnabled(bool consumerExpiryCheckEnabled);
 
+        /**
+         * @return the directory of the local message spool, empty when spooling is disabled.
+         */
+        std::string getSpoolDirectory() const;
+
+        /**
+         * Enables the local store and forward spool.  While the connection to the broker
+         * is interrupted, messages that would be sent asynchronously outside of a transaction
+         * and without a completion callback are appended to a memory mapped log in this
+         * directory and forced to disk instead of blocking the producer, once the connection
+         * is resumed they are forwarded to the broker in the order they were sent and each
+         * one is removed from the log when the broker acknowledges it.  Sends that wait for
+         * the broker's acknowledgement, such as persistent messages without useAsyncSend,
+         * are never spooled and keep blocking until the broker is reached, they can arrive
+         * at the broker ahead of messages that are still in the spool.  Messages left in the
+         * directory by an earlier run are recovered and forwarded as soon as this connection
+         * reaches the broker.  The directory must not be shared with another connection.
+         *
+         * @param directory
+         *      The directory that holds the spool files, empty to disable spooling.
+         *
+         * @throws CMSException if the spool can't be opened.
+         */
+        void setSpoolDirectory(const std::string& directory);
+
+        /**
+         * @return the size of each spool segment file.
+         */
+        int getSpoolSegmentSize() const;
+
+        /**
+         * Sets the size of the spool's segment files, this also limits the size of a single
+         * spooled message.  Must be set before the spool directory to take effect.
+         *
+         * @param segmentSize
+         *      The size in bytes of each segment file.
+         */
+        void setSpoolSegmentSize(int segmentSize);
+
+        /**
+         * @return the number of messages waiting in the local spool.
+         */
+        int getSpooledMessageCount() const;
+
+        /**
+         * @return true if identical non-durable topic subscriptions share one broker subscription.
+         *
+         * @since 3.10
+         */
+        bool isTopicFanOut() const;
+
+        /**
+         * Sets whether consumers created on this Connection for the same non-durable topic
+         * and selector share a single broker subscription.  The broker then sends each
+         * message once and it is handed to every matching consumer locally, each consumer
+         * still redelivers and acknowledges on its own.  Only affects consumers created
+         * after the change.  Disabled by default.
+         *
+         * @param topicFanOut
+         *      True to share identical topic subscriptions.
+         *
+         * @since 3.10
+         */
+        void setTopicFanOut(bool topicFanOut);
+
+        /**
+         * @return true if this Connection records metrics for its hot paths.
+         *
+         * @since 3.10
+         */
+        bool isMetricsEnabled() const;
+
+        /**
+         * Sets whether this Connection records counters and latency histograms for the
+         * messages and acks it sends and receives, reconnects, and the time spent in
+         * marshaling and in message listeners.  Disabled by default, in which case the
+         * hot paths do no extra work.  Values recorded before metrics are disabled are
+         * kept and reported again if they are enabled later.
+         *
+         * @param metricsEnabled
+         *      True to record metrics.
+         *
+         * @since 3.10
+         */
+        void setMetricsEnabled(bool metricsEnabled);
+
+        /**
+         * @return a snapshot of the metrics recorded so far, empty if metrics have never
+         *         been enabled.
+         *
+         * @since 3.10
+         */
+        util::MetricsSnapshot getMetricsSnapshot() const;
+
+        /**
+         * @return the interval in milliseconds at which metric snapshots are written to
+         *         the report stream, zero if they are never written.
+         *
+         * @since 3.10
+         */
+        long long getMetricsReportInterval() const;
+
+        /**
+         * Sets the interval in milliseconds at which a snapshot of this Connection's
+         * metrics is written to the report stream while metrics are enabled.
+         *
+         * @param interval
+         *      The report interval in milliseconds, zero disables periodic reports.
+         *
+         * @since 3.10
+         */
+        void setMetricsReportInterval(long long interval);
+
+        /**
+         * @return the format of periodic metric reports, either "text" or "json".
+         *
+         * @since 3.10
+         */
+        std::string getMetricsReportFormat() const;
+
+        /**
+         * Sets the format of periodic metric reports.
+         *
+         * @param format
+         *      Either "text" or "json".
+         *
+         * @throws IllegalArgumentException if the format is not known.
+         *
+         * @since 3.10
+         */
+        void setMetricsReportFormat(const std::string& format);
+
+        /**
+         * Sets the stream periodic metric reports are written to, std::clog by default.
+         * The stream is not owned by this Connection and must outlive it.
+         *
+         * @param stream
+         *      The stream to write reports to.
+         *
+         * @since 3.10
+         */
+        void setMetricsReportStream(std::ostream* stream);
+
         /**
          * @return the current connection's OpenWire protocol version.
          */
@@ -963,6 +1133,40 @@ namespace core {
          */
         void asyncRequest(Pointer<commands::Command> command, cms::AsyncCallback* onComplete);
 
+        /**
+         * Sends an asynchronous request, the connection keeps the callback alive until it
+         * has been notified of the outcome.
+         *
+         * @param command
+         *      The Command object that is to be sent to the broker.
+         * @param onComplete
+         *      Completion callback that will be notified on send success or failure.
+         *
+         * @throws ActiveMQException if an error occurs while sending the Command.
+         */
+        void asyncRequest(Pointer<commands::Command> command, const Pointer<cms::AsyncCallback>& onComplete);
+
+        /**
+         * Appends the message to the local spool when the connection to the broker is
+         * interrupted or when older spooled messages are still waiting to be forwarded,
+         * otherwise the message is left for the caller to send.  Only used for messages
+         * that the caller would send without waiting for a response.
+         *
+         * @param message
+         *      The message that is about to be sent.
+         *
+         * @return true if the message was spooled and must not be sent by the caller.
+         *
+         * @throws ActiveMQException if the message could not be written to the spool.
+         */
+        bool spoolMessage(const Pointer<commands::Message>& message);
+
+        /**
+         * Forwards the messages held in the local spool to the broker in order, stopping
+         * early if the connection is interrupted again.
+         */
+        void replaySpool();
+
         /**
          * Notify the exception listener
          * @param ex the exception to fire
@@ -1115,6 +1319,18 @@ namespace core {
         // Process the ConsumerControl command
         void onConsumerControl(Pointer<commands::Command> command);
 
+        // Queues a replay of the local spool on the Connection's executor if one isn't pending.
+        void scheduleSpoolReplay();
+
+        // Sends the oldest spooled message to the broker, false when there was nothing to send.
+        bool forwardSpooledMessage();
+
+        // Replaces the periodic metrics reporter to match the current metrics settings.
+        void updateMetricsReporter();
+
+        // Points the underlying IOTransport, if any, at the current metrics registry.
+        void attachTransportMetrics();
+
     };
 
 }}
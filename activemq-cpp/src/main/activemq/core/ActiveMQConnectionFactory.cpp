@@ -31,6 +31,7 @@
 #include <activemq/core/ActiveMQConnection.h>
 #include <activemq/core/ActiveMQConstants.h>
 #include <activemq/core/ActiveMQMessageAudit.h>
+#include <activemq/core/MessageSpool.h>
 #include <activemq/core/policies/DefaultPrefetchPolicy.h>
 #include <activemq/core/policies/DefaultRedeliveryPolicy.h>
 #include <activemq/util/URISupport.h>
@@ -100,6 +101,12 @@ namespace core{
         long long optimizedAckScheduledAckInterval;
         long long consumerFailoverRedeliveryWaitPeriod;
         bool consumerExpiryCheckEnabled;
+        bool topicFanOut;
+        bool metricsEnabled;
+        long long metricsReportInterval;
+        std::string metricsReportFormat;
+        std::string spoolDirectory;
+        int spoolSegmentSize;
 
         cms::ExceptionListener* defaultListener;
         cms::MessageTransformer* defaultTransformer;
@@ -136,6 +143,12 @@ namespace core{
                             optimizedAckScheduledAckInterval(0),
                             consumerFailoverRedeliveryWaitPeriod(0),
                             consumerExpiryCheckEnabled(true),
+                            topicFanOut(false),
+                            metricsEnabled(false),
+                            metricsReportInterval(0),
+                            metricsReportFormat("text"),
+                            spoolDirectory(),
+                            spoolSegmentSize(MessageSpool::DEFAULT_SEGMENT_SIZE),
                             defaultListener(NULL),
                             defaultTransformer(NULL),
                             defaultPrefetchPolicy(new DefaultPrefetchPolicy()),
@@ -224,6 +237,16 @@ namespace core{
                 properties->getProperty("connection.alwaysSessionAsync", Boolean::toString(alwaysSessionAsync)));
             this->consumerExpiryCheckEnabled = Boolean::parseBoolean(
                 properties->getProperty("connection.consumerExpiryCheckEnabled", Boolean::toString(consumerExpiryCheckEnabled)));
+            this->topicFanOut = Boolean::parseBoolean(
+                properties->getProperty("connection.topicFanOut", Boolean::toString(topicFanOut)));
+            this->metricsEnabled = Boolean::parseBoolean(
+                properties->getProperty("connection.metricsEnabled", Boolean::toString(metricsEnabled)));
+            this->metricsReportInterval = Long::parseLong(
+                properties->getProperty("connection.metricsReportInterval", Long::toString(metricsReportInterval)));
+            this->metricsReportFormat = properties->getProperty("connection.metricsReportFormat", metricsReportFormat);
+            this->spoolDirectory = properties->getProperty("connection.spoolDirectory", spoolDirectory);
+            this->spoolSegmentSize = Integer::parseInt(
+                properties->getProperty("connection.spoolSegmentSize", Integer::toString(spoolSegmentSize)));
 
             this->defaultPrefetchPolicy->configure(*properties);
             this->defaultRedeliveryPolicy->configure(*properties);
@@ -421,6 +444,14 @@ void ActiveMQConnectionFactory::configureConnection(ActiveMQConnection* connecti
     connection->setConsumerFailoverRedeliveryWaitPeriod(this->settings->consumerFailoverRedeliveryWaitPeriod);
     connection->setAlwaysSessionAsync(this->settings->alwaysSessionAsync);
     connection->setConsumerExpiryCheckEnabled(this->settings->consumerExpiryCheckEnabled);
+    connection->setTopicFanOut(this->settings->topicFanOut);
+    connection->setMetricsReportFormat(this->settings->metricsReportFormat);
+    connection->setMetricsReportInterval(this->settings->metricsReportInterval);
+    connection->setMetricsEnabled(this->settings->metricsEnabled);
+    connection->setSpoolSegmentSize(this->settings->spoolSegmentSize);
+    if (!this->settings->spoolDirectory.empty()) {
+        connection->setSpoolDirectory(this->settings->spoolDirectory);
+    }
 
     if (this->settings->defaultListener) {
         connection->setExceptionListener(this->settings->defaultListener);
@@ -762,3 +793,63 @@ bool ActiveMQConnectionFactory::isConsumerExpiryCheckEnabled() {
 void ActiveMQConnectionFactory::setConsumerExpiryCheckEnabled(bool consumerExpiryCheckEnabled) {
     this->settings->consumerExpiryCheckEnabled = consumerExpiryCheckEnabled;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnectionFactory::isTopicFanOut() const {
+    return this->settings->topicFanOut;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setTopicFanOut(bool topicFanOut) {
+    this->settings->topicFanOut = topicFanOut;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnectionFactory::isMetricsEnabled() const {
+    return this->settings->metricsEnabled;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setMetricsEnabled(bool metricsEnabled) {
+    this->settings->metricsEnabled = metricsEnabled;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long ActiveMQConnectionFactory::getMetricsReportInterval() const {
+    return this->settings->metricsReportInterval;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setMetricsReportInterval(long long interval) {
+    this->settings->metricsReportInterval = interval;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string ActiveMQConnectionFactory::getMetricsReportFormat() const {
+    return this->settings->metricsReportFormat;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setMetricsReportFormat(const std::string& format) {
+    this->settings->metricsReportFormat = format;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string ActiveMQConnectionFactory::getSpoolDirectory() const {
+    return this->settings->spoolDirectory;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setSpoolDirectory(const std::string& directory) {
+    this->settings->spoolDirectory = directory;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ActiveMQConnectionFactory::getSpoolSegmentSize() const {
+    return this->settings->spoolSegmentSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setSpoolSegmentSize(int segmentSize) {
+    this->settings->spoolSegmentSize = segmentSize;
+}
@@ -672,6 +672,108 @@ namespace core {
          */
         void setConsumerExpiryCheckEnabled(bool consumerExpiryCheckEnabled);
 
+        /**
+         * @return true if Connections share one broker subscription between identical
+         *         non-durable topic consumers.
+         *
+         * @since 3.10
+         */
+        bool isTopicFanOut() const;
+
+        /**
+         * Sets whether Connections created by this factory let consumers of the same
+         * non-durable topic and selector share a single broker subscription, messages are
+         * then received once and handed to each consumer locally.  Disabled by default.
+         *
+         * @param topicFanOut
+         *      True to share identical topic subscriptions.
+         *
+         * @since 3.10
+         */
+        void setTopicFanOut(bool topicFanOut);
+
+        /**
+         * @return true if Connections created by this factory record metrics.
+         *
+         * @since 3.10
+         */
+        bool isMetricsEnabled() const;
+
+        /**
+         * Sets whether Connections created by this factory record counters and latency
+         * histograms for their hot paths.  Disabled by default.
+         *
+         * @param metricsEnabled
+         *      True to record metrics.
+         *
+         * @since 3.10
+         */
+        void setMetricsEnabled(bool metricsEnabled);
+
+        /**
+         * @return the interval in milliseconds at which Connections report their metrics.
+         *
+         * @since 3.10
+         */
+        long long getMetricsReportInterval() const;
+
+        /**
+         * Sets the interval in milliseconds at which Connections created by this factory
+         * write a snapshot of their metrics to std::clog, zero disables periodic reports.
+         *
+         * @param interval
+         *      The report interval in milliseconds.
+         *
+         * @since 3.10
+         */
+        void setMetricsReportInterval(long long interval);
+
+        /**
+         * @return the format of periodic metric reports.
+         *
+         * @since 3.10
+         */
+        std::string getMetricsReportFormat() const;
+
+        /**
+         * Sets the format of periodic metric reports, either "text" or "json".
+         *
+         * @param format
+         *      The report format.
+         *
+         * @since 3.10
+         */
+        void setMetricsReportFormat(const std::string& format);
+
+        /**
+         * @return the directory of the local message spool, empty when spooling is disabled.
+         */
+        std::string getSpoolDirectory() const;
+
+        /**
+         * Sets the directory that Connections created by this factory use for their local
+         * store and forward spool, messages sent while the broker is unreachable are held
+         * there and forwarded once the connection is resumed.  Disabled by default.
+         *
+         * @param directory
+         *      The directory that holds the spool files, empty to disable spooling.
+         */
+        void setSpoolDirectory(const std::string& directory);
+
+        /**
+         * @return the size of each spool segment file.
+         */
+        int getSpoolSegmentSize() const;
+
+        /**
+         * Sets the size of the spool's segment files, this also limits the size of a single
+         * spooled message.
+         *
+         * @param segmentSize
+         *      The size in bytes of each segment file.
+         */
+        void setSpoolSegmentSize(int segmentSize);
+
     public:
 
         /**
@@ -149,6 +149,15 @@ cms::Message* ActiveMQConsumer::receiveNoWait() {
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
 
+////////////////////////////////////////////////////////////////////////////////
+std::vector<cms::Message*> ActiveMQConsumer::receiveBatch(int maxMessages, int millisecs) {
+
+    try {
+        return this->config->kernel->receiveBatch(maxMessages, millisecs);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQConsumer::setMessageListener(cms::MessageListener* listener) {
 
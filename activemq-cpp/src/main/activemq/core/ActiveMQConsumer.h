@@ -74,6 +74,8 @@ namespace core {
 
         virtual cms::Message* receiveNoWait();
 
+        virtual std::vector<cms::Message*> receiveBatch(int maxMessages, int millisecs);
+
         virtual void setMessageListener(cms::MessageListener* listener);
 
         virtual cms::MessageListener* getMessageListener() const;
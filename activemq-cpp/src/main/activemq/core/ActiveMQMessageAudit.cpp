@@ -17,15 +17,16 @@
 
 #include "ActiveMQMessageAudit.h"
 
-#include <activemq/util/IdGenerator.h>
 #include <activemq/exceptions/ActiveMQException.h>
 #include <activemq/commands/ProducerId.h>
 
-#include <decaf/util/LRUCache.h>
-#include <decaf/util/BitSet.h>
+#include <decaf/lang/Long.h>
+#include <decaf/util/HashCode.h>
 #include <decaf/util/concurrent/Mutex.h>
 
 #include <string>
+#include <vector>
+#include <cstring>
 
 using namespace std;
 using namespace activemq;
@@ -42,6 +43,327 @@ using namespace decaf::lang::exceptions;
 const int ActiveMQMessageAudit::DEFAULT_WINDOW_SIZE = 2048;
 const int ActiveMQMessageAudit::MAXIMUM_PRODUCER_COUNT = 64;
 
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int BITS_PER_BIN = 64;
+    const int BIN_SHIFT = 6;
+    const int MAX_STRIPES = 64;
+    const int MIN_PRODUCERS_PER_STRIPE = 16;
+
+    /**
+     * Lightweight view of the key that identifies a producer in the audit, which is
+     * the text form of its ProducerId.  A ProducerId lends its cached key and hash
+     * code, a string message id contributes the text before its final ':' separator
+     * and hashes it the same way the ProducerId computes its hash code, so both
+     * forms of lookup find the same window without building a new string.
+     */
+    struct ProducerKey {
+
+        std::string storage;
+        const char* text;
+        std::size_t length;
+        int hash;
+
+        ProducerKey(const ProducerId& id) : storage(), text(NULL), length(0), hash(id.getHashCode()) {
+            const std::string* key = id.getCachedKey();
+            if (key == NULL) {
+                this->storage = id.toString();
+                key = &this->storage;
+            }
+            this->text = key->c_str();
+            this->length = key->length();
+        }
+
+        ProducerKey(const char* text, std::size_t length) : storage(), text(text), length(length), hash(0) {
+            this->hash = hashText(text, length);
+        }
+
+        /**
+         * Hashes a key of the form connectionId:sessionId:value the same way as
+         * ProducerId::getHashCode, other keys get a plain string hash.
+         */
+        static int hashText(const char* text, std::size_t length) {
+
+            long long value = 0;
+            long long sessionId = 0;
+
+            std::size_t valueIndex = lastIndexOf(text, length, ':');
+            if (valueIndex < length && parseLong(text + valueIndex + 1, length - valueIndex - 1, value)) {
+                std::size_t sessionIndex = lastIndexOf(text, valueIndex, ':');
+                if (sessionIndex < valueIndex && parseLong(text + sessionIndex + 1, valueIndex - sessionIndex - 1, sessionId)) {
+                    int result = 31 * hashString(text, sessionIndex) + HashCode<long long>()(sessionId);
+                    return 31 * result + HashCode<long long>()(value);
+                }
+            }
+
+            return hashString(text, length);
+        }
+
+        static int hashString(const char* text, std::size_t length) {
+            int result = 0;
+            for (std::size_t i = 0; i < length; ++i) {
+                result = 31 * result + text[i];
+            }
+            return result;
+        }
+
+        static std::size_t lastIndexOf(const char* text, std::size_t length, char value) {
+            for (std::size_t i = length; i > 0; --i) {
+                if (text[i - 1] == value) {
+                    return i - 1;
+                }
+            }
+            return length;
+        }
+
+        static bool parseLong(const char* text, std::size_t length, long long& result) {
+
+            std::size_t i = 0;
+            bool negative = length > 0 && text[0] == '-';
+            if (negative) {
+                ++i;
+            }
+
+            if (i == length || length - i > 18) {
+                return false;
+            }
+
+            result = 0;
+            for (; i < length; ++i) {
+                if (text[i] < '0' || text[i] > '9') {
+                    return false;
+                }
+                result = result * 10 + (text[i] - '0');
+            }
+
+            if (negative) {
+                result = -result;
+            }
+
+            return true;
+        }
+    };
+
+    /**
+     * Fixed size sliding window of sequence ids seen from a single producer.  The
+     * window is a ring of 64 bit bins that always covers the bins leading up to the
+     * highest sequence id recorded, ids that fall behind the window are no longer
+     * tracked and are treated as not seen.
+     */
+    class ProducerWindow {
+    private:
+
+        ProducerWindow(const ProducerWindow&);
+        ProducerWindow& operator= (const ProducerWindow&);
+
+    public:
+
+        std::string text;
+        unsigned long long lastAccess;
+
+        std::vector<unsigned long long> bins;
+        long long highestBin;
+        long long lastSeqId;
+
+        ProducerWindow(const ProducerKey& key, int auditDepth) : text(key.text, key.length),
+                                                                 lastAccess(0),
+                                                                 bins((std::size_t) ((auditDepth > 0 ? auditDepth : 1) / BITS_PER_BIN + 2), 0),
+                                                                 highestBin(-1),
+                                                                 lastSeqId(-1) {
+        }
+
+        bool matches(const ProducerKey& key) const {
+            return this->text.length() == key.length && std::memcmp(this->text.data(), key.text, key.length) == 0;
+        }
+
+        /**
+         * Sets or clears the bit for the given sequence id.
+         *
+         * @return the previous state of the bit.
+         */
+        bool set(long long index, bool state) {
+
+            long long bin = index >> BIN_SHIFT;
+            long long size = (long long) this->bins.size();
+
+            if (bin > this->highestBin) {
+                if (!state) {
+                    return false;
+                }
+
+                long long clears = this->highestBin < 0 ? 0 : bin - this->highestBin;
+                if (clears > size) {
+                    clears = size;
+                }
+                for (long long i = 0; i < clears; ++i) {
+                    this->bins[(std::size_t) ((bin - i) % size)] = 0;
+                }
+                this->highestBin = bin;
+            } else if (bin <= this->highestBin - size) {
+                return false;
+            }
+
+            unsigned long long& slot = this->bins[(std::size_t) (bin % size)];
+            unsigned long long mask = 1ULL << (index & (BITS_PER_BIN - 1));
+            bool previous = (slot & mask) != 0;
+
+            if (state) {
+                slot |= mask;
+                if (index > this->lastSeqId) {
+                    this->lastSeqId = index;
+                }
+            } else {
+                slot &= ~mask;
+                if (previous && index == this->lastSeqId) {
+                    this->lastSeqId = findHighestSet();
+                }
+            }
+
+            return previous;
+        }
+
+        long long findHighestSet() const {
+            long long size = (long long) this->bins.size();
+            long long lowest = this->highestBin - size + 1;
+            if (lowest < 0) {
+                lowest = 0;
+            }
+
+            for (long long bin = this->highestBin; bin >= lowest; --bin) {
+                unsigned long long word = this->bins[(std::size_t) (bin % size)];
+                if (word != 0) {
+                    int bit = BITS_PER_BIN - 1;
+                    while ((word & (1ULL << bit)) == 0) {
+                        --bit;
+                    }
+                    return (bin << BIN_SHIFT) + bit;
+                }
+            }
+
+            return -1;
+        }
+    };
+
+    /**
+     * One stripe of the producer table, producers are assigned to a stripe by the
+     * hash of their key so that consumers of unrelated producers don't contend.
+     * Lookups scan a small contiguous array of hashes before touching any window.
+     */
+    class AuditStripe {
+    private:
+
+        AuditStripe(const AuditStripe&);
+        AuditStripe& operator= (const AuditStripe&);
+
+    public:
+
+        Mutex mutex;
+        std::vector<int> hashes;
+        std::vector<ProducerWindow*> windows;
+        unsigned long long clock;
+
+        AuditStripe() : mutex(), hashes(), windows(), clock(0) {
+        }
+
+        ~AuditStripe() {
+            clear();
+        }
+
+        ProducerWindow* find(const ProducerKey& key) {
+            std::size_t size = this->hashes.size();
+            for (std::size_t i = 0; i < size; ++i) {
+                if (this->hashes[i] == key.hash && this->windows[i]->matches(key)) {
+                    this->windows[i]->lastAccess = ++this->clock;
+                    return this->windows[i];
+                }
+            }
+            return NULL;
+        }
+
+        ProducerWindow* findOrCreate(const ProducerKey& key, int auditDepth, int capacity) {
+            ProducerWindow* window = find(key);
+            if (window == NULL) {
+                trim(capacity - 1);
+                window = new ProducerWindow(key, auditDepth);
+                window->lastAccess = ++this->clock;
+                this->hashes.push_back(key.hash);
+                this->windows.push_back(window);
+            }
+            return window;
+        }
+
+        /**
+         * Evicts the least recently used producers until at most count remain.
+         */
+        void trim(int count) {
+            if (count < 0) {
+                count = 0;
+            }
+
+            while (this->windows.size() > (std::size_t) count) {
+                std::size_t eldest = 0;
+                for (std::size_t i = 1; i < this->windows.size(); ++i) {
+                    if (this->windows[i]->lastAccess < this->windows[eldest]->lastAccess) {
+                        eldest = i;
+                    }
+                }
+
+                delete this->windows[eldest];
+                this->windows[eldest] = this->windows.back();
+                this->hashes[eldest] = this->hashes.back();
+                this->windows.pop_back();
+                this->hashes.pop_back();
+            }
+        }
+
+        void clear() {
+            for (std::size_t i = 0; i < this->windows.size(); ++i) {
+                delete this->windows[i];
+            }
+            this->windows.clear();
+            this->hashes.clear();
+        }
+    };
+
+    /**
+     * Splits a string message id into the key for its seed and its sequence value
+     * without allocating, returns false if the id has no usable seed.
+     */
+    bool parseMessageId(const std::string& id, const char*& seed, std::size_t& length, long long& sequence) {
+
+        if (id.empty()) {
+            return false;
+        }
+
+        seed = id.c_str();
+        length = id.length();
+        sequence = -1;
+
+        std::size_t index = id.find_last_of(':');
+        if (index != std::string::npos && (index + 1) < id.length()) {
+            length = index;
+
+            long long result = 0;
+            bool valid = true;
+            for (std::size_t i = index + 1; i < id.length(); ++i) {
+                char c = id[i];
+                if (c < '0' || c > '9' || result > (Long::MAX_VALUE - 9) / 10) {
+                    valid = false;
+                    break;
+                }
+                result = result * 10 + (c - '0');
+            }
+
+            // Anything other than a plain non-negative number gets the full
+            // parser, which also reports malformed values the same as before.
+            sequence = valid ? result : Long::parseLong(id.substr(index + 1));
+        }
+
+        return true;
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 namespace activemq {
 namespace core {
@@ -56,36 +378,80 @@ namespace core {
 
         int auditDepth;
         int maximumNumberOfProducersToTrack;
-        Mutex mutex;
 
-        LRUCache<std::string, Pointer<BitSet> > map;
+        int stripeCount;
+        int stripeCapacity;
+        AuditStripe* stripes;
 
-        MessageAuditImpl() : auditDepth(2048),
-                             maximumNumberOfProducersToTrack(64),
-                             mutex(),
-                             map() {
+        MessageAuditImpl() : auditDepth(ActiveMQMessageAudit::DEFAULT_WINDOW_SIZE),
+                             maximumNumberOfProducersToTrack(ActiveMQMessageAudit::MAXIMUM_PRODUCER_COUNT),
+                             stripeCount(1),
+                             stripeCapacity(1),
+                             stripes(NULL) {
+            initialize();
         }
 
         MessageAuditImpl(int auditDepth, int maximumNumberOfProducersToTrack) :
             auditDepth(auditDepth),
             maximumNumberOfProducersToTrack(maximumNumberOfProducersToTrack),
-            mutex(),
-            map() {
+            stripeCount(1),
+            stripeCapacity(1),
+            stripes(NULL) {
+            initialize();
+        }
+
+        ~MessageAuditImpl() {
+            delete [] this->stripes;
+        }
+
+        AuditStripe& stripeFor(const ProducerKey& key) const {
+            // Spread the high bits down, the low bits of the id hash mostly follow the producer value.
+            unsigned int hash = (unsigned int) key.hash;
+            hash ^= (hash >> 16);
+            hash *= 0x45d9f3bU;
+            hash ^= (hash >> 16);
+            return this->stripes[hash & (unsigned int) (this->stripeCount - 1)];
         }
 
         void adjustMaxProducersToTrack(int value) {
-            // When value is smaller than current we need to move the entries
-            // to a new cache with that setting so that old ones are pruned
-            // since putAll will access the entries in the right order,
-            // this shouldn't result in wrong cache entries being removed
-            if (value < maximumNumberOfProducersToTrack) {
-                LRUCache<std::string, Pointer<BitSet> > newMap(0, value, 0.75f, true);
-                newMap.putAll(this->map);
-                this->map.clear();
-                this->map.putAll(newMap);
-            }
-            this->map.setMaxCacheSize(value);
             this->maximumNumberOfProducersToTrack = value;
+            int capacity = computeStripeCapacity();
+
+            // Shrinking evicts the least recently used producers of each stripe.
+            for (int i = 0; i < this->stripeCount; ++i) {
+                synchronized(&this->stripes[i].mutex) {
+                    this->stripes[i].trim(capacity);
+                }
+            }
+
+            this->stripeCapacity = capacity;
+        }
+
+        void clear() {
+            for (int i = 0; i < this->stripeCount; ++i) {
+                synchronized(&this->stripes[i].mutex) {
+                    this->stripes[i].clear();
+                }
+            }
+        }
+
+    private:
+
+        void initialize() {
+            // The number of stripes is fixed for the life of the audit, only the
+            // capacity of each stripe follows later changes to the producer limit.
+            int producers = this->maximumNumberOfProducersToTrack;
+            while (this->stripeCount < MAX_STRIPES && this->stripeCount * 2 * MIN_PRODUCERS_PER_STRIPE <= producers) {
+                this->stripeCount *= 2;
+            }
+
+            this->stripeCapacity = computeStripeCapacity();
+            this->stripes = new AuditStripe[this->stripeCount];
+        }
+
+        int computeStripeCapacity() const {
+            int capacity = (this->maximumNumberOfProducersToTrack + this->stripeCount - 1) / this->stripeCount;
+            return capacity > 0 ? capacity : 1;
         }
     };
 
@@ -131,30 +497,20 @@ void ActiveMQMessageAudit::getMaximumNumberOfProducersToTrack(int value) {
 ////////////////////////////////////////////////////////////////////////////////
 bool ActiveMQMessageAudit::isDuplicate(const std::string& id) const {
     bool answer = false;
-    std::string seed = IdGenerator::getSeedFromId(id);
-    if (!seed.empty()) {
 
-        synchronized(&this->impl->mutex) {
+    const char* seed = NULL;
+    std::size_t length = 0;
+    long long index = -1;
 
-            Pointer<BitSet> bits;
-            try {
-                bits = this->impl->map.get(seed);
-            } catch (NoSuchElementException& ex) {
-                bits.reset(new BitSet(this->impl->auditDepth));
-                this->impl->map.put(seed, bits);
-            }
+    if (parseMessageId(id, seed, length, index)) {
 
-            long long index = IdGenerator::getSequenceFromId(id);
-            if (index >= 0) {
-                int scaledIndex = (int) index;
-                if (index > Integer::MAX_VALUE) {
-                    scaledIndex = (int)(index - Integer::MAX_VALUE);
-                }
+        ProducerKey key(seed, length);
+        AuditStripe& stripe = this->impl->stripeFor(key);
 
-                answer = bits->get(scaledIndex);
-                if (!answer) {
-                    bits->set(scaledIndex, true);
-                }
+        synchronized(&stripe.mutex) {
+            ProducerWindow* window = stripe.findOrCreate(key, this->impl->auditDepth, this->impl->stripeCapacity);
+            if (index >= 0) {
+                answer = window->set(index, true);
             }
         }
     }
@@ -166,33 +522,17 @@ bool ActiveMQMessageAudit::isDuplicate(decaf::lang::Pointer<MessageId> msgId) co
     bool answer = false;
 
     if (msgId != NULL) {
-        Pointer<ProducerId> pid = msgId->getProducerId();
+        const Pointer<ProducerId>& pid = msgId->getProducerId();
         if (pid != NULL) {
-            std::string seed = pid->toString();
-            if (!seed.empty()) {
 
-                synchronized(&this->impl->mutex) {
-
-                    Pointer<BitSet> bits;
-                    try {
-                        bits = this->impl->map.get(seed);
-                    } catch (NoSuchElementException& ex) {
-                        bits.reset(new BitSet(this->impl->auditDepth));
-                        this->impl->map.put(seed, bits);
-                    }
+            ProducerKey key(*pid);
+            AuditStripe& stripe = this->impl->stripeFor(key);
+            long long index = msgId->getProducerSequenceId();
 
-                    long long index = msgId->getProducerSequenceId();
-                    if (index >= 0) {
-                        int scaledIndex = (int) index;
-                        if (index > Integer::MAX_VALUE) {
-                            scaledIndex = (int)(index - Integer::MAX_VALUE);
-                        }
-
-                        answer = bits->get(scaledIndex);
-                        if (!answer) {
-                            bits->set(scaledIndex, true);
-                        }
-                    }
+            synchronized(&stripe.mutex) {
+                ProducerWindow* window = stripe.findOrCreate(key, this->impl->auditDepth, this->impl->stripeCapacity);
+                if (index >= 0) {
+                    answer = window->set(index, true);
                 }
             }
         }
@@ -202,27 +542,20 @@ bool ActiveMQMessageAudit::isDuplicate(decaf::lang::Pointer<MessageId> msgId) co
 
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQMessageAudit::rollback(const std::string& msgId) {
-    std::string seed = IdGenerator::getSeedFromId(msgId);
-    if (!seed.empty()) {
 
-        synchronized(&this->impl->mutex) {
+    const char* seed = NULL;
+    std::size_t length = 0;
+    long long index = -1;
 
-            Pointer<BitSet> bits;
-            try {
-                bits = this->impl->map.get(seed);
-            } catch (NoSuchElementException& ex) {
-            }
+    if (parseMessageId(msgId, seed, length, index) && index >= 0) {
 
-            if (bits != NULL) {
-                long long index = IdGenerator::getSequenceFromId(msgId);
-                if (index >= 0) {
-                    int scaledIndex = (int) index;
-                    if (index > Integer::MAX_VALUE) {
-                        scaledIndex = (int)(index - Integer::MAX_VALUE);
-                    }
+        ProducerKey key(seed, length);
+        AuditStripe& stripe = this->impl->stripeFor(key);
 
-                    bits->set(scaledIndex, false);
-                }
+        synchronized(&stripe.mutex) {
+            ProducerWindow* window = stripe.find(key);
+            if (window != NULL) {
+                window->set(index, false);
             }
         }
     }
@@ -231,30 +564,17 @@ void ActiveMQMessageAudit::rollback(const std::string& msgId) {
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQMessageAudit::rollback(decaf::lang::Pointer<commands::MessageId> msgId) {
     if (msgId != NULL) {
-        Pointer<ProducerId> pid = msgId->getProducerId();
-        if (pid != NULL) {
-            std::string seed = pid->toString();
-            if (!seed.empty()) {
-
-                synchronized(&this->impl->mutex) {
-
-                    Pointer<BitSet> bits;
-                    try {
-                        bits = this->impl->map.get(seed);
-                    } catch (NoSuchElementException& ex) {
-                    }
+        const Pointer<ProducerId>& pid = msgId->getProducerId();
+        long long index = msgId->getProducerSequenceId();
+        if (pid != NULL && index >= 0) {
 
-                    if (bits != NULL) {
-                        long long index = msgId->getProducerSequenceId();
-                        if (index >= 0) {
-                            int scaledIndex = (int) index;
-                            if (index > Integer::MAX_VALUE) {
-                                scaledIndex = (int)(index - Integer::MAX_VALUE);
-                            }
+            ProducerKey key(*pid);
+            AuditStripe& stripe = this->impl->stripeFor(key);
 
-                            bits->set(scaledIndex, false);
-                        }
-                    }
+            synchronized(&stripe.mutex) {
+                ProducerWindow* window = stripe.find(key);
+                if (window != NULL) {
+                    window->set(index, false);
                 }
             }
         }
@@ -265,30 +585,19 @@ void ActiveMQMessageAudit::rollback(decaf::lang::Pointer<commands::MessageId> ms
 bool ActiveMQMessageAudit::isInOrder(const std::string& msgId) const {
     bool answer = true;
 
-    if (!msgId.empty()) {
-        std::string seed = IdGenerator::getSeedFromId(msgId);
-        if (!seed.empty()) {
-
-            synchronized(&this->impl->mutex) {
+    const char* seed = NULL;
+    std::size_t length = 0;
+    long long index = -1;
 
-                Pointer<BitSet> bits;
-                try {
-                    bits = this->impl->map.get(seed);
-                } catch (NoSuchElementException& ex) {
-                    bits.reset(new BitSet(this->impl->auditDepth));
-                    this->impl->map.put(seed, bits);
-                }
-
-                long long index = IdGenerator::getSequenceFromId(msgId);
-                if (index >= 0) {
+    if (parseMessageId(msgId, seed, length, index)) {
 
-                    int scaledIndex = (int) index;
-                    if (index > Integer::MAX_VALUE) {
-                        scaledIndex = (int)(index - Integer::MAX_VALUE);
-                    }
+        ProducerKey key(seed, length);
+        AuditStripe& stripe = this->impl->stripeFor(key);
 
-                    answer = ((bits->length() - 1) == scaledIndex);
-                }
+        synchronized(&stripe.mutex) {
+            ProducerWindow* window = stripe.findOrCreate(key, this->impl->auditDepth, this->impl->stripeCapacity);
+            if (index >= 0) {
+                answer = (window->lastSeqId == index);
             }
         }
     }
@@ -300,29 +609,17 @@ bool ActiveMQMessageAudit::isInOrder(decaf::lang::Pointer<commands::MessageId> m
     bool answer = false;
 
     if (msgId != NULL) {
-        Pointer<ProducerId> pid = msgId->getProducerId();
+        const Pointer<ProducerId>& pid = msgId->getProducerId();
         if (pid != NULL) {
-            std::string seed = pid->toString();
-            if (!seed.empty()) {
 
-                synchronized(&this->impl->mutex) {
-
-                    Pointer<BitSet> bits;
-                    try {
-                        bits = this->impl->map.get(seed);
-                    } catch (NoSuchElementException& ex) {
-                        bits.reset(new BitSet(this->impl->auditDepth));
-                        this->impl->map.put(seed, bits);
-                    }
+            ProducerKey key(*pid);
+            AuditStripe& stripe = this->impl->stripeFor(key);
+            long long index = msgId->getProducerSequenceId();
 
-                    long long index = msgId->getProducerSequenceId();
-                    if (index >= 0) {
-                        int scaledIndex = (int) index;
-                        if (index > Integer::MAX_VALUE) {
-                            scaledIndex = (int)(index - Integer::MAX_VALUE);
-                        }
-                        answer = ((bits->length() - 1) == scaledIndex);
-                    }
+            synchronized(&stripe.mutex) {
+                ProducerWindow* window = stripe.findOrCreate(key, this->impl->auditDepth, this->impl->stripeCapacity);
+                if (index >= 0) {
+                    answer = (window->lastSeqId == index);
                 }
             }
         }
@@ -332,22 +629,16 @@ bool ActiveMQMessageAudit::isInOrder(decaf::lang::Pointer<commands::MessageId> m
 
 ////////////////////////////////////////////////////////////////////////////////
 long long ActiveMQMessageAudit::getLastSeqId(decaf::lang::Pointer<commands::ProducerId> id) const {
-    long result = -1;
+    long long result = -1;
     if (id != NULL) {
-        std::string seed = id->toString();
-        if (!seed.empty()) {
 
-            synchronized(&this->impl->mutex) {
+        ProducerKey key(*id);
+        AuditStripe& stripe = this->impl->stripeFor(key);
 
-                Pointer<BitSet> bits;
-                try {
-                    bits = this->impl->map.get(seed);
-                } catch (NoSuchElementException& ex) {
-                }
-
-                if (bits != NULL) {
-                    result = bits->length() - 1;
-                }
+        synchronized(&stripe.mutex) {
+            ProducerWindow* window = stripe.find(key);
+            if (window != NULL) {
+                result = window->lastSeqId;
             }
         }
     }
@@ -356,5 +647,5 @@ long long ActiveMQMessageAudit::getLastSeqId(decaf::lang::Pointer<commands::Prod
 
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQMessageAudit::clear() {
-    this->impl->map.clear();
+    this->impl->clear();
 }
@@ -128,3 +128,21 @@ void ActiveMQProducer::send(const cms::Destination* destination, cms::Message* m
     }
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQProducer::trySend(cms::Message* message) {
+
+    try {
+        return this->kernel->trySend(message);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQProducer::trySend(const cms::Destination* destination, cms::Message* message) {
+
+    try {
+        return this->kernel->trySend(destination, message);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
@@ -182,6 +182,18 @@ namespace core {
             return this->kernel->getMessageTransformer();
         }
 
+        virtual bool trySend(cms::Message* message);
+
+        virtual bool trySend(const cms::Destination* destination, cms::Message* message);
+
+        virtual void setProducerWindowListener(cms::ProducerWindowListener* listener) {
+            this->kernel->setProducerWindowListener(listener);
+        }
+
+        virtual cms::ProducerWindowListener* getProducerWindowListener() const {
+            return this->kernel->getProducerWindowListener();
+        }
+
     public:
 
         /**
@@ -18,6 +18,7 @@
 #define _ACTIVEMQ_CORE_ACTIVEMQSESSION_H_
 
 #include <cms/Session.h>
+#include <cms/AsyncCallback.h>
 #include <cms/ExceptionListener.h>
 
 #include <activemq/util/Config.h>
@@ -73,6 +74,28 @@ namespace core {
             return this->kernel->isStarted();
         }
 
+        /**
+         * Commits the current transaction without waiting for the broker to answer, the
+         * session can start on its next transaction at once.  The callback is notified
+         * of the outcome from the connection's transport thread.
+         *
+         * @param onComplete
+         *      Notified of the outcome, if NULL this is the same as commit().
+         *
+         * @throws CMSException if the session is not transacted or the commit can't be sent.
+         */
+        virtual void commit(cms::AsyncCallback* onComplete);
+
+        /**
+         * Rolls back the current transaction without waiting for the broker to answer.
+         *
+         * @param onComplete
+         *      Notified of the outcome, if NULL this is the same as rollback().
+         *
+         * @throws CMSException if the session is not transacted or the rollback can't be sent.
+         */
+        virtual void rollback(cms::AsyncCallback* onComplete);
+
     public:   // Implements Methods
 
         virtual void close();
@@ -168,6 +191,25 @@ namespace core {
             return this->kernel->getMessageTransformer();
         }
 
+        /**
+         * Enables parallel delivery to the MessageListeners of this session's consumers,
+         * messages with the same ordering key are still delivered one at a time in order.
+         *
+         * @param workers
+         *      The number of worker threads, zero turns parallel delivery off.
+         * @param keyFunction
+         *      Picks the ordering key for each message, NULL orders by message group.
+         *
+         * @throws IllegalStateException if the acknowledgement mode is not supported or the
+         *         session already has consumers.
+         *
+         * @see ActiveMQSessionKernel::setParallelDispatch
+         * @since 3.10
+         */
+        void setParallelDispatch(int workers, DispatchKeyFunction* keyFunction = NULL) {
+            this->kernel->setParallelDispatch(workers, keyFunction);
+        }
+
         /**
          * Gets the Session Information object for this session, if the
          * session is closed than this method throws an exception.
@@ -33,6 +33,7 @@
 #include <decaf/lang/exceptions/NullPointerException.h>
 #include <decaf/lang/Integer.h>
 #include <decaf/lang/Long.h>
+#include <decaf/lang/System.h>
 #include <decaf/util/Iterator.h>
 #include <decaf/util/concurrent/ConcurrentStlMap.h>
 
@@ -54,6 +55,55 @@ using namespace decaf::util::concurrent;
 namespace activemq{
 namespace core{
 
+    /**
+     * Counts the asynchronous commits and rollbacks whose callbacks have not yet been
+     * called, shared with the callbacks so they never refer back to the context.
+     */
+    class PendingCompletions {
+    private:
+
+        PendingCompletions(const PendingCompletions&);
+        PendingCompletions& operator=(const PendingCompletions&);
+
+    private:
+
+        Mutex mutex;
+        int count;
+
+    public:
+
+        PendingCompletions() : mutex(), count(0) {
+        }
+
+        void started() {
+            synchronized(&mutex) {
+                count++;
+            }
+        }
+
+        void finished() {
+            synchronized(&mutex) {
+                if (--count == 0) {
+                    mutex.notifyAll();
+                }
+            }
+        }
+
+        bool await(long long timeout) {
+            long long deadline = System::currentTimeMillis() + timeout;
+            synchronized(&mutex) {
+                long long remaining = timeout;
+                while (count > 0 && remaining > 0) {
+                    mutex.wait(remaining);
+                    remaining = deadline - System::currentTimeMillis();
+                }
+                return count == 0;
+            }
+
+            return true;
+        }
+    };
+
     class TxContextData {
     private:
 
@@ -69,7 +119,10 @@ namespace core{
         Pointer<Xid> associatedXid;
         int beforeEndIndex;
 
-        TxContextData() : transactionId(), associatedXid(), beforeEndIndex() {
+        // Commits and rollbacks sent without waiting for the response.
+        Pointer<PendingCompletions> pending;
+
+        TxContextData() : transactionId(), associatedXid(), beforeEndIndex(), pending(new PendingCompletions()) {
         }
 
     };
@@ -79,6 +132,22 @@ namespace core{
 ////////////////////////////////////////////////////////////////////////////////
 namespace {
 
+    // Errors thrown by a completion callback are never passed on to the caller, whichever
+    // thread runs it.
+    void notifySuccess(cms::AsyncCallback* callback) {
+        try {
+            callback->onSuccess();
+        } catch (...) {
+        }
+    }
+
+    void notifyException(cms::AsyncCallback* callback, const cms::CMSException& ex) {
+        try {
+            callback->onException(ex);
+        } catch (...) {
+        }
+    }
+
     class Finally {
     private:
 
@@ -101,6 +170,48 @@ namespace {
         }
     };
 
+    /**
+     * Passes the Broker's answer to an asynchronous commit or rollback on to the caller's
+     * callback, errors thrown by that callback must not reach the Transport's thread.  The
+     * completion counts as finished before the callback runs so that a callback which
+     * closes the session doesn't wait for itself.
+     */
+    class TransactionCompletion : public cms::AsyncCallback {
+    private:
+
+        TransactionCompletion(const TransactionCompletion&);
+        TransactionCompletion& operator=(const TransactionCompletion&);
+
+    private:
+
+        Pointer<PendingCompletions> pending;
+        cms::AsyncCallback* callback;
+
+    public:
+
+        TransactionCompletion(const Pointer<PendingCompletions>& pending, cms::AsyncCallback* callback) :
+            cms::AsyncCallback(), pending(pending), callback(callback) {
+
+            this->pending->started();
+        }
+
+        virtual ~TransactionCompletion() {}
+
+        virtual void onSuccess() {
+            this->pending->finished();
+            notifySuccess(this->callback);
+        }
+
+        virtual void onException(const cms::CMSException& ex) {
+            this->pending->finished();
+            notifyException(this->callback, ex);
+        }
+
+        void abandon() {
+            this->pending->finished();
+        }
+    };
+
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -257,6 +368,121 @@ void ActiveMQTransactionContext::rollback() {
     AMQ_CATCHALL_THROW(ActiveMQException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQTransactionContext::commit(cms::AsyncCallback* onComplete) {
+
+    try{
+
+        if (onComplete == NULL) {
+            commit();
+            return;
+        }
+
+        if (isInXATransaction()) {
+            throw cms::TransactionInProgressException("Cannot Commit a local transaction while an XA Transaction is in progress.");
+        }
+
+        // Synchronizations act on the session's current delivery state, letting them run
+        // after the next transaction has started would mix the two transactions up.
+        if (!isInTransaction() || hasSynchronizations()) {
+            try {
+                commit();
+            } catch (cms::CMSException& ex) {
+                notifyException(onComplete, ex);
+                return;
+            }
+
+            notifySuccess(onComplete);
+            return;
+        }
+
+        Pointer<TransactionInfo> info(new TransactionInfo());
+        info->setConnectionId(this->connection->getConnectionInfo().getConnectionId());
+        info->setTransactionId(this->context->transactionId);
+        info->setType(ActiveMQConstants::TRANSACTION_STATE_COMMITONEPHASE);
+
+        // Before we send the command NULL the id so the next transaction can begin.
+        this->context->transactionId.reset(NULL);
+
+        this->completeAsync(info, onComplete);
+    }
+    AMQ_CATCH_RETHROW(cms::CMSException)
+    AMQ_CATCH_RETHROW(ActiveMQException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, ActiveMQException)
+    AMQ_CATCHALL_THROW(ActiveMQException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQTransactionContext::rollback(cms::AsyncCallback* onComplete) {
+
+    try{
+
+        if (onComplete == NULL) {
+            rollback();
+            return;
+        }
+
+        if (isInXATransaction()) {
+            throw cms::TransactionInProgressException("Cannot Rollback a local transaction while an XA Transaction is in progress.");
+        }
+
+        if (!isInTransaction() || hasSynchronizations()) {
+            try {
+                rollback();
+            } catch (cms::CMSException& ex) {
+                notifyException(onComplete, ex);
+                return;
+            }
+
+            notifySuccess(onComplete);
+            return;
+        }
+
+        Pointer<TransactionInfo> info(new TransactionInfo());
+        info->setConnectionId(this->connection->getConnectionInfo().getConnectionId());
+        info->setTransactionId(this->context->transactionId);
+        info->setType(ActiveMQConstants::TRANSACTION_STATE_ROLLBACK);
+
+        // Before we send the command NULL the id so the next transaction can begin.
+        this->context->transactionId.reset(NULL);
+
+        this->completeAsync(info, onComplete);
+    }
+    AMQ_CATCH_RETHROW(cms::CMSException)
+    AMQ_CATCH_RETHROW(ActiveMQException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, ActiveMQException)
+    AMQ_CATCHALL_THROW(ActiveMQException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQTransactionContext::completeAsync(const Pointer<TransactionInfo>& info, cms::AsyncCallback* onComplete) {
+
+    Pointer<TransactionCompletion> completion(new TransactionCompletion(this->context->pending, onComplete));
+
+    try {
+        this->connection->asyncRequest(info, completion.dynamicCast<cms::AsyncCallback>());
+    } catch (...) {
+        // The request never left, so the callback will never be called.
+        completion->abandon();
+        throw;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQTransactionContext::waitForCompletions(long long timeout) {
+    return this->context->pending->await(timeout);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQTransactionContext::hasSynchronizations() {
+
+    synchronized(&this->synchronizations) {
+        return !this->synchronizations.isEmpty();
+    }
+
+    return false;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQTransactionContext::beforeEnd() {
 
@@ -19,6 +19,7 @@
 
 #include <memory>
 
+#include <cms/AsyncCallback.h>
 #include <cms/Message.h>
 #include <cms/XAResource.h>
 #include <cms/CMSException.h>
@@ -27,6 +28,7 @@
 #include <activemq/util/Config.h>
 #include <activemq/exceptions/ActiveMQException.h>
 #include <activemq/commands/LocalTransactionId.h>
+#include <activemq/commands/TransactionInfo.h>
 #include <activemq/core/Synchronization.h>
 #include <activemq/util/LongSequenceGenerator.h>
 
@@ -121,6 +123,43 @@ namespace kernels {
          */
         virtual void rollback();
 
+        /**
+         * Commit the current Transaction without waiting for the Broker to answer, the
+         * callback is notified of the outcome from the Transport's thread.  A new Transaction
+         * can be started as soon as this method returns so a series of commits can be in
+         * flight at once.  Transactions that have Synchronizations registered, such as those
+         * holding consumed messages, are committed synchronously before the callback is called.
+         * Exceptions thrown by the callback are ignored either way.
+         *
+         * @param onComplete
+         *      Notified of the outcome of the commit, if NULL this is the same as commit().
+         *
+         * @throw ActiveMQException if the commit could not be sent.
+         */
+        virtual void commit(cms::AsyncCallback* onComplete);
+
+        /**
+         * Rollback the current Transaction without waiting for the Broker to answer, see
+         * commit(cms::AsyncCallback*).
+         *
+         * @param onComplete
+         *      Notified of the outcome of the rollback, if NULL this is the same as rollback().
+         *
+         * @throw ActiveMQException if the rollback could not be sent.
+         */
+        virtual void rollback(cms::AsyncCallback* onComplete);
+
+        /**
+         * Waits until the Broker has answered every asynchronous commit or rollback, the
+         * callbacks may still be running when this returns.
+         *
+         * @param timeout
+         *      The maximum time to wait in milliseconds.
+         *
+         * @return true if every commit and rollback was answered before the timeout expired.
+         */
+        virtual bool waitForCompletions(long long timeout);
+
         /**
          * Get the Transaction Id object for the current
          * Transaction, returns NULL if no transaction is running
@@ -186,6 +225,8 @@ namespace kernels {
         void beforeEnd();
         void afterCommit();
         void afterRollback();
+        bool hasSynchronizations();
+        void completeAsync(const Pointer<commands::TransactionInfo>& info, cms::AsyncCallback* onComplete);
 
     };
 
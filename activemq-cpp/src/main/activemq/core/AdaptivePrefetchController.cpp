@@ -0,0 +1,89 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AdaptivePrefetchController.h"
+
+#include <decaf/lang/Math.h>
+
+using namespace activemq;
+using namespace activemq::core;
+using namespace decaf;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+AdaptivePrefetchController::AdaptivePrefetchController(int minimumPrefetch, int maximumPrefetch, long long targetLatency) :
+    minimumPrefetch(Math::max(1, minimumPrefetch)),
+    maximumPrefetch(0),
+    targetLatency(Math::max(1LL, targetLatency)),
+    prefetchSize(0),
+    periodStart(-1),
+    consumed(0),
+    starved(0),
+    consumeRate(0) {
+
+    this->maximumPrefetch = Math::max(this->minimumPrefetch, maximumPrefetch);
+    this->prefetchSize = this->minimumPrefetch;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+AdaptivePrefetchController::~AdaptivePrefetchController() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool AdaptivePrefetchController::messageConsumed(long long now, int backlog, int count) {
+
+    if (this->periodStart < 0) {
+        this->periodStart = now;
+    }
+
+    this->consumed += count;
+    if (backlog <= 0) {
+        this->starved++;
+    }
+
+    long long elapsed = now - this->periodStart;
+    if (elapsed < this->targetLatency) {
+        return false;
+    }
+
+    double rate = (double) this->consumed / (double) elapsed;
+    this->consumeRate = this->consumeRate > 0 ? (this->consumeRate + rate) / 2 : rate;
+
+    double window = Math::ceil(this->consumeRate * (double) this->targetLatency);
+    int desired = window < (double) this->maximumPrefetch ? (int) window : this->maximumPrefetch;
+
+    // Running dry while draining a whole window means the broker can't keep up with
+    // the current window, the measured rate understates what the consumer can do.
+    if (this->starved > 0 && this->consumed >= this->prefetchSize) {
+        desired = Math::max(desired, this->prefetchSize * 2);
+    }
+
+    desired = Math::min(this->maximumPrefetch, Math::max(this->minimumPrefetch, desired));
+
+    this->periodStart = now;
+    this->consumed = 0;
+    this->starved = 0;
+
+    // Small adjustments aren't worth a round trip to the broker.
+    int delta = Math::abs(desired - this->prefetchSize);
+    if (delta == 0 || delta < this->prefetchSize / 4) {
+        return false;
+    }
+
+    this->prefetchSize = desired;
+    return true;
+}
@@ -0,0 +1,121 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CORE_ADAPTIVEPREFETCHCONTROLLER_H_
+#define _ACTIVEMQ_CORE_ADAPTIVEPREFETCHCONTROLLER_H_
+
+#include <activemq/util/Config.h>
+
+namespace activemq {
+namespace core {
+
+    /**
+     * Computes the prefetch window of a consumer from its observed processing rate.
+     *
+     * The controller aims to keep no more messages buffered at the consumer than it can
+     * process within a target latency (window = rate * latency).  A consumer that gets
+     * through a whole window and then runs dry is limited by the window rather than by
+     * its own speed, so the window is doubled until that stops happening.  The window always stays
+     * between the configured minimum and maximum, which bounds the memory a consumer can
+     * use for prefetched messages.
+     *
+     * Samples are taken each time a message is consumed and evaluated once per target
+     * latency period.  This class is not thread safe, the owning consumer serializes
+     * access to it.
+     *
+     * @since 3.10
+     */
+    class AMQCPP_API AdaptivePrefetchController {
+    private:
+
+        int minimumPrefetch;
+        int maximumPrefetch;
+        long long targetLatency;
+        int prefetchSize;
+
+        long long periodStart;
+        int consumed;
+        int starved;
+        double consumeRate;
+
+    private:
+
+        AdaptivePrefetchController(const AdaptivePrefetchController&);
+        AdaptivePrefetchController& operator=(const AdaptivePrefetchController&);
+
+    public:
+
+        /**
+         * Creates a new controller whose window starts at the minimum prefetch.
+         *
+         * @param minimumPrefetch
+         *      The smallest window the controller will use, values below one are raised to one.
+         * @param maximumPrefetch
+         *      The largest window the controller will use, usually the consumer's configured prefetch.
+         * @param targetLatency
+         *      The time in milliseconds a message should at most spend in the consumer's buffer.
+         */
+        AdaptivePrefetchController(int minimumPrefetch, int maximumPrefetch, long long targetLatency);
+
+        virtual ~AdaptivePrefetchController();
+
+        /**
+         * Records that the consumer finished processing a message, or a batch of them.
+         *
+         * @param now
+         *      The current time in milliseconds.
+         * @param backlog
+         *      The number of messages still waiting in the consumer's buffer.
+         * @param count
+         *      The number of messages that were consumed.
+         *
+         * @return true if the window changed enough that the broker should be told about it.
+         */
+        bool messageConsumed(long long now, int backlog, int count = 1);
+
+        /**
+         * @return the current prefetch window.
+         */
+        int getPrefetchSize() const {
+            return this->prefetchSize;
+        }
+
+        /**
+         * @return the smoothed processing rate in messages per millisecond, zero until
+         *         the first sample period has completed.
+         */
+        double getConsumeRate() const {
+            return this->consumeRate;
+        }
+
+        int getMinimumPrefetch() const {
+            return this->minimumPrefetch;
+        }
+
+        int getMaximumPrefetch() const {
+            return this->maximumPrefetch;
+        }
+
+        long long getTargetLatency() const {
+            return this->targetLatency;
+        }
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_CORE_ADAPTIVEPREFETCHCONTROLLER_H_ */
@@ -55,6 +55,38 @@ namespace core {
 
         ConnectionAuditImpl() : mutex(), destinations(), dispatchers(1000) {
         }
+
+        /**
+         * Finds the audit for a message sent to the given destination, queues share one
+         * audit per destination while topics are audited per dispatcher.  The lock only
+         * covers the lookup, the audit itself is safe to use without it.
+         */
+        Pointer<ActiveMQMessageAudit> getAudit(Dispatcher* dispatcher, const Pointer<ActiveMQDestination>& destination,
+                                               bool create, int auditDepth, int maxProducers) {
+
+            Pointer<ActiveMQMessageAudit> audit;
+
+            synchronized(&this->mutex) {
+                try {
+                    if (destination->isQueue()) {
+                        audit = this->destinations.get(destination);
+                    } else {
+                        audit = this->dispatchers.get(dispatcher);
+                    }
+                } catch (NoSuchElementException& ex) {
+                    if (create) {
+                        audit.reset(new ActiveMQMessageAudit(auditDepth, maxProducers));
+                        if (destination->isQueue()) {
+                            this->destinations.put(destination, audit);
+                        } else {
+                            this->dispatchers.put(dispatcher, audit);
+                        }
+                    }
+                }
+            }
+
+            return audit;
+        }
     };
 }}
 
@@ -93,53 +125,29 @@ void ConnectionAudit::removeDispatcher(Dispatcher* dispatcher) {
 
 ////////////////////////////////////////////////////////////////////////////////
 bool ConnectionAudit::isDuplicate(Dispatcher* dispatcher, Pointer<commands::Message> message) {
-    synchronized(&this->impl->mutex) {
-        if (checkForDuplicates && message != NULL) {
-            Pointer<ActiveMQDestination> destination = message->getDestination();
-            if (destination != NULL) {
-                if (destination->isQueue()) {
-                    Pointer<ActiveMQMessageAudit> audit;
-                    try {
-                        audit = this->impl->destinations.get(destination);
-                    } catch (NoSuchElementException& ex) {
-                        audit.reset(new ActiveMQMessageAudit(auditDepth, auditMaximumProducerNumber));
-                        this->impl->destinations.put(destination, audit);
-                    }
-                    bool result = audit->isDuplicate(message->getMessageId());
-                    return result;
-                }
-                Pointer<ActiveMQMessageAudit> audit;
-                try {
-                    audit = this->impl->dispatchers.get(dispatcher);
-                } catch (NoSuchElementException& ex) {
-                    audit.reset(new ActiveMQMessageAudit(auditDepth, auditMaximumProducerNumber));
-                    this->impl->dispatchers.put(dispatcher, audit);
-                }
-                bool result = audit->isDuplicate(message->getMessageId());
-                return result;
-            }
+
+    if (checkForDuplicates && message != NULL) {
+        Pointer<ActiveMQDestination> destination = message->getDestination();
+        if (destination != NULL) {
+            Pointer<ActiveMQMessageAudit> audit =
+                this->impl->getAudit(dispatcher, destination, true, auditDepth, auditMaximumProducerNumber);
+            return audit->isDuplicate(message->getMessageId());
         }
     }
+
     return false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void ConnectionAudit::rollbackDuplicate(Dispatcher* dispatcher, Pointer<commands::Message> message) {
-    synchronized(&this->impl->mutex) {
-        if (checkForDuplicates && message != NULL) {
-            Pointer<ActiveMQDestination> destination = message->getDestination();
-            if (destination != NULL) {
-                if (destination->isQueue()) {
-                    try {
-                        Pointer<ActiveMQMessageAudit> audit = this->impl->destinations.get(destination);
-                        audit->rollback(message->getMessageId());
-                    } catch (NoSuchElementException& ex) {}
-                } else {
-                    try {
-                        Pointer<ActiveMQMessageAudit> audit = this->impl->dispatchers.get(dispatcher);
-                        audit->rollback(message->getMessageId());
-                    } catch (NoSuchElementException& ex) {}
-                }
+
+    if (checkForDuplicates && message != NULL) {
+        Pointer<ActiveMQDestination> destination = message->getDestination();
+        if (destination != NULL) {
+            Pointer<ActiveMQMessageAudit> audit =
+                this->impl->getAudit(dispatcher, destination, false, auditDepth, auditMaximumProducerNumber);
+            if (audit != NULL) {
+                audit->rollback(message->getMessageId());
             }
         }
     }
@@ -0,0 +1,60 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CORE_DISPATCHKEYFUNCTION_H_
+#define _ACTIVEMQ_CORE_DISPATCHKEYFUNCTION_H_
+
+#include <activemq/util/Config.h>
+
+#include <cms/Message.h>
+
+#include <string>
+
+namespace activemq {
+namespace core {
+
+    /**
+     * Interface for an object that picks the ordering key of a message when a session
+     * dispatches to its MessageListeners in parallel.  Messages with the same key are
+     * delivered one at a time in the order they arrived, messages with different keys
+     * may be delivered concurrently.
+     *
+     * @since 3.10
+     */
+    class AMQCPP_API DispatchKeyFunction {
+    public:
+
+        virtual ~DispatchKeyFunction();
+
+        /**
+         * Returns the ordering key of the given message, an empty string means the
+         * message needs no ordering relative to any other message.
+         *
+         * Called from the session's dispatch thread, implementations must not block.
+         *
+         * @param message
+         *      The message about to be handed to a MessageListener.
+         *
+         * @return the ordering key for the message.
+         */
+        virtual std::string getKey(const cms::Message* message) = 0;
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_CORE_DISPATCHKEYFUNCTION_H_ */
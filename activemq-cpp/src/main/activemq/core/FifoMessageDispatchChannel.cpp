@@ -17,6 +17,8 @@
 
 #include "FifoMessageDispatchChannel.h"
 
+#include <decaf/lang/Math.h>
+
 using namespace std;
 using namespace activemq;
 using namespace activemq::core;
@@ -96,6 +98,34 @@ Pointer<MessageDispatch> FifoMessageDispatchChannel::dequeueNoWait() {
     return Pointer<MessageDispatch>();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+std::vector<Pointer<MessageDispatch> > FifoMessageDispatchChannel::dequeueBatch(int maxMessages, long long timeout) {
+    std::vector<Pointer<MessageDispatch> > result;
+
+    synchronized(&channel) {
+        while (timeout != 0 && !closed && (channel.isEmpty() || !running)) {
+            if (timeout == -1) {
+                channel.wait();
+            } else {
+                channel.wait(timeout);
+                break;
+            }
+        }
+
+        if (closed || !running) {
+            return result;
+        }
+
+        int count = Math::min(maxMessages, channel.size());
+        result.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            result.push_back(channel.pop());
+        }
+    }
+
+    return result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<MessageDispatch> FifoMessageDispatchChannel::peek() const {
     synchronized(&channel) {
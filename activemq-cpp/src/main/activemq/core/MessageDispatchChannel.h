@@ -86,6 +86,22 @@ namespace core {
          */
         virtual Pointer<MessageDispatch> dequeueNoWait() = 0;
 
+        /**
+         * Used to get up to maxMessages enqueued messages at once.  Waits for the first
+         * message the same way as dequeue(long long) does and then takes whatever else is
+         * already in the channel, all while holding the channel's lock only once.
+         *
+         * @param maxMessages
+         *      The maximum number of messages to return, must be at least one.
+         * @param timeout
+         *      The time to wait for the first message, see dequeue(long long).
+         *
+         * @return the dequeued messages, empty if we timeout or if the consumer is closed.
+         *
+         * @since 3.10
+         */
+        virtual std::vector<Pointer<MessageDispatch> > dequeueBatch(int maxMessages, long long timeout) = 0;
+
         /**
          * Peek in the Queue and return the first message in the Channel without removing
          * it from the channel.
@@ -0,0 +1,728 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MessageSpool.h"
+
+#include <activemq/exceptions/ActiveMQException.h>
+#include <activemq/wireformat/openwire/OpenWireFormat.h>
+
+#include <decaf/internal/io/FileSystem.h>
+#include <decaf/internal/nio/MappedFile.h>
+#include <decaf/io/ByteArrayInputStream.h>
+#include <decaf/io/DataInputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/io/IOException.h>
+#include <decaf/io/OutputStream.h>
+#include <decaf/lang/Long.h>
+#include <decaf/lang/exceptions/IllegalStateException.h>
+#include <decaf/lang/exceptions/NumberFormatException.h>
+#include <decaf/util/LinkedList.h>
+#include <decaf/util/Properties.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/zip/CRC32.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace activemq::exceptions;
+using namespace activemq::wireformat::openwire;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::internal::io;
+using namespace decaf::internal::nio;
+
+////////////////////////////////////////////////////////////////////////////////
+const int MessageSpool::DEFAULT_SEGMENT_SIZE = 8 * 1024 * 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // Segment file layout, all values are big endian ints:
+    //
+    //   header:  magic | OpenWire version | replay offset | reserved
+    //   record:  payload length | payload CRC32 | payload
+    //
+    // A zero length marks the end of the written records, the length is stored
+    // last when appending so a non zero length means the payload is in place.
+    const int SEGMENT_MAGIC = 0x414D5153;
+    const int MAGIC_OFFSET = 0;
+    const int VERSION_OFFSET = 4;
+    const int REPLAY_OFFSET = 8;
+    const int HEADER_SIZE = 16;
+    const int RECORD_HEADER_SIZE = 8;
+
+    const char* const SEGMENT_PREFIX = "spool-";
+    const char* const SEGMENT_SUFFIX = ".log";
+
+    void putInt(unsigned char* address, int value) {
+        address[0] = (unsigned char) ((value >> 24) & 0xFF);
+        address[1] = (unsigned char) ((value >> 16) & 0xFF);
+        address[2] = (unsigned char) ((value >> 8) & 0xFF);
+        address[3] = (unsigned char) (value & 0xFF);
+    }
+
+    int getInt(const unsigned char* address) {
+        return (int) (((unsigned int) address[0] << 24) | ((unsigned int) address[1] << 16) |
+                      ((unsigned int) address[2] << 8) | (unsigned int) address[3]);
+    }
+
+    int checksum(const unsigned char* data, int length) {
+        decaf::util::zip::CRC32 crc;
+        crc.update(data, length, 0, length);
+        return (int) crc.getValue();
+    }
+
+    /**
+     * Writes straight into the mapped segment, running out of room is remembered
+     * since the marshalers convert whatever is thrown into an IOException.
+     */
+    class MappedOutputStream : public OutputStream {
+    private:
+
+        unsigned char* buffer;
+        int capacity;
+        int position;
+        bool overflow;
+
+    private:
+
+        MappedOutputStream(const MappedOutputStream&);
+        MappedOutputStream& operator=(const MappedOutputStream&);
+
+    public:
+
+        MappedOutputStream(unsigned char* buffer, int capacity) :
+            OutputStream(), buffer(buffer), capacity(capacity), position(0), overflow(false) {
+        }
+
+        virtual ~MappedOutputStream() {}
+
+        int getPosition() const {
+            return this->position;
+        }
+
+        bool isOverflow() const {
+            return this->overflow;
+        }
+
+    protected:
+
+        virtual void doWriteByte(unsigned char value) {
+            if (this->position >= this->capacity) {
+                this->overflow = true;
+                throw IOException(__FILE__, __LINE__, "Spool segment is full");
+            }
+
+            this->buffer[this->position++] = value;
+        }
+
+        virtual void doWriteArrayBounded(const unsigned char* source, int size AMQCPP_UNUSED, int offset, int length) {
+            if (length > this->capacity - this->position) {
+                this->overflow = true;
+                throw IOException(__FILE__, __LINE__, "Spool segment is full");
+            }
+
+            std::copy(source + offset, source + offset + length, this->buffer + this->position);
+            this->position += length;
+        }
+    };
+
+    class Segment {
+    private:
+
+        Segment(const Segment&);
+        Segment& operator=(const Segment&);
+
+    public:
+
+        long long sequence;
+        std::auto_ptr<MappedFile> file;
+        int writeOffset;
+        int records;
+
+        Segment(long long sequence, MappedFile* file) : sequence(sequence), file(file), writeOffset(HEADER_SIZE), records(0) {
+        }
+
+        unsigned char* address() const {
+            return this->file->getAddress();
+        }
+
+        int capacity() const {
+            return (int) this->file->getSize();
+        }
+
+        int version() const {
+            return getInt(address() + VERSION_OFFSET);
+        }
+
+        int replayOffset() const {
+            return getInt(address() + REPLAY_OFFSET);
+        }
+
+        void setReplayOffset(int offset) {
+            putInt(address() + REPLAY_OFFSET, offset);
+        }
+    };
+
+    bool segmentOrder(Segment* left, Segment* right) {
+        return left->sequence < right->sequence;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace core {
+
+    class MessageSpoolImpl {
+    private:
+
+        MessageSpoolImpl(const MessageSpoolImpl&);
+        MessageSpoolImpl& operator=(const MessageSpoolImpl&);
+
+    public:
+
+        std::string directory;
+        int segmentSize;
+        bool opened;
+        int count;
+
+        mutable Mutex mutex;
+
+        // Oldest segment first, appends always go to the last one.
+        LinkedList<Segment*> segments;
+
+        // Offset of the next record to hand out in the oldest segment.
+        int readOffset;
+        Pointer<Message> peeked;
+        int peekedSize;
+
+        OpenWireFormat writer;
+        OpenWireFormat reader;
+
+        MessageSpoolImpl(const std::string& directory, int segmentSize) :
+            directory(directory), segmentSize(segmentSize), opened(false), count(0), mutex(), segments(),
+            readOffset(HEADER_SIZE), peeked(), peekedSize(0), writer(Properties()), reader(Properties()) {
+
+            // Every record has to be readable on its own.
+            this->writer.setCacheEnabled(false);
+            this->reader.setCacheEnabled(false);
+        }
+
+        ~MessageSpoolImpl() {
+            try {
+                closeSegments();
+            }
+            AMQ_CATCHALL_NOTHROW()
+        }
+
+        std::string pathOf(long long sequence) const {
+            return directory + "/" + SEGMENT_PREFIX + Long::toString(sequence) + SEGMENT_SUFFIX;
+        }
+
+        void checkOpen() const {
+            if (!this->opened) {
+                throw IllegalStateException(__FILE__, __LINE__, "The MessageSpool is not open");
+            }
+        }
+
+        void closeSegments() {
+            while (!this->segments.isEmpty()) {
+                Segment* segment = this->segments.removeFirst();
+                try {
+                    segment->file->force();
+                    segment->file->close();
+                } catch (...) {
+                    delete segment;
+                    throw;
+                }
+                delete segment;
+            }
+        }
+
+        Segment* createSegment(long long sequence) {
+
+            std::string path = pathOf(sequence);
+
+            // A leftover file with this name could hold stale records.
+            FileSystem::remove(path);
+
+            std::auto_ptr<Segment> segment(new Segment(sequence, new MappedFile(path, this->segmentSize)));
+            unsigned char* address = segment->address();
+            putInt(address + MAGIC_OFFSET, SEGMENT_MAGIC);
+            putInt(address + VERSION_OFFSET, this->writer.getVersion());
+            segment->setReplayOffset(HEADER_SIZE);
+            putInt(address + HEADER_SIZE, 0);
+
+            return segment.release();
+        }
+
+        /**
+         * Maps an existing segment and finds the end of its intact records, anything
+         * after the first torn or corrupt record is dropped.
+         */
+        Segment* recoverSegment(long long sequence) {
+
+            std::auto_ptr<Segment> segment(new Segment(sequence, new MappedFile(pathOf(sequence), 0)));
+
+            int capacity = segment->capacity();
+            const unsigned char* address = segment->address();
+
+            if (capacity < HEADER_SIZE + RECORD_HEADER_SIZE || getInt(address + MAGIC_OFFSET) != SEGMENT_MAGIC) {
+                return NULL;
+            }
+
+            int replayOffset = segment->replayOffset();
+            int offset = HEADER_SIZE;
+
+            while (offset <= capacity - RECORD_HEADER_SIZE) {
+                int length = getInt(address + offset);
+                if (length <= 0 || length > capacity - offset - RECORD_HEADER_SIZE ||
+                    getInt(address + offset + 4) != checksum(address + offset + RECORD_HEADER_SIZE, length)) {
+                    break;
+                }
+
+                if (offset >= replayOffset) {
+                    segment->records++;
+                }
+
+                offset += RECORD_HEADER_SIZE + length;
+            }
+
+            // Wipe out a torn record so appends start from a clean end marker.
+            if (offset <= capacity - RECORD_HEADER_SIZE) {
+                putInt(segment->address() + offset, 0);
+            }
+
+            segment->writeOffset = offset;
+            if (replayOffset < HEADER_SIZE || replayOffset > offset) {
+                segment->setReplayOffset(offset);
+            }
+
+            return segment.release();
+        }
+
+        void recover() {
+
+            std::vector<std::string> names = FileSystem::list(this->directory);
+            std::vector<Segment*> recovered;
+
+            std::string prefix(SEGMENT_PREFIX);
+            std::string suffix(SEGMENT_SUFFIX);
+
+            try {
+
+                std::vector<std::string>::const_iterator name = names.begin();
+                for (; name != names.end(); ++name) {
+
+                    if (name->length() <= prefix.length() + suffix.length() ||
+                        name->compare(0, prefix.length(), prefix) != 0 ||
+                        name->compare(name->length() - suffix.length(), suffix.length(), suffix) != 0) {
+                        continue;
+                    }
+
+                    long long sequence = 0;
+                    try {
+                        sequence = Long::parseLong(name->substr(prefix.length(), name->length() - prefix.length() - suffix.length()));
+                    } catch (NumberFormatException& ex) {
+                        continue;
+                    }
+
+                    Segment* segment = NULL;
+                    try {
+                        segment = recoverSegment(sequence);
+                    } catch (IOException& ex) {
+                        // Most likely created but never sized before a crash.
+                    }
+
+                    if (segment == NULL) {
+                        FileSystem::remove(pathOf(sequence));
+                    } else if (segment->records == 0) {
+                        segment->file->close();
+                        delete segment;
+                        FileSystem::remove(pathOf(sequence));
+                    } else {
+                        recovered.push_back(segment);
+                    }
+                }
+            } catch (...) {
+                for (std::size_t i = 0; i < recovered.size(); ++i) {
+                    delete recovered[i];
+                }
+                throw;
+            }
+
+            std::sort(recovered.begin(), recovered.end(), segmentOrder);
+
+            for (std::size_t i = 0; i < recovered.size(); ++i) {
+                this->count += recovered[i]->records;
+                this->segments.add(recovered[i]);
+            }
+
+            if (!this->segments.isEmpty()) {
+                this->readOffset = this->segments.getFirst()->replayOffset();
+            }
+        }
+
+        Segment* writeSegment() {
+            if (this->segments.isEmpty()) {
+                this->segments.add(createSegment(0));
+                this->readOffset = HEADER_SIZE;
+            } else if (this->segments.getLast()->version() != this->writer.getVersion()) {
+                // Never mix OpenWire versions inside one segment.
+                rollSegment();
+            }
+
+            return this->segments.getLast();
+        }
+
+        void rollSegment() {
+            Segment* last = this->segments.getLast();
+            last->file->force();
+            this->segments.add(createSegment(last->sequence + 1));
+        }
+
+        /**
+         * Marshals the message into the free space of the given segment.
+         *
+         * @return the payload size or -1 if the message didn't fit.
+         */
+        int writeRecord(Segment* segment, const Pointer<Message>& message) {
+
+            // Keep room for the end marker after the record.
+            int available = segment->capacity() - segment->writeOffset - RECORD_HEADER_SIZE - 4;
+            if (available <= 0) {
+                return -1;
+            }
+
+            unsigned char* record = segment->address() + segment->writeOffset;
+
+            MappedOutputStream buffer(record + RECORD_HEADER_SIZE, available);
+            DataOutputStream dataOut(&buffer);
+
+            try {
+                this->writer.looseMarshalNestedObject(message.get(), &dataOut);
+                dataOut.flush();
+            } catch (IOException& ex) {
+                if (buffer.isOverflow()) {
+                    return -1;
+                }
+                throw;
+            }
+
+            int length = buffer.getPosition();
+
+            // Terminate first and publish the length last, a crash in between leaves
+            // either no record or a record whose checksum can be verified.
+            putInt(record + RECORD_HEADER_SIZE + length, 0);
+            putInt(record + 4, checksum(record + RECORD_HEADER_SIZE, length));
+            putInt(record, length);
+
+            segment->writeOffset += RECORD_HEADER_SIZE + length;
+            segment->records++;
+
+            return length;
+        }
+
+        void append(const Pointer<Message>& message) {
+
+            Segment* segment = writeSegment();
+
+            if (writeRecord(segment, message) >= 0) {
+                this->count++;
+                return;
+            }
+
+            if (segment->writeOffset == HEADER_SIZE) {
+                throw IOException(__FILE__, __LINE__, "Message is larger than the spool segment size of %d bytes", this->segmentSize);
+            }
+
+            rollSegment();
+
+            if (writeRecord(this->segments.getLast(), message) < 0) {
+                throw IOException(__FILE__, __LINE__, "Message is larger than the spool segment size of %d bytes", this->segmentSize);
+            }
+
+            this->count++;
+        }
+
+        /**
+         * Drops fully replayed segments from the front of the log, the segment that is
+         * being written is kept.
+         */
+        void releaseReplayed() {
+            while (this->segments.size() > 1) {
+                Segment* first = this->segments.getFirst();
+                if (this->readOffset < first->writeOffset) {
+                    break;
+                }
+
+                this->segments.removeFirst();
+                std::string path = first->file->getPath();
+                try {
+                    first->file->close();
+                } catch (...) {
+                }
+                delete first;
+                FileSystem::remove(path);
+
+                this->readOffset = this->segments.getFirst()->replayOffset();
+            }
+        }
+
+        Pointer<Message> peek() {
+
+            if (this->peeked != NULL) {
+                return this->peeked;
+            }
+
+            releaseReplayed();
+
+            if (this->count == 0 || this->segments.isEmpty()) {
+                return Pointer<Message>();
+            }
+
+            Segment* segment = this->segments.getFirst();
+            if (this->readOffset >= segment->writeOffset) {
+                return Pointer<Message>();
+            }
+
+            const unsigned char* record = segment->address() + this->readOffset;
+            int length = getInt(record);
+
+            if (this->reader.getVersion() != segment->version()) {
+                this->reader.setVersion(segment->version());
+            }
+
+            ByteArrayInputStream buffer(record + RECORD_HEADER_SIZE, length);
+            DataInputStream dataIn(&buffer);
+
+            Pointer<Message> message;
+            try {
+                Pointer<DataStructure> object(this->reader.looseUnmarshalNestedObject(&dataIn));
+                message = object.dynamicCast<Message>();
+            } catch (Exception& ex) {
+                // Skip a record that can't be decoded rather than blocking the spool.
+                skip(RECORD_HEADER_SIZE + length);
+                throw IOException(__FILE__, __LINE__, "Discarded an unreadable spool record: %s", ex.getMessage().c_str());
+            }
+
+            this->peeked = message;
+            this->peekedSize = RECORD_HEADER_SIZE + length;
+
+            return message;
+        }
+
+        void remove() {
+
+            if (this->peeked == NULL && peek() == NULL) {
+                return;
+            }
+
+            this->peeked.reset(NULL);
+            skip(this->peekedSize);
+            this->peekedSize = 0;
+        }
+
+        void skip(int recordSize) {
+
+            this->readOffset += recordSize;
+            this->segments.getFirst()->setReplayOffset(this->readOffset);
+            this->count--;
+
+            releaseReplayed();
+        }
+    };
+
+}}
+
+////////////////////////////////////////////////////////////////////////////////
+MessageSpool::MessageSpool(const std::string& directory, int segmentSize) :
+    impl(new MessageSpoolImpl(directory, segmentSize)) {
+
+    if (segmentSize < HEADER_SIZE + RECORD_HEADER_SIZE + 4) {
+        delete this->impl;
+        throw IllegalArgumentException(__FILE__, __LINE__, "Spool segment size is too small: %d", segmentSize);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MessageSpool::~MessageSpool() {
+    try {
+        delete this->impl;
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const std::string& MessageSpool::getDirectory() const {
+    return this->impl->directory;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int MessageSpool::getSegmentSize() const {
+    return this->impl->segmentSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpool::open() {
+
+    try {
+
+        synchronized(&this->impl->mutex) {
+
+            if (this->impl->opened) {
+                return;
+            }
+
+            FileSystem::makeDirectories(this->impl->directory);
+            this->impl->recover();
+            this->impl->opened = true;
+        }
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpool::close() {
+
+    try {
+
+        synchronized(&this->impl->mutex) {
+
+            if (!this->impl->opened) {
+                return;
+            }
+
+            this->impl->opened = false;
+            this->impl->peeked.reset(NULL);
+            this->impl->count = 0;
+            this->impl->closeSegments();
+        }
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool MessageSpool::isOpen() const {
+    synchronized(&this->impl->mutex) {
+        return this->impl->opened;
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpool::append(const Pointer<Message>& message) {
+
+    try {
+
+        if (message == NULL) {
+            throw NullPointerException(__FILE__, __LINE__, "Cannot spool a NULL message");
+        }
+
+        synchronized(&this->impl->mutex) {
+            this->impl->checkOpen();
+            this->impl->append(message);
+        }
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_RETHROW(IllegalStateException)
+    AMQ_CATCH_RETHROW(NullPointerException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<Message> MessageSpool::peek() {
+
+    try {
+
+        synchronized(&this->impl->mutex) {
+            this->impl->checkOpen();
+            return this->impl->peek();
+        }
+
+        return Pointer<Message>();
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_RETHROW(IllegalStateException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpool::remove() {
+
+    try {
+
+        synchronized(&this->impl->mutex) {
+            this->impl->checkOpen();
+            this->impl->remove();
+        }
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_RETHROW(IllegalStateException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int MessageSpool::size() const {
+    synchronized(&this->impl->mutex) {
+        return this->impl->count;
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool MessageSpool::isEmpty() const {
+    return this->size() == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpool::sync() {
+
+    try {
+
+        synchronized(&this->impl->mutex) {
+            this->impl->checkOpen();
+
+            // Earlier segments were forced when the log rolled past them.
+            if (!this->impl->segments.isEmpty()) {
+                this->impl->segments.getLast()->file->force();
+            }
+        }
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_RETHROW(IllegalStateException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
@@ -0,0 +1,167 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CORE_MESSAGESPOOL_H_
+#define _ACTIVEMQ_CORE_MESSAGESPOOL_H_
+
+#include <activemq/util/Config.h>
+
+#include <activemq/commands/Message.h>
+#include <decaf/lang/Pointer.h>
+
+#include <string>
+
+namespace activemq {
+namespace core {
+
+    class MessageSpoolImpl;
+
+    /**
+     * A local, file backed, store and forward queue for outgoing messages.
+     *
+     * The spool is an append only log split into fixed size segment files that are
+     * memory mapped, appending a message costs a marshal and a memory copy.  Messages
+     * are handed back in the order they were appended, each record is removed only
+     * once the caller has forwarded it, and a segment file is deleted once all of its
+     * records have been removed.
+     *
+     * Every record carries a checksum and each segment remembers how far it has been
+     * replayed, so when a spool is opened over the files of a process that crashed the
+     * intact records that were not yet forwarded are recovered and a record that was
+     * only partly written is discarded.  A crash while forwarding can repeat the last
+     * record, the broker's duplicate detection filters those out.
+     *
+     * All methods are thread safe.
+     *
+     * @since 3.10
+     */
+    class AMQCPP_API MessageSpool {
+    private:
+
+        MessageSpoolImpl* impl;
+
+    private:
+
+        MessageSpool(const MessageSpool&);
+        MessageSpool& operator=(const MessageSpool&);
+
+    public:
+
+        /**
+         * The default size of a segment file, 8 MB.
+         */
+        static const int DEFAULT_SEGMENT_SIZE;
+
+    public:
+
+        /**
+         * Creates a spool that keeps its segment files in the given directory, the
+         * spool does nothing with the directory until it is opened.
+         *
+         * @param directory
+         *      The directory that holds the spool's segment files.
+         * @param segmentSize
+         *      The size of each segment file, this also bounds the size of one message.
+         */
+        MessageSpool(const std::string& directory, int segmentSize = DEFAULT_SEGMENT_SIZE);
+
+        virtual ~MessageSpool();
+
+        /**
+         * @return the directory that holds the spool's segment files.
+         */
+        const std::string& getDirectory() const;
+
+        /**
+         * @return the size of each segment file.
+         */
+        int getSegmentSize() const;
+
+        /**
+         * Opens the spool creating its directory if needed and recovering any messages
+         * left behind by a previous run.
+         *
+         * @throws IOException if the directory or the segment files can't be used.
+         */
+        void open();
+
+        /**
+         * Flushes and closes the segment files, messages that haven't been removed stay
+         * on disk and are recovered when the spool is next opened.
+         *
+         * @throws IOException if an error occurs while closing the segment files.
+         */
+        void close();
+
+        /**
+         * @return true if the spool is open.
+         */
+        bool isOpen() const;
+
+        /**
+         * Appends a message to the end of the spool.
+         *
+         * @param message
+         *      The message to append.
+         *
+         * @throws IOException if the message can't be written or is larger than a segment.
+         * @throws IllegalStateException if the spool is not open.
+         */
+        void append(const decaf::lang::Pointer<commands::Message>& message);
+
+        /**
+         * Returns the oldest message in the spool without removing it, repeated calls
+         * return the same message until remove() is called.
+         *
+         * @return the oldest message or NULL if the spool is empty.
+         *
+         * @throws IOException if the message can't be read.
+         * @throws IllegalStateException if the spool is not open.
+         */
+        decaf::lang::Pointer<commands::Message> peek();
+
+        /**
+         * Removes the oldest message from the spool, does nothing if the spool is empty.
+         *
+         * @throws IOException if an error occurs while updating the segment files.
+         * @throws IllegalStateException if the spool is not open.
+         */
+        void remove();
+
+        /**
+         * @return the number of messages held in the spool.
+         */
+        int size() const;
+
+        /**
+         * @return true if the spool holds no messages.
+         */
+        bool isEmpty() const;
+
+        /**
+         * Forces everything appended so far out to the storage device, without this
+         * the records survive a crash of the process but not of the machine.
+         *
+         * @throws IOException if the segment files can't be flushed.
+         */
+        void sync();
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_CORE_MESSAGESPOOL_H_ */
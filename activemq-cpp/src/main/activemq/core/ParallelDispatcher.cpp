@@ -0,0 +1,111 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ParallelDispatcher.h"
+
+#include <activemq/commands/Message.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/util/concurrent/Executors.h>
+#include <decaf/util/concurrent/TimeUnit.h>
+
+using namespace activemq;
+using namespace activemq::core;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+ParallelDispatcher::ParallelDispatcher(int workers, DispatchKeyFunction* keyFunction) :
+    workers(), keyFunction(keyFunction), nextWorker() {
+
+    if (workers < 1) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Parallel dispatch needs at least one worker");
+    }
+
+    this->workers.reserve(workers);
+    for (int i = 0; i < workers; ++i) {
+        this->workers.push_back(Pointer<ExecutorService>(Executors::newSingleThreadExecutor()));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ParallelDispatcher::~ParallelDispatcher() {
+    try {
+        close(0);
+    }
+    DECAF_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ParallelDispatcher::execute(const cms::Message* message, Runnable* task) {
+
+    std::string key = getKey(message);
+
+    unsigned int index = 0;
+    if (key.empty()) {
+        index = (unsigned int) this->nextWorker.getAndIncrement();
+    } else {
+        for (std::string::const_iterator iter = key.begin(); iter != key.end(); ++iter) {
+            index = 31 * index + (unsigned char) *iter;
+        }
+    }
+
+    this->workers[index % this->workers.size()]->execute(task, true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string ParallelDispatcher::getKey(const cms::Message* message) const {
+
+    if (this->keyFunction != NULL) {
+        return this->keyFunction->getKey(message);
+    }
+
+    return getGroupId(message);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ParallelDispatcher::close(long long timeout) {
+
+    std::vector< Pointer<ExecutorService> >::iterator iter = this->workers.begin();
+    for (; iter != this->workers.end(); ++iter) {
+        (*iter)->shutdown();
+    }
+
+    for (iter = this->workers.begin(); iter != this->workers.end(); ++iter) {
+        (*iter)->awaitTermination(timeout, TimeUnit::MILLISECONDS);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string ParallelDispatcher::getGroupId(const cms::Message* message) {
+
+    if (message == NULL) {
+        return "";
+    }
+
+    const commands::Message* amqMessage = dynamic_cast<const commands::Message*>(message);
+    if (amqMessage != NULL) {
+        return amqMessage->getGroupID();
+    }
+
+    if (message->propertyExists("JMSXGroupID")) {
+        return message->getStringProperty("JMSXGroupID");
+    }
+
+    return "";
+}
@@ -0,0 +1,132 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CORE_PARALLELDISPATCHER_H_
+#define _ACTIVEMQ_CORE_PARALLELDISPATCHER_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/core/DispatchKeyFunction.h>
+
+#include <cms/Message.h>
+
+#include <decaf/lang/Pointer.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/util/concurrent/ExecutorService.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+
+#include <string>
+#include <vector>
+
+namespace activemq {
+namespace core {
+
+    using decaf::lang::Pointer;
+
+    /**
+     * Runs MessageListener deliveries for a session on a pool of worker threads.
+     *
+     * Each worker has its own FIFO queue and a message is always queued on the worker
+     * selected by its ordering key, so messages with the same key run one at a time in
+     * arrival order while different keys use all the workers.  Messages without a key
+     * are spread over the workers round robin.  Keeping acknowledgements in order is up
+     * to the consumer that submits the deliveries.
+     *
+     * @since 3.10
+     */
+    class AMQCPP_API ParallelDispatcher {
+    private:
+
+        std::vector< Pointer<decaf::util::concurrent::ExecutorService> > workers;
+        DispatchKeyFunction* keyFunction;
+        decaf::util::concurrent::atomic::AtomicInteger nextWorker;
+
+    private:
+
+        ParallelDispatcher(const ParallelDispatcher&);
+        ParallelDispatcher& operator=(const ParallelDispatcher&);
+
+    public:
+
+        /**
+         * Creates a dispatcher with the given number of worker threads.
+         *
+         * @param workers
+         *      The number of worker threads, must be at least one.
+         * @param keyFunction
+         *      Picks the ordering key of each message, the message group id is used when NULL.
+         *      The caller retains ownership and must keep it alive as long as this dispatcher.
+         *
+         * @throws IllegalArgumentException if workers is less than one.
+         */
+        ParallelDispatcher(int workers, DispatchKeyFunction* keyFunction);
+
+        virtual ~ParallelDispatcher();
+
+        /**
+         * Queues a task on the worker that owns the ordering key of the given message.
+         *
+         * @param message
+         *      The message the task delivers, used to compute the ordering key.
+         * @param task
+         *      The task to run, this dispatcher takes ownership of it.
+         *
+         * @throws RejectedExecutionException if the dispatcher has been closed.
+         */
+        void execute(const cms::Message* message, decaf::lang::Runnable* task);
+
+        /**
+         * @return the ordering key this dispatcher uses for the given message.
+         */
+        std::string getKey(const cms::Message* message) const;
+
+        /**
+         * @return the number of worker threads.
+         */
+        int getWorkerCount() const {
+            return (int) this->workers.size();
+        }
+
+        /**
+         * @return the key function in use or NULL when ordering by message group.
+         */
+        DispatchKeyFunction* getKeyFunction() const {
+            return this->keyFunction;
+        }
+
+        /**
+         * Stops accepting new tasks and waits for the queued ones to complete.
+         *
+         * @param timeout
+         *      The maximum time in milliseconds to wait for each worker to finish.
+         */
+        void close(long long timeout);
+
+        /**
+         * Returns the JMSXGroupID of a message, or an empty string if it has none.
+         *
+         * @param message
+         *      The message whose group is requested.
+         *
+         * @return the message group id.
+         */
+        static std::string getGroupId(const cms::Message* message);
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_CORE_PARALLELDISPATCHER_H_ */
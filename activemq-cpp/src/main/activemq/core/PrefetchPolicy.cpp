@@ -17,7 +17,9 @@
 
 #include "PrefetchPolicy.h"
 
+#include <decaf/lang/Boolean.h>
 #include <decaf/lang/Integer.h>
+#include <decaf/lang/Long.h>
 
 using namespace activemq;
 using namespace activemq::core;
@@ -75,6 +77,19 @@ void PrefetchPolicy::configure(const decaf::util::Properties& properties) {
             this->setQueuePrefetch(value);
             this->setTopicPrefetch(value);
         }
+
+        if (properties.hasProperty("cms.prefetchPolicy.adaptive")) {
+            this->setAdaptive(Boolean::parseBoolean(
+                properties.getProperty("cms.prefetchPolicy.adaptive")));
+        }
+        if (properties.hasProperty("cms.prefetchPolicy.adaptiveTargetLatency")) {
+            this->setAdaptiveTargetLatency(Long::parseLong(
+                properties.getProperty("cms.prefetchPolicy.adaptiveTargetLatency")));
+        }
+        if (properties.hasProperty("cms.prefetchPolicy.adaptiveMinimumPrefetch")) {
+            this->setAdaptiveMinimumPrefetch(Integer::parseInt(
+                properties.getProperty("cms.prefetchPolicy.adaptiveMinimumPrefetch")));
+        }
     }
     DECAF_CATCH_RETHROW(Exception)
     DECAF_CATCHALL_THROW(Exception)
@@ -122,6 +122,61 @@ namespace core {
          */
         virtual int getMaxPrefetchLimit(int value) const = 0;
 
+        /**
+         * Sets whether consumers adapt their prefetch window at runtime.  When enabled
+         * a consumer with a non-zero prefetch starts with a small window and grows or
+         * shrinks it based on its measured processing rate, never exceeding the prefetch
+         * value it was created with.
+         *
+         * @param value
+         *      true if consumers should adapt their prefetch window.
+         *
+         * @since 3.10
+         */
+        virtual void setAdaptive(bool value) = 0;
+
+        /**
+         * @return true if consumers adapt their prefetch window at runtime.
+         *
+         * @since 3.10
+         */
+        virtual bool isAdaptive() const = 0;
+
+        /**
+         * Sets the time in milliseconds that a message should at most wait in a consumer's
+         * prefetch buffer when adaptive prefetch is enabled.
+         *
+         * @param value
+         *      The target latency in milliseconds.
+         *
+         * @since 3.10
+         */
+        virtual void setAdaptiveTargetLatency(long long value) = 0;
+
+        /**
+         * @return the target latency in milliseconds used by adaptive prefetch.
+         *
+         * @since 3.10
+         */
+        virtual long long getAdaptiveTargetLatency() const = 0;
+
+        /**
+         * Sets the smallest window an adaptive consumer will shrink to.
+         *
+         * @param value
+         *      The minimum prefetch window, must be at least one.
+         *
+         * @since 3.10
+         */
+        virtual void setAdaptiveMinimumPrefetch(int value) = 0;
+
+        /**
+         * @return the smallest window an adaptive consumer will shrink to.
+         *
+         * @since 3.10
+         */
+        virtual int getAdaptiveMinimumPrefetch() const = 0;
+
         /**
          * Clone the Policy and return a new pointer to that clone.
          *
@@ -102,6 +102,34 @@ Pointer<MessageDispatch> SimplePriorityMessageDispatchChannel::dequeueNoWait() {
     return Pointer<MessageDispatch>();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+std::vector<Pointer<MessageDispatch> > SimplePriorityMessageDispatchChannel::dequeueBatch(int maxMessages, long long timeout) {
+    std::vector<Pointer<MessageDispatch> > result;
+
+    synchronized(&mutex) {
+        while (timeout != 0 && !closed && (isEmpty() || !running)) {
+            if (timeout == -1) {
+                mutex.wait();
+            } else {
+                mutex.wait((unsigned long) timeout);
+                break;
+            }
+        }
+
+        if (closed || !running) {
+            return result;
+        }
+
+        int count = Math::min(maxMessages, size());
+        result.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            result.push_back(removeFirst());
+        }
+    }
+
+    return result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<MessageDispatch> SimplePriorityMessageDispatchChannel::peek() const {
     synchronized(&mutex) {
@@ -0,0 +1,706 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TopicFanOut.h"
+
+#include <activemq/core/ActiveMQConnection.h>
+#include <activemq/core/ActiveMQConstants.h>
+#include <activemq/core/PrefetchPolicy.h>
+#include <activemq/commands/ActiveMQDestination.h>
+#include <activemq/commands/MessageDispatch.h>
+#include <activemq/commands/MessageId.h>
+#include <activemq/exceptions/ActiveMQException.h>
+
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/util/ArrayList.h>
+#include <decaf/util/LinkedList.h>
+#include <decaf/util/StlMap.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+
+#include <utility>
+#include <vector>
+
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace activemq::exceptions;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::atomic;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    /**
+     * A message dispatched to the shared subscription along with the number of
+     * members that still have to consume it, and that still have to report it
+     * delivered.
+     */
+    class FanOutEntry {
+    public:
+
+        Pointer<MessageId> messageId;
+        int remaining;
+        int undelivered;
+
+        // Set once the broker was sent a delivered ack for it.
+        bool delivered;
+
+        // Set once a member's poison or expired ack was forwarded, the broker no longer
+        // counts it as dispatched to the shared subscription.
+        bool settled;
+
+        FanOutEntry(const Pointer<MessageId>& messageId, int remaining) :
+            messageId(messageId), remaining(remaining), undelivered(remaining), delivered(false), settled(false) {
+        }
+    };
+
+    class FanOutMember {
+    private:
+
+        FanOutMember(const FanOutMember&);
+        FanOutMember& operator=(const FanOutMember&);
+
+    public:
+
+        Pointer<ConsumerId> consumerId;
+        Dispatcher* dispatcher;
+
+        // Entries this member was given and has not acked yet, in dispatch order.
+        LinkedList< Pointer<FanOutEntry> > outstanding;
+
+        // Outstanding entries this member hasn't sent a delivered ack for yet.
+        LinkedList< Pointer<FanOutEntry> > undelivered;
+
+        FanOutMember(const Pointer<ConsumerId>& consumerId, Dispatcher* dispatcher) :
+            consumerId(consumerId), dispatcher(dispatcher), outstanding(), undelivered() {
+        }
+
+        /**
+         * Removes the leading entries of the list up to and including the one with the
+         * given id, nothing is removed if the list doesn't hold it.
+         */
+        static std::vector< Pointer<FanOutEntry> > removeUpTo(LinkedList< Pointer<FanOutEntry> >& list,
+                                                              const MessageId& lastId) {
+            std::vector< Pointer<FanOutEntry> > removed;
+
+            int index = -1;
+            int position = 0;
+            Pointer< Iterator< Pointer<FanOutEntry> > > iter(list.iterator());
+            while (iter->hasNext()) {
+                if (iter->next()->messageId->equals(lastId)) {
+                    index = position;
+                    break;
+                }
+                position++;
+            }
+
+            for (int i = 0; i <= index; ++i) {
+                removed.push_back(list.removeFirst());
+            }
+
+            return removed;
+        }
+
+        /**
+         * Stops waiting on this member for the given entry.
+         */
+        void release(const Pointer<FanOutEntry>& entry) {
+            entry->remaining--;
+            if (this->undelivered.removeFirstOccurrence(entry)) {
+                entry->undelivered--;
+            }
+        }
+    };
+
+    class SharedSubscription : public Dispatcher {
+    private:
+
+        SharedSubscription(const SharedSubscription&);
+        SharedSubscription& operator=(const SharedSubscription&);
+
+    public:
+
+        std::string key;
+        Pointer<ConsumerInfo> info;
+        ActiveMQConnection* connection;
+        Mutex* mutex;
+
+        LinkedList< Pointer<FanOutMember> > members;
+        LinkedList< Pointer<FanOutEntry> > entries;
+
+        // The run of messages every member has consumed that the broker wasn't told about.
+        Pointer<MessageId> firstConsumed;
+        Pointer<MessageId> lastConsumed;
+        int consumedCount;
+
+        // Released once the broker answered the creating member's ConsumerInfo, failure
+        // holds the reason when it was refused.
+        CountDownLatch registered;
+        bool failed;
+        std::string failure;
+
+    public:
+
+        SharedSubscription(const std::string& key, const Pointer<ConsumerInfo>& info,
+                           ActiveMQConnection* connection, Mutex* mutex) :
+            Dispatcher(), key(key), info(info), connection(connection), mutex(mutex),
+            members(), entries(), firstConsumed(), lastConsumed(), consumedCount(0),
+            registered(1), failed(false), failure() {
+        }
+
+        virtual ~SharedSubscription() {}
+
+        virtual void dispatch(const Pointer<MessageDispatch>& dispatch) {
+
+            Pointer<Message> message = dispatch->getMessage();
+            if (message == NULL) {
+                return;
+            }
+
+            std::vector< std::pair<Dispatcher*, Pointer<MessageDispatch> > > targets;
+            std::vector< Pointer<MessageAck> > acks;
+
+            synchronized(this->mutex) {
+
+                Pointer<FanOutEntry> entry(new FanOutEntry(message->getMessageId(), this->members.size()));
+                this->entries.add(entry);
+
+                bool first = true;
+                Pointer< Iterator< Pointer<FanOutMember> > > iter(this->members.iterator());
+                while (iter->hasNext()) {
+                    Pointer<FanOutMember> member = iter->next();
+                    member->outstanding.add(entry);
+                    member->undelivered.add(entry);
+
+                    // Members count redeliveries on the message itself, so every member
+                    // after the first gets its own copy of the unmarshalled message.
+                    Pointer<MessageDispatch> copy(new MessageDispatch());
+                    copy->setConsumerId(member->consumerId);
+                    copy->setDestination(dispatch->getDestination());
+                    copy->setRedeliveryCounter(dispatch->getRedeliveryCounter());
+                    copy->setMessage(first ? message : message->copy());
+                    first = false;
+
+                    targets.push_back(std::make_pair(member->dispatcher, copy));
+                }
+
+                this->drain(acks);
+            }
+
+            // Consumers can ack from within their dispatch so don't hold the lock while
+            // handing out the messages, the connection's dispatcher lock keeps the member
+            // dispatchers alive until this returns.
+            std::vector< std::pair<Dispatcher*, Pointer<MessageDispatch> > >::iterator target = targets.begin();
+            for (; target != targets.end(); ++target) {
+                target->first->dispatch(target->second);
+            }
+
+            this->sendAcks(acks);
+        }
+
+        virtual int getHashCode() const {
+            return this->info->getConsumerId()->getHashCode();
+        }
+
+        Pointer<FanOutMember> findMember(const ConsumerId& consumerId) const {
+            Pointer< Iterator< Pointer<FanOutMember> > > iter(this->members.iterator());
+            while (iter->hasNext()) {
+                Pointer<FanOutMember> member = iter->next();
+                if (member->consumerId->equals(consumerId)) {
+                    return member;
+                }
+            }
+
+            return Pointer<FanOutMember>();
+        }
+
+        /**
+         * Removes a member, the messages it didn't ack are no longer waited on.  Must be
+         * called with the lock held.
+         */
+        void removeMember(const ConsumerId& consumerId, std::vector< Pointer<MessageAck> >& acks) {
+
+            Pointer<FanOutMember> member = this->findMember(consumerId);
+            if (member == NULL) {
+                return;
+            }
+
+            this->members.remove(member);
+            while (!member->outstanding.isEmpty()) {
+                member->release(member->outstanding.removeFirst());
+            }
+
+            this->drain(acks);
+        }
+
+        /**
+         * Applies a member's ack to the entries it was given, the acks the broker has to be
+         * sent in return are added to the given vector.  Must be called with the lock held.
+         */
+        void acknowledge(const MessageAck& ack, std::vector< Pointer<MessageAck> >& acks) {
+
+            // Redelivered acks only concern the member's own redelivery counting.
+            if (ack.getAckType() == ActiveMQConstants::ACK_TYPE_REDELIVERED || ack.getLastMessageId() == NULL) {
+                return;
+            }
+
+            Pointer<FanOutMember> member = this->findMember(*ack.getConsumerId());
+            if (member == NULL) {
+                return;
+            }
+
+            const MessageId& lastId = *ack.getLastMessageId();
+
+            if (ack.getAckType() == ActiveMQConstants::ACK_TYPE_DELIVERED) {
+
+                // The broker extends the window once every member got that far.
+                std::vector< Pointer<FanOutEntry> > delivered = FanOutMember::removeUpTo(member->undelivered, lastId);
+                std::vector< Pointer<FanOutEntry> >::const_iterator iter = delivered.begin();
+                for (; iter != delivered.end(); ++iter) {
+                    (*iter)->undelivered--;
+                }
+
+            } else if (ack.getAckType() == ActiveMQConstants::ACK_TYPE_POISON ||
+                       ack.getAckType() == ActiveMQConstants::ACK_TYPE_EXPIRED) {
+
+                // These cover the range from the first to the last id, which need not start
+                // at the member's oldest outstanding message.
+                bool inRange = ack.getFirstMessageId() == NULL;
+                Pointer< Iterator< Pointer<FanOutEntry> > > iter(member->outstanding.iterator());
+                while (iter->hasNext()) {
+                    Pointer<FanOutEntry> entry = iter->next();
+                    if (!inRange && entry->messageId->equals(*ack.getFirstMessageId())) {
+                        inRange = true;
+                    }
+
+                    if (!inRange && !entry->messageId->equals(lastId)) {
+                        continue;
+                    }
+
+                    iter->remove();
+                    member->release(entry);
+                    this->settle(ack, entry, acks);
+
+                    if (entry->messageId->equals(lastId)) {
+                        break;
+                    }
+                }
+
+            } else if (ack.getAckType() == ActiveMQConstants::ACK_TYPE_INDIVIDUAL) {
+                Pointer< Iterator< Pointer<FanOutEntry> > > iter(member->outstanding.iterator());
+                while (iter->hasNext()) {
+                    Pointer<FanOutEntry> entry = iter->next();
+                    if (entry->messageId->equals(lastId)) {
+                        iter->remove();
+                        member->release(entry);
+                        break;
+                    }
+                }
+            } else {
+
+                // All other acks cover everything the member was given up to the last id.
+                std::vector< Pointer<FanOutEntry> > consumed = FanOutMember::removeUpTo(member->outstanding, lastId);
+                std::vector< Pointer<FanOutEntry> >::const_iterator iter = consumed.begin();
+                for (; iter != consumed.end(); ++iter) {
+                    member->release(*iter);
+                }
+            }
+
+            this->drain(acks);
+        }
+
+        /**
+         * Forwards a member's poison or expired ack for a single entry under the shared
+         * ConsumerId the first time one arrives for it, the broker then handles the message
+         * for every member.
+         */
+        void settle(const MessageAck& ack, const Pointer<FanOutEntry>& entry,
+                    std::vector< Pointer<MessageAck> >& acks) {
+
+            if (entry->settled) {
+                return;
+            }
+
+            entry->settled = true;
+
+            Pointer<MessageAck> forward(new MessageAck());
+            forward->setAckType(ack.getAckType());
+            forward->setConsumerId(this->info->getConsumerId());
+            forward->setDestination(this->info->getDestination());
+            forward->setFirstMessageId(entry->messageId);
+            forward->setLastMessageId(entry->messageId);
+            forward->setMessageCount(1);
+            forward->setPoisonCause(ack.getPoisonCause());
+            acks.push_back(forward);
+        }
+
+        /**
+         * Retires the entries at the head of the dispatch order that every member has
+         * consumed, adds an ack for the broker once enough of them have accumulated and a
+         * delivered ack for the entries every remaining member has reported delivered.
+         */
+        void drain(std::vector< Pointer<MessageAck> >& acks) {
+
+            while (!this->entries.isEmpty() && this->entries.getFirst()->remaining <= 0) {
+                Pointer<FanOutEntry> entry = this->entries.removeFirst();
+
+                // The broker already dropped a settled message from the subscription.
+                if (entry->settled) {
+                    continue;
+                }
+
+                if (this->firstConsumed == NULL) {
+                    this->firstConsumed = entry->messageId;
+                }
+                this->lastConsumed = entry->messageId;
+                this->consumedCount++;
+            }
+
+            int threshold = this->info->getPrefetchSize() / 2;
+            if (this->consumedCount > 0 && this->consumedCount >= threshold) {
+
+                Pointer<MessageAck> ack(new MessageAck());
+                ack->setAckType(ActiveMQConstants::ACK_TYPE_CONSUMED);
+                ack->setConsumerId(this->info->getConsumerId());
+                ack->setDestination(this->info->getDestination());
+                ack->setFirstMessageId(this->firstConsumed);
+                ack->setLastMessageId(this->lastConsumed);
+                ack->setMessageCount(this->consumedCount);
+                acks.push_back(ack);
+
+                this->firstConsumed.reset(NULL);
+                this->lastConsumed.reset(NULL);
+                this->consumedCount = 0;
+            }
+
+            Pointer<MessageId> firstDelivered;
+            Pointer<MessageId> lastDelivered;
+            int deliveredCount = 0;
+
+            Pointer< Iterator< Pointer<FanOutEntry> > > iter(this->entries.iterator());
+            while (iter->hasNext()) {
+                Pointer<FanOutEntry> entry = iter->next();
+                if (entry->delivered || entry->settled) {
+                    continue;
+                } else if (entry->undelivered > 0) {
+                    break;
+                }
+
+                entry->delivered = true;
+                if (firstDelivered == NULL) {
+                    firstDelivered = entry->messageId;
+                }
+                lastDelivered = entry->messageId;
+                deliveredCount++;
+            }
+
+            if (deliveredCount > 0) {
+                Pointer<MessageAck> ack(new MessageAck());
+                ack->setAckType(ActiveMQConstants::ACK_TYPE_DELIVERED);
+                ack->setConsumerId(this->info->getConsumerId());
+                ack->setDestination(this->info->getDestination());
+                ack->setFirstMessageId(firstDelivered);
+                ack->setLastMessageId(lastDelivered);
+                ack->setMessageCount(deliveredCount);
+                acks.push_back(ack);
+            }
+        }
+
+        void clear() {
+            this->entries.clear();
+            Pointer< Iterator< Pointer<FanOutMember> > > iter(this->members.iterator());
+            while (iter->hasNext()) {
+                Pointer<FanOutMember> member = iter->next();
+                member->outstanding.clear();
+                member->undelivered.clear();
+            }
+
+            this->firstConsumed.reset(NULL);
+            this->lastConsumed.reset(NULL);
+            this->consumedCount = 0;
+        }
+
+        void sendAcks(const std::vector< Pointer<MessageAck> >& acks) {
+
+            try {
+                std::vector< Pointer<MessageAck> >::const_iterator iter = acks.begin();
+                for (; iter != acks.end(); ++iter) {
+                    this->connection->oneway(*iter);
+                }
+            } catch (Exception& e) {
+                this->connection->onClientInternalException(e);
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace core {
+
+    class TopicFanOutConfig {
+    private:
+
+        TopicFanOutConfig(const TopicFanOutConfig&);
+        TopicFanOutConfig& operator=(const TopicFanOutConfig&);
+
+    public:
+
+        mutable Mutex mutex;
+        StlMap< std::string, Pointer<SharedSubscription> > subscriptions;
+        StlMap< Pointer<ConsumerId>, Pointer<SharedSubscription>, ConsumerId::COMPARATOR > members;
+        AtomicInteger memberCount;
+
+        TopicFanOutConfig() : mutex(), subscriptions(), members(), memberCount() {
+        }
+
+        /**
+         * Fails a subscription the broker refused, it is forgotten along with every member
+         * and the members waiting for its registration are released.
+         */
+        void failSubscription(ActiveMQConnection* connection, Pointer<SharedSubscription> subscription,
+                              const std::string& reason) {
+
+            synchronized(&this->mutex) {
+
+                if (this->subscriptions.containsKey(subscription->key) &&
+                    this->subscriptions.get(subscription->key) == subscription) {
+
+                    this->subscriptions.remove(subscription->key);
+                }
+
+                // Every member that joined while the ConsumerInfo was in flight fails with it.
+                Pointer< Iterator< Pointer<FanOutMember> > > iter(subscription->members.iterator());
+                while (iter->hasNext()) {
+                    this->members.remove(iter->next()->consumerId);
+                    this->memberCount.decrementAndGet();
+                }
+                subscription->members.clear();
+                subscription->clear();
+            }
+
+            // The broker may have created the subscription when only the response was lost.
+            try {
+                connection->oneway(subscription->info->createRemoveCommand());
+            } catch (Exception& e) {
+            } catch (cms::CMSException& e) {
+            }
+
+            connection->removeDispatcher(subscription->info->getConsumerId());
+
+            subscription->failure = reason;
+            subscription->failed = true;
+            subscription->registered.countDown();
+        }
+    };
+
+}}
+
+////////////////////////////////////////////////////////////////////////////////
+TopicFanOut::TopicFanOut(ActiveMQConnection* connection) : config(NULL), connection(connection) {
+
+    if (connection == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "Parent Connection pointer was NULL");
+    }
+
+    this->config = new TopicFanOutConfig();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TopicFanOut::~TopicFanOut() {
+    try {
+        delete this->config;
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string TopicFanOut::createKey(const ConsumerInfo& info) {
+    return Integer::toString(info.getDestination()->getDestinationType()) + ":" +
+           info.getDestination()->getPhysicalName() + "|" +
+           (info.isNoLocal() ? "1" : "0") + "|" + info.getSelector();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool TopicFanOut::canShare(const Pointer<ConsumerInfo>& info) const {
+
+    if (!this->connection->isTopicFanOut() || info == NULL || info->getDestination() == NULL) {
+        return false;
+    }
+
+    // Adaptive prefetch and pull consumers both talk to the broker about their own window.
+    if (this->connection->getPrefetchPolicy()->isAdaptive() || info->getPrefetchSize() <= 0) {
+        return false;
+    }
+
+    return info->getDestination()->isTopic() && info->getSubscriptionName().empty() &&
+           !info->isBrowser() && !info->isRetroactive();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TopicFanOut::subscribe(const Pointer<ConsumerInfo>& info, Dispatcher* dispatcher) {
+
+    try {
+
+        std::string key = createKey(*info);
+        Pointer<SharedSubscription> subscription;
+        bool created = false;
+
+        synchronized(&this->config->mutex) {
+
+            if (this->config->subscriptions.containsKey(key)) {
+                subscription = this->config->subscriptions.get(key);
+            } else {
+                Pointer<ConsumerInfo> shared(info->cloneDataStructure());
+                shared->setConsumerId(this->connection->getNextConnectionConsumerId());
+                subscription.reset(new SharedSubscription(key, shared, this->connection, &this->config->mutex));
+                this->config->subscriptions.put(key, subscription);
+                created = true;
+            }
+
+            subscription->members.add(Pointer<FanOutMember>(new FanOutMember(info->getConsumerId(), dispatcher)));
+            this->config->members.put(info->getConsumerId(), subscription);
+            this->config->memberCount.incrementAndGet();
+        }
+
+        // The connection dispatches under its own lock, so register outside of ours.
+        if (created) {
+            try {
+                this->connection->addDispatcher(subscription->info->getConsumerId(), subscription.get());
+                this->connection->syncRequest(subscription->info);
+            } catch (Exception& ex) {
+                this->config->failSubscription(this->connection, subscription, ex.getMessage());
+                throw;
+            }
+
+            subscription->registered.countDown();
+        } else {
+
+            // Joining members can't receive anything before the broker knows the subscription.
+            subscription->registered.await();
+            if (subscription->failed) {
+                throw ActiveMQException(__FILE__, __LINE__,
+                    "Shared topic subscription could not be created: %s", subscription->failure.c_str());
+            }
+        }
+    }
+    AMQ_CATCH_RETHROW(ActiveMQException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, ActiveMQException)
+    AMQ_CATCHALL_THROW(ActiveMQException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool TopicFanOut::unsubscribe(const Pointer<ConsumerId>& consumerId) {
+
+    if (this->config->memberCount.get() == 0) {
+        return false;
+    }
+
+    Pointer<SharedSubscription> subscription;
+    std::vector< Pointer<MessageAck> > acks;
+    bool last = false;
+
+    synchronized(&this->config->mutex) {
+
+        if (!this->config->members.containsKey(consumerId)) {
+            return false;
+        }
+
+        subscription = this->config->members.remove(consumerId);
+        this->config->memberCount.decrementAndGet();
+
+        subscription->removeMember(*consumerId, acks);
+
+        if (subscription->members.isEmpty()) {
+            this->config->subscriptions.remove(subscription->key);
+            last = true;
+        }
+    }
+
+    if (last) {
+        try {
+            this->connection->oneway(subscription->info->createRemoveCommand());
+        } catch (Exception& e) {
+        } catch (cms::CMSException& e) {
+        }
+
+        this->connection->removeDispatcher(subscription->info->getConsumerId());
+    } else {
+        subscription->sendAcks(acks);
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool TopicFanOut::acknowledge(const Pointer<MessageAck>& ack) {
+
+    if (this->config->memberCount.get() == 0 || ack == NULL || ack->getConsumerId() == NULL) {
+        return false;
+    }
+
+    Pointer<SharedSubscription> subscription;
+    std::vector< Pointer<MessageAck> > brokerAcks;
+
+    synchronized(&this->config->mutex) {
+
+        if (!this->config->members.containsKey(ack->getConsumerId())) {
+            return false;
+        }
+
+        subscription = this->config->members.get(ack->getConsumerId());
+        subscription->acknowledge(*ack, brokerAcks);
+    }
+
+    subscription->sendAcks(brokerAcks);
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TopicFanOut::transportInterrupted() {
+
+    synchronized(&this->config->mutex) {
+        ArrayList< Pointer<SharedSubscription> > subscriptions(this->config->subscriptions.values());
+        Pointer< Iterator< Pointer<SharedSubscription> > > iter(subscriptions.iterator());
+        while (iter->hasNext()) {
+            iter->next()->clear();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int TopicFanOut::getSubscriptionCount() const {
+
+    synchronized(&this->config->mutex) {
+        return this->config->subscriptions.size();
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int TopicFanOut::getMemberCount() const {
+    return this->config->memberCount.get();
+}
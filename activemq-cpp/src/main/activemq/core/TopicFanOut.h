@@ -0,0 +1,168 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CORE_TOPICFANOUT_H_
+#define _ACTIVEMQ_CORE_TOPICFANOUT_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/core/Dispatcher.h>
+#include <activemq/commands/ConsumerId.h>
+#include <activemq/commands/ConsumerInfo.h>
+#include <activemq/commands/MessageAck.h>
+
+#include <decaf/lang/Pointer.h>
+
+#include <string>
+
+namespace activemq {
+namespace core {
+
+    using decaf::lang::Pointer;
+
+    class ActiveMQConnection;
+    class TopicFanOutConfig;
+
+    /**
+     * Lets consumers on one connection that subscribe to the same non-durable topic with
+     * the same selector share a single broker subscription.
+     *
+     * The first consumer for a given topic, selector and noLocal setting creates a
+     * subscription owned by the connection, every consumer that joins later is only
+     * registered locally.  Each message the broker dispatches to the shared subscription
+     * is handed to every member consumer, which then handles redelivery and
+     * acknowledgement exactly as if it had its own subscription.  The acks of the members
+     * are collected here and the broker subscription is acknowledged once all members
+     * that received a message have consumed it, so broker side flow control still
+     * follows the slowest member.  Delivered acks extend the shared window once every
+     * member reported the messages delivered, while poison and expired acks are forwarded
+     * for the shared subscription the first time a member sends one for a message.
+     *
+     * The acks sent for the shared subscription are not part of any transaction, consumers
+     * of transacted sessions therefore always get a subscription of their own.
+     *
+     * @since 3.10
+     */
+    class AMQCPP_API TopicFanOut {
+    private:
+
+        TopicFanOutConfig* config;
+        ActiveMQConnection* connection;
+
+    private:
+
+        TopicFanOut(const TopicFanOut&);
+        TopicFanOut& operator=(const TopicFanOut&);
+
+    public:
+
+        /**
+         * Creates a new TopicFanOut for the given connection.
+         *
+         * @param connection
+         *      The connection whose consumers this instance manages.
+         *
+         * @throws NullPointerException if the connection is NULL.
+         */
+        TopicFanOut(ActiveMQConnection* connection);
+
+        virtual ~TopicFanOut();
+
+        /**
+         * Checks if a consumer with the given ConsumerInfo can share a broker subscription,
+         * that requires fan out to be enabled on the connection and a non-durable topic
+         * consumer with a non-zero prefetch that is not retroactive and doesn't use
+         * adaptive prefetch.
+         *
+         * @param info
+         *      The ConsumerInfo of the consumer that is being created.
+         *
+         * @return true if the consumer should be passed to subscribe.
+         */
+        bool canShare(const Pointer<commands::ConsumerInfo>& info) const;
+
+        /**
+         * Adds a consumer to the shared subscription that matches its ConsumerInfo, the
+         * subscription is created on the broker if this is the first consumer for it.  The
+         * ConsumerInfo of the consumer itself is never sent to the broker.  A consumer that
+         * joins while the broker subscription is still being created waits for it, and fails
+         * along with the first consumer if the broker refuses it.
+         *
+         * @param info
+         *      The ConsumerInfo of the consumer that joins.
+         * @param dispatcher
+         *      The Dispatcher that is registered for the consumer's ConsumerId.
+         *
+         * @throws ActiveMQException if the broker subscription could not be created.
+         */
+        void subscribe(const Pointer<commands::ConsumerInfo>& info, Dispatcher* dispatcher);
+
+        /**
+         * Removes a consumer from its shared subscription, the subscription is removed from
+         * the broker when its last member leaves.  Messages the consumer had not acked
+         * yet are treated as consumed by it.
+         *
+         * @param consumerId
+         *      The ConsumerId of the consumer that is leaving.
+         *
+         * @return true if the consumer was a member of a shared subscription.
+         */
+        bool unsubscribe(const Pointer<commands::ConsumerId>& consumerId);
+
+        /**
+         * Accounts for an ack sent by a member consumer, acking the broker subscription
+         * for any messages that every member has now consumed or delivered, and forwarding
+         * poison and expired acks.
+         *
+         * @param ack
+         *      The ack the consumer would have sent to the broker.
+         *
+         * @return true if the ack was taken by this instance, false if the consumer isn't
+         *         a member and the ack should be sent to the broker as is.
+         */
+        bool acknowledge(const Pointer<commands::MessageAck>& ack);
+
+        /**
+         * Forgets the messages that are awaiting acks, called when the transport is
+         * interrupted since member consumers clear their in progress messages as well.
+         */
+        void transportInterrupted();
+
+        /**
+         * @return the number of broker subscriptions currently shared.
+         */
+        int getSubscriptionCount() const;
+
+        /**
+         * @return the number of consumers that are members of a shared subscription.
+         */
+        int getMemberCount() const;
+
+        /**
+         * Computes the key that identical subscriptions share.
+         *
+         * @param info
+         *      The ConsumerInfo of a consumer.
+         *
+         * @return the key for the given consumer's subscription.
+         */
+        static std::string createKey(const commands::ConsumerInfo& info);
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_CORE_TOPICFANOUT_H_ */
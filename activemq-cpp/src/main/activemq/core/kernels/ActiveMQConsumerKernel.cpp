@@ -26,6 +26,7 @@
 #include <decaf/lang/Integer.h>
 #include <decaf/lang/Long.h>
 #include <decaf/util/HashMap.h>
+#include <decaf/util/StlSet.h>
 #include <decaf/util/Collections.h>
 #include <decaf/util/concurrent/ExecutorService.h>
 #include <decaf/util/concurrent/Executors.h>
@@ -36,6 +37,7 @@
 #include <activemq/util/ActiveMQMessageTransformation.h>
 #include <activemq/exceptions/ActiveMQException.h>
 #include <activemq/commands/Message.h>
+#include <activemq/commands/ConsumerControl.h>
 #include <activemq/commands/MessageAck.h>
 #include <activemq/commands/MessagePull.h>
 #include <activemq/commands/RemoveInfo.h>
@@ -45,8 +47,11 @@
 #include <activemq/core/ActiveMQConstants.h>
 #include <activemq/core/ActiveMQTransactionContext.h>
 #include <activemq/core/ActiveMQAckHandler.h>
+#include <activemq/core/AdaptivePrefetchController.h>
 #include <activemq/core/FifoMessageDispatchChannel.h>
+#include <activemq/core/ParallelDispatcher.h>
 #include <activemq/core/SimplePriorityMessageDispatchChannel.h>
+#include <activemq/core/PrefetchPolicy.h>
 #include <activemq/core/RedeliveryPolicy.h>
 #include <activemq/core/kernels/ActiveMQSessionKernel.h>
 #include <activemq/threads/Scheduler.h>
@@ -85,6 +90,36 @@ namespace kernels {
         virtual ~PreviouslyDeliveredMap() {}
     };
 
+    /**
+     * A message handed to a ParallelDispatcher worker, completed in dispatch order
+     * once it and every message dispatched before it have been processed.
+     */
+    class ParallelDelivery {
+    private:
+
+        ParallelDelivery(const ParallelDelivery&);
+        ParallelDelivery& operator=(const ParallelDelivery&);
+
+    public:
+
+        Pointer<MessageDispatch> dispatch;
+        Pointer<cms::Message> message;
+        std::string key;
+        bool expired;
+        bool failed;
+        bool running;
+        bool cancelled;
+        bool done;
+
+        ParallelDelivery(Pointer<MessageDispatch> dispatch, Pointer<cms::Message> message,
+                         const std::string& key, bool expired) :
+            dispatch(dispatch), message(message), key(key), expired(expired), failed(false),
+            running(false), cancelled(false), done(false) {
+        }
+
+        virtual ~ParallelDelivery() {}
+    };
+
     class ActiveMQConsumerKernelConfig {
     private:
 
@@ -119,6 +154,7 @@ namespace kernels {
         bool transactedIndividualAck;
         bool nonBlockingRedelivery;
         bool consumerExpiryCheckEnabled;
+        bool fanOutMember;
         bool optimizeAcknowledge;
         long long optimizeAckTimestamp;
         long long optimizeAcknowledgeTimeOut;
@@ -127,6 +163,12 @@ namespace kernels {
         int ackCounter;
         int dispatchedCount;
         Pointer<ExecutorService> executor;
+        Pointer<AdaptivePrefetchController> adaptivePrefetch;
+        decaf::util::concurrent::Mutex adaptivePrefetchMutex;
+        decaf::util::LinkedList< Pointer<ParallelDelivery> > parallelDeliveries;
+        decaf::util::concurrent::Mutex parallelCompletionMutex;
+        decaf::util::StlSet<std::string> failedParallelKeys;
+        decaf::util::LinkedList<long long> parallelRunners;
         ActiveMQSessionKernel* session;
         ActiveMQConsumerKernel* parent;
         Pointer<ConsumerInfo> info;
@@ -157,6 +199,7 @@ namespace kernels {
                                          transactedIndividualAck(false),
                                          nonBlockingRedelivery(false),
                                          consumerExpiryCheckEnabled(true),
+                                         fanOutMember(false),
                                          optimizeAcknowledge(false),
                                          optimizeAckTimestamp(System::currentTimeMillis()),
                                          optimizeAcknowledgeTimeOut(),
@@ -165,6 +208,12 @@ namespace kernels {
                                          ackCounter(),
                                          dispatchedCount(),
                                          executor(),
+                                         adaptivePrefetch(),
+                                         adaptivePrefetchMutex(),
+                                         parallelDeliveries(),
+                                         parallelCompletionMutex(),
+                                         failedParallelKeys(),
+                                         parallelRunners(),
                                          session(),
                                          parent(),
                                          info() {
@@ -184,6 +233,34 @@ namespace kernels {
             return false;
         }
 
+        /**
+         * Feeds a consumed message to the adaptive prefetch controller and tells the
+         * broker about the new window when the controller decides it has changed.
+         */
+        void adaptPrefetch(int count) {
+            if (adaptivePrefetch == NULL) {
+                return;
+            }
+
+            int prefetch = 0;
+            synchronized(&adaptivePrefetchMutex) {
+                if (adaptivePrefetch->messageConsumed(System::currentTimeMillis(), unconsumedMessages->size(), count)) {
+                    prefetch = adaptivePrefetch->getPrefetchSize();
+                }
+            }
+
+            if (prefetch > 0) {
+                info->setPrefetchSize(prefetch);
+                info->setCurrentPrefetchSize(prefetch);
+
+                Pointer<ConsumerControl> control(new ConsumerControl());
+                control->setConsumerId(info->getConsumerId());
+                control->setDestination(info->getDestination());
+                control->setPrefetch(prefetch);
+                session->oneway(control);
+            }
+        }
+
         void clearDeliveredList() {
             if (isClearDeliveredList) {
                 synchronized (&this->deliveredMessages) {
@@ -348,6 +425,119 @@ namespace kernels {
             return false;
         }
 
+        /**
+         * Removes and returns the oldest parallel delivery if it has finished processing,
+         * or NULL when nothing at the head of the dispatch order is complete yet.
+         */
+        Pointer<ParallelDelivery> nextCompletedDelivery() {
+            synchronized(&parallelDeliveries) {
+                if (!parallelDeliveries.isEmpty() && parallelDeliveries.getFirst()->done) {
+                    return parallelDeliveries.removeFirst();
+                }
+            }
+
+            return Pointer<ParallelDelivery>();
+        }
+
+        /**
+         * Records that a parallel delivery failed, the later deliveries with the same key are
+         * skipped and held back until the failed one is rolled back so that they are redelivered
+         * after it.  Must be called with the parallelDeliveries lock held.
+         */
+        void parallelDeliveryFailed(Pointer<ParallelDelivery> delivery) {
+            bool found = false;
+            Pointer< Iterator< Pointer<ParallelDelivery> > > iter(parallelDeliveries.iterator());
+            while (iter->hasNext()) {
+                Pointer<ParallelDelivery> next = iter->next();
+                if (next.get() == delivery.get()) {
+                    found = true;
+                } else if (found && next->key == delivery->key) {
+                    next->cancelled = true;
+                }
+            }
+
+            // A delivery that was already dropped must not hold back anything.
+            if (found) {
+                failedParallelKeys.add(delivery->key);
+            }
+        }
+
+        /**
+         * Removes the deliveries that were held back behind a failed delivery with the given
+         * key, returned in dispatch order, and lets new messages with that key through again.
+         */
+        std::vector< Pointer<ParallelDelivery> > removeSkippedDeliveries(const std::string& key) {
+            std::vector< Pointer<ParallelDelivery> > skipped;
+            synchronized(&parallelDeliveries) {
+                Pointer< Iterator< Pointer<ParallelDelivery> > > iter(parallelDeliveries.iterator());
+                while (iter->hasNext()) {
+                    Pointer<ParallelDelivery> next = iter->next();
+                    if (next->cancelled && next->key == key) {
+                        skipped.push_back(next);
+                        iter->remove();
+                    }
+                }
+                failedParallelKeys.remove(key);
+            }
+
+            return skipped;
+        }
+
+        /**
+         * Drops tracked parallel deliveries so that their completion no longer generates an ack
+         * and their queued tasks no longer reach the listener.  When pendingOnly is set only the
+         * deliveries that have not been handed to the listener yet are dropped, otherwise every
+         * delivery is.  Returns the dropped messages in dispatch order.
+         */
+        std::vector< Pointer<MessageDispatch> > cancelParallelDeliveries(bool pendingOnly) {
+            std::vector< Pointer<MessageDispatch> > dropped;
+            synchronized(&parallelDeliveries) {
+                Pointer< Iterator< Pointer<ParallelDelivery> > > iter(parallelDeliveries.iterator());
+                while (iter->hasNext()) {
+                    Pointer<ParallelDelivery> next = iter->next();
+                    bool pending = !next->running && !next->done && !next->cancelled;
+                    if (pending || !pendingOnly) {
+                        next->cancelled = true;
+                        dropped.push_back(next->dispatch);
+                        iter->remove();
+                    }
+                }
+
+                if (!pendingOnly) {
+                    failedParallelKeys.clear();
+                }
+            }
+
+            return dropped;
+        }
+
+        /**
+         * Waits for the listeners running on ParallelDispatcher workers to return, other than
+         * one running on the calling thread, or until the timeout expires.
+         */
+        void awaitParallelListeners(long long timeout) {
+            long long self = Thread::currentThread()->getId();
+            long long deadline = System::currentTimeMillis() + timeout;
+            synchronized(&parallelDeliveries) {
+                long long remaining = timeout;
+                while (remaining > 0 && hasOtherParallelRunner(self)) {
+                    parallelDeliveries.wait(remaining);
+                    remaining = deadline - System::currentTimeMillis();
+                }
+            }
+        }
+
+        bool hasOtherParallelRunner(long long self) {
+            Pointer< Iterator<long long> > iter(parallelRunners.iterator());
+            while (iter->hasNext()) {
+                if (iter->next() != self) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
         bool consumeExpiredMessage(const Pointer<MessageDispatch> dispatch) {
             if (dispatch->getMessage()->isExpired()) {
                 return !info->isBrowser() && consumerExpiryCheckEnabled;
@@ -706,6 +896,85 @@ namespace {
             this->consumer.reset(NULL);
         }
     };
+
+    /**
+     * Delivers one message to the consumer's listener on a ParallelDispatcher worker
+     * and then advances the consumer's in-order completion watermark.
+     */
+    class ParallelDeliveryTask : public Runnable {
+    private:
+
+        Pointer<ActiveMQConsumerKernel> consumer;
+        ActiveMQConsumerKernelConfig* impl;
+        Pointer<ParallelDelivery> delivery;
+
+    private:
+
+        ParallelDeliveryTask(const ParallelDeliveryTask&);
+        ParallelDeliveryTask& operator=(const ParallelDeliveryTask&);
+
+    public:
+
+        ParallelDeliveryTask(Pointer<ActiveMQConsumerKernel> consumer, ActiveMQConsumerKernelConfig* impl,
+                             Pointer<ParallelDelivery> delivery) :
+            Runnable(), consumer(consumer), impl(impl), delivery(delivery) {}
+        virtual ~ParallelDeliveryTask() {}
+
+        virtual void run() {
+
+            long long self = Thread::currentThread()->getId();
+            synchronized(&impl->parallelDeliveries) {
+                if (delivery->cancelled) {
+                    // Dropped or held back behind a failed message, it is redelivered later.
+                    this->consumer.reset(NULL);
+                    return;
+                }
+                delivery->running = true;
+                impl->parallelRunners.add(self);
+            }
+
+            cms::MessageListener* listener = NULL;
+            synchronized(&impl->listenerMutex) {
+                listener = impl->listener;
+            }
+
+            try {
+                if (listener == NULL) {
+                    // The listener was removed while the message was queued, redeliver it.
+                    delivery->failed = true;
+                } else if (!delivery->expired) {
+                    listener->onMessage(delivery->message.get());
+                }
+            } catch (RuntimeException& e) {
+                delivery->dispatch->setRollbackCause(e);
+                delivery->failed = true;
+            } catch (Exception& ex) {
+                delivery->failed = true;
+                impl->session->getConnection()->onAsyncException(ex);
+            }
+
+            synchronized(&impl->parallelDeliveries) {
+                if (delivery->failed) {
+                    impl->parallelDeliveryFailed(delivery);
+                }
+                delivery->running = false;
+                delivery->done = true;
+                impl->parallelRunners.removeFirstOccurrence(self);
+                impl->parallelDeliveries.notifyAll();
+            }
+
+            try {
+                this->consumer->completeParallelDeliveries();
+            } catch (Exception& ex) {
+                impl->session->getConnection()->onAsyncException(ex);
+            } catch (cms::CMSException& ex) {
+                Exception wrapper(ex.clone());
+                impl->session->getConnection()->onAsyncException(wrapper);
+            }
+
+            this->consumer.reset(NULL);
+        }
+    };
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -803,6 +1072,19 @@ ActiveMQConsumerKernel::ActiveMQConsumerKernel(ActiveMQSessionKernel* session,
     }
 
     consumerInfo->setOptimizedAcknowledge(this->internal->optimizeAcknowledge);
+
+    // With adaptive prefetch the configured value becomes the upper bound of the window,
+    // the consumer registers with the controller's initial window and grows from there.
+    PrefetchPolicy* prefetchPolicy = session->getConnection()->getPrefetchPolicy();
+    if (prefetchPolicy->isAdaptive() && !consumerInfo->isBrowser() && consumerInfo->getPrefetchSize() > 0) {
+        this->internal->adaptivePrefetch.reset(new AdaptivePrefetchController(
+            prefetchPolicy->getAdaptiveMinimumPrefetch(),
+            consumerInfo->getPrefetchSize(),
+            prefetchPolicy->getAdaptiveTargetLatency()));
+        consumerInfo->setPrefetchSize(this->internal->adaptivePrefetch->getPrefetchSize());
+        consumerInfo->setCurrentPrefetchSize(this->internal->adaptivePrefetch->getPrefetchSize());
+    }
+
     this->internal->failoverRedeliveryWaitPeriod =
         session->getConnection()->getConsumerFailoverRedeliveryWaitPeriod();
     this->internal->nonBlockingRedelivery = session->getConnection()->isNonBlockingRedelivery();
@@ -849,6 +1131,22 @@ void ActiveMQConsumerKernel::start() {
 void ActiveMQConsumerKernel::stop() {
     this->internal->started.set(false);
     this->internal->unconsumedMessages->stop();
+
+    if (this->session->getParallelDispatcher() != NULL) {
+
+        // Messages still waiting for a worker go back in front of the undelivered ones,
+        // and the listeners that already have one are allowed to finish.
+        synchronized(this->internal->unconsumedMessages.get()) {
+            std::vector< Pointer<MessageDispatch> > pending = this->internal->cancelParallelDeliveries(true);
+            std::vector< Pointer<MessageDispatch> >::reverse_iterator iter = pending.rbegin();
+            for (; iter != pending.rend(); ++iter) {
+                this->session->getConnection()->rollbackDuplicate(this, (*iter)->getMessage());
+                this->internal->unconsumedMessages->enqueueFirst(*iter);
+            }
+        }
+
+        this->internal->awaitParallelListeners(this->session->getConnection()->getCloseTimeout());
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -890,11 +1188,14 @@ void ActiveMQConsumerKernel::doClose() {
         dispose();
         // Remove at the Broker Side, consumer has been removed from the local
         // Session and Connection objects so if the remote call to remove throws
-        // it is okay to propagate to the client.
-        Pointer<RemoveInfo> info(new RemoveInfo);
-        info->setObjectId(this->consumerInfo->getConsumerId());
-        info->setLastDeliveredSequenceId(this->internal->lastDeliveredSequenceId);
-        this->session->oneway(info);
+        // it is okay to propagate to the client.  A consumer sharing a topic
+        // subscription was never registered with the Broker.
+        if (!this->internal->fanOutMember) {
+            Pointer<RemoveInfo> info(new RemoveInfo);
+            info->setObjectId(this->consumerInfo->getConsumerId());
+            info->setLastDeliveredSequenceId(this->internal->lastDeliveredSequenceId);
+            this->session->oneway(info);
+        }
         if (interrupted) {
             Thread::currentThread()->interrupt();
         }
@@ -911,6 +1212,10 @@ void ActiveMQConsumerKernel::dispose() {
 
         if (!this->isClosed()) {
 
+            if (this->session->getParallelDispatcher() != NULL) {
+                disposeParallelDeliveries();
+            }
+
             if (!session->isTransacted()) {
                 deliverAcks();
                 if (isAutoAcknowledgeBatch()) {
@@ -1067,6 +1372,73 @@ decaf::lang::Pointer<MessageDispatch> ActiveMQConsumerKernel::dequeue(long long
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
 
+////////////////////////////////////////////////////////////////////////////////
+std::vector<Pointer<MessageDispatch> > ActiveMQConsumerKernel::dequeueBatch(int maxMessages, long long timeout) {
+
+    std::vector<Pointer<MessageDispatch> > result;
+
+    try {
+
+        long long deadline = 0;
+        if (timeout > 0) {
+            deadline = System::currentTimeMillis() + timeout;
+        }
+
+        // Loop until the time is up or we get at least one non-expired message
+        while (true) {
+            std::vector<Pointer<MessageDispatch> > dispatches =
+                this->internal->unconsumedMessages->dequeueBatch(maxMessages, timeout);
+
+            if (dispatches.empty()) {
+                if (timeout > 0 && !this->internal->unconsumedMessages->isClosed()) {
+                    timeout = Math::max(deadline - System::currentTimeMillis(), 0LL);
+                    continue;
+                } else if (this->internal->failureError != NULL) {
+                    throw CMSExceptionSupport::create(*this->internal->failureError);
+                }
+
+                return result;
+            }
+
+            for (std::size_t i = 0; i < dispatches.size(); ++i) {
+                Pointer<MessageDispatch> dispatch = dispatches[i];
+
+                if (dispatch->getMessage() == NULL) {
+                    // Put back what we took after the marker so the next receive sees it.
+                    for (std::size_t j = dispatches.size() - 1; j > i; --j) {
+                        this->internal->unconsumedMessages->enqueueFirst(dispatches[j]);
+                    }
+                    return result;
+                } else if (internal->consumeExpiredMessage(dispatch)) {
+                    beforeMessageIsConsumed(dispatch);
+                    afterMessageIsConsumed(dispatch, true);
+                } else if (internal->redeliveryExceeded(dispatch)) {
+                    internal->posionAck(dispatch,
+                                        "dispatch to " + getConsumerId()->toString() +
+                                        " exceeds RedeliveryPolicy limit: " +
+                                        Integer::toString(internal->redeliveryPolicy->getMaximumRedeliveries()));
+                } else {
+                    result.push_back(dispatch);
+                }
+            }
+
+            if (!result.empty()) {
+                return result;
+            }
+
+            if (timeout > 0) {
+                timeout = Math::max(deadline - System::currentTimeMillis(), 0LL);
+            }
+        }
+
+        return result;
+    } catch (InterruptedException& ex) {
+        Thread::currentThread()->interrupt();
+        throw CMSExceptionSupport::create(ex);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 cms::Message* ActiveMQConsumerKernel::receive() {
 
@@ -1163,6 +1535,68 @@ cms::Message* ActiveMQConsumerKernel::receiveNoWait() {
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
 
+////////////////////////////////////////////////////////////////////////////////
+std::vector<cms::Message*> ActiveMQConsumerKernel::receiveBatch(int maxMessages, int timeout) {
+
+    std::vector<cms::Message*> messages;
+
+    try {
+
+        this->checkClosed();
+        this->checkMessageListener();
+
+        if (maxMessages <= 0) {
+            throw IllegalArgumentException(__FILE__, __LINE__, "Batch size must be at least one");
+        }
+
+        // In pull mode the broker sends one message per request, there's nothing to batch.
+        if (internal->info->getPrefetchSize() == 0) {
+            cms::Message* message = timeout < 0 ? this->receiveNoWait() : this->receive(timeout);
+            if (message != NULL) {
+                messages.push_back(message);
+            }
+
+            return messages;
+        }
+
+        long long wait = timeout;
+        if (timeout == 0) {
+            wait = -1;
+        } else if (timeout < 0) {
+            wait = 0;
+        }
+
+        this->sendPullRequest(wait);
+
+        std::vector<Pointer<MessageDispatch> > dispatches = dequeueBatch(maxMessages, wait);
+        if (dispatches.empty()) {
+            return messages;
+        }
+
+        // One pass of the delivered / consumed bookkeeping covers the whole batch so
+        // the acknowledgement goes out as a single range ack.
+        beforeMessagesAreConsumed(dispatches);
+        afterMessagesAreConsumed(dispatches.front(), dispatches.back(), (int) dispatches.size());
+
+        try {
+            messages.reserve(dispatches.size());
+            std::vector<Pointer<MessageDispatch> >::const_iterator iter = dispatches.begin();
+            for (; iter != dispatches.end(); ++iter) {
+                messages.push_back(createCMSMessage(*iter).release());
+            }
+        } catch (...) {
+            std::vector<cms::Message*>::iterator iter = messages.begin();
+            for (; iter != messages.end(); ++iter) {
+                delete *iter;
+            }
+            throw;
+        }
+
+        return messages;
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQConsumerKernel::setMessageListener(cms::MessageListener* listener) {
 
@@ -1222,6 +1656,32 @@ void ActiveMQConsumerKernel::beforeMessageIsConsumed(Pointer<MessageDispatch> di
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConsumerKernel::beforeMessagesAreConsumed(const std::vector<Pointer<MessageDispatch> >& dispatches) {
+    this->internal->lastDeliveredSequenceId = dispatches.back()->getMessage()->getMessageId()->getBrokerSequenceId();
+
+    if (!isAutoAcknowledgeBatch()) {
+
+        std::vector<Pointer<MessageDispatch> >::const_iterator iter;
+        synchronized(&this->internal->deliveredMessages) {
+            for (iter = dispatches.begin(); iter != dispatches.end(); ++iter) {
+                this->internal->deliveredMessages.addFirst(*iter);
+            }
+        }
+
+        if (this->session->isTransacted()) {
+            if (this->internal->transactedIndividualAck) {
+                for (iter = dispatches.begin(); iter != dispatches.end(); ++iter) {
+                    immediateIndividualTransactedAck(*iter);
+                }
+            } else {
+                ackLater(dispatches.front(), dispatches.back(),
+                         (int) dispatches.size(), ActiveMQConstants::ACK_TYPE_DELIVERED);
+            }
+        }
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQConsumerKernel::immediateIndividualTransactedAck(Pointer<MessageDispatch> dispatch) {
     // acks accumulate on the broker pending transaction completion to indicate delivery status
@@ -1229,7 +1689,11 @@ void ActiveMQConsumerKernel::immediateIndividualTransactedAck(Pointer<MessageDis
 
     Pointer<MessageAck> ack(new MessageAck(dispatch, ActiveMQConstants::ACK_TYPE_INDIVIDUAL, 1));
     ack->setTransactionId(this->session->getTransactionContext()->getTransactionId());
-    this->session->syncRequest(ack);
+    if (this->internal->fanOutMember) {
+        this->session->sendAck(ack);
+    } else {
+        this->session->syncRequest(ack);
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1254,7 +1718,28 @@ void ActiveMQConsumerKernel::afterMessageIsConsumed(Pointer<MessageDispatch> mes
         } else if (messageExpired) {
             acknowledge(message, ActiveMQConstants::ACK_TYPE_EXPIRED);
             return;
-        } else if (session->isTransacted()) {
+        }
+
+        afterMessagesAreConsumed(message, message, 1);
+    }
+    AMQ_CATCH_RETHROW(ActiveMQException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, ActiveMQException)
+    AMQ_CATCHALL_THROW(ActiveMQException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConsumerKernel::afterMessagesAreConsumed(Pointer<MessageDispatch> first,
+                                                      Pointer<MessageDispatch> last, int count) {
+
+    try {
+
+        if (this->internal->unconsumedMessages->isClosed()) {
+            return;
+        }
+
+        this->internal->adaptPrefetch(count);
+
+        if (session->isTransacted()) {
             return;
         }
 
@@ -1264,7 +1749,7 @@ void ActiveMQConsumerKernel::afterMessageIsConsumed(Pointer<MessageDispatch> mes
                     if (!this->internal->deliveredMessages.isEmpty()) {
                         if (this->internal->optimizeAcknowledge) {
 
-                            this->internal->ackCounter++;
+                            this->internal->ackCounter += count;
                             if (this->internal->isTimeForOptimizedAck(this->consumerInfo->getPrefetchSize())) {
                                 Pointer<MessageAck> ack =
                                     makeAckForAllDeliveredMessages(ActiveMQConstants::ACK_TYPE_CONSUMED);
@@ -1299,15 +1784,15 @@ void ActiveMQConsumerKernel::afterMessageIsConsumed(Pointer<MessageDispatch> mes
                 this->internal->deliveringAcks.set(false);
             }
         } else if (isAutoAcknowledgeBatch()) {
-            ackLater(message, ActiveMQConstants::ACK_TYPE_CONSUMED);
+            ackLater(first, last, count, ActiveMQConstants::ACK_TYPE_CONSUMED);
         } else if (session->isClientAcknowledge() || session->isIndividualAcknowledge()) {
             bool messageUnackedByConsumer = false;
             synchronized(&this->internal->deliveredMessages) {
-                messageUnackedByConsumer = this->internal->deliveredMessages.contains(message);
+                messageUnackedByConsumer = this->internal->deliveredMessages.contains(last);
             }
 
             if (messageUnackedByConsumer) {
-                this->ackLater(message, ActiveMQConstants::ACK_TYPE_DELIVERED);
+                this->ackLater(first, last, count, ActiveMQConstants::ACK_TYPE_DELIVERED);
             }
         } else {
             throw IllegalStateException(__FILE__, __LINE__, "Invalid Session State");
@@ -1359,6 +1844,12 @@ void ActiveMQConsumerKernel::deliverAcks() {
 
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQConsumerKernel::ackLater(Pointer<MessageDispatch> dispatch, int ackType) {
+    ackLater(dispatch, dispatch, 1, ackType);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConsumerKernel::ackLater(Pointer<MessageDispatch> first, Pointer<MessageDispatch> last,
+                                      int count, int ackType) {
 
     // Don't acknowledge now, but we may need to let the broker know the
     // consumer got the message to expand the pre-fetch window
@@ -1368,13 +1859,13 @@ void ActiveMQConsumerKernel::ackLater(Pointer<MessageDispatch> dispatch, int ack
 
     // The delivered message list is only needed for the recover method
     // which is only used with client ack.
-    this->internal->deliveredCounter++;
+    this->internal->deliveredCounter += count;
 
     Pointer<MessageAck> oldPendingAck = this->internal->pendingAck;
-    this->internal->pendingAck.reset(new MessageAck(dispatch, ackType, internal->deliveredCounter));
+    this->internal->pendingAck.reset(new MessageAck(last, ackType, internal->deliveredCounter));
 
     if (oldPendingAck == NULL) {
-        this->internal->pendingAck->setFirstMessageId(this->internal->pendingAck->getLastMessageId());
+        this->internal->pendingAck->setFirstMessageId(first->getMessage()->getMessageId());
     } else if (oldPendingAck->getAckType() == this->internal->pendingAck->getAckType()) {
         this->internal->pendingAck->setFirstMessageId(oldPendingAck->getFirstMessageId());
     } else {
@@ -1636,12 +2127,22 @@ void ActiveMQConsumerKernel::dispatch(const Pointer<MessageDispatch>& dispatch)
                                                     Integer::toString(internal->redeliveryPolicy->getMaximumRedeliveries()));
                                 return;
                             }
+                            Pointer<ParallelDispatcher> dispatcher = session->getParallelDispatcher();
+                            if (dispatcher != NULL) {
+                                dispatchInParallel(dispatcher, dispatch);
+                                return;
+                            }
                             Pointer<cms::Message> message = createCMSMessage(dispatch);
                             beforeMessageIsConsumed(dispatch);
                             try {
                                 bool expired = isConsumerExpiryCheckEnabled() && dispatch->getMessage()->isExpired();
                                 if (!expired) {
+                                    util::MetricsRegistry* metrics = session->getConnection()->getMetrics();
+                                    long long start = metrics != NULL ? System::nanoTime() : 0;
                                     this->internal->listener->onMessage(message.get());
+                                    if (metrics != NULL) {
+                                        metrics->record(util::MetricsRegistry::LISTENER_TIME, (System::nanoTime() - start) / 1000);
+                                    }
                                 }
                                 afterMessageIsConsumed(dispatch, expired);
                             } catch (RuntimeException& e) {
@@ -1660,6 +2161,13 @@ void ActiveMQConsumerKernel::dispatch(const Pointer<MessageDispatch>& dispatch)
                                 session->getConnection()->rollbackDuplicate(this, dispatch->getMessage());
                             }
                             this->internal->unconsumedMessages->enqueue(dispatch);
+
+                            util::MetricsRegistry* metrics = session->getConnection()->getMetrics();
+                            if (metrics != NULL) {
+                                metrics->record(util::MetricsRegistry::DISPATCH_QUEUE_DEPTH,
+                                                this->internal->unconsumedMessages->size());
+                            }
+
                             if (this->internal->messageAvailableListener != NULL) {
                                 this->internal->messageAvailableListener->onMessageAvailable(this);
                             }
@@ -1695,6 +2203,98 @@ void ActiveMQConsumerKernel::dispatch(const Pointer<MessageDispatch>& dispatch)
     AMQ_CATCHALL_THROW(ActiveMQException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConsumerKernel::dispatchInParallel(Pointer<ParallelDispatcher> dispatcher,
+                                                Pointer<MessageDispatch> dispatch) {
+
+    Pointer<ActiveMQConsumerKernel> self =
+        this->session->lookupConsumerKernel(this->consumerInfo->getConsumerId());
+    if (self == NULL) {
+        // Being removed from the session, the broker redelivers whatever was not acked.
+        return;
+    }
+
+    // The message is not marked as delivered until it completes, otherwise an auto ack
+    // of an earlier message would also ack the ones that are still being processed.
+    bool expired = isConsumerExpiryCheckEnabled() && dispatch->getMessage()->isExpired();
+    Pointer<cms::Message> message = createCMSMessage(dispatch);
+    Pointer<ParallelDelivery> delivery(
+        new ParallelDelivery(dispatch, message, dispatcher->getKey(message.get()), expired));
+
+    synchronized(&this->internal->parallelDeliveries) {
+        // Messages behind a failed one with the same key wait for its redelivery.
+        delivery->cancelled = this->internal->failedParallelKeys.contains(delivery->key);
+        this->internal->parallelDeliveries.addLast(delivery);
+    }
+
+    if (!delivery->cancelled) {
+        dispatcher->execute(message.get(), new ParallelDeliveryTask(self, this->internal, delivery));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConsumerKernel::completeParallelDeliveries() {
+
+    try {
+
+        // Only one thread advances the watermark so acks are generated in dispatch order.
+        synchronized(&this->internal->parallelCompletionMutex) {
+
+            Pointer<ParallelDelivery> delivery = this->internal->nextCompletedDelivery();
+            while (delivery != NULL) {
+
+                beforeMessageIsConsumed(delivery->dispatch);
+                if (!delivery->failed) {
+                    afterMessageIsConsumed(delivery->dispatch, delivery->expired);
+                } else {
+                    // The messages with the same key that were held back are redelivered
+                    // along with it so they are not processed ahead of it.
+                    std::vector< Pointer<ParallelDelivery> > skipped =
+                        this->internal->removeSkippedDeliveries(delivery->key);
+                    std::vector< Pointer<ParallelDelivery> >::const_iterator iter = skipped.begin();
+                    for (; iter != skipped.end(); ++iter) {
+                        beforeMessageIsConsumed((*iter)->dispatch);
+                    }
+
+                    // Schedule redelivery and possible DLQ processing
+                    rollback();
+                }
+
+                delivery = this->internal->nextCompletedDelivery();
+            }
+        }
+    }
+    AMQ_CATCH_RETHROW(ActiveMQException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, ActiveMQException)
+    AMQ_CATCHALL_THROW(ActiveMQException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConsumerKernel::disposeParallelDeliveries() {
+
+    try {
+
+        // Nothing new is handed to the workers, the running listeners finish and the
+        // messages completed in order are acked, the broker redelivers the rest.
+        this->internal->unconsumedMessages->stop();
+
+        std::vector< Pointer<MessageDispatch> > dropped = this->internal->cancelParallelDeliveries(true);
+        this->internal->awaitParallelListeners(this->session->getConnection()->getCloseTimeout());
+        completeParallelDeliveries();
+
+        std::vector< Pointer<MessageDispatch> > remaining = this->internal->cancelParallelDeliveries(false);
+        dropped.insert(dropped.end(), remaining.begin(), remaining.end());
+
+        std::vector< Pointer<MessageDispatch> >::const_iterator iter = dropped.begin();
+        for (; iter != dropped.end(); ++iter) {
+            this->session->getConnection()->rollbackDuplicate(this, (*iter)->getMessage());
+        }
+    }
+    AMQ_CATCH_RETHROW(ActiveMQException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, ActiveMQException)
+    AMQ_CATCHALL_THROW(ActiveMQException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<cms::Message> ActiveMQConsumerKernel::createCMSMessage(Pointer<MessageDispatch> dispatch) {
 
@@ -1825,8 +2425,11 @@ void ActiveMQConsumerKernel::clearMessagesInProgress() {
             if (this->internal->inProgressClearRequiredFlag.get() > 0) {
 
                 // ensure messages that were not yet consumed are rolled back up front as they
-                // may get redelivered to another consumer by the Broker.
-                std::vector< Pointer<MessageDispatch> > list = this->internal->unconsumedMessages->removeAll();
+                // may get redelivered to another consumer by the Broker.  Parallel deliveries
+                // still in progress are dropped so their completion doesn't ack after failover.
+                std::vector< Pointer<MessageDispatch> > list = this->internal->cancelParallelDeliveries(false);
+                std::vector< Pointer<MessageDispatch> > unconsumed = this->internal->unconsumedMessages->removeAll();
+                list.insert(list.end(), unconsumed.begin(), unconsumed.end());
                 if (!this->consumerInfo->isBrowser()) {
                     std::vector< Pointer<MessageDispatch> >::const_iterator iter = list.begin();
 
@@ -1986,6 +2589,16 @@ void ActiveMQConsumerKernel::setTransactedIndividualAck(bool value) {
     this->internal->transactedIndividualAck = value;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConsumerKernel::isFanOutMember() const {
+    return this->internal->fanOutMember;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConsumerKernel::setFanOutMember(bool value) {
+    this->internal->fanOutMember = value;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 long long ActiveMQConsumerKernel::setFailoverRedeliveryWaitPeriod() const {
     return this->internal->failoverRedeliveryWaitPeriod;
@@ -31,6 +31,7 @@
 #include <activemq/core/Dispatcher.h>
 #include <activemq/core/RedeliveryPolicy.h>
 #include <activemq/core/MessageDispatchChannel.h>
+#include <activemq/core/ParallelDispatcher.h>
 
 #include <decaf/util/concurrent/atomic/AtomicBoolean.h>
 #include <decaf/lang/Pointer.h>
@@ -99,6 +100,8 @@ namespace kernels {
 
         virtual cms::Message* receiveNoWait();
 
+        virtual std::vector<cms::Message*> receiveBatch(int maxMessages, int millisecs);
+
         virtual void setMessageListener(cms::MessageListener* listener);
 
         virtual cms::MessageListener* getMessageListener() const;
@@ -213,6 +216,17 @@ namespace kernels {
          */
         void deliverAcks();
 
+        /**
+         * Completes the messages handed to the session's ParallelDispatcher in the order
+         * they were dispatched, each message is acknowledged only once it and all the
+         * messages dispatched to this consumer before it have been processed.
+         *
+         * @throw ActiveMQException if an error occurs while performing the operation.
+         *
+         * @since 3.10
+         */
+        void completeParallelDeliveries();
+
         /**
          * Called on a Failover to clear any pending messages.
          */
@@ -246,6 +260,20 @@ namespace kernels {
          */
         void setTransactedIndividualAck(bool value);
 
+        /**
+         * @return true if this consumer shares a topic subscription owned by its Connection.
+         */
+        bool isFanOutMember() const;
+
+        /**
+         * Marks this consumer as a member of a shared topic subscription, such a consumer
+         * is never registered with or removed from the Broker itself.
+         *
+         * @param value
+         *      True if the consumer was added to a shared subscription.
+         */
+        void setFanOutMember(bool value);
+
         /**
          * Returns the delay after a failover before Message redelivery starts.
          *
@@ -397,6 +425,17 @@ namespace kernels {
          */
         Pointer<MessageDispatch> dequeue(long long timeout);
 
+        /**
+         * Used by receiveBatch to take up to maxMessages messages out of the channel at
+         * once, waits for the first one the same way dequeue(long long) does.
+         *
+         * @param maxMessages - The maximum number of messages to return.
+         * @param timeout - The time to wait for the first message, see dequeue.
+         *
+         * @return the messages received within the allotted time, empty if none.
+         */
+        std::vector<Pointer<MessageDispatch> > dequeueBatch(int maxMessages, long long timeout);
+
         /**
          * Pre-consume processing
          * @param dispatch - the message being consumed.
@@ -410,10 +449,29 @@ namespace kernels {
          */
         void afterMessageIsConsumed(Pointer<commands::MessageDispatch> dispatch, bool messageExpired);
 
+        /**
+         * Pre-consume processing for a batch of messages received at once.
+         * @param dispatches - the messages being consumed, in delivery order.
+         */
+        void beforeMessagesAreConsumed(const std::vector<Pointer<commands::MessageDispatch> >& dispatches);
+
+        /**
+         * Post-consume processing for count messages delivered in order from first to last.
+         * @param first - the first consumed message
+         * @param last - the last consumed message
+         * @param count - the number of consumed messages
+         */
+        void afterMessagesAreConsumed(Pointer<commands::MessageDispatch> first,
+                                      Pointer<commands::MessageDispatch> last, int count);
+
     private:
 
         Pointer<cms::Message> createCMSMessage(Pointer<commands::MessageDispatch> dispatch);
 
+        void dispatchInParallel(Pointer<ParallelDispatcher> dispatcher, Pointer<commands::MessageDispatch> dispatch);
+
+        void disposeParallelDeliveries();
+
         void applyDestinationOptions(Pointer<commands::ConsumerInfo> info);
 
         void sendPullRequest(long long timeout);
@@ -424,6 +482,9 @@ namespace kernels {
 
         void ackLater(Pointer<commands::MessageDispatch> message, int ackType);
 
+        void ackLater(Pointer<commands::MessageDispatch> first, Pointer<commands::MessageDispatch> last,
+                      int count, int ackType);
+
         void immediateIndividualTransactedAck(Pointer<commands::MessageDispatch> dispatch);
 
         Pointer<commands::MessageAck> makeAckForAllDeliveredMessages(int type);
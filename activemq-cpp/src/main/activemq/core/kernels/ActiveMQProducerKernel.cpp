@@ -57,7 +57,9 @@ ActiveMQProducerKernel::ActiveMQProducerKernel(ActiveMQSessionKernel* session,
                                                                         memoryUsage(),
                                                                         destination(),
                                                                         messageSequence(),
-                                                                        transformer() {
+                                                                        transformer(),
+                                                                        windowListener(NULL),
+                                                                        windowBlocked() {
 
     if (session == NULL || producerId == NULL) {
         throw ActiveMQException(
@@ -209,6 +211,38 @@ void ActiveMQProducerKernel::send(const cms::Destination* destination, cms::Mess
 void ActiveMQProducerKernel::send(const cms::Destination* destination, cms::Message* message,
                                   int deliveryMode, int priority, long long timeToLive, cms::AsyncCallback* onComplete) {
 
+    try {
+        this->doSend(destination, message, deliveryMode, priority, timeToLive, onComplete, true);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQProducerKernel::trySend(cms::Message* message) {
+
+    try {
+        this->checkClosed();
+        return this->doSend(this->destination.get(), message, defaultDeliveryMode,
+                            defaultPriority, defaultTimeToLive, NULL, false);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQProducerKernel::trySend(const cms::Destination* destination, cms::Message* message) {
+
+    try {
+        this->checkClosed();
+        return this->doSend(destination, message, defaultDeliveryMode,
+                            defaultPriority, defaultTimeToLive, NULL, false);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQProducerKernel::doSend(const cms::Destination* destination, cms::Message* message, int deliveryMode,
+                                    int priority, long long timeToLive, cms::AsyncCallback* onComplete, bool blockOnWindow) {
+
     try {
 
         this->checkClosed();
@@ -261,15 +295,27 @@ void ActiveMQProducerKernel::send(const cms::Destination* destination, cms::Mess
         }
 
         if (this->memoryUsage.get() != NULL) {
-            try {
-                this->memoryUsage->waitForSpace();
-            } catch (InterruptedException& e) {
-                throw cms::CMSException("Send aborted due to thread interrupt.");
+            if (blockOnWindow) {
+                try {
+                    this->memoryUsage->waitForSpace();
+                } catch (InterruptedException& e) {
+                    throw cms::CMSException("Send aborted due to thread interrupt.");
+                }
+            } else if (this->memoryUsage->isFull()) {
+                this->windowBlocked.set(true);
+
+                // An ack that drained the window before the flag was set won't notify, so
+                // check again and send now unless the ack side has already claimed the flag.
+                if (this->memoryUsage->isFull() || !this->windowBlocked.compareAndSet(true, false)) {
+                    return false;
+                }
             }
         }
 
         this->session->send(this, dest, outbound, deliveryMode, priority, timeToLive,
                             this->memoryUsage.get(), this->sendTimeout, onComplete);
+
+        return true;
     }
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
@@ -281,6 +327,13 @@ void ActiveMQProducerKernel::onProducerAck(const commands::ProducerAck& ack) {
 
         if (this->memoryUsage.get() != NULL) {
             this->memoryUsage->decreaseUsage(ack.getSize());
+
+            if (!this->memoryUsage->isFull() && this->windowBlocked.compareAndSet(true, false)) {
+                cms::ProducerWindowListener* listener = this->windowListener;
+                if (listener != NULL) {
+                    listener->onWindowAvailable(this);
+                }
+            }
         }
     }
     AMQ_CATCH_RETHROW(ActiveMQException)
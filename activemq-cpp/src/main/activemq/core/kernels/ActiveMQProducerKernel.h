@@ -31,6 +31,8 @@
 #include <activemq/commands/ProducerAck.h>
 #include <activemq/exceptions/ActiveMQException.h>
 
+#include <decaf/util/concurrent/atomic/AtomicBoolean.h>
+
 #include <memory>
 
 namespace activemq {
@@ -83,6 +85,12 @@ namespace kernels {
         // Used to tranform Message before sending them to the CMS bus.
         cms::MessageTransformer* transformer;
 
+        // Notified when window space frees up after a trySend was refused.
+        cms::ProducerWindowListener* windowListener;
+
+        // Set when a trySend was refused and the listener hasn't been notified yet.
+        decaf::util::concurrent::atomic::AtomicBoolean windowBlocked;
+
     private:
 
         ActiveMQProducerKernel(const ActiveMQProducerKernel&);
@@ -154,6 +162,18 @@ namespace kernels {
             return this->transformer;
         }
 
+        virtual bool trySend(cms::Message* message);
+
+        virtual bool trySend(const cms::Destination* destination, cms::Message* message);
+
+        virtual void setProducerWindowListener(cms::ProducerWindowListener* listener) {
+            this->windowListener = listener;
+        }
+
+        virtual cms::ProducerWindowListener* getProducerWindowListener() const {
+            return this->windowListener;
+        }
+
         /**
          * Sets the delivery mode for this Producer
          * @param mode - The DeliveryMode to use for Message sends.
@@ -276,7 +296,9 @@ namespace kernels {
         }
 
         /**
-         * Handles the work of Processing a ProducerAck Command from the Broker.
+         * Handles the work of Processing a ProducerAck Command from the Broker, releasing
+         * the acknowledged space in the producer window and notifying the registered
+         * ProducerWindowListener if a trySend was refused since its last notification.
          * @param ack - The ProducerAck message received from the Broker.
          */
         virtual void onProducerAck(const commands::ProducerAck& ack);
@@ -301,6 +323,11 @@ namespace kernels {
        // Checks for the closed state and throws if so.
        void checkClosed() const;
 
+       // Performs a send, returns false without sending when blockOnWindow is false and
+       // the producer window is full.
+       bool doSend(const cms::Destination* destination, cms::Message* message, int deliveryMode,
+                   int priority, long long timeToLive, cms::AsyncCallback* onComplete, bool blockOnWindow);
+
     };
 
 }}}
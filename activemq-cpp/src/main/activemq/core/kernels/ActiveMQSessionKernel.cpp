@@ -26,6 +26,7 @@
 #include <activemq/core/ActiveMQQueueBrowser.h>
 #include <activemq/core/ActiveMQSessionExecutor.h>
 #include <activemq/core/PrefetchPolicy.h>
+#include <activemq/core/TopicFanOut.h>
 #include <activemq/util/ActiveMQProperties.h>
 #include <activemq/util/ActiveMQMessageTransformation.h>
 #include <activemq/util/CMSExceptionSupport.h>
@@ -53,6 +54,7 @@
 #include <decaf/lang/Runnable.h>
 #include <decaf/lang/Long.h>
 #include <decaf/lang/Math.h>
+#include <decaf/lang/System.h>
 #include <decaf/util/Queue.h>
 #include <decaf/util/LinkedList.h>
 #include <decaf/util/concurrent/Mutex.h>
@@ -101,13 +103,14 @@ namespace kernels{
         cms::MessageTransformer* transformer;
         int hashCode;
         bool sessionAsyncDispatch;
+        Pointer<ParallelDispatcher> parallelDispatcher;
 
     public:
 
         SessionConfig() : synchronizationRegistered(false),
                           producerLock(), producers(), consumerLock(), consumers(),
                           scheduler(), closeSync(), sendMutex(), transformer(NULL),
-                          hashCode(), sessionAsyncDispatch(true) {}
+                          hashCode(), sessionAsyncDispatch(true), parallelDispatcher() {}
         ~SessionConfig() {}
     };
 
@@ -287,6 +290,9 @@ void ActiveMQSessionKernel::close() {
 
     try {
 
+        // Let the Broker answer the outstanding commits before the session goes.
+        this->transaction->waitForCompletions(this->connection->getCloseTimeout());
+
         if (this->transaction->isInXATransaction()) {
             if (!this->config->synchronizationRegistered.compareAndSet(false, true)) {
                 this->config->closeSync.reset(new CloseSynhcronization(this, this->config));
@@ -359,6 +365,11 @@ void ActiveMQSessionKernel::dispose() {
         // Stop the dispatch executor.
         stop();
 
+        // Let the listeners that are still running finish while their consumers can ack.
+        if (this->config->parallelDispatcher != NULL) {
+            this->config->parallelDispatcher->close(this->connection->getCloseTimeout());
+        }
+
         // Dispose of all Consumers, the dispose method skips the RemoveInfo command.
         this->config->consumerLock.writeLock().lock();
         try {
@@ -453,6 +464,40 @@ void ActiveMQSessionKernel::rollback() {
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionKernel::commit(cms::AsyncCallback* onComplete) {
+
+    try {
+
+        this->checkClosed();
+
+        if (!this->isTransacted()) {
+            throw ActiveMQException(
+                __FILE__, __LINE__, "ActiveMQSessionKernel::commit - This Session is not Transacted");
+        }
+
+        this->transaction->commit(onComplete);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionKernel::rollback(cms::AsyncCallback* onComplete) {
+
+    try {
+
+        this->checkClosed();
+
+        if (!this->isTransacted()) {
+            throw ActiveMQException(
+                __FILE__, __LINE__, "ActiveMQSessionKernel::rollback - This Session is not Transacted");
+        }
+
+        this->transaction->rollback(onComplete);
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQSessionKernel::recover() {
 
@@ -592,7 +637,16 @@ cms::MessageConsumer* ActiveMQSessionKernel::createConsumer(const cms::Destinati
 
         try{
             this->addConsumer(consumer);
-            this->connection->syncRequest(consumer->getConsumerInfo());
+
+            // Consumers that share a broker subscription are only known locally, the
+            // shared acks can't carry the transaction of one member.
+            TopicFanOut* fanOut = this->connection->getTopicFanOut();
+            if (!this->isTransacted() && fanOut->canShare(consumer->getConsumerInfo())) {
+                consumer->setFanOutMember(true);
+                fanOut->subscribe(consumer->getConsumerInfo(), this);
+            } else {
+                this->connection->syncRequest(consumer->getConsumerInfo());
+            }
         } catch (Exception& ex) {
             this->removeConsumer(consumer);
             throw;
@@ -925,6 +979,9 @@ void ActiveMQSessionKernel::send(kernels::ActiveMQProducerKernel* producer, Poin
             }
         }
 
+        util::MetricsRegistry* metrics = this->connection->getMetrics();
+        long long start = metrics != NULL ? System::nanoTime() : 0;
+
         synchronized(&this->config->sendMutex) {
 
             // Ensure that a new transaction is started if this is the first message
@@ -956,9 +1013,7 @@ void ActiveMQSessionKernel::send(kernels::ActiveMQProducerKernel* producer, Poin
 
             // Always assign the message ID, regardless of the disable flag.
             // Not adding a message ID will cause an NPE at the broker.
-            decaf::lang::Pointer<commands::MessageId> id(new commands::MessageId());
-            id->setProducerId(producerId);
-            id->setProducerSequenceId(sequenceId);
+            decaf::lang::Pointer<commands::MessageId> id(new commands::MessageId(producerId, sequenceId));
 
             // NOTE:
             // Now we copy the message before sending, this allows the user to reuse the
@@ -994,11 +1049,18 @@ void ActiveMQSessionKernel::send(kernels::ActiveMQProducerKernel* producer, Poin
             if (onComplete == NULL && sendTimeout <= 0 && !amqMessage->isResponseRequired() && !this->connection->isAlwaysSyncSend() &&
                 (!amqMessage->isPersistent() || this->connection->isUseAsyncSend() || amqMessage->getTransactionId() != NULL)) {
 
-                // No Response Required, send is asynchronous.
-                this->connection->oneway(amqMessage);
-
-                if (producerWindow != NULL) {
-                    producerWindow->enqueueUsage(amqMessage->getSize());
+                // No Response Required, send is asynchronous.  Only these sends are
+                // spooled, a synchronous send must not report success before the
+                // broker has the message so it waits for the broker instead.
+                if (amqMessage->getTransactionId() != NULL || !this->connection->spoolMessage(amqMessage)) {
+                    this->connection->oneway(amqMessage);
+
+                    // The producer has already waited for window space, so only account
+                    // for the message here rather than blocking a second time.  Spooled
+                    // messages are forwarded as requests and never produce a ProducerAck.
+                    if (producerWindow != NULL) {
+                        producerWindow->increaseUsage(amqMessage->getSize());
+                    }
                 }
 
             } else {
@@ -1008,6 +1070,12 @@ void ActiveMQSessionKernel::send(kernels::ActiveMQProducerKernel* producer, Poin
                     this->connection->asyncRequest(amqMessage, onComplete);
                 }
             }
+
+            if (metrics != NULL) {
+                metrics->increment(util::MetricsRegistry::MESSAGES_SENT);
+                metrics->increment(util::MetricsRegistry::BYTES_SENT, amqMessage->getSize());
+                metrics->record(util::MetricsRegistry::SEND_LATENCY, (System::nanoTime() - start) / 1000);
+            }
         }
     }
     AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
@@ -1033,6 +1101,49 @@ cms::MessageTransformer* ActiveMQSessionKernel::getMessageTransformer() const {
     return this->config->transformer;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionKernel::setParallelDispatch(int workers, DispatchKeyFunction* keyFunction) {
+
+    try {
+
+        this->checkClosed();
+
+        if (this->isTransacted()) {
+            throw cms::IllegalStateException("Parallel dispatch is not supported by transacted sessions");
+        }
+
+        if (!this->isAutoAcknowledge() && !this->isDupsOkAcknowledge()) {
+            throw cms::IllegalStateException(
+                "Parallel dispatch requires an AUTO_ACKNOWLEDGE or DUPS_OK_ACKNOWLEDGE session");
+        }
+
+        this->config->consumerLock.readLock().lock();
+        bool hasConsumers = !this->config->consumers.isEmpty();
+        this->config->consumerLock.readLock().unlock();
+
+        if (hasConsumers) {
+            throw cms::IllegalStateException("Parallel dispatch must be configured before creating consumers");
+        }
+
+        Pointer<ParallelDispatcher> previous = this->config->parallelDispatcher;
+        if (workers > 0) {
+            this->config->parallelDispatcher.reset(new ParallelDispatcher(workers, keyFunction));
+        } else {
+            this->config->parallelDispatcher.reset(NULL);
+        }
+
+        if (previous != NULL) {
+            previous->close(this->connection->getCloseTimeout());
+        }
+    }
+    AMQ_CATCH_ALL_THROW_CMSEXCEPTION()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<ParallelDispatcher> ActiveMQSessionKernel::getParallelDispatcher() const {
+    return this->config->parallelDispatcher;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<Scheduler> ActiveMQSessionKernel::getScheduler() const {
     return this->config->scheduler;
@@ -1266,6 +1377,9 @@ void ActiveMQSessionKernel::removeConsumer(Pointer<ActiveMQConsumerKernel> consu
 
     try {
         this->connection->removeDispatcher(consumer->getConsumerId());
+        if (consumer->isFanOutMember()) {
+            this->connection->getTopicFanOut()->unsubscribe(consumer->getConsumerId());
+        }
         this->config->consumerLock.writeLock().lock();
         try {
             this->config->consumers.remove(consumer);
@@ -1458,22 +1572,16 @@ void ActiveMQSessionKernel::wakeup() {
 
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<commands::ConsumerId> ActiveMQSessionKernel::getNextConsumerId() {
-    Pointer<ConsumerId> consumerId(new commands::ConsumerId());
-
-    consumerId->setConnectionId(this->connection->getConnectionId().getValue());
-    consumerId->setSessionId(this->sessionInfo->getSessionId()->getValue());
-    consumerId->setValue(this->consumerIds.getNextSequenceId());
+    Pointer<ConsumerId> consumerId(new commands::ConsumerId(
+        *this->sessionInfo->getSessionId(), this->consumerIds.getNextSequenceId()));
 
     return consumerId;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<commands::ProducerId> ActiveMQSessionKernel::getNextProducerId() {
-    Pointer<ProducerId> producerId(new ProducerId());
-
-    producerId->setConnectionId(this->connection->getConnectionId().getValue());
-    producerId->setSessionId(this->sessionInfo->getSessionId()->getValue());
-    producerId->setValue(this->producerIds.getNextSequenceId());
+    Pointer<ProducerId> producerId(new ProducerId(
+        *this->sessionInfo->getSessionId(), this->producerIds.getNextSequenceId()));
 
     return producerId;
 }
@@ -1505,10 +1613,23 @@ void ActiveMQSessionKernel::checkMessageListener() const {
 
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQSessionKernel::sendAck(Pointer<MessageAck> ack, bool async) {
-    if (async || this->connection->isSendAcksAsync() || this->isTransacted()) {
-        this->connection->oneway(ack);
-    } else {
-        this->connection->syncRequest(ack);
+
+    util::MetricsRegistry* metrics = this->connection->getMetrics();
+    long long start = metrics != NULL ? System::nanoTime() : 0;
+
+    // Acks for shared topic subscriptions are merged by the fan out, which sends
+    // whatever the broker needs itself, they still count as sent by this session.
+    if (!this->connection->getTopicFanOut()->acknowledge(ack)) {
+        if (async || this->connection->isSendAcksAsync() || this->isTransacted()) {
+            this->connection->oneway(ack);
+        } else {
+            this->connection->syncRequest(ack);
+        }
+    }
+
+    if (metrics != NULL) {
+        metrics->increment(util::MetricsRegistry::ACKS_SENT);
+        metrics->record(util::MetricsRegistry::ACK_LATENCY, (System::nanoTime() - start) / 1000);
     }
 }
 
@@ -19,6 +19,7 @@
 #define _ACTIVEMQ_CORE_KERNELS_ACTIVEMQSESSIONKERNEL_H_
 
 #include <cms/Session.h>
+#include <cms/AsyncCallback.h>
 #include <cms/ExceptionListener.h>
 
 #include <activemq/util/Config.h>
@@ -37,7 +38,9 @@
 #include <activemq/commands/TransactionId.h>
 #include <activemq/core/Dispatcher.h>
 #include <activemq/core/MessageDispatchChannel.h>
+#include <activemq/core/ParallelDispatcher.h>
 #include <activemq/util/LongSequenceGenerator.h>
+#include <activemq/util/BlockSequenceGenerator.h>
 #include <activemq/threads/Scheduler.h>
 
 #include <decaf/lang/Pointer.h>
@@ -107,7 +110,7 @@ namespace kernels {
         /**
          * Next available Producer Id
          */
-        util::LongSequenceGenerator producerIds;
+        util::BlockSequenceGenerator producerIds;
 
         /**
          * Next available Producer Sequence Id
@@ -117,7 +120,7 @@ namespace kernels {
         /**
          * Next available Consumer Id
          */
-        util::LongSequenceGenerator consumerIds;
+        util::BlockSequenceGenerator consumerIds;
 
         /**
          * Last Delivered Sequence Id
@@ -160,6 +163,28 @@ namespace kernels {
          */
         bool isStarted() const;
 
+        /**
+         * Commits the current transaction without waiting for the broker to answer, the
+         * session can start on its next transaction at once.  The callback is notified
+         * of the outcome from the connection's transport thread.
+         *
+         * @param onComplete
+         *      Notified of the outcome, if NULL this is the same as commit().
+         *
+         * @throws CMSException if the session is not transacted or the commit can't be sent.
+         */
+        virtual void commit(cms::AsyncCallback* onComplete);
+
+        /**
+         * Rolls back the current transaction without waiting for the broker to answer.
+         *
+         * @param onComplete
+         *      Notified of the outcome, if NULL this is the same as rollback().
+         *
+         * @throws CMSException if the session is not transacted or the rollback can't be sent.
+         */
+        virtual void rollback(cms::AsyncCallback* onComplete);
+
         virtual bool isAutoAcknowledge() const {
             return this->ackMode == cms::Session::AUTO_ACKNOWLEDGE;
         }
@@ -306,6 +331,38 @@ namespace kernels {
          */
         virtual cms::MessageTransformer* getMessageTransformer() const;
 
+        /**
+         * Enables parallel delivery to the MessageListeners of this session's consumers.
+         * Messages are handed to a pool of worker threads keyed by their message group
+         * id, or by the given key function, so messages with the same key stay in order
+         * while the rest are processed concurrently.  Each consumer still acknowledges
+         * its messages in the order they were dispatched, a message is only acknowledged
+         * once it and every message dispatched before it have been processed.
+         *
+         * Must be set before any consumer is created and is only supported by sessions that
+         * use AUTO_ACKNOWLEDGE or DUPS_OK_ACKNOWLEDGE mode.
+         *
+         * @param workers
+         *      The number of worker threads, zero turns parallel delivery off.
+         * @param keyFunction
+         *      Picks the ordering key for each message, NULL orders by message group.
+         *      The caller retains ownership and must keep it alive as long as this session.
+         *
+         * @throws IllegalStateException if the acknowledgement mode is not supported or the
+         *         session already has consumers.
+         *
+         * @since 3.10
+         */
+        void setParallelDispatch(int workers, DispatchKeyFunction* keyFunction);
+
+        /**
+         * @return the dispatcher used for parallel listener delivery or NULL if the
+         *         session delivers to its listeners one message at a time.
+         *
+         * @since 3.10
+         */
+        Pointer<ParallelDispatcher> getParallelDispatcher() const;
+
         /**
          * Gets the Session Information object for this session, if the
          * session is closed than this method throws an exception.
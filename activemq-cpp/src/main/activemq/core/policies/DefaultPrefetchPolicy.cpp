@@ -31,13 +31,18 @@ int DefaultPrefetchPolicy::DEFAULT_DURABLE_TOPIC_PREFETCH = 100;
 int DefaultPrefetchPolicy::DEFAULT_QUEUE_PREFETCH = 1000;
 int DefaultPrefetchPolicy::DEFAULT_QUEUE_BROWSER_PREFETCH = 500;
 int DefaultPrefetchPolicy::DEFAULT_TOPIC_PREFETCH = MAX_PREFETCH_SIZE;
+long long DefaultPrefetchPolicy::DEFAULT_ADAPTIVE_TARGET_LATENCY = 100;
+int DefaultPrefetchPolicy::DEFAULT_ADAPTIVE_MINIMUM_PREFETCH = 1;
 
 ////////////////////////////////////////////////////////////////////////////////
 DefaultPrefetchPolicy::DefaultPrefetchPolicy() :
     durableTopicPrefetch( DEFAULT_DURABLE_TOPIC_PREFETCH ),
     queuePrefetch( DEFAULT_QUEUE_PREFETCH ),
     queueBrowserPrefetch( DEFAULT_QUEUE_BROWSER_PREFETCH ),
-    topicPrefetch( DEFAULT_TOPIC_PREFETCH ) {
+    topicPrefetch( DEFAULT_TOPIC_PREFETCH ),
+    adaptive( false ),
+    adaptiveTargetLatency( DEFAULT_ADAPTIVE_TARGET_LATENCY ),
+    adaptiveMinimumPrefetch( DEFAULT_ADAPTIVE_MINIMUM_PREFETCH ) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -53,6 +58,9 @@ PrefetchPolicy* DefaultPrefetchPolicy::clone() const {
     copy->setTopicPrefetch(this->getTopicPrefetch());
     copy->setQueueBrowserPrefetch(this->getQueueBrowserPrefetch());
     copy->setQueuePrefetch(this->getQueuePrefetch());
+    copy->setAdaptive(this->isAdaptive());
+    copy->setAdaptiveTargetLatency(this->getAdaptiveTargetLatency());
+    copy->setAdaptiveMinimumPrefetch(this->getAdaptiveMinimumPrefetch());
 
     return copy;
 }
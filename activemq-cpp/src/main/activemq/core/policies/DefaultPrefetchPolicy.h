@@ -33,6 +33,9 @@ namespace policies {
         int queuePrefetch;
         int queueBrowserPrefetch;
         int topicPrefetch;
+        bool adaptive;
+        long long adaptiveTargetLatency;
+        int adaptiveMinimumPrefetch;
 
     public:
 
@@ -41,6 +44,8 @@ namespace policies {
         static int DEFAULT_QUEUE_PREFETCH;
         static int DEFAULT_QUEUE_BROWSER_PREFETCH;
         static int DEFAULT_TOPIC_PREFETCH;
+        static long long DEFAULT_ADAPTIVE_TARGET_LATENCY;
+        static int DEFAULT_ADAPTIVE_MINIMUM_PREFETCH;
 
     private:
 
@@ -89,6 +94,30 @@ namespace policies {
             return value < MAX_PREFETCH_SIZE ? value : MAX_PREFETCH_SIZE;
         }
 
+        virtual void setAdaptive(bool value) {
+            this->adaptive = value;
+        }
+
+        virtual bool isAdaptive() const {
+            return this->adaptive;
+        }
+
+        virtual void setAdaptiveTargetLatency(long long value) {
+            this->adaptiveTargetLatency = value > 0 ? value : 1;
+        }
+
+        virtual long long getAdaptiveTargetLatency() const {
+            return this->adaptiveTargetLatency;
+        }
+
+        virtual void setAdaptiveMinimumPrefetch(int value) {
+            this->adaptiveMinimumPrefetch = value > 0 ? getMaxPrefetchLimit(value) : 1;
+        }
+
+        virtual int getAdaptiveMinimumPrefetch() const {
+            return this->adaptiveMinimumPrefetch;
+        }
+
         virtual PrefetchPolicy* clone() const;
 
     };
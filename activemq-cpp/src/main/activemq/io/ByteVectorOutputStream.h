@@ -0,0 +1,75 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_IO_BYTEVECTOROUTPUTSTREAM_H_
+#define _ACTIVEMQ_IO_BYTEVECTOROUTPUTSTREAM_H_
+
+#include <activemq/util/Config.h>
+#include <decaf/io/OutputStream.h>
+
+#include <vector>
+
+namespace activemq {
+namespace io {
+
+    /**
+     * OutputStream that appends everything written to it onto a std::vector that it
+     * does not own.  Messages use this to build their body directly in their content
+     * so the body doesn't need to be copied out of a separate buffer when it's stored.
+     *
+     * @since 3.10.0
+     */
+    class AMQCPP_API ByteVectorOutputStream : public decaf::io::OutputStream {
+    private:
+
+        std::vector<unsigned char>* target;
+
+    private:
+
+        ByteVectorOutputStream(const ByteVectorOutputStream&);
+        ByteVectorOutputStream& operator=(const ByteVectorOutputStream&);
+
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param target
+         *      The vector that written bytes are appended to, it must outlive this stream.
+         */
+        ByteVectorOutputStream(std::vector<unsigned char>& target);
+
+        virtual ~ByteVectorOutputStream();
+
+        /**
+         * @return the number of bytes currently held in the target vector.
+         */
+        int size() const {
+            return (int) this->target->size();
+        }
+
+    protected:
+
+        virtual void doWriteByte(unsigned char value);
+
+        virtual void doWriteArrayBounded(const unsigned char* buffer, int size, int offset, int length);
+
+    };
+
+}}
+
+#endif /*_ACTIVEMQ_IO_BYTEVECTOROUTPUTSTREAM_H_*/
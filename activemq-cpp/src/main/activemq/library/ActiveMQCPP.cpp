@@ -23,6 +23,10 @@
 #include <activemq/transport/discovery/DiscoveryAgentRegistry.h>
 
 #include <activemq/util/IdGenerator.h>
+#include <activemq/util/BlockSequenceGenerator.h>
+#include <activemq/util/IdPrefixTable.h>
+#include <activemq/util/MetricsRegistry.h>
+#include <activemq/util/PropertyNameTable.h>
 
 #include <activemq/wireformat/stomp/StompWireFormatFactory.h>
 #include <activemq/wireformat/openwire/OpenWireFormatFactory.h>
@@ -70,6 +74,10 @@ void ActiveMQCPP::initializeLibrary(int argc, char** argv) {
 
     // Start the IdGenerator Kernel
     IdGenerator::initialize();
+    BlockSequenceGenerator::initialize();
+    MetricsRegistry::initialize();
+    IdPrefixTable::initialize();
+    PropertyNameTable::initialize();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -81,6 +89,10 @@ void ActiveMQCPP::initializeLibrary() {
 void ActiveMQCPP::shutdownLibrary() {
 
     // Shutdown the IdGenerator Kernel
+    PropertyNameTable::shutdown();
+    IdPrefixTable::shutdown();
+    MetricsRegistry::shutdown();
+    BlockSequenceGenerator::shutdown();
     IdGenerator::shutdown();
 
     WireFormatRegistry::shutdown();
@@ -23,14 +23,20 @@
 #include <decaf/util/MapEntry.h>
 #include <decaf/util/NoSuchElementException.h>
 #include <decaf/util/concurrent/ConcurrentStlMap.h>
+#include <decaf/util/concurrent/Concurrent.h>
+#include <decaf/util/concurrent/Mutex.h>
 
 #include <activemq/commands/ConsumerControl.h>
 #include <activemq/commands/ExceptionResponse.h>
 #include <activemq/commands/RemoveInfo.h>
 #include <activemq/core/ActiveMQConstants.h>
+#include <activemq/transport/IOTransport.h>
 #include <activemq/transport/TransportListener.h>
 #include <activemq/wireformat/WireFormat.h>
 
+#include <typeinfo>
+#include <vector>
+
 using namespace activemq;
 using namespace activemq::core;
 using namespace activemq::state;
@@ -40,36 +46,174 @@ using namespace decaf;
 using namespace decaf::lang;
 using namespace decaf::io;
 using namespace decaf::lang::exceptions;
+using namespace decaf::util::concurrent;
 
 ////////////////////////////////////////////////////////////////////////////////
 namespace activemq {
 namespace state {
 
 
-    class MessageCache : public LinkedHashMap<Pointer<MessageId>, Pointer<Command> > {
-    protected:
+    /**
+     * Holds the most recently sent Messages for replay, bounded by the total size of the
+     * cached Messages rather than their count.  Entries live in a ring so that adding a
+     * Message and evicting the eldest ones is a few index updates under a short lock, no
+     * nodes are allocated and no MessageId needs to be hashed on the send path.
+     */
+    class MessageCache {
+    private:
+
+        struct CacheEntry {
+            Pointer<Message> message;
+            unsigned int size;
+
+            CacheEntry() : message(), size(0) {}
+        };
 
         ConnectionStateTracker* parent;
 
-    public:
+        // Capacity is always a power of two so positions wrap with a mask.
+        std::vector<CacheEntry> ring;
+        std::size_t head;
+        std::size_t count;
+        long long currentCacheSize;
+
+        mutable Mutex mutex;
+
+    private:
 
-        int currentCacheSize;
+        MessageCache(const MessageCache&);
+        MessageCache& operator=(const MessageCache&);
 
     public:
 
         MessageCache(ConnectionStateTracker* parent) :
-            LinkedHashMap<Pointer<MessageId>, Pointer<Command> >(), parent(parent), currentCacheSize(0) {
+            parent(parent), ring(16), head(0), count(0), currentCacheSize(0), mutex() {
         }
 
         virtual ~MessageCache() {}
 
-        virtual bool removeEldestEntry(const MapEntry<Pointer<MessageId>, Pointer<Command> >& eldest) {
-            bool result = currentCacheSize > parent->getMaxMessageCacheSize();
-            if (result) {
-                Pointer<Message> message = eldest.getValue().dynamicCast<Message>();
-                currentCacheSize -= message->getSize();
+        void add(const Pointer<Message>& message) {
+
+            unsigned int size = message->getSize();
+
+            synchronized(&mutex) {
+
+                // A send that failed is retried with the same Message, replace it instead of
+                // caching it twice so it's only replayed once.
+                CacheEntry* last = newest();
+                if (last != NULL && isSameMessage(*last, message)) {
+                    currentCacheSize += (long long) size - last->size;
+                    last->message = message;
+                    last->size = size;
+                } else {
+                    if (count == ring.size()) {
+                        grow();
+                    }
+
+                    CacheEntry& entry = ring[(head + count) & (ring.size() - 1)];
+                    entry.message = message;
+                    entry.size = size;
+                    currentCacheSize += size;
+                    count++;
+                }
+
+                evict();
+            }
+        }
+
+        /**
+         * Refreshes the size of a Message once it has been sent, its marshaled properties
+         * aren't known until then.
+         */
+        void update(const Pointer<Message>& message) {
+
+            synchronized(&mutex) {
+                CacheEntry* last = newest();
+                if (last != NULL && isSameMessage(*last, message)) {
+                    unsigned int size = message->getSize();
+                    currentCacheSize += (long long) size - last->size;
+                    last->size = size;
+                    evict();
+                }
+            }
+        }
+
+        /**
+         * Copies the cached Messages, eldest first, so they can be replayed without holding
+         * the cache lock while writing to the Transport.
+         */
+        void snapshot(std::vector<Pointer<Command> >& messages) const {
+
+            synchronized(&mutex) {
+                messages.reserve(messages.size() + count);
+                for (std::size_t i = 0; i < count; ++i) {
+                    messages.push_back(ring[(head + i) & (ring.size() - 1)].message);
+                }
+            }
+        }
+
+        int size() const {
+            synchronized(&mutex) {
+                return (int) count;
+            }
+
+            return 0;
+        }
+
+        void clear() {
+
+            synchronized(&mutex) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    ring[(head + i) & (ring.size() - 1)].message.reset(NULL);
+                }
+
+                head = 0;
+                count = 0;
+                currentCacheSize = 0;
+            }
+        }
+
+    private:
+
+        CacheEntry* newest() {
+            if (count == 0) {
+                return NULL;
+            }
+
+            return &ring[(head + count - 1) & (ring.size() - 1)];
+        }
+
+        static bool isSameMessage(const CacheEntry& entry, const Pointer<Message>& message) {
+
+            if (entry.message == message) {
+                return true;
             }
-            return result;
+
+            Pointer<MessageId> cachedId = entry.message->getMessageId();
+            Pointer<MessageId> messageId = message->getMessageId();
+
+            return cachedId != NULL && messageId != NULL && cachedId->equals(*messageId);
+        }
+
+        void evict() {
+            while (count > 0 && currentCacheSize > parent->getMaxMessageCacheSize()) {
+                CacheEntry& eldest = ring[head];
+                currentCacheSize -= eldest.size;
+                eldest.message.reset(NULL);
+                head = (head + 1) & (ring.size() - 1);
+                count--;
+            }
+        }
+
+        void grow() {
+
+            std::vector<CacheEntry> larger(ring.size() * 2);
+            for (std::size_t i = 0; i < count; ++i) {
+                larger[i] = ring[(head + i) & (ring.size() - 1)];
+            }
+
+            ring.swap(larger);
+            head = 0;
         }
     };
 
@@ -131,6 +275,47 @@ namespace state {
         }
     };
 
+    /**
+     * Holds a batch of writes open on an IOTransport while a phase of the restore is
+     * replayed, so the phase is flushed once instead of once per command.
+     */
+    class RestoreBatch {
+    private:
+
+        transport::IOTransport* transport;
+
+    private:
+
+        RestoreBatch(const RestoreBatch&);
+        RestoreBatch& operator=(const RestoreBatch&);
+
+    public:
+
+        RestoreBatch(transport::IOTransport* transport) : transport(transport) {
+            if (transport != NULL) {
+                transport->beginBatch();
+            }
+        }
+
+        ~RestoreBatch() {
+            try {
+                if (transport != NULL) {
+                    transport->endBatch();
+                }
+            }
+            AMQ_CATCHALL_NOTHROW()
+        }
+
+        void complete() {
+            transport::IOTransport* target = transport;
+            transport = NULL;
+
+            if (target != NULL) {
+                target->endBatch();
+            }
+        }
+    };
+
     class RemoveTransactionAction : public Runnable {
     private:
 
@@ -188,6 +373,18 @@ Pointer<Tracked> ConnectionStateTracker::track(Pointer<Command> command) {
 
     try{
 
+        // Messages are the bulk of the traffic, the session already sends a private copy
+        // of each one so it can be kept as is rather than cloned again by processMessage.
+        if (command != NULL && command->isMessage()) {
+            Pointer<Message> message = command.dynamicCast<Message>();
+            Pointer<Command> result = trackMessage(message);
+            if (result == NULL) {
+                return Pointer<Tracked>();
+            } else {
+                return result.dynamicCast<Tracked>();
+            }
+        }
+
         Pointer<Command> result = command->visit(this);
         if (result == NULL) {
             return Pointer<Tracked>();
@@ -208,7 +405,7 @@ void ConnectionStateTracker::trackBack(Pointer<Command> command) {
             if (trackMessages && command->isMessage()) {
                 Pointer<Message> message = command.dynamicCast<Message>();
                 if (message->getTransactionId() == NULL) {
-                    this->impl->messageCache.currentCacheSize += message->getSize();
+                    this->impl->messageCache.update(message);
                 }
             }
         }
@@ -223,37 +420,70 @@ void ConnectionStateTracker::restore(Pointer<transport::Transport> transport) {
 
     try {
 
+        // When the chain ends in an IOTransport the replayed commands are written into its
+        // buffered stream and flushed once per phase rather than once per command.  The
+        // consumers go out in the first phase so that dispatch resumes while the producers,
+        // transactions and cached messages are still being sent.
+        transport::IOTransport* ioTransport =
+            dynamic_cast<transport::IOTransport*>(transport->narrow(typeid(transport::IOTransport)));
+
+        std::vector<Pointer<ConnectionState> > states;
         Pointer<Iterator<Pointer<ConnectionState> > > iterator(
             this->impl->connectionStates.values().iterator());
-
         while (iterator->hasNext()) {
-            Pointer<ConnectionState> state = iterator->next();
+            states.push_back(iterator->next());
+        }
+
+        std::vector<Pointer<ConnectionState> >::const_iterator state;
+
+        RestoreBatch consumerPhase(ioTransport);
+
+        for (state = states.begin(); state != states.end(); ++state) {
 
-            Pointer<ConnectionInfo> info = state->getInfo();
+            Pointer<ConnectionInfo> info = (*state)->getInfo();
             info->setFailoverReconnect(true);
             transport->oneway(info);
 
-            doRestoreTempDestinations(transport, state);
+            doRestoreTempDestinations(transport, *state);
 
             if (restoreSessions) {
-                doRestoreSessions(transport, state);
+                doRestoreSessions(transport, *state);
+            }
+        }
+
+        Pointer<Iterator<Pointer<Command> > > messagePullIter(this->impl->messagePullCache.values().iterator());
+        while (messagePullIter->hasNext()) {
+            transport->oneway(messagePullIter->next());
+        }
+
+        consumerPhase.complete();
+
+        RestoreBatch producerPhase(ioTransport);
+
+        for (state = states.begin(); state != states.end(); ++state) {
+
+            if (restoreSessions && restoreProducers) {
+                Pointer<Iterator<Pointer<SessionState> > > session((*state)->getSessionStates().iterator());
+                while (session->hasNext()) {
+                    doRestoreProducers(transport, session->next());
+                }
             }
 
             if (restoreTransaction) {
-                doRestoreTransactions(transport, state);
+                doRestoreTransactions(transport, *state);
             }
         }
 
         // Now we flush messages
-        Pointer<Iterator<Pointer<Command> > > messages(this->impl->messageCache.values().iterator());
-        while (messages->hasNext()) {
-            transport->oneway(messages->next());
-        }
+        std::vector<Pointer<Command> > messages;
+        this->impl->messageCache.snapshot(messages);
 
-        Pointer<Iterator<Pointer<Command> > > messagePullIter(this->impl->messagePullCache.values().iterator());
-        while (messagePullIter->hasNext()) {
-            transport->oneway(messagePullIter->next());
+        std::vector<Pointer<Command> >::const_iterator message = messages.begin();
+        for (; message != messages.end(); ++message) {
+            transport->oneway(*message);
         }
+
+        producerPhase.complete();
     }
     AMQ_CATCH_RETHROW(IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
@@ -328,10 +558,7 @@ void ConnectionStateTracker::doRestoreSessions(Pointer<transport::Transport> tra
             Pointer<SessionState> state = iter->next();
             transport->oneway(state->getInfo());
 
-            if (restoreProducers) {
-                doRestoreProducers(transport, state);
-            }
-
+            // Producers are restored after every consumer, see restore.
             if (restoreConsumers) {
                 doRestoreConsumers(transport, state);
             }
@@ -626,32 +853,8 @@ Pointer<Command> ConnectionStateTracker::processMessage(Message* message) {
 
     try {
 
-        if (message != NULL) {
-            if (trackTransactions && message->getTransactionId() != NULL) {
-                Pointer<ProducerId> producerId = message->getProducerId();
-                Pointer<ConnectionId> connectionId = producerId->getParentId()->getParentId();
-
-                if (connectionId != NULL) {
-                    Pointer<ConnectionState> cs = this->impl->connectionStates.get(connectionId);
-                    if (cs != NULL) {
-                        Pointer<TransactionState> transactionState = cs->getTransactionState(message->getTransactionId());
-                        if (transactionState != NULL) {
-                            transactionState->addCommand(Pointer<Command>(message->cloneDataStructure()));
-
-                            if (trackTransactionProducers) {
-                                // Track the producer in case it is closed before a commit
-                                Pointer<SessionState> sessionState = cs->getSessionState(producerId->getParentId());
-                                Pointer<ProducerState> producerState = sessionState->getProducerState(producerId);
-                                producerState->setTransactionState(transactionState);
-                            }
-                        }
-                    }
-                }
-                return this->impl->TRACKED_RESPONSE_MARKER;
-            } else if (trackMessages) {
-                this->impl->messageCache.put(
-                    message->getMessageId(), Pointer<Message>(message->cloneDataStructure()));
-            }
+        if (message != NULL && (trackMessages || (trackTransactions && message->getTransactionId() != NULL))) {
+            return trackMessage(Pointer<Message>(message->cloneDataStructure()));
         }
 
         return Pointer<Response>();
@@ -661,6 +864,37 @@ Pointer<Command> ConnectionStateTracker::processMessage(Message* message) {
     AMQ_CATCHALL_THROW(ActiveMQException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+Pointer<Command> ConnectionStateTracker::trackMessage(Pointer<Message> message) {
+
+    if (trackTransactions && message->getTransactionId() != NULL) {
+        Pointer<ProducerId> producerId = message->getProducerId();
+        Pointer<ConnectionId> connectionId = producerId->getParentId()->getParentId();
+
+        if (connectionId != NULL) {
+            Pointer<ConnectionState> cs = this->impl->connectionStates.get(connectionId);
+            if (cs != NULL) {
+                Pointer<TransactionState> transactionState = cs->getTransactionState(message->getTransactionId());
+                if (transactionState != NULL) {
+                    transactionState->addCommand(message);
+
+                    if (trackTransactionProducers) {
+                        // Track the producer in case it is closed before a commit
+                        Pointer<SessionState> sessionState = cs->getSessionState(producerId->getParentId());
+                        Pointer<ProducerState> producerState = sessionState->getProducerState(producerId);
+                        producerState->setTransactionState(transactionState);
+                    }
+                }
+            }
+        }
+        return this->impl->TRACKED_RESPONSE_MARKER;
+    } else if (trackMessages) {
+        this->impl->messageCache.add(message);
+    }
+
+    return Pointer<Response>();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<Command> ConnectionStateTracker::processBeginTransaction(TransactionInfo* info) {
 
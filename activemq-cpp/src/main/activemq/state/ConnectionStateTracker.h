@@ -182,6 +182,8 @@ namespace state {
 
     private:
 
+        decaf::lang::Pointer<Command> trackMessage(decaf::lang::Pointer<Message> message);
+
         void doRestoreTransactions(decaf::lang::Pointer<transport::Transport> transport,
                                    decaf::lang::Pointer<ConnectionState> connectionState);
 
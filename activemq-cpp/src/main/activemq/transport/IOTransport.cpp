@@ -17,6 +17,7 @@
 
 #include "IOTransport.h"
 
+#include <decaf/lang/System.h>
 #include <decaf/util/concurrent/Concurrent.h>
 #include <decaf/util/concurrent/atomic/AtomicBoolean.h>
 #include <decaf/lang/exceptions/UnsupportedOperationException.h>
@@ -59,11 +60,18 @@ namespace transport {
         AtomicBoolean closed;
         AtomicBoolean started;
 
-        IOTransportImpl() : wireFormat(), listener(NULL), inputStream(NULL), outputStream(NULL), thread(), closed(false) {
+        // Depth of nested write batches, only accessed while holding the output stream lock.
+        int batchDepth;
+
+        util::MetricsRegistry* metrics;
+
+        IOTransportImpl() : wireFormat(), listener(NULL), inputStream(NULL), outputStream(NULL), thread(), closed(false),
+                            batchDepth(0), metrics(NULL) {
         }
 
         IOTransportImpl(const Pointer<WireFormat> wireFormat) :
-            wireFormat(wireFormat), listener(NULL), inputStream(NULL), outputStream(NULL), thread(), closed(false) {
+            wireFormat(wireFormat), listener(NULL), inputStream(NULL), outputStream(NULL), thread(), closed(false),
+            batchDepth(0), metrics(NULL) {
         }
     };
 
@@ -142,9 +150,51 @@ void IOTransport::oneway(const Pointer<Command> command) {
         }
 
         synchronized(impl->outputStream) {
+            util::MetricsRegistry* metrics = this->impl->metrics;
+            long long start = metrics != NULL ? System::nanoTime() : 0;
+
             // Write the command to the output stream.
             this->impl->wireFormat->marshal(command, this, this->impl->outputStream);
-            this->impl->outputStream->flush();
+
+            if (metrics != NULL) {
+                metrics->record(util::MetricsRegistry::MARSHAL_TIME, (System::nanoTime() - start) / 1000);
+            }
+
+            if (this->impl->batchDepth == 0) {
+                this->impl->outputStream->flush();
+            }
+        }
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::beginBatch() {
+
+    if (impl->outputStream == NULL) {
+        return;
+    }
+
+    synchronized(impl->outputStream) {
+        this->impl->batchDepth++;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::endBatch() {
+
+    try {
+
+        if (impl->outputStream == NULL) {
+            return;
+        }
+
+        synchronized(impl->outputStream) {
+            if (this->impl->batchDepth > 0 && --this->impl->batchDepth == 0 && !impl->closed.get()) {
+                this->impl->outputStream->flush();
+            }
         }
     }
     AMQ_CATCH_RETHROW(IOException)
@@ -152,6 +202,11 @@ void IOTransport::oneway(const Pointer<Command> command) {
     AMQ_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::setMetrics(util::MetricsRegistry* metrics) {
+    this->impl->metrics = metrics;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void IOTransport::start() {
 
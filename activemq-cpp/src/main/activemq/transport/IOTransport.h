@@ -23,6 +23,7 @@
 #include <activemq/transport/TransportListener.h>
 #include <activemq/commands/Command.h>
 #include <activemq/commands/Response.h>
+#include <activemq/util/MetricsRegistry.h>
 #include <activemq/wireformat/WireFormat.h>
 
 #include <decaf/lang/Runnable.h>
@@ -121,6 +122,34 @@ namespace transport {
          */
         virtual void setOutputStream(decaf::io::DataOutputStream* os);
 
+        /**
+         * Starts a batch of writes.  Until the matching call to endBatch the commands
+         * passed to oneway are marshaled into the output stream without flushing it, so
+         * a burst of commands goes out in as few writes as the stream's buffer allows.
+         * Batches can be nested, the stream is flushed when the outermost one ends.
+         */
+        void beginBatch();
+
+        /**
+         * Ends a batch of writes started with beginBatch, flushing the output stream
+         * when this ends the outermost batch.
+         *
+         * @throws IOException if an error occurs while flushing the output stream.
+         */
+        void endBatch();
+
+        /**
+         * Sets the registry that the time spent marshaling outgoing commands is recorded
+         * in, or NULL to stop recording.  The registry is not owned by this transport and
+         * must remain valid until it is replaced or the transport is closed.
+         *
+         * @param metrics
+         *      The registry to record marshal times in.
+         *
+         * @since 3.10
+         */
+        void setMetrics(util::MetricsRegistry* metrics);
+
     public:  // Transport methods
 
         virtual void oneway(const Pointer<Command> command);
@@ -19,16 +19,19 @@
 
 #include <memory>
 
+#include <activemq/commands/KeepAliveInfo.h>
 #include <activemq/exceptions/ActiveMQException.h>
 #include <activemq/transport/TransportFactory.h>
 #include <activemq/transport/TransportRegistry.h>
 #include <activemq/transport/failover/FailoverTransport.h>
 
 #include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/System.h>
 #include <decaf/lang/exceptions/IllegalStateException.h>
 
 using namespace activemq;
 using namespace activemq::threads;
+using namespace activemq::commands;
 using namespace activemq::exceptions;
 using namespace activemq::transport;
 using namespace activemq::transport::failover;
@@ -228,7 +231,21 @@ Pointer<BackupTransport> BackupTransportPool::getBackup() {
 
     synchronized(&this->impl->backups) {
         if (!this->impl->backups.isEmpty()) {
-            result = this->impl->backups.removeAt(0);
+            int index = 0;
+
+            // Priority backups stay first, otherwise hand out the fastest backup.
+            Pointer<URILatencyTracker> tracker = this->uriPool->getLatencyTracker();
+            if (tracker != NULL && !this->impl->backups.getFirst()->isPriority()) {
+                LinkedList<URI> candidates;
+                std::auto_ptr<Iterator<Pointer<BackupTransport> > > iter(this->impl->backups.iterator());
+                while (iter->hasNext()) {
+                    candidates.add(iter->next()->getUri());
+                }
+
+                index = tracker->selectBest(candidates);
+            }
+
+            result = this->impl->backups.removeAt(index);
         }
     }
 
@@ -282,6 +299,9 @@ bool BackupTransportPool::iterate() {
             Pointer<BackupTransport> backup(new BackupTransport(this));
             backup->setUri(connectTo);
 
+            Pointer<URILatencyTracker> tracker = uriPool->getLatencyTracker();
+            long long connectStart = System::currentTimeMillis();
+
             try {
                 Pointer<Transport> transport = createTransport(connectTo);
 
@@ -289,6 +309,13 @@ bool BackupTransportPool::iterate() {
                 transport->start();
                 backup->setTransport(transport);
 
+                if (tracker != NULL) {
+                    // The KeepAliveInfo can only go out once the WireFormatInfo exchange
+                    // is done so the time taken covers both connect and handshake.
+                    transport->oneway(Pointer<Command>(new KeepAliveInfo()));
+                    tracker->recordLatency(connectTo, System::currentTimeMillis() - connectStart);
+                }
+
                 if (priorityUriPool->contains(connectTo) || (priorityUriPool->isEmpty() && uriPool->isPriority(connectTo))) {
                     backup->setPriority(true);
 
@@ -307,6 +334,10 @@ bool BackupTransportPool::iterate() {
                 }
 
             } catch (...) {
+                if (tracker != NULL) {
+                    tracker->recordFailure(connectTo);
+                }
+
                 // Store it in the list of URIs that didn't work, once done we
                 // return those to the pool.
                 failures.add(connectTo);
@@ -332,6 +363,11 @@ bool BackupTransportPool::iterate() {
 ////////////////////////////////////////////////////////////////////////////////
 void BackupTransportPool::onBackupTransportFailure(BackupTransport* failedTransport) {
 
+    Pointer<URILatencyTracker> tracker = this->uriPool->getLatencyTracker();
+    if (tracker != NULL) {
+        tracker->recordFailure(failedTransport->getUri());
+    }
+
     synchronized(&this->impl->backups) {
 
         std::auto_ptr<Iterator<Pointer<BackupTransport> > > iter(this->impl->backups.iterator());
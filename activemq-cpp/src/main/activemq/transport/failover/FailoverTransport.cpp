@@ -18,6 +18,7 @@
 #include "FailoverTransport.h"
 
 #include <activemq/commands/ConnectionControl.h>
+#include <activemq/commands/KeepAliveInfo.h>
 #include <activemq/commands/ShutdownInfo.h>
 #include <activemq/commands/RemoveInfo.h>
 #include <activemq/transport/TransportRegistry.h>
@@ -27,6 +28,7 @@
 #include <activemq/transport/failover/URIPool.h>
 #include <activemq/transport/failover/FailoverTransportListener.h>
 #include <activemq/transport/failover/CloseTransportsTask.h>
+#include <activemq/transport/failover/URILatencyTracker.h>
 #include <activemq/transport/failover/URIPool.h>
 #include <decaf/util/Random.h>
 #include <decaf/util/StringTokenizer.h>
@@ -34,8 +36,11 @@
 #include <decaf/util/StlMap.h>
 #include <decaf/util/concurrent/TimeUnit.h>
 #include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/LinkedBlockingQueue.h>
+#include <decaf/util/concurrent/ThreadPoolExecutor.h>
 #include <decaf/lang/System.h>
 #include <decaf/lang/Integer.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
 
 using namespace std;
 using namespace activemq;
@@ -58,6 +63,76 @@ namespace activemq {
 namespace transport {
 namespace failover {
 
+    /**
+     * Listener for a racing connect attempt.  The broker starts talking as soon as the
+     * handshake completes, so everything received before the attempt is known to have
+     * won is held here and replayed to the real listener once it is handed off.
+     */
+    class RaceTransportListener : public TransportListener {
+    private:
+
+        RaceTransportListener(const RaceTransportListener&);
+        RaceTransportListener& operator= (const RaceTransportListener&);
+
+        Mutex mutex;
+        TransportListener* delegate;
+        LinkedList< Pointer<Command> > commands;
+        Pointer<Exception> failure;
+
+    public:
+
+        RaceTransportListener() : TransportListener(), mutex(), delegate(NULL), commands(), failure() {
+        }
+
+        virtual ~RaceTransportListener() {}
+
+        /**
+         * Replays everything buffered so far to the given listener and forwards anything
+         * received afterwards to it directly.
+         *
+         * @throws IOException if the transport failed after winning the race.
+         */
+        void handOff(TransportListener* listener) {
+            synchronized(&mutex) {
+                if (failure != NULL) {
+                    throw IOException(__FILE__, __LINE__, "Raced transport failed: %s", failure->getMessage().c_str());
+                }
+
+                delegate = listener;
+
+                while (!commands.isEmpty()) {
+                    listener->onCommand(commands.removeFirst());
+                }
+            }
+        }
+
+        virtual void onCommand(const Pointer<Command> command) {
+            synchronized(&mutex) {
+                if (delegate != NULL) {
+                    delegate->onCommand(command);
+                } else {
+                    commands.addLast(command);
+                }
+            }
+        }
+
+        virtual void onException(const decaf::lang::Exception& ex) {
+            synchronized(&mutex) {
+                if (delegate != NULL) {
+                    delegate->onException(ex);
+                } else if (failure == NULL) {
+                    failure.reset(ex.clone());
+                }
+            }
+        }
+
+        virtual void transportInterrupted() {
+        }
+
+        virtual void transportResumed() {
+        }
+    };
+
     class FailoverTransportImpl {
     private:
 
@@ -94,6 +169,9 @@ namespace failover {
         bool rebalanceUpdateURIs;
         bool priorityBackup;
         bool backupsEnabled;
+        bool latencyAware;
+        bool reconnectRace;
+        int reconnectRaceSize;
         volatile bool shutdown;
 
         bool doRebalance;
@@ -108,6 +186,7 @@ namespace failover {
         Pointer<URIPool> uris;
         Pointer<URIPool> priorityUris;
         Pointer<URIPool> updated;
+        Pointer<URILatencyTracker> latencyTracker;
         Pointer<URI> connectedTransportURI;
         Pointer<Transport> connectedTransport;
         Pointer<Exception> connectionFailure;
@@ -119,6 +198,11 @@ namespace failover {
 
         TransportListener* transportListener;
 
+        // Runs the racing connect attempts, declared last so that it is destroyed first
+        // and any attempt still in progress finishes before the rest of this object goes.
+        Pointer<ThreadPoolExecutor> raceExecutor;
+        Pointer<RaceTransportListener> raceListener;
+
         FailoverTransportImpl(FailoverTransport* parent) :
             closed(false),
             connected(false),
@@ -144,6 +228,9 @@ namespace failover {
             rebalanceUpdateURIs(true),
             priorityBackup(false),
             backupsEnabled(false),
+            latencyAware(false),
+            reconnectRace(false),
+            reconnectRaceSize(3),
             shutdown(false),
             doRebalance(false),
             connectedToPrioirty(false),
@@ -154,6 +241,7 @@ namespace failover {
             uris(new URIPool()),
             priorityUris(new URIPool()),
             updated(new URIPool()),
+            latencyTracker(new URILatencyTracker()),
             connectedTransportURI(),
             connectedTransport(),
             connectionFailure(),
@@ -162,7 +250,9 @@ namespace failover {
             taskRunner(new CompositeTaskRunner()),
             disposedListener(),
             myTransportListener(new FailoverTransportListener(parent)),
-            transportListener(NULL) {
+            transportListener(NULL),
+            raceExecutor(),
+            raceListener() {
 
             this->backups.reset(
                 new BackupTransportPool(parent, taskRunner, closeTask, uris, updated, priorityUris));
@@ -186,6 +276,31 @@ namespace failover {
             return uris;
         }
 
+        void setLatencyAware(bool value) {
+            Pointer<URILatencyTracker> tracker;
+            if (value) {
+                tracker = latencyTracker;
+            }
+
+            latencyAware = value;
+            uris->setLatencyTracker(tracker);
+            updated->setLatencyTracker(tracker);
+        }
+
+        Executor& getRaceExecutor() {
+            if (raceExecutor == NULL) {
+                raceExecutor.reset(
+                    new ThreadPoolExecutor(reconnectRaceSize, reconnectRaceSize, 30, TimeUnit::SECONDS,
+                        new LinkedBlockingQueue<Runnable*>()));
+                raceExecutor->allowCoreThreadTimeout(true);
+            } else if (raceExecutor->getMaximumPoolSize() < reconnectRaceSize) {
+                raceExecutor->setMaximumPoolSize(reconnectRaceSize);
+                raceExecutor->setCorePoolSize(reconnectRaceSize);
+            }
+
+            return *raceExecutor;
+        }
+
         void doDelay() {
             if (reconnectDelay > 0) {
                 synchronized (&sleepMutex) {
@@ -283,6 +398,150 @@ namespace failover {
         }
     };
 
+    class ConnectRace {
+    private:
+
+        ConnectRace(const ConnectRace&);
+        ConnectRace& operator= (const ConnectRace&);
+
+    public:
+
+        Mutex mutex;
+        int pending;
+        bool decided;
+        Pointer<Transport> winner;
+        Pointer<RaceTransportListener> winnerListener;
+        URI winnerUri;
+        Pointer<Exception> failure;
+        Pointer<URILatencyTracker> latencyTracker;
+
+        ConnectRace(Pointer<URILatencyTracker> latencyTracker) : mutex(),
+                                                                 pending(0),
+                                                                 decided(false),
+                                                                 winner(),
+                                                                 winnerListener(),
+                                                                 winnerUri(),
+                                                                 failure(),
+                                                                 latencyTracker(latencyTracker) {
+        }
+
+        void onConnected(Pointer<Transport> transport, Pointer<RaceTransportListener> listener,
+                         const URI& uri, long long latency) {
+
+            if (latencyTracker != NULL) {
+                latencyTracker->recordLatency(uri, latency);
+            }
+
+            bool lost = true;
+
+            synchronized(&mutex) {
+                pending--;
+                if (!decided) {
+                    decided = true;
+                    lost = false;
+                    winner = transport;
+                    winnerListener = listener;
+                    winnerUri = uri;
+                }
+                mutex.notifyAll();
+            }
+
+            if (lost) {
+                discard(transport);
+            }
+        }
+
+        void onFailed(Pointer<Transport> transport, const URI& uri, const Exception& error) {
+
+            if (latencyTracker != NULL) {
+                latencyTracker->recordFailure(uri);
+            }
+
+            synchronized(&mutex) {
+                pending--;
+                if (failure == NULL) {
+                    failure.reset(error.clone());
+                }
+                mutex.notifyAll();
+            }
+
+            discard(transport);
+        }
+
+        // Waits until an attempt wins or all of them have failed, anything that
+        // completes after this returns is discarded.
+        Pointer<Transport> await(URI& uri, Pointer<RaceTransportListener>& listener) {
+            Pointer<Transport> result;
+
+            synchronized(&mutex) {
+                while (!decided && pending > 0) {
+                    mutex.wait();
+                }
+
+                decided = true;
+                result = winner;
+                listener = winnerListener;
+                uri = winnerUri;
+            }
+
+            return result;
+        }
+
+    private:
+
+        // Called on the attempt's own executor thread, which is not the reconnect task
+        // and holds no locks, so the transport is closed right away.  The failover task
+        // runner may already be shut down at this point so it can't be used for this.
+        void discard(Pointer<Transport> transport) {
+            try {
+                transport->close();
+            } catch (...) {
+            }
+        }
+    };
+
+    class RaceConnectTask : public Runnable {
+    private:
+
+        Pointer<ConnectRace> race;
+        Pointer<Transport> transport;
+        Pointer<RaceTransportListener> listener;
+        URI uri;
+
+    private:
+
+        RaceConnectTask(const RaceConnectTask&);
+        RaceConnectTask& operator= (const RaceConnectTask&);
+
+    public:
+
+        RaceConnectTask(Pointer<ConnectRace> race, Pointer<Transport> transport,
+                        Pointer<RaceTransportListener> listener, const URI& uri) :
+            Runnable(), race(race), transport(transport), listener(listener), uri(uri) {
+        }
+
+        virtual ~RaceConnectTask() {}
+
+        virtual void run() {
+
+            long long start = System::currentTimeMillis();
+
+            try {
+                transport->start();
+
+                // Can only be sent once the WireFormatInfo exchange is done, so a
+                // winner is a transport that has completed its handshake.
+                transport->oneway(Pointer<Command>(new KeepAliveInfo()));
+
+                race->onConnected(transport, listener, uri, System::currentTimeMillis() - start);
+            } catch (Exception& ex) {
+                race->onFailed(transport, uri, ex);
+            } catch (...) {
+                race->onFailed(transport, uri, IOException(__FILE__, __LINE__, "Failed to connect to the Broker."));
+            }
+        }
+    };
+
     const int FailoverTransportImpl::DEFAULT_INITIAL_RECONNECT_DELAY = 10;
     const int FailoverTransportImpl::INFINITE_WAIT = -1;
 
@@ -644,6 +903,14 @@ void FailoverTransport::close() {
 
         this->impl->taskRunner->shutdown(TimeUnit::MINUTES.toMillis(5));
 
+        if (this->impl->raceExecutor != NULL) {
+            // Attempts still in flight close their transports themselves when they finish.
+            this->impl->raceExecutor->shutdown();
+            this->impl->raceExecutor->awaitTermination(5, TimeUnit::MINUTES);
+        }
+
+        this->impl->raceListener.reset(NULL);
+
         if (transportToStop != NULL) {
             transportToStop->close();
         }
@@ -733,6 +1000,10 @@ void FailoverTransport::handleTransportFailure(const decaf::lang::Exception& err
             bool reconnectOk = this->impl->canReconnect();
             URI failedUri = *this->impl->connectedTransportURI;
 
+            if (this->impl->latencyAware) {
+                this->impl->latencyTracker->recordFailure(failedUri);
+            }
+
             this->impl->initialized = false;
             this->impl->uris->addURI(failedUri);
             this->impl->connectedTransportURI.reset(NULL);
@@ -940,7 +1211,23 @@ bool FailoverTransport::iterate() {
                 }
 
                 while ((transport != NULL || !connectList->isEmpty()) && this->impl->connectedTransport == NULL && !this->impl->closed) {
+
+                    // Backups were already measured when the pool connected them.
+                    bool measure = this->impl->latencyAware && transport == NULL;
+                    bool raced = false;
+                    long long connectStart = System::currentTimeMillis();
+
                     try {
+                        if (transport == NULL && this->impl->reconnectRace) {
+                            // Racing attempts measure themselves.
+                            measure = false;
+                            transport = raceConnect(connectList, failures, uri, failure);
+                            if (transport == NULL) {
+                                continue;
+                            }
+                            raced = true;
+                        }
+
                         // We could be starting the loop with a backup already.
                         if (transport == NULL) {
                             try {
@@ -952,8 +1239,25 @@ bool FailoverTransport::iterate() {
                             transport = createTransport(uri);
                         }
 
+                        if (raced) {
+                            // Deliver whatever the broker sent while the race was decided
+                            // before the transport talks to our listener directly.
+                            this->impl->raceListener->handOff(this->impl->myTransportListener.get());
+                        }
+
                         transport->setTransportListener(this->impl->myTransportListener.get());
-                        transport->start();
+                        if (!raced) {
+                            transport->start();
+                        }
+
+                        if (measure) {
+                            // Wait out the WireFormatInfo exchange with a KeepAliveInfo and
+                            // stop the clock there, restoring state below depends on how much
+                            // the connection holds and says nothing about the broker.
+                            transport->oneway(Pointer<Command>(new KeepAliveInfo()));
+                            this->impl->latencyTracker->recordLatency(
+                                uri, System::currentTimeMillis() - connectStart);
+                        }
 
                         if (this->impl->started && !this->impl->firstConnection) {
                             restoreTransport(transport);
@@ -1019,6 +1323,10 @@ bool FailoverTransport::iterate() {
                             transport.reset(NULL);
                         }
 
+                        if (this->impl->latencyAware) {
+                            this->impl->latencyTracker->recordFailure(uri);
+                        }
+
                         failures.add(uri);
                         failure.reset(e.clone());
                     }
@@ -1054,6 +1362,83 @@ bool FailoverTransport::iterate() {
     return !this->impl->closed;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+Pointer<Transport> FailoverTransport::raceConnect(const Pointer<URIPool> pool, List<URI>& failures,
+                                                  URI& connectedUri, Pointer<Exception>& failure) {
+
+    Pointer<URILatencyTracker> tracker;
+    if (this->impl->latencyAware) {
+        tracker = this->impl->latencyTracker;
+    }
+
+    Pointer<ConnectRace> race(new ConnectRace(tracker));
+    LinkedList<URI> candidates;
+
+    while (candidates.size() < this->impl->reconnectRaceSize) {
+
+        URI uri;
+        try {
+            uri = pool->getURI();
+        } catch (NoSuchElementException& ex) {
+            break;
+        }
+
+        candidates.add(uri);
+
+        Pointer<Transport> transport;
+        Pointer<RaceTransportListener> listener(new RaceTransportListener());
+        try {
+            transport = createTransport(uri);
+            transport->setTransportListener(listener.get());
+        } catch (Exception& ex) {
+            if (tracker != NULL) {
+                tracker->recordFailure(uri);
+            }
+            failure.reset(ex.clone());
+            continue;
+        }
+
+        synchronized(&race->mutex) {
+            race->pending++;
+        }
+
+        try {
+            this->impl->getRaceExecutor().execute(new RaceConnectTask(race, transport, listener, uri));
+        } catch (Exception& ex) {
+            race->onFailed(transport, uri, ex);
+        }
+    }
+
+    Pointer<RaceTransportListener> winnerListener;
+    Pointer<Transport> winner = race->await(connectedUri, winnerListener);
+
+    // The winner keeps calling into its race listener until our own listener is
+    // installed, so it has to live as long as the connected transport does.
+    if (winner != NULL) {
+        this->impl->raceListener = winnerListener;
+    }
+
+    // Everything but the winner goes back to the pool, attempts that are still
+    // running are closed by the race when they complete.
+    std::auto_ptr<Iterator<URI> > iter(candidates.iterator());
+    while (iter->hasNext()) {
+        URI uri = iter->next();
+        if (winner == NULL || !uri.equals(connectedUri)) {
+            failures.add(uri);
+        }
+    }
+
+    if (winner == NULL) {
+        synchronized(&race->mutex) {
+            if (race->failure != NULL) {
+                failure = race->failure;
+            }
+        }
+    }
+
+    return winner;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<Transport> FailoverTransport::createTransport(const URI& location) const {
 
@@ -1341,6 +1726,60 @@ void FailoverTransport::setPriorityBackup(bool priorityBackup) {
     this->impl->priorityBackup = priorityBackup;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool FailoverTransport::isLatencyAware() const {
+    return this->impl->latencyAware;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::setLatencyAware(bool value) {
+    this->impl->setLatencyAware(value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long FailoverTransport::getLatencyDecayTime() const {
+    return this->impl->latencyTracker->getDecayTime();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::setLatencyDecayTime(long long value) {
+    this->impl->latencyTracker->setDecayTime(value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long FailoverTransport::getLatencyFailurePenalty() const {
+    return this->impl->latencyTracker->getFailurePenalty();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::setLatencyFailurePenalty(long long value) {
+    this->impl->latencyTracker->setFailurePenalty(value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool FailoverTransport::isReconnectRace() const {
+    return this->impl->reconnectRace;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::setReconnectRace(bool value) {
+    this->impl->reconnectRace = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int FailoverTransport::getReconnectRaceSize() const {
+    return this->impl->reconnectRaceSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransport::setReconnectRaceSize(int value) {
+    if (value < 1) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Reconnect race size must be at least one.");
+    }
+
+    this->impl->reconnectRaceSize = value;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool FailoverTransport::isConnectedToPriority() const {
     return this->impl->connectedToPrioirty;
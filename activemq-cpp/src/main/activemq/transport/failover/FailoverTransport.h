@@ -43,6 +43,7 @@ namespace failover {
 
     class FailoverTransportListener;
     class BackupTransportPool;
+    class URIPool;
     class FailoverTransportImpl;
 
     class AMQCPP_API FailoverTransport : public CompositeTransport,
@@ -236,6 +237,60 @@ namespace failover {
 
         const decaf::util::List<decaf::net::URI>& getPriorityURIs() const;
 
+        bool isLatencyAware() const;
+
+        /**
+         * Sets whether reconnects prefer the broker with the lowest measured connect
+         * and handshake latency.  When enabled every connect, including those made by
+         * the backup pool, is timed and the URI pools select the best scoring URI while
+         * URIs that were never measured are tried first.  Failures add a penalty and
+         * all scores decay over time so slow or failed brokers are probed again later.
+         *
+         * @param value
+         *      true to select brokers by latency.
+         *
+         * @since 3.10
+         */
+        void setLatencyAware(bool value);
+
+        long long getLatencyDecayTime() const;
+
+        void setLatencyDecayTime(long long value);
+
+        long long getLatencyFailurePenalty() const;
+
+        void setLatencyFailurePenalty(long long value);
+
+        bool isReconnectRace() const;
+
+        /**
+         * Sets whether a reconnect races several brokers at once.  When enabled the
+         * connect and handshake to the next reconnectRaceSize candidate URIs run in
+         * parallel, the first to complete is used and the others are closed, so the
+         * time to fail over is no longer the sum of the connect timeouts of every
+         * broker that is down.  Backups, when available, are still used first.
+         *
+         * @param value
+         *      true to race reconnect attempts.
+         *
+         * @since 3.10
+         */
+        void setReconnectRace(bool value);
+
+        int getReconnectRaceSize() const;
+
+        /**
+         * Sets how many candidate URIs a racing reconnect attempts at once.
+         *
+         * @param value
+         *      The number of concurrent attempts, must be at least one.
+         *
+         * @throws IllegalArgumentException if the value is less than one.
+         *
+         * @since 3.10
+         */
+        void setReconnectRaceSize(int value);
+
         void setConnectionInterruptProcessingComplete(const Pointer<commands::ConnectionId> connectionId);
 
         bool isConnectedToPriority() const;
@@ -282,6 +337,27 @@ namespace failover {
          */
         Pointer<Transport> createTransport(const decaf::net::URI& location) const;
 
+        /**
+         * Starts connect attempts to several URIs taken from the given pool at once and
+         * returns the first Transport to complete its handshake.  All URIs other than
+         * the winner's are added to the failures list so they can be returned to the pool.
+         *
+         * @param pool
+         *      The pool of URIs to take candidates from.
+         * @param failures
+         *      List that receives the URIs that did not win.
+         * @param connectedUri
+         *      Set to the URI of the winning Transport.
+         * @param failure
+         *      Set to the error of a failed attempt when no attempt succeeds.
+         *
+         * @return the connected Transport or NULL if every attempt failed.
+         */
+        Pointer<Transport> raceConnect(const Pointer<URIPool> pool,
+                                       decaf::util::List<decaf::net::URI>& failures,
+                                       decaf::net::URI& connectedUri,
+                                       Pointer<decaf::lang::Exception>& failure);
+
         void processNewTransports(bool rebalance, std::string newTransports);
 
         void processResponse(const Pointer<Response> response);
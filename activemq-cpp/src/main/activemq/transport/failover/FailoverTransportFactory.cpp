@@ -108,6 +108,16 @@ Pointer<Transport> FailoverTransportFactory::doCreateComposite(const decaf::net:
         transport->setPriorityBackup(
             Boolean::parseBoolean(topLvlProperties.getProperty("priorityBackup", "false")));
         transport->setPriorityURIs(topLvlProperties.getProperty("priorityURIs", ""));
+        transport->setLatencyAware(
+            Boolean::parseBoolean(topLvlProperties.getProperty("latencyAware", "false")));
+        transport->setLatencyDecayTime(
+            Long::parseLong(topLvlProperties.getProperty("latencyDecayTime", "60000")));
+        transport->setLatencyFailurePenalty(
+            Long::parseLong(topLvlProperties.getProperty("latencyFailurePenalty", "5000")));
+        transport->setReconnectRace(
+            Boolean::parseBoolean(topLvlProperties.getProperty("reconnectRace", "false")));
+        transport->setReconnectRaceSize(
+            Integer::parseInt(topLvlProperties.getProperty("reconnectRaceSize", "3")));
 
         transport->addURI(false, data.getComponents());
 
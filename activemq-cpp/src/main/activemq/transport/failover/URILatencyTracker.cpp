@@ -0,0 +1,224 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "URILatencyTracker.h"
+
+#include <memory>
+
+#include <activemq/exceptions/ActiveMQException.h>
+
+#include <decaf/lang/Math.h>
+#include <decaf/lang/System.h>
+#include <decaf/util/StlMap.h>
+
+using namespace activemq;
+using namespace activemq::transport;
+using namespace activemq::transport::failover;
+using namespace decaf;
+using namespace decaf::net;
+using namespace decaf::util;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+const long long URILatencyTracker::DEFAULT_DECAY_TIME = 60000;
+const long long URILatencyTracker::DEFAULT_FAILURE_PENALTY = 5000;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace transport {
+namespace failover {
+
+    class LatencyScore {
+    public:
+
+        double value;
+        long long timestamp;
+
+        LatencyScore() : value(0), timestamp(0) {
+        }
+
+        LatencyScore(double value, long long timestamp) : value(value), timestamp(timestamp) {
+        }
+
+        bool operator==(const LatencyScore& other) const {
+            return value == other.value && timestamp == other.timestamp;
+        }
+    };
+
+    class URILatencyTrackerImpl {
+    private:
+
+        URILatencyTrackerImpl(const URILatencyTrackerImpl&);
+        URILatencyTrackerImpl& operator= (const URILatencyTrackerImpl&);
+
+    public:
+
+        // Weight given to a new measurement when folding it into the running average.
+        static const double SMOOTHING_FACTOR;
+
+        StlMap<std::string, LatencyScore> scores;
+        volatile long long decayTime;
+        volatile long long failurePenalty;
+
+        URILatencyTrackerImpl() : scores(),
+                                  decayTime(URILatencyTracker::DEFAULT_DECAY_TIME),
+                                  failurePenalty(URILatencyTracker::DEFAULT_FAILURE_PENALTY) {
+        }
+
+        double decayed(const LatencyScore& score, long long now) const {
+            long long age = now - score.timestamp;
+            if (decayTime <= 0 || age <= 0) {
+                return score.value;
+            }
+
+            return score.value * Math::pow(0.5, (double) age / (double) decayTime);
+        }
+
+        // Caller must hold the scores lock.
+        double currentScore(const std::string& key, long long now) const {
+            if (!scores.containsKey(key)) {
+                return 0;
+            }
+
+            return decayed(scores.get(key), now);
+        }
+    };
+
+    const double URILatencyTrackerImpl::SMOOTHING_FACTOR = 0.3;
+
+}}}
+
+////////////////////////////////////////////////////////////////////////////////
+URILatencyTracker::URILatencyTracker() : impl(new URILatencyTrackerImpl) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+URILatencyTracker::~URILatencyTracker() {
+    try {
+        delete this->impl;
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void URILatencyTracker::recordLatency(const URI& uri, long long latency) {
+
+    if (latency < 0) {
+        latency = 0;
+    }
+
+    long long now = System::currentTimeMillis();
+    std::string key = uri.toString();
+
+    synchronized(&this->impl->scores) {
+        double value = (double) latency;
+
+        if (this->impl->scores.containsKey(key)) {
+            double previous = this->impl->decayed(this->impl->scores.get(key), now);
+            value = previous + URILatencyTrackerImpl::SMOOTHING_FACTOR * (value - previous);
+        }
+
+        this->impl->scores.put(key, LatencyScore(value, now));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void URILatencyTracker::recordFailure(const URI& uri) {
+
+    long long now = System::currentTimeMillis();
+    std::string key = uri.toString();
+
+    synchronized(&this->impl->scores) {
+        double value = this->impl->currentScore(key, now) + (double) this->impl->failurePenalty;
+        this->impl->scores.put(key, LatencyScore(value, now));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+double URILatencyTracker::getScore(const URI& uri) const {
+
+    double result = 0;
+    long long now = System::currentTimeMillis();
+
+    synchronized(&this->impl->scores) {
+        result = this->impl->currentScore(uri.toString(), now);
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool URILatencyTracker::isScored(const URI& uri) const {
+
+    bool result = false;
+
+    synchronized(&this->impl->scores) {
+        result = this->impl->scores.containsKey(uri.toString());
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int URILatencyTracker::selectBest(const List<URI>& uris) const {
+
+    int result = -1;
+    double best = 0;
+    long long now = System::currentTimeMillis();
+
+    synchronized(&this->impl->scores) {
+        std::auto_ptr<Iterator<URI> > iter(uris.iterator());
+
+        for (int index = 0; iter->hasNext(); ++index) {
+            double score = this->impl->currentScore(iter->next().toString(), now);
+
+            if (result == -1 || score < best) {
+                result = index;
+                best = score;
+            }
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void URILatencyTracker::clear() {
+    synchronized(&this->impl->scores) {
+        this->impl->scores.clear();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void URILatencyTracker::setDecayTime(long long value) {
+    this->impl->decayTime = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long URILatencyTracker::getDecayTime() const {
+    return this->impl->decayTime;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void URILatencyTracker::setFailurePenalty(long long value) {
+    this->impl->failurePenalty = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long URILatencyTracker::getFailurePenalty() const {
+    return this->impl->failurePenalty;
+}
@@ -0,0 +1,149 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_TRANSPORT_FAILOVER_URILATENCYTRACKER_H_
+#define _ACTIVEMQ_TRANSPORT_FAILOVER_URILATENCYTRACKER_H_
+
+#include <activemq/util/Config.h>
+
+#include <decaf/net/URI.h>
+#include <decaf/util/List.h>
+
+namespace activemq {
+namespace transport {
+namespace failover {
+
+    class URILatencyTrackerImpl;
+
+    /**
+     * Keeps a latency score for each broker URI that the Failover Transport has
+     * connected to.  A score is a smoothed average of the measured connect and
+     * WireFormatInfo handshake times, failed attempts add a fixed penalty, and the
+     * score decays toward zero as it ages so that a broker which was once slow or
+     * down is eventually probed again.  URIs that have never been measured score
+     * zero and are therefore tried before any measured URI.
+     *
+     * @since 3.10
+     */
+    class AMQCPP_API URILatencyTracker {
+    private:
+
+        URILatencyTrackerImpl* impl;
+
+    private:
+
+        URILatencyTracker(const URILatencyTracker&);
+        URILatencyTracker& operator= (const URILatencyTracker&);
+
+    public:
+
+        /**
+         * The default time in milliseconds it takes a score to decay to half its value.
+         */
+        static const long long DEFAULT_DECAY_TIME;
+
+        /**
+         * The default penalty in milliseconds applied to a URI for each failed attempt.
+         */
+        static const long long DEFAULT_FAILURE_PENALTY;
+
+    public:
+
+        URILatencyTracker();
+
+        virtual ~URILatencyTracker();
+
+        /**
+         * Records a successful connect to the given URI that took the given time.
+         *
+         * @param uri
+         *      The URI that was connected to.
+         * @param latency
+         *      The time in milliseconds the connect and handshake took.
+         */
+        void recordLatency(const decaf::net::URI& uri, long long latency);
+
+        /**
+         * Records a failed attempt to connect to the given URI.
+         *
+         * @param uri
+         *      The URI whose connect attempt failed.
+         */
+        void recordFailure(const decaf::net::URI& uri);
+
+        /**
+         * Gets the current score of the given URI, lower is better.
+         *
+         * @param uri
+         *      The URI whose score is requested.
+         *
+         * @return the decayed score or zero if the URI has never been measured.
+         */
+        double getScore(const decaf::net::URI& uri) const;
+
+        /**
+         * @return true if the given URI has been measured at least once.
+         */
+        bool isScored(const decaf::net::URI& uri) const;
+
+        /**
+         * Returns the index of the best scoring URI in the given list.  When more than
+         * one URI shares the best score the first of them is returned.
+         *
+         * @param uris
+         *      The candidate URIs.
+         *
+         * @return the index of the best candidate or -1 if the list is empty.
+         */
+        int selectBest(const decaf::util::List<decaf::net::URI>& uris) const;
+
+        /**
+         * Forget all recorded scores.
+         */
+        void clear();
+
+        /**
+         * Sets the time in milliseconds it takes a score to decay to half its value.
+         *
+         * @param value
+         *      The decay half-life in milliseconds, values less than one disable decay.
+         */
+        void setDecayTime(long long value);
+
+        /**
+         * @return the time in milliseconds it takes a score to decay to half its value.
+         */
+        long long getDecayTime() const;
+
+        /**
+         * Sets the penalty in milliseconds added to a URI's score for each failed attempt.
+         *
+         * @param value
+         *      The failure penalty in milliseconds.
+         */
+        void setFailurePenalty(long long value);
+
+        /**
+         * @return the penalty in milliseconds added to a URI's score for each failed attempt.
+         */
+        long long getFailurePenalty() const;
+
+    };
+
+}}}
+
+#endif /* _ACTIVEMQ_TRANSPORT_FAILOVER_URILATENCYTRACKER_H_ */
@@ -18,6 +18,7 @@
 #include "URIPool.h"
 
 #include <memory>
+#include <decaf/util/ArrayList.h>
 #include <decaf/util/Random.h>
 #include <decaf/lang/System.h>
 
@@ -31,11 +32,11 @@ using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
 
 ////////////////////////////////////////////////////////////////////////////////
-URIPool::URIPool() : uriPool(), priorityURI(), randomize(false) {
+URIPool::URIPool() : uriPool(), priorityURI(), randomize(false), latencyTracker() {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-URIPool::URIPool(const decaf::util::List<URI>& uris) : uriPool(), priorityURI(), randomize(false) {
+URIPool::URIPool(const decaf::util::List<URI>& uris) : uriPool(), priorityURI(), randomize(false), latencyTracker() {
     this->uriPool.copy(uris);
 
     if (!this->uriPool.isEmpty()) {
@@ -44,7 +45,7 @@ URIPool::URIPool(const decaf::util::List<URI>& uris) : uriPool(), priorityURI(),
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-URIPool::URIPool(const URIPool& uris) : uriPool(), priorityURI(), randomize(false) {
+URIPool::URIPool(const URIPool& uris) : uriPool(), priorityURI(), randomize(false), latencyTracker() {
     synchronized(&uris.uriPool) {
         this->uriPool.copy(uris.uriPool);
     }
@@ -79,7 +80,9 @@ URI URIPool::getURI() {
 
             int index = 0; // Take the first one in the list unless random is on.
 
-            if (isRandomize()) {
+            if (this->latencyTracker != NULL) {
+                index = selectByLatency();
+            } else if (isRandomize()) {
                 Random rand;
                 rand.setSeed(decaf::lang::System::currentTimeMillis());
                 index = rand.nextInt((int) uriPool.size());
@@ -92,6 +95,31 @@ URI URIPool::getURI() {
     throw NoSuchElementException(__FILE__, __LINE__, "URI Pool is currently empty.");
 }
 
+////////////////////////////////////////////////////////////////////////////////
+int URIPool::selectByLatency() const {
+
+    int index = this->latencyTracker->selectBest(uriPool);
+
+    if (isRandomize()) {
+        double best = this->latencyTracker->getScore(uriPool.get(index));
+
+        ArrayList<int> ties;
+        for (int i = 0; i < uriPool.size(); ++i) {
+            if (this->latencyTracker->getScore(uriPool.get(i)) <= best) {
+                ties.add(i);
+            }
+        }
+
+        if (ties.size() > 1) {
+            Random rand;
+            rand.setSeed(decaf::lang::System::currentTimeMillis());
+            index = ties.get(rand.nextInt(ties.size()));
+        }
+    }
+
+    return index;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool URIPool::addURI(const URI& uri) {
 
@@ -19,7 +19,9 @@
 #define _ACTIVEMQ_TRANSPORT_FAILOVER_URIPOOL_H_
 
 #include <activemq/util/Config.h>
+#include <activemq/transport/failover/URILatencyTracker.h>
 
+#include <decaf/lang/Pointer.h>
 #include <decaf/net/URI.h>
 #include <decaf/util/LinkedList.h>
 #include <decaf/util/NoSuchElementException.h>
@@ -34,6 +36,7 @@ namespace failover {
         mutable decaf::util::LinkedList<decaf::net::URI> uriPool;
         decaf::net::URI priorityURI;
         bool randomize;
+        decaf::lang::Pointer<URILatencyTracker> latencyTracker;
 
     public:
 
@@ -102,6 +105,8 @@ namespace failover {
         /**
          * Fetches the next available URI from the pool, if there are no more
          * URIs free when this method is called it throws a NoSuchElementException.
+         * When a latency tracker is assigned the URI with the best score is taken,
+         * randomize then only decides between URIs that share the best score.
          * Receiving the exception is not an indication that a URI won't be available
          * in the future, the caller should react accordingly.
          *
@@ -162,6 +167,30 @@ namespace failover {
             this->randomize = value;
         }
 
+        /**
+         * Gets the latency tracker used to pick URIs from this pool, if any.
+         *
+         * @return the assigned latency tracker or NULL if none is assigned.
+         *
+         * @since 3.10
+         */
+        decaf::lang::Pointer<URILatencyTracker> getLatencyTracker() const {
+            return this->latencyTracker;
+        }
+
+        /**
+         * Sets the latency tracker whose scores decide which URI is taken from the
+         * pool next, a NULL tracker restores the ordered or random selection.
+         *
+         * @param tracker
+         *      The latency tracker to use, or NULL.
+         *
+         * @since 3.10
+         */
+        void setLatencyTracker(const decaf::lang::Pointer<URILatencyTracker> tracker) {
+            this->latencyTracker = tracker;
+        }
+
         /**
          * Returns true if the given URI is contained in this set of URIs.
          *
@@ -189,6 +218,11 @@ namespace failover {
          */
         bool equals(const URIPool& other) const;
 
+    private:
+
+        // Caller must hold the pool lock and the pool must not be empty.
+        int selectByLatency() const;
+
     };
 
 }}}
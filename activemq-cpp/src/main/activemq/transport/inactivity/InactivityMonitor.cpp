@@ -36,6 +36,7 @@
 using namespace std;
 using namespace activemq;
 using namespace activemq::commands;
+using namespace activemq::util;
 using namespace activemq::threads;
 using namespace activemq::transport;
 using namespace activemq::transport::inactivity;
@@ -426,11 +427,15 @@ void InactivityMonitor::startMonitorThreads() {
         return;
     }
 
-    if (this->members->localWireFormatInfo == NULL) {
+    if (this->members->remoteWireFormatInfo == NULL) {
         return;
     }
 
-    if (this->members->remoteWireFormatInfo == NULL) {
+    // Without a negotiator nothing is sent from this end, the WireFormat hands up the
+    // agreed read and write intervals instead (STOMP heart-beats).
+    bool negotiated = this->members->wireFormat->hasNegotiator();
+
+    if (negotiated && this->members->localWireFormatInfo == NULL) {
         return;
     }
 
@@ -444,21 +449,36 @@ void InactivityMonitor::startMonitorThreads() {
         this->members->asyncTasks->addTask(this->members->asyncWriteTask.get());
         this->members->asyncTasks->start();
 
-        this->members->readCheckTime = Math::min(this->members->localWireFormatInfo->getMaxInactivityDuration(),
-                this->members->remoteWireFormatInfo->getMaxInactivityDuration());
+        if (negotiated) {
+            this->members->readCheckTime = Math::min(this->members->localWireFormatInfo->getMaxInactivityDuration(),
+                    this->members->remoteWireFormatInfo->getMaxInactivityDuration());
 
-        this->members->initialDelayTime = Math::min(this->members->localWireFormatInfo->getMaxInactivityDurationInitalDelay(),
-                this->members->remoteWireFormatInfo->getMaxInactivityDurationInitalDelay());
+            this->members->initialDelayTime = Math::min(this->members->localWireFormatInfo->getMaxInactivityDurationInitalDelay(),
+                    this->members->remoteWireFormatInfo->getMaxInactivityDurationInitalDelay());
 
-        if (this->members->readCheckTime > 0) {
+            this->members->writeCheckTime = this->members->readCheckTime > 3 ? this->members->readCheckTime / 3 : this->members->readCheckTime;
+        } else {
+            // The two directions are agreed separately, a zero interval leaves that check off.
+            const PrimitiveMap& agreed = this->members->remoteWireFormatInfo->getProperties();
+
+            this->members->readCheckTime = this->members->remoteWireFormatInfo->getMaxInactivityDuration();
+            this->members->initialDelayTime = this->members->remoteWireFormatInfo->getMaxInactivityDurationInitalDelay();
+            this->members->writeCheckTime = agreed.containsKey("WriteCheckTime") ? agreed.getLong("WriteCheckTime") : 0;
+        }
+
+        if (this->members->readCheckTime > 0 || this->members->writeCheckTime > 0) {
 
             this->members->monitorStarted.set(true);
             this->members->writeCheckerTask.reset(new WriteChecker(this));
             this->members->readCheckerTask.reset(new ReadChecker(this));
-            this->members->writeCheckTime = this->members->readCheckTime > 3 ? this->members->readCheckTime / 3 : this->members->readCheckTime;
 
-            this->members->writeCheckTimer.scheduleAtFixedRate(this->members->writeCheckerTask, this->members->initialDelayTime, this->members->writeCheckTime);
-            this->members->readCheckTimer.scheduleAtFixedRate(this->members->readCheckerTask, this->members->initialDelayTime, this->members->readCheckTime);
+            if (this->members->writeCheckTime > 0) {
+                this->members->writeCheckTimer.scheduleAtFixedRate(this->members->writeCheckerTask, this->members->initialDelayTime, this->members->writeCheckTime);
+            }
+
+            if (this->members->readCheckTime > 0) {
+                this->members->readCheckTimer.scheduleAtFixedRate(this->members->readCheckerTask, this->members->initialDelayTime, this->members->readCheckTime);
+            }
         }
     }
 }
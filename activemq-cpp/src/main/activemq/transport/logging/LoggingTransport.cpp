@@ -17,23 +17,247 @@
 
 #include "LoggingTransport.h"
 
+#include <activemq/commands/Message.h>
+#include <activemq/commands/MessageAck.h>
+#include <activemq/commands/MessageDispatch.h>
+#include <activemq/commands/ProducerAck.h>
+#include <activemq/commands/Response.h>
+#include <activemq/commands/ExceptionResponse.h>
+#include <activemq/commands/ActiveMQDestination.h>
+
+#include <decaf/lang/System.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/Long.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/Concurrent.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+
+#include <map>
+#include <sstream>
+
 using namespace std;
 using namespace activemq;
+using namespace activemq::commands;
 using namespace activemq::exceptions;
 using namespace activemq::transport;
 using namespace activemq::transport::logging;
 using namespace decaf::io;
 using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::atomic;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace transport {
+namespace logging {
+
+    class LoggingTransportData {
+    private:
+
+        LoggingTransportData(const LoggingTransportData&);
+        LoggingTransportData& operator= (const LoggingTransportData&);
+
+    public:
+
+        // Upper bound on the number of outstanding requests whose send time is kept.
+        static const std::size_t MAX_PENDING_REQUESTS = 4096;
+
+        volatile int mode;
+        AtomicInteger sampleRate;
+        AtomicInteger maxPerSecond;
+
+        AtomicInteger sampleCounter;
+        AtomicInteger logged;
+        AtomicInteger suppressed;
+
+        Mutex limiterLock;
+        long long windowStart;
+        int windowCount;
+
+        // Send times in nanoseconds of logged requests, keyed by command id.
+        Mutex requestsLock;
+        std::map<int, long long> requests;
+
+    public:
+
+        LoggingTransportData() : mode(LoggingTransport::FULL), sampleRate(1), maxPerSecond(0),
+                                 sampleCounter(), logged(), suppressed(), limiterLock(),
+                                 windowStart(0), windowCount(0), requestsLock(), requests() {
+        }
+
+        // Decides if the next command is logged, a Response that answers a logged request
+        // skips sampling so that the pair shows up together.
+        bool admit(bool correlated) {
+
+            int rate = this->sampleRate.get();
+            if (!correlated && rate > 1 &&
+                (unsigned int) this->sampleCounter.getAndIncrement() % (unsigned int) rate != 0) {
+
+                this->suppressed.incrementAndGet();
+                return false;
+            }
+
+            int limit = this->maxPerSecond.get();
+            if (limit > 0) {
+
+                bool allowed = true;
+                synchronized(&this->limiterLock) {
+                    long long now = System::currentTimeMillis();
+                    if (now - this->windowStart >= 1000) {
+                        this->windowStart = now;
+                        this->windowCount = 0;
+                    }
+
+                    if (this->windowCount < limit) {
+                        this->windowCount++;
+                    } else {
+                        allowed = false;
+                    }
+                }
+
+                if (!allowed) {
+                    this->suppressed.incrementAndGet();
+                    return false;
+                }
+            }
+
+            this->logged.incrementAndGet();
+            return true;
+        }
+
+        void requestSent(int commandId, long long sentAt) {
+            synchronized(&this->requestsLock) {
+                if (this->requests.size() >= MAX_PENDING_REQUESTS) {
+                    this->requests.erase(this->requests.begin());
+                }
+                this->requests[commandId] = sentAt;
+            }
+        }
+
+        bool responseReceived(int correlationId, long long& sentAt) {
+            bool found = false;
+            synchronized(&this->requestsLock) {
+                std::map<int, long long>::iterator iter = this->requests.find(correlationId);
+                if (iter != this->requests.end()) {
+                    sentAt = iter->second;
+                    this->requests.erase(iter);
+                    found = true;
+                }
+            }
+            return found;
+        }
+    };
+
+}}}
 
 ////////////////////////////////////////////////////////////////////////////////
-LoggingTransport::LoggingTransport(const Pointer<Transport> next) : TransportFilter(next) {
+namespace {
+
+    const char* typeName(const Command& command) {
+
+        if (command.isMessage()) {
+            return "Message";
+        } else if (command.isMessageDispatch()) {
+            return "MessageDispatch";
+        } else if (command.isMessageAck()) {
+            return "MessageAck";
+        } else if (command.isResponse()) {
+            return command.getDataStructureType() == ExceptionResponse::ID_EXCEPTIONRESPONSE ?
+                "ExceptionResponse" : "Response";
+        } else if (command.isProducerAck()) {
+            return "ProducerAck";
+        } else if (command.isMessagePull()) {
+            return "MessagePull";
+        } else if (command.isKeepAliveInfo()) {
+            return "KeepAliveInfo";
+        } else if (command.isWireFormatInfo()) {
+            return "WireFormatInfo";
+        } else if (command.isBrokerInfo()) {
+            return "BrokerInfo";
+        } else if (command.isConnectionInfo()) {
+            return "ConnectionInfo";
+        } else if (command.isSessionInfo()) {
+            return "SessionInfo";
+        } else if (command.isConsumerInfo()) {
+            return "ConsumerInfo";
+        } else if (command.isProducerInfo()) {
+            return "ProducerInfo";
+        } else if (command.isDestinationInfo()) {
+            return "DestinationInfo";
+        } else if (command.isTransactionInfo()) {
+            return "TransactionInfo";
+        } else if (command.isRemoveInfo()) {
+            return "RemoveInfo";
+        } else if (command.isRemoveSubscriptionInfo()) {
+            return "RemoveSubscriptionInfo";
+        } else if (command.isConsumerControl()) {
+            return "ConsumerControl";
+        } else if (command.isConnectionControl()) {
+            return "ConnectionControl";
+        } else if (command.isConnectionError()) {
+            return "ConnectionError";
+        } else if (command.isMessageDispatchNotification()) {
+            return "MessageDispatchNotification";
+        } else if (command.isShutdownInfo()) {
+            return "ShutdownInfo";
+        } else if (command.isFlushCommand()) {
+            return "FlushCommand";
+        } else if (command.isReplayCommand()) {
+            return "ReplayCommand";
+        } else if (command.isControlCommand()) {
+            return "ControlCommand";
+        }
+
+        return "Command";
+    }
+
+    void describeDestination(std::ostringstream& stream, const Pointer<ActiveMQDestination>& destination) {
+        if (destination != NULL) {
+            stream << " destination=" << (destination->isTopic() ? "topic://" : "queue://")
+                   << destination->getPhysicalName();
+        }
+    }
+
+    void describeMessage(std::ostringstream& stream, const Message& message) {
+        if (message.getMessageId() != NULL) {
+            stream << " message=" << message.getMessageId()->toString();
+        }
+        describeDestination(stream, message.getDestination());
+        stream << " size=" << message.getSize();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LoggingTransport::LoggingTransport(const Pointer<Transport> next) :
+    TransportFilter(next), config(new LoggingTransportData()) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LoggingTransport::LoggingTransport(const Pointer<Transport> next, const decaf::util::Properties& properties) :
+    TransportFilter(next), config(new LoggingTransportData()) {
+
+    try {
+        this->setLogMode(parseLogMode(properties.getProperty("transport.logMode", "full")));
+        this->setSampleRate(Integer::parseInt(properties.getProperty("transport.logSampleRate", "1")));
+        this->setMaxPerSecond(Integer::parseInt(properties.getProperty("transport.logMaxPerSecond", "0")));
+    } catch (Exception& ex) {
+        delete this->config;
+        ex.setMark(__FILE__, __LINE__);
+        throw;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LoggingTransport::~LoggingTransport() {
+    delete this->config;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void LoggingTransport::onCommand(const Pointer<Command> command) {
 
-    std::cout << "RECV: " << command->toString() << std::endl;
+    this->logCommand("RECV", command);
 
     // Delegate to the base class.
     TransportFilter::onCommand(command);
@@ -44,7 +268,7 @@ void LoggingTransport::oneway(const Pointer<Command> command) {
 
     try {
 
-        std::cout << "SEND: " << command->toString() << std::endl;
+        this->logCommand("SEND", command);
 
         // Delegate to the base class.
         TransportFilter::oneway(command);
@@ -60,7 +284,7 @@ Pointer<Response> LoggingTransport::request(const Pointer<Command> command) {
 
     try {
 
-        std::cout << "SEND: " << command->toString() << std::endl;
+        this->logCommand("SEND", command);
 
         // Delegate to the base class.
         Pointer<Response> response = TransportFilter::request(command);
@@ -78,7 +302,7 @@ Pointer<Response> LoggingTransport::request(const Pointer<Command> command, unsi
 
     try {
 
-        std::cout << "SEND: " << command->toString() << std::endl;
+        this->logCommand("SEND", command);
 
         // Delegate to the base class.
         Pointer<Response> response = TransportFilter::request(command, timeout);
@@ -90,3 +314,154 @@ Pointer<Response> LoggingTransport::request(const Pointer<Command> command, unsi
     AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
     AMQ_CATCHALL_THROW(IOException)
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void LoggingTransport::setLogMode(LogMode mode) {
+    this->config->mode = mode;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LoggingTransport::LogMode LoggingTransport::getLogMode() const {
+    return (LogMode) this->config->mode;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LoggingTransport::setSampleRate(int rate) {
+
+    if (rate <= 0) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Sample rate must be positive: %d", rate);
+    }
+
+    this->config->sampleRate.set(rate);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int LoggingTransport::getSampleRate() const {
+    return this->config->sampleRate.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LoggingTransport::setMaxPerSecond(int maxPerSecond) {
+    this->config->maxPerSecond.set(maxPerSecond > 0 ? maxPerSecond : 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int LoggingTransport::getMaxPerSecond() const {
+    return this->config->maxPerSecond.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long LoggingTransport::getLoggedCount() const {
+    return (unsigned int) this->config->logged.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long LoggingTransport::getSuppressedCount() const {
+    return (unsigned int) this->config->suppressed.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LoggingTransport::LogMode LoggingTransport::parseLogMode(const std::string& name) {
+
+    if (name == "off") {
+        return OFF;
+    } else if (name == "summary") {
+        return SUMMARY;
+    } else if (name == "full") {
+        return FULL;
+    }
+
+    throw IllegalArgumentException(__FILE__, __LINE__, "Unknown log mode: %s", name.c_str());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string LoggingTransport::summarize(const Command& command) {
+
+    std::ostringstream stream;
+
+    stream << typeName(command) << " id=" << command.getCommandId();
+    if (command.isResponseRequired()) {
+        stream << " responseRequired";
+    }
+
+    if (command.isMessage()) {
+        describeMessage(stream, dynamic_cast<const Message&>(command));
+    } else if (command.isMessageDispatch()) {
+        const MessageDispatch& dispatch = dynamic_cast<const MessageDispatch&>(command);
+        if (dispatch.getConsumerId() != NULL) {
+            stream << " consumer=" << dispatch.getConsumerId()->toString();
+        }
+        if (dispatch.getMessage() != NULL) {
+            describeMessage(stream, *dispatch.getMessage());
+        } else {
+            stream << " message=null";
+        }
+        stream << " redeliveries=" << dispatch.getRedeliveryCounter();
+    } else if (command.isMessageAck()) {
+        const MessageAck& ack = dynamic_cast<const MessageAck&>(command);
+        if (ack.getConsumerId() != NULL) {
+            stream << " consumer=" << ack.getConsumerId()->toString();
+        }
+        stream << " ackType=" << (int) ack.getAckType() << " count=" << ack.getMessageCount();
+        if (ack.getLastMessageId() != NULL) {
+            stream << " last=" << ack.getLastMessageId()->toString();
+        }
+    } else if (command.isResponse()) {
+        stream << " correlationId=" << dynamic_cast<const Response&>(command).getCorrelationId();
+    } else if (command.isProducerAck()) {
+        const ProducerAck& ack = dynamic_cast<const ProducerAck&>(command);
+        if (ack.getProducerId() != NULL) {
+            stream << " producer=" << ack.getProducerId()->toString();
+        }
+        stream << " size=" << ack.getSize();
+    }
+
+    return stream.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LoggingTransport::logCommand(const std::string& direction, const Pointer<Command>& command) {
+
+    LogMode mode = (LogMode) this->config->mode;
+
+    if (mode == OFF || command == NULL) {
+        return;
+    }
+
+    if (mode == FULL) {
+        if (this->config->admit(false)) {
+            this->log(direction + ": " + command->toString());
+        }
+        return;
+    }
+
+    long long now = System::nanoTime();
+    long long sentAt = 0;
+    bool correlated = false;
+
+    if (command->isResponse()) {
+        correlated = this->config->responseReceived(
+            dynamic_cast<const Response*>(command.get())->getCorrelationId(), sentAt);
+    }
+
+    if (!this->config->admit(correlated)) {
+        return;
+    }
+
+    std::string line = direction + ": " + summarize(*command);
+
+    if (correlated) {
+        line += " latency=" + Long::toString((now - sentAt) / 1000) + "us";
+    }
+
+    if (command->isResponseRequired()) {
+        this->config->requestSent(command->getCommandId(), now);
+    }
+
+    this->log(line);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LoggingTransport::log(const std::string& line) {
+    std::cout << line << std::endl;
+}
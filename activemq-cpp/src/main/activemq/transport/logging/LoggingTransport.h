@@ -21,6 +21,9 @@
 #include <activemq/util/Config.h>
 #include <activemq/transport/TransportFilter.h>
 #include <decaf/lang/Pointer.h>
+#include <decaf/util/Properties.h>
+
+#include <string>
 
 namespace activemq{
 namespace transport{
@@ -28,19 +31,60 @@ namespace logging{
 
     using decaf::lang::Pointer;
 
+    class LoggingTransportData;
+
     /**
      * A transport filter that logs commands as they are sent/received.
+     *
+     * In FULL mode every command is written out with its complete toString() form, which
+     * includes the message content.  SUMMARY mode writes one compact line per command with
+     * its type, command id, the ids it refers to and message sizes, a Response to a request
+     * that was logged also shows the time since that request was sent.  Logging can be
+     * thinned out by keeping only one in N commands and by capping the number of lines
+     * written per second.  The mode, sample rate and cap can all be changed while the
+     * transport is running, the filter can be found in a running chain with
+     * <code>transport->narrow(typeid(LoggingTransport))</code>.
+     *
+     * The following URI options configure the filter when it is created by a factory:
+     *
+     *   * transport.logMode - off, summary or full, setting it installs the filter.
+     *   * transport.logSampleRate - log one in N commands (defaults to 1).
+     *   * transport.logMaxPerSecond - maximum lines per second, zero for no cap.
      */
     class AMQCPP_API LoggingTransport: public TransportFilter {
+    public:
+
+        enum LogMode {
+            OFF,
+            SUMMARY,
+            FULL
+        };
+
+    private:
+
+        LoggingTransportData* config;
+
+    private:
+
+        LoggingTransport(const LoggingTransport&);
+        LoggingTransport& operator= (const LoggingTransport&);
+
     public:
 
         /**
-         * Constructor.
+         * Constructor, logs every command in FULL mode.
          * @param next - the next Transport in the chain
          */
         LoggingTransport(const Pointer<Transport> next);
 
-        virtual ~LoggingTransport() {}
+        /**
+         * Constructor that reads the logging options from the transport properties.
+         * @param next - the next Transport in the chain
+         * @param properties - the URI options the transport was created with
+         */
+        LoggingTransport(const Pointer<Transport> next, const decaf::util::Properties& properties);
+
+        virtual ~LoggingTransport();
 
     public: // TransportFilter methods.
 
@@ -64,6 +108,81 @@ namespace logging{
          */
         virtual Pointer<Response> request(const Pointer<Command> command, unsigned int timeout);
 
+    public:
+
+        /**
+         * Sets how much of each command is logged, OFF stops logging altogether.
+         * @param mode - the new LogMode
+         */
+        void setLogMode(LogMode mode);
+
+        /**
+         * @return the current LogMode.
+         */
+        LogMode getLogMode() const;
+
+        /**
+         * Sets the one in N rate at which commands are logged.
+         * @param rate - the sample rate, one logs every command.
+         *
+         * @throws IllegalArgumentException if the rate is not positive.
+         */
+        void setSampleRate(int rate);
+
+        /**
+         * @return the one in N rate at which commands are logged.
+         */
+        int getSampleRate() const;
+
+        /**
+         * Sets the maximum number of commands logged in any one second.
+         * @param maxPerSecond - the cap, zero or less removes it.
+         */
+        void setMaxPerSecond(int maxPerSecond);
+
+        /**
+         * @return the maximum number of commands logged in any one second, zero for no cap.
+         */
+        int getMaxPerSecond() const;
+
+        /**
+         * @return the number of commands that were logged.
+         */
+        long long getLoggedCount() const;
+
+        /**
+         * @return the number of commands that were skipped by sampling or the rate cap.
+         */
+        long long getSuppressedCount() const;
+
+        /**
+         * Creates the one line SUMMARY form of a command, without any latency.
+         *
+         * @param command - the command to describe.
+         * @return the summary line.
+         */
+        static std::string summarize(const Command& command);
+
+        /**
+         * Parses a LogMode from its name, off, summary or full.
+         *
+         * @throws IllegalArgumentException if the name is not a known mode.
+         */
+        static LogMode parseLogMode(const std::string& name);
+
+    protected:
+
+        /**
+         * Writes a single line of output, by default to standard out.
+         *
+         * @param line - the line to write, without a trailing newline.
+         */
+        virtual void log(const std::string& line);
+
+    private:
+
+        void logCommand(const std::string& direction, const Pointer<Command>& command);
+
     };
 
 }}}
@@ -51,7 +51,8 @@ MockTransport::MockTransport(const Pointer<WireFormat> wireFormat,
     numSentKeepAlives(0),
     failOnStart(false),
     failOnStop(false),
-    failOnClose(false) {
+    failOnClose(false),
+    startDelay(0) {
 
     this->instance = this;
 
@@ -190,6 +191,10 @@ void MockTransport::start() {
     if (this->failOnStart) {
         throw IOException(__FILE__, __LINE__, "Failed to Start MockTransport.");
     }
+
+    if (this->startDelay > 0) {
+        Thread::sleep(this->startDelay);
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -85,6 +85,8 @@ namespace mock{
         bool failOnStop;
         bool failOnClose;
 
+        long long startDelay;
+
     private:
 
         MockTransport(const MockTransport&);
@@ -312,6 +314,18 @@ namespace mock{
             this->failOnClose = value;
         }
 
+        long long getStartDelay() const {
+            return this->startDelay;
+        }
+
+        /**
+         * Sets a time in milliseconds that start() blocks for, simulating the
+         * connect time to a remote broker.
+         */
+        void setStartDelay(long long value) {
+            this->startDelay = value;
+        }
+
         virtual bool isReconnectSupported() const {
             return false;
         }
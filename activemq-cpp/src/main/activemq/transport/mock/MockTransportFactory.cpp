@@ -26,6 +26,7 @@
 
 #include <decaf/lang/Boolean.h>
 #include <decaf/lang/Integer.h>
+#include <decaf/lang/Long.h>
 #include <decaf/io/IOException.h>
 
 using namespace activemq;
@@ -57,9 +58,10 @@ Pointer<Transport> MockTransportFactory::create(const decaf::net::URI& location)
         transport.reset(new ResponseCorrelator(transport));
 
         // If command tracing was enabled, wrap the transport with a logging transport.
-        if (properties.getProperty("transport.commandTracingEnabled", "false") == "true") {
-            // Create the Transport for response correlator
-            transport.reset(new LoggingTransport(transport));
+        if (properties.getProperty("transport.commandTracingEnabled", "false") == "true" ||
+            properties.hasProperty("transport.logMode")) {
+
+            transport.reset(new LoggingTransport(transport, properties));
         }
 
         return transport;
@@ -123,6 +125,8 @@ Pointer<Transport> MockTransportFactory::doCreateComposite(const decaf::net::URI
         transport->setNumSentKeepAlivesBeforeFail(
             Integer::parseInt(properties.getProperty("numSentKeepAlivesBeforeFail", "0")));
         transport->setName(properties.getProperty("name", ""));
+        transport->setStartDelay(
+            Long::parseLong(properties.getProperty("startDelay", "0")));
 
         return transport;
     }
@@ -63,9 +63,10 @@ Pointer<Transport> SslTransportFactory::doCreateComposite(const decaf::net::URI&
         }
 
         // If command tracing was enabled, wrap the transport with a logging transport.
-        if (properties.getProperty("transport.commandTracingEnabled", "false") == "true") {
-            // Create the Transport for response correlator
-            transport.reset(new LoggingTransport(transport));
+        if (properties.getProperty("transport.commandTracingEnabled", "false") == "true" ||
+            properties.hasProperty("transport.logMode")) {
+
+            transport.reset(new LoggingTransport(transport, properties));
         }
 
         // If there is a negotiator need then we create and wrap here.
@@ -48,6 +48,11 @@ Pointer<Transport> TcpTransportFactory::create(const decaf::net::URI& location)
 
         Properties properties = activemq::util::URISupport::parseQuery(location.getQuery());
 
+        // Unless told otherwise the WireFormat names the host it connects to (STOMP).
+        if (!properties.hasProperty("wireFormat.host")) {
+            properties.setProperty("wireFormat.host", location.getHost());
+        }
+
         Pointer<WireFormat> wireFormat = this->createWireFormat(properties);
 
         // Create the initial Composite Transport, then wrap it in the normal Filters
@@ -70,6 +75,11 @@ Pointer<Transport> TcpTransportFactory::createComposite(const decaf::net::URI& l
 
         Properties properties = activemq::util::URISupport::parseQuery(location.getQuery());
 
+        // Unless told otherwise the WireFormat names the host it connects to (STOMP).
+        if (!properties.hasProperty("wireFormat.host")) {
+            properties.setProperty("wireFormat.host", location.getHost());
+        }
+
         Pointer<WireFormat> wireFormat = this->createWireFormat(properties);
 
         // Create the initial Transport, then wrap it in the normal Filters
@@ -101,12 +111,14 @@ Pointer<Transport> TcpTransportFactory::doCreateComposite(const decaf::net::URI&
 
         // If command tracing was enabled, wrap the transport with a logging transport.
         // We support the old CMS value, the ActiveMQ trace value and the NMS useLogging
-        // value in order to be more friendly.
+        // value in order to be more friendly.  Setting a log mode installs the filter
+        // even when it is off so that it can be switched on later.
         if (properties.getProperty("transport.commandTracingEnabled", "false") == "true" ||
             properties.getProperty("transport.useLogging", "false") == "true" ||
-            properties.getProperty("transport.trace", "false") == "true") {
+            properties.getProperty("transport.trace", "false") == "true" ||
+            properties.hasProperty("transport.logMode")) {
 
-            transport.reset(new LoggingTransport(transport));
+            transport.reset(new LoggingTransport(transport, properties));
         }
 
         if (wireFormat->hasNegotiator()) {
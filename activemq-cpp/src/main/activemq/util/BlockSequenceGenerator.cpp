@@ -0,0 +1,158 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "BlockSequenceGenerator.h"
+
+#include <decaf/lang/ThreadLocal.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/util/concurrent/Concurrent.h>
+
+using namespace activemq;
+using namespace activemq::util;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+BlockSequenceGeneratorKernel* BlockSequenceGenerator::kernel = NULL;
+const int BlockSequenceGenerator::DEFAULT_BLOCK_SIZE = 64;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // Number of generators whose blocks a thread keeps at the same time, a
+    // generator that is evicted just loses the remainder of its block.
+    const int THREAD_CACHE_SIZE = 16;
+
+    struct SequenceBlock {
+        long long owner;
+        long long next;
+        long long end;
+    };
+
+    struct ThreadSequenceBlocks {
+
+        SequenceBlock blocks[THREAD_CACHE_SIZE];
+
+        ThreadSequenceBlocks() {
+            for (int i = 0; i < THREAD_CACHE_SIZE; ++i) {
+                blocks[i].owner = 0;
+                blocks[i].next = 0;
+                blocks[i].end = 0;
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace util {
+
+    class BlockSequenceGeneratorKernel {
+    private:
+
+        BlockSequenceGeneratorKernel(const BlockSequenceGeneratorKernel&);
+        BlockSequenceGeneratorKernel& operator=(const BlockSequenceGeneratorKernel&);
+
+    public:
+
+        // One thread local slot is shared by every generator, the slots are a
+        // limited resource so they can't be allocated per instance.
+        ThreadLocal<ThreadSequenceBlocks> blocks;
+        long long generatorIds;
+        Mutex mutex;
+
+        BlockSequenceGeneratorKernel() : blocks(), generatorIds(0), mutex() {
+        }
+    };
+
+}}
+
+////////////////////////////////////////////////////////////////////////////////
+BlockSequenceGenerator::BlockSequenceGenerator() :
+    nextBlock(1), blockSize(DEFAULT_BLOCK_SIZE), generatorId(0), mutex() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+BlockSequenceGenerator::BlockSequenceGenerator(int blockSize) :
+    nextBlock(1), blockSize(blockSize), generatorId(0), mutex() {
+
+    if (blockSize < 1) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Block size must be greater than zero.");
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+BlockSequenceGenerator::~BlockSequenceGenerator() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long BlockSequenceGenerator::getNextSequenceId() {
+
+    long long id = this->generatorId;
+
+    if (id != 0 && kernel != NULL) {
+        SequenceBlock& block = kernel->blocks.get().blocks[id & (THREAD_CACHE_SIZE - 1)];
+        if (block.owner == id && block.next < block.end) {
+            return block.next++;
+        }
+    }
+
+    return reserveBlock();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long BlockSequenceGenerator::reserveBlock() {
+
+    synchronized(&this->mutex) {
+
+        // Without the library kernel there's nowhere to keep the blocks so values
+        // are handed out one at a time under the lock.
+        if (kernel == NULL) {
+            return this->nextBlock++;
+        }
+
+        if (this->generatorId == 0) {
+            synchronized(&kernel->mutex) {
+                this->generatorId = ++kernel->generatorIds;
+            }
+        }
+
+        SequenceBlock& block = kernel->blocks.get().blocks[this->generatorId & (THREAD_CACHE_SIZE - 1)];
+        block.owner = this->generatorId;
+        block.next = this->nextBlock;
+        block.end = this->nextBlock + this->blockSize;
+
+        this->nextBlock += this->blockSize;
+
+        return block.next++;
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void BlockSequenceGenerator::initialize() {
+    BlockSequenceGenerator::kernel = new BlockSequenceGeneratorKernel();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void BlockSequenceGenerator::shutdown() {
+    delete BlockSequenceGenerator::kernel;
+    BlockSequenceGenerator::kernel = NULL;
+}
@@ -0,0 +1,106 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_UTIL_BLOCKSEQUENCEGENERATOR_H_
+#define _ACTIVEMQ_UTIL_BLOCKSEQUENCEGENERATOR_H_
+
+#include <activemq/util/Config.h>
+#include <decaf/util/concurrent/Mutex.h>
+
+namespace activemq {
+namespace library {
+    class ActiveMQCPP;
+}
+namespace util {
+
+    class BlockSequenceGeneratorKernel;
+
+    /**
+     * Generates unique long long values for ids that only need to be unique and
+     * not strictly ordered, such as Session, Consumer and Producer Id values or
+     * temporary destination names.
+     *
+     * Each thread reserves a block of values from the shared sequence and then hands
+     * them out without taking any lock until the block is used up, so threads that
+     * create many sessions or temporary destinations don't contend with each other.
+     * Values taken from a single thread are increasing but the values returned to
+     * different threads interleave, use a LongSequenceGenerator when the values must
+     * follow a strict order, for instance message sequence ids.
+     *
+     * @since 3.10.0
+     */
+    class AMQCPP_API BlockSequenceGenerator {
+    private:
+
+        long long nextBlock;
+        int blockSize;
+        volatile long long generatorId;
+        decaf::util::concurrent::Mutex mutex;
+
+        static BlockSequenceGeneratorKernel* kernel;
+
+    private:
+
+        BlockSequenceGenerator(const BlockSequenceGenerator&);
+        BlockSequenceGenerator& operator=(const BlockSequenceGenerator&);
+
+    public:
+
+        static const int DEFAULT_BLOCK_SIZE;
+
+    public:
+
+        BlockSequenceGenerator();
+
+        /**
+         * Creates a new generator that reserves blockSize values at a time for each thread.
+         *
+         * @param blockSize
+         *      The number of values reserved by a thread each time it runs out.
+         *
+         * @throws IllegalArgumentException if the block size is less than one.
+         */
+        BlockSequenceGenerator(int blockSize);
+
+        virtual ~BlockSequenceGenerator();
+
+        /**
+         * @return the next unique id from this generator.
+         */
+        long long getNextSequenceId();
+
+        /**
+         * @return the number of values each thread reserves at a time.
+         */
+        int getBlockSize() const {
+            return this->blockSize;
+        }
+
+    private:
+
+        long long reserveBlock();
+
+        static void initialize();
+        static void shutdown();
+
+        friend class activemq::library::ActiveMQCPP;
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_UTIL_BLOCKSEQUENCEGENERATOR_H_ */
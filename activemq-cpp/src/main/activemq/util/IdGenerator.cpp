@@ -88,12 +88,12 @@ IdGenerator::~IdGenerator() {
 ////////////////////////////////////////////////////////////////////////////////
 std::string IdGenerator::generateId() const {
 
-    std::string result;
-
     if (IdGenerator::kernel == NULL) {
         throw RuntimeException(__FILE__, __LINE__, "Library is not initialized.");
     }
 
+    long long value = 0;
+
     synchronized( &( IdGenerator::kernel->mutex ) ) {
 
         if (seed.empty()) {
@@ -106,9 +106,23 @@ std::string IdGenerator::generateId() const {
             }
         }
 
-        result = this->seed + Long::toString(this->sequence++);
+        value = this->sequence++;
     }
 
+    // The seed never changes once assigned so the id can be formatted outside
+    // the lock, digits are written straight into a local buffer.
+    char digits[24];
+    char* end = digits + sizeof(digits);
+    char* start = end;
+    do {
+        *--start = (char) ('0' + (value % 10));
+        value /= 10;
+    } while (value > 0);
+
+    std::string result;
+    result.reserve(this->seed.length() + (end - start));
+    result.append(this->seed).append(start, end);
+
     return result;
 }
 
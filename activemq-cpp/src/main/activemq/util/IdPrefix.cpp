@@ -0,0 +1,67 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "IdPrefix.h"
+
+#include <decaf/lang/Long.h>
+#include <decaf/util/HashCode.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::util;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+IdPrefix::IdPrefix(const std::string& connectionId, long long sessionId) :
+    text(), connectionIdLength(connectionId.length()), sessionId(sessionId), hashCode(0) {
+
+    std::string session = Long::toString(sessionId);
+
+    this->text.reserve(connectionId.length() + session.length() + 1);
+    this->text.append(connectionId).append(1, ':').append(session);
+
+    this->hashCode = 31 * HashCode<std::string>()(connectionId) + HashCode<long long>()(sessionId);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+IdPrefix::~IdPrefix() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool IdPrefix::matches(const std::string& connectionId, long long sessionId) const {
+    return this->sessionId == sessionId && this->connectionIdLength == connectionId.length() &&
+           this->text.compare(0, this->connectionIdLength, connectionId) == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string IdPrefix::formatKey(long long value) const {
+
+    std::string id = Long::toString(value);
+
+    std::string result;
+    result.reserve(this->text.length() + id.length() + 1);
+    result.append(this->text).append(1, ':').append(id);
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int IdPrefix::hashKey(long long value) const {
+    return 31 * this->hashCode + HashCode<long long>()(value);
+}
@@ -0,0 +1,97 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_UTIL_IDPREFIX_H_
+#define _ACTIVEMQ_UTIL_IDPREFIX_H_
+
+#include <activemq/util/Config.h>
+
+#include <string>
+
+namespace activemq {
+namespace util {
+
+    /**
+     * The "connectionId:sessionId" prefix shared by a SessionId and the producer and
+     * consumer ids created from it, along with its hash code.  Instances are immutable
+     * and are normally obtained from the IdPrefixTable so that every id of the same
+     * session refers to the same instance.
+     *
+     * @since 3.10
+     */
+    class AMQCPP_API IdPrefix {
+    private:
+
+        std::string text;
+        std::string::size_type connectionIdLength;
+        long long sessionId;
+        int hashCode;
+
+    private:
+
+        IdPrefix(const IdPrefix&);
+        IdPrefix& operator=(const IdPrefix&);
+
+    public:
+
+        /**
+         * Creates the prefix for the given connection and session.
+         *
+         * @param connectionId
+         *      The connection id the session belongs to.
+         * @param sessionId
+         *      The session's value within the connection.
+         */
+        IdPrefix(const std::string& connectionId, long long sessionId);
+
+        virtual ~IdPrefix();
+
+        /**
+         * @return the formatted "connectionId:sessionId" text.
+         */
+        const std::string& getText() const {
+            return this->text;
+        }
+
+        /**
+         * @return the hash code of the connection and session id.
+         */
+        int getHashCode() const {
+            return this->hashCode;
+        }
+
+        /**
+         * @return true if this prefix was created for the given connection and session.
+         */
+        bool matches(const std::string& connectionId, long long sessionId) const;
+
+        /**
+         * @return the key of the id with the given value in this session, the prefix
+         *         followed by a colon and the value.
+         */
+        std::string formatKey(long long value) const;
+
+        /**
+         * @return the hash code of the id with the given value in this session.
+         */
+        int hashKey(long long value) const;
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_UTIL_IDPREFIX_H_ */
@@ -0,0 +1,151 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "IdPrefixTable.h"
+
+#include <decaf/util/concurrent/Concurrent.h>
+#include <decaf/util/concurrent/Mutex.h>
+
+#include <map>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::util;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+IdPrefixTableKernel* IdPrefixTable::kernel = NULL;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int STRIPE_COUNT = 16;
+
+    // Prefixes a stripe holds before it is emptied, connections are long lived so
+    // this is only reached by applications that churn through many of them.
+    const int MAX_STRIPE_SIZE = 256;
+
+    typedef std::map<long long, Pointer<const IdPrefix> > SessionPrefixes;
+    typedef std::map<std::string, SessionPrefixes> ConnectionPrefixes;
+
+    struct PrefixStripe {
+
+        Mutex mutex;
+        ConnectionPrefixes prefixes;
+        int size;
+
+        PrefixStripe() : mutex(), prefixes(), size(0) {
+        }
+    };
+
+    // Connection ids of the same process differ in their trailing digits so only
+    // the tail is mixed in, hashing the whole id is left to the IdPrefix.
+    int selectStripe(const std::string& connectionId, long long sessionId) {
+
+        unsigned int hash = (unsigned int) sessionId;
+        std::string::size_type start = connectionId.length() > 8 ? connectionId.length() - 8 : 0;
+        for (std::string::size_type i = start; i < connectionId.length(); ++i) {
+            hash = 31 * hash + (unsigned char) connectionId[i];
+        }
+
+        return (int) ((hash ^ (hash >> 16)) & (STRIPE_COUNT - 1));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace util {
+
+    class IdPrefixTableKernel {
+    private:
+
+        IdPrefixTableKernel(const IdPrefixTableKernel&);
+        IdPrefixTableKernel& operator=(const IdPrefixTableKernel&);
+
+    public:
+
+        PrefixStripe stripes[STRIPE_COUNT];
+
+        IdPrefixTableKernel() : stripes() {
+        }
+    };
+
+}}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<const IdPrefix> IdPrefixTable::intern(const std::string& connectionId, long long sessionId) {
+
+    if (kernel == NULL) {
+        return Pointer<const IdPrefix>(new IdPrefix(connectionId, sessionId));
+    }
+
+    PrefixStripe& stripe = kernel->stripes[selectStripe(connectionId, sessionId)];
+
+    synchronized(&stripe.mutex) {
+
+        ConnectionPrefixes::iterator connection = stripe.prefixes.find(connectionId);
+        if (connection != stripe.prefixes.end()) {
+            SessionPrefixes::const_iterator session = connection->second.find(sessionId);
+            if (session != connection->second.end()) {
+                return session->second;
+            }
+        }
+
+        if (stripe.size >= MAX_STRIPE_SIZE) {
+            stripe.prefixes.clear();
+            stripe.size = 0;
+        }
+
+        Pointer<const IdPrefix> prefix(new IdPrefix(connectionId, sessionId));
+        stripe.prefixes[connectionId][sessionId] = prefix;
+        stripe.size++;
+
+        return prefix;
+    }
+
+    return Pointer<const IdPrefix>();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int IdPrefixTable::size() {
+
+    int result = 0;
+
+    if (kernel != NULL) {
+        for (int i = 0; i < STRIPE_COUNT; ++i) {
+            PrefixStripe& stripe = kernel->stripes[i];
+            synchronized(&stripe.mutex) {
+                result += stripe.size;
+            }
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IdPrefixTable::initialize() {
+    IdPrefixTable::kernel = new IdPrefixTableKernel();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IdPrefixTable::shutdown() {
+    delete IdPrefixTable::kernel;
+    IdPrefixTable::kernel = NULL;
+}
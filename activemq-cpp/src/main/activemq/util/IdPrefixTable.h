@@ -0,0 +1,90 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_UTIL_IDPREFIXTABLE_H_
+#define _ACTIVEMQ_UTIL_IDPREFIXTABLE_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/util/IdPrefix.h>
+#include <decaf/lang/Pointer.h>
+
+#include <string>
+
+namespace activemq {
+namespace library {
+    class ActiveMQCPP;
+}
+namespace util {
+
+    class IdPrefixTableKernel;
+
+    /**
+     * Process wide table of interned IdPrefix instances.  Ids of the same session that
+     * are built locally or unmarshaled from the wire share one prefix so their keys and
+     * hash codes are derived from it without formatting or hashing the connection id
+     * again, and two ids holding the same prefix instance are known to belong to the
+     * same session.
+     *
+     * The table is striped by connection and session and a stripe is emptied once it
+     * holds too many prefixes, ids that already hold an evicted prefix keep using it.
+     *
+     * @since 3.10
+     */
+    class AMQCPP_API IdPrefixTable {
+    private:
+
+        static IdPrefixTableKernel* kernel;
+
+    private:
+
+        IdPrefixTable();
+        IdPrefixTable(const IdPrefixTable&);
+        IdPrefixTable& operator=(const IdPrefixTable&);
+
+    public:
+
+        /**
+         * Returns the interned prefix for the given connection and session, creating
+         * it on first use.  When the library has not been initialized a new prefix that
+         * is not shared is returned.
+         *
+         * @param connectionId
+         *      The connection id the session belongs to.
+         * @param sessionId
+         *      The session's value within the connection.
+         *
+         * @return the prefix for the given connection and session.
+         */
+        static decaf::lang::Pointer<const IdPrefix> intern(const std::string& connectionId, long long sessionId);
+
+        /**
+         * @return the number of prefixes currently held by the table.
+         */
+        static int size();
+
+    private:
+
+        static void initialize();
+        static void shutdown();
+
+        friend class activemq::library::ActiveMQCPP;
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_UTIL_IDPREFIXTABLE_H_ */
@@ -0,0 +1,189 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LatencyHistogram.h"
+
+#include <string.h>
+
+using namespace activemq;
+using namespace activemq::util;
+
+////////////////////////////////////////////////////////////////////////////////
+const int LatencyHistogram::SUB_BUCKET_BITS = 4;
+const int LatencyHistogram::SUB_BUCKET_COUNT = 16;
+const int LatencyHistogram::MAX_MAGNITUDE = 40;
+const int LatencyHistogram::BUCKET_COUNT = 608;
+
+////////////////////////////////////////////////////////////////////////////////
+LatencyHistogram::LatencyHistogram() : buckets(new long long[BUCKET_COUNT]), count(0), total(0), min(0), max(0) {
+    memset(this->buckets, 0, sizeof(long long) * BUCKET_COUNT);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LatencyHistogram::LatencyHistogram(const LatencyHistogram& source) :
+    buckets(new long long[BUCKET_COUNT]), count(source.count), total(source.total), min(source.min), max(source.max) {
+
+    memcpy(this->buckets, source.buckets, sizeof(long long) * BUCKET_COUNT);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LatencyHistogram& LatencyHistogram::operator=(const LatencyHistogram& source) {
+
+    if (this != &source) {
+        memcpy(this->buckets, source.buckets, sizeof(long long) * BUCKET_COUNT);
+        this->count = source.count;
+        this->total = source.total;
+        this->min = source.min;
+        this->max = source.max;
+    }
+
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LatencyHistogram::~LatencyHistogram() {
+    delete [] this->buckets;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int LatencyHistogram::indexOf(long long value) {
+
+    if (value < SUB_BUCKET_COUNT) {
+        return (int) value;
+    }
+
+    // Binary search for the position of the highest set bit.
+    int magnitude = 0;
+    for (int shift = 32; shift > 0; shift >>= 1) {
+        if ((value >> (magnitude + shift)) != 0) {
+            magnitude += shift;
+        }
+    }
+
+    if (magnitude > MAX_MAGNITUDE) {
+        return BUCKET_COUNT - 1;
+    }
+
+    int shift = magnitude - SUB_BUCKET_BITS;
+    int subBucket = (int) ((value >> shift) & (SUB_BUCKET_COUNT - 1));
+
+    return SUB_BUCKET_COUNT + shift * SUB_BUCKET_COUNT + subBucket;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long LatencyHistogram::upperBoundOf(int index) {
+
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+
+    int shift = (index - SUB_BUCKET_COUNT) / SUB_BUCKET_COUNT;
+    int subBucket = (index - SUB_BUCKET_COUNT) % SUB_BUCKET_COUNT;
+
+    return (((long long) (SUB_BUCKET_COUNT + subBucket)) << shift) + (1LL << shift) - 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LatencyHistogram::record(long long value) {
+
+    if (value < 0) {
+        value = 0;
+    }
+
+    this->buckets[indexOf(value)]++;
+
+    if (this->count == 0 || value < this->min) {
+        this->min = value;
+    }
+    if (value > this->max) {
+        this->max = value;
+    }
+
+    this->count++;
+    this->total += value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LatencyHistogram::add(const LatencyHistogram& other) {
+
+    if (other.count == 0) {
+        return;
+    }
+
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        this->buckets[i] += other.buckets[i];
+    }
+
+    if (this->count == 0 || other.min < this->min) {
+        this->min = other.min;
+    }
+    if (other.max > this->max) {
+        this->max = other.max;
+    }
+
+    this->count += other.count;
+    this->total += other.total;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LatencyHistogram::reset() {
+    memset(this->buckets, 0, sizeof(long long) * BUCKET_COUNT);
+    this->count = 0;
+    this->total = 0;
+    this->min = 0;
+    this->max = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+double LatencyHistogram::getMean() const {
+
+    if (this->count == 0) {
+        return 0.0;
+    }
+
+    return (double) this->total / (double) this->count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long LatencyHistogram::getValueAtPercentile(double percentile) const {
+
+    if (this->count == 0) {
+        return 0;
+    }
+
+    if (percentile < 0.0) {
+        percentile = 0.0;
+    } else if (percentile > 100.0) {
+        percentile = 100.0;
+    }
+
+    long long target = (long long) ((percentile / 100.0) * (double) this->count + 0.5);
+    if (target < 1) {
+        target = 1;
+    }
+
+    long long seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        seen += this->buckets[i];
+        if (seen >= target && i < BUCKET_COUNT - 1) {
+            long long bound = upperBoundOf(i);
+            return bound < this->max ? bound : this->max;
+        }
+    }
+
+    return this->max;
+}
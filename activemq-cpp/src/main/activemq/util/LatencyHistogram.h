@@ -0,0 +1,137 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_UTIL_LATENCYHISTOGRAM_H_
+#define _ACTIVEMQ_UTIL_LATENCYHISTOGRAM_H_
+
+#include <activemq/util/Config.h>
+
+namespace activemq {
+namespace util {
+
+    /**
+     * A fixed size histogram of non-negative long long samples using log-linear
+     * buckets, each power of two range is split into sixteen equal sub-buckets so
+     * that any recorded value is reported with a relative error of at most 1/16th.
+     * Values that exceed the largest tracked magnitude are counted in the last bucket
+     * and still reflected in the exact maximum.
+     *
+     * This class is not thread safe, callers must provide their own locking.
+     *
+     * @since 3.10
+     */
+    class AMQCPP_API LatencyHistogram {
+    public:
+
+        static const int SUB_BUCKET_BITS;
+        static const int SUB_BUCKET_COUNT;
+        static const int MAX_MAGNITUDE;
+        static const int BUCKET_COUNT;
+
+    private:
+
+        long long* buckets;
+        long long count;
+        long long total;
+        long long min;
+        long long max;
+
+    public:
+
+        LatencyHistogram();
+        LatencyHistogram(const LatencyHistogram& source);
+        LatencyHistogram& operator=(const LatencyHistogram& source);
+
+        virtual ~LatencyHistogram();
+
+        /**
+         * Records a single sample, negative values are recorded as zero.
+         *
+         * @param value
+         *      The sample to record.
+         */
+        void record(long long value);
+
+        /**
+         * Adds all the samples recorded in the given histogram to this one.
+         *
+         * @param other
+         *      The histogram whose samples are added to this one.
+         */
+        void add(const LatencyHistogram& other);
+
+        /**
+         * Discards all recorded samples.
+         */
+        void reset();
+
+        /**
+         * @return the number of samples recorded.
+         */
+        long long getCount() const {
+            return this->count;
+        }
+
+        /**
+         * @return the sum of all samples recorded.
+         */
+        long long getTotal() const {
+            return this->total;
+        }
+
+        /**
+         * @return the smallest sample recorded or zero if there are none.
+         */
+        long long getMin() const {
+            return this->count == 0 ? 0 : this->min;
+        }
+
+        /**
+         * @return the largest sample recorded or zero if there are none.
+         */
+        long long getMax() const {
+            return this->max;
+        }
+
+        /**
+         * @return the mean of all recorded samples or zero if there are none.
+         */
+        double getMean() const;
+
+        /**
+         * Returns the value below which the given percentage of samples fall, the
+         * result is the upper bound of the bucket holding that sample and never
+         * exceeds the largest sample recorded.
+         *
+         * @param percentile
+         *      The percentile to compute in the range [0, 100].
+         *
+         * @return the value at the given percentile or zero if there are no samples.
+         */
+        long long getValueAtPercentile(double percentile) const;
+
+    private:
+
+        static int indexOf(long long value);
+
+        static long long upperBoundOf(int index);
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_UTIL_LATENCYHISTOGRAM_H_ */
@@ -17,19 +17,29 @@
 
 #include "MemoryUsage.h"
 #include <decaf/util/concurrent/Concurrent.h>
+#include <decaf/lang/Integer.h>
 
 using namespace activemq;
 using namespace activemq::util;
+using namespace decaf::lang;
 using namespace decaf::util;
 using namespace decaf::util::concurrent;
 using namespace std;
 
 ////////////////////////////////////////////////////////////////////////////////
-MemoryUsage::MemoryUsage() : limit(0), usage(0), mutex() {
+namespace {
+
+    int clampUsage(unsigned long long value) {
+        return value > (unsigned long long) Integer::MAX_VALUE ? Integer::MAX_VALUE : (int) value;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MemoryUsage::MemoryUsage() : limit(0), usage(), waiters(), mutex() {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-MemoryUsage::MemoryUsage(unsigned long long limit) : limit(limit), usage(), mutex() {
+MemoryUsage::MemoryUsage(unsigned long long limit) : limit(limit), usage(), waiters(), mutex() {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -39,20 +49,42 @@ MemoryUsage::~MemoryUsage() {
 ////////////////////////////////////////////////////////////////////////////////
 void MemoryUsage::waitForSpace() {
 
+    if (!this->isFull()) {
+        return;
+    }
+
     synchronized(&mutex) {
-        while (this->isFull()) {
-            mutex.wait();
+        this->waiters.incrementAndGet();
+        try {
+            while (this->isFull()) {
+                mutex.wait();
+            }
+        } catch (...) {
+            this->waiters.decrementAndGet();
+            throw;
         }
+        this->waiters.decrementAndGet();
     }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void MemoryUsage::waitForSpace(unsigned int timeout) {
 
-    if (this->isFull()) {
-        synchronized(&mutex) {
-            mutex.wait(timeout);
+    if (!this->isFull()) {
+        return;
+    }
+
+    synchronized(&mutex) {
+        this->waiters.incrementAndGet();
+        try {
+            if (this->isFull()) {
+                mutex.wait(timeout);
+            }
+        } catch (...) {
+            this->waiters.decrementAndGet();
+            throw;
         }
+        this->waiters.decrementAndGet();
     }
 }
 
@@ -63,8 +95,14 @@ void MemoryUsage::increaseUsage(unsigned long long value) {
         return;
     }
 
-    synchronized(&mutex) {
-        this->usage += value;
+    int delta = clampUsage(value);
+
+    while (true) {
+        int current = this->usage.get();
+        int update = current > Integer::MAX_VALUE - delta ? Integer::MAX_VALUE : current + delta;
+        if (this->usage.compareAndSet(current, update)) {
+            return;
+        }
     }
 }
 
@@ -75,19 +113,35 @@ void MemoryUsage::decreaseUsage(unsigned long long value) {
         return;
     }
 
-    synchronized(&mutex) {
-        value > this->usage ? this->usage = 0 : this->usage -= value;
-        mutex.notifyAll();
+    while (true) {
+        int current = this->usage.get();
+        int update = value >= (unsigned long long) current ? 0 : current - (int) value;
+        if (this->usage.compareAndSet(current, update)) {
+            break;
+        }
+    }
+
+    // Waiters register under the lock before re-checking isFull, so taking the
+    // lock here whenever one is registered can't miss a wakeup.
+    if (this->waiters.get() > 0) {
+        synchronized(&mutex) {
+            mutex.notifyAll();
+        }
     }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-bool MemoryUsage::isFull() const {
-    bool result = false;
+void MemoryUsage::setUsage(unsigned long long usage) {
+    this->usage.set(clampUsage(usage));
 
-    synchronized(&mutex) {
-        result = this->usage >= this->limit;
+    if (this->waiters.get() > 0) {
+        synchronized(&mutex) {
+            mutex.notifyAll();
+        }
     }
+}
 
-    return result;
+////////////////////////////////////////////////////////////////////////////////
+bool MemoryUsage::isFull() const {
+    return (unsigned long long) this->usage.get() >= this->limit;
 }
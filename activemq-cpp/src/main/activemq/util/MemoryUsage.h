@@ -21,20 +21,30 @@
 #include <activemq/util/Config.h>
 #include <activemq/util/Usage.h>
 #include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
 
 namespace activemq {
 namespace util {
 
+    /**
+     * Tracks memory usage against a fixed limit.  The usage counter is updated
+     * with atomic operations so that checking for space and returning it never
+     * contends on a lock, only threads that block waiting for space use the
+     * internal monitor.
+     */
     class AMQCPP_API MemoryUsage : public Usage {
     private:
 
         // The physical limit of memory usage this object allows.
         unsigned long long limit;
 
-        // Amount of memory currently used in.
-        unsigned long long usage;
+        // Amount of memory currently used in, saturates at Integer::MAX_VALUE.
+        decaf::util::concurrent::atomic::AtomicInteger usage;
 
-        // Mutex to lock usage and wait on.
+        // Number of threads currently blocked waiting for space.
+        decaf::util::concurrent::atomic::AtomicInteger waiters;
+
+        // Mutex that threads waiting for space block on, usage is not guarded by it.
         mutable decaf::util::concurrent::Mutex mutex;
 
     public:
@@ -96,16 +106,14 @@ namespace util {
          * @return the amount of bytes currently used.
          */
         unsigned long long getUsage() const {
-            return usage;
+            return (unsigned long long) usage.get();
         }
 
         /**
          * Sets the current usage amount
          * @param usage - The amount to tag as used.
          */
-        void setUsage(unsigned long long usage) {
-            this->usage = usage;
-        }
+        void setUsage(unsigned long long usage);
 
         /**
          * Gets the current limit amount.
@@ -0,0 +1,314 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MetricsRegistry.h"
+
+#include <activemq/util/LatencyHistogram.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/ThreadLocal.h>
+#include <decaf/util/concurrent/Concurrent.h>
+#include <decaf/util/concurrent/Mutex.h>
+
+#include <vector>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::util;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::atomic;
+
+////////////////////////////////////////////////////////////////////////////////
+MetricsRegistryKernel* MetricsRegistry::kernel = NULL;
+
+const int MetricsRegistry::MAX_STRIPES = 16;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace util {
+
+    class MetricsStripe {
+    private:
+
+        MetricsStripe(const MetricsStripe&);
+        MetricsStripe& operator=(const MetricsStripe&);
+
+    public:
+
+        Mutex mutex;
+        long long counters[MetricsRegistry::COUNTER_COUNT];
+        LatencyHistogram histograms[MetricsRegistry::HISTOGRAM_COUNT];
+
+        MetricsStripe() : mutex(), histograms() {
+            clear();
+        }
+
+        void clear() {
+            for (int i = 0; i < MetricsRegistry::COUNTER_COUNT; ++i) {
+                counters[i] = 0;
+            }
+            for (int i = 0; i < MetricsRegistry::HISTOGRAM_COUNT; ++i) {
+                histograms[i].reset();
+            }
+        }
+    };
+
+    /**
+     * The slot a thread records into, given back to the kernel when the thread
+     * exits and its thread local value is deleted.
+     */
+    struct MetricsThreadSlot {
+
+        MetricsRegistryKernel* kernel;
+        int slot;
+
+        MetricsThreadSlot() : kernel(NULL), slot(-1) {
+        }
+
+        ~MetricsThreadSlot();
+    };
+
+    class MetricsRegistryKernel {
+    private:
+
+        MetricsRegistryKernel(const MetricsRegistryKernel&);
+        MetricsRegistryKernel& operator=(const MetricsRegistryKernel&);
+
+    public:
+
+        Mutex mutex;
+        std::vector<int> freeSlots;
+        int nextSlot;
+
+        // One thread local slot is shared by every registry, the slots are a
+        // limited resource so they can't be allocated per instance.  Declared
+        // last so the values it deletes can still give their slot back.
+        ThreadLocal<MetricsThreadSlot> slots;
+
+        MetricsRegistryKernel() : mutex(), freeSlots(), nextSlot(0), slots() {
+        }
+
+        int currentSlot() {
+            MetricsThreadSlot& current = this->slots.get();
+            if (current.slot < 0) {
+                synchronized(&this->mutex) {
+                    if (this->freeSlots.empty()) {
+                        current.slot = this->nextSlot++;
+                    } else {
+                        current.slot = this->freeSlots.back();
+                        this->freeSlots.pop_back();
+                    }
+                }
+                current.kernel = this;
+            }
+            return current.slot;
+        }
+
+        void releaseSlot(int slot) {
+            synchronized(&this->mutex) {
+                this->freeSlots.push_back(slot);
+            }
+        }
+    };
+
+    MetricsThreadSlot::~MetricsThreadSlot() {
+        try {
+            if (this->kernel != NULL) {
+                this->kernel->releaseSlot(this->slot);
+            }
+        } catch (...) {
+        }
+    }
+
+}}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const char* COUNTER_NAMES[] = {
+        "messagesSent",
+        "bytesSent",
+        "messagesReceived",
+        "bytesReceived",
+        "acksSent",
+        "reconnects",
+        "poolHits",
+        "poolMisses"
+    };
+
+    const char* HISTOGRAM_NAMES[] = {
+        "sendLatencyMicros",
+        "ackLatencyMicros",
+        "listenerTimeMicros",
+        "marshalTimeMicros",
+        "dispatchQueueDepth"
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MetricsRegistry::MetricsRegistry() : stripes(new AtomicReference<MetricsStripe>[MAX_STRIPES]) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MetricsRegistry::~MetricsRegistry() {
+
+    for (int i = 0; i < MAX_STRIPES; ++i) {
+        delete this->stripes[i].get();
+    }
+    delete [] this->stripes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MetricsStripe& MetricsRegistry::currentStripe() {
+
+    // Without the library kernel there are no slots to hand out so the thread
+    // id picks the stripe instead.
+    int slot = 0;
+    if (kernel != NULL) {
+        slot = kernel->currentSlot();
+    } else {
+        slot = (int) (Thread::currentThread()->getId() % MAX_STRIPES);
+    }
+
+    AtomicReference<MetricsStripe>& reference = this->stripes[slot % MAX_STRIPES];
+    MetricsStripe* stripe = reference.get();
+    if (stripe == NULL) {
+        MetricsStripe* created = new MetricsStripe();
+        if (reference.compareAndSet(NULL, created)) {
+            stripe = created;
+        } else {
+            delete created;
+            stripe = reference.get();
+        }
+    }
+
+    return *stripe;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MetricsRegistry::increment(Counter counter, long long delta) {
+
+    if (counter < 0 || counter >= COUNTER_COUNT) {
+        return;
+    }
+
+    MetricsStripe& stripe = currentStripe();
+    synchronized(&stripe.mutex) {
+        stripe.counters[counter] += delta;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MetricsRegistry::record(Histogram histogram, long long value) {
+
+    if (histogram < 0 || histogram >= HISTOGRAM_COUNT) {
+        return;
+    }
+
+    MetricsStripe& stripe = currentStripe();
+    synchronized(&stripe.mutex) {
+        stripe.histograms[histogram].record(value);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MetricsSnapshot MetricsRegistry::snapshot() const {
+
+    std::vector<long long> counters(COUNTER_COUNT, 0);
+    LatencyHistogram histograms[HISTOGRAM_COUNT];
+
+    for (int i = 0; i < MAX_STRIPES; ++i) {
+        MetricsStripe* stripe = this->stripes[i].get();
+        if (stripe != NULL) {
+            synchronized(&stripe->mutex) {
+                for (int j = 0; j < COUNTER_COUNT; ++j) {
+                    counters[j] += stripe->counters[j];
+                }
+                for (int j = 0; j < HISTOGRAM_COUNT; ++j) {
+                    histograms[j].add(stripe->histograms[j]);
+                }
+            }
+        }
+    }
+
+    std::vector<MetricsSnapshot::Summary> summaries;
+    for (int i = 0; i < HISTOGRAM_COUNT; ++i) {
+        summaries.push_back(MetricsSnapshot::Summary(histograms[i]));
+    }
+
+    return MetricsSnapshot(System::currentTimeMillis(), counters, summaries);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MetricsRegistry::reset() {
+
+    for (int i = 0; i < MAX_STRIPES; ++i) {
+        MetricsStripe* stripe = this->stripes[i].get();
+        if (stripe != NULL) {
+            synchronized(&stripe->mutex) {
+                stripe->clear();
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int MetricsRegistry::getStripeCount() const {
+
+    int count = 0;
+    for (int i = 0; i < MAX_STRIPES; ++i) {
+        if (this->stripes[i].get() != NULL) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string MetricsRegistry::getCounterName(int counter) {
+
+    if (counter < 0 || counter >= COUNTER_COUNT) {
+        return "unknown";
+    }
+
+    return COUNTER_NAMES[counter];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string MetricsRegistry::getHistogramName(int histogram) {
+
+    if (histogram < 0 || histogram >= HISTOGRAM_COUNT) {
+        return "unknown";
+    }
+
+    return HISTOGRAM_NAMES[histogram];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MetricsRegistry::initialize() {
+    MetricsRegistry::kernel = new MetricsRegistryKernel();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MetricsRegistry::shutdown() {
+    delete MetricsRegistry::kernel;
+    MetricsRegistry::kernel = NULL;
+}
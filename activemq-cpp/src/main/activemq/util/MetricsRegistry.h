@@ -0,0 +1,152 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_UTIL_METRICSREGISTRY_H_
+#define _ACTIVEMQ_UTIL_METRICSREGISTRY_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/util/MetricsSnapshot.h>
+#include <decaf/util/concurrent/atomic/AtomicReference.h>
+
+#include <string>
+
+namespace activemq {
+namespace library {
+    class ActiveMQCPP;
+}
+namespace util {
+
+    class MetricsStripe;
+    class MetricsRegistryKernel;
+
+    /**
+     * Collects counters and latency histograms for the hot paths of a Connection and
+     * the sessions, producers and consumers it owns.  Each registry has a fixed number of
+     * stripes, a thread records into the stripe picked by a slot it takes from a process
+     * wide free list on first use and gives back when it exits, so threads recording at
+     * the same time rarely contend and a stripe left by an exited thread is reused by the
+     * next one.  The stripes are only combined when a snapshot is requested.
+     *
+     * All latency histograms are recorded in microseconds.
+     *
+     * @since 3.10
+     */
+    class AMQCPP_API MetricsRegistry {
+    public:
+
+        enum Counter {
+            MESSAGES_SENT = 0,
+            BYTES_SENT,
+            MESSAGES_RECEIVED,
+            BYTES_RECEIVED,
+            ACKS_SENT,
+            RECONNECTS,
+            POOL_HITS,
+            POOL_MISSES,
+            COUNTER_COUNT
+        };
+
+        enum Histogram {
+            SEND_LATENCY = 0,
+            ACK_LATENCY,
+            LISTENER_TIME,
+            MARSHAL_TIME,
+            DISPATCH_QUEUE_DEPTH,
+            HISTOGRAM_COUNT
+        };
+
+        /**
+         * The most stripes a registry creates, threads beyond this share them.
+         */
+        static const int MAX_STRIPES;
+
+    private:
+
+        decaf::util::concurrent::atomic::AtomicReference<MetricsStripe>* stripes;
+
+        static MetricsRegistryKernel* kernel;
+
+    private:
+
+        MetricsRegistry(const MetricsRegistry&);
+        MetricsRegistry& operator=(const MetricsRegistry&);
+
+    public:
+
+        MetricsRegistry();
+
+        virtual ~MetricsRegistry();
+
+        /**
+         * Adds the given amount to a counter.
+         *
+         * @param counter
+         *      The counter to update.
+         * @param delta
+         *      The amount to add to the counter.
+         */
+        void increment(Counter counter, long long delta = 1);
+
+        /**
+         * Records a sample in one of the histograms.
+         *
+         * @param histogram
+         *      The histogram to update.
+         * @param value
+         *      The sample to record.
+         */
+        void record(Histogram histogram, long long value);
+
+        /**
+         * @return a snapshot combining the values of all stripes.
+         */
+        MetricsSnapshot snapshot() const;
+
+        /**
+         * Resets all counters and histograms to zero.
+         */
+        void reset();
+
+        /**
+         * @return the number of stripes threads have recorded into so far.
+         */
+        int getStripeCount() const;
+
+        /**
+         * @return the name used for the given counter in snapshot output.
+         */
+        static std::string getCounterName(int counter);
+
+        /**
+         * @return the name used for the given histogram in snapshot output.
+         */
+        static std::string getHistogramName(int histogram);
+
+    private:
+
+        MetricsStripe& currentStripe();
+
+        static void initialize();
+        static void shutdown();
+
+        friend class activemq::library::ActiveMQCPP;
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_UTIL_METRICSREGISTRY_H_ */
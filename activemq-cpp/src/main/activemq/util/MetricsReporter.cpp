@@ -0,0 +1,77 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MetricsReporter.h"
+
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <activemq/exceptions/ActiveMQException.h>
+
+#include <ctype.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::util;
+using namespace activemq::exceptions;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+MetricsReporter::MetricsReporter(Pointer<MetricsRegistry> registry, std::ostream* stream, Format format) :
+    Runnable(), registry(registry), stream(stream), format(format) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MetricsReporter::~MetricsReporter() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MetricsReporter::run() {
+
+    try {
+
+        if (this->registry == NULL || this->stream == NULL) {
+            return;
+        }
+
+        MetricsSnapshot snapshot = this->registry->snapshot();
+
+        if (this->format == JSON) {
+            *this->stream << snapshot.toJSON() << std::endl;
+        } else {
+            *this->stream << snapshot.toText() << std::endl;
+        }
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MetricsReporter::Format MetricsReporter::parseFormat(const std::string& value) {
+
+    std::string lower(value);
+    for (std::string::iterator iter = lower.begin(); iter != lower.end(); ++iter) {
+        *iter = (char) tolower(*iter);
+    }
+
+    if (lower == "text") {
+        return TEXT;
+    } else if (lower == "json") {
+        return JSON;
+    }
+
+    throw IllegalArgumentException(__FILE__, __LINE__, "Unknown metrics report format: %s", value.c_str());
+}
@@ -0,0 +1,91 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_UTIL_METRICSREPORTER_H_
+#define _ACTIVEMQ_UTIL_METRICSREPORTER_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/util/MetricsRegistry.h>
+
+#include <decaf/lang/Pointer.h>
+#include <decaf/lang/Runnable.h>
+
+#include <ostream>
+#include <string>
+
+namespace activemq {
+namespace util {
+
+    /**
+     * A Runnable that writes a snapshot of a MetricsRegistry to an output stream each
+     * time it is run, intended to be scheduled periodically.
+     *
+     * @since 3.10
+     */
+    class AMQCPP_API MetricsReporter : public decaf::lang::Runnable {
+    public:
+
+        enum Format {
+            TEXT,
+            JSON
+        };
+
+    private:
+
+        decaf::lang::Pointer<MetricsRegistry> registry;
+        std::ostream* stream;
+        Format format;
+
+    private:
+
+        MetricsReporter(const MetricsReporter&);
+        MetricsReporter& operator=(const MetricsReporter&);
+
+    public:
+
+        /**
+         * @param registry
+         *      The registry whose snapshots are written.
+         * @param stream
+         *      The stream the snapshots are written to, not owned by this object.
+         * @param format
+         *      The format used to render each snapshot.
+         */
+        MetricsReporter(decaf::lang::Pointer<MetricsRegistry> registry, std::ostream* stream, Format format);
+
+        virtual ~MetricsReporter();
+
+        virtual void run();
+
+        /**
+         * Converts the name of a format, either "text" or "json" in any case, to
+         * its Format value.
+         *
+         * @param value
+         *      The name of the format.
+         *
+         * @return the matching Format.
+         *
+         * @throws IllegalArgumentException if the name does not match a format.
+         */
+        static Format parseFormat(const std::string& value);
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_UTIL_METRICSREPORTER_H_ */
@@ -0,0 +1,140 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MetricsSnapshot.h"
+
+#include <activemq/util/LatencyHistogram.h>
+#include <activemq/util/MetricsRegistry.h>
+
+#include <sstream>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::util;
+
+////////////////////////////////////////////////////////////////////////////////
+MetricsSnapshot::Summary::Summary() : count(0), min(0), max(0), mean(0.0), p50(0), p90(0), p99(0), p999(0) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MetricsSnapshot::Summary::Summary(const LatencyHistogram& histogram) :
+    count(histogram.getCount()),
+    min(histogram.getMin()),
+    max(histogram.getMax()),
+    mean(histogram.getMean()),
+    p50(histogram.getValueAtPercentile(50.0)),
+    p90(histogram.getValueAtPercentile(90.0)),
+    p99(histogram.getValueAtPercentile(99.0)),
+    p999(histogram.getValueAtPercentile(99.9)) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MetricsSnapshot::MetricsSnapshot() : timestamp(0), counters(), histograms() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MetricsSnapshot::MetricsSnapshot(long long timestamp,
+                                 const std::vector<long long>& counters,
+                                 const std::vector<Summary>& histograms) :
+    timestamp(timestamp), counters(counters), histograms(histograms) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MetricsSnapshot::~MetricsSnapshot() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long MetricsSnapshot::getCounter(int counter) const {
+
+    if (counter < 0 || counter >= (int) this->counters.size()) {
+        return 0;
+    }
+
+    return this->counters[counter];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MetricsSnapshot::Summary MetricsSnapshot::getHistogram(int histogram) const {
+
+    if (histogram < 0 || histogram >= (int) this->histograms.size()) {
+        return Summary();
+    }
+
+    return this->histograms[histogram];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string MetricsSnapshot::toText() const {
+
+    std::ostringstream stream;
+    stream << "timestamp=" << this->timestamp;
+
+    for (std::size_t i = 0; i < this->counters.size(); ++i) {
+        stream << " " << MetricsRegistry::getCounterName((int) i) << "=" << this->counters[i];
+    }
+
+    for (std::size_t i = 0; i < this->histograms.size(); ++i) {
+        const Summary& summary = this->histograms[i];
+        stream << " " << MetricsRegistry::getHistogramName((int) i)
+               << "={count=" << summary.count
+               << " min=" << summary.min
+               << " mean=" << summary.mean
+               << " p50=" << summary.p50
+               << " p90=" << summary.p90
+               << " p99=" << summary.p99
+               << " p999=" << summary.p999
+               << " max=" << summary.max << "}";
+    }
+
+    return stream.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string MetricsSnapshot::toJSON() const {
+
+    std::ostringstream stream;
+    stream << "{\"timestamp\":" << this->timestamp << ",\"counters\":{";
+
+    for (std::size_t i = 0; i < this->counters.size(); ++i) {
+        if (i > 0) {
+            stream << ",";
+        }
+        stream << "\"" << MetricsRegistry::getCounterName((int) i) << "\":" << this->counters[i];
+    }
+
+    stream << "},\"histograms\":{";
+
+    for (std::size_t i = 0; i < this->histograms.size(); ++i) {
+        const Summary& summary = this->histograms[i];
+        if (i > 0) {
+            stream << ",";
+        }
+        stream << "\"" << MetricsRegistry::getHistogramName((int) i) << "\":{"
+               << "\"count\":" << summary.count
+               << ",\"min\":" << summary.min
+               << ",\"mean\":" << summary.mean
+               << ",\"p50\":" << summary.p50
+               << ",\"p90\":" << summary.p90
+               << ",\"p99\":" << summary.p99
+               << ",\"p999\":" << summary.p999
+               << ",\"max\":" << summary.max << "}";
+    }
+
+    stream << "}}";
+
+    return stream.str();
+}
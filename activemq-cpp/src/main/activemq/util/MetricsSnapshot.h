@@ -0,0 +1,114 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_UTIL_METRICSSNAPSHOT_H_
+#define _ACTIVEMQ_UTIL_METRICSSNAPSHOT_H_
+
+#include <activemq/util/Config.h>
+
+#include <string>
+#include <vector>
+
+namespace activemq {
+namespace util {
+
+    class LatencyHistogram;
+
+    /**
+     * An immutable point in time copy of the values held in a MetricsRegistry.  Counters
+     * and histograms are indexed using the MetricsRegistry::Counter and
+     * MetricsRegistry::Histogram constants.
+     *
+     * @since 3.10
+     */
+    class AMQCPP_API MetricsSnapshot {
+    public:
+
+        /**
+         * Summary statistics of a single histogram at the time the snapshot was taken.
+         */
+        struct AMQCPP_API Summary {
+
+            long long count;
+            long long min;
+            long long max;
+            double mean;
+            long long p50;
+            long long p90;
+            long long p99;
+            long long p999;
+
+            Summary();
+
+            Summary(const LatencyHistogram& histogram);
+
+        };
+
+    private:
+
+        long long timestamp;
+        std::vector<long long> counters;
+        std::vector<Summary> histograms;
+
+    public:
+
+        MetricsSnapshot();
+
+        MetricsSnapshot(long long timestamp,
+                        const std::vector<long long>& counters,
+                        const std::vector<Summary>& histograms);
+
+        virtual ~MetricsSnapshot();
+
+        /**
+         * @return the time in milliseconds since the epoch when this snapshot was taken.
+         */
+        long long getTimestamp() const {
+            return this->timestamp;
+        }
+
+        /**
+         * @param counter
+         *      One of the MetricsRegistry::Counter constants.
+         *
+         * @return the value of the counter or zero if the index is not valid.
+         */
+        long long getCounter(int counter) const;
+
+        /**
+         * @param histogram
+         *      One of the MetricsRegistry::Histogram constants.
+         *
+         * @return the summary of the histogram, empty if the index is not valid.
+         */
+        Summary getHistogram(int histogram) const;
+
+        /**
+         * @return a single line human readable rendering of this snapshot.
+         */
+        std::string toText() const;
+
+        /**
+         * @return a single line JSON object rendering of this snapshot.
+         */
+        std::string toJSON() const;
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_UTIL_METRICSSNAPSHOT_H_ */
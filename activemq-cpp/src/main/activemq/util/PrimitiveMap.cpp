@@ -17,6 +17,7 @@
 
 #include "PrimitiveMap.h"
 
+#include <algorithm>
 #include <sstream>
 #include <stdio.h>
 #include <string.h>
@@ -32,7 +33,7 @@ using namespace decaf::lang;
 using namespace std;
 
 ////////////////////////////////////////////////////////////////////////////////
-PrimitiveMap::PrimitiveMap() : decaf::util::StlMap<std::string, PrimitiveValueNode>(), converter() {
+PrimitiveMap::PrimitiveMap() : decaf::util::StlMap<std::string, PrimitiveValueNode>(), converter(), internedNodes(), internedSize(0) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -41,12 +42,12 @@ PrimitiveMap::~PrimitiveMap() {
 
 ////////////////////////////////////////////////////////////////////////////////
 PrimitiveMap::PrimitiveMap(const decaf::util::Map<std::string, PrimitiveValueNode>& src) :
-    decaf::util::StlMap<std::string, PrimitiveValueNode>(src), converter() {
+    decaf::util::StlMap<std::string, PrimitiveValueNode>(src), converter(), internedNodes(), internedSize(0) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 PrimitiveMap::PrimitiveMap(const PrimitiveMap& src) :
-    decaf::util::StlMap<std::string, PrimitiveValueNode>(src), converter() {
+    decaf::util::StlMap<std::string, PrimitiveValueNode>(src), converter(), internedNodes(), internedSize(0) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -70,13 +71,13 @@ std::string PrimitiveMap::toString() const {
 
 ////////////////////////////////////////////////////////////////////////////////
 PrimitiveValueNode::PrimitiveType PrimitiveMap::getValueType(const std::string& key) const {
-    PrimitiveValueNode node = this->get(key);
+    const PrimitiveValueNode& node = this->get(key);
     return node.getType();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 bool PrimitiveMap::getBool(const string& key) const {
-    PrimitiveValueNode node = this->get(key);
+    const PrimitiveValueNode& node = this->get(key);
     return converter.convert<bool> (node);
 }
 
@@ -89,7 +90,7 @@ void PrimitiveMap::setBool(const string& key, bool value) {
 
 ////////////////////////////////////////////////////////////////////////////////
 unsigned char PrimitiveMap::getByte(const string& key) const {
-    PrimitiveValueNode node = this->get(key);
+    const PrimitiveValueNode& node = this->get(key);
     return converter.convert<unsigned char> (node);
 }
 
@@ -102,7 +103,7 @@ void PrimitiveMap::setByte(const string& key, unsigned char value) {
 
 ////////////////////////////////////////////////////////////////////////////////
 char PrimitiveMap::getChar(const string& key) const {
-    PrimitiveValueNode node = this->get(key);
+    const PrimitiveValueNode& node = this->get(key);
     return converter.convert<char> (node);
 }
 
@@ -115,7 +116,7 @@ void PrimitiveMap::setChar(const string& key, char value) {
 
 ////////////////////////////////////////////////////////////////////////////////
 short PrimitiveMap::getShort(const string& key) const {
-    PrimitiveValueNode node = this->get(key);
+    const PrimitiveValueNode& node = this->get(key);
     return converter.convert<short> (node);
 }
 
@@ -128,7 +129,7 @@ void PrimitiveMap::setShort(const string& key, short value) {
 
 ////////////////////////////////////////////////////////////////////////////////
 int PrimitiveMap::getInt(const string& key) const {
-    PrimitiveValueNode node = this->get(key);
+    const PrimitiveValueNode& node = this->get(key);
     return converter.convert<int> (node);
 }
 
@@ -141,7 +142,7 @@ void PrimitiveMap::setInt(const string& key, int value) {
 
 ////////////////////////////////////////////////////////////////////////////////
 long long PrimitiveMap::getLong(const string& key) const {
-    PrimitiveValueNode node = this->get(key);
+    const PrimitiveValueNode& node = this->get(key);
     return converter.convert<long long> (node);
 }
 
@@ -154,7 +155,7 @@ void PrimitiveMap::setLong(const string& key, long long value) {
 
 ////////////////////////////////////////////////////////////////////////////////
 double PrimitiveMap::getDouble(const string& key) const {
-    PrimitiveValueNode node = this->get(key);
+    const PrimitiveValueNode& node = this->get(key);
     return converter.convert<double> (node);
 }
 
@@ -167,7 +168,7 @@ void PrimitiveMap::setDouble(const string& key, double value) {
 
 ////////////////////////////////////////////////////////////////////////////////
 float PrimitiveMap::getFloat(const string& key) const {
-    PrimitiveValueNode node = this->get(key);
+    const PrimitiveValueNode& node = this->get(key);
     return converter.convert<float> (node);
 }
 
@@ -180,7 +181,7 @@ void PrimitiveMap::setFloat(const string& key, float value) {
 
 ////////////////////////////////////////////////////////////////////////////////
 string PrimitiveMap::getString(const string& key) const {
-    PrimitiveValueNode node = this->get(key);
+    const PrimitiveValueNode& node = this->get(key);
     return converter.convert<std::string> (node);
 }
 
@@ -188,12 +189,12 @@ string PrimitiveMap::getString(const string& key) const {
 void PrimitiveMap::setString(const string& key, const string& value) {
     PrimitiveValueNode node;
     node.setString(value);
-    this->put(key, node);
+    this->putValue(key, node);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 std::vector<unsigned char> PrimitiveMap::getByteArray(const std::string& key) const {
-    PrimitiveValueNode node = this->get(key);
+    const PrimitiveValueNode& node = this->get(key);
     return converter.convert<std::vector<unsigned char> > (node);
 }
 
@@ -201,5 +202,110 @@ std::vector<unsigned char> PrimitiveMap::getByteArray(const std::string& key) co
 void PrimitiveMap::setByteArray(const std::string& key, const std::vector<unsigned char>& value) {
     PrimitiveValueNode node;
     node.setByteArray(value);
-    this->put(key, node);
+    this->putValue(key, node);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PrimitiveMap::putValue(const std::string& key, PrimitiveValueNode& value) {
+
+    if (!this->containsKey(key)) {
+        this->put(key, PrimitiveValueNode());
+    }
+
+    this->get(key).swap(value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // Caps the index so a very large map doesn't pay for keeping it sorted.
+    const std::size_t MAX_INTERNED_NODES = 64;
+
+    bool compareName(const std::pair<const std::string*, PrimitiveValueNode*>& entry, const std::string* name) {
+        return std::less<const std::string*>()(entry.first, name);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PrimitiveValueNode& PrimitiveMap::getInternedValueNode(const std::string* name) {
+
+    // Iterators of a view taken earlier can still remove entries without the map
+    // seeing it, a change in size since the last insert catches that.
+    if (this->internedSize != this->size()) {
+        this->internedNodes.clear();
+    }
+
+    std::vector< std::pair<const std::string*, PrimitiveValueNode*> >::iterator iter =
+        std::lower_bound(this->internedNodes.begin(), this->internedNodes.end(), name, compareName);
+
+    if (iter != this->internedNodes.end() && iter->first == name) {
+        return *iter->second;
+    }
+
+    if (!this->containsKey(*name)) {
+        StlMap<std::string, PrimitiveValueNode>::put(*name, PrimitiveValueNode());
+    }
+
+    PrimitiveValueNode& node = this->get(*name);
+    if (this->internedNodes.size() < MAX_INTERNED_NODES) {
+        this->internedNodes.insert(iter, std::make_pair(name, &node));
+    }
+    this->internedSize = this->size();
+
+    return node;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PrimitiveMap::clear() {
+    this->internedNodes.clear();
+    StlMap<std::string, PrimitiveValueNode>::clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool PrimitiveMap::put(const std::string& key, const PrimitiveValueNode& value) {
+    this->internedNodes.clear();
+    return StlMap<std::string, PrimitiveValueNode>::put(key, value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool PrimitiveMap::put(const std::string& key, const PrimitiveValueNode& value, PrimitiveValueNode& oldValue) {
+    this->internedNodes.clear();
+    return StlMap<std::string, PrimitiveValueNode>::put(key, value, oldValue);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PrimitiveMap::copy(const StlMap<std::string, PrimitiveValueNode>& source) {
+    this->internedNodes.clear();
+    StlMap<std::string, PrimitiveValueNode>::copy(source);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PrimitiveMap::copy(const Map<std::string, PrimitiveValueNode>& source) {
+    this->internedNodes.clear();
+    StlMap<std::string, PrimitiveValueNode>::copy(source);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PrimitiveValueNode PrimitiveMap::remove(const std::string& key) {
+    this->internedNodes.clear();
+    return StlMap<std::string, PrimitiveValueNode>::remove(key);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Set< MapEntry<std::string, PrimitiveValueNode> >& PrimitiveMap::entrySet() {
+    // The returned view's iterators can remove entries behind the map's back.
+    this->internedNodes.clear();
+    return StlMap<std::string, PrimitiveValueNode>::entrySet();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Set<std::string>& PrimitiveMap::keySet() {
+    this->internedNodes.clear();
+    return StlMap<std::string, PrimitiveValueNode>::keySet();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Collection<PrimitiveValueNode>& PrimitiveMap::values() {
+    this->internedNodes.clear();
+    return StlMap<std::string, PrimitiveValueNode>::values();
 }
@@ -19,6 +19,7 @@
 #define _ACTIVEMQ_UTIL_PRIMITIVEMAP_H_
 
 #include <string>
+#include <utility>
 #include <vector>
 #include <activemq/util/Config.h>
 #include <decaf/util/Config.h>
@@ -38,8 +39,18 @@ namespace util {
 
         PrimitiveValueConverter converter;
 
+        // Nodes of the entries added under interned names, sorted by the address of
+        // the name, and the map size they were recorded at.  Dropped whenever an entry
+        // may have been removed from the map.
+        std::vector< std::pair<const std::string*, PrimitiveValueNode*> > internedNodes;
+        int internedSize;
+
     public:
 
+        using decaf::util::StlMap<std::string, PrimitiveValueNode>::entrySet;
+        using decaf::util::StlMap<std::string, PrimitiveValueNode>::keySet;
+        using decaf::util::StlMap<std::string, PrimitiveValueNode>::values;
+
         /**
          * Default Constructor, creates an empty map.
          */
@@ -287,6 +298,49 @@ namespace util {
          */
         virtual void setByteArray(const std::string& key, const std::vector<unsigned char>& value);
 
+        /**
+         * Stores the value under the given key by swapping it into the map's own node
+         * rather than copying it, the given node is left holding the old value if any.
+         *
+         * @param key - the key to store the value under.
+         * @param value - the value to move into the map.
+         */
+        void putValue(const std::string& key, PrimitiveValueNode& value);
+
+        /**
+         * Returns the node stored under a name interned by PropertyNameTable, adding an
+         * empty node if the map has no entry for it.  Interned names are matched by
+         * their address so a name this method has already seen is found without any
+         * string compare.
+         *
+         * @param name - an interned name returned from PropertyNameTable.
+         *
+         * @return reference to the node stored under the name.
+         *
+         * @since 3.10
+         */
+        PrimitiveValueNode& getInternedValueNode(const std::string* name);
+
+    public:
+
+        virtual void clear();
+
+        virtual bool put(const std::string& key, const PrimitiveValueNode& value);
+
+        virtual bool put(const std::string& key, const PrimitiveValueNode& value, PrimitiveValueNode& oldValue);
+
+        virtual void copy(const decaf::util::StlMap<std::string, PrimitiveValueNode>& source);
+
+        virtual void copy(const decaf::util::Map<std::string, PrimitiveValueNode>& source);
+
+        virtual PrimitiveValueNode remove(const std::string& key);
+
+        virtual decaf::util::Set< decaf::util::MapEntry<std::string, PrimitiveValueNode> >& entrySet();
+
+        virtual decaf::util::Set<std::string>& keySet();
+
+        virtual decaf::util::Collection<PrimitiveValueNode>& values();
+
     };
 
 }}
@@ -23,6 +23,8 @@
 #include <decaf/util/StlMap.h>
 #include <decaf/util/LinkedList.h>
 
+#include <new>
+
 #ifdef HAVE_STRING_H
 #include <string.h>
 #endif
@@ -35,89 +37,136 @@ using namespace activemq;
 using namespace activemq::util;
 
 ////////////////////////////////////////////////////////////////////////////////
-PrimitiveValueNode::PrimitiveValueNode() : valueType(NULL_TYPE), value() {
+namespace {
+
+    typedef std::string String;
+    typedef std::vector<unsigned char> ByteArray;
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PrimitiveValueNode::PrimitiveValueNode() : valueType(NULL_TYPE), value(), storage() {
     memset(&value, 0, sizeof(value));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-PrimitiveValueNode::PrimitiveValueNode(bool value) : valueType(NULL_TYPE), value() {
+PrimitiveValueNode::PrimitiveValueNode(bool value) : valueType(NULL_TYPE), value(), storage() {
     this->setBool(value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-PrimitiveValueNode::PrimitiveValueNode(unsigned char value) : valueType(NULL_TYPE), value() {
+PrimitiveValueNode::PrimitiveValueNode(unsigned char value) : valueType(NULL_TYPE), value(), storage() {
     this->setByte(value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-PrimitiveValueNode::PrimitiveValueNode(char value) : valueType(NULL_TYPE), value() {
+PrimitiveValueNode::PrimitiveValueNode(char value) : valueType(NULL_TYPE), value(), storage() {
     this->setChar(value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-PrimitiveValueNode::PrimitiveValueNode(short value) : valueType(NULL_TYPE), value() {
+PrimitiveValueNode::PrimitiveValueNode(short value) : valueType(NULL_TYPE), value(), storage() {
     this->setShort(value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-PrimitiveValueNode::PrimitiveValueNode(int value) : valueType(NULL_TYPE), value() {
+PrimitiveValueNode::PrimitiveValueNode(int value) : valueType(NULL_TYPE), value(), storage() {
     this->setInt(value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-PrimitiveValueNode::PrimitiveValueNode(long long value) : valueType(NULL_TYPE), value() {
+PrimitiveValueNode::PrimitiveValueNode(long long value) : valueType(NULL_TYPE), value(), storage() {
     this->setLong(value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-PrimitiveValueNode::PrimitiveValueNode(float value) : valueType(NULL_TYPE), value() {
+PrimitiveValueNode::PrimitiveValueNode(float value) : valueType(NULL_TYPE), value(), storage() {
     this->setFloat(value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-PrimitiveValueNode::PrimitiveValueNode(double value) : valueType(NULL_TYPE), value() {
+PrimitiveValueNode::PrimitiveValueNode(double value) : valueType(NULL_TYPE), value(), storage() {
     this->setDouble(value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-PrimitiveValueNode::PrimitiveValueNode(const char* value) : valueType(NULL_TYPE), value() {
+PrimitiveValueNode::PrimitiveValueNode(const char* value) : valueType(NULL_TYPE), value(), storage() {
     if (value != NULL) {
         this->setString(string(value));
     }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-PrimitiveValueNode::PrimitiveValueNode(const std::string& value) : valueType(NULL_TYPE), value() {
+PrimitiveValueNode::PrimitiveValueNode(const std::string& value) : valueType(NULL_TYPE), value(), storage() {
     this->setString(value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-PrimitiveValueNode::PrimitiveValueNode(const std::vector<unsigned char>& value) : valueType(NULL_TYPE), value() {
+PrimitiveValueNode::PrimitiveValueNode(const std::vector<unsigned char>& value) : valueType(NULL_TYPE), value(), storage() {
     this->setByteArray(value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-PrimitiveValueNode::PrimitiveValueNode(const decaf::util::List<PrimitiveValueNode>& value) : valueType(NULL_TYPE), value() {
+PrimitiveValueNode::PrimitiveValueNode(const decaf::util::List<PrimitiveValueNode>& value) : valueType(NULL_TYPE), value(), storage() {
     this->setList(value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-PrimitiveValueNode::PrimitiveValueNode(const decaf::util::Map<std::string, PrimitiveValueNode>& value) : valueType(NULL_TYPE), value() {
+PrimitiveValueNode::PrimitiveValueNode(const decaf::util::Map<std::string, PrimitiveValueNode>& value) : valueType(NULL_TYPE), value(), storage() {
     this->setMap(value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-PrimitiveValueNode::PrimitiveValueNode(const PrimitiveValueNode& node) : valueType(NULL_TYPE), value() {
+PrimitiveValueNode::PrimitiveValueNode(const PrimitiveValueNode& node) : valueType(NULL_TYPE), value(), storage() {
     (*this) = node;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 PrimitiveValueNode& PrimitiveValueNode::operator =(const PrimitiveValueNode& node) {
-    clear();
-    this->setValue(node.getValue(), node.getType());
+    if (this != &node) {
+        clear();
+        this->setValue(node.getValue(), node.getType());
+    }
     return *this;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void PrimitiveValueNode::swap(PrimitiveValueNode& node) {
+
+    if (this == &node) {
+        return;
+    }
+
+    PrimitiveValueNode temp;
+    temp.takeValue(*this);
+    this->takeValue(node);
+    node.takeValue(temp);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PrimitiveValueNode::takeValue(PrimitiveValueNode& node) {
+
+    clear();
+
+    if (node.valueType == STRING_TYPE && node.value.stringValue != NULL) {
+        value.stringValue = new (storage.stringData) String();
+        value.stringValue->swap(*node.value.stringValue);
+        valueType = STRING_TYPE;
+        node.clear();
+    } else if (node.valueType == BYTE_ARRAY_TYPE && node.value.byteArrayValue != NULL) {
+        value.byteArrayValue = new (storage.byteArrayData) ByteArray();
+        value.byteArrayValue->swap(*node.value.byteArrayValue);
+        valueType = BYTE_ARRAY_TYPE;
+        node.clear();
+    } else {
+        // Scalars are copied and lists and maps change owner with their pointer.
+        valueType = node.valueType;
+        value = node.value;
+        node.valueType = NULL_TYPE;
+        memset(&node.value, 0, sizeof(node.value));
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool PrimitiveValueNode::operator==(const PrimitiveValueNode& node) const {
 
@@ -158,9 +207,9 @@ bool PrimitiveValueNode::operator==(const PrimitiveValueNode& node) const {
 void PrimitiveValueNode::clear() {
 
     if (valueType == STRING_TYPE && value.stringValue != NULL) {
-        delete value.stringValue;
+        value.stringValue->~String();
     } else if (valueType == BYTE_ARRAY_TYPE && value.byteArrayValue != NULL) {
-        delete value.byteArrayValue;
+        value.byteArrayValue->~ByteArray();
     } else if (valueType == LIST_TYPE && value.listValue != NULL) {
         delete value.listValue;
     } else if (valueType == MAP_TYPE && value.mapValue != NULL) {
@@ -341,9 +390,16 @@ float PrimitiveValueNode::getFloat() const {
 
 ////////////////////////////////////////////////////////////////////////////////
 void PrimitiveValueNode::setString(const std::string& lvalue) {
+
+    if (valueType == STRING_TYPE && value.stringValue != NULL) {
+        // Reuses the existing buffer, and is safe when given our own value.
+        value.stringValue->assign(lvalue);
+        return;
+    }
+
     clear();
+    value.stringValue = new (storage.stringData) String(lvalue);
     valueType = STRING_TYPE;
-    value.stringValue = new std::string(lvalue);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -362,9 +418,15 @@ std::string PrimitiveValueNode::getString() const {
 
 ////////////////////////////////////////////////////////////////////////////////
 void PrimitiveValueNode::setByteArray(const std::vector<unsigned char>& lvalue) {
+
+    if (valueType == BYTE_ARRAY_TYPE && value.byteArrayValue != NULL) {
+        *value.byteArrayValue = lvalue;
+        return;
+    }
+
     clear();
+    value.byteArrayValue = new (storage.byteArrayData) ByteArray(lvalue);
     valueType = BYTE_ARRAY_TYPE;
-    value.byteArrayValue = new std::vector<unsigned char>(lvalue);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
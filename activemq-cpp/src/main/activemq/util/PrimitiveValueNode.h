@@ -23,6 +23,9 @@
 #include <decaf/util/Map.h>
 #include <decaf/util/List.h>
 
+#include <string>
+#include <vector>
+
 namespace activemq {
 namespace util {
 
@@ -78,10 +81,28 @@ namespace util {
 
         };
 
+    private:
+
+        /**
+         * Room to construct a string or byte array in place, so storing one costs no
+         * allocation of its own and short strings don't allocate at all.  The value
+         * union points into this storage so getValue() works the same for every type.
+         */
+        union InlineStorage {
+
+            char stringData[sizeof(std::string)];
+            char byteArrayData[sizeof(std::vector<unsigned char>)];
+            void* pointerAlignment;
+            long long longAlignment;
+            double doubleAlignment;
+
+        };
+
     private:
 
         PrimitiveType valueType;
         PrimitiveValue value;
+        InlineStorage storage;
 
     public:
 
@@ -187,6 +208,15 @@ namespace util {
          */
         PrimitiveValueNode& operator =(const PrimitiveValueNode& node);
 
+        /**
+         * Exchanges the values held by this node and the given one without copying
+         * any strings, byte arrays, lists or maps.
+         *
+         * @param node
+         *      The node whose value is exchanged with this one.
+         */
+        void swap(PrimitiveValueNode& node);
+
         /**
          * Comparison Operator, compares this node to the other node.
          * @return true if the values are the same false otherwise.
@@ -424,6 +454,10 @@ namespace util {
          */
         std::string toString() const;
 
+    private:
+
+        void takeValue(PrimitiveValueNode& node);
+
     };
 
 }}
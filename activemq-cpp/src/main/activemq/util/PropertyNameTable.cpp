@@ -0,0 +1,198 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PropertyNameTable.h"
+
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/atomic/AtomicReference.h>
+
+using namespace activemq;
+using namespace activemq::util;
+using namespace decaf;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::atomic;
+
+////////////////////////////////////////////////////////////////////////////////
+PropertyNameTableKernel* PropertyNameTable::kernel = NULL;
+
+const int PropertyNameTable::MAX_NAMES = 4096;
+const int PropertyNameTable::MAX_NAME_LENGTH = 256;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace util {
+
+    /**
+     * Fixed size hash table whose chains only ever grow at the head.  An entry is
+     * fully built before it is published to its bucket and is never changed or freed
+     * until the table is destroyed, so readers walk the chains without a lock while
+     * writers serialize on the mutex.
+     */
+    class PropertyNameTableKernel {
+    private:
+
+        static const int BUCKETS = 1024;
+
+        struct Entry {
+            unsigned int hash;
+            std::string name;
+            Entry* next;
+
+            Entry(unsigned int hash, const char* name, std::size_t length, Entry* next) :
+                hash(hash), name(name, length), next(next) {
+            }
+        };
+
+        AtomicReference<Entry>* buckets;
+        volatile int count;
+
+    public:
+
+        Mutex mutex;
+
+    private:
+
+        PropertyNameTableKernel(const PropertyNameTableKernel&);
+        PropertyNameTableKernel& operator=(const PropertyNameTableKernel&);
+
+    public:
+
+        PropertyNameTableKernel() : buckets(new AtomicReference<Entry>[BUCKETS]), count(0), mutex() {
+        }
+
+        ~PropertyNameTableKernel() {
+            for (int i = 0; i < BUCKETS; ++i) {
+                Entry* entry = buckets[i].get();
+                while (entry != NULL) {
+                    Entry* next = entry->next;
+                    delete entry;
+                    entry = next;
+                }
+            }
+            delete [] buckets;
+        }
+
+        int size() const {
+            return count;
+        }
+
+        static unsigned int hash(const char* name, std::size_t length) {
+            // FNV-1a, cheap and good enough for short ASCII names.
+            unsigned int result = 2166136261U;
+            for (std::size_t i = 0; i < length; ++i) {
+                result ^= (unsigned char) name[i];
+                result *= 16777619U;
+            }
+            return result;
+        }
+
+        const std::string* find(unsigned int hash, const char* name, std::size_t length) const {
+            const Entry* entry = buckets[hash & (BUCKETS - 1)].get();
+            while (entry != NULL) {
+                if (entry->hash == hash && entry->name.compare(0, std::string::npos, name, length) == 0) {
+                    return &entry->name;
+                }
+                entry = entry->next;
+            }
+            return NULL;
+        }
+
+        /**
+         * Adds a name that find didn't return, must be called with the mutex held.
+         */
+        const std::string* add(unsigned int hash, const char* name, std::size_t length) {
+            if (count >= PropertyNameTable::MAX_NAMES) {
+                return NULL;
+            }
+
+            AtomicReference<Entry>& head = buckets[hash & (BUCKETS - 1)];
+            Entry* entry = new Entry(hash, name, length, head.get());
+            head.set(entry);
+            count++;
+            return &entry->name;
+        }
+    };
+}}
+
+////////////////////////////////////////////////////////////////////////////////
+const std::string* PropertyNameTable::intern(const std::string& name) {
+    return PropertyNameTable::intern(name.c_str(), name.length());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const std::string* PropertyNameTable::intern(const char* name, std::size_t length) {
+
+    if (kernel == NULL || name == NULL || length > (std::size_t) MAX_NAME_LENGTH) {
+        return NULL;
+    }
+
+    // Nearly every call finds an existing name which needs no lock.
+    unsigned int hash = PropertyNameTableKernel::hash(name, length);
+    const std::string* result = kernel->find(hash, name, length);
+    if (result != NULL) {
+        return result;
+    }
+
+    synchronized(&kernel->mutex) {
+        result = kernel->find(hash, name, length);
+        if (result == NULL) {
+            result = kernel->add(hash, name, length);
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const std::string* PropertyNameTable::lookup(const std::string& name) {
+
+    if (kernel == NULL || name.length() > (std::size_t) MAX_NAME_LENGTH) {
+        return NULL;
+    }
+
+    unsigned int hash = PropertyNameTableKernel::hash(name.c_str(), name.length());
+    return kernel->find(hash, name.c_str(), name.length());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int PropertyNameTable::size() {
+
+    if (kernel == NULL) {
+        return 0;
+    }
+
+    return kernel->size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PropertyNameTable::initialize() {
+    PropertyNameTable::kernel = new PropertyNameTableKernel();
+
+    // Seed the table with the reserved names every message may carry.
+    intern("JMSXDeliveryCount");
+    intern("JMSXGroupID");
+    intern("JMSXGroupSeq");
+    intern("JMSXGroupFirstForConsumer");
+    intern("JMSXUserID");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PropertyNameTable::shutdown() {
+    delete PropertyNameTable::kernel;
+    PropertyNameTable::kernel = NULL;
+}
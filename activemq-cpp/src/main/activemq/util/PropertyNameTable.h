@@ -0,0 +1,129 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_UTIL_PROPERTYNAMETABLE_H_
+#define _ACTIVEMQ_UTIL_PROPERTYNAMETABLE_H_
+
+#include <activemq/util/Config.h>
+
+#include <string>
+
+namespace activemq {
+namespace library {
+    class ActiveMQCPP;
+}
+namespace util {
+
+    class PropertyNameTableKernel;
+
+    /**
+     * Process wide table of interned message property and header names.
+     *
+     * Most applications use the same small set of property names on every message,
+     * the table hands out a single immutable string instance for each distinct name
+     * so that decoders don't need to rebuild the name for every message and so that
+     * two interned names can be compared by address.  A name's hash is computed once
+     * when it is first interned.
+     *
+     * The interned strings remain valid until the library is shut down.  To keep a
+     * misbehaving peer from growing the table without bound only MAX_NAMES names of
+     * at most MAX_NAME_LENGTH characters are interned, past that point the intern
+     * methods return NULL and the caller should just keep its own copy of the name.
+     *
+     * Names are never removed while the library is running so lookups of a name that
+     * is already present don't take any lock, only adding a new name does.
+     *
+     * @since 3.10
+     */
+    class AMQCPP_API PropertyNameTable {
+    private:
+
+        static PropertyNameTableKernel* kernel;
+
+    public:
+
+        /**
+         * The maximum number of distinct names the table will hold.
+         */
+        static const int MAX_NAMES;
+
+        /**
+         * The longest name, in characters, that will be interned.
+         */
+        static const int MAX_NAME_LENGTH;
+
+    private:
+
+        PropertyNameTable();
+        PropertyNameTable(const PropertyNameTable&);
+        PropertyNameTable& operator=(const PropertyNameTable&);
+
+    public:
+
+        /**
+         * Returns the interned instance of the given name, adding it to the table if
+         * it hasn't been seen before.
+         *
+         * @param name
+         *      The name to intern.
+         *
+         * @return the shared instance of the name or NULL if it could not be interned.
+         */
+        static const std::string* intern(const std::string& name);
+
+        /**
+         * Returns the interned instance of the name held in the given character
+         * buffer, a new string is only created when the name is not already present
+         * in the table.
+         *
+         * @param name
+         *      Pointer to the characters of the name, need not be null terminated.
+         * @param length
+         *      The number of characters in the name.
+         *
+         * @return the shared instance of the name or NULL if it could not be interned.
+         */
+        static const std::string* intern(const char* name, std::size_t length);
+
+        /**
+         * Returns the interned instance of the given name if there is one, the table
+         * is never modified by this method.
+         *
+         * @param name
+         *      The name to look up.
+         *
+         * @return the shared instance of the name or NULL if it is not in the table.
+         */
+        static const std::string* lookup(const std::string& name);
+
+        /**
+         * @return the number of names currently held in the table.
+         */
+        static int size();
+
+    private:
+
+        static void initialize();
+        static void shutdown();
+
+        friend class activemq::library::ActiveMQCPP;
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_UTIL_PROPERTYNAMETABLE_H_ */
@@ -51,13 +51,46 @@ using namespace decaf::lang::exceptions;
 const unsigned char OpenWireFormat::NULL_TYPE = 0;
 const int OpenWireFormat::DEFAULT_VERSION = 1;
 const int OpenWireFormat::MAX_SUPPORTED_VERSION = 11;
+const int OpenWireFormat::MAX_CACHED_FRAME_SIZE = 64 * 1024;
+const int OpenWireFormat::MAX_BUFFERED_FRAME_SIZE = 4 * 1024 * 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // Marks the format as receiving for the duration of an unmarshal.
+    class ReceivingScope {
+    private:
+
+        decaf::util::concurrent::atomic::AtomicBoolean* state;
+
+    private:
+
+        ReceivingScope(const ReceivingScope&);
+        ReceivingScope& operator=(const ReceivingScope&);
+
+    public:
+
+        ReceivingScope(decaf::util::concurrent::atomic::AtomicBoolean* state) : state(state) {
+            state->set(true);
+        }
+
+        ~ReceivingScope() {
+            state->set(false);
+        }
+    };
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 OpenWireFormat::OpenWireFormat(const decaf::util::Properties& properties) :
     properties(properties), preferedWireFormatInfo(), dataMarshallers(256),
+    fastUnmarshallers(256), fastMarshallers(256), slowMarshallers(0), frameBuffer(),
     id(UUID::randomUUID().toString()), receiving(), version(0), stackTraceEnabled(true),
     tcpNoDelayEnabled(true), cacheEnabled(true), cacheSize(1024), tightEncodingEnabled(false),
-    sizePrefixDisabled(false), maxInactivityDuration(30000), maxInactivityDurationInitialDelay(10000) {
+    sizePrefixDisabled(false), maxInactivityDuration(30000), maxInactivityDurationInitialDelay(10000),
+    maxFrameSize(Long::MAX_VALUE) {
+
+    this->maxFrameSize = Long::parseLong(
+        properties.getProperty("wireFormat.maxFrameSize", Long::toString(Long::MAX_VALUE)));
 
     // initialize the universal marshalers, don't need to reset them again
     // after this so its safe to do this here.
@@ -122,8 +155,26 @@ void OpenWireFormat::setVersion(int version) {
 
 ////////////////////////////////////////////////////////////////////////////////
 void OpenWireFormat::addMarshaller(DataStreamMarshaller* marshaller) {
+    this->addMarshaller(marshaller, NULL, NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormat::addMarshaller(DataStreamMarshaller* marshaller, FastUnmarshalFunction unmarshal, FastMarshalFunction marshal) {
     unsigned char type = marshaller->getDataStructureType();
+
+    if (dataMarshallers[type & 0xFF] != NULL && fastUnmarshallers[type & 0xFF] == NULL) {
+        slowMarshallers--;
+    }
+
     dataMarshallers[type & 0xFF] = marshaller;
+    fastUnmarshallers[type & 0xFF] = unmarshal;
+    fastMarshallers[type & 0xFF] = marshal;
+
+    if (unmarshal == NULL || marshal == NULL) {
+        fastUnmarshallers[type & 0xFF] = NULL;
+        fastMarshallers[type & 0xFF] = NULL;
+        slowMarshallers++;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -163,6 +214,28 @@ void OpenWireFormat::marshal(const Pointer<commands::Command> command, const act
                 size += dsm->tightMarshal1(this, dataStructure, &bs);
                 size += bs.marshalledSize();
 
+                if (!sizePrefixDisabled && slowMarshallers == 0) {
+
+                    // The first pass gave us the exact frame size, so encode the
+                    // whole frame into one buffer and hand it to the stream in a
+                    // single write.
+                    std::vector<unsigned char> frame(4 + size);
+                    FrameWriter writer(&frame[0], (int) frame.size());
+
+                    writer.writeInt(size);
+                    writer.writeByte(type);
+                    bs.marshal(&writer);
+                    fastMarshallers[type & 0xFF](this, dataStructure, &writer, &bs);
+
+                    if (writer.remaining() != 0) {
+                        throw IOException(__FILE__, __LINE__, "OpenWireFormat::marshal - "
+                                "Marshaled %d bytes less than the computed frame size.", writer.remaining());
+                    }
+
+                    dataOut->write(&frame[0], (int) frame.size());
+                    return;
+                }
+
                 if (!sizePrefixDisabled) {
                     dataOut->writeInt(size);
                 }
@@ -222,12 +295,37 @@ Pointer<commands::Command> OpenWireFormat::unmarshal(const activemq::transport::
             throw decaf::io::IOException(__FILE__, __LINE__, "DataInputStream passed is NULL");
         }
 
+        Pointer<DataStructure> data;
+
         if (!sizePrefixDisabled) {
-            dis->readInt();
-        }
+            int size = dis->readInt();
+
+            if (size > maxFrameSize) {
+                throw IOException(__FILE__, __LINE__,
+                    "Frame size of %d bytes is larger than the max allowed %lld bytes", size, maxFrameSize);
+            }
+
+            // The size prefix hasn't been validated against the frame contents so
+            // only modest frames are buffered up front, larger ones are read from
+            // the stream which allocates only as the data actually arrives.
+            if (tightEncodingEnabled && slowMarshallers == 0 && size > 0 && size <= MAX_BUFFERED_FRAME_SIZE) {
 
-        // Get the unmarshalled DataStructure
-        Pointer<DataStructure> data(doUnmarshal(dis));
+                // Only one thread reads from a given format so the frame buffer
+                // can be reused, very large frames get their own so that it
+                // isn't held on to after they've been processed.
+                std::vector<unsigned char> largeFrame;
+                std::vector<unsigned char>& frame = size <= MAX_CACHED_FRAME_SIZE ? this->frameBuffer : largeFrame;
+
+                frame.resize(size);
+                dis->readFully(&frame[0], size);
+
+                data.reset(doUnmarshal(&frame[0], size));
+            } else {
+                data.reset(doUnmarshal(dis));
+            }
+        } else {
+            data.reset(doUnmarshal(dis));
+        }
 
         if (data == NULL) {
             throw IOException(__FILE__, __LINE__, "OpenWireFormat::doUnmarshal - "
@@ -252,28 +350,7 @@ commands::DataStructure* OpenWireFormat::doUnmarshal(DataInputStream* dis) {
 
     try {
 
-        class Finally {
-        private:
-
-            decaf::util::concurrent::atomic::AtomicBoolean* state;
-
-        private:
-
-            Finally(const Finally&);
-            Finally& operator=(const Finally&);
-
-        public:
-
-            Finally(decaf::util::concurrent::atomic::AtomicBoolean* state) : state(state) {
-                state->set(true);
-            }
-
-            ~Finally() {
-                state->set(false);
-            }
-        }
-
-        finalizer(&(this->receiving));
+        ReceivingScope finalizer(&(this->receiving));
 
         unsigned char dataType = dis->readByte();
 
@@ -308,6 +385,41 @@ commands::DataStructure* OpenWireFormat::doUnmarshal(DataInputStream* dis) {
     AMQ_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+commands::DataStructure* OpenWireFormat::doUnmarshal(const unsigned char* frame, int size) {
+
+    try {
+
+        ReceivingScope finalizer(&(this->receiving));
+
+        FrameReader reader(frame, size);
+
+        unsigned char dataType = reader.readByte();
+
+        if (dataType == NULL_TYPE) {
+            return NULL;
+        }
+
+        DataStreamMarshaller* dsm = dataMarshallers[dataType & 0xFF];
+
+        if (dsm == NULL) {
+            throw IOException(__FILE__, __LINE__, (string("OpenWireFormat::marshal - Unknown data type: ") + Integer::toString(dataType)).c_str());
+        }
+
+        std::auto_ptr<DataStructure> data(dsm->createObject());
+
+        BooleanStream bs;
+        bs.unmarshal(&reader);
+        fastUnmarshallers[dataType & 0xFF](this, data.get(), &reader, &bs);
+
+        return data.release();
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 int OpenWireFormat::tightMarshalNestedObject1(commands::DataStructure* object, utils::BooleanStream* bs) {
 
@@ -422,6 +534,68 @@ DataStructure* OpenWireFormat::tightUnmarshalNestedObject(DataInputStream* dis,
     AMQ_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormat::tightMarshalNestedObject2(DataStructure* o, FrameWriter* ds, BooleanStream* bs) {
+
+    if (!bs->readBoolean()) {
+        return;
+    }
+
+    unsigned char type = o->getDataStructureType();
+
+    ds->writeByte(type);
+
+    if (o->isMarshalAware() && bs->readBoolean()) {
+
+        MarshalAware* ma = dynamic_cast<MarshalAware*>(o);
+        vector<unsigned char> sequence = ma->getMarshaledForm(this);
+        ds->write(&sequence[0], (int) sequence.size(), 0, (int) sequence.size());
+
+    } else {
+
+        FastMarshalFunction marshal = fastMarshallers[type & 0xFF];
+
+        if (marshal == NULL) {
+            throw IOException(__FILE__, __LINE__, (string("OpenWireFormat::marshal - Unknown data type: ") + Integer::toString(type)).c_str());
+        }
+
+        marshal(this, o, ds, bs);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+DataStructure* OpenWireFormat::tightUnmarshalNestedObject(FrameReader* dis, BooleanStream* bs) {
+
+    if (!bs->readBoolean()) {
+        return NULL;
+    }
+
+    const unsigned char dataType = dis->readByte();
+
+    DataStreamMarshaller* dsm = dataMarshallers[dataType & 0xFF];
+    FastUnmarshalFunction unmarshal = fastUnmarshallers[dataType & 0xFF];
+
+    if (dsm == NULL || unmarshal == NULL) {
+        throw IOException(__FILE__, __LINE__, (string("OpenWireFormat::marshal - Unknown data type: ") + Integer::toString(dataType)).c_str());
+    }
+
+    std::auto_ptr<DataStructure> data(dsm->createObject());
+
+    if (data->isMarshalAware() && bs->readBoolean()) {
+
+        dis->readInt();
+        dis->readByte();
+
+        BooleanStream bs2;
+        bs2.unmarshal(dis);
+        unmarshal(this, data.get(), dis, &bs2);
+    } else {
+        unmarshal(this, data.get(), dis, bs);
+    }
+
+    return data.release();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 DataStructure* OpenWireFormat::looseUnmarshalNestedObject(decaf::io::DataInputStream* dis) {
 
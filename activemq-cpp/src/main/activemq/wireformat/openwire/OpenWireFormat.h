@@ -23,6 +23,8 @@
 #include <activemq/commands/DataStructure.h>
 #include <activemq/wireformat/WireFormat.h>
 #include <activemq/wireformat/openwire/utils/BooleanStream.h>
+#include <activemq/wireformat/openwire/utils/FrameReader.h>
+#include <activemq/wireformat/openwire/utils/FrameWriter.h>
 #include <decaf/lang/Pointer.h>
 #include <decaf/util/Properties.h>
 #include <decaf/util/concurrent/atomic/AtomicBoolean.h>
@@ -52,6 +54,25 @@ namespace marshal {
         // Defines the maximum supported openwire version
         static const int MAX_SUPPORTED_VERSION;
 
+        // Frames up to this size reuse a buffer owned by the format when unmarshaled.
+        static const int MAX_CACHED_FRAME_SIZE;
+
+        // Frames larger than this are unmarshaled from the stream instead of being
+        // read into a buffer first.
+        static const int MAX_BUFFERED_FRAME_SIZE;
+
+        /**
+         * Statically typed tight unmarshal of one type from a buffered frame, these
+         * are generated alongside each marshaler and indexed by data structure type.
+         */
+        typedef void (*FastUnmarshalFunction)(OpenWireFormat*, commands::DataStructure*, utils::FrameReader*, utils::BooleanStream*);
+
+        /**
+         * Statically typed second pass tight marshal of one type into a buffered
+         * frame, the counterpart of FastUnmarshalFunction.
+         */
+        typedef void (*FastMarshalFunction)(OpenWireFormat*, commands::DataStructure*, utils::FrameWriter*, utils::BooleanStream*);
+
     private:
 
         // Configuration parameters
@@ -63,6 +84,17 @@ namespace marshal {
         // Marshalers
         std::vector< marshal::DataStreamMarshaller* > dataMarshallers;
 
+        // Fast path functions for each registered type, indexed like dataMarshallers
+        std::vector< FastUnmarshalFunction > fastUnmarshallers;
+        std::vector< FastMarshalFunction > fastMarshallers;
+
+        // Count of registered types without fast path functions, while non-zero
+        // every frame takes the stream path.
+        int slowMarshallers;
+
+        // Reused by unmarshal to hold the incoming frame.
+        std::vector<unsigned char> frameBuffer;
+
         // Uniquely Generated ID, initialize in the Ctor
         std::string id;
 
@@ -79,6 +111,7 @@ namespace marshal {
         bool sizePrefixDisabled;
         long long maxInactivityDuration;
         long long maxInactivityDurationInitialDelay;
+        long long maxFrameSize;
 
     public:
 
@@ -109,6 +142,19 @@ namespace marshal {
          */
         void addMarshaller(marshal::DataStreamMarshaller* marshaler);
 
+        /**
+         * Adds a marshaler along with the static fast path functions that encode
+         * and decode its type from a fully buffered frame.  When every registered
+         * type has fast path functions, tight encoded frames with a size prefix
+         * are read and written as a whole instead of field by field through the
+         * data streams.
+         *
+         * @param marshaler - the Marshaler to add to the collection.
+         * @param unmarshal - the fast path unmarshal function for the type.
+         * @param marshal - the fast path marshal function for the type.
+         */
+        void addMarshaller(marshal::DataStreamMarshaller* marshaler, FastUnmarshalFunction unmarshal, FastMarshalFunction marshal);
+
         /**
          * {@inheritDoc}
          */
@@ -152,6 +198,26 @@ namespace marshal {
          */
         commands::DataStructure* tightUnmarshalNestedObject(decaf::io::DataInputStream* dis, utils::BooleanStream* bs);
 
+        /**
+         * Fast path version of tightMarshalNestedObject2 that writes into a buffered frame.
+         * @param o - DataStructure object
+         * @param ds - the frame to write to
+         * @param bs - BooleanStream
+         * @throws IOException if an error occurs.
+         */
+        void tightMarshalNestedObject2(commands::DataStructure* o, utils::FrameWriter* ds, utils::BooleanStream* bs);
+
+        /**
+         * Fast path version of tightUnmarshalNestedObject that reads from a buffered
+         * frame.  The DataStructure instance that is returned is now the property of
+         * the caller.
+         * @param dis - the frame to read from
+         * @param bs - BooleanStream to read from
+         * @return Newly allocated DataStructure Object
+         * @throws IOException if an error occurs.
+         */
+        commands::DataStructure* tightUnmarshalNestedObject(utils::FrameReader* dis, utils::BooleanStream* bs);
+
         /**
          * Utility method to unmarshal an DataStructure object from an
          * DataInputStream using the Loose Unmarshaling format.  Will read
@@ -357,6 +423,28 @@ namespace marshal {
             this->maxInactivityDurationInitialDelay = value;
         }
 
+        /**
+         * Gets the largest frame size that will be accepted when unmarshaling.
+         * @return the maximum frame size in bytes.
+         *
+         * @since 3.10
+         */
+        long long getMaxFrameSize() const {
+            return this->maxFrameSize;
+        }
+
+        /**
+         * Sets the largest frame size that will be accepted when unmarshaling, a
+         * frame whose size prefix exceeds this value is rejected before any of it
+         * is read.
+         * @param value - the maximum frame size in bytes.
+         *
+         * @since 3.10
+         */
+        void setMaxFrameSize(long long value) {
+            this->maxFrameSize = value;
+        }
+
     protected:
 
         /**
@@ -374,6 +462,21 @@ namespace marshal {
          */
         commands::DataStructure* doUnmarshal(decaf::io::DataInputStream* dis);
 
+        /**
+         * Unmarshals a tight encoded frame that has already been read in full,
+         * using the fast path functions of the frame's type.
+         *
+         * @param frame
+         *      The frame contents following the size prefix.
+         * @param size
+         *      The number of bytes in the frame.
+         *
+         * @return new DataStructure* that the caller owns.
+         *
+         * @throws IOException if an error occurs during the unmarshal.
+         */
+        commands::DataStructure* doUnmarshal(const unsigned char* frame, int size);
+
         /**
          * Cleans up all registered Marshallers and empties the dataMarshallers
          * vector.  This should be called before a reconfiguration of the version
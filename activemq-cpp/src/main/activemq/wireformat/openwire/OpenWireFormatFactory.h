@@ -48,6 +48,7 @@ namespace openwire{
          * wireFormat.sizePrefixDisabled
          * wireFormat.maxInactivityDuration
          * wireFormat.maxInactivityDurationInitialDelay
+         * wireFormat.maxFrameSize
          */
         OpenWireFormatFactory() {}
 
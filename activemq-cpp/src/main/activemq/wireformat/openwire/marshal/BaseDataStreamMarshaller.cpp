@@ -710,3 +710,197 @@ std::string BaseDataStreamMarshaller::readAsciiString(decaf::io::DataInputStream
     AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
     AMQ_CATCHALL_THROW(IOException)
 }
+
+////////////////////////////////////////////////////////////////////////////////
+commands::DataStructure* BaseDataStreamMarshaller::tightUnmarshalCachedObject(OpenWireFormat* wireFormat, utils::FrameReader* dataIn, utils::BooleanStream* bs) {
+    return wireFormat->tightUnmarshalNestedObject(dataIn, bs);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void BaseDataStreamMarshaller::tightMarshalCachedObject2(OpenWireFormat* wireFormat, commands::DataStructure* data, utils::FrameWriter* dataOut, utils::BooleanStream* bs) {
+    wireFormat->tightMarshalNestedObject2(data, dataOut, bs);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+commands::DataStructure* BaseDataStreamMarshaller::tightUnmarshalNestedObject(OpenWireFormat* wireFormat, utils::FrameReader* dataIn, utils::BooleanStream* bs) {
+    return wireFormat->tightUnmarshalNestedObject(dataIn, bs);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void BaseDataStreamMarshaller::tightMarshalNestedObject2(OpenWireFormat* wireFormat, commands::DataStructure* object, utils::FrameWriter* dataOut, utils::BooleanStream* bs) {
+    wireFormat->tightMarshalNestedObject2(object, dataOut, bs);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string BaseDataStreamMarshaller::tightUnmarshalString(utils::FrameReader* dataIn, utils::BooleanStream* bs) {
+
+    if (bs->readBoolean()) {
+        if (bs->readBoolean()) {
+            return readAsciiString(dataIn);
+        } else {
+            return dataIn->readUTF();
+        }
+    }
+
+    return "";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void BaseDataStreamMarshaller::tightMarshalString2(const std::string& value, utils::FrameWriter* dataOut, utils::BooleanStream* bs) {
+
+    if (bs->readBoolean()) {
+        // If we verified it only holds ascii values
+        if (bs->readBoolean()) {
+            dataOut->writeShort((short) value.length());
+            dataOut->writeBytes(value);
+        } else {
+            dataOut->writeUTF(value);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long BaseDataStreamMarshaller::tightUnmarshalLong(OpenWireFormat* wireFormat AMQCPP_UNUSED, utils::FrameReader* dataIn, utils::BooleanStream* bs) {
+
+    if (bs->readBoolean()) {
+
+        if (bs->readBoolean()) {
+            return dataIn->readLong();
+        } else {
+            return (unsigned int) dataIn->readInt();
+        }
+
+    } else {
+
+        if (bs->readBoolean()) {
+            return dataIn->readUnsignedShort();
+        } else {
+            return 0;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void BaseDataStreamMarshaller::tightMarshalLong2(OpenWireFormat* wireFormat AMQCPP_UNUSED, long long value, utils::FrameWriter* dataOut, utils::BooleanStream* bs) {
+
+    if (bs->readBoolean()) {
+
+        if (bs->readBoolean()) {
+            dataOut->writeLong(value);
+        } else {
+            dataOut->writeInt((int) value);
+        }
+
+    } else {
+
+        if (bs->readBoolean()) {
+            dataOut->writeShort((short) value);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<unsigned char> BaseDataStreamMarshaller::tightUnmarshalByteArray(utils::FrameReader* dataIn, utils::BooleanStream* bs) {
+
+    std::vector<unsigned char> data;
+    if (bs->readBoolean()) {
+        int size = dataIn->readInt();
+        if (size > 0) {
+            if (size > dataIn->remaining()) {
+                throw IOException(__FILE__, __LINE__, "BaseDataStreamMarshaller::tightUnmarshalByteArray - "
+                        "Array size %d is larger than the remaining frame.", size);
+            }
+            data.resize(size);
+            dataIn->readFully(&data[0], size);
+        }
+    }
+
+    return data;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<unsigned char> BaseDataStreamMarshaller::tightUnmarshalConstByteArray(utils::FrameReader* dataIn, utils::BooleanStream* bs AMQCPP_UNUSED, int size) {
+
+    std::vector<unsigned char> data;
+    if (size > 0) {
+        data.resize(size);
+        dataIn->readFully(&data[0], size);
+    }
+    return data;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+commands::DataStructure* BaseDataStreamMarshaller::tightUnmarshalBrokerError(OpenWireFormat* wireFormat, utils::FrameReader* dataIn, utils::BooleanStream* bs) {
+
+    if (!bs->readBoolean()) {
+        return NULL;
+    }
+
+    std::auto_ptr<BrokerError> answer(new BrokerError());
+
+    answer->setExceptionClass(tightUnmarshalString(dataIn, bs));
+    answer->setMessage(tightUnmarshalString(dataIn, bs));
+
+    if (wireFormat->isStackTraceEnabled()) {
+        short length = dataIn->readShort();
+        std::vector<Pointer<BrokerError::StackTraceElement> > stackTrace;
+
+        for (int i = 0; i < length; ++i) {
+
+            Pointer<BrokerError::StackTraceElement> element(new BrokerError::StackTraceElement);
+
+            element->ClassName = tightUnmarshalString(dataIn, bs);
+            element->MethodName = tightUnmarshalString(dataIn, bs);
+            element->FileName = tightUnmarshalString(dataIn, bs);
+            element->LineNumber = dataIn->readInt();
+            stackTrace.push_back(element);
+        }
+
+        answer->setStackTraceElements(stackTrace);
+        answer->setCause(Pointer<BrokerError>(static_cast<BrokerError*>(tightUnmarshalBrokerError(wireFormat, dataIn, bs))));
+    }
+
+    return answer.release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void BaseDataStreamMarshaller::tightMarshalBrokerError2(OpenWireFormat* wireFormat, commands::DataStructure* data, utils::FrameWriter* dataOut, utils::BooleanStream* bs) {
+
+    if (!bs->readBoolean()) {
+        return;
+    }
+
+    BrokerError* error = dynamic_cast<BrokerError*>(data);
+
+    tightMarshalString2(error->getExceptionClass(), dataOut, bs);
+    tightMarshalString2(error->getMessage(), dataOut, bs);
+
+    if (wireFormat->isStackTraceEnabled()) {
+
+        int length = (short) error->getStackTraceElements().size();
+        dataOut->writeShort((short) length);
+
+        for (int i = 0; i < length; ++i) {
+
+            Pointer<BrokerError::StackTraceElement> element = error->getStackTraceElements()[i];
+
+            tightMarshalString2(element->ClassName, dataOut, bs);
+            tightMarshalString2(element->MethodName, dataOut, bs);
+            tightMarshalString2(element->FileName, dataOut, bs);
+            dataOut->writeInt(element->LineNumber);
+        }
+
+        tightMarshalBrokerError2(wireFormat, error->getCause().get(), dataOut, bs);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string BaseDataStreamMarshaller::readAsciiString(utils::FrameReader* dataIn) {
+
+    int size = dataIn->readShort();
+    if (size > 0) {
+        return dataIn->readString(size);
+    }
+
+    return "";
+}
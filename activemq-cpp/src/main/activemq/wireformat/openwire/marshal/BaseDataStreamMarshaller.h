@@ -20,6 +20,8 @@
 
 #include <activemq/wireformat/openwire/marshal/DataStreamMarshaller.h>
 #include <activemq/wireformat/openwire/utils/HexTable.h>
+#include <activemq/wireformat/openwire/utils/FrameReader.h>
+#include <activemq/wireformat/openwire/utils/FrameWriter.h>
 #include <activemq/commands/MessageId.h>
 #include <activemq/commands/ProducerId.h>
 #include <activemq/commands/TransactionId.h>
@@ -105,6 +107,38 @@ namespace marshal{
                                     commands::DataStructure* command AMQCPP_UNUSED,
                                     decaf::io::DataInputStream* dis AMQCPP_UNUSED) {}
 
+        /**
+         * Fast path Tight Un-Marshal from a fully buffered frame.  Each generated
+         * marshaler provides a static version of this method that fills in its own
+         * fields after calling the one of its base class, this is the root of
+         * that chain and reads nothing.
+         *
+         * @param format - The OpenwireFormat properties
+         * @param command - the object to Un-Marshal, must be of the marshaler's type.
+         * @param dataIn - the frame to Un-Marshal from
+         * @param bs - boolean stream to unmarshal from.
+         * @throws IOException if an error occurs.
+         */
+        static void fastTightUnmarshal(OpenWireFormat* format AMQCPP_UNUSED,
+                                       commands::DataStructure* command AMQCPP_UNUSED,
+                                       utils::FrameReader* dataIn AMQCPP_UNUSED,
+                                       utils::BooleanStream* bs AMQCPP_UNUSED) {}
+
+        /**
+         * Fast path Tight Marshal into a preallocated frame, the counterpart of
+         * tightMarshal2 for use with fastTightUnmarshal.
+         *
+         * @param format - The OpenwireFormat properties
+         * @param command - the object to Marshal, must be of the marshaler's type.
+         * @param dataOut - the frame to Marshal to
+         * @param bs - boolean stream filled in by tightMarshal1.
+         * @throws IOException if an error occurs.
+         */
+        static void fastTightMarshal2(OpenWireFormat* format AMQCPP_UNUSED,
+                                      commands::DataStructure* command AMQCPP_UNUSED,
+                                      utils::FrameWriter* dataOut AMQCPP_UNUSED,
+                                      utils::BooleanStream* bs AMQCPP_UNUSED) {}
+
     public:
         // Statics
 
@@ -518,6 +552,50 @@ namespace marshal{
          */
         virtual std::string readAsciiString(decaf::io::DataInputStream* dataIn);
 
+    protected:
+
+        // Fast path overloads of the tight helpers above, these work on a
+        // buffered frame and are static so that the generated fastTightUnmarshal
+        // and fastTightMarshal2 functions can call them without an instance.
+
+        static commands::DataStructure* tightUnmarshalCachedObject(OpenWireFormat* wireFormat, utils::FrameReader* dataIn, utils::BooleanStream* bs);
+
+        static void tightMarshalCachedObject2(OpenWireFormat* wireFormat, commands::DataStructure* data, utils::FrameWriter* dataOut, utils::BooleanStream* bs);
+
+        static commands::DataStructure* tightUnmarshalNestedObject(OpenWireFormat* wireFormat, utils::FrameReader* dataIn, utils::BooleanStream* bs);
+
+        static void tightMarshalNestedObject2(OpenWireFormat* wireFormat, commands::DataStructure* object, utils::FrameWriter* dataOut, utils::BooleanStream* bs);
+
+        static std::string tightUnmarshalString(utils::FrameReader* dataIn, utils::BooleanStream* bs);
+
+        static void tightMarshalString2(const std::string& value, utils::FrameWriter* dataOut, utils::BooleanStream* bs);
+
+        static long long tightUnmarshalLong(OpenWireFormat* wireFormat, utils::FrameReader* dataIn, utils::BooleanStream* bs);
+
+        static void tightMarshalLong2(OpenWireFormat* wireFormat, long long value, utils::FrameWriter* dataOut, utils::BooleanStream* bs);
+
+        static std::vector<unsigned char> tightUnmarshalByteArray(utils::FrameReader* dataIn, utils::BooleanStream* bs);
+
+        static std::vector<unsigned char> tightUnmarshalConstByteArray(utils::FrameReader* dataIn, utils::BooleanStream* bs, int size);
+
+        static commands::DataStructure* tightUnmarshalBrokerError(OpenWireFormat* wireFormat, utils::FrameReader* dataIn, utils::BooleanStream* bs);
+
+        static void tightMarshalBrokerError2(OpenWireFormat* wireFormat, commands::DataStructure* data, utils::FrameWriter* dataOut, utils::BooleanStream* bs);
+
+        template<typename T>
+        static void tightMarshalObjectArray2(OpenWireFormat* wireFormat, const std::vector<T>& objects, utils::FrameWriter* dataOut, utils::BooleanStream* bs) {
+
+            if (bs->readBoolean()) {
+
+                dataOut->writeShort((short) objects.size());
+                for (std::size_t i = 0; i < objects.size(); ++i) {
+                    tightMarshalNestedObject2(wireFormat, objects[i].get(), dataOut, bs);
+                }
+            }
+        }
+
+        static std::string readAsciiString(utils::FrameReader* dataIn);
+
     };
 
 }}}}
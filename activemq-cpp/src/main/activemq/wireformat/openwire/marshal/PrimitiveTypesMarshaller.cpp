@@ -22,6 +22,8 @@
 #include <decaf/io/DataInputStream.h>
 #include <decaf/io/DataOutputStream.h>
 #include <activemq/exceptions/ActiveMQException.h>
+#include <activemq/util/MarshallingSupport.h>
+#include <activemq/util/PropertyNameTable.h>
 #include <decaf/lang/Short.h>
 
 #include <memory>
@@ -324,9 +326,19 @@ void PrimitiveTypesMarshaller::unmarshalPrimitiveMap(decaf::io::DataInputStream&
         int size = dataIn.readInt();
 
         if (size > 0) {
+            std::string scratch;
             for (int i = 0; i < size; i++) {
-                std::string key = dataIn.readUTF();
-                map.put(key, unmarshalPrimitive(dataIn));
+
+                // Decode straight into the map's node instead of copying it there.
+                const std::string* name = unmarshalPropertyName(dataIn, scratch);
+                if (name != NULL) {
+                    unmarshalPrimitive(dataIn, map.getInternedValueNode(name));
+                } else {
+                    if (!map.containsKey(scratch)) {
+                        map.put(scratch, PrimitiveValueNode());
+                    }
+                    unmarshalPrimitive(dataIn, map.get(scratch));
+                }
             }
         }
     }
@@ -342,7 +354,8 @@ void PrimitiveTypesMarshaller::unmarshalPrimitiveList(decaf::io::DataInputStream
 
         int size = dataIn.readInt();
         while (size-- > 0) {
-            list.add(unmarshalPrimitive(dataIn));
+            list.add(PrimitiveValueNode());
+            unmarshalPrimitive(dataIn, list.getLast());
         }
     }
     AMQ_CATCH_RETHROW(io::IOException)
@@ -355,8 +368,21 @@ PrimitiveValueNode PrimitiveTypesMarshaller::unmarshalPrimitive(io::DataInputStr
 
     try {
 
-        unsigned char type = dataIn.readByte();
         PrimitiveValueNode value;
+        PrimitiveTypesMarshaller::unmarshalPrimitive(dataIn, value);
+        return value;
+    }
+    AMQ_CATCH_RETHROW(io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, io::IOException)
+    AMQ_CATCHALL_THROW(io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void PrimitiveTypesMarshaller::unmarshalPrimitive(io::DataInputStream& dataIn, PrimitiveValueNode& value) {
+
+    try {
+
+        unsigned char type = dataIn.readByte();
 
         switch (type) {
 
@@ -403,9 +429,11 @@ PrimitiveValueNode PrimitiveTypesMarshaller::unmarshalPrimitive(io::DataInputStr
                 int utfLength = dataIn.readShort();
                 if (utfLength > 0) {
 
-                    std::vector<unsigned char> buffer(utfLength);
-                    dataIn.readFully(&buffer[0], utfLength);
-                    value.setString(std::string((char*) (&buffer[0]), utfLength));
+                    std::string text((std::size_t) utfLength, '\0');
+                    dataIn.readFully((unsigned char*) &text[0], utfLength);
+                    value.setString(text);
+                } else {
+                    value.clear();
                 }
                 break;
             }
@@ -413,9 +441,11 @@ PrimitiveValueNode PrimitiveTypesMarshaller::unmarshalPrimitive(io::DataInputStr
                 int utfLength = dataIn.readInt();
                 if (utfLength > 0) {
 
-                    std::vector<unsigned char> buffer(utfLength);
-                    dataIn.readFully(&buffer[0], utfLength);
-                    value.setString(std::string((char*) (&buffer[0]), utfLength));
+                    std::string text((std::size_t) utfLength, '\0');
+                    dataIn.readFully((unsigned char*) &text[0], utfLength);
+                    value.setString(text);
+                } else {
+                    value.clear();
                 }
                 break;
             }
@@ -437,8 +467,33 @@ PrimitiveValueNode PrimitiveTypesMarshaller::unmarshalPrimitive(io::DataInputStr
                 __LINE__, "PrimitiveTypesMarshaller::unmarshalPrimitive - "
                         "Unsupported data type: ");
         }
+    }
+    AMQ_CATCH_RETHROW(io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, io::IOException)
+    AMQ_CATCHALL_THROW(io::IOException)
+}
+
+///////////////////////////////////////////////////////////////////////////////
+const std::string* PrimitiveTypesMarshaller::unmarshalPropertyName(decaf::io::DataInputStream& dataIn, std::string& scratch) {
+
+    try {
+
+        unsigned short utfLength = dataIn.readUnsignedShort();
+
+        scratch.resize(utfLength);
+        if (utfLength > 0) {
+            dataIn.readFully((unsigned char*) &scratch[0], utfLength);
+        }
 
-        return value;
+        // Names are almost always plain ASCII which reads the same in modified UTF-8.
+        for (std::size_t i = 0; i < scratch.length(); ++i) {
+            if ((unsigned char) scratch[i] >= 0x80) {
+                scratch = MarshallingSupport::modifiedUtf8ToAscii(scratch);
+                break;
+            }
+        }
+
+        return PropertyNameTable::intern(scratch);
     }
     AMQ_CATCH_RETHROW(io::IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(Exception, io::IOException)
@@ -212,6 +212,29 @@ namespace marshal{
          */
         static util::PrimitiveValueNode unmarshalPrimitive( decaf::io::DataInputStream& dataIn );
 
+        /**
+         * Unmarshals a Primitive Type from the stream into the given value Node,
+         * replacing whatever value it held before.
+         * @param dataIn - DataInputStream to read from.
+         * @param value - the PrimitiveValueNode that receives the data.
+         *
+         * @throws IOException if an I/O error occurs during this operation.
+         */
+        static void unmarshalPrimitive( decaf::io::DataInputStream& dataIn, util::PrimitiveValueNode& value );
+
+        /**
+         * Reads a property name from the stream and returns its interned instance from
+         * PropertyNameTable, the raw name is decoded into the given scratch string whose
+         * storage is reused so that decoding a map doesn't allocate a name per key.
+         * @param dataIn - DataInputStream to read from.
+         * @param scratch - string that receives the decoded name.
+         * @return the interned name or NULL if it could not be interned, in which case
+         *         the caller uses the scratch string.
+         *
+         * @throws IOException if an I/O error occurs during this operation.
+         */
+        static const std::string* unmarshalPropertyName( decaf::io::DataInputStream& dataIn, std::string& scratch );
+
     };
 
 }}}}
@@ -133,6 +133,48 @@ void ActiveMQBlobMessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat, Da
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQBlobMessageMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    MessageMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    ActiveMQBlobMessage* info =
+        static_cast<ActiveMQBlobMessage*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    if (wireVersion >= 3) {
+        info->setRemoteBlobUrl(tightUnmarshalString(dataIn, bs));
+    }
+    if (wireVersion >= 3) {
+        info->setMimeType(tightUnmarshalString(dataIn, bs));
+    }
+    if (wireVersion >= 3) {
+        info->setDeletedByBroker(bs->readBoolean());
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQBlobMessageMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    MessageMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    ActiveMQBlobMessage* info =
+        static_cast<ActiveMQBlobMessage*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    if (wireVersion >= 3) {
+        tightMarshalString2(info->getRemoteBlobUrl(), dataOut, bs);
+    }
+    if (wireVersion >= 3) {
+        tightMarshalString2(info->getMimeType(), dataOut, bs);
+    }
+    if (wireVersion >= 3) {
+        bs->readBoolean();
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQBlobMessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
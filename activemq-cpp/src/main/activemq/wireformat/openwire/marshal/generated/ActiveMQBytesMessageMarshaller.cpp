@@ -103,6 +103,29 @@ void ActiveMQBytesMessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat, D
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQBytesMessageMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    MessageMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    ActiveMQBytesMessage* info =
+        static_cast<ActiveMQBytesMessage*>(dataStructure);
+    info->beforeUnmarshal(wireFormat);
+
+
+    info->afterUnmarshal( wireFormat );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQBytesMessageMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    MessageMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    ActiveMQBytesMessage* info =
+        static_cast<ActiveMQBytesMessage*>(dataStructure);
+    info->afterMarshal(wireFormat);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQBytesMessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -32,6 +32,8 @@
 #include <activemq/commands/DataStructure.h>
 #include <activemq/wireformat/openwire/OpenWireFormat.h>
 #include <activemq/wireformat/openwire/utils/BooleanStream.h>
+#include <activemq/wireformat/openwire/utils/FrameReader.h>
+#include <activemq/wireformat/openwire/utils/FrameWriter.h>
 
 namespace activemq {
 namespace wireformat {
@@ -70,6 +72,16 @@ namespace generated {
                                    decaf::io::DataOutputStream* dataOut,
                                    utils::BooleanStream* bs);
 
+        static void fastTightUnmarshal(OpenWireFormat* wireFormat,
+                                       commands::DataStructure* dataStructure,
+                                       utils::FrameReader* dataIn,
+                                       utils::BooleanStream* bs);
+
+        static void fastTightMarshal2(OpenWireFormat* wireFormat,
+                                      commands::DataStructure* dataStructure,
+                                      utils::FrameWriter* dataOut,
+                                      utils::BooleanStream* bs);
+
         virtual void looseUnmarshal(OpenWireFormat* wireFormat,
                                     commands::DataStructure* dataStructure,
                                     decaf::io::DataInputStream* dataIn);
@@ -90,6 +90,26 @@ void ActiveMQDestinationMarshaller::tightMarshal2(OpenWireFormat* wireFormat, Da
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQDestinationMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    ActiveMQDestination* info =
+        static_cast<ActiveMQDestination*>(dataStructure);
+    info->setPhysicalName(tightUnmarshalString(dataIn, bs));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQDestinationMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    ActiveMQDestination* info =
+        static_cast<ActiveMQDestination*>(dataStructure);
+    tightMarshalString2(info->getPhysicalName(), dataOut, bs);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQDestinationMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
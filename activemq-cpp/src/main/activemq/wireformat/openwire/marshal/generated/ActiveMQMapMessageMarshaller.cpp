@@ -103,6 +103,29 @@ void ActiveMQMapMessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat, Dat
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQMapMessageMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    MessageMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    ActiveMQMapMessage* info =
+        static_cast<ActiveMQMapMessage*>(dataStructure);
+    info->beforeUnmarshal(wireFormat);
+
+
+    info->afterUnmarshal( wireFormat );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQMapMessageMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    MessageMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    ActiveMQMapMessage* info =
+        static_cast<ActiveMQMapMessage*>(dataStructure);
+    info->afterMarshal(wireFormat);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQMapMessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -103,6 +103,29 @@ void ActiveMQMessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataSt
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQMessageMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    MessageMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    ActiveMQMessage* info =
+        static_cast<ActiveMQMessage*>(dataStructure);
+    info->beforeUnmarshal(wireFormat);
+
+
+    info->afterUnmarshal( wireFormat );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQMessageMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    MessageMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    ActiveMQMessage* info =
+        static_cast<ActiveMQMessage*>(dataStructure);
+    info->afterMarshal(wireFormat);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQMessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
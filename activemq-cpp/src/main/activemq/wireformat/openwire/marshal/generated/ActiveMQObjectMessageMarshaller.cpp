@@ -103,6 +103,29 @@ void ActiveMQObjectMessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQObjectMessageMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    MessageMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    ActiveMQObjectMessage* info =
+        static_cast<ActiveMQObjectMessage*>(dataStructure);
+    info->beforeUnmarshal(wireFormat);
+
+
+    info->afterUnmarshal( wireFormat );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQObjectMessageMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    MessageMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    ActiveMQObjectMessage* info =
+        static_cast<ActiveMQObjectMessage*>(dataStructure);
+    info->afterMarshal(wireFormat);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQObjectMessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
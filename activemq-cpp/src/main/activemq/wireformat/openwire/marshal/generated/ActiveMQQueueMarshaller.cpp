@@ -90,6 +90,20 @@ void ActiveMQQueueMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStru
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQQueueMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    ActiveMQDestinationMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQQueueMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    ActiveMQDestinationMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQQueueMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -103,6 +103,29 @@ void ActiveMQStreamMessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQStreamMessageMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    MessageMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    ActiveMQStreamMessage* info =
+        static_cast<ActiveMQStreamMessage*>(dataStructure);
+    info->beforeUnmarshal(wireFormat);
+
+
+    info->afterUnmarshal( wireFormat );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQStreamMessageMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    MessageMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    ActiveMQStreamMessage* info =
+        static_cast<ActiveMQStreamMessage*>(dataStructure);
+    info->afterMarshal(wireFormat);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQStreamMessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
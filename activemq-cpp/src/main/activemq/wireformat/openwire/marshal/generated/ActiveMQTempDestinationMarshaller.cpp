@@ -80,6 +80,20 @@ void ActiveMQTempDestinationMarshaller::tightMarshal2(OpenWireFormat* wireFormat
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQTempDestinationMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    ActiveMQDestinationMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQTempDestinationMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    ActiveMQDestinationMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQTempDestinationMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -90,6 +90,20 @@ void ActiveMQTempQueueMarshaller::tightMarshal2(OpenWireFormat* wireFormat, Data
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQTempQueueMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    ActiveMQTempDestinationMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQTempQueueMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    ActiveMQTempDestinationMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQTempQueueMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -90,6 +90,20 @@ void ActiveMQTempTopicMarshaller::tightMarshal2(OpenWireFormat* wireFormat, Data
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQTempTopicMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    ActiveMQTempDestinationMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQTempTopicMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    ActiveMQTempDestinationMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQTempTopicMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -90,6 +90,20 @@ void ActiveMQTopicMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStru
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQTopicMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    ActiveMQDestinationMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQTopicMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    ActiveMQDestinationMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQTopicMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
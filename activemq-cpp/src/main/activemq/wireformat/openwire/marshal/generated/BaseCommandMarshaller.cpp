@@ -92,6 +92,28 @@ void BaseCommandMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStruct
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void BaseCommandMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    BaseCommand* info =
+        static_cast<BaseCommand*>(dataStructure);
+    info->setCommandId(dataIn->readInt());
+    info->setResponseRequired(bs->readBoolean());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void BaseCommandMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    BaseCommand* info =
+        static_cast<BaseCommand*>(dataStructure);
+    dataOut->writeInt(info->getCommandId());
+    bs->readBoolean();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void BaseCommandMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -100,6 +100,26 @@ void BrokerIdMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStructure
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void BrokerIdMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    BrokerId* info =
+        static_cast<BrokerId*>(dataStructure);
+    info->setValue(tightUnmarshalString(dataIn, bs));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void BrokerIdMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    BrokerId* info =
+        static_cast<BrokerId*>(dataStructure);
+    tightMarshalString2(info->getValue(), dataOut, bs);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void BrokerIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
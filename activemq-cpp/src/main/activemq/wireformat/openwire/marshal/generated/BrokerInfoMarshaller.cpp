@@ -183,6 +183,85 @@ void BrokerInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStructu
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void BrokerInfoMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    BrokerInfo* info =
+        static_cast<BrokerInfo*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    info->setBrokerId(Pointer<BrokerId>(dynamic_cast<BrokerId* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    info->setBrokerURL(tightUnmarshalString(dataIn, bs));
+
+    if (bs->readBoolean()) {
+        short size = dataIn->readShort();
+        info->getPeerBrokerInfos().reserve(size);
+        for (int i = 0; i < size; i++) {
+            info->getPeerBrokerInfos().push_back(Pointer<BrokerInfo>(dynamic_cast<BrokerInfo*>(
+                tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+        }
+    } else {
+        info->getPeerBrokerInfos().clear();
+    }
+    info->setBrokerName(tightUnmarshalString(dataIn, bs));
+    info->setSlaveBroker(bs->readBoolean());
+    info->setMasterBroker(bs->readBoolean());
+    info->setFaultTolerantConfiguration(bs->readBoolean());
+    if (wireVersion >= 2) {
+        info->setDuplexConnection(bs->readBoolean());
+    }
+    if (wireVersion >= 2) {
+        info->setNetworkConnection(bs->readBoolean());
+    }
+    if (wireVersion >= 2) {
+        info->setConnectionId(tightUnmarshalLong(wireFormat, dataIn, bs));
+    }
+    if (wireVersion >= 3) {
+        info->setBrokerUploadUrl(tightUnmarshalString(dataIn, bs));
+    }
+    if (wireVersion >= 3) {
+        info->setNetworkProperties(tightUnmarshalString(dataIn, bs));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void BrokerInfoMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    BrokerInfo* info =
+        static_cast<BrokerInfo*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    tightMarshalCachedObject2(wireFormat, info->getBrokerId().get(), dataOut, bs);
+    tightMarshalString2(info->getBrokerURL(), dataOut, bs);
+    tightMarshalObjectArray2(wireFormat, info->getPeerBrokerInfos(), dataOut, bs);
+    tightMarshalString2(info->getBrokerName(), dataOut, bs);
+    bs->readBoolean();
+    bs->readBoolean();
+    bs->readBoolean();
+    if (wireVersion >= 2) {
+        bs->readBoolean();
+    }
+    if (wireVersion >= 2) {
+        bs->readBoolean();
+    }
+    if (wireVersion >= 2) {
+        tightMarshalLong2(wireFormat, info->getConnectionId(), dataOut, bs);
+    }
+    if (wireVersion >= 3) {
+        tightMarshalString2(info->getBrokerUploadUrl(), dataOut, bs);
+    }
+    if (wireVersion >= 3) {
+        tightMarshalString2(info->getNetworkProperties(), dataOut, bs);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void BrokerInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -161,6 +161,67 @@ void ConnectionControlMarshaller::tightMarshal2(OpenWireFormat* wireFormat, Data
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ConnectionControlMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    ConnectionControl* info =
+        static_cast<ConnectionControl*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    info->setClose(bs->readBoolean());
+    info->setExit(bs->readBoolean());
+    info->setFaultTolerant(bs->readBoolean());
+    info->setResume(bs->readBoolean());
+    info->setSuspend(bs->readBoolean());
+    if (wireVersion >= 6) {
+        info->setConnectedBrokers(tightUnmarshalString(dataIn, bs));
+    }
+    if (wireVersion >= 6) {
+        info->setReconnectTo(tightUnmarshalString(dataIn, bs));
+    }
+    if (wireVersion >= 6) {
+        info->setRebalanceConnection(bs->readBoolean());
+    }
+    if (wireVersion >= 8) {
+        info->setToken(tightUnmarshalByteArray(dataIn, bs));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ConnectionControlMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    ConnectionControl* info =
+        static_cast<ConnectionControl*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    bs->readBoolean();
+    bs->readBoolean();
+    bs->readBoolean();
+    bs->readBoolean();
+    bs->readBoolean();
+    if (wireVersion >= 6) {
+        tightMarshalString2(info->getConnectedBrokers(), dataOut, bs);
+    }
+    if (wireVersion >= 6) {
+        tightMarshalString2(info->getReconnectTo(), dataOut, bs);
+    }
+    if (wireVersion >= 6) {
+        bs->readBoolean();
+    }
+    if (wireVersion >= 8) {
+        if (bs->readBoolean()) {
+            dataOut->writeInt((int)info->getToken().size() );
+            dataOut->write((const unsigned char*)(&info->getToken()[0]), (int)info->getToken().size(), 0, (int)info->getToken().size());
+        }
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ConnectionControlMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
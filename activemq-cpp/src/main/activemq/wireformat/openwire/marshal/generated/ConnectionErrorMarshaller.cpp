@@ -105,6 +105,30 @@ void ConnectionErrorMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataSt
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ConnectionErrorMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    ConnectionError* info =
+        static_cast<ConnectionError*>(dataStructure);
+    info->setException(Pointer<BrokerError>(dynamic_cast<BrokerError* >(
+        tightUnmarshalBrokerError(wireFormat, dataIn, bs))));
+    info->setConnectionId(Pointer<ConnectionId>(dynamic_cast<ConnectionId* >(
+        tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ConnectionErrorMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    ConnectionError* info =
+        static_cast<ConnectionError*>(dataStructure);
+    tightMarshalBrokerError2(wireFormat, info->getException().get(), dataOut, bs);
+    tightMarshalNestedObject2(wireFormat, info->getConnectionId().get(), dataOut, bs);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ConnectionErrorMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -100,6 +100,26 @@ void ConnectionIdMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStruc
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ConnectionIdMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    ConnectionId* info =
+        static_cast<ConnectionId*>(dataStructure);
+    info->setValue(tightUnmarshalString(dataIn, bs));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ConnectionIdMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    ConnectionId* info =
+        static_cast<ConnectionId*>(dataStructure);
+    tightMarshalString2(info->getValue(), dataOut, bs);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ConnectionIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -174,6 +174,79 @@ void ConnectionInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStr
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ConnectionInfoMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    ConnectionInfo* info =
+        static_cast<ConnectionInfo*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    info->setConnectionId(Pointer<ConnectionId>(dynamic_cast<ConnectionId* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    info->setClientId(tightUnmarshalString(dataIn, bs));
+    info->setPassword(tightUnmarshalString(dataIn, bs));
+    info->setUserName(tightUnmarshalString(dataIn, bs));
+
+    if (bs->readBoolean()) {
+        short size = dataIn->readShort();
+        info->getBrokerPath().reserve(size);
+        for (int i = 0; i < size; i++) {
+            info->getBrokerPath().push_back(Pointer<BrokerId>(dynamic_cast<BrokerId*>(
+                tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+        }
+    } else {
+        info->getBrokerPath().clear();
+    }
+    info->setBrokerMasterConnector(bs->readBoolean());
+    info->setManageable(bs->readBoolean());
+    if (wireVersion >= 2) {
+        info->setClientMaster(bs->readBoolean());
+    }
+    if (wireVersion >= 6) {
+        info->setFaultTolerant(bs->readBoolean());
+    }
+    if (wireVersion >= 6) {
+        info->setFailoverReconnect(bs->readBoolean());
+    }
+    if (wireVersion >= 8) {
+        info->setClientIp(tightUnmarshalString(dataIn, bs));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ConnectionInfoMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    ConnectionInfo* info =
+        static_cast<ConnectionInfo*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    tightMarshalCachedObject2(wireFormat, info->getConnectionId().get(), dataOut, bs);
+    tightMarshalString2(info->getClientId(), dataOut, bs);
+    tightMarshalString2(info->getPassword(), dataOut, bs);
+    tightMarshalString2(info->getUserName(), dataOut, bs);
+    tightMarshalObjectArray2(wireFormat, info->getBrokerPath(), dataOut, bs);
+    bs->readBoolean();
+    bs->readBoolean();
+    if (wireVersion >= 2) {
+        bs->readBoolean();
+    }
+    if (wireVersion >= 6) {
+        bs->readBoolean();
+    }
+    if (wireVersion >= 6) {
+        bs->readBoolean();
+    }
+    if (wireVersion >= 8) {
+        tightMarshalString2(info->getClientIp(), dataOut, bs);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ConnectionInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
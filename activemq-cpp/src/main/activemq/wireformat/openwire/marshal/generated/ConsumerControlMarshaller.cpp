@@ -152,6 +152,62 @@ void ConsumerControlMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataSt
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ConsumerControlMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    ConsumerControl* info =
+        static_cast<ConsumerControl*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    if (wireVersion >= 6) {
+        info->setDestination(Pointer<ActiveMQDestination>(dynamic_cast<ActiveMQDestination* >(
+            tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+    }
+    info->setClose(bs->readBoolean());
+    info->setConsumerId(Pointer<ConsumerId>(dynamic_cast<ConsumerId* >(
+        tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+    info->setPrefetch(dataIn->readInt());
+    if (wireVersion >= 2) {
+        info->setFlush(bs->readBoolean());
+    }
+    if (wireVersion >= 2) {
+        info->setStart(bs->readBoolean());
+    }
+    if (wireVersion >= 2) {
+        info->setStop(bs->readBoolean());
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ConsumerControlMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    ConsumerControl* info =
+        static_cast<ConsumerControl*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    if (wireVersion >= 6) {
+        tightMarshalNestedObject2(wireFormat, info->getDestination().get(), dataOut, bs);
+    }
+    bs->readBoolean();
+    tightMarshalNestedObject2(wireFormat, info->getConsumerId().get(), dataOut, bs);
+    dataOut->writeInt(info->getPrefetch());
+    if (wireVersion >= 2) {
+        bs->readBoolean();
+    }
+    if (wireVersion >= 2) {
+        bs->readBoolean();
+    }
+    if (wireVersion >= 2) {
+        bs->readBoolean();
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ConsumerControlMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
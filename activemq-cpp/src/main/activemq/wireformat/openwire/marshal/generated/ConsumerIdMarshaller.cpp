@@ -62,6 +62,8 @@ void ConsumerIdMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataStruct
         info->setConnectionId(tightUnmarshalString(dataIn, bs));
         info->setSessionId(tightUnmarshalLong(wireFormat, dataIn, bs));
         info->setValue(tightUnmarshalLong(wireFormat, dataIn, bs));
+
+        info->afterUnmarshal( wireFormat );
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
@@ -106,6 +108,32 @@ void ConsumerIdMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStructu
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ConsumerIdMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    ConsumerId* info =
+        static_cast<ConsumerId*>(dataStructure);
+    info->setConnectionId(tightUnmarshalString(dataIn, bs));
+    info->setSessionId(tightUnmarshalLong(wireFormat, dataIn, bs));
+    info->setValue(tightUnmarshalLong(wireFormat, dataIn, bs));
+
+    info->afterUnmarshal( wireFormat );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ConsumerIdMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    ConsumerId* info =
+        static_cast<ConsumerId*>(dataStructure);
+    tightMarshalString2(info->getConnectionId(), dataOut, bs);
+    tightMarshalLong2(wireFormat, info->getSessionId(), dataOut, bs);
+    tightMarshalLong2(wireFormat, info->getValue(), dataOut, bs);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ConsumerIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -117,6 +145,7 @@ void ConsumerIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStruct
         info->setConnectionId(looseUnmarshalString(dataIn));
         info->setSessionId(looseUnmarshalLong(wireFormat, dataIn));
         info->setValue(looseUnmarshalLong(wireFormat, dataIn));
+        info->afterUnmarshal(wireFormat);
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
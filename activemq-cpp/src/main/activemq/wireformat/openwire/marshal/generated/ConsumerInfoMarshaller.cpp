@@ -195,6 +195,99 @@ void ConsumerInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStruc
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ConsumerInfoMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    ConsumerInfo* info =
+        static_cast<ConsumerInfo*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    info->setConsumerId(Pointer<ConsumerId>(dynamic_cast<ConsumerId* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    info->setBrowser(bs->readBoolean());
+    info->setDestination(Pointer<ActiveMQDestination>(dynamic_cast<ActiveMQDestination* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    info->setPrefetchSize(dataIn->readInt());
+    info->setMaximumPendingMessageLimit(dataIn->readInt());
+    info->setDispatchAsync(bs->readBoolean());
+    info->setSelector(tightUnmarshalString(dataIn, bs));
+    if (wireVersion >= 10) {
+        info->setClientId(tightUnmarshalString(dataIn, bs));
+    }
+    info->setSubscriptionName(tightUnmarshalString(dataIn, bs));
+    info->setNoLocal(bs->readBoolean());
+    info->setExclusive(bs->readBoolean());
+    info->setRetroactive(bs->readBoolean());
+    info->setPriority(dataIn->readByte());
+
+    if (bs->readBoolean()) {
+        short size = dataIn->readShort();
+        info->getBrokerPath().reserve(size);
+        for (int i = 0; i < size; i++) {
+            info->getBrokerPath().push_back(Pointer<BrokerId>(dynamic_cast<BrokerId*>(
+                tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+        }
+    } else {
+        info->getBrokerPath().clear();
+    }
+    info->setAdditionalPredicate(Pointer<BooleanExpression>(dynamic_cast<BooleanExpression* >(
+        tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+    info->setNetworkSubscription(bs->readBoolean());
+    info->setOptimizedAcknowledge(bs->readBoolean());
+    info->setNoRangeAcks(bs->readBoolean());
+    if (wireVersion >= 4) {
+
+        if (bs->readBoolean()) {
+            short size = dataIn->readShort();
+            info->getNetworkConsumerPath().reserve(size);
+            for (int i = 0; i < size; i++) {
+                info->getNetworkConsumerPath().push_back(Pointer<ConsumerId>(dynamic_cast<ConsumerId*>(
+                    tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+            }
+        } else {
+            info->getNetworkConsumerPath().clear();
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ConsumerInfoMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    ConsumerInfo* info =
+        static_cast<ConsumerInfo*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    tightMarshalCachedObject2(wireFormat, info->getConsumerId().get(), dataOut, bs);
+    bs->readBoolean();
+    tightMarshalCachedObject2(wireFormat, info->getDestination().get(), dataOut, bs);
+    dataOut->writeInt(info->getPrefetchSize());
+    dataOut->writeInt(info->getMaximumPendingMessageLimit());
+    bs->readBoolean();
+    tightMarshalString2(info->getSelector(), dataOut, bs);
+    if (wireVersion >= 10) {
+        tightMarshalString2(info->getClientId(), dataOut, bs);
+    }
+    tightMarshalString2(info->getSubscriptionName(), dataOut, bs);
+    bs->readBoolean();
+    bs->readBoolean();
+    bs->readBoolean();
+    dataOut->write(info->getPriority());
+    tightMarshalObjectArray2(wireFormat, info->getBrokerPath(), dataOut, bs);
+    tightMarshalNestedObject2(wireFormat, info->getAdditionalPredicate().get(), dataOut, bs);
+    bs->readBoolean();
+    bs->readBoolean();
+    bs->readBoolean();
+    if (wireVersion >= 4) {
+        tightMarshalObjectArray2(wireFormat, info->getNetworkConsumerPath(), dataOut, bs);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ConsumerInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -100,6 +100,26 @@ void ControlCommandMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStr
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ControlCommandMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    ControlCommand* info =
+        static_cast<ControlCommand*>(dataStructure);
+    info->setCommand(tightUnmarshalString(dataIn, bs));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ControlCommandMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    ControlCommand* info =
+        static_cast<ControlCommand*>(dataStructure);
+    tightMarshalString2(info->getCommand(), dataOut, bs);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ControlCommandMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
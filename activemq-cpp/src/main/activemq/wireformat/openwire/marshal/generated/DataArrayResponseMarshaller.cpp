@@ -110,6 +110,36 @@ void DataArrayResponseMarshaller::tightMarshal2(OpenWireFormat* wireFormat, Data
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void DataArrayResponseMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    ResponseMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    DataArrayResponse* info =
+        static_cast<DataArrayResponse*>(dataStructure);
+
+    if (bs->readBoolean()) {
+        short size = dataIn->readShort();
+        info->getData().reserve(size);
+        for (int i = 0; i < size; i++) {
+            info->getData().push_back(Pointer<DataStructure>(dynamic_cast<DataStructure*>(
+                tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+        }
+    } else {
+        info->getData().clear();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void DataArrayResponseMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    ResponseMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    DataArrayResponse* info =
+        static_cast<DataArrayResponse*>(dataStructure);
+    tightMarshalObjectArray2(wireFormat, info->getData(), dataOut, bs);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void DataArrayResponseMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
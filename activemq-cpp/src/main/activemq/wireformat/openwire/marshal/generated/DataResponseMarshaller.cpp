@@ -101,6 +101,27 @@ void DataResponseMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStruc
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void DataResponseMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    ResponseMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    DataResponse* info =
+        static_cast<DataResponse*>(dataStructure);
+    info->setData(Pointer<DataStructure>(dynamic_cast<DataStructure* >(
+        tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void DataResponseMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    ResponseMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    DataResponse* info =
+        static_cast<DataResponse*>(dataStructure);
+    tightMarshalNestedObject2(wireFormat, info->getData().get(), dataOut, bs);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void DataResponseMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -123,6 +123,46 @@ void DestinationInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataSt
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void DestinationInfoMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    DestinationInfo* info =
+        static_cast<DestinationInfo*>(dataStructure);
+    info->setConnectionId(Pointer<ConnectionId>(dynamic_cast<ConnectionId* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    info->setDestination(Pointer<ActiveMQDestination>(dynamic_cast<ActiveMQDestination* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    info->setOperationType(dataIn->readByte());
+    info->setTimeout(tightUnmarshalLong(wireFormat, dataIn, bs));
+
+    if (bs->readBoolean()) {
+        short size = dataIn->readShort();
+        info->getBrokerPath().reserve(size);
+        for (int i = 0; i < size; i++) {
+            info->getBrokerPath().push_back(Pointer<BrokerId>(dynamic_cast<BrokerId*>(
+                tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+        }
+    } else {
+        info->getBrokerPath().clear();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void DestinationInfoMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    DestinationInfo* info =
+        static_cast<DestinationInfo*>(dataStructure);
+    tightMarshalCachedObject2(wireFormat, info->getConnectionId().get(), dataOut, bs);
+    tightMarshalCachedObject2(wireFormat, info->getDestination().get(), dataOut, bs);
+    dataOut->write(info->getOperationType());
+    tightMarshalLong2(wireFormat, info->getTimeout(), dataOut, bs);
+    tightMarshalObjectArray2(wireFormat, info->getBrokerPath(), dataOut, bs);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void DestinationInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
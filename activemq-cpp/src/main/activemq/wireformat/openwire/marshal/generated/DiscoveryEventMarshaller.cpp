@@ -103,6 +103,28 @@ void DiscoveryEventMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStr
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void DiscoveryEventMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    DiscoveryEvent* info =
+        static_cast<DiscoveryEvent*>(dataStructure);
+    info->setServiceName(tightUnmarshalString(dataIn, bs));
+    info->setBrokerName(tightUnmarshalString(dataIn, bs));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void DiscoveryEventMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    DiscoveryEvent* info =
+        static_cast<DiscoveryEvent*>(dataStructure);
+    tightMarshalString2(info->getServiceName(), dataOut, bs);
+    tightMarshalString2(info->getBrokerName(), dataOut, bs);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void DiscoveryEventMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
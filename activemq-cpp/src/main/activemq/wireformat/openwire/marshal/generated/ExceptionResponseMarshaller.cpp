@@ -101,6 +101,27 @@ void ExceptionResponseMarshaller::tightMarshal2(OpenWireFormat* wireFormat, Data
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ExceptionResponseMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    ResponseMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    ExceptionResponse* info =
+        static_cast<ExceptionResponse*>(dataStructure);
+    info->setException(Pointer<BrokerError>(dynamic_cast<BrokerError* >(
+        tightUnmarshalBrokerError(wireFormat, dataIn, bs))));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ExceptionResponseMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    ResponseMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    ExceptionResponse* info =
+        static_cast<ExceptionResponse*>(dataStructure);
+    tightMarshalBrokerError2(wireFormat, info->getException().get(), dataOut, bs);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ExceptionResponseMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
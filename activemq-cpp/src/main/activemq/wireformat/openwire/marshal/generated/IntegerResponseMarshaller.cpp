@@ -96,6 +96,26 @@ void IntegerResponseMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataSt
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void IntegerResponseMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    ResponseMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    IntegerResponse* info =
+        static_cast<IntegerResponse*>(dataStructure);
+    info->setResult(dataIn->readInt());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void IntegerResponseMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    ResponseMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    IntegerResponse* info =
+        static_cast<IntegerResponse*>(dataStructure);
+    dataOut->writeInt(info->getResult());
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void IntegerResponseMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
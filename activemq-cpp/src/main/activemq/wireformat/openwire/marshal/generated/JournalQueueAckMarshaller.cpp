@@ -105,6 +105,30 @@ void JournalQueueAckMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataSt
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void JournalQueueAckMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    JournalQueueAck* info =
+        static_cast<JournalQueueAck*>(dataStructure);
+    info->setDestination(Pointer<ActiveMQDestination>(dynamic_cast<ActiveMQDestination* >(
+        tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+    info->setMessageAck(Pointer<MessageAck>(dynamic_cast<MessageAck* >(
+        tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void JournalQueueAckMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    JournalQueueAck* info =
+        static_cast<JournalQueueAck*>(dataStructure);
+    tightMarshalNestedObject2(wireFormat, info->getDestination().get(), dataOut, bs);
+    tightMarshalNestedObject2(wireFormat, info->getMessageAck().get(), dataOut, bs);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void JournalQueueAckMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -118,6 +118,39 @@ void JournalTopicAckMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataSt
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void JournalTopicAckMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    JournalTopicAck* info =
+        static_cast<JournalTopicAck*>(dataStructure);
+    info->setDestination(Pointer<ActiveMQDestination>(dynamic_cast<ActiveMQDestination* >(
+        tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+    info->setMessageId(Pointer<MessageId>(dynamic_cast<MessageId* >(
+        tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+    info->setMessageSequenceId(tightUnmarshalLong(wireFormat, dataIn, bs));
+    info->setSubscritionName(tightUnmarshalString(dataIn, bs));
+    info->setClientId(tightUnmarshalString(dataIn, bs));
+    info->setTransactionId(Pointer<TransactionId>(dynamic_cast<TransactionId* >(
+        tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void JournalTopicAckMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    JournalTopicAck* info =
+        static_cast<JournalTopicAck*>(dataStructure);
+    tightMarshalNestedObject2(wireFormat, info->getDestination().get(), dataOut, bs);
+    tightMarshalNestedObject2(wireFormat, info->getMessageId().get(), dataOut, bs);
+    tightMarshalLong2(wireFormat, info->getMessageSequenceId(), dataOut, bs);
+    tightMarshalString2(info->getSubscritionName(), dataOut, bs);
+    tightMarshalString2(info->getClientId(), dataOut, bs);
+    tightMarshalNestedObject2(wireFormat, info->getTransactionId().get(), dataOut, bs);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void JournalTopicAckMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
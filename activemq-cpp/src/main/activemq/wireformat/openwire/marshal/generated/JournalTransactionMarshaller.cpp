@@ -106,6 +106,31 @@ void JournalTransactionMarshaller::tightMarshal2(OpenWireFormat* wireFormat, Dat
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void JournalTransactionMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    JournalTransaction* info =
+        static_cast<JournalTransaction*>(dataStructure);
+    info->setTransactionId(Pointer<TransactionId>(dynamic_cast<TransactionId* >(
+        tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+    info->setType(dataIn->readByte());
+    info->setWasPrepared(bs->readBoolean());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void JournalTransactionMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    JournalTransaction* info =
+        static_cast<JournalTransaction*>(dataStructure);
+    tightMarshalNestedObject2(wireFormat, info->getTransactionId().get(), dataOut, bs);
+    dataOut->write(info->getType());
+    bs->readBoolean();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void JournalTransactionMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -104,6 +104,29 @@ void LocalTransactionIdMarshaller::tightMarshal2(OpenWireFormat* wireFormat, Dat
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void LocalTransactionIdMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    TransactionIdMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    LocalTransactionId* info =
+        static_cast<LocalTransactionId*>(dataStructure);
+    info->setValue(tightUnmarshalLong(wireFormat, dataIn, bs));
+    info->setConnectionId(Pointer<ConnectionId>(dynamic_cast<ConnectionId* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void LocalTransactionIdMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    TransactionIdMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    LocalTransactionId* info =
+        static_cast<LocalTransactionId*>(dataStructure);
+    tightMarshalLong2(wireFormat, info->getValue(), dataOut, bs);
+    tightMarshalCachedObject2(wireFormat, info->getConnectionId().get(), dataOut, bs);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void LocalTransactionIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
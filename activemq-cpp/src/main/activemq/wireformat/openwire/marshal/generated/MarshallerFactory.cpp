@@ -92,61 +92,61 @@ using namespace activemq::wireformat::openwire::marshal::generated;
 ///////////////////////////////////////////////////////////////////////////////
 void MarshallerFactory::configure(OpenWireFormat* format) {
 
-    format->addMarshaller(new ActiveMQBlobMessageMarshaller());
-    format->addMarshaller(new ActiveMQBytesMessageMarshaller());
-    format->addMarshaller(new ActiveMQMapMessageMarshaller());
-    format->addMarshaller(new ActiveMQMessageMarshaller());
-    format->addMarshaller(new ActiveMQObjectMessageMarshaller());
-    format->addMarshaller(new ActiveMQQueueMarshaller());
-    format->addMarshaller(new ActiveMQStreamMessageMarshaller());
-    format->addMarshaller(new ActiveMQTempQueueMarshaller());
-    format->addMarshaller(new ActiveMQTempTopicMarshaller());
-    format->addMarshaller(new ActiveMQTextMessageMarshaller());
-    format->addMarshaller(new ActiveMQTopicMarshaller());
-    format->addMarshaller(new BrokerIdMarshaller());
-    format->addMarshaller(new BrokerInfoMarshaller());
-    format->addMarshaller(new ConnectionControlMarshaller());
-    format->addMarshaller(new ConnectionErrorMarshaller());
-    format->addMarshaller(new ConnectionIdMarshaller());
-    format->addMarshaller(new ConnectionInfoMarshaller());
-    format->addMarshaller(new ConsumerControlMarshaller());
-    format->addMarshaller(new ConsumerIdMarshaller());
-    format->addMarshaller(new ConsumerInfoMarshaller());
-    format->addMarshaller(new ControlCommandMarshaller());
-    format->addMarshaller(new DataArrayResponseMarshaller());
-    format->addMarshaller(new DataResponseMarshaller());
-    format->addMarshaller(new DestinationInfoMarshaller());
-    format->addMarshaller(new DiscoveryEventMarshaller());
-    format->addMarshaller(new ExceptionResponseMarshaller());
-    format->addMarshaller(new FlushCommandMarshaller());
-    format->addMarshaller(new IntegerResponseMarshaller());
-    format->addMarshaller(new JournalQueueAckMarshaller());
-    format->addMarshaller(new JournalTopicAckMarshaller());
-    format->addMarshaller(new JournalTraceMarshaller());
-    format->addMarshaller(new JournalTransactionMarshaller());
-    format->addMarshaller(new KeepAliveInfoMarshaller());
-    format->addMarshaller(new LastPartialCommandMarshaller());
-    format->addMarshaller(new LocalTransactionIdMarshaller());
-    format->addMarshaller(new MessageAckMarshaller());
-    format->addMarshaller(new MessageDispatchMarshaller());
-    format->addMarshaller(new MessageDispatchNotificationMarshaller());
-    format->addMarshaller(new MessageIdMarshaller());
-    format->addMarshaller(new MessagePullMarshaller());
-    format->addMarshaller(new NetworkBridgeFilterMarshaller());
-    format->addMarshaller(new PartialCommandMarshaller());
-    format->addMarshaller(new ProducerAckMarshaller());
-    format->addMarshaller(new ProducerIdMarshaller());
-    format->addMarshaller(new ProducerInfoMarshaller());
-    format->addMarshaller(new RemoveInfoMarshaller());
-    format->addMarshaller(new RemoveSubscriptionInfoMarshaller());
-    format->addMarshaller(new ReplayCommandMarshaller());
-    format->addMarshaller(new ResponseMarshaller());
-    format->addMarshaller(new SessionIdMarshaller());
-    format->addMarshaller(new SessionInfoMarshaller());
-    format->addMarshaller(new ShutdownInfoMarshaller());
-    format->addMarshaller(new SubscriptionInfoMarshaller());
-    format->addMarshaller(new TransactionInfoMarshaller());
-    format->addMarshaller(new WireFormatInfoMarshaller());
-    format->addMarshaller(new XATransactionIdMarshaller());
+    format->addMarshaller(new ActiveMQBlobMessageMarshaller(), &ActiveMQBlobMessageMarshaller::fastTightUnmarshal, &ActiveMQBlobMessageMarshaller::fastTightMarshal2);
+    format->addMarshaller(new ActiveMQBytesMessageMarshaller(), &ActiveMQBytesMessageMarshaller::fastTightUnmarshal, &ActiveMQBytesMessageMarshaller::fastTightMarshal2);
+    format->addMarshaller(new ActiveMQMapMessageMarshaller(), &ActiveMQMapMessageMarshaller::fastTightUnmarshal, &ActiveMQMapMessageMarshaller::fastTightMarshal2);
+    format->addMarshaller(new ActiveMQMessageMarshaller(), &ActiveMQMessageMarshaller::fastTightUnmarshal, &ActiveMQMessageMarshaller::fastTightMarshal2);
+    format->addMarshaller(new ActiveMQObjectMessageMarshaller(), &ActiveMQObjectMessageMarshaller::fastTightUnmarshal, &ActiveMQObjectMessageMarshaller::fastTightMarshal2);
+    format->addMarshaller(new ActiveMQQueueMarshaller(), &ActiveMQQueueMarshaller::fastTightUnmarshal, &ActiveMQQueueMarshaller::fastTightMarshal2);
+    format->addMarshaller(new ActiveMQStreamMessageMarshaller(), &ActiveMQStreamMessageMarshaller::fastTightUnmarshal, &ActiveMQStreamMessageMarshaller::fastTightMarshal2);
+    format->addMarshaller(new ActiveMQTempQueueMarshaller(), &ActiveMQTempQueueMarshaller::fastTightUnmarshal, &ActiveMQTempQueueMarshaller::fastTightMarshal2);
+    format->addMarshaller(new ActiveMQTempTopicMarshaller(), &ActiveMQTempTopicMarshaller::fastTightUnmarshal, &ActiveMQTempTopicMarshaller::fastTightMarshal2);
+    format->addMarshaller(new ActiveMQTextMessageMarshaller(), &ActiveMQTextMessageMarshaller::fastTightUnmarshal, &ActiveMQTextMessageMarshaller::fastTightMarshal2);
+    format->addMarshaller(new ActiveMQTopicMarshaller(), &ActiveMQTopicMarshaller::fastTightUnmarshal, &ActiveMQTopicMarshaller::fastTightMarshal2);
+    format->addMarshaller(new BrokerIdMarshaller(), &BrokerIdMarshaller::fastTightUnmarshal, &BrokerIdMarshaller::fastTightMarshal2);
+    format->addMarshaller(new BrokerInfoMarshaller(), &BrokerInfoMarshaller::fastTightUnmarshal, &BrokerInfoMarshaller::fastTightMarshal2);
+    format->addMarshaller(new ConnectionControlMarshaller(), &ConnectionControlMarshaller::fastTightUnmarshal, &ConnectionControlMarshaller::fastTightMarshal2);
+    format->addMarshaller(new ConnectionErrorMarshaller(), &ConnectionErrorMarshaller::fastTightUnmarshal, &ConnectionErrorMarshaller::fastTightMarshal2);
+    format->addMarshaller(new ConnectionIdMarshaller(), &ConnectionIdMarshaller::fastTightUnmarshal, &ConnectionIdMarshaller::fastTightMarshal2);
+    format->addMarshaller(new ConnectionInfoMarshaller(), &ConnectionInfoMarshaller::fastTightUnmarshal, &ConnectionInfoMarshaller::fastTightMarshal2);
+    format->addMarshaller(new ConsumerControlMarshaller(), &ConsumerControlMarshaller::fastTightUnmarshal, &ConsumerControlMarshaller::fastTightMarshal2);
+    format->addMarshaller(new ConsumerIdMarshaller(), &ConsumerIdMarshaller::fastTightUnmarshal, &ConsumerIdMarshaller::fastTightMarshal2);
+    format->addMarshaller(new ConsumerInfoMarshaller(), &ConsumerInfoMarshaller::fastTightUnmarshal, &ConsumerInfoMarshaller::fastTightMarshal2);
+    format->addMarshaller(new ControlCommandMarshaller(), &ControlCommandMarshaller::fastTightUnmarshal, &ControlCommandMarshaller::fastTightMarshal2);
+    format->addMarshaller(new DataArrayResponseMarshaller(), &DataArrayResponseMarshaller::fastTightUnmarshal, &DataArrayResponseMarshaller::fastTightMarshal2);
+    format->addMarshaller(new DataResponseMarshaller(), &DataResponseMarshaller::fastTightUnmarshal, &DataResponseMarshaller::fastTightMarshal2);
+    format->addMarshaller(new DestinationInfoMarshaller(), &DestinationInfoMarshaller::fastTightUnmarshal, &DestinationInfoMarshaller::fastTightMarshal2);
+    format->addMarshaller(new DiscoveryEventMarshaller(), &DiscoveryEventMarshaller::fastTightUnmarshal, &DiscoveryEventMarshaller::fastTightMarshal2);
+    format->addMarshaller(new ExceptionResponseMarshaller(), &ExceptionResponseMarshaller::fastTightUnmarshal, &ExceptionResponseMarshaller::fastTightMarshal2);
+    format->addMarshaller(new FlushCommandMarshaller(), &FlushCommandMarshaller::fastTightUnmarshal, &FlushCommandMarshaller::fastTightMarshal2);
+    format->addMarshaller(new IntegerResponseMarshaller(), &IntegerResponseMarshaller::fastTightUnmarshal, &IntegerResponseMarshaller::fastTightMarshal2);
+    format->addMarshaller(new JournalQueueAckMarshaller(), &JournalQueueAckMarshaller::fastTightUnmarshal, &JournalQueueAckMarshaller::fastTightMarshal2);
+    format->addMarshaller(new JournalTopicAckMarshaller(), &JournalTopicAckMarshaller::fastTightUnmarshal, &JournalTopicAckMarshaller::fastTightMarshal2);
+    format->addMarshaller(new JournalTraceMarshaller(), &JournalTraceMarshaller::fastTightUnmarshal, &JournalTraceMarshaller::fastTightMarshal2);
+    format->addMarshaller(new JournalTransactionMarshaller(), &JournalTransactionMarshaller::fastTightUnmarshal, &JournalTransactionMarshaller::fastTightMarshal2);
+    format->addMarshaller(new KeepAliveInfoMarshaller(), &KeepAliveInfoMarshaller::fastTightUnmarshal, &KeepAliveInfoMarshaller::fastTightMarshal2);
+    format->addMarshaller(new LastPartialCommandMarshaller(), &LastPartialCommandMarshaller::fastTightUnmarshal, &LastPartialCommandMarshaller::fastTightMarshal2);
+    format->addMarshaller(new LocalTransactionIdMarshaller(), &LocalTransactionIdMarshaller::fastTightUnmarshal, &LocalTransactionIdMarshaller::fastTightMarshal2);
+    format->addMarshaller(new MessageAckMarshaller(), &MessageAckMarshaller::fastTightUnmarshal, &MessageAckMarshaller::fastTightMarshal2);
+    format->addMarshaller(new MessageDispatchMarshaller(), &MessageDispatchMarshaller::fastTightUnmarshal, &MessageDispatchMarshaller::fastTightMarshal2);
+    format->addMarshaller(new MessageDispatchNotificationMarshaller(), &MessageDispatchNotificationMarshaller::fastTightUnmarshal, &MessageDispatchNotificationMarshaller::fastTightMarshal2);
+    format->addMarshaller(new MessageIdMarshaller(), &MessageIdMarshaller::fastTightUnmarshal, &MessageIdMarshaller::fastTightMarshal2);
+    format->addMarshaller(new MessagePullMarshaller(), &MessagePullMarshaller::fastTightUnmarshal, &MessagePullMarshaller::fastTightMarshal2);
+    format->addMarshaller(new NetworkBridgeFilterMarshaller(), &NetworkBridgeFilterMarshaller::fastTightUnmarshal, &NetworkBridgeFilterMarshaller::fastTightMarshal2);
+    format->addMarshaller(new PartialCommandMarshaller(), &PartialCommandMarshaller::fastTightUnmarshal, &PartialCommandMarshaller::fastTightMarshal2);
+    format->addMarshaller(new ProducerAckMarshaller(), &ProducerAckMarshaller::fastTightUnmarshal, &ProducerAckMarshaller::fastTightMarshal2);
+    format->addMarshaller(new ProducerIdMarshaller(), &ProducerIdMarshaller::fastTightUnmarshal, &ProducerIdMarshaller::fastTightMarshal2);
+    format->addMarshaller(new ProducerInfoMarshaller(), &ProducerInfoMarshaller::fastTightUnmarshal, &ProducerInfoMarshaller::fastTightMarshal2);
+    format->addMarshaller(new RemoveInfoMarshaller(), &RemoveInfoMarshaller::fastTightUnmarshal, &RemoveInfoMarshaller::fastTightMarshal2);
+    format->addMarshaller(new RemoveSubscriptionInfoMarshaller(), &RemoveSubscriptionInfoMarshaller::fastTightUnmarshal, &RemoveSubscriptionInfoMarshaller::fastTightMarshal2);
+    format->addMarshaller(new ReplayCommandMarshaller(), &ReplayCommandMarshaller::fastTightUnmarshal, &ReplayCommandMarshaller::fastTightMarshal2);
+    format->addMarshaller(new ResponseMarshaller(), &ResponseMarshaller::fastTightUnmarshal, &ResponseMarshaller::fastTightMarshal2);
+    format->addMarshaller(new SessionIdMarshaller(), &SessionIdMarshaller::fastTightUnmarshal, &SessionIdMarshaller::fastTightMarshal2);
+    format->addMarshaller(new SessionInfoMarshaller(), &SessionInfoMarshaller::fastTightUnmarshal, &SessionInfoMarshaller::fastTightMarshal2);
+    format->addMarshaller(new ShutdownInfoMarshaller(), &ShutdownInfoMarshaller::fastTightUnmarshal, &ShutdownInfoMarshaller::fastTightMarshal2);
+    format->addMarshaller(new SubscriptionInfoMarshaller(), &SubscriptionInfoMarshaller::fastTightUnmarshal, &SubscriptionInfoMarshaller::fastTightMarshal2);
+    format->addMarshaller(new TransactionInfoMarshaller(), &TransactionInfoMarshaller::fastTightUnmarshal, &TransactionInfoMarshaller::fastTightMarshal2);
+    format->addMarshaller(new WireFormatInfoMarshaller(), &WireFormatInfoMarshaller::fastTightUnmarshal, &WireFormatInfoMarshaller::fastTightMarshal2);
+    format->addMarshaller(new XATransactionIdMarshaller(), &XATransactionIdMarshaller::fastTightUnmarshal, &XATransactionIdMarshaller::fastTightMarshal2);
 }
 
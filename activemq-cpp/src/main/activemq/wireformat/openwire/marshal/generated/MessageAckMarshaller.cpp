@@ -140,6 +140,56 @@ void MessageAckMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStructu
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void MessageAckMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    MessageAck* info =
+        static_cast<MessageAck*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    info->setDestination(Pointer<ActiveMQDestination>(dynamic_cast<ActiveMQDestination* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    info->setTransactionId(Pointer<TransactionId>(dynamic_cast<TransactionId* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    info->setConsumerId(Pointer<ConsumerId>(dynamic_cast<ConsumerId* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    info->setAckType(dataIn->readByte());
+    info->setFirstMessageId(Pointer<MessageId>(dynamic_cast<MessageId* >(
+        tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+    info->setLastMessageId(Pointer<MessageId>(dynamic_cast<MessageId* >(
+        tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+    info->setMessageCount(dataIn->readInt());
+    if (wireVersion >= 7) {
+        info->setPoisonCause(Pointer<BrokerError>(dynamic_cast<BrokerError* >(
+            tightUnmarshalBrokerError(wireFormat, dataIn, bs))));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void MessageAckMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    MessageAck* info =
+        static_cast<MessageAck*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    tightMarshalCachedObject2(wireFormat, info->getDestination().get(), dataOut, bs);
+    tightMarshalCachedObject2(wireFormat, info->getTransactionId().get(), dataOut, bs);
+    tightMarshalCachedObject2(wireFormat, info->getConsumerId().get(), dataOut, bs);
+    dataOut->write(info->getAckType());
+    tightMarshalNestedObject2(wireFormat, info->getFirstMessageId().get(), dataOut, bs);
+    tightMarshalNestedObject2(wireFormat, info->getLastMessageId().get(), dataOut, bs);
+    dataOut->writeInt(info->getMessageCount());
+    if (wireVersion >= 7) {
+        tightMarshalBrokerError2(wireFormat, info->getPoisonCause().get(), dataOut, bs);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void MessageAckMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
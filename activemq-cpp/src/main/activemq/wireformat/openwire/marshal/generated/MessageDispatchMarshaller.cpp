@@ -111,6 +111,35 @@ void MessageDispatchMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataSt
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void MessageDispatchMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    MessageDispatch* info =
+        static_cast<MessageDispatch*>(dataStructure);
+    info->setConsumerId(Pointer<ConsumerId>(dynamic_cast<ConsumerId* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    info->setDestination(Pointer<ActiveMQDestination>(dynamic_cast<ActiveMQDestination* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    info->setMessage(Pointer<Message>(dynamic_cast<Message* >(
+        tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+    info->setRedeliveryCounter(dataIn->readInt());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void MessageDispatchMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    MessageDispatch* info =
+        static_cast<MessageDispatch*>(dataStructure);
+    tightMarshalCachedObject2(wireFormat, info->getConsumerId().get(), dataOut, bs);
+    tightMarshalCachedObject2(wireFormat, info->getDestination().get(), dataOut, bs);
+    tightMarshalNestedObject2(wireFormat, info->getMessage().get(), dataOut, bs);
+    dataOut->writeInt(info->getRedeliveryCounter());
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void MessageDispatchMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -112,6 +112,35 @@ void MessageDispatchNotificationMarshaller::tightMarshal2(OpenWireFormat* wireFo
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void MessageDispatchNotificationMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    MessageDispatchNotification* info =
+        static_cast<MessageDispatchNotification*>(dataStructure);
+    info->setConsumerId(Pointer<ConsumerId>(dynamic_cast<ConsumerId* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    info->setDestination(Pointer<ActiveMQDestination>(dynamic_cast<ActiveMQDestination* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    info->setDeliverySequenceId(tightUnmarshalLong(wireFormat, dataIn, bs));
+    info->setMessageId(Pointer<MessageId>(dynamic_cast<MessageId* >(
+        tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void MessageDispatchNotificationMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    MessageDispatchNotification* info =
+        static_cast<MessageDispatchNotification*>(dataStructure);
+    tightMarshalCachedObject2(wireFormat, info->getConsumerId().get(), dataOut, bs);
+    tightMarshalCachedObject2(wireFormat, info->getDestination().get(), dataOut, bs);
+    tightMarshalLong2(wireFormat, info->getDeliverySequenceId(), dataOut, bs);
+    tightMarshalNestedObject2(wireFormat, info->getMessageId().get(), dataOut, bs);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void MessageDispatchNotificationMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -69,6 +69,8 @@ void MessageIdMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataStructu
             tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
         info->setProducerSequenceId(tightUnmarshalLong(wireFormat, dataIn, bs));
         info->setBrokerSequenceId(tightUnmarshalLong(wireFormat, dataIn, bs));
+
+        info->afterUnmarshal( wireFormat );
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
@@ -125,6 +127,45 @@ void MessageIdMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStructur
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void MessageIdMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    MessageId* info =
+        static_cast<MessageId*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    if (wireVersion >= 10) {
+        info->setTextView(tightUnmarshalString(dataIn, bs));
+    }
+    info->setProducerId(Pointer<ProducerId>(dynamic_cast<ProducerId* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    info->setProducerSequenceId(tightUnmarshalLong(wireFormat, dataIn, bs));
+    info->setBrokerSequenceId(tightUnmarshalLong(wireFormat, dataIn, bs));
+
+    info->afterUnmarshal( wireFormat );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void MessageIdMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    MessageId* info =
+        static_cast<MessageId*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    if (wireVersion >= 10) {
+        tightMarshalString2(info->getTextView(), dataOut, bs);
+    }
+    tightMarshalCachedObject2(wireFormat, info->getProducerId().get(), dataOut, bs);
+    tightMarshalLong2(wireFormat, info->getProducerSequenceId(), dataOut, bs);
+    tightMarshalLong2(wireFormat, info->getBrokerSequenceId(), dataOut, bs);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void MessageIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -143,6 +184,7 @@ void MessageIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructu
             looseUnmarshalCachedObject(wireFormat, dataIn))));
         info->setProducerSequenceId(looseUnmarshalLong(wireFormat, dataIn));
         info->setBrokerSequenceId(looseUnmarshalLong(wireFormat, dataIn));
+        info->afterUnmarshal(wireFormat);
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
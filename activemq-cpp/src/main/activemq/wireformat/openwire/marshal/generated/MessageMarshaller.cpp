@@ -250,6 +250,145 @@ void MessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStructure*
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void MessageMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    Message* info =
+        static_cast<Message*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    info->setProducerId(Pointer<ProducerId>(dynamic_cast<ProducerId* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    info->setDestination(Pointer<ActiveMQDestination>(dynamic_cast<ActiveMQDestination* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    info->setTransactionId(Pointer<TransactionId>(dynamic_cast<TransactionId* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    info->setOriginalDestination(Pointer<ActiveMQDestination>(dynamic_cast<ActiveMQDestination* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    info->setMessageId(Pointer<MessageId>(dynamic_cast<MessageId* >(
+        tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+    info->setOriginalTransactionId(Pointer<TransactionId>(dynamic_cast<TransactionId* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    info->setGroupID(tightUnmarshalString(dataIn, bs));
+    info->setGroupSequence(dataIn->readInt());
+    info->setCorrelationId(tightUnmarshalString(dataIn, bs));
+    info->setPersistent(bs->readBoolean());
+    info->setExpiration(tightUnmarshalLong(wireFormat, dataIn, bs));
+    info->setPriority(dataIn->readByte());
+    info->setReplyTo(Pointer<ActiveMQDestination>(dynamic_cast<ActiveMQDestination* >(
+        tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+    info->setTimestamp(tightUnmarshalLong(wireFormat, dataIn, bs));
+    info->setType(tightUnmarshalString(dataIn, bs));
+    info->setContent(tightUnmarshalByteArray(dataIn, bs));
+    info->setMarshalledProperties(tightUnmarshalByteArray(dataIn, bs));
+    info->setDataStructure(Pointer<DataStructure>(dynamic_cast<DataStructure* >(
+        tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+    info->setTargetConsumerId(Pointer<ConsumerId>(dynamic_cast<ConsumerId* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    info->setCompressed(bs->readBoolean());
+    info->setRedeliveryCounter(dataIn->readInt());
+
+    if (bs->readBoolean()) {
+        short size = dataIn->readShort();
+        info->getBrokerPath().reserve(size);
+        for (int i = 0; i < size; i++) {
+            info->getBrokerPath().push_back(Pointer<BrokerId>(dynamic_cast<BrokerId*>(
+                tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+        }
+    } else {
+        info->getBrokerPath().clear();
+    }
+    info->setArrival(tightUnmarshalLong(wireFormat, dataIn, bs));
+    info->setUserID(tightUnmarshalString(dataIn, bs));
+    info->setRecievedByDFBridge(bs->readBoolean());
+    if (wireVersion >= 2) {
+        info->setDroppable(bs->readBoolean());
+    }
+    if (wireVersion >= 3) {
+
+        if (bs->readBoolean()) {
+            short size = dataIn->readShort();
+            info->getCluster().reserve(size);
+            for (int i = 0; i < size; i++) {
+                info->getCluster().push_back(Pointer<BrokerId>(dynamic_cast<BrokerId*>(
+                    tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+            }
+        } else {
+            info->getCluster().clear();
+        }
+    }
+    if (wireVersion >= 3) {
+        info->setBrokerInTime(tightUnmarshalLong(wireFormat, dataIn, bs));
+    }
+    if (wireVersion >= 3) {
+        info->setBrokerOutTime(tightUnmarshalLong(wireFormat, dataIn, bs));
+    }
+    if (wireVersion >= 10) {
+        info->setJMSXGroupFirstForConsumer(bs->readBoolean());
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void MessageMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    Message* info =
+        static_cast<Message*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    tightMarshalCachedObject2(wireFormat, info->getProducerId().get(), dataOut, bs);
+    tightMarshalCachedObject2(wireFormat, info->getDestination().get(), dataOut, bs);
+    tightMarshalCachedObject2(wireFormat, info->getTransactionId().get(), dataOut, bs);
+    tightMarshalCachedObject2(wireFormat, info->getOriginalDestination().get(), dataOut, bs);
+    tightMarshalNestedObject2(wireFormat, info->getMessageId().get(), dataOut, bs);
+    tightMarshalCachedObject2(wireFormat, info->getOriginalTransactionId().get(), dataOut, bs);
+    tightMarshalString2(info->getGroupID(), dataOut, bs);
+    dataOut->writeInt(info->getGroupSequence());
+    tightMarshalString2(info->getCorrelationId(), dataOut, bs);
+    bs->readBoolean();
+    tightMarshalLong2(wireFormat, info->getExpiration(), dataOut, bs);
+    dataOut->write(info->getPriority());
+    tightMarshalNestedObject2(wireFormat, info->getReplyTo().get(), dataOut, bs);
+    tightMarshalLong2(wireFormat, info->getTimestamp(), dataOut, bs);
+    tightMarshalString2(info->getType(), dataOut, bs);
+    if (bs->readBoolean()) {
+        dataOut->writeInt((int)info->getContent().size() );
+        dataOut->write((const unsigned char*)(&info->getContent()[0]), (int)info->getContent().size(), 0, (int)info->getContent().size());
+    }
+    if (bs->readBoolean()) {
+        dataOut->writeInt((int)info->getMarshalledProperties().size() );
+        dataOut->write((const unsigned char*)(&info->getMarshalledProperties()[0]), (int)info->getMarshalledProperties().size(), 0, (int)info->getMarshalledProperties().size());
+    }
+    tightMarshalNestedObject2(wireFormat, info->getDataStructure().get(), dataOut, bs);
+    tightMarshalCachedObject2(wireFormat, info->getTargetConsumerId().get(), dataOut, bs);
+    bs->readBoolean();
+    dataOut->writeInt(info->getRedeliveryCounter());
+    tightMarshalObjectArray2(wireFormat, info->getBrokerPath(), dataOut, bs);
+    tightMarshalLong2(wireFormat, info->getArrival(), dataOut, bs);
+    tightMarshalString2(info->getUserID(), dataOut, bs);
+    bs->readBoolean();
+    if (wireVersion >= 2) {
+        bs->readBoolean();
+    }
+    if (wireVersion >= 3) {
+        tightMarshalObjectArray2(wireFormat, info->getCluster(), dataOut, bs);
+    }
+    if (wireVersion >= 3) {
+        tightMarshalLong2(wireFormat, info->getBrokerInTime(), dataOut, bs);
+    }
+    if (wireVersion >= 3) {
+        tightMarshalLong2(wireFormat, info->getBrokerOutTime(), dataOut, bs);
+    }
+    if (wireVersion >= 10) {
+        bs->readBoolean();
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void MessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
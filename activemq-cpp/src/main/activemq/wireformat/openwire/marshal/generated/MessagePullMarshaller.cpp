@@ -136,6 +136,51 @@ void MessagePullMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStruct
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void MessagePullMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    MessagePull* info =
+        static_cast<MessagePull*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    info->setConsumerId(Pointer<ConsumerId>(dynamic_cast<ConsumerId* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    info->setDestination(Pointer<ActiveMQDestination>(dynamic_cast<ActiveMQDestination* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    info->setTimeout(tightUnmarshalLong(wireFormat, dataIn, bs));
+    if (wireVersion >= 3) {
+        info->setCorrelationId(tightUnmarshalString(dataIn, bs));
+    }
+    if (wireVersion >= 3) {
+        info->setMessageId(Pointer<MessageId>(dynamic_cast<MessageId* >(
+            tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void MessagePullMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    MessagePull* info =
+        static_cast<MessagePull*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    tightMarshalCachedObject2(wireFormat, info->getConsumerId().get(), dataOut, bs);
+    tightMarshalCachedObject2(wireFormat, info->getDestination().get(), dataOut, bs);
+    tightMarshalLong2(wireFormat, info->getTimeout(), dataOut, bs);
+    if (wireVersion >= 3) {
+        tightMarshalString2(info->getCorrelationId(), dataOut, bs);
+    }
+    if (wireVersion >= 3) {
+        tightMarshalNestedObject2(wireFormat, info->getMessageId().get(), dataOut, bs);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void MessagePullMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -126,6 +126,45 @@ void NetworkBridgeFilterMarshaller::tightMarshal2(OpenWireFormat* wireFormat, Da
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void NetworkBridgeFilterMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    NetworkBridgeFilter* info =
+        static_cast<NetworkBridgeFilter*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    info->setNetworkBrokerId(Pointer<BrokerId>(dynamic_cast<BrokerId* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    if (wireVersion >= 10) {
+        info->setMessageTTL(dataIn->readInt());
+    }
+    if (wireVersion >= 10) {
+        info->setConsumerTTL(dataIn->readInt());
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void NetworkBridgeFilterMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    NetworkBridgeFilter* info =
+        static_cast<NetworkBridgeFilter*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    tightMarshalCachedObject2(wireFormat, info->getNetworkBrokerId().get(), dataOut, bs);
+    if (wireVersion >= 10) {
+        dataOut->writeInt(info->getMessageTTL());
+    }
+    if (wireVersion >= 10) {
+        dataOut->writeInt(info->getConsumerTTL());
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void NetworkBridgeFilterMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
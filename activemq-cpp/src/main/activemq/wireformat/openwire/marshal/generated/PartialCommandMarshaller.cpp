@@ -106,6 +106,31 @@ void PartialCommandMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStr
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void PartialCommandMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    PartialCommand* info =
+        static_cast<PartialCommand*>(dataStructure);
+    info->setCommandId(dataIn->readInt());
+    info->setData(tightUnmarshalByteArray(dataIn, bs));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void PartialCommandMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    PartialCommand* info =
+        static_cast<PartialCommand*>(dataStructure);
+    dataOut->writeInt(info->getCommandId());
+    if (bs->readBoolean()) {
+        dataOut->writeInt((int)info->getData().size() );
+        dataOut->write((const unsigned char*)(&info->getData()[0]), (int)info->getData().size(), 0, (int)info->getData().size());
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void PartialCommandMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -124,6 +124,43 @@ void ProducerAckMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStruct
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ProducerAckMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    ProducerAck* info =
+        static_cast<ProducerAck*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    if (wireVersion >= 3) {
+        info->setProducerId(Pointer<ProducerId>(dynamic_cast<ProducerId* >(
+            tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+    }
+    if (wireVersion >= 3) {
+        info->setSize(dataIn->readInt());
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ProducerAckMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    ProducerAck* info =
+        static_cast<ProducerAck*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    if (wireVersion >= 3) {
+        tightMarshalNestedObject2(wireFormat, info->getProducerId().get(), dataOut, bs);
+    }
+    if (wireVersion >= 3) {
+        dataOut->writeInt(info->getSize());
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ProducerAckMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
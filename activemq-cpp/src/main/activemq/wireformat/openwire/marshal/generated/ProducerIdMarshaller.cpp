@@ -62,6 +62,8 @@ void ProducerIdMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataStruct
         info->setConnectionId(tightUnmarshalString(dataIn, bs));
         info->setValue(tightUnmarshalLong(wireFormat, dataIn, bs));
         info->setSessionId(tightUnmarshalLong(wireFormat, dataIn, bs));
+
+        info->afterUnmarshal( wireFormat );
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
@@ -106,6 +108,32 @@ void ProducerIdMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStructu
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ProducerIdMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    ProducerId* info =
+        static_cast<ProducerId*>(dataStructure);
+    info->setConnectionId(tightUnmarshalString(dataIn, bs));
+    info->setValue(tightUnmarshalLong(wireFormat, dataIn, bs));
+    info->setSessionId(tightUnmarshalLong(wireFormat, dataIn, bs));
+
+    info->afterUnmarshal( wireFormat );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ProducerIdMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    ProducerId* info =
+        static_cast<ProducerId*>(dataStructure);
+    tightMarshalString2(info->getConnectionId(), dataOut, bs);
+    tightMarshalLong2(wireFormat, info->getValue(), dataOut, bs);
+    tightMarshalLong2(wireFormat, info->getSessionId(), dataOut, bs);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ProducerIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -117,6 +145,7 @@ void ProducerIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStruct
         info->setConnectionId(looseUnmarshalString(dataIn));
         info->setValue(looseUnmarshalLong(wireFormat, dataIn));
         info->setSessionId(looseUnmarshalLong(wireFormat, dataIn));
+        info->afterUnmarshal(wireFormat);
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
@@ -144,6 +144,60 @@ void ProducerInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStruc
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ProducerInfoMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    ProducerInfo* info =
+        static_cast<ProducerInfo*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    info->setProducerId(Pointer<ProducerId>(dynamic_cast<ProducerId* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    info->setDestination(Pointer<ActiveMQDestination>(dynamic_cast<ActiveMQDestination* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+
+    if (bs->readBoolean()) {
+        short size = dataIn->readShort();
+        info->getBrokerPath().reserve(size);
+        for (int i = 0; i < size; i++) {
+            info->getBrokerPath().push_back(Pointer<BrokerId>(dynamic_cast<BrokerId*>(
+                tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+        }
+    } else {
+        info->getBrokerPath().clear();
+    }
+    if (wireVersion >= 2) {
+        info->setDispatchAsync(bs->readBoolean());
+    }
+    if (wireVersion >= 3) {
+        info->setWindowSize(dataIn->readInt());
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ProducerInfoMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    ProducerInfo* info =
+        static_cast<ProducerInfo*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    tightMarshalCachedObject2(wireFormat, info->getProducerId().get(), dataOut, bs);
+    tightMarshalCachedObject2(wireFormat, info->getDestination().get(), dataOut, bs);
+    tightMarshalObjectArray2(wireFormat, info->getBrokerPath(), dataOut, bs);
+    if (wireVersion >= 2) {
+        bs->readBoolean();
+    }
+    if (wireVersion >= 3) {
+        dataOut->writeInt(info->getWindowSize());
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ProducerInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -119,6 +119,39 @@ void RemoveInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStructu
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void RemoveInfoMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    RemoveInfo* info =
+        static_cast<RemoveInfo*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    info->setObjectId(Pointer<DataStructure>(dynamic_cast<DataStructure* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    if (wireVersion >= 5) {
+        info->setLastDeliveredSequenceId(tightUnmarshalLong(wireFormat, dataIn, bs));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void RemoveInfoMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    RemoveInfo* info =
+        static_cast<RemoveInfo*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    tightMarshalCachedObject2(wireFormat, info->getObjectId().get(), dataOut, bs);
+    if (wireVersion >= 5) {
+        tightMarshalLong2(wireFormat, info->getLastDeliveredSequenceId(), dataOut, bs);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void RemoveInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -107,6 +107,31 @@ void RemoveSubscriptionInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void RemoveSubscriptionInfoMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    RemoveSubscriptionInfo* info =
+        static_cast<RemoveSubscriptionInfo*>(dataStructure);
+    info->setConnectionId(Pointer<ConnectionId>(dynamic_cast<ConnectionId* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    info->setSubcriptionName(tightUnmarshalString(dataIn, bs));
+    info->setClientId(tightUnmarshalString(dataIn, bs));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void RemoveSubscriptionInfoMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    RemoveSubscriptionInfo* info =
+        static_cast<RemoveSubscriptionInfo*>(dataStructure);
+    tightMarshalCachedObject2(wireFormat, info->getConnectionId().get(), dataOut, bs);
+    tightMarshalString2(info->getSubcriptionName(), dataOut, bs);
+    tightMarshalString2(info->getClientId(), dataOut, bs);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void RemoveSubscriptionInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
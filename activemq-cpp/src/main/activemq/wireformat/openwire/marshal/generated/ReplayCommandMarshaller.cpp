@@ -98,6 +98,28 @@ void ReplayCommandMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStru
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ReplayCommandMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    ReplayCommand* info =
+        static_cast<ReplayCommand*>(dataStructure);
+    info->setFirstNakNumber(dataIn->readInt());
+    info->setLastNakNumber(dataIn->readInt());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ReplayCommandMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    ReplayCommand* info =
+        static_cast<ReplayCommand*>(dataStructure);
+    dataOut->writeInt(info->getFirstNakNumber());
+    dataOut->writeInt(info->getLastNakNumber());
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ReplayCommandMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
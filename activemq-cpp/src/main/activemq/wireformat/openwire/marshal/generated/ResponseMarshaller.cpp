@@ -96,6 +96,26 @@ void ResponseMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStructure
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ResponseMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    Response* info =
+        static_cast<Response*>(dataStructure);
+    info->setCorrelationId(dataIn->readInt());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ResponseMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    Response* info =
+        static_cast<Response*>(dataStructure);
+    dataOut->writeInt(info->getCorrelationId());
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ResponseMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
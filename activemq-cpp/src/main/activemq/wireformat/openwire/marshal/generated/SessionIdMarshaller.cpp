@@ -61,6 +61,8 @@ void SessionIdMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataStructu
             dynamic_cast<SessionId*>(dataStructure);
         info->setConnectionId(tightUnmarshalString(dataIn, bs));
         info->setValue(tightUnmarshalLong(wireFormat, dataIn, bs));
+
+        info->afterUnmarshal( wireFormat );
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
@@ -103,6 +105,30 @@ void SessionIdMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStructur
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void SessionIdMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    SessionId* info =
+        static_cast<SessionId*>(dataStructure);
+    info->setConnectionId(tightUnmarshalString(dataIn, bs));
+    info->setValue(tightUnmarshalLong(wireFormat, dataIn, bs));
+
+    info->afterUnmarshal( wireFormat );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void SessionIdMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    SessionId* info =
+        static_cast<SessionId*>(dataStructure);
+    tightMarshalString2(info->getConnectionId(), dataOut, bs);
+    tightMarshalLong2(wireFormat, info->getValue(), dataOut, bs);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void SessionIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -113,6 +139,7 @@ void SessionIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructu
             dynamic_cast<SessionId*>(dataStructure);
         info->setConnectionId(looseUnmarshalString(dataIn));
         info->setValue(looseUnmarshalLong(wireFormat, dataIn));
+        info->afterUnmarshal(wireFormat);
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
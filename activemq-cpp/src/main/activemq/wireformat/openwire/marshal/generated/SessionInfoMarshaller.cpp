@@ -101,6 +101,27 @@ void SessionInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStruct
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void SessionInfoMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    SessionInfo* info =
+        static_cast<SessionInfo*>(dataStructure);
+    info->setSessionId(Pointer<SessionId>(dynamic_cast<SessionId* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void SessionInfoMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    SessionInfo* info =
+        static_cast<SessionInfo*>(dataStructure);
+    tightMarshalCachedObject2(wireFormat, info->getSessionId().get(), dataOut, bs);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void SessionInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -138,6 +138,52 @@ void SubscriptionInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataS
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void SubscriptionInfoMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    SubscriptionInfo* info =
+        static_cast<SubscriptionInfo*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    info->setClientId(tightUnmarshalString(dataIn, bs));
+    info->setDestination(Pointer<ActiveMQDestination>(dynamic_cast<ActiveMQDestination* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    info->setSelector(tightUnmarshalString(dataIn, bs));
+    info->setSubcriptionName(tightUnmarshalString(dataIn, bs));
+    if (wireVersion >= 3) {
+        info->setSubscribedDestination(Pointer<ActiveMQDestination>(dynamic_cast<ActiveMQDestination* >(
+            tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+    }
+    if (wireVersion >= 11) {
+        info->setNoLocal(bs->readBoolean());
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void SubscriptionInfoMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    SubscriptionInfo* info =
+        static_cast<SubscriptionInfo*>(dataStructure);
+
+    int wireVersion = wireFormat->getVersion();
+
+    tightMarshalString2(info->getClientId(), dataOut, bs);
+    tightMarshalCachedObject2(wireFormat, info->getDestination().get(), dataOut, bs);
+    tightMarshalString2(info->getSelector(), dataOut, bs);
+    tightMarshalString2(info->getSubcriptionName(), dataOut, bs);
+    if (wireVersion >= 3) {
+        tightMarshalNestedObject2(wireFormat, info->getSubscribedDestination().get(), dataOut, bs);
+    }
+    if (wireVersion >= 11) {
+        bs->readBoolean();
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void SubscriptionInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
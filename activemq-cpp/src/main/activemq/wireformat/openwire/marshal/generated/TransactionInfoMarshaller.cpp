@@ -107,6 +107,32 @@ void TransactionInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataSt
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void TransactionInfoMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    TransactionInfo* info =
+        static_cast<TransactionInfo*>(dataStructure);
+    info->setConnectionId(Pointer<ConnectionId>(dynamic_cast<ConnectionId* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    info->setTransactionId(Pointer<TransactionId>(dynamic_cast<TransactionId* >(
+        tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+    info->setType(dataIn->readByte());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void TransactionInfoMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseCommandMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    TransactionInfo* info =
+        static_cast<TransactionInfo*>(dataStructure);
+    tightMarshalCachedObject2(wireFormat, info->getConnectionId().get(), dataOut, bs);
+    tightMarshalCachedObject2(wireFormat, info->getTransactionId().get(), dataOut, bs);
+    dataOut->write(info->getType());
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void TransactionInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -114,6 +114,38 @@ void WireFormatInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStr
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void WireFormatInfoMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    WireFormatInfo* info =
+        static_cast<WireFormatInfo*>(dataStructure);
+    info->beforeUnmarshal(wireFormat);
+
+    info->setMagic(tightUnmarshalConstByteArray(dataIn, bs, 8));
+    info->setVersion(dataIn->readInt());
+    info->setMarshalledProperties(tightUnmarshalByteArray(dataIn, bs));
+
+    info->afterUnmarshal( wireFormat );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void WireFormatInfoMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    BaseDataStreamMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    WireFormatInfo* info =
+        static_cast<WireFormatInfo*>(dataStructure);
+    dataOut->write((const unsigned char*)(&info->getMagic()[0]), 8, 0, 8);
+    dataOut->writeInt(info->getVersion());
+    if (bs->readBoolean()) {
+        dataOut->writeInt((int)info->getMarshalledProperties().size() );
+        dataOut->write((const unsigned char*)(&info->getMarshalledProperties()[0]), (int)info->getMarshalledProperties().size(), 0, (int)info->getMarshalledProperties().size());
+    }
+    info->afterMarshal(wireFormat);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void WireFormatInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -113,6 +113,36 @@ void XATransactionIdMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataSt
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void XATransactionIdMarshaller::fastTightUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameReader* dataIn, BooleanStream* bs) {
+
+    TransactionIdMarshaller::fastTightUnmarshal(wireFormat, dataStructure, dataIn, bs);
+
+    XATransactionId* info =
+        static_cast<XATransactionId*>(dataStructure);
+    info->setFormatId(dataIn->readInt());
+    info->setGlobalTransactionId(tightUnmarshalByteArray(dataIn, bs));
+    info->setBranchQualifier(tightUnmarshalByteArray(dataIn, bs));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void XATransactionIdMarshaller::fastTightMarshal2(OpenWireFormat* wireFormat, DataStructure* dataStructure, FrameWriter* dataOut, BooleanStream* bs) {
+
+    TransactionIdMarshaller::fastTightMarshal2(wireFormat, dataStructure, dataOut, bs);
+
+    XATransactionId* info =
+        static_cast<XATransactionId*>(dataStructure);
+    dataOut->writeInt(info->getFormatId());
+    if (bs->readBoolean()) {
+        dataOut->writeInt((int)info->getGlobalTransactionId().size() );
+        dataOut->write((const unsigned char*)(&info->getGlobalTransactionId()[0]), (int)info->getGlobalTransactionId().size(), 0, (int)info->getGlobalTransactionId().size());
+    }
+    if (bs->readBoolean()) {
+        dataOut->writeInt((int)info->getBranchQualifier().size() );
+        dataOut->write((const unsigned char*)(&info->getBranchQualifier()[0]), (int)info->getBranchQualifier().size(), 0, (int)info->getBranchQualifier().size());
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void XATransactionIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -17,6 +17,9 @@
 
 #include <activemq/wireformat/openwire/utils/BooleanStream.h>
 
+#include <activemq/wireformat/openwire/utils/FrameReader.h>
+#include <activemq/wireformat/openwire/utils/FrameWriter.h>
+
 #include <activemq/exceptions/ActiveMQException.h>
 
 using namespace std;
@@ -164,6 +167,61 @@ void BooleanStream::unmarshal( DataInputStream* dataIn ) {
     AMQ_CATCHALL_THROW( IOException )
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void BooleanStream::marshal( FrameWriter* dataOut ) {
+
+    try {
+
+        if( arrayLimit < 64 ) {
+            dataOut->writeByte( (unsigned char)arrayLimit );
+        } else if( arrayLimit < 256 ) { // max value of unsigned char
+            dataOut->writeByte( 0xC0 );
+            dataOut->writeByte( (unsigned char)arrayLimit );
+        } else {
+            dataOut->writeByte( 0x80 );
+            dataOut->writeShort( arrayLimit );
+        }
+
+        // Dump the payload
+        dataOut->write( &data[0], (int)data.size(), 0, arrayLimit );
+        clear();
+    }
+    AMQ_CATCH_RETHROW( IOException )
+    AMQ_CATCH_EXCEPTION_CONVERT( Exception, IOException )
+    AMQ_CATCHALL_THROW( IOException )
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void BooleanStream::unmarshal( FrameReader* dataIn ) {
+
+    try{
+
+        arrayLimit = (short)( dataIn->readByte() & 0xFF );
+
+        if ( arrayLimit == 0xC0 ) {
+            arrayLimit = (short)( dataIn->readByte() & 0xFF );
+        } else if( arrayLimit == 0x80 ) {
+            arrayLimit = dataIn->readShort();
+        }
+
+        if( arrayLimit < 0 ) {
+            throw IOException( __FILE__, __LINE__, "BooleanStream::unmarshal - Invalid stream size." );
+        }
+
+        // Make sure we can accomodate all the data.
+        data.resize( arrayLimit );
+
+        if( arrayLimit > 0 ) {
+            dataIn->readFully( &data[0], arrayLimit );
+        }
+
+        clear();
+    }
+    AMQ_CATCH_RETHROW( IOException )
+    AMQ_CATCH_EXCEPTION_CONVERT( Exception, IOException )
+    AMQ_CATCHALL_THROW( IOException )
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void BooleanStream::clear() {
     // Reset the positions
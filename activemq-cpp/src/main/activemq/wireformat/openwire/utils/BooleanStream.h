@@ -27,6 +27,9 @@ namespace wireformat{
 namespace openwire{
 namespace utils{
 
+    class FrameReader;
+    class FrameWriter;
+
     /**
      * Manages the writing and reading of boolean data streams
      * to and from a data source such as a DataInputStream or
@@ -100,6 +103,14 @@ namespace utils{
          */
         void marshal( std::vector< unsigned char >& dataOut );
 
+        /**
+         * Marshal the data into a buffered frame.
+         * @param dataOut - the frame to write the data to.
+         *
+         * @throws IOException if an I/O error occurs during this operation.
+         */
+        void marshal( FrameWriter* dataOut );
+
         /**
          * Unmarshal a Boolean data stream from the Input Stream
          * @param dataIn - Input Stream to read data from.
@@ -108,6 +119,14 @@ namespace utils{
          */
         void unmarshal( decaf::io::DataInputStream* dataIn );
 
+        /**
+         * Unmarshal a Boolean data stream from a buffered frame.
+         * @param dataIn - the frame to read data from.
+         *
+         * @throws IOException if an I/O error occurs during this operation.
+         */
+        void unmarshal( FrameReader* dataIn );
+
         /**
          * Clears to old position markers, data starts at the beginning
          */
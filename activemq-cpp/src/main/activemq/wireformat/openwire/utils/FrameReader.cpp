@@ -0,0 +1,52 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FrameReader.h"
+
+#include <decaf/io/ByteArrayInputStream.h>
+#include <decaf/io/DataInputStream.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace activemq::wireformat::openwire::utils;
+using namespace decaf::io;
+
+////////////////////////////////////////////////////////////////////////////////
+std::string FrameReader::readUTF() {
+
+    require(2);
+    int length = 2 + ((position[0] << 8) | position[1]);
+    require(length);
+
+    // Strings that need real UTF-8 decoding are rare on the wire, reuse the
+    // stream decoder so that both paths accept and reject the same input.
+    ByteArrayInputStream bytesIn(position, length);
+    DataInputStream dataIn(&bytesIn);
+    std::string value = dataIn.readUTF();
+
+    position += length;
+    return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameReader::underflow(int length) const {
+    throw IOException(__FILE__, __LINE__,
+        "FrameReader - Attempted to read %d bytes with only %d remaining in the frame.",
+        length, (int) (limit - position));
+}
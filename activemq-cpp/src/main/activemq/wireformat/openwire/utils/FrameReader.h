@@ -0,0 +1,164 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_WIREFORMAT_OPENWIRE_UTILS_FRAMEREADER_H_
+#define _ACTIVEMQ_WIREFORMAT_OPENWIRE_UTILS_FRAMEREADER_H_
+
+#include <activemq/util/Config.h>
+#include <decaf/io/IOException.h>
+
+#include <string>
+#include <string.h>
+
+namespace activemq {
+namespace wireformat {
+namespace openwire {
+namespace utils {
+
+    /**
+     * Reads OpenWire primitive values from a frame that has already been
+     * buffered in memory.  This is the counterpart of DataInputStream used by
+     * the generated fast path marshalers, every read is an inline bounds check
+     * against the end of the frame followed by a direct decode from the buffer,
+     * no virtual calls are made and no data is copied for fixed size values.
+     *
+     * The reader does not own the buffer it reads from, the caller must keep
+     * the frame alive for as long as the reader is in use.
+     *
+     * @since 3.10
+     */
+    class AMQCPP_API FrameReader {
+    private:
+
+        const unsigned char* position;
+        const unsigned char* limit;
+
+    private:
+
+        FrameReader(const FrameReader&);
+        FrameReader& operator=(const FrameReader&);
+
+    public:
+
+        /**
+         * Creates a reader over the given frame.
+         *
+         * @param buffer
+         *      The first byte of the frame.
+         * @param length
+         *      The number of bytes in the frame.
+         */
+        FrameReader(const unsigned char* buffer, int length) : position(buffer), limit(buffer + length) {}
+
+        ~FrameReader() {}
+
+        /**
+         * @return the number of bytes that have not been read yet.
+         */
+        int remaining() const {
+            return (int) (limit - position);
+        }
+
+        bool readBoolean() {
+            return readByte() != 0;
+        }
+
+        unsigned char readByte() {
+            require(1);
+            return *position++;
+        }
+
+        char readChar() {
+            return (char) readByte();
+        }
+
+        short readShort() {
+            return (short) readUnsignedShort();
+        }
+
+        unsigned short readUnsignedShort() {
+            require(2);
+            unsigned short value = (unsigned short) ((position[0] << 8) | position[1]);
+            position += 2;
+            return value;
+        }
+
+        int readInt() {
+            require(4);
+            unsigned int value = ((unsigned int) position[0] << 24) | ((unsigned int) position[1] << 16) |
+                                 ((unsigned int) position[2] << 8) | (unsigned int) position[3];
+            position += 4;
+            return (int) value;
+        }
+
+        long long readLong() {
+            require(8);
+            unsigned long long value = 0;
+            for (int i = 0; i < 8; ++i) {
+                value = (value << 8) | position[i];
+            }
+            position += 8;
+            return (long long) value;
+        }
+
+        /**
+         * Copies the next length bytes of the frame into the given buffer.
+         *
+         * @throws IOException if the frame holds fewer than length bytes.
+         */
+        void readFully(unsigned char* buffer, int length) {
+            require(length);
+            if (length > 0) {
+                memcpy(buffer, position, (size_t) length);
+                position += length;
+            }
+        }
+
+        /**
+         * Reads length bytes of single byte character data directly into a new string.
+         *
+         * @throws IOException if the frame holds fewer than length bytes.
+         */
+        std::string readString(int length) {
+            require(length);
+            std::string value((const char*) position, (std::size_t) length);
+            position += length;
+            return value;
+        }
+
+        /**
+         * Reads a modified UTF-8 string, decoded exactly as DataInputStream::readUTF.
+         *
+         * @throws IOException if the frame is short or the encoding is invalid.
+         */
+        std::string readUTF();
+
+    private:
+
+        void require(int length) const {
+            if (length < 0 || limit - position < length) {
+                underflow(length);
+            }
+        }
+
+        void underflow(int length) const;
+
+    };
+
+}}}}
+
+#endif /* _ACTIVEMQ_WIREFORMAT_OPENWIRE_UTILS_FRAMEREADER_H_ */
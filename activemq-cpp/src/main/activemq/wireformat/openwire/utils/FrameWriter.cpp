@@ -0,0 +1,65 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FrameWriter.h"
+
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/lang/exceptions/IndexOutOfBoundsException.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace activemq::wireformat::openwire::utils;
+using namespace decaf::io;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameWriter::writeUTF(const std::string& value) {
+
+    // Only strings that were found to hold non-ASCII data take this path so
+    // the stream encoder is reused rather than duplicated here.
+    ByteArrayOutputStream bytesOut((int) value.length() + 2);
+    DataOutputStream dataOut(&bytesOut);
+    dataOut.writeUTF(value);
+
+    std::pair<unsigned char*, int> array = bytesOut.toByteArray();
+
+    try {
+        write(array.first, array.second, 0, array.second);
+    } catch (...) {
+        delete[] array.first;
+        throw;
+    }
+
+    delete[] array.first;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameWriter::overflow(int length) const {
+    throw IOException(__FILE__, __LINE__,
+        "FrameWriter - Attempted to write %d bytes with only %d remaining in the frame.",
+        length, (int) (limit - position));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameWriter::outOfRange(int size, int offset, int length) const {
+    throw IndexOutOfBoundsException(__FILE__, __LINE__,
+        "FrameWriter - Offset %d and length %d are outside a buffer of size %d.",
+        offset, length, size);
+}
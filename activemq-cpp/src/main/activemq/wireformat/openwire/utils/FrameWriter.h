@@ -0,0 +1,165 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_WIREFORMAT_OPENWIRE_UTILS_FRAMEWRITER_H_
+#define _ACTIVEMQ_WIREFORMAT_OPENWIRE_UTILS_FRAMEWRITER_H_
+
+#include <activemq/util/Config.h>
+#include <decaf/io/IOException.h>
+
+#include <string>
+#include <string.h>
+
+namespace activemq {
+namespace wireformat {
+namespace openwire {
+namespace utils {
+
+    /**
+     * Writes OpenWire primitive values into a preallocated frame buffer.  This
+     * is the counterpart of DataOutputStream used by the generated fast path
+     * marshalers, the frame size is known up front from the first marshal pass
+     * so the buffer never grows and each write is an inline bounds check and
+     * a direct encode into the buffer.
+     *
+     * The writer does not own the buffer it writes to.
+     *
+     * @since 3.10
+     */
+    class AMQCPP_API FrameWriter {
+    private:
+
+        unsigned char* position;
+        unsigned char* limit;
+
+    private:
+
+        FrameWriter(const FrameWriter&);
+        FrameWriter& operator=(const FrameWriter&);
+
+    public:
+
+        /**
+         * Creates a writer that fills the given buffer.
+         *
+         * @param buffer
+         *      The first byte of the frame.
+         * @param length
+         *      The number of bytes available in the frame.
+         */
+        FrameWriter(unsigned char* buffer, int length) : position(buffer), limit(buffer + length) {}
+
+        ~FrameWriter() {}
+
+        /**
+         * @return the number of bytes that can still be written.
+         */
+        int remaining() const {
+            return (int) (limit - position);
+        }
+
+        void write(unsigned char value) {
+            require(1);
+            *position++ = value;
+        }
+
+        void writeByte(unsigned char value) {
+            write(value);
+        }
+
+        void writeBoolean(bool value) {
+            write((unsigned char) (value ? 1 : 0));
+        }
+
+        void writeShort(short value) {
+            writeUnsignedShort((unsigned short) value);
+        }
+
+        void writeUnsignedShort(unsigned short value) {
+            require(2);
+            position[0] = (unsigned char) (value >> 8);
+            position[1] = (unsigned char) value;
+            position += 2;
+        }
+
+        void writeInt(int value) {
+            require(4);
+            unsigned int bits = (unsigned int) value;
+            position[0] = (unsigned char) (bits >> 24);
+            position[1] = (unsigned char) (bits >> 16);
+            position[2] = (unsigned char) (bits >> 8);
+            position[3] = (unsigned char) bits;
+            position += 4;
+        }
+
+        void writeLong(long long value) {
+            require(8);
+            unsigned long long bits = (unsigned long long) value;
+            for (int i = 7; i >= 0; --i) {
+                position[i] = (unsigned char) bits;
+                bits >>= 8;
+            }
+            position += 8;
+        }
+
+        /**
+         * Writes length bytes of buffer starting at offset, with the same
+         * argument order as DataOutputStream::write.
+         */
+        void write(const unsigned char* buffer, int size, int offset, int length) {
+            if (offset < 0 || length < 0 || offset > size - length) {
+                outOfRange(size, offset, length);
+            }
+            require(length);
+            if (length > 0) {
+                memcpy(position, buffer + offset, (size_t) length);
+                position += length;
+            }
+        }
+
+        /**
+         * Writes each character of the string as a single byte.
+         */
+        void writeBytes(const std::string& value) {
+            write((const unsigned char*) value.c_str(), (int) value.length(), 0, (int) value.length());
+        }
+
+        /**
+         * Writes a modified UTF-8 string, encoded exactly as DataOutputStream::writeUTF.
+         *
+         * @throws IOException if the encoded value does not fit in the frame.
+         * @throws UTFDataFormatException if the encoded value is longer than 65535 bytes.
+         */
+        void writeUTF(const std::string& value);
+
+    private:
+
+        void require(int length) const {
+            if (limit - position < length) {
+                overflow(length);
+            }
+        }
+
+        void overflow(int length) const;
+
+        void outOfRange(int size, int offset, int length) const;
+
+    };
+
+}}}}
+
+#endif /* _ACTIVEMQ_WIREFORMAT_OPENWIRE_UTILS_FRAMEWRITER_H_ */
@@ -33,6 +33,43 @@ using namespace decaf;
 using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
 
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    enum ReservedName {
+        NOT_RESERVED,
+        JMSX_DELIVERY_COUNT,
+        JMSX_GROUP_ID,
+        JMSX_GROUP_SEQ,
+        JMSX_GROUP_FIRST_FOR_CONSUMER
+    };
+
+    /**
+     * Classifies a property name, the reserved names all start with JMSX and each
+     * has a distinct length so an ordinary name is rejected without any string
+     * compare and a reserved one needs only a single compare.
+     */
+    ReservedName reservedName(const std::string& name) {
+
+        if (name.length() < 11 || name.compare(0, 4, "JMSX") != 0) {
+            return NOT_RESERVED;
+        }
+
+        switch (name.length()) {
+            case 11:
+                return name == "JMSXGroupID" ? JMSX_GROUP_ID : NOT_RESERVED;
+            case 12:
+                return name == "JMSXGroupSeq" ? JMSX_GROUP_SEQ : NOT_RESERVED;
+            case 17:
+                return name == "JMSXDeliveryCount" ? JMSX_DELIVERY_COUNT : NOT_RESERVED;
+            case 25:
+                return name == "JMSXGroupFirstForConsumer" ? JMSX_GROUP_FIRST_FOR_CONSUMER : NOT_RESERVED;
+            default:
+                return NOT_RESERVED;
+        }
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 MessagePropertyInterceptor::MessagePropertyInterceptor(commands::Message* message, PrimitiveMap* properties) :
     message(message), properties(properties) {
@@ -62,10 +99,12 @@ MessagePropertyInterceptor::~MessagePropertyInterceptor() {}
 ////////////////////////////////////////////////////////////////////////////////
 bool MessagePropertyInterceptor::getBooleanProperty(const std::string& name) const {
 
-    if (name == "JMSXDeliveryCount" || name == "JMSXGroupID" ||
-        name == "JMSXGroupSeq") {
+    ReservedName reserved = reservedName(name);
+
+    if (reserved == JMSX_DELIVERY_COUNT || reserved == JMSX_GROUP_ID ||
+        reserved == JMSX_GROUP_SEQ) {
         throw ActiveMQException(__FILE__, __LINE__, "Cannot Convert Reserved Property to this Type.");
-    } else if (name == "JMSXGroupFirstForConsumer") {
+    } else if (reserved == JMSX_GROUP_FIRST_FOR_CONSUMER) {
         return message->isJMSXGroupFirstForConsumer();
     }
 
@@ -75,8 +114,9 @@ bool MessagePropertyInterceptor::getBooleanProperty(const std::string& name) con
 ////////////////////////////////////////////////////////////////////////////////
 unsigned char MessagePropertyInterceptor::getByteProperty(const std::string& name) const {
 
-    if (name == "JMSXDeliveryCount" || name == "JMSXGroupID" ||
-        name == "JMSXGroupSeq" || name == "JMSXGroupFirstForConsumer") {
+    ReservedName reserved = reservedName(name);
+
+    if (reserved != NOT_RESERVED) {
         throw ActiveMQException(__FILE__, __LINE__, "Cannot Convert Reserved Property to this Type.");
     }
 
@@ -86,8 +126,9 @@ unsigned char MessagePropertyInterceptor::getByteProperty(const std::string& nam
 ////////////////////////////////////////////////////////////////////////////////
 double MessagePropertyInterceptor::getDoubleProperty(const std::string& name) const {
 
-    if (name == "JMSXDeliveryCount" || name == "JMSXGroupID" ||
-        name == "JMSXGroupSeq" || name == "JMSXGroupFirstForConsumer") {
+    ReservedName reserved = reservedName(name);
+
+    if (reserved != NOT_RESERVED) {
         throw ActiveMQException(__FILE__, __LINE__, "Cannot Convert Reserved Property to this Type.");
     }
 
@@ -97,8 +138,9 @@ double MessagePropertyInterceptor::getDoubleProperty(const std::string& name) co
 ////////////////////////////////////////////////////////////////////////////////
 float MessagePropertyInterceptor::getFloatProperty(const std::string& name) const {
 
-    if (name == "JMSXDeliveryCount" || name == "JMSXGroupID" ||
-        name == "JMSXGroupSeq" || name == "JMSXGroupFirstForConsumer") {
+    ReservedName reserved = reservedName(name);
+
+    if (reserved != NOT_RESERVED) {
 
         throw ActiveMQException(__FILE__, __LINE__, "Cannot Convert Reserved Property to this Type.");
     }
@@ -109,11 +151,13 @@ float MessagePropertyInterceptor::getFloatProperty(const std::string& name) cons
 ////////////////////////////////////////////////////////////////////////////////
 int MessagePropertyInterceptor::getIntProperty(const std::string& name) const {
 
-    if (name == "JMSXGroupID" || name == "JMSXGroupFirstForConsumer") {
+    ReservedName reserved = reservedName(name);
+
+    if (reserved == JMSX_GROUP_ID || reserved == JMSX_GROUP_FIRST_FOR_CONSUMER) {
         throw ActiveMQException(__FILE__, __LINE__, "Cannot Convert Reserved Property to this Type.");
-    } else if (name == "JMSXDeliveryCount") {
+    } else if (reserved == JMSX_DELIVERY_COUNT) {
         return this->message->getRedeliveryCounter();
-    } else if (name == "JMSXGroupSeq") {
+    } else if (reserved == JMSX_GROUP_SEQ) {
         return this->message->getGroupSequence();
     }
 
@@ -123,11 +167,13 @@ int MessagePropertyInterceptor::getIntProperty(const std::string& name) const {
 ////////////////////////////////////////////////////////////////////////////////
 long long MessagePropertyInterceptor::getLongProperty(const std::string& name) const {
 
-    if (name == "JMSXGroupID" || name == "JMSXGroupFirstForConsumer") {
+    ReservedName reserved = reservedName(name);
+
+    if (reserved == JMSX_GROUP_ID || reserved == JMSX_GROUP_FIRST_FOR_CONSUMER) {
         throw ActiveMQException(__FILE__, __LINE__, "Cannot Convert Reserved Property to this Type.");
-    } else if (name == "JMSXDeliveryCount") {
+    } else if (reserved == JMSX_DELIVERY_COUNT) {
         return (long long) this->message->getRedeliveryCounter();
-    } else if (name == "JMSXGroupSeq") {
+    } else if (reserved == JMSX_GROUP_SEQ) {
         return (long long) this->message->getGroupSequence();
     }
 
@@ -137,8 +183,9 @@ long long MessagePropertyInterceptor::getLongProperty(const std::string& name) c
 ////////////////////////////////////////////////////////////////////////////////
 short MessagePropertyInterceptor::getShortProperty(const std::string& name) const {
 
-    if (name == "JMSXDeliveryCount" || name == "JMSXGroupID" ||
-        name == "JMSXGroupSeq" || name == "JMSXGroupFirstForConsumer") {
+    ReservedName reserved = reservedName(name);
+
+    if (reserved != NOT_RESERVED) {
 
         throw ActiveMQException(__FILE__, __LINE__, "Cannot Convert Reserved Property to this Type.");
     }
@@ -149,13 +196,15 @@ short MessagePropertyInterceptor::getShortProperty(const std::string& name) cons
 ////////////////////////////////////////////////////////////////////////////////
 std::string MessagePropertyInterceptor::getStringProperty(const std::string& name) const {
 
-    if (name == "JMSXGroupID") {
+    ReservedName reserved = reservedName(name);
+
+    if (reserved == JMSX_GROUP_ID) {
         return this->message->getGroupID();
-    } else if (name == "JMSXDeliveryCount") {
+    } else if (reserved == JMSX_DELIVERY_COUNT) {
         return Integer::toString(this->message->getRedeliveryCounter());
-    } else if (name == "JMSXGroupSeq") {
+    } else if (reserved == JMSX_GROUP_SEQ) {
         return Integer::toString(this->message->getGroupSequence());
-    } else if (name == "JMSXGroupFirstForConsumer") {
+    } else if (reserved == JMSX_GROUP_FIRST_FOR_CONSUMER) {
         return Boolean::toString(message->isJMSXGroupFirstForConsumer());
     }
 
@@ -165,9 +214,11 @@ std::string MessagePropertyInterceptor::getStringProperty(const std::string& nam
 ////////////////////////////////////////////////////////////////////////////////
 void MessagePropertyInterceptor::setBooleanProperty(const std::string& name, bool value) {
 
-    if (name == "JMSXDeliveryCount" || name == "JMSXGroupID" || name == "JMSXGroupSeq") {
+    ReservedName reserved = reservedName(name);
+
+    if (reserved == JMSX_DELIVERY_COUNT || reserved == JMSX_GROUP_ID || reserved == JMSX_GROUP_SEQ) {
         throw ActiveMQException(__FILE__, __LINE__, "Cannot Convert Reserved Property to this Type.");
-    } else if(name == "JMSXGroupFirstForConsumer") {
+    } else if(reserved == JMSX_GROUP_FIRST_FOR_CONSUMER) {
         return message->setJMSXGroupFirstForConsumer(value);
     }
 
@@ -177,7 +228,9 @@ void MessagePropertyInterceptor::setBooleanProperty(const std::string& name, boo
 ////////////////////////////////////////////////////////////////////////////////
 void MessagePropertyInterceptor::setByteProperty(const std::string& name, unsigned char value) {
 
-    if (name == "JMSXDeliveryCount" || name == "JMSXGroupID" || name == "JMSXGroupSeq") {
+    ReservedName reserved = reservedName(name);
+
+    if (reserved == JMSX_DELIVERY_COUNT || reserved == JMSX_GROUP_ID || reserved == JMSX_GROUP_SEQ) {
         throw ActiveMQException(__FILE__, __LINE__, "Cannot Convert Reserved Property to this Type.");
     }
 
@@ -187,7 +240,9 @@ void MessagePropertyInterceptor::setByteProperty(const std::string& name, unsign
 ////////////////////////////////////////////////////////////////////////////////
 void MessagePropertyInterceptor::setDoubleProperty(const std::string& name, double value) {
 
-    if (name == "JMSXDeliveryCount" || name == "JMSXGroupID" || name == "JMSXGroupSeq") {
+    ReservedName reserved = reservedName(name);
+
+    if (reserved == JMSX_DELIVERY_COUNT || reserved == JMSX_GROUP_ID || reserved == JMSX_GROUP_SEQ) {
         throw ActiveMQException(__FILE__, __LINE__, "Cannot Convert Reserved Property to this Type.");
     }
 
@@ -197,8 +252,9 @@ void MessagePropertyInterceptor::setDoubleProperty(const std::string& name, doub
 ////////////////////////////////////////////////////////////////////////////////
 void MessagePropertyInterceptor::setFloatProperty(const std::string& name, float value) {
 
-    if (name == "JMSXDeliveryCount" || name == "JMSXGroupID" ||
-        name == "JMSXGroupSeq" || name == "JMSXGroupFirstForConsumer") {
+    ReservedName reserved = reservedName(name);
+
+    if (reserved != NOT_RESERVED) {
 
         throw ActiveMQException(__FILE__, __LINE__, "Cannot Convert Reserved Property to this Type.");
     }
@@ -209,11 +265,13 @@ void MessagePropertyInterceptor::setFloatProperty(const std::string& name, float
 ////////////////////////////////////////////////////////////////////////////////
 void MessagePropertyInterceptor::setIntProperty(const std::string& name, int value) {
 
-    if (name == "JMSXGroupID" || name == "JMSXGroupFirstForConsumer") {
+    ReservedName reserved = reservedName(name);
+
+    if (reserved == JMSX_GROUP_ID || reserved == JMSX_GROUP_FIRST_FOR_CONSUMER) {
         throw ActiveMQException(__FILE__, __LINE__, "Cannot Convert Reserved Property to this Type.");
-    } else if (name == "JMSXDeliveryCount") {
+    } else if (reserved == JMSX_DELIVERY_COUNT) {
         this->message->setRedeliveryCounter(value);
-    } else if (name == "JMSXGroupSeq") {
+    } else if (reserved == JMSX_GROUP_SEQ) {
         this->message->setGroupSequence(value);
     }
 
@@ -222,7 +280,10 @@ void MessagePropertyInterceptor::setIntProperty(const std::string& name, int val
 
 ////////////////////////////////////////////////////////////////////////////////
 void MessagePropertyInterceptor::setLongProperty(const std::string& name, long long value) {
-    if (name == "JMSXGroupFirstForConsumer") {
+
+    ReservedName reserved = reservedName(name);
+
+    if (reserved == JMSX_GROUP_FIRST_FOR_CONSUMER) {
         throw ActiveMQException(__FILE__, __LINE__, "Cannot Convert Reserved Property to this Type.");
     }
 
@@ -232,11 +293,13 @@ void MessagePropertyInterceptor::setLongProperty(const std::string& name, long l
 ////////////////////////////////////////////////////////////////////////////////
 void MessagePropertyInterceptor::setShortProperty(const std::string& name, short value) {
 
-    if (name == "JMSXGroupID" || name == "JMSXGroupFirstForConsumer") {
+    ReservedName reserved = reservedName(name);
+
+    if (reserved == JMSX_GROUP_ID || reserved == JMSX_GROUP_FIRST_FOR_CONSUMER) {
         throw ActiveMQException(__FILE__, __LINE__, "Cannot Convert Reserved Property to this Type.");
-    } else if (name == "JMSXDeliveryCount") {
+    } else if (reserved == JMSX_DELIVERY_COUNT) {
         this->message->setRedeliveryCounter((int) value);
-    } else if (name == "JMSXGroupSeq") {
+    } else if (reserved == JMSX_GROUP_SEQ) {
         this->message->setGroupSequence((int) value);
     }
 
@@ -246,13 +309,15 @@ void MessagePropertyInterceptor::setShortProperty(const std::string& name, short
 ////////////////////////////////////////////////////////////////////////////////
 void MessagePropertyInterceptor::setStringProperty(const std::string& name, const std::string& value) {
 
-    if (name == "JMSXGroupID") {
+    ReservedName reserved = reservedName(name);
+
+    if (reserved == JMSX_GROUP_ID) {
         this->message->setGroupID(value);
-    } else if (name == "JMSXDeliveryCount") {
+    } else if (reserved == JMSX_DELIVERY_COUNT) {
         this->message->setRedeliveryCounter(Integer::parseInt(value));
-    } else if (name == "JMSXGroupSeq") {
+    } else if (reserved == JMSX_GROUP_SEQ) {
         this->message->setGroupSequence(Integer::parseInt(value));
-    } else if (name == "JMSXGroupFirstForConsumer") {
+    } else if (reserved == JMSX_GROUP_FIRST_FOR_CONSUMER) {
         this->message->setJMSXGroupFirstForConsumer(Boolean::parseBoolean(value));
     }
 
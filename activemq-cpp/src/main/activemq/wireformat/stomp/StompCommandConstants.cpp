@@ -37,6 +37,7 @@ const std::string StompCommandConstants::BEGIN = "BEGIN";
 const std::string StompCommandConstants::COMMIT = "COMMIT";
 const std::string StompCommandConstants::ABORT = "ABORT";
 const std::string StompCommandConstants::ACK = "ACK";
+const std::string StompCommandConstants::NACK = "NACK";
 const std::string StompCommandConstants::ERROR_CMD = "ERROR";
 const std::string StompCommandConstants::RECEIPT = "RECEIPT";
 
@@ -79,6 +80,10 @@ const std::string StompCommandConstants::HEADER_ID = "id";
 const std::string StompCommandConstants::HEADER_SUBSCRIPTION = "subscription";
 const std::string StompCommandConstants::HEADER_TRANSFORMATION = "transformation";
 const std::string StompCommandConstants::HEADER_TRANSFORMATION_ERROR = "transformation-error";
+const std::string StompCommandConstants::HEADER_ACCEPT_VERSION = "accept-version";
+const std::string StompCommandConstants::HEADER_VERSION = "version";
+const std::string StompCommandConstants::HEADER_HEARTBEAT = "heart-beat";
+const std::string StompCommandConstants::HEADER_HOST = "host";
 
 ////////////////////////////////////////////////////////////////////////////////
 // Stomp Ack Modes
@@ -86,6 +91,12 @@ const std::string StompCommandConstants::ACK_CLIENT = "client";
 const std::string StompCommandConstants::ACK_AUTO = "auto";
 const std::string StompCommandConstants::ACK_INDIVIDUAL = "client-individual";
 
+////////////////////////////////////////////////////////////////////////////////
+// Stomp Protocol Versions
+const std::string StompCommandConstants::VERSION_1_0 = "1.0";
+const std::string StompCommandConstants::VERSION_1_1 = "1.1";
+const std::string StompCommandConstants::VERSION_1_2 = "1.2";
+
 ////////////////////////////////////////////////////////////////////////////////
 // Supported Stomp Message Types
 const std::string StompCommandConstants::TEXT = "text";
@@ -18,7 +18,9 @@
 #include "StompFrame.h"
 
 #include <string>
+#include <string.h>
 
+#include <decaf/io/EOFException.h>
 #include <decaf/lang/exceptions/NullPointerException.h>
 #include <decaf/lang/Character.h>
 #include <decaf/lang/Integer.h>
@@ -37,268 +39,609 @@ using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
 
 ////////////////////////////////////////////////////////////////////////////////
-StompFrame::StompFrame() : command(), properties(), body() {
-}
+namespace {
+
+    // Most bytes that are pulled from the stream at once while scanning a frame.
+    const int MAX_CHUNK_SIZE = 4096;
+
+    // Bodies up to this size are copied in with the headers so the frame goes out
+    // in a single write, larger ones are written straight from the frame.
+    const std::size_t MAX_INLINE_BODY_SIZE = 1024;
+
+    /**
+     * Reads the parts of a frame a chunk at a time rather than one byte per virtual
+     * call.  When the stream supports mark / reset whatever it has available is
+     * peeked into a local window and scanned with memchr, once the frame is done the
+     * stream is reset and only the bytes that were used are skipped so the next frame
+     * is left in place.  When nothing is available, or the stream can't be marked,
+     * a single blocking byte read is used to wait for more data.
+     */
+    class FrameReader {
+    private:
+
+        DataInputStream* in;
+        bool markSupported;
+        bool marked;
+        std::size_t position;
+        std::size_t limit;
+        unsigned char window[MAX_CHUNK_SIZE];
+
+    private:
+
+        FrameReader(const FrameReader&);
+        FrameReader& operator=(const FrameReader&);
+
+    public:
+
+        FrameReader(DataInputStream* in) :
+            in(in), markSupported(in->markSupported()), marked(false), position(0), limit(0) {
+        }
 
-////////////////////////////////////////////////////////////////////////////////
-StompFrame::~StompFrame() {
-}
+        /**
+         * Reads up to the next line feed, the line feed is consumed but not stored.
+         */
+        void readLine(std::string& line) {
 
-////////////////////////////////////////////////////////////////////////////////
-StompFrame* StompFrame::clone() const {
-    StompFrame* frame = new StompFrame();
-    frame->copy(this);
-    return frame;
-}
+            line.clear();
 
-////////////////////////////////////////////////////////////////////////////////
-void StompFrame::copy(const StompFrame* src) {
+            while (true) {
+                fill();
 
-    this->setCommand(src->getCommand());
-    this->properties = src->getProperties();
-    this->body = src->getBody();
-}
+                const unsigned char* start = &window[position];
+                std::size_t length = limit - position;
+                const void* end = memchr(start, '\n', length);
 
-////////////////////////////////////////////////////////////////////////////////
-void StompFrame::setBody(const unsigned char* bytes, std::size_t numBytes) {
+                if (end != NULL) {
+                    length = (const unsigned char*) end - start;
+                    line.append((const char*) start, length);
+                    position += length + 1;
+                    return;
+                }
 
-    // Remove old data
-    body.clear();
-    body.reserve(numBytes);
+                line.append((const char*) start, length);
+                position = limit;
+            }
+        }
 
-    // Copy data to internal buffer.
-    this->body.insert(this->body.begin(), bytes, bytes + numBytes);
-}
+        /**
+         * Reads up to and including the next null byte and appends it to the buffer.
+         */
+        void readUntilNull(std::vector<unsigned char>& buffer) {
 
-////////////////////////////////////////////////////////////////////////////////
-void StompFrame::toStream(decaf::io::DataOutputStream* stream) const {
+            while (true) {
+                fill();
 
-    if (stream == NULL) {
-        throw NullPointerException(__FILE__, __LINE__, "Stream Passed is Null");
-    }
+                const unsigned char* start = &window[position];
+                std::size_t length = limit - position;
+                const void* end = memchr(start, '\0', length);
 
-    // Write the command.
-    const string& cmdString = this->getCommand();
-    stream->write((unsigned char*) cmdString.c_str(), (int) cmdString.length(), 0, (int) cmdString.length());
-    stream->write('\n');
-
-    // Write all the headers.
-    vector<pair<string, string> > headers = this->getProperties().toArray();
-    for (std::size_t ix = 0; ix < headers.size(); ++ix) {
-        string& name = headers[ix].first;
-        string& value = headers[ix].second;
-
-        stream->write((unsigned char*) name.c_str(), (int) name.length(), 0, (int) name.length());
-        stream->write(':');
-        stream->write((unsigned char*) value.c_str(), (int) value.length(), 0, (int) value.length());
-        stream->write('\n');
-    }
+                if (end != NULL) {
+                    length = (const unsigned char*) end - start + 1;
+                    buffer.insert(buffer.end(), start, start + length);
+                    position += length;
+                    return;
+                }
 
-    // Finish the header section with a form feed.
-    stream->write('\n');
+                buffer.insert(buffer.end(), start, start + length);
+                position = limit;
+            }
+        }
 
-    // Write the body.
-    const std::vector<unsigned char>& body = this->getBody();
-    if (body.size() > 0) {
-        stream->write(&body[0], (int) body.size(), 0, (int) body.size());
-    }
+        /**
+         * Reads exactly length bytes, anything past what is already in the window is
+         * read straight from the stream into the caller's buffer.
+         */
+        void readFully(unsigned char* buffer, std::size_t length) {
 
-    if ((this->getBodyLength() == 0) || (this->getProperty(StompCommandConstants::HEADER_CONTENTLENGTH) != "")) {
-        stream->write('\0');
-    }
+            std::size_t buffered = limit - position;
+            if (buffered > length) {
+                buffered = length;
+            }
 
-    stream->write('\n');
+            if (buffered > 0) {
+                memcpy(buffer, &window[position], buffered);
+                position += buffered;
+            }
 
-    // Flush the stream.
-    stream->flush();
-}
+            if (length > buffered) {
+                in->readFully(buffer + buffered, (int) (length - buffered));
+            }
+        }
 
-////////////////////////////////////////////////////////////////////////////////
-void StompFrame::fromStream(decaf::io::DataInputStream* in) {
+        unsigned char readByte() {
+            fill();
+            return window[position++];
+        }
 
-    if (in == NULL) {
-        throw decaf::io::IOException(__FILE__, __LINE__, "DataInputStream passed is NULL");
+        /**
+         * Consumes the end of line that usually trails a frame if it has already been
+         * read into the window, this saves reading it as an empty line later on.
+         */
+        void skipBufferedEndOfLine() {
+
+            if (position < limit && window[position] == '\r' &&
+                position + 1 < limit && window[position + 1] == '\n') {
+                position++;
+            }
+
+            if (position < limit && window[position] == '\n') {
+                position++;
+            }
+        }
+
+        /**
+         * Hands any bytes that were peeked but not used back to the stream.
+         */
+        void finish() {
+
+            if (marked && position < limit) {
+                in->reset();
+
+                long long remaining = (long long) position;
+                while (remaining > 0) {
+                    long long skipped = in->skip(remaining);
+                    if (skipped <= 0) {
+                        throw IOException(__FILE__, __LINE__, "StompFrame - Could not skip past the frame just read");
+                    }
+                    remaining -= skipped;
+                }
+            }
+
+            marked = false;
+            position = limit = 0;
+        }
+
+    private:
+
+        void fill() {
+
+            if (position < limit) {
+                return;
+            }
+
+            position = limit = 0;
+            marked = false;
+
+            int available = markSupported ? in->available() : 0;
+            if (available > 0) {
+                int chunk = available < MAX_CHUNK_SIZE ? available : MAX_CHUNK_SIZE;
+
+                in->mark(chunk);
+                marked = true;
+
+                int result = in->read(window, MAX_CHUNK_SIZE, 0, chunk);
+                if (result == -1) {
+                    throw EOFException(__FILE__, __LINE__, "StompFrame - Reached EOF while reading a Frame");
+                }
+
+                limit = (std::size_t) result;
+            }
+
+            if (limit == 0) {
+                marked = false;
+                window[0] = (unsigned char) in->readByte();
+                limit = 1;
+            }
+        }
+    };
+
+    void stripCarriageReturn(std::string& line) {
+        if (!line.empty() && line[line.size() - 1] == '\r') {
+            line.erase(line.size() - 1);
+        }
     }
 
-    try {
+    std::string decodeHeader(const std::string& value) {
 
-        // Read the command header.
-        readCommandHeader(in);
+        if (value.find('\\') == std::string::npos) {
+            return value;
+        }
 
-        // Read the headers.
-        readHeaders(in);
+        std::string result;
+        result.reserve(value.size());
 
-        // Read the body.
-        readBody(in);
+        for (std::size_t ix = 0; ix < value.size(); ++ix) {
+
+            if (value[ix] != '\\') {
+                result.push_back(value[ix]);
+                continue;
+            }
+
+            if (++ix == value.size()) {
+                throw IOException(__FILE__, __LINE__, "StompFrame - Header ends with an escape character");
+            }
+
+            switch (value[ix]) {
+                case 'r':
+                    result.push_back('\r');
+                    break;
+                case 'n':
+                    result.push_back('\n');
+                    break;
+                case 'c':
+                    result.push_back(':');
+                    break;
+                case '\\':
+                    result.push_back('\\');
+                    break;
+                default:
+                    throw IOException(__FILE__, __LINE__, "StompFrame - Undefined escape sequence in header: %s", value.c_str());
+            }
+        }
+
+        return result;
     }
-    AMQ_CATCH_RETHROW(decaf::io::IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::Exception, decaf::io::IOException)
-    AMQ_CATCHALL_THROW(decaf::io::IOException)
-}
 
-////////////////////////////////////////////////////////////////////////////////
-void StompFrame::readCommandHeader(decaf::io::DataInputStream* in) {
+    void appendEncodedHeader(std::string& buffer, const std::string& value) {
 
-    try {
+        if (value.find_first_of("\\\r\n:") == std::string::npos) {
+            buffer.append(value);
+            return;
+        }
 
-        std::vector<unsigned char> buffer;
+        for (std::size_t ix = 0; ix < value.size(); ++ix) {
+            switch (value[ix]) {
+                case '\r':
+                    // A raw one would be taken for part of a CRLF line ending.
+                    buffer.append("\\r");
+                    break;
+                case '\n':
+                    buffer.append("\\n");
+                    break;
+                case ':':
+                    buffer.append("\\c");
+                    break;
+                case '\\':
+                    buffer.append("\\\\");
+                    break;
+                default:
+                    buffer.push_back(value[ix]);
+            }
+        }
+    }
+
+    /**
+     * Reads the command line, returns false if a heart-beat was read instead.
+     */
+    bool readCommandHeader(StompFrame& frame, FrameReader& reader, bool stomp11) {
+
+        std::string line;
 
         while (true) {
 
             // The command header is formatted just like any other stomp header.
-            readHeaderLine(buffer, in);
+            reader.readLine(line);
+
+            if (stomp11) {
+                stripCarriageReturn(line);
+
+                if (line.empty()) {
+                    frame.setCommand("");
+                    return false;
+                }
+            }
 
             // Ignore all white space before the command.
-            long long offset = -1;
-            for (size_t ix = 0; ix < buffer.size() - 1; ++ix) {
+            for (std::size_t ix = 0; ix < line.size(); ++ix) {
 
                 // Find the first non whitespace character
-                if (!Character::isWhitespace(buffer[ix])) {
-                    offset = (long long) ix;
-                    break;
+                if (!Character::isWhitespace(line[ix])) {
+                    frame.setCommand(line.substr(ix));
+                    return true;
                 }
             }
+        }
+    }
+
+    void readHeaders(StompFrame::HeaderList& headers, FrameReader& reader, bool stomp11) {
+
+        std::string line;
+
+        while (true) {
+
+            reader.readLine(line);
+
+            if (stomp11) {
+                stripCarriageReturn(line);
+            }
 
-            if (offset >= 0) {
-                // Set the command in the frame - copy the memory.
-                this->setCommand(reinterpret_cast<char*>(&buffer[(size_t) offset]));
+            // An empty line marks the end of the header section.
+            if (line.empty()) {
                 break;
             }
+
+            // Lines without a key/value separator are ignored.
+            std::size_t separator = line.find(':');
+            if (separator == std::string::npos) {
+                continue;
+            }
+
+            // A repeated header replaces the value read before it.
+            std::string key = line.substr(0, separator);
+            std::string value = line.substr(separator + 1);
+
+            if (stomp11) {
+                key = decodeHeader(key);
+                value = decodeHeader(value);
+            }
+
+            StompFrame::HeaderList::iterator iter = headers.begin();
+            for (; iter != headers.end(); ++iter) {
+                if (iter->first == key) {
+                    break;
+                }
+            }
+
+            if (iter != headers.end()) {
+                iter->second = value;
+            } else {
+                headers.push_back(std::make_pair(key, value));
+            }
         }
     }
-    AMQ_CATCH_RETHROW(decaf::io::IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::Exception, decaf::io::IOException)
-    AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void StompFrame::readHeaders(decaf::io::DataInputStream* in) {
+StompFrame::StompFrame() : command(), headers(), properties(NULL), body() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+StompFrame::StompFrame(const StompFrame& other) : command(), headers(), properties(NULL), body() {
+    this->copy(&other);
+}
 
+////////////////////////////////////////////////////////////////////////////////
+StompFrame::~StompFrame() {
     try {
+        delete this->properties;
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
 
-        // Read the command;
-        bool endOfHeaders = false;
-        std::vector<unsigned char> buffer;
+////////////////////////////////////////////////////////////////////////////////
+StompFrame& StompFrame::operator=(const StompFrame& other) {
+
+    if (this != &other) {
+        this->copy(&other);
+    }
 
-        while (!endOfHeaders) {
+    return *this;
+}
 
-            // Read in the next header line.
-            std::size_t numChars = readHeaderLine(buffer, in);
+////////////////////////////////////////////////////////////////////////////////
+StompFrame* StompFrame::clone() const {
+    StompFrame* frame = new StompFrame();
+    frame->copy(this);
+    return frame;
+}
 
-            if (numChars == 0) {
+////////////////////////////////////////////////////////////////////////////////
+void StompFrame::copy(const StompFrame* src) {
 
-                // should never get here
-                throw decaf::io::IOException(__FILE__, __LINE__, "StompWireFormat::readStompHeaders: no characters read");
-            }
+    this->setCommand(src->getCommand());
+    this->headers = src->getHeaders();
+    this->body = src->getBody();
 
-            // Check for an empty line to demark the end of the header section.
-            // if its not the end then we have a header to process, so parse it.
-            if (numChars == 1 && buffer[0] == '\0') {
-                endOfHeaders = true;
-            } else {
+    if (this->properties != NULL) {
+        this->properties->clear();
+        HeaderList::const_iterator iter = headers.begin();
+        for (; iter != headers.end(); ++iter) {
+            this->properties->setProperty(iter->first, iter->second);
+        }
+    }
+}
 
-                // Search through this line to separate the key/value pair.
-                for (size_t ix = 0; ix < buffer.size(); ++ix) {
+////////////////////////////////////////////////////////////////////////////////
+decaf::util::Properties& StompFrame::propertiesView() const {
 
-                    // If found the key/value separator...
-                    if (buffer[ix] == ':') {
+    if (this->properties == NULL) {
+        this->properties = new decaf::util::Properties();
+        HeaderList::const_iterator iter = headers.begin();
+        for (; iter != headers.end(); ++iter) {
+            this->properties->setProperty(iter->first, iter->second);
+        }
+    }
 
-                        // Null-terminate the key.
-                        buffer[ix] = '\0';
+    return *this->properties;
+}
 
-                        const char* key = reinterpret_cast<char*>(&buffer[0]);
-                        const char* value = reinterpret_cast<char*>(&buffer[ix + 1]);
+////////////////////////////////////////////////////////////////////////////////
+void StompFrame::syncHeaders() const {
 
-                        // Assign the header key/value pair.
-                        if (!this->getProperties().hasProperty(key)) {
-                            this->getProperties().setProperty(key, value);
-                        }
+    if (this->properties == NULL) {
+        return;
+    }
 
-                        // Break out of the for loop.
-                        break;
-                    }
-                }
+    // Keep the order of the headers that are still set, drop the removed ones and
+    // append the ones only added through the Properties.
+    HeaderList current;
+    current.reserve((std::size_t) this->properties->size());
+
+    HeaderList::const_iterator iter = headers.begin();
+    for (; iter != headers.end(); ++iter) {
+        if (this->properties->hasProperty(iter->first)) {
+            current.push_back(std::make_pair(iter->first, this->properties->getProperty(iter->first, "")));
+        }
+    }
+
+    if (current.size() != (std::size_t) this->properties->size()) {
+        std::vector<std::string> names = this->properties->propertyNames();
+        std::vector<std::string>::const_iterator name = names.begin();
+        for (; name != names.end(); ++name) {
+            bool found = false;
+            for (iter = current.begin(); iter != current.end() && !found; ++iter) {
+                found = iter->first == *name;
+            }
+
+            if (!found) {
+                current.push_back(std::make_pair(*name, this->properties->getProperty(*name, "")));
             }
         }
     }
-    AMQ_CATCH_RETHROW(decaf::io::IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::Exception, decaf::io::IOException)
-    AMQ_CATCHALL_THROW(decaf::io::IOException)
+
+    this->headers.swap(current);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-std::size_t StompFrame::readHeaderLine(std::vector<unsigned char>& buffer, decaf::io::DataInputStream* in) {
+const std::string* StompFrame::findHeader(const std::string& name) const {
 
-    try {
+    syncHeaders();
 
-        // Clear any data from the buffer.
-        buffer.clear();
+    HeaderList::const_iterator iter = headers.begin();
+    for (; iter != headers.end(); ++iter) {
+        if (iter->first == name) {
+            return &iter->second;
+        }
+    }
 
-        std::size_t count = 0;
+    return NULL;
+}
 
-        while (true) {
+////////////////////////////////////////////////////////////////////////////////
+void StompFrame::setProperty(const std::string& name, const std::string& value) {
 
-            // Read the next char from the stream.
-            buffer.push_back(in->readByte());
+    if (this->properties != NULL) {
+        this->properties->setProperty(name, value);
+    }
 
-            // Increment the position pointer.
-            count++;
+    syncHeaders();
 
-            // If we reached the line terminator, return the total number
-            // of characters read.
-            if (buffer[count - 1] == '\n') {
-                // Overwrite the line feed with a null character.
-                buffer[count - 1] = '\0';
-                return count;
-            }
+    HeaderList::iterator iter = headers.begin();
+    for (; iter != headers.end(); ++iter) {
+        if (iter->first == name) {
+            iter->second = value;
+            return;
         }
+    }
+
+    headers.push_back(std::make_pair(name, value));
+}
 
-        // If we get here something bad must have happened.
-        throw decaf::io::IOException(__FILE__, __LINE__, "StompWireFormat::readStompHeaderLine: "
-                "Unrecoverable, error condition");
+////////////////////////////////////////////////////////////////////////////////
+void StompFrame::setBody(const unsigned char* bytes, std::size_t numBytes) {
+
+    // Remove old data
+    body.clear();
+    body.reserve(numBytes);
+
+    // Copy data to internal buffer.
+    this->body.insert(this->body.begin(), bytes, bytes + numBytes);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrame::toStream(decaf::io::DataOutputStream* stream, bool stomp11) const {
+
+    if (stream == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "Stream Passed is Null");
     }
-    AMQ_CATCH_RETHROW(decaf::io::IOException)
-    AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::Exception, decaf::io::IOException)
-    AMQ_CATCHALL_THROW(decaf::io::IOException)
+
+    syncHeaders();
+
+    std::size_t size = command.length() + 3;
+    HeaderList::const_iterator iter = headers.begin();
+    for (; iter != headers.end(); ++iter) {
+        size += iter->first.length() + iter->second.length() + 2;
+    }
+
+    bool inlineBody = body.size() <= MAX_INLINE_BODY_SIZE;
+    if (inlineBody) {
+        size += body.size();
+    }
+
+    // Collect the command, headers and small bodies so they go out in one write.
+    std::string buffer;
+    buffer.reserve(size + 1);
+
+    buffer.append(command);
+    buffer.push_back('\n');
+
+    for (iter = headers.begin(); iter != headers.end(); ++iter) {
+        if (stomp11) {
+            appendEncodedHeader(buffer, iter->first);
+            buffer.push_back(':');
+            appendEncodedHeader(buffer, iter->second);
+        } else {
+            buffer.append(iter->first);
+            buffer.push_back(':');
+            buffer.append(iter->second);
+        }
+        buffer.push_back('\n');
+    }
+
+    // Finish the header section with a form feed.
+    buffer.push_back('\n');
+
+    if (!body.empty()) {
+        if (inlineBody) {
+            buffer.append((const char*) &body[0], body.size());
+        } else {
+            stream->write((const unsigned char*) buffer.data(), (int) buffer.size(), 0, (int) buffer.size());
+            stream->write(&body[0], (int) body.size(), 0, (int) body.size());
+            buffer.clear();
+        }
+    }
+
+    if (body.empty() || !getProperty(StompCommandConstants::HEADER_CONTENTLENGTH).empty()) {
+        buffer.push_back('\0');
+    }
+
+    buffer.push_back('\n');
+
+    stream->write((const unsigned char*) buffer.data(), (int) buffer.size(), 0, (int) buffer.size());
+
+    // Flush the stream.
+    stream->flush();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void StompFrame::readBody(decaf::io::DataInputStream* in) {
+void StompFrame::fromStream(decaf::io::DataInputStream* in, bool stomp11) {
+
+    if (in == NULL) {
+        throw decaf::io::IOException(__FILE__, __LINE__, "DataInputStream passed is NULL");
+    }
 
     try {
 
-        // Clear any data from the body.
+        FrameReader reader(in);
+
+        this->headers.clear();
         this->body.clear();
 
-        unsigned int content_length = 0;
+        if (this->properties != NULL) {
+            this->properties->clear();
+        }
+
+        // Read the command header, a heart-beat has nothing else to read.
+        if (!readCommandHeader(*this, reader, stomp11)) {
+            reader.finish();
+            return;
+        }
+
+        // Read the headers.
+        readHeaders(this->headers, reader, stomp11);
+
+        if (this->properties != NULL) {
+            HeaderList::const_iterator iter = headers.begin();
+            for (; iter != headers.end(); ++iter) {
+                this->properties->setProperty(iter->first, iter->second);
+            }
+        }
+
+        // Read the body.
+        unsigned int contentLength = 0;
 
-        if (this->hasProperty(StompCommandConstants::HEADER_CONTENTLENGTH)) {
-            string length = this->getProperty(StompCommandConstants::HEADER_CONTENTLENGTH);
-            content_length = (unsigned int) Integer::parseInt(length);
+        const std::string* length = findHeader(StompCommandConstants::HEADER_CONTENTLENGTH);
+        if (length != NULL) {
+            contentLength = (unsigned int) Integer::parseInt(*length);
         }
 
-        if (content_length != 0) {
-            // For this case its assumed that content length indicates how
-            // much to read.  We reserve space in the buffer for it to
-            // minimize the number of reallocs that might occur.  We are
-            // assuming that content length doesn't count the trailing null
-            // that indicates the end of frame.  The reserve won't do anything
-            // if the buffer already has that much capacity.  The resize call
-            // basically sets the end iterator to the correct location since
-            // this is a char vector and we already reserve enough space.
-            // Resize doesn't realloc the vector smaller if content_length
-            // is less than capacity of the buffer, it just move the end
-            // iterator.  Reserve adds the benefit that the mem is set to
-            // zero.
-
-            this->body.reserve((std::size_t) content_length);
-            this->body.resize((std::size_t) content_length);
-
-            // Read the Content Length now
-            in->readFully(&body[0], (int) body.size());
-
-            // Content Length read, now pop the end terminator off (\0\n).
-            if (in->readByte() != '\0') {
+        if (contentLength != 0) {
+
+            // Content length doesn't count the trailing null that ends the frame.
+            this->body.resize((std::size_t) contentLength);
+            reader.readFully(&body[0], body.size());
+
+            if (reader.readByte() != '\0') {
                 throw decaf::io::IOException(__FILE__, __LINE__, "StompWireFormat::readStompBody: "
                         "Read Content Length, and no trailing null");
             }
@@ -307,18 +650,11 @@ void StompFrame::readBody(decaf::io::DataInputStream* in) {
 
             // Content length was either zero, or not set, so we read until the
             // first null is encountered.
-            while (true) {
-
-                char byte = in->readByte();
-                this->body.push_back(byte);
-
-                if (byte != '\0') {
-                    continue;
-                }
-
-                break; // Read null and newline we are done.
-            }
+            reader.readUntilNull(this->body);
         }
+
+        reader.skipBufferedEndOfLine();
+        reader.finish();
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::Exception, decaf::io::IOException)
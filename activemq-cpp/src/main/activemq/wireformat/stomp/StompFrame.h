@@ -19,8 +19,8 @@
 #define _ACTIVEMQ_WIREFORMAT_STOMP_STOMPFRAMEWRAPPER_H_
 
 #include <string>
-#include <string.h>
-#include <map>
+#include <vector>
+#include <utility>
 #include <decaf/util/Properties.h>
 #include <decaf/io/DataOutputStream.h>
 #include <decaf/io/DataInputStream.h>
@@ -34,13 +34,26 @@ namespace stomp {
      * A Stomp-level message frame that encloses all messages to and from the broker.
      */
     class AMQCPP_API StompFrame {
+    public:
+
+        /**
+         * The headers of a frame, kept in the order they were set or read.  A frame
+         * only carries a handful of headers and is only ever touched by one thread
+         * so a flat list with linear lookup beats a synchronized map here.
+         */
+        typedef std::vector< std::pair<std::string, std::string> > HeaderList;
+
     private:
 
         // String Name of this command.
         std::string command;
 
-        // Properties of the Stomp Message
-        decaf::util::Properties properties;
+        // Headers of the Stomp Message
+        mutable HeaderList headers;
+
+        // Created by the deprecated getProperties(), once handed out it is the copy of
+        // the headers that counts and the list is brought up to date from it on use.
+        mutable decaf::util::Properties* properties;
 
         // Byte data of Body.
         std::vector<unsigned char> body;
@@ -52,11 +65,23 @@ namespace stomp {
          */
         StompFrame();
 
+        /**
+         * Copy constructor, the new frame holds its own copy of the command, headers
+         * and body.
+         */
+        StompFrame(const StompFrame& other);
+
         /**
          * Destruction.
          */
         virtual ~StompFrame();
 
+        /**
+         * Replaces the command, headers and body of this frame with a copy of those
+         * of the given frame.
+         */
+        StompFrame& operator=(const StompFrame& other);
+
         /**
          * Clonse this message exactly, returns a new instance that the
          * caller is required to delete.
@@ -91,7 +116,7 @@ namespace stomp {
          * @param name - The name of the property to check for.
          */
         bool hasProperty(const std::string& name) const {
-            return this->properties.hasProperty(name);
+            return findHeader(name) != NULL;
         }
 
         /**
@@ -104,7 +129,8 @@ namespace stomp {
          * @return string value of the property asked for.
          */
         std::string getProperty(const std::string& name, const std::string& fallback = "") const {
-            return this->properties.getProperty(name, fallback);
+            const std::string* value = findHeader(name);
+            return value != NULL ? *value : fallback;
         }
 
         /**
@@ -114,28 +140,41 @@ namespace stomp {
          * @param name - the Name of the property to get and return.
          */
         std::string removeProperty(const std::string& name) {
-            return this->properties.getProperty(name, "");
+            return getProperty(name, "");
         }
 
         /**
-         * Sets the property given to the value specified in this Frame's Properties
+         * Sets the property given to the value specified in this Frame's headers
          *
          * @param name - Name of the property.
          * @param value - Value to set the property to.
          */
-        void setProperty(const std::string& name, const std::string& value) {
-            this->properties.setProperty(name, value);
+        void setProperty(const std::string& name, const std::string& value);
+
+        /**
+         * Gets access to the headers of this frame in the order they were added.
+         * @return the HeaderList owned by this Frame
+         */
+        const HeaderList& getHeaders() const {
+            syncHeaders();
+            return headers;
         }
 
         /**
-         * Gets access to the header properties for this frame.
+         * Gets access to the headers of this frame as a Properties object.  The object
+         * is created on first use and stays in step with the frame, changes made
+         * through it are seen by the frame and changes to the frame are seen by it.
+         * Once it exists every header access pays for keeping the two in step.
+         *
          * @return the Properties object owned by this Frame
+         *
+         * @deprecated use getHeaders(), getProperty() and setProperty() instead.
          */
         decaf::util::Properties& getProperties() {
-            return properties;
+            return propertiesView();
         }
         const decaf::util::Properties& getProperties() const {
-            return properties;
+            return propertiesView();
         }
 
         /**
@@ -168,55 +207,55 @@ namespace stomp {
          */
         void setBody(const unsigned char* bytes, std::size_t numBytes);
 
+        /**
+         * @return true if this Frame is a STOMP 1.1 heart-beat, a bare end of line that
+         *         carries no command.
+         */
+        bool isHeartBeat() const {
+            return command.empty();
+        }
+
         /**
          * Writes this Frame to an OuputStream in the Stomp Wire Format.
          *
          * @param stream - The stream to write the Frame to.
+         * @param stomp11 - true once STOMP 1.1 or later is in use, header names and
+         *                  values are then escaped.
          *
          * @throw IOException if an error occurs while reading the Frame.
          */
-        void toStream(decaf::io::DataOutputStream* stream) const;
+        void toStream(decaf::io::DataOutputStream* stream, bool stomp11 = false) const;
 
         /**
          * Reads a Stop Frame from a DataInputStream in the Stomp Wire format.
          *
          * @param stream - The stream to read the Frame from.
+         * @param stomp11 - true once STOMP 1.1 or later is in use, header names and
+         *                  values are then unescaped, lines may end in a carriage return
+         *                  and a bare end of line is read as a heart-beat Frame.
          *
          * @throw IOException if an error occurs while writing the Frame.
          */
-        void fromStream(decaf::io::DataInputStream* stream);
+        void fromStream(decaf::io::DataInputStream* stream, bool stomp11 = false);
 
     private:
 
         /**
-         * Read the Stomp Command from the Frame
-         * @param in - The stream to read the Frame from.
-         * @throws IOException
-         */
-        void readCommandHeader(decaf::io::DataInputStream* in);
-
-        /**
-         * Read all the Stomp Headers for the incoming Frame
-         * @param in - The stream to read the Frame from.
-         * @throws IOException
+         * Finds the value of the named header.
+         * @param name - The name of the header to look up.
+         * @return pointer to the value or NULL if the header is not set.
          */
-        void readHeaders(decaf::io::DataInputStream* in);
+        const std::string* findHeader(const std::string& name) const;
 
         /**
-         * Reads a Stomp Header line and stores it in the buffer object
-         * @param buffer - reference to a memory buffer to store the read line in.
-         * @param in - The stream to read the Frame from.
-         * @return number of bytes read, zero if there was a problem.
-         * @throws IOException
+         * Creates the Properties view of the headers if needed and returns it.
          */
-        std::size_t readHeaderLine(std::vector<unsigned char>& buffer, decaf::io::DataInputStream* in);
+        decaf::util::Properties& propertiesView() const;
 
         /**
-         * Reads the Stomp Body from the Wire and store it in the frame.
-         * @param in - The stream to read the Frame from.
-         * @throws IOException
+         * Brings the header list up to date with the Properties view, if there is one.
          */
-        void readBody(decaf::io::DataInputStream* in);
+        void syncHeaders() const;
 
     };
 
@@ -130,10 +130,10 @@ void StompHelper::convertProperties(const Pointer<StompFrame>& frame, const Poin
     }
 
     // Copy the general headers over to the Message.
-    std::vector<std::pair<std::string, std::string> > properties = frame->getProperties().toArray();
-    std::vector<std::pair<std::string, std::string> >::const_iterator iter = properties.begin();
+    const StompFrame::HeaderList& headers = frame->getHeaders();
+    StompFrame::HeaderList::const_iterator iter = headers.begin();
 
-    for (; iter != properties.end(); ++iter) {
+    for (; iter != headers.end(); ++iter) {
         message->getMessageProperties().setString(iter->first, iter->second);
     }
 }
@@ -261,10 +261,7 @@ Pointer<MessageId> StompHelper::convertMessageId(const std::string& messageId) {
         return Pointer<MessageId>();
     }
 
-    Pointer<MessageId> id(new MessageId());
-
-    id->setProducerId(convertProducerId(messageId));
-    id->setProducerSequenceId(this->messageIdGenerator.getNextSequenceId());
+    Pointer<MessageId> id(new MessageId(convertProducerId(messageId), this->messageIdGenerator.getNextSequenceId()));
 
     return id;
 }
@@ -306,6 +303,8 @@ Pointer<ConsumerId> StompHelper::convertConsumerId(const std::string& consumerId
         }
     }
 
+    id->afterUnmarshal(NULL);
+
     return id;
 }
 
@@ -327,6 +326,7 @@ Pointer<ProducerId> StompHelper::convertProducerId(const std::string& producerId
     id->setConnectionId(producerId);
     id->setSessionId(-1);
     id->setValue(-1);
+    id->afterUnmarshal(NULL);
 
     return id;
 }
@@ -39,16 +39,24 @@
 #include <activemq/commands/ProducerInfo.h>
 #include <activemq/commands/ConsumerInfo.h>
 #include <activemq/commands/RemoveSubscriptionInfo.h>
+#include <activemq/commands/KeepAliveInfo.h>
+#include <activemq/commands/WireFormatInfo.h>
 
 #include <decaf/lang/Character.h>
 #include <decaf/lang/Integer.h>
 #include <decaf/lang/Boolean.h>
 #include <decaf/lang/Long.h>
+#include <decaf/lang/Math.h>
 #include <decaf/lang/exceptions/ClassCastException.h>
+#include <decaf/util/StringTokenizer.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
 #include <decaf/io/IOException.h>
 #include <decaf/io/ByteArrayOutputStream.h>
 #include <decaf/io/DataOutputStream.h>
 #include <memory>
+#include <list>
+#include <map>
 
 using namespace std;
 using namespace activemq;
@@ -60,6 +68,51 @@ using namespace decaf;
 using namespace decaf::io;
 using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::atomic;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int STOMP_1_0 = 10;
+    const int STOMP_1_1 = 11;
+    const int STOMP_1_2 = 12;
+
+    int parseProtocolVersion(const std::string& version) {
+        if (version == StompCommandConstants::VERSION_1_2) {
+            return STOMP_1_2;
+        } else if (version == StompCommandConstants::VERSION_1_1) {
+            return STOMP_1_1;
+        }
+
+        return STOMP_1_0;
+    }
+
+    // Message delivered to a client-individual subscription that still needs an ACK or NACK.
+    struct PendingAck {
+
+        std::string messageId;
+        std::string ackId;
+
+        PendingAck(const std::string& messageId, const std::string& ackId) :
+            messageId(messageId), ackId(ackId) {
+        }
+    };
+
+    typedef std::list<PendingAck> PendingAckList;
+
+    // The pending acks of one subscription in delivery order, indexed by message id so
+    // an ACK or NACK doesn't have to walk everything that is still outstanding.
+    struct PendingAcks {
+
+        PendingAckList delivered;
+        std::map<std::string, PendingAckList::iterator> index;
+
+        PendingAcks() : delivered(), index() {
+        }
+    };
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 namespace activemq {
@@ -67,6 +120,11 @@ namespace wireformat {
 namespace stomp {
 
     class StompWireformatProperties {
+    private:
+
+        StompWireformatProperties(const StompWireformatProperties&);
+        StompWireformatProperties& operator=(const StompWireformatProperties&);
+
     public:
 
         int connectResponseId;
@@ -83,14 +141,97 @@ namespace stomp {
         // Prefix used to address Temporary Queues (default is /temp-queue/
         std::string tempQueuePrefix;
 
+        // Versions offered in the CONNECT frame (default is 1.0)
+        std::string acceptVersion;
+
+        // Host named in a 1.1 or later CONNECT frame.
+        std::string host;
+
+        // Heart-beat intervals offered in the CONNECT frame, zero disables.
+        long long outgoingHeartBeat;
+        long long incomingHeartBeat;
+
+        // The version agreed on in the CONNECTED frame.
+        AtomicInteger protocolVersion;
+
+        // A Command held back so that the negotiated heart-beat can be handed up first.
+        Pointer<Command> pendingCommand;
+
+        // Messages awaiting an ACK or NACK keyed by subscription, only kept for 1.1 and up.
+        Mutex pendingAcksLock;
+        std::map<std::string, PendingAcks> pendingAcks;
+
     public:
 
         StompWireformatProperties() : connectResponseId(-1),
                                       topicPrefix("/topic/"),
                                       queuePrefix("/queue/"),
                                       tempTopicPrefix("/temp-topic/"),
-                                      tempQueuePrefix("/temp-queue/") {
+                                      tempQueuePrefix("/temp-queue/"),
+                                      acceptVersion(StompCommandConstants::VERSION_1_0),
+                                      host(),
+                                      outgoingHeartBeat(0),
+                                      incomingHeartBeat(0),
+                                      protocolVersion(STOMP_1_0),
+                                      pendingCommand(),
+                                      pendingAcksLock(),
+                                      pendingAcks() {
+
+        }
+
+        void addPendingAck(const std::string& subscription, const PendingAck& pending) {
+            synchronized(&pendingAcksLock) {
+                PendingAcks& acks = pendingAcks[subscription];
+                acks.index[pending.messageId] = acks.delivered.insert(acks.delivered.end(), pending);
+            }
+        }
+
+        /**
+         * Removes the pending entry for the given message, or with cumulative set every
+         * entry delivered up to and including it, and returns what was removed.
+         */
+        void takePendingAcks(const std::string& subscription, const std::string& messageId,
+                             bool cumulative, PendingAckList& result) {
+
+            synchronized(&pendingAcksLock) {
+
+                std::map<std::string, PendingAcks>::iterator entry = pendingAcks.find(subscription);
+                if (entry == pendingAcks.end()) {
+                    return;
+                }
+
+                PendingAcks& acks = entry->second;
+                std::map<std::string, PendingAckList::iterator>::iterator found = acks.index.find(messageId);
+                if (found == acks.index.end()) {
+                    return;
+                }
+
+                PendingAckList::iterator last = found->second;
+                PendingAckList::iterator first = cumulative ? acks.delivered.begin() : last;
+                ++last;
+
+                // A redelivered message is indexed by its latest entry only.
+                for (PendingAckList::iterator iter = first; iter != last; ++iter) {
+                    std::map<std::string, PendingAckList::iterator>::iterator indexed = acks.index.find(iter->messageId);
+                    if (indexed != acks.index.end() && indexed->second == iter) {
+                        acks.index.erase(indexed);
+                    }
+                }
+
+                result.splice(result.end(), acks.delivered, first, last);
+            }
+        }
 
+        void removePendingAcks(const std::string& subscription) {
+            synchronized(&pendingAcksLock) {
+                pendingAcks.erase(subscription);
+            }
+        }
+
+        void clearPendingAcks() {
+            synchronized(&pendingAcksLock) {
+                pendingAcks.clear();
+            }
         }
 
     };
@@ -125,6 +266,17 @@ void StompWireFormat::marshal(const Pointer<Command> command,
                     "output stream is NULL");
         }
 
+        // A heart-beat is a bare end of line, there is nothing to send before 1.1.
+        if (command->isKeepAliveInfo()) {
+            if (isStomp11()) {
+                out->write('\n');
+                out->flush();
+            }
+
+            return;
+        }
+
+        std::vector< Pointer<StompFrame> > frames;
         Pointer<StompFrame> frame;
 
         if (command->isMessage()) {
@@ -134,7 +286,7 @@ void StompWireFormat::marshal(const Pointer<Command> command,
         } else if (command->isShutdownInfo()) {
             frame = this->marshalShutdownInfo(command);
         } else if (command->isMessageAck()) {
-            frame = this->marshalAck(command);
+            this->marshalAck(command, frames);
         } else if (command->isConnectionInfo()) {
             frame = this->marshalConnectionInfo(command);
         } else if (command->isTransactionInfo()) {
@@ -145,9 +297,13 @@ void StompWireFormat::marshal(const Pointer<Command> command,
             frame = this->marshalRemoveSubscriptionInfo(command);
         }
 
+        if (frame != NULL) {
+            frames.push_back(frame);
+        }
+
         // Some commands just don't translate to Stomp Commands, unless they require
         // a response we can just ignore them.
-        if (frame == NULL) {
+        if (frames.empty()) {
 
             if (command->isResponseRequired()) {
                 Pointer<Response> response(new Response());
@@ -162,8 +318,12 @@ void StompWireFormat::marshal(const Pointer<Command> command,
             return;
         }
 
-        // Let the Frame write itself to the output stream
-        frame->toStream(out);
+        // Let the Frames write themselves to the output stream
+        bool stomp11 = isStomp11();
+        std::vector< Pointer<StompFrame> >::const_iterator iter = frames.begin();
+        for (; iter != frames.end(); ++iter) {
+            (*iter)->toStream(out, stomp11);
+        }
     }
     AMQ_CATCH_RETHROW( decaf::io::IOException)
     AMQ_CATCH_EXCEPTION_CONVERT( decaf::lang::Exception, decaf::io::IOException)
@@ -181,6 +341,13 @@ Pointer<Command> StompWireFormat::unmarshal(const activemq::transport::Transport
         throw decaf::io::IOException(__FILE__, __LINE__, "DataInputStream passed is NULL");
     }
 
+    // Hand up anything that was held back on the last call before reading on.
+    if (this->properties->pendingCommand != NULL) {
+        Pointer<Command> pending = this->properties->pendingCommand;
+        this->properties->pendingCommand.reset(NULL);
+        return pending;
+    }
+
     Pointer<StompFrame> frame;
 
     try {
@@ -189,7 +356,12 @@ Pointer<Command> StompWireFormat::unmarshal(const activemq::transport::Transport
         frame.reset(new StompFrame());
 
         // Read the command header.
-        frame->fromStream(in);
+        frame->fromStream(in, isStomp11());
+
+        // Heart-beats only need to show that the broker is still there.
+        if (frame->isHeartBeat()) {
+            return Pointer<Command>(new KeepAliveInfo());
+        }
 
         // Return the Command.
         const std::string commandId = frame->getCommand();
@@ -251,9 +423,17 @@ Pointer<Command> StompWireFormat::unmarshalMessage(const Pointer<StompFrame> fra
     // We created a unique id when we registered the subscription for the consumer
     // now extract it back to a consumer Id so the ActiveMQConnection can dispatch it
     // correctly.
-    Pointer<ConsumerId> consumerId = helper->convertConsumerId(frame->removeProperty(StompCommandConstants::HEADER_SUBSCRIPTION));
+    std::string subscription = frame->removeProperty(StompCommandConstants::HEADER_SUBSCRIPTION);
+    Pointer<ConsumerId> consumerId = helper->convertConsumerId(subscription);
     messageDispatch->setConsumerId(consumerId);
 
+    // Client individual subscriptions need every message answered, 1.2 by its ack header.
+    if (isStomp11()) {
+        this->properties->addPendingAck(subscription, PendingAck(
+            frame->getProperty(StompCommandConstants::HEADER_MESSAGEID),
+            frame->getProperty(StompCommandConstants::HEADER_ACK)));
+    }
+
     if (frame->hasProperty(StompCommandConstants::HEADER_CONTENTLENGTH)) {
 
         Pointer<ActiveMQBytesMessage> message(new ActiveMQBytesMessage());
@@ -296,7 +476,7 @@ Pointer<Command> StompWireFormat::unmarshalReceipt(const Pointer<StompFrame> fra
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-Pointer<Command> StompWireFormat::unmarshalConnected(const Pointer<StompFrame> frame AMQCPP_UNUSED) {
+Pointer<Command> StompWireFormat::unmarshalConnected(const Pointer<StompFrame> frame) {
 
     Pointer<Response> response(new Response());
 
@@ -306,7 +486,50 @@ Pointer<Command> StompWireFormat::unmarshalConnected(const Pointer<StompFrame> f
         throw IOException(__FILE__, __LINE__, "Error, Connected Command has no Response ID.");
     }
 
-    return response;
+    // A broker that doesn't send a version only speaks 1.0.
+    this->properties->protocolVersion.set(parseProtocolVersion(
+        frame->getProperty(StompCommandConstants::HEADER_VERSION, StompCommandConstants::VERSION_1_0)));
+
+    if (!isStomp11() || !frame->hasProperty(StompCommandConstants::HEADER_HEARTBEAT)) {
+        return response;
+    }
+
+    StringTokenizer tokenizer(frame->getProperty(StompCommandConstants::HEADER_HEARTBEAT), ",");
+    if (tokenizer.countTokens() != 2) {
+        throw IOException(__FILE__, __LINE__, "Error, Connected Command has an invalid heart-beat header.");
+    }
+
+    long long brokerOutgoing = Long::parseLong(tokenizer.nextToken());
+    long long brokerIncoming = Long::parseLong(tokenizer.nextToken());
+
+    long long writeInterval = 0;
+    if (this->properties->outgoingHeartBeat > 0 && brokerIncoming > 0) {
+        writeInterval = Math::max(this->properties->outgoingHeartBeat, brokerIncoming);
+    }
+
+    long long readInterval = 0;
+    if (this->properties->incomingHeartBeat > 0 && brokerOutgoing > 0) {
+        readInterval = Math::max(this->properties->incomingHeartBeat, brokerOutgoing);
+    }
+
+    if (writeInterval == 0 && readInterval == 0) {
+        return response;
+    }
+
+    // Hand the agreement to the InactivityMonitor the same way OpenWire does, by way of
+    // a WireFormatInfo.  Reads are given half an interval of grace for network delays and
+    // writes are checked twice per interval since the monitor can let a whole check period
+    // pass after the last write before it notices.  The info didn't come from the broker,
+    // it is marked so that the connection doesn't take its version as the broker's.
+    Pointer<WireFormatInfo> info(new WireFormatInfo());
+    info->setMaxInactivityDuration(readInterval + readInterval / 2);
+    info->setMaxInactivityDurationInitalDelay(0);
+    info->getProperties().setLong("WriteCheckTime", writeInterval / 2 > 0 ? writeInterval / 2 : writeInterval);
+    info->getProperties().setBool("TransportOnly", true);
+
+    this->properties->pendingCommand = response;
+
+    return info;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -380,27 +603,84 @@ Pointer<StompFrame> StompWireFormat::marshalMessage(const Pointer<Command> comma
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-Pointer<StompFrame> StompWireFormat::marshalAck(const Pointer<Command> command) {
+void StompWireFormat::marshalAck(const Pointer<Command> command, std::vector< Pointer<StompFrame> >& frames) {
 
     Pointer<MessageAck> ack = command.dynamicCast<MessageAck>();
 
-    Pointer<StompFrame> frame(new StompFrame());
-    frame->setCommand(StompCommandConstants::ACK);
+    std::string messageId = helper->convertMessageId(ack->getLastMessageId());
 
-    if (command->isResponseRequired()) {
-        frame->setProperty(StompCommandConstants::HEADER_RECEIPT_REQUIRED,
-                           std::string("ignore:") + Integer::toString(command->getCommandId()));
+    if (!isStomp11()) {
+
+        Pointer<StompFrame> frame(new StompFrame());
+        frame->setCommand(StompCommandConstants::ACK);
+
+        if (command->isResponseRequired()) {
+            frame->setProperty(StompCommandConstants::HEADER_RECEIPT_REQUIRED,
+                               std::string("ignore:") + Integer::toString(command->getCommandId()));
+        }
+
+        frame->setProperty(StompCommandConstants::HEADER_MESSAGEID, messageId);
+
+        if (ack->getTransactionId() != NULL) {
+            frame->setProperty(StompCommandConstants::HEADER_TRANSACTIONID,
+                               helper->convertTransactionId(ack->getTransactionId()));
+        }
+
+        frames.push_back(frame);
+        return;
+    }
+
+    // From 1.1 on subscriptions are client-individual, so every message the core ack
+    // covers is answered on its own.  Delivered and redelivered acks only matter to the
+    // OpenWire prefetch window, a poison ack rejects only the message it names with a
+    // NACK, consumed acks cover all messages up to the last one and the rest name a
+    // single message.
+    int ackType = ack->getAckType();
+    if (ackType == ActiveMQConstants::ACK_TYPE_DELIVERED || ackType == ActiveMQConstants::ACK_TYPE_REDELIVERED) {
+        return;
     }
 
-    frame->setProperty(StompCommandConstants::HEADER_MESSAGEID,
-        helper->convertMessageId(ack->getLastMessageId()));
+    bool nack = ackType == ActiveMQConstants::ACK_TYPE_POISON;
+    bool cumulative = ackType == ActiveMQConstants::ACK_TYPE_CONSUMED;
 
-    if (ack->getTransactionId() != NULL) {
-        frame->setProperty(StompCommandConstants::HEADER_TRANSACTIONID,
-                           helper->convertTransactionId(ack->getTransactionId()));
+    std::string subscription = helper->convertConsumerId(ack->getConsumerId());
+
+    PendingAckList acked;
+    this->properties->takePendingAcks(subscription, messageId, cumulative, acked);
+
+    // Messages that weren't seen on the way in are answered by their id alone.
+    if (acked.empty()) {
+        acked.push_back(PendingAck(messageId, ""));
     }
 
-    return frame;
+    bool stomp12 = this->properties->protocolVersion.get() >= STOMP_1_2;
+
+    PendingAckList::const_iterator iter = acked.begin();
+    for (; iter != acked.end(); ++iter) {
+
+        Pointer<StompFrame> frame(new StompFrame());
+        frame->setCommand(nack ? StompCommandConstants::NACK : StompCommandConstants::ACK);
+
+        if (stomp12) {
+            frame->setProperty(StompCommandConstants::HEADER_ID, iter->ackId.empty() ? iter->messageId : iter->ackId);
+        }
+
+        frame->setProperty(StompCommandConstants::HEADER_MESSAGEID, iter->messageId);
+        frame->setProperty(StompCommandConstants::HEADER_SUBSCRIPTION, subscription);
+
+        if (ack->getTransactionId() != NULL) {
+            frame->setProperty(StompCommandConstants::HEADER_TRANSACTIONID,
+                               helper->convertTransactionId(ack->getTransactionId()));
+        }
+
+        frames.push_back(frame);
+    }
+
+    // Only the last frame needs to carry the receipt request.
+    if (command->isResponseRequired()) {
+        frames.back()->setProperty(StompCommandConstants::HEADER_RECEIPT_REQUIRED,
+                                   std::string("ignore:") + Integer::toString(command->getCommandId()));
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -414,6 +694,25 @@ Pointer<StompFrame> StompWireFormat::marshalConnectionInfo(const Pointer<Command
     frame->setProperty(StompCommandConstants::HEADER_LOGIN, info->getUserName());
     frame->setProperty(StompCommandConstants::HEADER_PASSWORD, info->getPassword());
 
+    // Offering only 1.0 leaves the frame as a plain 1.0 CONNECT.
+    if (!this->properties->acceptVersion.empty() &&
+        this->properties->acceptVersion != StompCommandConstants::VERSION_1_0) {
+        frame->setProperty(StompCommandConstants::HEADER_ACCEPT_VERSION, this->properties->acceptVersion);
+
+        // Required from 1.1 on, it lets a broker serve several virtual hosts.
+        if (!this->properties->host.empty()) {
+            frame->setProperty(StompCommandConstants::HEADER_HOST, this->properties->host);
+        }
+
+        frame->setProperty(StompCommandConstants::HEADER_HEARTBEAT,
+                           Long::toString(this->properties->outgoingHeartBeat) + "," +
+                           Long::toString(this->properties->incomingHeartBeat));
+    }
+
+    // Until the broker answers, this connection speaks 1.0.
+    this->properties->protocolVersion.set(STOMP_1_0);
+    this->properties->clearPendingAcks();
+
     this->properties->connectResponseId = info->getCommandId();
 
     // Store this for later.
@@ -474,7 +773,9 @@ Pointer<StompFrame> StompWireFormat::marshalRemoveInfo(const Pointer<Command> co
 
     try {
         Pointer<ConsumerId> id = info->getObjectId().dynamicCast<ConsumerId>();
-        frame->setProperty(StompCommandConstants::HEADER_ID, helper->convertConsumerId(id));
+        std::string subscription = helper->convertConsumerId(id);
+        frame->setProperty(StompCommandConstants::HEADER_ID, subscription);
+        this->properties->removePendingAcks(subscription);
         return frame;
     } catch (ClassCastException& ex) {
     }
@@ -517,9 +818,10 @@ Pointer<StompFrame> StompWireFormat::marshalConsumerInfo(const Pointer<Command>
         frame->setProperty(StompCommandConstants::HEADER_SELECTOR, info->getSelector());
     }
 
-    // TODO - This should eventually check the session to see what its mode really is.
-    //        This will work for now but in order to add individual ack we need to check.
-    frame->setProperty(StompCommandConstants::HEADER_ACK, "client");
+    // From 1.1 on messages are acked one by one so that a NACK only rejects the one
+    // message, the acks the core sends are spread out over the messages they cover.
+    frame->setProperty(StompCommandConstants::HEADER_ACK,
+                       isStomp11() ? StompCommandConstants::ACK_INDIVIDUAL : StompCommandConstants::ACK_CLIENT);
 
     if (info->isNoLocal()) {
         frame->setProperty(StompCommandConstants::HEADER_NOLOCAL, "true");
@@ -601,3 +903,61 @@ std::string StompWireFormat::getTempQueuePrefix() const {
 void StompWireFormat::setTempQueuePrefix(const std::string& prefix) {
     this->properties->tempQueuePrefix = prefix;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+std::string StompWireFormat::getAcceptVersion() const {
+    return this->properties->acceptVersion;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompWireFormat::setAcceptVersion(const std::string& versions) {
+    this->properties->acceptVersion = versions;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string StompWireFormat::getHost() const {
+    return this->properties->host;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompWireFormat::setHost(const std::string& host) {
+    this->properties->host = host;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long StompWireFormat::getOutgoingHeartBeat() const {
+    return this->properties->outgoingHeartBeat;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompWireFormat::setOutgoingHeartBeat(long long interval) {
+    this->properties->outgoingHeartBeat = interval;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long StompWireFormat::getIncomingHeartBeat() const {
+    return this->properties->incomingHeartBeat;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompWireFormat::setIncomingHeartBeat(long long interval) {
+    this->properties->incomingHeartBeat = interval;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string StompWireFormat::getProtocolVersion() const {
+
+    switch (this->properties->protocolVersion.get()) {
+        case STOMP_1_2:
+            return StompCommandConstants::VERSION_1_2;
+        case STOMP_1_1:
+            return StompCommandConstants::VERSION_1_1;
+        default:
+            return StompCommandConstants::VERSION_1_0;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool StompWireFormat::isStomp11() const {
+    return this->properties->protocolVersion.get() >= STOMP_1_1;
+}
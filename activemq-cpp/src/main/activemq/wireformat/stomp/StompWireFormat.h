@@ -171,6 +171,84 @@ namespace stomp {
          */
         void setTempQueuePrefix(const std::string& prefix);
 
+        /**
+         * Gets the comma separated list of STOMP versions offered when connecting.
+         *
+         * @return the versions sent in the accept-version header.
+         */
+        std::string getAcceptVersion() const;
+
+        /**
+         * Sets the comma separated list of STOMP versions offered when connecting, the
+         * broker picks the highest one it supports.  The default is 1.0 only, newer
+         * versions have to be asked for, e.g. "1.0,1.1,1.2".
+         *
+         * @param versions
+         *      The versions to send in the accept-version header.
+         */
+        void setAcceptVersion(const std::string& versions);
+
+        /**
+         * Gets the host name sent in the CONNECT frame.
+         *
+         * @return the host sent in the host header.
+         */
+        std::string getHost() const;
+
+        /**
+         * Sets the host name sent in the CONNECT frame, STOMP 1.1 and later require it
+         * so that a broker can serve more than one virtual host.  Only sent along with
+         * a version above 1.0 and only when not empty.
+         *
+         * @param host
+         *      The host to send in the host header.
+         */
+        void setHost(const std::string& host);
+
+        /**
+         * Gets the smallest interval in milliseconds at which this client offers to send
+         * heart-beats, zero if it won't send any.
+         *
+         * @return the outgoing heart-beat interval.
+         */
+        long long getOutgoingHeartBeat() const;
+
+        /**
+         * Sets the smallest interval in milliseconds at which this client offers to send
+         * heart-beats, zero if it won't send any.  Only offered along with a version
+         * above 1.0.
+         *
+         * @param interval
+         *      The outgoing heart-beat interval.
+         */
+        void setOutgoingHeartBeat(long long interval);
+
+        /**
+         * Gets the interval in milliseconds at which this client would like to receive
+         * heart-beats from the broker, zero if it doesn't want any.
+         *
+         * @return the incoming heart-beat interval.
+         */
+        long long getIncomingHeartBeat() const;
+
+        /**
+         * Sets the interval in milliseconds at which this client would like to receive
+         * heart-beats from the broker, zero if it doesn't want any.  Only offered along with a version
+         * above 1.0.
+         *
+         * @param interval
+         *      The incoming heart-beat interval.
+         */
+        void setIncomingHeartBeat(long long interval);
+
+        /**
+         * Gets the STOMP version agreed on with the broker, this is 1.0 until a
+         * CONNECTED frame says otherwise.
+         *
+         * @return the negotiated protocol version.
+         */
+        std::string getProtocolVersion() const;
+
         /**
          * Is there a Message being unmarshaled?
          *
@@ -200,13 +278,15 @@ namespace stomp {
 
     private:
 
+        bool isStomp11() const;
+
         Pointer<Command> unmarshalMessage(const Pointer<StompFrame> frame);
         Pointer<Command> unmarshalReceipt(const Pointer<StompFrame> frame);
         Pointer<Command> unmarshalConnected(const Pointer<StompFrame> frame);
         Pointer<Command> unmarshalError(const Pointer<StompFrame> frame);
 
         Pointer<StompFrame> marshalMessage(const Pointer<Command> command);
-        Pointer<StompFrame> marshalAck(const Pointer<Command> command);
+        void marshalAck(const Pointer<Command> command, std::vector< Pointer<StompFrame> >& frames);
         Pointer<StompFrame> marshalConnectionInfo(const Pointer<Command> command);
         Pointer<StompFrame> marshalTransactionInfo(const Pointer<Command> command);
         Pointer<StompFrame> marshalShutdownInfo(const Pointer<Command> command);
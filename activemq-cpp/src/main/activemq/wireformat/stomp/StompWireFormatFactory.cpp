@@ -19,11 +19,14 @@
 
 #include <activemq/exceptions/ActiveMQException.h>
 
+#include <decaf/lang/Long.h>
+
 using namespace std;
 using namespace activemq;
 using namespace activemq::wireformat;
 using namespace activemq::wireformat::stomp;
 using namespace activemq::exceptions;
+using namespace decaf::lang;
 
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<WireFormat> StompWireFormatFactory::createWireFormat(const decaf::util::Properties& properties AMQCPP_UNUSED) {
@@ -40,9 +43,18 @@ Pointer<WireFormat> StompWireFormatFactory::createWireFormat(const decaf::util::
             properties.getProperty("wireFormat.tempTopicPrefix", "/temp-topic/"));
         wireFormat->setTempQueuePrefix(
             properties.getProperty("wireFormat.tempQueuePrefix", "/temp-queue/"));
+        wireFormat->setAcceptVersion(
+            properties.getProperty("wireFormat.acceptVersion", "1.0"));
+        wireFormat->setHost(
+            properties.getProperty("wireFormat.host", ""));
+        wireFormat->setOutgoingHeartBeat(
+            Long::parseLong(properties.getProperty("wireFormat.outgoingHeartBeat", "0")));
+        wireFormat->setIncomingHeartBeat(
+            Long::parseLong(properties.getProperty("wireFormat.incomingHeartBeat", "0")));
 
         return wireFormat;
     }
     AMQ_CATCH_RETHROW(ActiveMQException)
+    AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::Exception, ActiveMQException)
     AMQ_CATCHALL_THROW(ActiveMQException)
 }
@@ -24,3 +24,34 @@ MessageConsumer::~MessageConsumer() {
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+std::vector<Message*> MessageConsumer::receiveBatch(int maxMessages, int millisecs) {
+
+    if (maxMessages <= 0) {
+        throw CMSException("Batch size must be at least one");
+    }
+
+    std::vector<Message*> messages;
+
+    Message* message = NULL;
+    if (millisecs == 0) {
+        message = this->receive();
+    } else if (millisecs < 0) {
+        message = this->receiveNoWait();
+    } else {
+        message = this->receive(millisecs);
+    }
+
+    try {
+        while (message != NULL) {
+            messages.push_back(message);
+            if ((int) messages.size() >= maxMessages) {
+                break;
+            }
+            message = this->receiveNoWait();
+        }
+    } catch (CMSException& ex) {
+    }
+
+    return messages;
+}
@@ -26,6 +26,8 @@
 #include <cms/Startable.h>
 #include <cms/Stoppable.h>
 
+#include <vector>
+
 namespace cms {
 
     class MessageTransformer;
@@ -164,6 +166,32 @@ namespace cms {
          */
         virtual cms::MessageAvailableListener* getMessageAvailableListener() const = 0;
 
+        /**
+         * Synchronously Receive up to maxMessages Messages in one call.  Waits for the
+         * first message like receive(int) does and then returns it together with any
+         * further messages that are available right away.  Consuming the messages as a
+         * batch lets the provider acknowledge them together.
+         *
+         * The default implementation calls receive for the first message and then
+         * receiveNoWait for the others, providers override it to do better.  Should one
+         * of the later calls fail the messages already received are returned and the
+         * error is left for the next call to report.
+         *
+         * @param maxMessages
+         *      The maximum number of messages to return, must be at least one.
+         * @param millisecs
+         *      The time to wait for the first message, zero waits indefinitely and a
+         *      negative value doesn't wait at all.
+         *
+         * @return the new messages which the caller owns and must delete, empty if
+         *         nothing was read.
+         *
+         * @throws CMSException - If an internal error occurs.
+         *
+         * @since 3.10
+         */
+        virtual std::vector<Message*> receiveBatch(int maxMessages, int millisecs);
+
     };
 
 }
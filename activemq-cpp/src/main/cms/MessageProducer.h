@@ -28,6 +28,7 @@
 #include <cms/MessageFormatException.h>
 #include <cms/UnsupportedOperationException.h>
 #include <cms/DeliveryMode.h>
+#include <cms/ProducerWindowListener.h>
 
 namespace cms {
 
@@ -368,6 +369,79 @@ namespace cms {
          */
         virtual cms::MessageTransformer* getMessageTransformer() const = 0;
 
+        /**
+         * Attempts to send the message to the default producer destination without waiting
+         * for space in the producer's send window.  If the window is full the message is not
+         * sent, false is returned and the registered ProducerWindowListener is notified once
+         * space becomes available.  Uses default values for deliveryMode, priority, and time
+         * to live.  A send that requires a response from the provider still waits for that
+         * response, so this method only avoids blocking when sends are asynchronous.
+         *
+         * @param message
+         *      The message to be sent.
+         *
+         * @return true if the message was sent, false if the send window was full.
+         *
+         * @throws CMSException - if an internal error occurs while sending the message.
+         * @throws MessageFormatException - if an Invalid Message is given.
+         * @throws InvalidDestinationException - if a client uses this method with a
+         *         MessageProducer with an invalid destination.
+         * @throws UnsupportedOperationException - if a client uses this method with a
+         *         MessageProducer that did not specify a destination at creation time.
+         *
+         * @since 3.10
+         */
+        virtual bool trySend(Message* message) = 0;
+
+        /**
+         * Attempts to send the message to the given destination without waiting for space in
+         * the producer's send window, see trySend(Message*) for details.
+         *
+         * @param destination
+         *      The destination on which to send the message
+         * @param message
+         *      The message to be sent.
+         *
+         * @return true if the message was sent, false if the send window was full.
+         *
+         * @throws CMSException - if an internal error occurs while sending the message.
+         * @throws MessageFormatException - if an Invalid Message is given.
+         * @throws InvalidDestinationException - if a client uses this method with a
+         *         MessageProducer with an invalid destination.
+         * @throws UnsupportedOperationException - if a client uses this method with a
+         *         MessageProducer that did specify a destination at creation time.
+         *
+         * @since 3.10
+         */
+        virtual bool trySend(const Destination* destination, Message* message) = 0;
+
+        /**
+         * Sets the ProducerWindowListener that is notified when space becomes available in
+         * the send window after a trySend call was refused.
+         *
+         * The CMS code never takes ownership of the listener, the client must ensure that it
+         * remains valid for the lifetime of this producer or until it is replaced.
+         *
+         * @param listener
+         *      The listener to notify or NULL to clear it.
+         *
+         * @throws CMSException - If an internal error occurs.
+         *
+         * @since 3.10
+         */
+        virtual void setProducerWindowListener(cms::ProducerWindowListener* listener) = 0;
+
+        /**
+         * Gets the ProducerWindowListener that this producer notifies of window space.
+         *
+         * @return the registered listener or NULL if none is set.
+         *
+         * @throws CMSException - If an internal error occurs.
+         *
+         * @since 3.10
+         */
+        virtual cms::ProducerWindowListener* getProducerWindowListener() const = 0;
+
     };
 
 }
@@ -0,0 +1,54 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _CMS_PRODUCERWINDOWLISTENER_H_
+#define _CMS_PRODUCERWINDOWLISTENER_H_
+
+#include <cms/Config.h>
+
+namespace cms {
+
+    class MessageProducer;
+
+    /**
+     * A listener that is notified by a MessageProducer once space has become available
+     * in its send window after a call to trySend was refused because the window was
+     * full.  The notification is delivered once per refused trySend episode from the
+     * thread that processes the provider's acknowledgements, so implementations should
+     * return quickly.
+     *
+     * @since 3.10
+     */
+    class CMS_API ProducerWindowListener {
+    public:
+
+        virtual ~ProducerWindowListener();
+
+        /**
+         * Indicates that the given producer can accept messages again, a call to
+         * trySend is now expected to succeed.
+         *
+         * @param producer
+         *      The producer whose send window has space available.
+         */
+        virtual void onWindowAvailable(cms::MessageProducer* producer) = 0;
+
+    };
+
+}
+
+#endif /* _CMS_PRODUCERWINDOWLISTENER_H_ */
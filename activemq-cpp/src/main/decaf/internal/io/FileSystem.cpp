@@ -0,0 +1,104 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FileSystem.h"
+
+#include <decaf/internal/AprPool.h>
+
+#include <apr_errno.h>
+#include <apr_file_io.h>
+#include <apr_file_info.h>
+
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::internal;
+using namespace decaf::internal::io;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    std::string errorString(apr_status_t status) {
+        char buffer[256];
+        return std::string(apr_strerror(status, buffer, sizeof(buffer)));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool FileSystem::exists(const std::string& path) {
+
+    AprPool pool;
+    apr_finfo_t info;
+
+    apr_status_t result = apr_stat(&info, path.c_str(), APR_FINFO_TYPE, pool.getAprPool());
+    return result == APR_SUCCESS || result == APR_INCOMPLETE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool FileSystem::remove(const std::string& path) {
+
+    AprPool pool;
+    return apr_file_remove(path.c_str(), pool.getAprPool()) == APR_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileSystem::makeDirectories(const std::string& path) {
+
+    AprPool pool;
+
+    apr_status_t result = apr_dir_make_recursive(path.c_str(), APR_OS_DEFAULT, pool.getAprPool());
+    if (result != APR_SUCCESS && !APR_STATUS_IS_EEXIST(result)) {
+        throw IOException(__FILE__, __LINE__, "Could not create directory %s: %s",
+                          path.c_str(), errorString(result).c_str());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool FileSystem::removeDirectory(const std::string& path) {
+
+    AprPool pool;
+    return apr_dir_remove(path.c_str(), pool.getAprPool()) == APR_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<std::string> FileSystem::list(const std::string& path) {
+
+    AprPool pool;
+    apr_dir_t* directory = NULL;
+
+    apr_status_t result = apr_dir_open(&directory, path.c_str(), pool.getAprPool());
+    if (result != APR_SUCCESS) {
+        throw IOException(__FILE__, __LINE__, "Could not open directory %s: %s",
+                          path.c_str(), errorString(result).c_str());
+    }
+
+    std::vector<std::string> names;
+    apr_finfo_t info;
+
+    while (true) {
+        result = apr_dir_read(&info, APR_FINFO_NAME | APR_FINFO_TYPE, directory);
+        if (result != APR_SUCCESS && result != APR_INCOMPLETE) {
+            break;
+        }
+
+        if (info.filetype == APR_REG && info.name != NULL) {
+            names.push_back(info.name);
+        }
+    }
+
+    apr_dir_close(directory);
+    return names;
+}
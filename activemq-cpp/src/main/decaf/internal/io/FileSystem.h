@@ -0,0 +1,102 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_INTERNAL_IO_FILESYSTEM_H_
+#define _DECAF_INTERNAL_IO_FILESYSTEM_H_
+
+#include <decaf/util/Config.h>
+#include <decaf/io/IOException.h>
+
+#include <string>
+#include <vector>
+
+namespace decaf {
+namespace internal {
+namespace io {
+
+    /**
+     * Minimal set of platform independent file system operations used by the
+     * file backed parts of the library.
+     *
+     * @since 3.10
+     */
+    class DECAF_API FileSystem {
+    private:
+
+        FileSystem();
+        FileSystem(const FileSystem&);
+        FileSystem& operator=(const FileSystem&);
+
+    public:
+
+        /**
+         * @param path
+         *      The path of the file or directory to check.
+         *
+         * @return true if something exists at the given path.
+         */
+        static bool exists(const std::string& path);
+
+        /**
+         * Removes the file at the given path.
+         *
+         * @param path
+         *      The path of the file to remove.
+         *
+         * @return true if the file was removed, false if it didn't exist or couldn't be removed.
+         */
+        static bool remove(const std::string& path);
+
+        /**
+         * Creates the given directory along with any missing parent directories,
+         * it is not an error for the directory to already exist.
+         *
+         * @param path
+         *      The path of the directory to create.
+         *
+         * @throws IOException if the directory could not be created.
+         */
+        static void makeDirectories(const std::string& path);
+
+        /**
+         * Removes the directory at the given path, the directory must be empty.
+         *
+         * @param path
+         *      The path of the directory to remove.
+         *
+         * @return true if the directory was removed.
+         */
+        static bool removeDirectory(const std::string& path);
+
+        /**
+         * Lists the names of the regular files held in a directory, the names don't
+         * include the directory path and are returned in no particular order.
+         *
+         * @param path
+         *      The path of the directory to list.
+         *
+         * @return the names of the files found in the directory.
+         *
+         * @throws IOException if the directory could not be read.
+         */
+        static std::vector<std::string> list(const std::string& path);
+
+    };
+
+}}}
+
+#endif /* _DECAF_INTERNAL_IO_FILESYSTEM_H_ */
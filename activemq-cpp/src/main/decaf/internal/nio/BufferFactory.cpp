@@ -24,14 +24,19 @@
 #include <decaf/internal/nio/LongArrayBuffer.h>
 #include <decaf/internal/nio/IntArrayBuffer.h>
 #include <decaf/internal/nio/ShortArrayBuffer.h>
+#include <decaf/internal/util/AlignedByteArrayAdapter.h>
 
 using namespace decaf;
 using namespace decaf::internal;
 using namespace decaf::internal::nio;
+using namespace decaf::internal::util;
 using namespace decaf::nio;
 using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
 
+////////////////////////////////////////////////////////////////////////////////
+const int BufferFactory::DEFAULT_DIRECT_ALIGNMENT = 64;
+
 ////////////////////////////////////////////////////////////////////////////////
 ByteBuffer* BufferFactory::createByteBuffer( int capacity ) {
 
@@ -42,6 +47,18 @@ ByteBuffer* BufferFactory::createByteBuffer( int capacity ) {
     DECAF_CATCHALL_THROW( IndexOutOfBoundsException )
 }
 
+////////////////////////////////////////////////////////////////////////////////
+ByteBuffer* BufferFactory::createDirectByteBuffer( int capacity, int alignment ) {
+
+    try{
+        Pointer<ByteArrayAdapter> array( new AlignedByteArrayAdapter( capacity, alignment ) );
+        return new ByteArrayBuffer( array, 0, capacity, false );
+    }
+    DECAF_CATCH_RETHROW( IllegalArgumentException )
+    DECAF_CATCH_EXCEPTION_CONVERT( Exception, IllegalArgumentException )
+    DECAF_CATCHALL_THROW( IllegalArgumentException )
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ByteBuffer* BufferFactory::createByteBuffer( unsigned char* buffer, int size, int offset, int length ) {
 
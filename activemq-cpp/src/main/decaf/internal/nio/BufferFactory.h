@@ -39,6 +39,13 @@ namespace nio{
      * @since 1.0
      */
     class DECAF_API BufferFactory {
+    public:
+
+        /**
+         * Alignment used for direct buffers when none is given, one cache line.
+         */
+        static const int DEFAULT_DIRECT_ALIGNMENT;
+
     public:
 
         virtual ~BufferFactory() {}
@@ -56,6 +63,22 @@ namespace nio{
          */
         static decaf::nio::ByteBuffer* createByteBuffer( int capacity );
 
+        /**
+         * Allocates a new direct byte buffer whose memory starts on the given boundary,
+         * its position will be zero its limit will be its capacity and its mark is not set.
+         *
+         * @param capacity
+         *      The internal buffer's capacity.
+         * @param alignment
+         *      The alignment of the buffer's first byte, a power of two.
+         *
+         * @return a newly allocated direct ByteBuffer which the caller owns.
+         *
+         * @throws IllegalArgumentException if the capacity is negative or the alignment
+         *         is not a power of two.
+         */
+        static decaf::nio::ByteBuffer* createDirectByteBuffer( int capacity, int alignment );
+
         /**
          * Wraps the passed buffer with a new ByteBuffer.
          *
@@ -16,6 +16,14 @@
  */
 
 #include "ByteArrayBuffer.h"
+#include "decaf/internal/nio/ByteArrayViewAdapter.h"
+#include "decaf/internal/nio/CharArrayBuffer.h"
+#include "decaf/internal/nio/DoubleArrayBuffer.h"
+#include "decaf/internal/nio/FloatArrayBuffer.h"
+#include "decaf/internal/nio/IntArrayBuffer.h"
+#include "decaf/internal/nio/LongArrayBuffer.h"
+#include "decaf/internal/nio/ShortArrayBuffer.h"
+#include "decaf/lang/exceptions/UnsupportedOperationException.h"
 #include "decaf/lang/Short.h"
 #include "decaf/lang/Integer.h"
 #include "decaf/lang/Long.h"
@@ -143,6 +151,77 @@ int ByteArrayBuffer::arrayOffset() const {
     DECAF_CATCHALL_THROW( decaf::nio::ReadOnlyBufferException )
 }
 
+////////////////////////////////////////////////////////////////////////////////
+decaf::nio::CharBuffer* ByteArrayBuffer::asCharBuffer() const {
+
+    try{
+        return new CharArrayBuffer( this->_array, this->offset + this->position(),
+                                    this->remaining(), this->isReadOnly() );
+    }
+    DECAF_CATCH_RETHROW( Exception )
+    DECAF_CATCHALL_THROW( Exception )
+}
+
+////////////////////////////////////////////////////////////////////////////////
+decaf::nio::DoubleBuffer* ByteArrayBuffer::asDoubleBuffer() const {
+
+    try{
+        Pointer<ByteArrayAdapter> view(
+            new ByteArrayViewAdapter( this->_array, this->offset + this->position(), this->remaining() ) );
+        return new DoubleArrayBuffer( view, 0, this->remaining() / (int)sizeof( double ), this->isReadOnly() );
+    }
+    DECAF_CATCH_RETHROW( Exception )
+    DECAF_CATCHALL_THROW( Exception )
+}
+
+////////////////////////////////////////////////////////////////////////////////
+decaf::nio::FloatBuffer* ByteArrayBuffer::asFloatBuffer() const {
+
+    try{
+        Pointer<ByteArrayAdapter> view(
+            new ByteArrayViewAdapter( this->_array, this->offset + this->position(), this->remaining() ) );
+        return new FloatArrayBuffer( view, 0, this->remaining() / (int)sizeof( float ), this->isReadOnly() );
+    }
+    DECAF_CATCH_RETHROW( Exception )
+    DECAF_CATCHALL_THROW( Exception )
+}
+
+////////////////////////////////////////////////////////////////////////////////
+decaf::nio::IntBuffer* ByteArrayBuffer::asIntBuffer() const {
+
+    try{
+        Pointer<ByteArrayAdapter> view(
+            new ByteArrayViewAdapter( this->_array, this->offset + this->position(), this->remaining() ) );
+        return new IntArrayBuffer( view, 0, this->remaining() / (int)sizeof( int ), this->isReadOnly() );
+    }
+    DECAF_CATCH_RETHROW( Exception )
+    DECAF_CATCHALL_THROW( Exception )
+}
+
+////////////////////////////////////////////////////////////////////////////////
+decaf::nio::LongBuffer* ByteArrayBuffer::asLongBuffer() const {
+
+    try{
+        Pointer<ByteArrayAdapter> view(
+            new ByteArrayViewAdapter( this->_array, this->offset + this->position(), this->remaining() ) );
+        return new LongArrayBuffer( view, 0, this->remaining() / (int)sizeof( long long ), this->isReadOnly() );
+    }
+    DECAF_CATCH_RETHROW( Exception )
+    DECAF_CATCHALL_THROW( Exception )
+}
+
+////////////////////////////////////////////////////////////////////////////////
+decaf::nio::ShortBuffer* ByteArrayBuffer::asShortBuffer() const {
+
+    try{
+        Pointer<ByteArrayAdapter> view(
+            new ByteArrayViewAdapter( this->_array, this->offset + this->position(), this->remaining() ) );
+        return new ShortArrayBuffer( view, 0, this->remaining() / (int)sizeof( short ), this->isReadOnly() );
+    }
+    DECAF_CATCH_RETHROW( Exception )
+    DECAF_CATCHALL_THROW( Exception )
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ByteArrayBuffer* ByteArrayBuffer::asReadOnlyBuffer() const {
 
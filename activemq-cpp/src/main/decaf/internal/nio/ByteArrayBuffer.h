@@ -209,37 +209,44 @@ namespace nio{
          */
         virtual bool hasArray() const { return true; }
 
+        /**
+         * {@inheritDoc}
+         */
+        virtual bool isDirect() const {
+            return this->_array->isDirect();
+        }
+
     public:   // Abstract Methods
 
         /**
          * {@inheritDoc}
          */
-        virtual decaf::nio::CharBuffer* asCharBuffer() const { return NULL; } //TODO
+        virtual decaf::nio::CharBuffer* asCharBuffer() const;
 
         /**
          * {@inheritDoc}
          */
-        virtual decaf::nio::DoubleBuffer* asDoubleBuffer() const { return NULL; } //TODO
+        virtual decaf::nio::DoubleBuffer* asDoubleBuffer() const;
 
         /**
          * {@inheritDoc}
          */
-        virtual decaf::nio::FloatBuffer* asFloatBuffer() const { return NULL; } //TODO
+        virtual decaf::nio::FloatBuffer* asFloatBuffer() const;
 
         /**
          * {@inheritDoc}
          */
-        virtual decaf::nio::IntBuffer* asIntBuffer() const { return NULL; } //TODO
+        virtual decaf::nio::IntBuffer* asIntBuffer() const;
 
         /**
          * {@inheritDoc}
          */
-        virtual decaf::nio::LongBuffer* asLongBuffer() const { return NULL; } //TODO
+        virtual decaf::nio::LongBuffer* asLongBuffer() const;
 
         /**
          * {@inheritDoc}
          */
-        virtual decaf::nio::ShortBuffer* asShortBuffer() const { return NULL; } //TODO
+        virtual decaf::nio::ShortBuffer* asShortBuffer() const;
 
         /**
          * {@inheritDoc}
@@ -418,6 +425,14 @@ namespace nio{
             this->readOnly = value;
         }
 
+        /**
+         * @return the offset into the backing ByteArrayAdapter where this buffer starts,
+         *         unlike arrayOffset this is available for read-only buffers as well.
+         */
+        int getOffset() const {
+            return this->offset;
+        }
+
     };
 
 }}}
@@ -0,0 +1,131 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ByteArrayViewAdapter.h"
+
+#include <decaf/lang/exceptions/UnsupportedOperationException.h>
+
+using namespace decaf;
+using namespace decaf::internal;
+using namespace decaf::internal::nio;
+using namespace decaf::internal::util;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+ByteArrayViewAdapter::ByteArrayViewAdapter(const Pointer<ByteArrayAdapter>& source, int offset, int size) :
+    ByteArrayAdapter(addressOf(source, offset, size), size, false), source(source) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ByteArrayViewAdapter::~ByteArrayViewAdapter() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+unsigned char* ByteArrayViewAdapter::addressOf(const Pointer<ByteArrayAdapter>& source, int offset, int size) {
+
+    if (source == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "Source adapter of the view is NULL");
+    }
+
+    if (offset < 0 || size < 0 || offset > source->getCapacity() - size) {
+        throw IndexOutOfBoundsException(__FILE__, __LINE__,
+            "View region %d+%d lies outside the source of %d bytes", offset, size, source->getCapacity());
+    }
+
+    return source->getByteArray() + offset;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+short* ByteArrayViewAdapter::getShortArray() {
+    throw UnsupportedOperationException(__FILE__, __LINE__, "A byte buffer view has no short array");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int* ByteArrayViewAdapter::getIntArray() {
+    throw UnsupportedOperationException(__FILE__, __LINE__, "A byte buffer view has no int array");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long* ByteArrayViewAdapter::getLongArray() {
+    throw UnsupportedOperationException(__FILE__, __LINE__, "A byte buffer view has no long array");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+double* ByteArrayViewAdapter::getDoubleArray() {
+    throw UnsupportedOperationException(__FILE__, __LINE__, "A byte buffer view has no double array");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+float* ByteArrayViewAdapter::getFloatArray() {
+    throw UnsupportedOperationException(__FILE__, __LINE__, "A byte buffer view has no float array");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ByteArrayViewAdapter::resize(int size DECAF_UNUSED) {
+    throw UnsupportedOperationException(__FILE__, __LINE__, "A byte buffer view can't be resized");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+double ByteArrayViewAdapter::getDouble(int index) const {
+    return this->getDoubleAt(index * (int) sizeof(double));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+float ByteArrayViewAdapter::getFloat(int index) const {
+    return this->getFloatAt(index * (int) sizeof(float));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long ByteArrayViewAdapter::getLong(int index) const {
+    return this->getLongAt(index * (int) sizeof(long long));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ByteArrayViewAdapter::getInt(int index) const {
+    return this->getIntAt(index * (int) sizeof(int));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+short ByteArrayViewAdapter::getShort(int index) const {
+    return this->getShortAt(index * (int) sizeof(short));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ByteArrayAdapter& ByteArrayViewAdapter::putDouble(int index, double value) {
+    return this->putDoubleAt(index * (int) sizeof(double), value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ByteArrayAdapter& ByteArrayViewAdapter::putFloat(int index, float value) {
+    return this->putFloatAt(index * (int) sizeof(float), value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ByteArrayAdapter& ByteArrayViewAdapter::putLong(int index, long long value) {
+    return this->putLongAt(index * (int) sizeof(long long), value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ByteArrayAdapter& ByteArrayViewAdapter::putInt(int index, int value) {
+    return this->putIntAt(index * (int) sizeof(int), value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ByteArrayAdapter& ByteArrayViewAdapter::putShort(int index, short value) {
+    return this->putShortAt(index * (int) sizeof(short), value);
+}
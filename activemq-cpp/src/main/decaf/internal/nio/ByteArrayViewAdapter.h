@@ -0,0 +1,113 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_INTERNAL_NIO_BYTEARRAYVIEWADAPTER_H_
+#define _DECAF_INTERNAL_NIO_BYTEARRAYVIEWADAPTER_H_
+
+#include <decaf/internal/util/ByteArrayAdapter.h>
+#include <decaf/lang/Pointer.h>
+
+namespace decaf {
+namespace internal {
+namespace nio {
+
+    /**
+     * A ByteArrayAdapter over a region of another adapter that reads and writes its
+     * typed elements the way a ByteBuffer does, in big-endian order and at any byte
+     * offset.  The typed views of a ByteArrayBuffer are built over one of these so that
+     * they see the same values as ByteBuffer::getInt and friends and need no alignment.
+     *
+     * Because the elements are not stored in native order the typed array accessors
+     * such as getIntArray() are not supported.  The adapter holds a reference to the
+     * source so the memory stays valid for as long as the view is alive.
+     *
+     * @since 3.10
+     */
+    class DECAF_API ByteArrayViewAdapter : public decaf::internal::util::ByteArrayAdapter {
+    private:
+
+        decaf::lang::Pointer<decaf::internal::util::ByteArrayAdapter> source;
+
+    private:
+
+        ByteArrayViewAdapter(const ByteArrayViewAdapter&);
+        ByteArrayViewAdapter& operator=(const ByteArrayViewAdapter&);
+
+    public:
+
+        /**
+         * Wraps size bytes of the source adapter starting at the given byte offset.
+         *
+         * @param source
+         *      The adapter whose memory the view shares.
+         * @param offset
+         *      The byte offset in the source of the first byte of the view.
+         * @param size
+         *      The number of bytes in the view.
+         *
+         * @throws NullPointerException if the source is NULL.
+         * @throws IndexOutOfBoundsException if the region lies outside the source.
+         */
+        ByteArrayViewAdapter(const decaf::lang::Pointer<decaf::internal::util::ByteArrayAdapter>& source,
+                             int offset, int size);
+
+        virtual ~ByteArrayViewAdapter();
+
+        /**
+         * {@inheritDoc}
+         */
+        virtual bool isDirect() const {
+            return this->source->isDirect();
+        }
+
+        /**
+         * {@inheritDoc}
+         */
+        virtual bool hasArray() const {
+            return false;
+        }
+
+        virtual short* getShortArray();
+        virtual int* getIntArray();
+        virtual long long* getLongArray();
+        virtual double* getDoubleArray();
+        virtual float* getFloatArray();
+
+        virtual void resize(int size);
+
+        virtual double getDouble(int index) const;
+        virtual float getFloat(int index) const;
+        virtual long long getLong(int index) const;
+        virtual int getInt(int index) const;
+        virtual short getShort(int index) const;
+
+        virtual ByteArrayAdapter& putDouble(int index, double value);
+        virtual ByteArrayAdapter& putFloat(int index, float value);
+        virtual ByteArrayAdapter& putLong(int index, long long value);
+        virtual ByteArrayAdapter& putInt(int index, int value);
+        virtual ByteArrayAdapter& putShort(int index, short value);
+
+    private:
+
+        static unsigned char* addressOf(const decaf::lang::Pointer<decaf::internal::util::ByteArrayAdapter>& source,
+                                        int offset, int size);
+
+    };
+
+}}}
+
+#endif /* _DECAF_INTERNAL_NIO_BYTEARRAYVIEWADAPTER_H_ */
@@ -158,7 +158,7 @@ namespace nio {
          * {@inheritDoc}
          */
         virtual bool hasArray() const {
-            return true;
+            return this->_array->hasArray();
         }
 
         /**
@@ -157,7 +157,7 @@ namespace nio{
         /**
          * {@inheritDoc}
          */
-        virtual bool hasArray() const { return true; }
+        virtual bool hasArray() const { return this->_array->hasArray(); }
 
         /**
          * {@inheritDoc}
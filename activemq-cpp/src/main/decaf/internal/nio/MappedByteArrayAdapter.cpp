@@ -0,0 +1,60 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MappedByteArrayAdapter.h"
+
+#include <decaf/lang/Integer.h>
+
+using namespace decaf;
+using namespace decaf::internal;
+using namespace decaf::internal::nio;
+using namespace decaf::internal::util;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+MappedByteArrayAdapter::MappedByteArrayAdapter(const Pointer<MappedFile>& file) :
+    ByteArrayAdapter(addressOf(file), sizeOf(file), false), file(file) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MappedByteArrayAdapter::~MappedByteArrayAdapter() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+unsigned char* MappedByteArrayAdapter::addressOf(const Pointer<MappedFile>& file) {
+
+    if (file == NULL || !file->isOpen()) {
+        throw NullPointerException(__FILE__, __LINE__, "Mapped file is NULL or closed");
+    }
+
+    return file->getAddress();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int MappedByteArrayAdapter::sizeOf(const Pointer<MappedFile>& file) {
+
+    if (file == NULL || !file->isOpen()) {
+        throw NullPointerException(__FILE__, __LINE__, "Mapped file is NULL or closed");
+    }
+
+    if (file->getSize() > Integer::MAX_VALUE) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Mapping of %lld bytes is too large for a buffer", file->getSize());
+    }
+
+    return (int) file->getSize();
+}
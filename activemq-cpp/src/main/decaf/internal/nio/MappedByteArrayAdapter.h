@@ -0,0 +1,85 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_INTERNAL_NIO_MAPPEDBYTEARRAYADAPTER_H_
+#define _DECAF_INTERNAL_NIO_MAPPEDBYTEARRAYADAPTER_H_
+
+#include <decaf/internal/util/ByteArrayAdapter.h>
+#include <decaf/internal/nio/MappedFile.h>
+#include <decaf/lang/Pointer.h>
+
+namespace decaf {
+namespace internal {
+namespace nio {
+
+    /**
+     * A ByteArrayAdapter over the memory of a MappedFile.  The adapter holds a reference
+     * to the file so the mapping stays valid for as long as any buffer or view created
+     * over it is alive.
+     *
+     * @since 3.10
+     */
+    class DECAF_API MappedByteArrayAdapter : public decaf::internal::util::ByteArrayAdapter {
+    private:
+
+        decaf::lang::Pointer<MappedFile> file;
+
+    private:
+
+        MappedByteArrayAdapter(const MappedByteArrayAdapter&);
+        MappedByteArrayAdapter& operator=(const MappedByteArrayAdapter&);
+
+    public:
+
+        /**
+         * Wraps the mapped memory of the given file.
+         *
+         * @param file
+         *      The open MappedFile to wrap, its size must fit in an int.
+         *
+         * @throws NullPointerException if the file is NULL or closed.
+         * @throws IllegalArgumentException if the mapping is too large for a buffer.
+         */
+        MappedByteArrayAdapter(const decaf::lang::Pointer<MappedFile>& file);
+
+        virtual ~MappedByteArrayAdapter();
+
+        /**
+         * @return the file whose memory this adapter wraps.
+         */
+        decaf::lang::Pointer<MappedFile> getFile() const {
+            return this->file;
+        }
+
+        /**
+         * {@inheritDoc}
+         */
+        virtual bool isDirect() const {
+            return true;
+        }
+
+    private:
+
+        static unsigned char* addressOf(const decaf::lang::Pointer<MappedFile>& file);
+
+        static int sizeOf(const decaf::lang::Pointer<MappedFile>& file);
+
+    };
+
+}}}
+
+#endif /* _DECAF_INTERNAL_NIO_MAPPEDBYTEARRAYADAPTER_H_ */
@@ -0,0 +1,379 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MappedFile.h"
+
+#include <decaf/internal/AprPool.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+
+#include <apr_errno.h>
+#include <apr_file_io.h>
+#include <apr_file_info.h>
+#include <apr_mmap.h>
+
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::internal;
+using namespace decaf::internal::nio;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace decaf {
+namespace internal {
+namespace nio {
+
+    class MappedFileImpl {
+    private:
+
+        MappedFileImpl(const MappedFileImpl&);
+        MappedFileImpl& operator=(const MappedFileImpl&);
+
+    public:
+
+        AprPool pool;
+        std::string path;
+        apr_file_t* file;
+        apr_mmap_t* mapping;
+        long long offset;
+        long long size;
+
+        // Distance from the start of the mapping to the first requested byte, the
+        // mapping itself has to start on an allocation boundary.
+        long long slack;
+
+        bool readOnly;
+
+        // False when the file handle was handed in by the caller, it is then only
+        // borrowed while the mapping is created and never closed here.
+        bool ownsFile;
+
+        MappedFileImpl(const std::string& path) :
+            pool(), path(path), file(NULL), mapping(NULL), offset(0), size(0), slack(0), readOnly(false), ownsFile(true) {
+        }
+
+        unsigned char* base() const {
+            return (unsigned char*) this->mapping->mm;
+        }
+
+        static std::string errorString(apr_status_t status) {
+            char buffer[256];
+            return std::string(apr_strerror(status, buffer, sizeof(buffer)));
+        }
+
+        static long long granularity() {
+#if defined(_WIN32)
+            SYSTEM_INFO info;
+            ::GetSystemInfo(&info);
+            return (long long) info.dwAllocationGranularity;
+#elif HAVE_UNISTD_H
+            long pageSize = ::sysconf(_SC_PAGESIZE);
+            return pageSize > 0 ? (long long) pageSize : 4096LL;
+#else
+            return 65536LL;
+#endif
+        }
+    };
+
+}}}
+
+////////////////////////////////////////////////////////////////////////////////
+MappedFile::MappedFile(const std::string& path, long long size) : impl(new MappedFileImpl(path)) {
+
+    try {
+
+        if (size < 0) {
+            throw IllegalArgumentException(__FILE__, __LINE__, "Mapped size cannot be negative: %lld", size);
+        }
+
+        this->initialize(0, size, true, false);
+    } catch (Exception& ex) {
+        delete impl;
+        ex.setMark(__FILE__, __LINE__);
+        throw;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MappedFile::MappedFile(const std::string& path, long long offset, long long size, bool readOnly) :
+    impl(new MappedFileImpl(path)) {
+
+    try {
+
+        if (offset < 0) {
+            throw IllegalArgumentException(__FILE__, __LINE__, "Mapped offset cannot be negative: %lld", offset);
+        }
+
+        if (size <= 0) {
+            throw IllegalArgumentException(__FILE__, __LINE__, "Mapped size must be positive: %lld", size);
+        }
+
+        this->initialize(offset, size, false, readOnly);
+    } catch (Exception& ex) {
+        delete impl;
+        ex.setMark(__FILE__, __LINE__);
+        throw;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MappedFile::MappedFile(apr_file_t* file, const std::string& path, long long offset, long long size, bool readOnly) :
+    impl(new MappedFileImpl(path)) {
+
+    try {
+
+        if (file == NULL) {
+            throw NullPointerException(__FILE__, __LINE__, "File handle to map is NULL");
+        }
+
+        if (offset < 0) {
+            throw IllegalArgumentException(__FILE__, __LINE__, "Mapped offset cannot be negative: %lld", offset);
+        }
+
+        if (size <= 0) {
+            throw IllegalArgumentException(__FILE__, __LINE__, "Mapped size must be positive: %lld", size);
+        }
+
+        this->impl->file = file;
+        this->impl->ownsFile = false;
+
+        this->initialize(offset, size, false, readOnly);
+    } catch (Exception& ex) {
+        delete impl;
+        ex.setMark(__FILE__, __LINE__);
+        throw;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MappedFile::initialize(long long offset, long long size, bool wholeFile, bool readOnly) {
+
+    const std::string& path = this->impl->path;
+
+    try {
+
+        apr_status_t result = APR_SUCCESS;
+
+        if (impl->ownsFile) {
+
+            apr_int32_t flags = readOnly ? APR_FOPEN_READ | APR_FOPEN_BINARY :
+                                           APR_FOPEN_READ | APR_FOPEN_WRITE | APR_FOPEN_CREATE | APR_FOPEN_BINARY;
+
+            result = apr_file_open(&impl->file, path.c_str(), flags, APR_OS_DEFAULT, impl->pool.getAprPool());
+            if (result != APR_SUCCESS) {
+                impl->file = NULL;
+                throw IOException(__FILE__, __LINE__, "Could not open file %s: %s",
+                                  path.c_str(), MappedFileImpl::errorString(result).c_str());
+            }
+        }
+
+        apr_finfo_t info;
+        result = apr_file_info_get(&info, APR_FINFO_SIZE, impl->file);
+        if (result != APR_SUCCESS) {
+            throw IOException(__FILE__, __LINE__, "Could not read the size of file %s: %s",
+                              path.c_str(), MappedFileImpl::errorString(result).c_str());
+        }
+
+        long long length = (long long) info.size;
+
+        if (length < offset + size) {
+            if (readOnly) {
+                throw IOException(__FILE__, __LINE__, "Region %lld+%lld lies beyond the end of file %s",
+                                  offset, size, path.c_str());
+            }
+
+            result = apr_file_trunc(impl->file, (apr_off_t) (offset + size));
+            if (result != APR_SUCCESS) {
+                throw IOException(__FILE__, __LINE__, "Could not grow file %s to %lld bytes: %s",
+                                  path.c_str(), offset + size, MappedFileImpl::errorString(result).c_str());
+            }
+            length = offset + size;
+        }
+
+        impl->offset = offset;
+        impl->size = wholeFile ? length : size;
+        impl->slack = offset % MappedFileImpl::granularity();
+        impl->readOnly = readOnly;
+
+        if (impl->size == 0) {
+            throw IOException(__FILE__, __LINE__, "Cannot map the empty file %s", path.c_str());
+        }
+
+        apr_int32_t protection = readOnly ? APR_MMAP_READ : APR_MMAP_READ | APR_MMAP_WRITE;
+
+        result = apr_mmap_create(&impl->mapping, impl->file, (apr_off_t) (offset - impl->slack),
+                                 (apr_size_t) (impl->size + impl->slack), protection, impl->pool.getAprPool());
+        if (result != APR_SUCCESS) {
+            impl->mapping = NULL;
+            throw IOException(__FILE__, __LINE__, "Could not map file %s: %s",
+                              path.c_str(), MappedFileImpl::errorString(result).c_str());
+        }
+
+        // The mapping doesn't depend on the handle, let go of a borrowed one so the
+        // caller is free to close it.
+        if (!impl->ownsFile) {
+            impl->file = NULL;
+        }
+    } catch (Exception& ex) {
+        try {
+            this->close();
+        } catch (...) {
+        }
+        ex.setMark(__FILE__, __LINE__);
+        throw;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MappedFile::~MappedFile() {
+    try {
+        this->close();
+    }
+    DECAF_CATCHALL_NOTHROW()
+
+    try {
+        delete this->impl;
+    }
+    DECAF_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const std::string& MappedFile::getPath() const {
+    return this->impl->path;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long MappedFile::getOffset() const {
+    return this->impl->offset;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long MappedFile::getSize() const {
+    return this->impl->size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool MappedFile::isReadOnly() const {
+    return this->impl->readOnly;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+unsigned char* MappedFile::getAddress() const {
+    if (this->impl->mapping == NULL) {
+        return NULL;
+    }
+
+    return this->impl->base() + this->impl->slack;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool MappedFile::isOpen() const {
+    return this->impl->mapping != NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MappedFile::load() {
+
+    if (this->impl->mapping == NULL) {
+        throw IOException(__FILE__, __LINE__, "File %s is closed", this->impl->path.c_str());
+    }
+
+#if defined(HAVE_SYS_MMAN_H) && defined(MADV_WILLNEED)
+    ::madvise(this->impl->base(), (size_t) (this->impl->size + this->impl->slack), MADV_WILLNEED);
+#endif
+
+    const long long pageSize = MappedFileImpl::granularity();
+    const volatile unsigned char* address = this->getAddress();
+
+    unsigned char sum = 0;
+    for (long long position = 0; position < this->impl->size; position += pageSize) {
+        sum = (unsigned char) (sum + address[position]);
+    }
+
+    (void) sum;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MappedFile::force() {
+
+    if (this->impl->mapping == NULL) {
+        throw IOException(__FILE__, __LINE__, "File %s is closed", this->impl->path.c_str());
+    }
+
+    if (this->impl->readOnly) {
+        return;
+    }
+
+    bool failed = false;
+    size_t length = (size_t) (this->impl->size + this->impl->slack);
+
+#if defined(HAVE_SYS_MMAN_H)
+    failed = ::msync(this->impl->base(), length, MS_SYNC) != 0;
+#elif defined(_WIN32)
+    failed = ::FlushViewOfFile(this->impl->base(), (SIZE_T) length) == 0;
+#endif
+
+    if (failed) {
+        throw IOException(__FILE__, __LINE__, "Could not flush file %s", this->impl->path.c_str());
+    }
+
+    if (this->impl->file == NULL) {
+        return;
+    }
+
+    apr_status_t result = apr_file_flush(this->impl->file);
+    if (result != APR_SUCCESS) {
+        throw IOException(__FILE__, __LINE__, "Could not flush file %s: %s",
+                          this->impl->path.c_str(), MappedFileImpl::errorString(result).c_str());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MappedFile::close() {
+
+    apr_status_t result = APR_SUCCESS;
+
+    if (this->impl->mapping != NULL) {
+        result = apr_mmap_delete(this->impl->mapping);
+        this->impl->mapping = NULL;
+    }
+
+    if (this->impl->file != NULL) {
+        apr_status_t closed = this->impl->ownsFile ? apr_file_close(this->impl->file) : APR_SUCCESS;
+        this->impl->file = NULL;
+        if (result == APR_SUCCESS) {
+            result = closed;
+        }
+    }
+
+    if (result != APR_SUCCESS) {
+        throw IOException(__FILE__, __LINE__, "Error while closing file %s: %s",
+                          this->impl->path.c_str(), MappedFileImpl::errorString(result).c_str());
+    }
+}
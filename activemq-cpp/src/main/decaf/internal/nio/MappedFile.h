@@ -0,0 +1,183 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_INTERNAL_NIO_MAPPEDFILE_H_
+#define _DECAF_INTERNAL_NIO_MAPPEDFILE_H_
+
+#include <decaf/util/Config.h>
+#include <decaf/io/IOException.h>
+
+#include <string>
+
+#include <apr_file_io.h>
+
+namespace decaf {
+namespace internal {
+namespace nio {
+
+    class MappedFileImpl;
+
+    /**
+     * A file whose contents are mapped read / write into the address space of the
+     * process.  Writes to the mapped memory land in the OS page cache directly and
+     * survive a crash of the process, calling force() pushes them out to the device
+     * so that they also survive a crash of the machine.
+     *
+     * The file is opened, created if needed, and grown to the requested size when the
+     * object is constructed and stays mapped until close() is called or the object is
+     * destroyed.  Either the whole file or a region of it can be mapped, optionally
+     * read-only.
+     *
+     * @since 3.10
+     */
+    class DECAF_API MappedFile {
+    private:
+
+        MappedFileImpl* impl;
+
+    private:
+
+        MappedFile(const MappedFile&);
+        MappedFile& operator=(const MappedFile&);
+
+    public:
+
+        /**
+         * Opens or creates the file at the given path and maps it into memory.  When the
+         * file is shorter than the requested size it is first extended with zeros, when it
+         * is longer its whole length is mapped.
+         *
+         * @param path
+         *      The path of the file to map.
+         * @param size
+         *      The minimum size of the mapping, or zero to map an existing file as is.
+         *
+         * @throws IOException if the file can't be opened, resized or mapped.
+         * @throws IllegalArgumentException if the size is negative.
+         */
+        MappedFile(const std::string& path, long long size);
+
+        /**
+         * Maps the region of the given file that starts at offset and spans size bytes.
+         * The offset need not be aligned to the page size.  When the mapping is writable
+         * the file is created if needed and grown to cover the region, a read-only region
+         * must lie within the existing file.
+         *
+         * @param path
+         *      The path of the file to map.
+         * @param offset
+         *      The position in the file where the region starts.
+         * @param size
+         *      The size of the region in bytes.
+         * @param readOnly
+         *      True if the region is mapped for reading only.
+         *
+         * @throws IOException if the file can't be opened, resized or mapped.
+         * @throws IllegalArgumentException if the offset is negative or the size is not positive.
+         */
+        MappedFile(const std::string& path, long long offset, long long size, bool readOnly);
+
+        /**
+         * Maps the region of a file that the caller already has open, the file is not
+         * reopened by path so the mapping is of the very file behind the handle.  The
+         * handle is only used while the mapping is created, it stays owned by the caller
+         * and may be closed while the mapping is still in use.  A writable region grows
+         * the file when it extends beyond its end.
+         *
+         * @param file
+         *      The open APR file to map, opened for writing unless readOnly is true.
+         * @param path
+         *      The path of the file, used in messages and returned by getPath().
+         * @param offset
+         *      The position in the file where the region starts.
+         * @param size
+         *      The size of the region in bytes.
+         * @param readOnly
+         *      True if the region is mapped for reading only.
+         *
+         * @throws IOException if the file can't be resized or mapped.
+         * @throws IllegalArgumentException if the offset is negative or the size is not positive.
+         * @throws NullPointerException if the file handle is NULL.
+         */
+        MappedFile(apr_file_t* file, const std::string& path, long long offset, long long size, bool readOnly);
+
+        virtual ~MappedFile();
+
+        /**
+         * @return the path of the mapped file.
+         */
+        const std::string& getPath() const;
+
+        /**
+         * @return the position in the file of the first mapped byte.
+         */
+        long long getOffset() const;
+
+        /**
+         * @return the number of bytes that are mapped.
+         */
+        long long getSize() const;
+
+        /**
+         * @return true if the mapping can't be written to.
+         */
+        bool isReadOnly() const;
+
+        /**
+         * @return the address of the first mapped byte, or NULL once closed.
+         */
+        unsigned char* getAddress() const;
+
+        /**
+         * @return true until the file has been closed.
+         */
+        bool isOpen() const;
+
+        /**
+         * Asks the OS to read the mapped region into physical memory and touches each page
+         * so that later accesses don't fault.  This is only a hint, pages can be evicted
+         * again at any time.
+         *
+         * @throws IOException if the file is closed.
+         */
+        void load();
+
+        /**
+         * Writes any modified pages of the mapping back to the storage device and waits
+         * for the write to complete.
+         *
+         * @throws IOException if the file is closed or the flush fails.
+         */
+        void force();
+
+        /**
+         * Unmaps and closes the file, the address returned by getAddress() becomes
+         * invalid.  Calling close on a closed file has no effect.
+         *
+         * @throws IOException if an error occurs while releasing the file.
+         */
+        void close();
+
+    private:
+
+        void initialize(long long offset, long long size, bool wholeFile, bool readOnly);
+
+    };
+
+}}}
+
+#endif /* _DECAF_INTERNAL_NIO_MAPPEDFILE_H_ */
@@ -0,0 +1,77 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AlignedByteArrayAdapter.h"
+
+#include <string.h>
+
+using namespace decaf;
+using namespace decaf::internal;
+using namespace decaf::internal::util;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+AlignedByteArrayAdapter::AlignedByteArrayAdapter(int size, int alignment) :
+    ByteArrayAdapter(allocate(size, alignment), size, false), alignment(alignment) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+AlignedByteArrayAdapter::~AlignedByteArrayAdapter() {
+    try {
+        release(this->getByteArray());
+    }
+    DECAF_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+unsigned char* AlignedByteArrayAdapter::allocate(int size, int alignment) {
+
+    if (size < 0) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Array size cannot be negative: %d", size);
+    }
+
+    if (alignment <= 0 || (alignment & (alignment - 1)) != 0) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Alignment must be a power of two: %d", alignment);
+    }
+
+    // Over allocate so that an aligned start can always be found, the address of the
+    // raw block is kept just in front of the aligned start for release().
+    std::size_t padding = (std::size_t) alignment - 1 + sizeof(unsigned char*);
+    unsigned char* raw = new unsigned char[(std::size_t) size + padding];
+
+    std::size_t address = (std::size_t) (raw + sizeof(unsigned char*));
+    unsigned char* aligned = raw + sizeof(unsigned char*) +
+        ((std::size_t) alignment - address % (std::size_t) alignment) % (std::size_t) alignment;
+
+    memcpy(aligned - sizeof(unsigned char*), &raw, sizeof(unsigned char*));
+    memset(aligned, 0, (std::size_t) size);
+
+    return aligned;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AlignedByteArrayAdapter::release(unsigned char* array) {
+
+    if (array == NULL) {
+        return;
+    }
+
+    unsigned char* raw = NULL;
+    memcpy(&raw, array - sizeof(unsigned char*), sizeof(unsigned char*));
+    delete[] raw;
+}
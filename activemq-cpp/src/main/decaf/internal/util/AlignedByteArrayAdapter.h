@@ -0,0 +1,84 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_INTERNAL_UTIL_ALIGNEDBYTEARRAYADAPTER_H_
+#define _DECAF_INTERNAL_UTIL_ALIGNEDBYTEARRAYADAPTER_H_
+
+#include <decaf/internal/util/ByteArrayAdapter.h>
+
+namespace decaf {
+namespace internal {
+namespace util {
+
+    /**
+     * A ByteArrayAdapter over a zero filled block of memory whose start address is a
+     * multiple of the requested alignment.  The block is owned by the adapter and is
+     * released when the adapter is destroyed, it can't be resized.
+     *
+     * @since 3.10
+     */
+    class DECAF_API AlignedByteArrayAdapter : public ByteArrayAdapter {
+    private:
+
+        int alignment;
+
+    private:
+
+        AlignedByteArrayAdapter(const AlignedByteArrayAdapter&);
+        AlignedByteArrayAdapter& operator=(const AlignedByteArrayAdapter&);
+
+    public:
+
+        /**
+         * Allocates size bytes aligned to the given boundary.
+         *
+         * @param size
+         *      The size of the array, this is the limit we read and write to.
+         * @param alignment
+         *      The alignment of the first byte, must be a power of two.
+         *
+         * @throws IllegalArgumentException if size is negative or alignment isn't a power of two.
+         */
+        AlignedByteArrayAdapter(int size, int alignment);
+
+        virtual ~AlignedByteArrayAdapter();
+
+        /**
+         * @return the alignment of the first byte of the array.
+         */
+        int getAlignment() const {
+            return this->alignment;
+        }
+
+        /**
+         * {@inheritDoc}
+         */
+        virtual bool isDirect() const {
+            return true;
+        }
+
+    private:
+
+        static unsigned char* allocate(int size, int alignment);
+
+        static void release(unsigned char* array);
+
+    };
+
+}}}
+
+#endif /* _DECAF_INTERNAL_UTIL_ALIGNEDBYTEARRAYADAPTER_H_ */
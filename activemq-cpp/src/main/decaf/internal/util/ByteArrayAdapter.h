@@ -311,6 +311,26 @@ namespace util {
             return this->array.floats;
         }
 
+        /**
+         * Indicates if the wrapped memory is direct, meaning it is allocated outside the
+         * usual heap arrays with a known alignment, or is mapped from a file.
+         *
+         * @return true if the memory wrapped by this adapter is direct.
+         */
+        virtual bool isDirect() const {
+            return false;
+        }
+
+        /**
+         * Indicates if the typed array accessors such as getIntArray() expose the wrapped
+         * memory in the element order and alignment of the typed buffers built on it.
+         *
+         * @return true if the typed array accessors can be used.
+         */
+        virtual bool hasArray() const {
+            return true;
+        }
+
         /**
          * Reads from the Byte array starting at the specified offset and reading
          * the specified length.  If the length is greater than the size of this
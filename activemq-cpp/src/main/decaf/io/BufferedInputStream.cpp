@@ -322,7 +322,7 @@ int BufferedInputStream::bufferData(InputStream* inputStream, unsigned char*& bu
             }
 
             unsigned char* temp = new unsigned char[newLength];
-            System::arraycopy(temp, 0, buffer, 0, count);
+            System::arraycopy(buffer, 0, temp, 0, count);
             std::swap(temp, buffer);
             delete[] temp;
             this->bufferSize = newLength;
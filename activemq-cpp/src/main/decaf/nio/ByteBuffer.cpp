@@ -23,6 +23,8 @@
 #include "decaf/lang/Float.h"
 #include "decaf/lang/Double.h"
 
+#include <string.h>
+
 using namespace std;
 using namespace decaf;
 using namespace decaf::nio;
@@ -44,6 +46,26 @@ ByteBuffer* ByteBuffer::allocate( int capacity ) {
     DECAF_CATCHALL_THROW( IllegalArgumentException )
 }
 
+////////////////////////////////////////////////////////////////////////////////
+ByteBuffer* ByteBuffer::allocateDirect( int capacity ) {
+
+    try{
+        return BufferFactory::createDirectByteBuffer( capacity, BufferFactory::DEFAULT_DIRECT_ALIGNMENT );
+    }
+    DECAF_CATCH_RETHROW( IllegalArgumentException )
+    DECAF_CATCHALL_THROW( IllegalArgumentException )
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ByteBuffer* ByteBuffer::allocateDirect( int capacity, int alignment ) {
+
+    try{
+        return BufferFactory::createDirectByteBuffer( capacity, alignment );
+    }
+    DECAF_CATCH_RETHROW( IllegalArgumentException )
+    DECAF_CATCHALL_THROW( IllegalArgumentException )
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ByteBuffer* ByteBuffer::wrap( unsigned char* buffer, int size, int offset, int length ) {
 
@@ -128,6 +150,13 @@ ByteBuffer& ByteBuffer::get( unsigned char* buffer, int size, int offset, int le
                 "ByteBuffer::get - Not Enough Data to Fill Request.");
         }
 
+        // Copy straight out of the backing array when it is accessible.
+        if( this->hasArray() && !this->isReadOnly() ) {
+            memcpy( buffer + offset, this->array() + this->arrayOffset() + this->position(), length );
+            this->position( this->position() + length );
+            return *this;
+        }
+
         // read length bytes starting from the offset
         for( int ix = 0; ix < length; ++ix ) {
             buffer[ix + offset] = this->get();
@@ -165,6 +194,15 @@ ByteBuffer& ByteBuffer::put( ByteBuffer& src ) {
                 "ByteBuffer::put - Not enough space remaining to put src." );
         }
 
+        if( this->hasArray() && src.hasArray() && !src.isReadOnly() ) {
+            int length = src.remaining();
+            memmove( this->array() + this->arrayOffset() + this->position(),
+                     src.array() + src.arrayOffset() + src.position(), length );
+            this->position( this->position() + length );
+            src.position( src.position() + length );
+            return *this;
+        }
+
         while( src.hasRemaining() ) {
             this->put( src.get() );
         }
@@ -210,6 +248,12 @@ ByteBuffer& ByteBuffer::put( const unsigned char* buffer, int size, int offset,
                 "ByteBuffer::put - Not Enough space to store requested Data.");
         }
 
+        if( this->hasArray() ) {
+            memmove( this->array() + this->arrayOffset() + this->position(), buffer + offset, length );
+            this->position( this->position() + length );
+            return *this;
+        }
+
         // read length bytes starting from the offset
         for( int ix = 0; ix < length; ++ix ) {
             this->put( buffer[ix + offset] );
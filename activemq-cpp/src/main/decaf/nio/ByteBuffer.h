@@ -93,6 +93,17 @@ namespace nio{
      *   contiguous sequences of values between a buffer and an array or some other
      *   buffer of the same type; and
      *
+     *   A view buffer reads and writes the shared memory directly, values are kept in
+     *   the same big-endian order used by the byte buffer's own get and put methods
+     *   and the view can start at any position of the byte buffer.
+     *
+     * Direct vs. non-direct buffers:
+     *
+     * A direct byte buffer is backed by memory with a known alignment that is allocated
+     * outside of the usual heap arrays, or by a region of a file that is mapped into
+     * memory (see MappedByteBuffer).  Direct buffers are intended for large, long lived
+     * payloads and for file I/O where their contents can be used in place.
+     *
      */
     class DECAF_API ByteBuffer : public Buffer,
                                  public lang::Comparable<ByteBuffer> {
@@ -289,6 +300,13 @@ namespace nio{
          */
         virtual bool hasArray() const = 0;
 
+        /**
+         * Tells whether or not this byte buffer is direct.
+         *
+         * @return true if, and only if, this buffer is direct.
+         */
+        virtual bool isDirect() const = 0;
+
         /**
          * Creates a view of this byte buffer as a char buffer.
          *
@@ -879,6 +897,37 @@ namespace nio{
          */
         static ByteBuffer* allocate(int capacity);
 
+        /**
+         * Allocates a new direct byte buffer whose first byte is aligned to a cache line,
+         * the buffer's position will be zero, its limit will be its capacity, its mark
+         * is not set and its contents are zeroed.
+         *
+         * @param capacity
+         *      The internal buffer's capacity.
+         *
+         * @return a newly allocated direct ByteBuffer which the caller owns.
+         *
+         * @throws IllegalArgumentException if capacity is negative.
+         */
+        static ByteBuffer* allocateDirect(int capacity);
+
+        /**
+         * Allocates a new direct byte buffer whose first byte is aligned to the given
+         * boundary, the buffer's position will be zero, its limit will be its capacity,
+         * its mark is not set and its contents are zeroed.
+         *
+         * @param capacity
+         *      The internal buffer's capacity.
+         * @param alignment
+         *      The alignment in bytes of the buffer's memory, must be a power of two.
+         *
+         * @return a newly allocated direct ByteBuffer which the caller owns.
+         *
+         * @throws IllegalArgumentException if capacity is negative or the alignment
+         *         is not a power of two.
+         */
+        static ByteBuffer* allocateDirect(int capacity, int alignment);
+
         /**
          * Wraps the passed buffer with a new ByteBuffer.
          *
@@ -0,0 +1,96 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MappedByteBuffer.h"
+
+using namespace decaf;
+using namespace decaf::nio;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::internal::nio;
+
+////////////////////////////////////////////////////////////////////////////////
+MappedByteBuffer::MappedByteBuffer(const Pointer<MappedByteArrayAdapter>& mapping, int offset, int length, bool readOnly) :
+    ByteArrayBuffer(mapping, offset, length, readOnly), mapping(mapping) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MappedByteBuffer::MappedByteBuffer(const MappedByteBuffer& other) :
+    ByteArrayBuffer(other), mapping(other.mapping) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MappedByteBuffer::~MappedByteBuffer() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MappedByteBuffer& MappedByteBuffer::force() {
+
+    try {
+        this->mapping->getFile()->force();
+        return *this;
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    DECAF_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MappedByteBuffer& MappedByteBuffer::load() {
+
+    try {
+        this->mapping->getFile()->load();
+        return *this;
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    DECAF_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MappedByteBuffer* MappedByteBuffer::asReadOnlyBuffer() const {
+
+    try {
+        MappedByteBuffer* buffer = new MappedByteBuffer(*this);
+        buffer->setReadOnly(true);
+        return buffer;
+    }
+    DECAF_CATCH_RETHROW(Exception)
+    DECAF_CATCHALL_THROW(Exception)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MappedByteBuffer* MappedByteBuffer::duplicate() {
+
+    try {
+        return new MappedByteBuffer(*this);
+    }
+    DECAF_CATCH_RETHROW(Exception)
+    DECAF_CATCHALL_THROW(Exception)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MappedByteBuffer* MappedByteBuffer::slice() const {
+
+    try {
+        return new MappedByteBuffer(this->mapping, this->getOffset() + this->position(),
+                                    this->remaining(), this->isReadOnly());
+    }
+    DECAF_CATCH_RETHROW(Exception)
+    DECAF_CATCHALL_THROW(Exception)
+}
@@ -0,0 +1,121 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_NIO_MAPPEDBYTEBUFFER_H_
+#define _DECAF_NIO_MAPPEDBYTEBUFFER_H_
+
+#include <decaf/util/Config.h>
+#include <decaf/internal/nio/ByteArrayBuffer.h>
+#include <decaf/internal/nio/MappedByteArrayAdapter.h>
+#include <decaf/lang/Pointer.h>
+#include <decaf/io/IOException.h>
+
+namespace decaf {
+namespace nio {
+
+    /**
+     * A direct byte buffer whose content is a memory-mapped region of a file.
+     *
+     * Mapped byte buffers are created via the FileChannel map method.  A mapped byte
+     * buffer and the file mapping that it represents remain valid until the buffer
+     * and every buffer or view derived from it have been destroyed, closing the
+     * channel that created it has no effect on the mapping.
+     *
+     * The content of a mapped byte buffer can change at any time, for example if the
+     * content of the corresponding region of the mapped file is changed by this program
+     * or another.  Changes made through a READ_WRITE mapping are eventually written to
+     * the file, force() can be used to wait for them to reach the storage device.
+     *
+     * @since 3.10
+     */
+    class DECAF_API MappedByteBuffer : public decaf::internal::nio::ByteArrayBuffer {
+    private:
+
+        decaf::lang::Pointer<decaf::internal::nio::MappedByteArrayAdapter> mapping;
+
+    public:
+
+        /**
+         * Creates a buffer over the given range of an existing mapping.
+         *
+         * @param mapping
+         *      The mapped memory that backs the new buffer.
+         * @param offset
+         *      The offset into the mapping where the buffer starts.
+         * @param length
+         *      The number of bytes of the mapping the buffer covers.
+         * @param readOnly
+         *      True if the buffer is read-only.
+         *
+         * @throws NullPointerException if mapping is NULL.
+         * @throws IndexOutOfBoundsException if offset and length don't lie within the mapping.
+         */
+        MappedByteBuffer(const decaf::lang::Pointer<decaf::internal::nio::MappedByteArrayAdapter>& mapping,
+                         int offset, int length, bool readOnly);
+
+        /**
+         * Create a MappedByteBuffer that shares the mapping and state of another.
+         *
+         * @param other
+         *      The MappedByteBuffer this one is to mirror.
+         */
+        MappedByteBuffer(const MappedByteBuffer& other);
+
+        virtual ~MappedByteBuffer();
+
+        /**
+         * Forces any changes made to this buffer's content to be written to the storage
+         * device containing the mapped file.  Has no effect for a read-only mapping.
+         *
+         * @return a reference to this buffer.
+         *
+         * @throws IOException if the changes could not be written.
+         */
+        MappedByteBuffer& force();
+
+        /**
+         * Loads this buffer's content into physical memory.  This is a best effort
+         * attempt to ensure that the content is resident when the method returns.
+         *
+         * @return a reference to this buffer.
+         *
+         * @throws IOException if the mapping is no longer valid.
+         */
+        MappedByteBuffer& load();
+
+    public:
+
+        /**
+         * {@inheritDoc}
+         */
+        virtual MappedByteBuffer* asReadOnlyBuffer() const;
+
+        /**
+         * {@inheritDoc}
+         */
+        virtual MappedByteBuffer* duplicate();
+
+        /**
+         * {@inheritDoc}
+         */
+        virtual MappedByteBuffer* slice() const;
+
+    };
+
+}}
+
+#endif /* _DECAF_NIO_MAPPEDBYTEBUFFER_H_ */
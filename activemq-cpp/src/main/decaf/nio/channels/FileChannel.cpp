@@ -0,0 +1,633 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FileChannel.h"
+
+#include <decaf/internal/AprPool.h>
+#include <decaf/internal/nio/MappedFile.h>
+#include <decaf/internal/nio/MappedByteArrayAdapter.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/Math.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/nio/ReadOnlyBufferException.h>
+#include <decaf/util/concurrent/Mutex.h>
+
+#include <apr_errno.h>
+#include <apr_file_io.h>
+#include <apr_file_info.h>
+#include <apr_portable.h>
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+#include <memory>
+#include <vector>
+
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::nio;
+using namespace decaf::nio::channels;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::internal;
+using namespace decaf::internal::nio;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace decaf {
+namespace nio {
+namespace channels {
+
+    class FileChannelImpl {
+    private:
+
+        FileChannelImpl(const FileChannelImpl&);
+        FileChannelImpl& operator=(const FileChannelImpl&);
+
+    public:
+
+        // Transfers map the source file in windows of this size.
+        static const int TRANSFER_WINDOW;
+
+        AprPool pool;
+        std::string path;
+        apr_file_t* file;
+        bool readOnly;
+        long long position;
+        Mutex mutex;
+
+        FileChannelImpl(const std::string& path, bool readOnly) :
+            pool(), path(path), file(NULL), readOnly(readOnly), position(0), mutex() {
+        }
+
+        static std::string errorString(apr_status_t status) {
+            char buffer[256];
+            return std::string(apr_strerror(status, buffer, sizeof(buffer)));
+        }
+
+        void checkOpen() const {
+            if (this->file == NULL) {
+                throw IOException(__FILE__, __LINE__, "Channel on file %s is closed", this->path.c_str());
+            }
+        }
+
+        void checkWritable() const {
+            if (this->readOnly) {
+                throw IOException(__FILE__, __LINE__, "Channel on file %s is read-only", this->path.c_str());
+            }
+        }
+
+        long long size() const {
+
+            apr_finfo_t info;
+            apr_status_t result = apr_file_info_get(&info, APR_FINFO_SIZE, this->file);
+            if (result != APR_SUCCESS) {
+                throw IOException(__FILE__, __LINE__, "Could not read the size of file %s: %s",
+                                  this->path.c_str(), errorString(result).c_str());
+            }
+
+            return (long long) info.size;
+        }
+
+        void seek(long long position) {
+
+            apr_off_t offset = (apr_off_t) position;
+            apr_status_t result = apr_file_seek(this->file, APR_SET, &offset);
+            if (result != APR_SUCCESS) {
+                throw IOException(__FILE__, __LINE__, "Could not seek to %lld in file %s: %s",
+                                  position, this->path.c_str(), errorString(result).c_str());
+            }
+        }
+
+        int readAt(unsigned char* buffer, int length, long long position) {
+
+            this->seek(position);
+
+            apr_size_t count = 0;
+            apr_status_t result = apr_file_read_full(this->file, buffer, (apr_size_t) length, &count);
+            if (result == APR_EOF) {
+                return count == 0 ? -1 : (int) count;
+            } else if (result != APR_SUCCESS) {
+                throw IOException(__FILE__, __LINE__, "Could not read from file %s: %s",
+                                  this->path.c_str(), errorString(result).c_str());
+            }
+
+            return (int) count;
+        }
+
+        void writeAt(const unsigned char* buffer, int length, long long position) {
+
+            this->seek(position);
+
+            apr_size_t count = 0;
+            apr_status_t result = apr_file_write_full(this->file, buffer, (apr_size_t) length, &count);
+            if (result != APR_SUCCESS) {
+                throw IOException(__FILE__, __LINE__, "Could not write to file %s: %s",
+                                  this->path.c_str(), errorString(result).c_str());
+            }
+        }
+    };
+
+    const int FileChannelImpl::TRANSFER_WINDOW = 8 * 1024 * 1024;
+
+}}}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    /**
+     * Receives the windows of a file region during a transfer.
+     */
+    class TransferSink {
+    public:
+
+        virtual ~TransferSink() {}
+
+        virtual void write(const unsigned char* buffer, int length) = 0;
+    };
+
+    class ChannelSink : public TransferSink {
+    private:
+
+        FileChannelImpl* target;
+        long long position;
+        bool advance;
+
+    private:
+
+        ChannelSink(const ChannelSink&);
+        ChannelSink& operator=(const ChannelSink&);
+
+    public:
+
+        ChannelSink(FileChannelImpl* target, long long position, bool advance) :
+            target(target), position(position), advance(advance) {
+        }
+
+        virtual void write(const unsigned char* buffer, int length) {
+            synchronized(&target->mutex) {
+                target->checkOpen();
+                long long at = this->advance ? target->position : this->position;
+                target->writeAt(buffer, length, at);
+                if (this->advance) {
+                    target->position += length;
+                } else {
+                    this->position += length;
+                }
+            }
+        }
+    };
+
+    class StreamSink : public TransferSink {
+    private:
+
+        OutputStream* target;
+
+    private:
+
+        StreamSink(const StreamSink&);
+        StreamSink& operator=(const StreamSink&);
+
+    public:
+
+        StreamSink(OutputStream* target) : target(target) {
+        }
+
+        virtual void write(const unsigned char* buffer, int length) {
+            target->write(buffer, length, 0, length);
+        }
+    };
+
+    /**
+     * Maps the region of the source channel's file window by window and hands each one to
+     * the sink, the bytes go from the page cache to their destination without an
+     * intermediate copy.  The windows are mapped through the channel's own handle.
+     */
+    long long transferRegion(FileChannelImpl* source, long long position, long long count, TransferSink& sink) {
+
+        long long transferred = 0;
+
+        while (transferred < count) {
+            long long window = Math::min(count - transferred, (long long) FileChannelImpl::TRANSFER_WINDOW);
+
+            std::auto_ptr<MappedFile> region;
+            synchronized(&source->mutex) {
+                source->checkOpen();
+                region.reset(new MappedFile(source->file, source->path, position + transferred, window, true));
+            }
+
+            sink.write(region->getAddress(), (int) window);
+            region->close();
+            transferred += window;
+        }
+
+        return transferred;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+FileChannel::FileChannel(const std::string& path, const std::string& mode) : impl(NULL) {
+
+    if (mode != "r" && mode != "rw") {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Invalid file channel mode: %s", mode.c_str());
+    }
+
+    bool readOnly = mode == "r";
+    this->impl = new FileChannelImpl(path, readOnly);
+
+    apr_int32_t flags = readOnly ? APR_FOPEN_READ | APR_FOPEN_BINARY :
+                                   APR_FOPEN_READ | APR_FOPEN_WRITE | APR_FOPEN_CREATE | APR_FOPEN_BINARY;
+
+    apr_status_t result = apr_file_open(&impl->file, path.c_str(), flags, APR_OS_DEFAULT, impl->pool.getAprPool());
+    if (result != APR_SUCCESS) {
+        delete this->impl;
+        throw IOException(__FILE__, __LINE__, "Could not open file %s: %s",
+                          path.c_str(), FileChannelImpl::errorString(result).c_str());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+FileChannel::~FileChannel() {
+    try {
+        this->close();
+    }
+    DECAF_CATCHALL_NOTHROW()
+
+    try {
+        delete this->impl;
+    }
+    DECAF_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const std::string& FileChannel::getPath() const {
+    return this->impl->path;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool FileChannel::isReadOnly() const {
+    return this->impl->readOnly;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool FileChannel::isOpen() const {
+    synchronized(&impl->mutex) {
+        return this->impl->file != NULL;
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileChannel::close() {
+
+    synchronized(&impl->mutex) {
+
+        if (this->impl->file == NULL) {
+            return;
+        }
+
+        apr_status_t result = apr_file_close(this->impl->file);
+        this->impl->file = NULL;
+
+        if (result != APR_SUCCESS) {
+            throw IOException(__FILE__, __LINE__, "Error while closing file %s: %s",
+                              this->impl->path.c_str(), FileChannelImpl::errorString(result).c_str());
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long FileChannel::position() const {
+
+    synchronized(&impl->mutex) {
+        this->impl->checkOpen();
+        return this->impl->position;
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+FileChannel& FileChannel::position(long long newPosition) {
+
+    if (newPosition < 0) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Position cannot be negative: %lld", newPosition);
+    }
+
+    synchronized(&impl->mutex) {
+        this->impl->checkOpen();
+        this->impl->position = newPosition;
+    }
+
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long FileChannel::size() const {
+
+    synchronized(&impl->mutex) {
+        this->impl->checkOpen();
+        return this->impl->size();
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+FileChannel& FileChannel::truncate(long long size) {
+
+    if (size < 0) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Size cannot be negative: %lld", size);
+    }
+
+    synchronized(&impl->mutex) {
+
+        this->impl->checkOpen();
+        this->impl->checkWritable();
+
+        if (size < this->impl->size()) {
+            apr_status_t result = apr_file_trunc(this->impl->file, (apr_off_t) size);
+            if (result != APR_SUCCESS) {
+                throw IOException(__FILE__, __LINE__, "Could not truncate file %s: %s",
+                                  this->impl->path.c_str(), FileChannelImpl::errorString(result).c_str());
+            }
+        }
+
+        if (this->impl->position > size) {
+            this->impl->position = size;
+        }
+    }
+
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileChannel::force(bool metaData DECAF_UNUSED) {
+
+    synchronized(&impl->mutex) {
+
+        this->impl->checkOpen();
+
+        apr_status_t result = apr_file_flush(this->impl->file);
+        if (result != APR_SUCCESS) {
+            throw IOException(__FILE__, __LINE__, "Could not flush file %s: %s",
+                              this->impl->path.c_str(), FileChannelImpl::errorString(result).c_str());
+        }
+
+        apr_os_file_t handle;
+        apr_os_file_get(&handle, this->impl->file);
+
+        bool failed = false;
+
+#if defined(_WIN32)
+        failed = ::FlushFileBuffers(handle) == 0;
+#elif HAVE_UNISTD_H
+        failed = ::fsync(handle) != 0;
+#endif
+
+        if (failed) {
+            throw IOException(__FILE__, __LINE__, "Could not sync file %s", this->impl->path.c_str());
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int FileChannel::read(ByteBuffer& dst) {
+
+    synchronized(&impl->mutex) {
+        this->impl->checkOpen();
+        int count = this->read(dst, this->impl->position);
+        if (count > 0) {
+            this->impl->position += count;
+        }
+        return count;
+    }
+
+    return -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int FileChannel::read(ByteBuffer& dst, long long position) {
+
+    if (position < 0) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Position cannot be negative: %lld", position);
+    }
+
+    if (dst.isReadOnly()) {
+        throw ReadOnlyBufferException(__FILE__, __LINE__, "FileChannel::read - Buffer is Read Only.");
+    }
+
+    int length = dst.remaining();
+
+    synchronized(&impl->mutex) {
+
+        this->impl->checkOpen();
+
+        if (length == 0) {
+            return position >= this->impl->size() ? -1 : 0;
+        }
+
+        int count = -1;
+        if (dst.hasArray()) {
+            count = this->impl->readAt(dst.array() + dst.arrayOffset() + dst.position(), length, position);
+            if (count > 0) {
+                dst.position(dst.position() + count);
+            }
+        } else {
+            std::vector<unsigned char> buffer(length);
+            count = this->impl->readAt(&buffer[0], length, position);
+            if (count > 0) {
+                dst.put(&buffer[0], length, 0, count);
+            }
+        }
+
+        return count;
+    }
+
+    return -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int FileChannel::write(ByteBuffer& src) {
+
+    synchronized(&impl->mutex) {
+        this->impl->checkOpen();
+        int count = this->write(src, this->impl->position);
+        this->impl->position += count;
+        return count;
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int FileChannel::write(ByteBuffer& src, long long position) {
+
+    if (position < 0) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Position cannot be negative: %lld", position);
+    }
+
+    int length = src.remaining();
+
+    synchronized(&impl->mutex) {
+
+        this->impl->checkOpen();
+        this->impl->checkWritable();
+
+        if (length == 0) {
+            return 0;
+        }
+
+        if (src.hasArray() && !src.isReadOnly()) {
+            this->impl->writeAt(src.array() + src.arrayOffset() + src.position(), length, position);
+            src.position(src.position() + length);
+        } else {
+            std::vector<unsigned char> buffer(length);
+            src.get(&buffer[0], length, 0, length);
+            this->impl->writeAt(&buffer[0], length, position);
+        }
+    }
+
+    return length;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MappedByteBuffer* FileChannel::map(MapMode mode, long long position, long long size) {
+
+    if (position < 0) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Position cannot be negative: %lld", position);
+    }
+
+    if (size <= 0 || size > Integer::MAX_VALUE) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Mapped size is out of range: %lld", size);
+    }
+
+    try {
+
+        bool readOnly = mode == READ_ONLY;
+        Pointer<MappedFile> file;
+
+        // Mapped through the channel's own handle, growing the file for a writable
+        // region must not race with the channel's reads, writes and truncation.
+        synchronized(&impl->mutex) {
+            this->impl->checkOpen();
+            if (!readOnly) {
+                this->impl->checkWritable();
+            }
+
+            file.reset(new MappedFile(this->impl->file, this->impl->path, position, size, readOnly));
+        }
+
+        Pointer<MappedByteArrayAdapter> mapping(new MappedByteArrayAdapter(file));
+
+        return new MappedByteBuffer(mapping, 0, (int) size, readOnly);
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_RETHROW(IllegalArgumentException)
+    DECAF_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    DECAF_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long FileChannel::transferTo(long long position, long long count, FileChannel& target) {
+
+    if (position < 0 || count < 0) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Position and count cannot be negative");
+    }
+
+    if (&target == this) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Cannot transfer a channel to itself");
+    }
+
+    long long available = this->size() - position;
+    if (available <= 0 || count == 0) {
+        return 0;
+    }
+
+    synchronized(&target.impl->mutex) {
+        target.impl->checkOpen();
+        target.impl->checkWritable();
+    }
+
+    try {
+        ChannelSink sink(target.impl, 0, true);
+        return transferRegion(this->impl, position, Math::min(count, available), sink);
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    DECAF_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long FileChannel::transferTo(long long position, long long count, OutputStream& target) {
+
+    if (position < 0 || count < 0) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Position and count cannot be negative");
+    }
+
+    long long available = this->size() - position;
+    if (available <= 0 || count == 0) {
+        return 0;
+    }
+
+    try {
+        StreamSink sink(&target);
+        return transferRegion(this->impl, position, Math::min(count, available), sink);
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    DECAF_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long FileChannel::transferFrom(FileChannel& src, long long position, long long count) {
+
+    if (position < 0 || count < 0) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Position and count cannot be negative");
+    }
+
+    if (&src == this) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Cannot transfer a channel to itself");
+    }
+
+    synchronized(&impl->mutex) {
+        this->impl->checkOpen();
+        this->impl->checkWritable();
+    }
+
+    long long start = src.position();
+    long long available = src.size() - start;
+    if (available <= 0 || count == 0) {
+        return 0;
+    }
+
+    try {
+        ChannelSink sink(this->impl, position, false);
+        long long transferred = transferRegion(src.impl, start, Math::min(count, available), sink);
+        src.position(start + transferred);
+        return transferred;
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    DECAF_CATCHALL_THROW(IOException)
+}
@@ -0,0 +1,330 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_NIO_CHANNELS_FILECHANNEL_H_
+#define _DECAF_NIO_CHANNELS_FILECHANNEL_H_
+
+#include <decaf/util/Config.h>
+#include <decaf/io/Closeable.h>
+#include <decaf/io/IOException.h>
+#include <decaf/io/OutputStream.h>
+#include <decaf/nio/ByteBuffer.h>
+#include <decaf/nio/MappedByteBuffer.h>
+
+#include <string>
+
+namespace decaf {
+namespace nio {
+namespace channels {
+
+    class FileChannelImpl;
+
+    /**
+     * A channel for reading, writing, mapping, and manipulating a file.
+     *
+     * A file channel has a current position within its file which can be both queried
+     * and modified.  The file itself contains a variable-length sequence of bytes that
+     * can be read and written and whose current size can be queried.  The size of the
+     * file increases when bytes are written beyond its current size and decreases when
+     * it is truncated.
+     *
+     * In addition to the usual read, write, and close operations a file channel
+     * supports the following file-specific operations:
+     *
+     *   Bytes may be read or written at an absolute position in a file in a way that
+     *   does not affect the channel's current position.
+     *
+     *   A region of a file may be mapped directly into memory, for large files this is
+     *   often much more efficient than invoking the usual read or write methods.
+     *
+     *   Updates made to a file may be forced out to the underlying storage device.
+     *
+     *   Bytes can be transferred from a file to another file or to an output stream
+     *   straight from the mapped file, without an intermediate buffer.
+     *
+     * File channels are safe for use by multiple concurrent threads.
+     *
+     * @since 3.10
+     */
+    class DECAF_API FileChannel : public decaf::io::Closeable {
+    public:
+
+        /**
+         * The modes in which a region of the file can be mapped.
+         */
+        enum MapMode {
+            READ_ONLY,
+            READ_WRITE
+        };
+
+    private:
+
+        FileChannelImpl* impl;
+
+    private:
+
+        FileChannel(const FileChannel&);
+        FileChannel& operator=(const FileChannel&);
+
+    public:
+
+        /**
+         * Opens a channel on the file at the given path.  The mode is either "r" to open
+         * an existing file for reading only, or "rw" to open the file for reading and
+         * writing, creating it if it doesn't exist.
+         *
+         * @param path
+         *      The path of the file to open.
+         * @param mode
+         *      The access mode, "r" or "rw".
+         *
+         * @throws IllegalArgumentException if the mode is not "r" or "rw".
+         * @throws IOException if the file can't be opened.
+         */
+        FileChannel(const std::string& path, const std::string& mode);
+
+        virtual ~FileChannel();
+
+        /**
+         * @return the path of the file this channel was opened on.
+         */
+        const std::string& getPath() const;
+
+        /**
+         * @return true if the channel was opened for reading only.
+         */
+        bool isReadOnly() const;
+
+        /**
+         * @return true until the channel has been closed.
+         */
+        bool isOpen() const;
+
+        /**
+         * Closes the channel, buffers mapped from it stay valid.  Calling close on a
+         * closed channel has no effect.
+         *
+         * @throws IOException if an error occurs while closing the file.
+         */
+        virtual void close();
+
+        /**
+         * @return the channel's position in the file.
+         *
+         * @throws IOException if the channel is closed.
+         */
+        long long position() const;
+
+        /**
+         * Sets the channel's position.  Setting the position beyond the end of the file
+         * doesn't change the file size, a later write will extend it and the bytes in
+         * between are unspecified.
+         *
+         * @param newPosition
+         *      The new position, a non-negative offset from the start of the file.
+         *
+         * @return a reference to this channel.
+         *
+         * @throws IllegalArgumentException if the position is negative.
+         * @throws IOException if the channel is closed.
+         */
+        FileChannel& position(long long newPosition);
+
+        /**
+         * @return the current size of the channel's file.
+         *
+         * @throws IOException if the channel is closed or the size can't be read.
+         */
+        long long size() const;
+
+        /**
+         * Truncates the channel's file to the given size.  Nothing happens if the file
+         * is already smaller, the position is moved back if it lies beyond the new size.
+         *
+         * @param size
+         *      The new size, a non-negative byte count.
+         *
+         * @return a reference to this channel.
+         *
+         * @throws IllegalArgumentException if the size is negative.
+         * @throws IOException if the channel is read-only, closed or the truncate fails.
+         */
+        FileChannel& truncate(long long size);
+
+        /**
+         * Forces any updates to this channel's file to be written to the storage device
+         * that contains it.  Updates made through a mapped buffer are forced with the
+         * MappedByteBuffer force method instead.
+         *
+         * @param metaData
+         *      If true the file's meta data is written as well, the flag is a hint and
+         *      some platforms always write it.
+         *
+         * @throws IOException if the channel is closed or the flush fails.
+         */
+        void force(bool metaData);
+
+        /**
+         * Reads bytes from the channel's position into the remaining space of the given
+         * buffer, the channel position and the buffer position advance by the number of
+         * bytes read.
+         *
+         * @param dst
+         *      The buffer into which bytes are to be transferred.
+         *
+         * @return the number of bytes read, possibly zero, or -1 at the end of the file.
+         *
+         * @throws ReadOnlyBufferException if dst is read-only.
+         * @throws IOException if the channel is closed or the read fails.
+         */
+        int read(decaf::nio::ByteBuffer& dst);
+
+        /**
+         * Reads bytes starting at the given file position into the remaining space of the
+         * given buffer, the channel's position is not changed.
+         *
+         * @param dst
+         *      The buffer into which bytes are to be transferred.
+         * @param position
+         *      The file position at which the transfer is to begin.
+         *
+         * @return the number of bytes read, possibly zero, or -1 if the position lies at
+         *         or beyond the end of the file.
+         *
+         * @throws IllegalArgumentException if the position is negative.
+         * @throws ReadOnlyBufferException if dst is read-only.
+         * @throws IOException if the channel is closed or the read fails.
+         */
+        int read(decaf::nio::ByteBuffer& dst, long long position);
+
+        /**
+         * Writes the remaining bytes of the given buffer at the channel's position, the
+         * channel position and the buffer position advance by the number of bytes written.
+         *
+         * @param src
+         *      The buffer from which bytes are to be retrieved.
+         *
+         * @return the number of bytes written.
+         *
+         * @throws IOException if the channel is read-only, closed or the write fails.
+         */
+        int write(decaf::nio::ByteBuffer& src);
+
+        /**
+         * Writes the remaining bytes of the given buffer starting at the given file
+         * position, the channel's position is not changed.
+         *
+         * @param src
+         *      The buffer from which bytes are to be retrieved.
+         * @param position
+         *      The file position at which the transfer is to begin.
+         *
+         * @return the number of bytes written.
+         *
+         * @throws IllegalArgumentException if the position is negative.
+         * @throws IOException if the channel is read-only, closed or the write fails.
+         */
+        int write(decaf::nio::ByteBuffer& src, long long position);
+
+        /**
+         * Maps a region of this channel's file directly into memory.  A READ_WRITE mapping
+         * that extends beyond the end of the file grows the file first.  The returned
+         * buffer has a position of zero and a limit and capacity of size, it stays valid
+         * after this channel has been closed.
+         *
+         * @param mode
+         *      READ_ONLY or READ_WRITE.
+         * @param position
+         *      The position within the file at which the mapped region starts.
+         * @param size
+         *      The size of the region to be mapped, positive and at most Integer::MAX_VALUE.
+         *
+         * @return a new MappedByteBuffer which the caller owns.
+         *
+         * @throws IllegalArgumentException if the position or size is out of range.
+         * @throws IOException if the mode is READ_WRITE and the channel is read-only,
+         *         if a READ_ONLY region lies beyond the end of the file, or the mapping fails.
+         */
+        decaf::nio::MappedByteBuffer* map(MapMode mode, long long position, long long size);
+
+        /**
+         * Transfers bytes from this channel's file to the given channel.  Up to count bytes
+         * starting at the given position of this file are written at the target's current
+         * position, fewer are transferred if this file ends first.  This channel's position
+         * is not changed, the target's position advances by the number of bytes written.
+         *
+         * @param position
+         *      The position within this file at which the transfer is to begin.
+         * @param count
+         *      The maximum number of bytes to be transferred.
+         * @param target
+         *      The channel that receives the bytes.
+         *
+         * @return the number of bytes actually transferred.
+         *
+         * @throws IllegalArgumentException if position or count is negative or target
+         *         is this channel.
+         * @throws IOException if either channel is closed, the target is read-only, or
+         *         an I/O error occurs.
+         */
+        long long transferTo(long long position, long long count, FileChannel& target);
+
+        /**
+         * Writes up to count bytes starting at the given position of this channel's file
+         * to the given output stream.  This channel's position is not changed.
+         *
+         * @param position
+         *      The position within this file at which the transfer is to begin.
+         * @param count
+         *      The maximum number of bytes to be transferred.
+         * @param target
+         *      The stream that receives the bytes.
+         *
+         * @return the number of bytes actually transferred.
+         *
+         * @throws IllegalArgumentException if position or count is negative.
+         * @throws IOException if the channel is closed or an I/O error occurs.
+         */
+        long long transferTo(long long position, long long count, decaf::io::OutputStream& target);
+
+        /**
+         * Transfers bytes into this channel's file from the given channel.  Up to count
+         * bytes are read from the source's current position and written starting at the
+         * given position of this file.  This channel's position is not changed, the
+         * source's position advances by the number of bytes read.
+         *
+         * @param src
+         *      The channel that provides the bytes.
+         * @param position
+         *      The position within this file at which the transfer is to begin.
+         * @param count
+         *      The maximum number of bytes to be transferred.
+         *
+         * @return the number of bytes actually transferred.
+         *
+         * @throws IllegalArgumentException if position or count is negative or src
+         *         is this channel.
+         * @throws IOException if either channel is closed, this channel is read-only,
+         *         or an I/O error occurs.
+         */
+        long long transferFrom(FileChannel& src, long long position, long long count);
+
+    };
+
+}}}
+
+#endif /* _DECAF_NIO_CHANNELS_FILECHANNEL_H_ */
@@ -0,0 +1,504 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AsyncHandler.h"
+
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/util/logging/Level.h>
+#include <decaf/util/logging/ErrorManager.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/Concurrent.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+#include <decaf/util/concurrent/atomic/AtomicBoolean.h>
+
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::atomic;
+using namespace decaf::util::logging;
+
+////////////////////////////////////////////////////////////////////////////////
+const int AsyncHandler::DEFAULT_CAPACITY = 1024;
+const int AsyncHandler::DEFAULT_SAMPLE_RATE = 10;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // Publishers blocked on a full ring recheck at least this often, in milliseconds.
+    const long long WAIT_INTERVAL = 100;
+
+    const int MAX_CAPACITY = 1 << 30;
+
+    // Ring positions are free running and are allowed to wrap, the arithmetic is
+    // done unsigned so that the wrap is well defined.
+    inline int advance(int position, int delta) {
+        return (int) ((unsigned int) position + (unsigned int) delta);
+    }
+
+    inline int distance(int from, int to) {
+        return (int) ((unsigned int) to - (unsigned int) from);
+    }
+
+    // A slot is free for position p when its sequence is p, and holds the record for
+    // position p once its sequence is p + 1.
+    struct Slot {
+
+        AtomicInteger sequence;
+        LogRecord record;
+
+        Slot() : sequence(), record() {}
+
+    private:
+
+        Slot(const Slot&);
+        Slot& operator= (const Slot&);
+    };
+
+    void copyRecord(const LogRecord& source, LogRecord& target) {
+        target.setLevel(source.getLevel());
+        target.setLoggerName(source.getLoggerName());
+        target.setSourceFile(source.getSourceFile());
+        target.setSourceLine(source.getSourceLine());
+        target.setSourceFunction(source.getSourceFunction());
+        target.setMessage(source.getMessage());
+        target.setTimestamp(source.getTimestamp());
+        target.setTreadId(source.getTreadId());
+        target.setThrown(source.getThrown() != NULL ? source.getThrown()->clone() : NULL);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace decaf {
+namespace util {
+namespace logging {
+
+    class AsyncHandlerImpl : public Runnable {
+    private:
+
+        AsyncHandlerImpl(const AsyncHandlerImpl&);
+        AsyncHandlerImpl& operator= (const AsyncHandlerImpl&);
+
+    public:
+
+        AsyncHandler* parent;
+        Handler* target;
+        AsyncHandler::OverflowPolicy policy;
+
+        Slot* slots;
+        int capacity;
+        int mask;
+
+        // Next position to be claimed by a publisher.
+        AtomicInteger enqueuePosition;
+
+        // Next position to be taken by the writer thread, only ever moved by it.
+        AtomicInteger dequeuePosition;
+
+        // Position up to which records have been written and the target flushed.
+        AtomicInteger flushedPosition;
+
+        AtomicInteger sampleRate;
+        AtomicInteger sampleCounter;
+
+        AtomicInteger published;
+        AtomicInteger dropped;
+        AtomicInteger blocked;
+        volatile long long written;
+
+        // Threads waiting on the monitor for room in the ring or for a flush.
+        AtomicInteger waiters;
+
+        // Set while the writer thread is, or is about to start, waiting on the monitor.
+        AtomicBoolean idle;
+        AtomicBoolean closed;
+
+        Mutex monitor;
+        Thread* thread;
+
+    public:
+
+        AsyncHandlerImpl(AsyncHandler* parent, Handler* target, int capacity, AsyncHandler::OverflowPolicy policy) :
+            parent(parent), target(target), policy(policy), slots(NULL), capacity(1), mask(0),
+            enqueuePosition(), dequeuePosition(), flushedPosition(), sampleRate(AsyncHandler::DEFAULT_SAMPLE_RATE),
+            sampleCounter(), published(), dropped(), blocked(), written(0), waiters(), idle(false), closed(false),
+            monitor(), thread(NULL) {
+
+            while (this->capacity < capacity && this->capacity < MAX_CAPACITY) {
+                this->capacity <<= 1;
+            }
+
+            this->mask = this->capacity - 1;
+            this->slots = new Slot[this->capacity];
+            for (int i = 0; i < this->capacity; ++i) {
+                this->slots[i].sequence.set(i);
+            }
+        }
+
+        virtual ~AsyncHandlerImpl() {
+            delete this->thread;
+            delete [] this->slots;
+            delete this->target;
+        }
+
+        bool isWriterThread() const {
+            return Thread::currentThread() == this->thread;
+        }
+
+        int pending() const {
+            return distance(this->dequeuePosition.get(), this->enqueuePosition.get());
+        }
+
+        // True when the record at the head of the ring is ready to be written.
+        bool isReady() {
+            int position = this->dequeuePosition.get();
+            Slot& slot = this->slots[(unsigned int) position & this->mask];
+            return slot.sequence.get() == advance(position, 1);
+        }
+
+        bool offer(const LogRecord& record) {
+
+            Slot* slot = NULL;
+            int position = this->enqueuePosition.get();
+
+            for (;;) {
+                slot = &this->slots[(unsigned int) position & this->mask];
+                int delta = distance(position, slot->sequence.get());
+
+                if (delta == 0) {
+                    if (this->enqueuePosition.compareAndSet(position, advance(position, 1))) {
+                        break;
+                    }
+                } else if (delta < 0) {
+                    return false;
+                }
+
+                position = this->enqueuePosition.get();
+            }
+
+            copyRecord(record, slot->record);
+
+            // The atomic swap orders the copy above before the slot is marked as ready.
+            slot->sequence.getAndSet(advance(position, 1));
+            this->published.incrementAndGet();
+
+            if (this->idle.compareAndSet(true, false)) {
+                synchronized(&this->monitor) {
+                    this->monitor.notifyAll();
+                }
+            }
+
+            return true;
+        }
+
+        bool offerOrWait(const LogRecord& record) {
+
+            if (offer(record)) {
+                return true;
+            }
+
+            // Waiting for the writer thread from the writer thread would never end.
+            if (isWriterThread()) {
+                return false;
+            }
+
+            this->blocked.incrementAndGet();
+            this->waiters.incrementAndGet();
+
+            bool accepted = false;
+            while (!accepted && !this->closed.get()) {
+                synchronized(&this->monitor) {
+                    accepted = offer(record);
+                    if (!accepted) {
+                        this->monitor.wait(WAIT_INTERVAL);
+                    }
+                }
+            }
+
+            this->waiters.decrementAndGet();
+            return accepted;
+        }
+
+        bool sampledOut(const LogRecord& record) {
+
+            if (record.getLevel().intValue() >= Level::SEVERE.intValue() || pending() < this->capacity / 2) {
+                return false;
+            }
+
+            unsigned int count = (unsigned int) this->sampleCounter.getAndIncrement();
+            return count % (unsigned int) this->sampleRate.get() != 0;
+        }
+
+        void publish(const LogRecord& record) {
+
+            bool accepted = false;
+
+            if (!this->closed.get()) {
+                switch (this->policy) {
+                    case AsyncHandler::BLOCK:
+                        accepted = offerOrWait(record);
+                        break;
+                    case AsyncHandler::SAMPLE:
+                        accepted = !sampledOut(record) && offer(record);
+                        break;
+                    default:
+                        accepted = offer(record);
+                        break;
+                }
+            }
+
+            if (!accepted) {
+                this->dropped.incrementAndGet();
+            }
+        }
+
+        // Hands the record at the head of the ring to the target, returns false when
+        // there is nothing ready to be written.
+        bool writeNext() {
+
+            int position = this->dequeuePosition.get();
+            Slot& slot = this->slots[(unsigned int) position & this->mask];
+
+            // The zero add is a full barrier, the publisher's copy of the record is visible
+            // once its sequence update is.
+            if (slot.sequence.addAndGet(0) != advance(position, 1)) {
+                return false;
+            }
+
+            try {
+                this->target->publish(slot.record);
+            } catch (Exception& ex) {
+                this->parent->getErrorManager()->error(
+                    "Failed to publish the LogRecord", &ex, ErrorManager::WRITE_FAILURE);
+            }
+
+            slot.record.setThrown(NULL);
+            slot.sequence.getAndSet(advance(position, this->capacity));
+            this->dequeuePosition.getAndSet(advance(position, 1));
+            this->written++;
+
+            signalWaiters();
+            return true;
+        }
+
+        void flushTarget() {
+
+            try {
+                this->target->flush();
+            } catch (Exception& ex) {
+                this->parent->getErrorManager()->error(
+                    "Failed to flush the target Handler", &ex, ErrorManager::FLUSH_FAILURE);
+            }
+
+            this->flushedPosition.getAndSet(this->dequeuePosition.get());
+            signalWaiters();
+        }
+
+        void signalWaiters() {
+            if (this->waiters.get() > 0) {
+                synchronized(&this->monitor) {
+                    this->monitor.notifyAll();
+                }
+            }
+        }
+
+        void flush() {
+
+            if (isWriterThread()) {
+                return;
+            }
+
+            int position = this->enqueuePosition.get();
+
+            this->waiters.incrementAndGet();
+            synchronized(&this->monitor) {
+                while (distance(this->flushedPosition.get(), position) > 0 && !this->closed.get()) {
+                    this->monitor.wait(WAIT_INTERVAL);
+                }
+            }
+            this->waiters.decrementAndGet();
+        }
+
+        virtual void run() {
+
+            bool done = false;
+            while (!done) {
+
+                bool wrote = false;
+                while (writeNext()) {
+                    wrote = true;
+                }
+
+                if (wrote) {
+                    flushTarget();
+                }
+
+                synchronized(&this->monitor) {
+                    this->idle.set(true);
+                    if (!isReady()) {
+                        if (this->closed.get()) {
+                            done = true;
+                        } else {
+                            this->monitor.wait();
+                        }
+                    }
+                    this->idle.set(false);
+                }
+            }
+        }
+
+        void close() {
+
+            if (!this->closed.compareAndSet(false, true)) {
+                return;
+            }
+
+            synchronized(&this->monitor) {
+                this->monitor.notifyAll();
+            }
+
+            if (!isWriterThread()) {
+                this->thread->join();
+            }
+
+            // Anything published while the writer thread was on its way out.
+            while (writeNext()) {
+            }
+            flushTarget();
+
+            try {
+                this->target->close();
+            } catch (Exception& ex) {
+                this->parent->getErrorManager()->error(
+                    "Failed to close the target Handler", &ex, ErrorManager::CLOSE_FAILURE);
+            }
+        }
+    };
+
+}}}
+
+////////////////////////////////////////////////////////////////////////////////
+AsyncHandler::AsyncHandler( Handler* target, int capacity, OverflowPolicy policy ) : Handler(), impl(NULL) {
+
+    if( target == NULL ) {
+        throw NullPointerException(
+            __FILE__, __LINE__, "The target Handler cannot be NULL." );
+    }
+
+    if( capacity <= 0 ) {
+        throw IllegalArgumentException(
+            __FILE__, __LINE__, "Capacity must be positive: %d", capacity );
+    }
+
+    this->impl = new AsyncHandlerImpl( this, target, capacity, policy );
+
+    try {
+        this->impl->thread = new Thread( this->impl, "AsyncHandler" );
+        this->impl->thread->start();
+    } catch( Exception& ) {
+        delete this->impl;
+        throw;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+AsyncHandler::~AsyncHandler() {
+
+    try {
+        this->close();
+    }
+    DECAF_CATCH_NOTHROW( lang::Exception )
+    DECAF_CATCHALL_NOTHROW()
+
+    delete this->impl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandler::close() {
+    this->impl->close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandler::flush() {
+    this->impl->flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandler::publish( const LogRecord& record ) {
+
+    if( this->isLoggable( record ) ) {
+        this->impl->publish( record );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Handler* AsyncHandler::getTarget() const {
+    return this->impl->target;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int AsyncHandler::getCapacity() const {
+    return this->impl->capacity;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+AsyncHandler::OverflowPolicy AsyncHandler::getOverflowPolicy() const {
+    return this->impl->policy;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandler::setSampleRate( int rate ) {
+
+    if( rate <= 0 ) {
+        throw IllegalArgumentException(
+            __FILE__, __LINE__, "Sample rate must be positive: %d", rate );
+    }
+
+    this->impl->sampleRate.set( rate );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int AsyncHandler::getSampleRate() const {
+    return this->impl->sampleRate.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long AsyncHandler::getPublishedCount() const {
+    return (unsigned int) this->impl->published.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long AsyncHandler::getWrittenCount() const {
+    return this->impl->written;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long AsyncHandler::getDroppedCount() const {
+    return (unsigned int) this->impl->dropped.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long AsyncHandler::getBlockedCount() const {
+    return (unsigned int) this->impl->blocked.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int AsyncHandler::getPendingCount() const {
+    return this->impl->pending();
+}
@@ -0,0 +1,189 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _DECAF_UTIL_LOGGING_ASYNCHANDLER_H_
+#define _DECAF_UTIL_LOGGING_ASYNCHANDLER_H_
+
+#include <decaf/util/Config.h>
+#include <decaf/util/logging/Handler.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+
+namespace decaf{
+namespace util{
+namespace logging{
+
+    class AsyncHandlerImpl;
+
+    /**
+     * A Handler that moves formatting and output off the logging thread.
+     *
+     * Published records are copied into a fixed ring of preallocated LogRecord slots, a
+     * single background thread takes them out in order and passes them on to the target
+     * Handler, flushing the target each time the ring runs empty.  Publishing threads never
+     * take a lock or touch the target's output while there is room in the ring, so enabling
+     * verbose logging does not make transport or producer threads wait on console or file
+     * I/O.
+     *
+     * When the ring is full the OverflowPolicy decides what happens to a new record:
+     *
+     *   * DROP discards it.
+     *   * BLOCK makes the publishing thread wait until the writer thread frees a slot.
+     *   * SAMPLE passes only one in every getSampleRate() records once the ring is half full,
+     *     SEVERE records are always offered, and anything that still does not fit is dropped.
+     *
+     * The number of records accepted, written, dropped and the number of times a publisher
+     * had to wait are kept so that lost output is visible rather than silent.
+     *
+     * The AsyncHandler takes ownership of the target Handler and closes and deletes it when
+     * it is itself closed or destroyed.  The target is only ever called from the writer
+     * thread, once the handler has been created the target should not be used directly.
+     *
+     * @since 3.10
+     */
+    class DECAF_API AsyncHandler : public Handler {
+    public:
+
+        /**
+         * What to do with a record that is published while the ring is full.
+         */
+        enum OverflowPolicy {
+            DROP,
+            BLOCK,
+            SAMPLE
+        };
+
+        /**
+         * The default number of records that can be waiting for the writer thread.
+         */
+        static const int DEFAULT_CAPACITY;
+
+        /**
+         * The default one in N rate at which records are kept by the SAMPLE policy.
+         */
+        static const int DEFAULT_SAMPLE_RATE;
+
+    private:
+
+        AsyncHandlerImpl* impl;
+
+    private:
+
+        AsyncHandler( const AsyncHandler& );
+        AsyncHandler& operator= ( const AsyncHandler& );
+
+    public:
+
+        /**
+         * Creates a new AsyncHandler that writes to the given target, and starts its writer
+         * thread.
+         *
+         * @param target
+         *      The Handler that records are handed to, the AsyncHandler takes ownership.
+         * @param capacity
+         *      The number of records the ring can hold, rounded up to a power of two.
+         * @param policy
+         *      What to do with records published while the ring is full.
+         *
+         * @throws NullPointerException if the target is NULL.
+         * @throws IllegalArgumentException if the capacity is not positive.
+         */
+        AsyncHandler( Handler* target, int capacity = DEFAULT_CAPACITY, OverflowPolicy policy = DROP );
+
+        virtual ~AsyncHandler();
+
+        /**
+         * Writes out every record that is still in the ring, stops the writer thread and
+         * closes the target Handler.  Records published after close are dropped.
+         */
+        virtual void close();
+
+        /**
+         * Blocks until every record published before the call has been handed to the target
+         * Handler and the target has been flushed.
+         */
+        virtual void flush();
+
+        /**
+         * Copies the record into the ring for the writer thread, applying the overflow
+         * policy when the ring is full.
+         *
+         * @param record
+         *      The <code>LogRecord</code> to Publish
+         */
+        virtual void publish( const LogRecord& record );
+
+        /**
+         * @return the Handler that records are written to.
+         */
+        Handler* getTarget() const;
+
+        /**
+         * @return the number of records the ring can hold.
+         */
+        int getCapacity() const;
+
+        /**
+         * @return the policy applied to records published while the ring is full.
+         */
+        OverflowPolicy getOverflowPolicy() const;
+
+        /**
+         * Sets the one in N rate at which the SAMPLE policy keeps records while the ring
+         * is more than half full.
+         *
+         * @param rate
+         *      The sample rate, one keeps every record.
+         *
+         * @throws IllegalArgumentException if the rate is not positive.
+         */
+        void setSampleRate( int rate );
+
+        /**
+         * @return the one in N rate at which the SAMPLE policy keeps records.
+         */
+        int getSampleRate() const;
+
+        /**
+         * @return the number of records that were accepted into the ring.
+         */
+        long long getPublishedCount() const;
+
+        /**
+         * @return the number of records that have been handed to the target Handler.
+         */
+        long long getWrittenCount() const;
+
+        /**
+         * @return the number of records that were dropped or sampled out.
+         */
+        long long getDroppedCount() const;
+
+        /**
+         * @return the number of times a publishing thread had to wait for room in the ring.
+         */
+        long long getBlockedCount() const;
+
+        /**
+         * @return the number of records currently waiting for the writer thread.
+         */
+        int getPendingCount() const;
+
+    };
+
+}}}
+
+#endif /*_DECAF_UTIL_LOGGING_ASYNCHANDLER_H_*/
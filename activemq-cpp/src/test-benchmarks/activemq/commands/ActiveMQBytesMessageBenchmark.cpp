@@ -0,0 +1,73 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ActiveMQBytesMessageBenchmark.h"
+
+#include <decaf/lang/Pointer.h>
+
+using namespace activemq;
+using namespace activemq::commands;
+using namespace decaf;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int MIN_BODY_SIZE = 64 * 1024;
+    const int MAX_BODY_SIZE = 16 * 1024 * 1024;
+
+    // Bodies are written the way applications usually do, a chunk at a time.
+    const int CHUNK_SIZE = 8 * 1024;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ActiveMQBytesMessageBenchmark::ActiveMQBytesMessageBenchmark() : buffer() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ActiveMQBytesMessageBenchmark::~ActiveMQBytesMessageBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQBytesMessageBenchmark::setUp() {
+    buffer.resize(CHUNK_SIZE, 'a');
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQBytesMessageBenchmark::tearDown() {
+    buffer.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQBytesMessageBenchmark::run() {
+
+    for (int size = MIN_BODY_SIZE; size <= MAX_BODY_SIZE; size *= 4) {
+
+        Pointer<ActiveMQBytesMessage> message(new ActiveMQBytesMessage());
+
+        for (int written = 0; written < size; written += CHUNK_SIZE) {
+            message->writeBytes(&buffer[0], 0, CHUNK_SIZE);
+        }
+
+        // Stores the body the same way sending the message does.
+        message->onSend();
+
+        Pointer<ActiveMQBytesMessage> copy(message->cloneDataStructure());
+        copy->reset();
+        copy->getBodyLength();
+    }
+}
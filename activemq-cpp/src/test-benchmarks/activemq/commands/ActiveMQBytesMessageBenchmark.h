@@ -0,0 +1,54 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_COMMANDS_ACTIVEMQBYTESMESSAGEBENCHMARK_H_
+#define _ACTIVEMQ_COMMANDS_ACTIVEMQBYTESMESSAGEBENCHMARK_H_
+
+#include <benchmark/BenchmarkBase.h>
+
+#include <activemq/commands/ActiveMQBytesMessage.h>
+
+#include <vector>
+
+namespace activemq {
+namespace commands {
+
+    /**
+     * Writes and stores BytesMessage bodies from 64 KB up to 16 MB.
+     */
+    class ActiveMQBytesMessageBenchmark :
+        public benchmark::BenchmarkBase<
+            activemq::commands::ActiveMQBytesMessageBenchmark, ActiveMQBytesMessage, 10 >
+    {
+    private:
+
+        std::vector<unsigned char> buffer;
+
+    public:
+
+        ActiveMQBytesMessageBenchmark();
+        virtual ~ActiveMQBytesMessageBenchmark();
+
+        void setUp();
+        void tearDown();
+        void run();
+
+    };
+
+}}
+
+#endif /*_ACTIVEMQ_COMMANDS_ACTIVEMQBYTESMESSAGEBENCHMARK_H_*/
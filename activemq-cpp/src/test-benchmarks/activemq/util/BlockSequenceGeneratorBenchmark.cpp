@@ -0,0 +1,80 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "BlockSequenceGeneratorBenchmark.h"
+
+#include <decaf/lang/Thread.h>
+
+using namespace activemq;
+using namespace activemq::util;
+using namespace decaf;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class BlockSequenceRunnable : public Runnable {
+    private:
+
+        BlockSequenceGenerator* generator;
+
+    private:
+
+        BlockSequenceRunnable(const BlockSequenceRunnable&);
+        BlockSequenceRunnable& operator=(const BlockSequenceRunnable&);
+
+    public:
+
+        BlockSequenceRunnable(BlockSequenceGenerator* generator) : Runnable(), generator(generator) {}
+
+        virtual void run() {
+            for (int i = 0; i < 100000; ++i) {
+                generator->getNextSequenceId();
+            }
+        }
+
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+BlockSequenceGeneratorBenchmark::BlockSequenceGeneratorBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+BlockSequenceGeneratorBenchmark::~BlockSequenceGeneratorBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void BlockSequenceGeneratorBenchmark::run() {
+
+    static const int NUM_THREADS = 8;
+
+    BlockSequenceGenerator generator;
+    BlockSequenceRunnable runnable(&generator);
+
+    Thread* threads[NUM_THREADS];
+
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        threads[i] = new Thread(&runnable);
+        threads[i]->start();
+    }
+
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        threads[i]->join();
+        delete threads[i];
+    }
+}
@@ -0,0 +1,47 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_UTIL_LONGSEQUENCEGENERATORBENCHMARK_H_
+#define _ACTIVEMQ_UTIL_LONGSEQUENCEGENERATORBENCHMARK_H_
+
+#include <benchmark/BenchmarkBase.h>
+
+#include <activemq/util/LongSequenceGenerator.h>
+
+namespace activemq {
+namespace util {
+
+    /**
+     * Draws ids from a single generator in several threads at once, to compare
+     * against the BlockSequenceGeneratorBenchmark.
+     */
+    class LongSequenceGeneratorBenchmark :
+        public benchmark::BenchmarkBase<
+            activemq::util::LongSequenceGeneratorBenchmark, LongSequenceGenerator, 20 >
+    {
+    public:
+
+        LongSequenceGeneratorBenchmark();
+        virtual ~LongSequenceGeneratorBenchmark();
+
+        void run();
+
+    };
+
+}}
+
+#endif /*_ACTIVEMQ_UTIL_LONGSEQUENCEGENERATORBENCHMARK_H_*/
@@ -0,0 +1,102 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StompFrameBenchmark.h"
+
+#include <activemq/wireformat/stomp/StompCommandConstants.h>
+
+#include <decaf/io/BufferedInputStream.h>
+#include <decaf/io/ByteArrayInputStream.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataInputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/lang/Integer.h>
+
+using namespace activemq;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::stomp;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int FRAME_COUNT = 10000;
+    const int BODY_SIZE = 256;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+StompFrameBenchmark::StompFrameBenchmark() : frame(), content() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+StompFrameBenchmark::~StompFrameBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameBenchmark::setUp() {
+
+    std::vector<unsigned char> body(BODY_SIZE, 'a');
+
+    frame.setCommand(StompCommandConstants::MESSAGE);
+    frame.setProperty(StompCommandConstants::HEADER_DESTINATION, "/queue/benchmark");
+    frame.setProperty(StompCommandConstants::HEADER_MESSAGEID, "ID:host-12345-1234567890123-1:1:1:1:1");
+    frame.setProperty(StompCommandConstants::HEADER_SUBSCRIPTION, "ID:host-12345-1234567890123-1:1:1:1");
+    frame.setProperty(StompCommandConstants::HEADER_TIMESTAMP, "1234567890123");
+    frame.setProperty(StompCommandConstants::HEADER_EXPIRES, "0");
+    frame.setProperty(StompCommandConstants::HEADER_JMSPRIORITY, "4");
+    frame.setProperty("custom-property", "some value");
+    frame.setProperty(StompCommandConstants::HEADER_CONTENTLENGTH, Integer::toString(BODY_SIZE));
+    frame.setBody(&body[0], body.size());
+
+    ByteArrayOutputStream bytesOut;
+    DataOutputStream dataOut(&bytesOut);
+
+    for (int i = 0; i < FRAME_COUNT; ++i) {
+        frame.toStream(&dataOut);
+    }
+
+    std::pair<unsigned char*, int> array = bytesOut.toByteArray();
+    content.assign(array.first, array.first + array.second);
+    delete [] array.first;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameBenchmark::tearDown() {
+    content.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameBenchmark::run() {
+
+    ByteArrayOutputStream bytesOut;
+    DataOutputStream dataOut(&bytesOut);
+
+    for (int i = 0; i < FRAME_COUNT; ++i) {
+        frame.toStream(&dataOut);
+    }
+
+    ByteArrayInputStream bytesIn(content);
+    BufferedInputStream bufferedIn(&bytesIn);
+    DataInputStream dataIn(&bufferedIn);
+
+    for (int i = 0; i < FRAME_COUNT; ++i) {
+        StompFrame result;
+        result.fromStream(&dataIn);
+    }
+}
@@ -0,0 +1,56 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_WIREFORMAT_STOMP_STOMPFRAMEBENCHMARK_H_
+#define _ACTIVEMQ_WIREFORMAT_STOMP_STOMPFRAMEBENCHMARK_H_
+
+#include <benchmark/BenchmarkBase.h>
+
+#include <activemq/wireformat/stomp/StompFrame.h>
+
+#include <vector>
+
+namespace activemq {
+namespace wireformat {
+namespace stomp {
+
+    /**
+     * Writes and then reads back a stream of typical MESSAGE frames.
+     */
+    class StompFrameBenchmark :
+        public benchmark::BenchmarkBase<
+            activemq::wireformat::stomp::StompFrameBenchmark, StompFrame, 20 >
+    {
+    private:
+
+        StompFrame frame;
+        std::vector<unsigned char> content;
+
+    public:
+
+        StompFrameBenchmark();
+        virtual ~StompFrameBenchmark();
+
+        void setUp();
+        void tearDown();
+        void run();
+
+    };
+
+}}}
+
+#endif /*_ACTIVEMQ_WIREFORMAT_STOMP_STOMPFRAMEBENCHMARK_H_*/
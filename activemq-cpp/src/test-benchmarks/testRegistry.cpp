@@ -15,9 +15,19 @@
  * limitations under the License.
  */
 
+#include <activemq/commands/ActiveMQBytesMessageBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::commands::ActiveMQBytesMessageBenchmark );
+
+#include <activemq/util/BlockSequenceGeneratorBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::util::BlockSequenceGeneratorBenchmark );
+#include <activemq/util/LongSequenceGeneratorBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::util::LongSequenceGeneratorBenchmark );
 #include <activemq/util/PrimitiveMapBenchmark.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::util::PrimitiveMapBenchmark );
 
+#include <activemq/wireformat/stomp/StompFrameBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::stomp::StompFrameBenchmark );
+
 #include <decaf/lang/BooleanBenchmark.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::lang::BooleanBenchmark );
 #include <decaf/lang/ThreadBenchmark.h>
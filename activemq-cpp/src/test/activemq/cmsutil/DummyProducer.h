@@ -35,6 +35,7 @@ namespace cmsutil {
         long long ttl;
         MessageContext* messageContext;
         cms::MessageTransformer* transformer;
+        cms::ProducerWindowListener* windowListener;
 
     private:
 
@@ -45,7 +46,7 @@ namespace cmsutil {
 
         DummyProducer(MessageContext* messageContext, const cms::Destination* dest) :
             dest(dest), deliveryMode(1), disableMessageId(false), disableMessageTimestamp(false),
-            priority(4), ttl(0LL), messageContext(messageContext), transformer(NULL) {
+            priority(4), ttl(0LL), messageContext(messageContext), transformer(NULL), windowListener(NULL) {
         }
 
         virtual ~DummyProducer() {}
@@ -186,6 +187,24 @@ namespace cmsutil {
         virtual void setMessageTransformer(cms::MessageTransformer* transformer) {
             this->transformer = transformer;
         }
+
+        virtual bool trySend(cms::Message* message) {
+            send(message);
+            return true;
+        }
+
+        virtual bool trySend(const cms::Destination* destination, cms::Message* message) {
+            send(destination, message);
+            return true;
+        }
+
+        virtual void setProducerWindowListener(cms::ProducerWindowListener* listener) {
+            this->windowListener = listener;
+        }
+
+        virtual cms::ProducerWindowListener* getProducerWindowListener() const {
+            return this->windowListener;
+        }
     };
 
 }}
@@ -0,0 +1,331 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PooledConnectionFactoryTest.h"
+#include "DummyConnectionFactory.h"
+
+#include <activemq/cmsutil/PooledConnectionFactory.h>
+#include <activemq/commands/ActiveMQQueue.h>
+#include <cms/DeliveryMode.h>
+#include <cms/IllegalStateException.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/util/concurrent/Mutex.h>
+
+#include <memory>
+#include <vector>
+
+using namespace activemq;
+using namespace activemq::cmsutil;
+using namespace decaf::lang;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class RecordingConnectionFactory : public DummyConnectionFactory {
+    public:
+
+        std::vector<cms::Connection*> connections;
+
+        RecordingConnectionFactory() : DummyConnectionFactory(), connections() {}
+        virtual ~RecordingConnectionFactory() {}
+
+        virtual cms::Connection* createConnection() {
+            cms::Connection* connection = DummyConnectionFactory::createConnection();
+            connections.push_back(connection);
+            return connection;
+        }
+    };
+
+    class RecordingExceptionListener : public cms::ExceptionListener {
+    public:
+
+        int count;
+
+        RecordingExceptionListener() : count(0) {}
+        virtual ~RecordingExceptionListener() {}
+
+        virtual void onException(const cms::CMSException& ex AMQCPP_UNUSED) {
+            count++;
+        }
+    };
+
+    class LeasingThread : public Thread {
+    private:
+
+        PooledConnectionFactory* factory;
+
+    public:
+
+        bool failed;
+
+        LeasingThread(PooledConnectionFactory* factory) : Thread(), factory(factory), failed(false) {}
+        virtual ~LeasingThread() {}
+
+        virtual void run() {
+            try {
+                for (int i = 0; i < 100; ++i) {
+                    std::auto_ptr<cms::Connection> connection(factory->createConnection());
+                    std::auto_ptr<cms::Session> session(connection->createSession());
+                    session->close();
+                    connection->close();
+                }
+            } catch (...) {
+                failed = true;
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledConnectionFactoryTest::testConnectionReuse() {
+
+    DummyConnectionFactory dummy;
+    PooledConnectionFactory factory(&dummy);
+
+    std::auto_ptr<cms::Connection> connection(factory.createConnection());
+    CPPUNIT_ASSERT(connection.get() != NULL);
+    CPPUNIT_ASSERT_EQUAL(1, factory.getConnectionCount());
+    CPPUNIT_ASSERT_EQUAL(0, factory.getIdleConnectionCount());
+    connection->close();
+    CPPUNIT_ASSERT_EQUAL(1, factory.getIdleConnectionCount());
+
+    connection.reset(factory.createConnection());
+    connection.reset(factory.createConnection());
+    connection.reset();
+
+    CPPUNIT_ASSERT_EQUAL(1, factory.getConnectionsCreated());
+    CPPUNIT_ASSERT_EQUAL(3, factory.getConnectionLeases());
+    CPPUNIT_ASSERT_EQUAL(2, factory.getConnectionPoolHits());
+
+    // Other credentials get their own connection.
+    connection.reset(factory.createConnection("user", "pass"));
+    CPPUNIT_ASSERT_EQUAL(2, factory.getConnectionsCreated());
+
+    // The lease is closed, the pooled connection is not.
+    connection->close();
+    CPPUNIT_ASSERT_THROW(connection->createSession(), cms::IllegalStateException);
+    CPPUNIT_ASSERT_THROW(connection->setClientID("id"), cms::IllegalStateException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledConnectionFactoryTest::testSessionReuse() {
+
+    DummyConnectionFactory dummy;
+    PooledConnectionFactory factory(&dummy);
+    commands::ActiveMQQueue queue("test");
+
+    std::auto_ptr<cms::Connection> connection(factory.createConnection());
+    std::auto_ptr<cms::Session> session(connection->createSession());
+    std::auto_ptr<cms::MessageProducer> producer(session->createProducer(&queue));
+    CPPUNIT_ASSERT(producer.get() != NULL);
+    producer->close();
+    session->close();
+    CPPUNIT_ASSERT_THROW(session->createProducer(&queue), cms::IllegalStateException);
+
+    session.reset(connection->createSession());
+    session.reset(connection->createSession(cms::Session::CLIENT_ACKNOWLEDGE));
+    CPPUNIT_ASSERT_EQUAL(cms::Session::CLIENT_ACKNOWLEDGE, session->getAcknowledgeMode());
+    session.reset();
+
+    CPPUNIT_ASSERT_EQUAL(3LL, factory.getSessionLeases());
+    CPPUNIT_ASSERT_EQUAL(1LL, factory.getSessionPoolHits());
+
+    // Sessions stay pooled with the connection across leases.
+    connection.reset(factory.createConnection());
+    session.reset(connection->createSession());
+    CPPUNIT_ASSERT_EQUAL(2LL, factory.getSessionPoolHits());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledConnectionFactoryTest::testLeaseIsolation() {
+
+    DummyConnectionFactory dummy;
+    PooledConnectionFactory factory(&dummy);
+    commands::ActiveMQQueue queue("test");
+
+    std::auto_ptr<cms::Connection> connection(factory.createConnection());
+    std::auto_ptr<cms::Session> session(connection->createSession());
+    std::auto_ptr<cms::MessageProducer> producer(session->createProducer(&queue));
+    producer->setPriority(9);
+    producer->setDeliveryMode(cms::DeliveryMode::NON_PERSISTENT);
+    producer.reset();
+    session.reset();
+
+    // The next lease of the pooled session doesn't inherit the producer settings.
+    session.reset(connection->createSession());
+    producer.reset(session->createProducer(&queue));
+    CPPUNIT_ASSERT_EQUAL(4, producer->getPriority());
+    CPPUNIT_ASSERT_EQUAL((int) cms::DeliveryMode::PERSISTENT, producer->getDeliveryMode());
+    producer.reset();
+
+    // Closing the lease closes what was created through it.
+    std::auto_ptr<cms::MessageConsumer> consumer(session->createConsumer(&queue));
+    connection->close();
+    CPPUNIT_ASSERT_THROW(session->createProducer(&queue), cms::IllegalStateException);
+    consumer.reset();
+    session.reset();
+
+    CPPUNIT_ASSERT_EQUAL(1, factory.getIdleConnectionCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledConnectionFactoryTest::testMaxConnections() {
+
+    DummyConnectionFactory dummy;
+    PooledConnectionFactory factory(&dummy);
+
+    CPPUNIT_ASSERT_THROW(factory.setMaxConnections(0), cms::CMSException);
+    factory.setMaxConnections(2);
+    CPPUNIT_ASSERT_EQUAL(2, factory.getMaxConnections());
+
+    std::auto_ptr<cms::Connection> connection1(factory.createConnection());
+    std::auto_ptr<cms::Connection> connection2(factory.createConnection());
+    std::auto_ptr<cms::Connection> connection3(factory.createConnection());
+
+    // The third lease shares one of the open connections.
+    CPPUNIT_ASSERT_EQUAL(2, factory.getConnectionsCreated());
+    CPPUNIT_ASSERT_EQUAL(2, factory.getConnectionCount());
+    CPPUNIT_ASSERT_EQUAL(1, factory.getConnectionPoolHits());
+
+    CPPUNIT_ASSERT_THROW(factory.setMaxConnections(4), cms::IllegalStateException);
+
+    // Every connection is busy with other credentials.
+    CPPUNIT_ASSERT_THROW(factory.createConnection("user", "pass"), cms::IllegalStateException);
+
+    // An idle connection is replaced by one for the requested credentials.
+    connection1.reset();
+    connection2.reset();
+    connection3.reset();
+    std::auto_ptr<cms::Connection> other(factory.createConnection("user", "pass"));
+    CPPUNIT_ASSERT_EQUAL(3, factory.getConnectionsCreated());
+    CPPUNIT_ASSERT_EQUAL(2, factory.getConnectionCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledConnectionFactoryTest::testMaximumActiveSessionPerConnection() {
+
+    DummyConnectionFactory dummy;
+    PooledConnectionFactory factory(&dummy);
+    factory.setMaximumActiveSessionPerConnection(1);
+
+    std::auto_ptr<cms::Connection> connection(factory.createConnection());
+    std::auto_ptr<cms::Session> session(connection->createSession());
+    CPPUNIT_ASSERT_THROW(connection->createSession(), cms::IllegalStateException);
+
+    session.reset();
+    session.reset(connection->createSession());
+    CPPUNIT_ASSERT(session.get() != NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledConnectionFactoryTest::testIdleEviction() {
+
+    DummyConnectionFactory dummy;
+    PooledConnectionFactory factory(&dummy);
+    factory.setIdleTimeout(5);
+
+    std::auto_ptr<cms::Connection> connection(factory.createConnection());
+    std::auto_ptr<cms::Session> session(connection->createSession());
+
+    // Leased connections are never evicted.
+    Thread::sleep(20);
+    factory.evictIdleConnections();
+    CPPUNIT_ASSERT_EQUAL(1, factory.getConnectionCount());
+
+    session.reset();
+    connection.reset();
+    Thread::sleep(20);
+    factory.evictIdleConnections();
+    CPPUNIT_ASSERT_EQUAL(0, factory.getConnectionCount());
+
+    connection.reset(factory.createConnection());
+    CPPUNIT_ASSERT_EQUAL(2, factory.getConnectionsCreated());
+    CPPUNIT_ASSERT_EQUAL(0, factory.getConnectionPoolHits());
+
+    // The sessions of the evicted connection are still counted.
+    session.reset(connection->createSession());
+    CPPUNIT_ASSERT_EQUAL(2LL, factory.getSessionLeases());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledConnectionFactoryTest::testFailedConnectionIsReplaced() {
+
+    RecordingConnectionFactory dummy;
+    RecordingExceptionListener factoryListener;
+    RecordingExceptionListener leaseListener;
+    PooledConnectionFactory factory(&dummy);
+    factory.setExceptionListener(&factoryListener);
+
+    std::auto_ptr<cms::Connection> connection(factory.createConnection());
+    connection->setExceptionListener(&leaseListener);
+    CPPUNIT_ASSERT_EQUAL((std::size_t) 1, dummy.connections.size());
+
+    cms::ExceptionListener* poolListener = dummy.connections[0]->getExceptionListener();
+    CPPUNIT_ASSERT(poolListener != NULL);
+    poolListener->onException(cms::CMSException("connection failed"));
+    CPPUNIT_ASSERT_EQUAL(1, factoryListener.count);
+    CPPUNIT_ASSERT_EQUAL(1, leaseListener.count);
+
+    // The failed connection is closed once its last lease is returned.
+    connection.reset();
+    CPPUNIT_ASSERT_EQUAL(0, factory.getConnectionCount());
+
+    connection.reset(factory.createConnection());
+    CPPUNIT_ASSERT_EQUAL(2, factory.getConnectionsCreated());
+    CPPUNIT_ASSERT_EQUAL((std::size_t) 2, dummy.connections.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledConnectionFactoryTest::testClientIdIsNotPooled() {
+
+    DummyConnectionFactory dummy;
+    PooledConnectionFactory factory(&dummy);
+
+    std::auto_ptr<cms::Connection> connection(factory.createConnection("user", "pass", "clientId"));
+    CPPUNIT_ASSERT_EQUAL(std::string("clientId"), connection->getClientID());
+    CPPUNIT_ASSERT_EQUAL(0, factory.getConnectionLeases());
+    CPPUNIT_ASSERT_EQUAL(0, factory.getConnectionCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledConnectionFactoryTest::testConcurrentLeases() {
+
+    DummyConnectionFactory dummy;
+    PooledConnectionFactory factory(&dummy);
+    factory.setMaxConnections(2);
+
+    const int threadCount = 8;
+    std::vector<LeasingThread*> threads;
+    for (int i = 0; i < threadCount; ++i) {
+        threads.push_back(new LeasingThread(&factory));
+        threads.back()->start();
+    }
+
+    bool failed = false;
+    for (int i = 0; i < threadCount; ++i) {
+        threads[i]->join();
+        failed = failed || threads[i]->failed;
+        delete threads[i];
+    }
+
+    CPPUNIT_ASSERT(!failed);
+    CPPUNIT_ASSERT(factory.getConnectionsCreated() <= 2);
+    CPPUNIT_ASSERT_EQUAL(threadCount * 100, factory.getConnectionLeases());
+    CPPUNIT_ASSERT_EQUAL(threadCount * 100 - factory.getConnectionsCreated(), factory.getConnectionPoolHits());
+    CPPUNIT_ASSERT_EQUAL((long long) threadCount * 100, factory.getSessionLeases());
+}
@@ -20,12 +20,15 @@
 #include <decaf/util/UUID.h>
 #include <decaf/lang/Exception.h>
 #include <activemq/commands/ActiveMQBytesMessage.h>
+#include <activemq/core/ActiveMQConnection.h>
+#include <activemq/core/ActiveMQConnectionFactory.h>
 
 using namespace std;
 using namespace cms;
 using namespace activemq;
 using namespace activemq::util;
 using namespace activemq::commands;
+using namespace activemq::core;
 using namespace decaf;
 using namespace decaf::lang;
 
@@ -459,3 +462,62 @@ void ActiveMQBytesMessageTest::testWriteOnlyBody() {
     } catch( MessageNotReadableException& e ) {
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQBytesMessageTest::testLargeBody() {
+
+    const int size = 256 * 1024;
+
+    std::vector<unsigned char> body(size);
+    for (int i = 0; i < size; ++i) {
+        body[i] = (unsigned char) (i % 251);
+    }
+
+    ActiveMQBytesMessage message;
+    message.writeInt(size);
+    message.writeBytes(body);
+
+    // Copying a message part way through stores what has been written so far.
+    std::auto_ptr<ActiveMQBytesMessage> copy(message.cloneDataStructure());
+    CPPUNIT_ASSERT_EQUAL((std::size_t) size + 4, copy->getContent().size());
+
+    message.reset();
+
+    CPPUNIT_ASSERT_EQUAL((std::size_t) size + 4, message.getContent().size());
+    CPPUNIT_ASSERT_EQUAL(size + 4, message.getBodyLength());
+    CPPUNIT_ASSERT_EQUAL(size, message.readInt());
+
+    std::vector<unsigned char> result(size);
+    CPPUNIT_ASSERT_EQUAL(size, message.readBytes(result));
+    CPPUNIT_ASSERT(body == result);
+
+    copy->reset();
+    CPPUNIT_ASSERT_EQUAL(size, copy->readInt());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQBytesMessageTest::testClearCompressedBody() {
+
+    ActiveMQConnectionFactory factory("mock://127.0.0.1:12345?wireFormat=openwire&connection.useCompression=true");
+    std::auto_ptr<ActiveMQConnection> connection(dynamic_cast<ActiveMQConnection*>(factory.createConnection()));
+
+    ActiveMQBytesMessage message;
+    message.setConnection(connection.get());
+
+    message.writeInt(42);
+    message.writeUTF("discarded");
+    message.clearBody();
+
+    CPPUNIT_ASSERT(!message.isCompressed());
+    CPPUNIT_ASSERT(message.getContent().empty());
+
+    message.writeInt(7);
+    message.writeUTF("kept");
+    message.reset();
+
+    CPPUNIT_ASSERT(message.isCompressed());
+    CPPUNIT_ASSERT_EQUAL(7, message.readInt());
+    CPPUNIT_ASSERT_EQUAL(std::string("kept"), message.readUTF());
+
+    connection->close();
+}
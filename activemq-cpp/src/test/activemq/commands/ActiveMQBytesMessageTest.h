@@ -43,6 +43,8 @@ namespace commands{
         CPPUNIT_TEST( testReset );
         CPPUNIT_TEST( testReadOnlyBody );
         CPPUNIT_TEST( testWriteOnlyBody );
+        CPPUNIT_TEST( testLargeBody );
+        CPPUNIT_TEST( testClearCompressedBody );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -67,6 +69,8 @@ namespace commands{
         void testReset();
         void testReadOnlyBody();
         void testWriteOnlyBody();
+        void testLargeBody();
+        void testClearCompressedBody();
 
     };
 
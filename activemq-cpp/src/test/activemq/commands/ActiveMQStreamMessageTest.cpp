@@ -18,6 +18,8 @@
 #include "ActiveMQStreamMessageTest.h"
 
 #include <activemq/commands/ActiveMQStreamMessage.h>
+#include <activemq/core/ActiveMQConnection.h>
+#include <activemq/core/ActiveMQConnectionFactory.h>
 
 #include <cms/MessageFormatException.h>
 #include <cms/MessageEOFException.h>
@@ -37,6 +39,7 @@ using namespace cms;
 using namespace std;
 using namespace activemq;
 using namespace activemq::commands;
+using namespace activemq::core;
 using namespace decaf;
 using namespace decaf::lang;
 
@@ -973,3 +976,29 @@ void ActiveMQStreamMessageTest::testWriteOnlyBody() {
     } catch( MessageNotReadableException& e ) {
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQStreamMessageTest::testClearCompressedBody() {
+
+    ActiveMQConnectionFactory factory("mock://127.0.0.1:12345?wireFormat=openwire&connection.useCompression=true");
+    std::auto_ptr<ActiveMQConnection> connection(dynamic_cast<ActiveMQConnection*>(factory.createConnection()));
+
+    ActiveMQStreamMessage message;
+    message.setConnection(connection.get());
+
+    message.writeInt(42);
+    message.writeString("discarded");
+    message.clearBody();
+
+    CPPUNIT_ASSERT(!message.isCompressed());
+    CPPUNIT_ASSERT(message.getContent().empty());
+
+    message.writeInt(7);
+    message.writeString("kept");
+    message.reset();
+
+    CPPUNIT_ASSERT_EQUAL(7, message.readInt());
+    CPPUNIT_ASSERT_EQUAL(std::string("kept"), message.readString());
+
+    connection->close();
+}
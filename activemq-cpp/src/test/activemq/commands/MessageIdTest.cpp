@@ -0,0 +1,153 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MessageIdTest.h"
+
+#include <activemq/commands/MessageId.h>
+#include <activemq/commands/ProducerId.h>
+#include <activemq/commands/ConsumerId.h>
+#include <activemq/commands/SessionId.h>
+#include <decaf/lang/Pointer.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::commands;
+using namespace decaf;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageIdTest::testToString() {
+
+    SessionId sessionId;
+    sessionId.setConnectionId("ID:host-1234-1-0:1");
+    sessionId.setValue(2);
+    CPPUNIT_ASSERT_EQUAL(std::string("ID:host-1234-1-0:1:2"), sessionId.toString());
+
+    Pointer<ProducerId> producerId(new ProducerId(sessionId, 3));
+    CPPUNIT_ASSERT_EQUAL(std::string("ID:host-1234-1-0:1:2:3"), producerId->toString());
+
+    ConsumerId consumerId(sessionId, 4);
+    CPPUNIT_ASSERT_EQUAL(std::string("ID:host-1234-1-0:1:2:4"), consumerId.toString());
+
+    MessageId messageId(producerId, 42);
+    CPPUNIT_ASSERT_EQUAL(std::string("ID:host-1234-1-0:1:2:3:42"), messageId.toString());
+    CPPUNIT_ASSERT_EQUAL(std::string("ID:host-1234-1-0:1:2:3:42"), messageId.toString());
+
+    MessageId textId;
+    textId.setTextView("host-1234-1-0:1:2:3:42");
+    CPPUNIT_ASSERT_EQUAL(std::string("ID:host-1234-1-0:1:2:3:42"), textId.toString());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageIdTest::testSetValue() {
+
+    MessageId messageId("ID:host-1234-1-0:1:2:3:42");
+
+    CPPUNIT_ASSERT_EQUAL(42LL, messageId.getProducerSequenceId());
+    CPPUNIT_ASSERT_EQUAL(std::string("ID:host-1234-1-0:1"), messageId.getProducerId()->getConnectionId());
+    CPPUNIT_ASSERT_EQUAL(2LL, messageId.getProducerId()->getSessionId());
+    CPPUNIT_ASSERT_EQUAL(3LL, messageId.getProducerId()->getValue());
+    CPPUNIT_ASSERT_EQUAL(std::string("ID:host-1234-1-0:1:2:3:42"), messageId.toString());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageIdTest::testToStringAfterSetters() {
+
+    Pointer<ProducerId> producerId(new ProducerId);
+    producerId->setConnectionId("test");
+    producerId->setSessionId(1);
+    producerId->setValue(1);
+    CPPUNIT_ASSERT_EQUAL(std::string("test:1:1"), producerId->toString());
+
+    producerId->setValue(2);
+    CPPUNIT_ASSERT_EQUAL(std::string("test:1:2"), producerId->toString());
+
+    MessageId messageId;
+    messageId.setProducerId(producerId);
+    messageId.setProducerSequenceId(1);
+    CPPUNIT_ASSERT_EQUAL(std::string("test:1:2:1"), messageId.toString());
+
+    messageId.setProducerSequenceId(2);
+    CPPUNIT_ASSERT_EQUAL(std::string("test:1:2:2"), messageId.toString());
+
+    MessageId copy(messageId);
+    CPPUNIT_ASSERT_EQUAL(std::string("test:1:2:2"), copy.toString());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageIdTest::testHashCode() {
+
+    Pointer<ProducerId> producerId1(new ProducerId("ID:host-1234-1-0:1:2:3"));
+    Pointer<ProducerId> producerId2(new ProducerId);
+    producerId2->setConnectionId("ID:host-1234-1-0:1");
+    producerId2->setSessionId(2);
+    producerId2->setValue(3);
+
+    CPPUNIT_ASSERT(producerId1->equals(producerId2.get()));
+    CPPUNIT_ASSERT_EQUAL(producerId1->getHashCode(), producerId2->getHashCode());
+
+    MessageId messageId1(producerId1, 10);
+    MessageId messageId2(producerId2, 10);
+    MessageId messageId3(producerId2, 11);
+
+    CPPUNIT_ASSERT(messageId1.equals(messageId2));
+    CPPUNIT_ASSERT_EQUAL(messageId1.getHashCode(), messageId2.getHashCode());
+    CPPUNIT_ASSERT(messageId1.getHashCode() != messageId3.getHashCode());
+
+    int hashCode = producerId2->getHashCode();
+    producerId2->setValue(4);
+    CPPUNIT_ASSERT(hashCode != producerId2->getHashCode());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageIdTest::testCompareTo() {
+
+    Pointer<ProducerId> producerId1(new ProducerId("ID:host-1234-1-0:1:2:3"));
+    Pointer<ProducerId> producerId2(new ProducerId("id:HOST-1234-1-0:1:2:3"));
+    Pointer<ProducerId> producerId3(new ProducerId("ID:host-1234-1-0:1:2:4"));
+
+    CPPUNIT_ASSERT_EQUAL(0, producerId1->compareTo(*producerId2));
+    CPPUNIT_ASSERT(producerId1->compareTo(*producerId3) < 0);
+    CPPUNIT_ASSERT(producerId3->compareTo(*producerId1) > 0);
+
+    MessageId messageId1(producerId1, 10);
+    MessageId messageId2(producerId1, 11);
+
+    CPPUNIT_ASSERT(messageId1 < messageId2);
+    CPPUNIT_ASSERT(!(messageId2 < messageId1));
+    CPPUNIT_ASSERT(messageId1 == MessageId(producerId1, 10));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageIdTest::testMutableConnectionId() {
+
+    Pointer<ProducerId> producerId(new ProducerId("ID:host-1234-1-0:1:2:3"));
+    MessageId messageId(producerId, 42);
+    int hashCode = producerId->getHashCode();
+
+    producerId->getConnectionId() = "ID:host-5678-1-0:1";
+    CPPUNIT_ASSERT_EQUAL(std::string("ID:host-5678-1-0:1:2:3"), producerId->toString());
+    CPPUNIT_ASSERT(hashCode != producerId->getHashCode());
+    CPPUNIT_ASSERT_EQUAL(std::string("ID:host-5678-1-0:1:2:3:42"), messageId.toString());
+
+    producerId->getConnectionId().erase(producerId->getConnectionId().length() - 2);
+    CPPUNIT_ASSERT_EQUAL(std::string("ID:host-5678-1-0:2:3"), producerId->toString());
+
+    ProducerId copy(*producerId);
+    CPPUNIT_ASSERT_EQUAL(producerId->toString(), copy.toString());
+    CPPUNIT_ASSERT_EQUAL(producerId->getHashCode(), copy.getHashCode());
+}
@@ -32,6 +32,9 @@
 #include <activemq/transport/TransportRegistry.h>
 #include <activemq/util/Config.h>
 #include <activemq/commands/Message.h>
+#include <activemq/mock/MockStompBrokerService.h>
+#include <activemq/wireformat/openwire/OpenWireFormat.h>
+#include <activemq/wireformat/stomp/StompCommandConstants.h>
 
 #include <cms/Connection.h>
 #include <cms/ExceptionListener.h>
@@ -250,3 +253,70 @@ void ActiveMQConnectionTest::testExceptionInOnException() {
         throw ex;
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionTest::testStompHeartBeats() {
+
+    mock::MockStompBrokerService broker;
+    broker.setHeartBeat(100, 100);
+    broker.start();
+    broker.waitUntilStarted();
+
+    MyExceptionListener exListener;
+    std::auto_ptr<ActiveMQConnectionFactory> factory(new ActiveMQConnectionFactory(
+        broker.getConnectString() + "&wireFormat.acceptVersion=1.0,1.1,1.2"
+        "&wireFormat.outgoingHeartBeat=300&wireFormat.incomingHeartBeat=300"));
+    std::auto_ptr<cms::Connection> connection(factory->createConnection());
+    connection->setExceptionListener(&exListener);
+    connection->start();
+
+    Pointer<wireformat::stomp::StompFrame> connect =
+        broker.waitForFrame(wireformat::stomp::StompCommandConstants::CONNECT, 2000);
+    CPPUNIT_ASSERT(connect != NULL);
+    CPPUNIT_ASSERT_EQUAL(std::string("localhost"),
+                         connect->getProperty(wireformat::stomp::StompCommandConstants::HEADER_HOST));
+    CPPUNIT_ASSERT_EQUAL(wireformat::stomp::StompCommandConstants::VERSION_1_2, broker.getNegotiatedVersion());
+
+    // Both ends keep beating so the connection outlives several read checks.
+    CPPUNIT_ASSERT(exListener.waitForException(2000) == false);
+    CPPUNIT_ASSERT(broker.getHeartBeatsReceived() > 0);
+
+    // The agreed heart-beat timing isn't mistaken for the broker's wire format.
+    ActiveMQConnection* amqConnection = dynamic_cast<ActiveMQConnection*>(connection.get());
+    CPPUNIT_ASSERT_EQUAL(wireformat::openwire::OpenWireFormat::MAX_SUPPORTED_VERSION, amqConnection->getProtocolVersion());
+
+    connection->close();
+    broker.stop();
+    broker.waitUntilStopped();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionTest::testStompMissedHeartBeats() {
+
+    mock::MockStompBrokerService broker;
+    broker.setSupportedVersions("1.0,1.1");
+    broker.setHeartBeat(100, 0);
+    broker.setSendHeartBeats(false);
+    broker.start();
+    broker.waitUntilStarted();
+
+    MyExceptionListener exListener;
+    std::auto_ptr<ActiveMQConnectionFactory> factory(new ActiveMQConnectionFactory(
+        broker.getConnectString() + "&wireFormat.acceptVersion=1.0,1.1&wireFormat.incomingHeartBeat=200"));
+    std::auto_ptr<cms::Connection> connection(factory->createConnection());
+    connection->setExceptionListener(&exListener);
+    connection->start();
+
+    CPPUNIT_ASSERT_EQUAL(wireformat::stomp::StompCommandConstants::VERSION_1_1, broker.getNegotiatedVersion());
+
+    // The broker promised heart-beats it never sends, the connection must fail.
+    CPPUNIT_ASSERT(exListener.waitForException(3000) == true);
+
+    try {
+        connection->close();
+    } catch (...) {
+    }
+
+    broker.stop();
+    broker.waitUntilStopped();
+}
@@ -30,6 +30,8 @@ namespace core {
         CPPUNIT_TEST( test2WithOpenwire );
         CPPUNIT_TEST( testCloseCancelsHungStart );
         CPPUNIT_TEST( testExceptionInOnException );
+        CPPUNIT_TEST( testStompHeartBeats );
+        CPPUNIT_TEST( testStompMissedHeartBeats );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -40,6 +42,8 @@ namespace core {
         void test2WithOpenwire();
         void testCloseCancelsHungStart();
         void testExceptionInOnException();
+        void testStompHeartBeats();
+        void testStompMissedHeartBeats();
 
     };
 
@@ -21,6 +21,7 @@
 #include <activemq/util/IdGenerator.h>
 
 #include <decaf/util/ArrayList.h>
+#include <decaf/lang/Integer.h>
 
 using namespace std;
 using namespace activemq;
@@ -220,3 +221,149 @@ void ActiveMQMessageAuditTest::testGetLastSeqId() {
     }
 
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQMessageAuditTest::testMultipleProducers() {
+
+    int count = 1000;
+    int producers = 32;
+    ActiveMQMessageAudit audit;
+
+    ArrayList<Pointer<ProducerId> > pids;
+    for (int i = 0; i < producers; i++) {
+        Pointer<ProducerId> pid(new ProducerId);
+        pid->setConnectionId("test");
+        pid->setSessionId(i % 4);
+        pid->setValue(i);
+        pids.add(pid);
+    }
+
+    for (int seq = 0; seq < count; seq++) {
+        for (int i = 0; i < producers; i++) {
+            Pointer<MessageId> id(new MessageId);
+            id->setProducerId(pids.get(i));
+            id->setProducerSequenceId(seq);
+            CPPUNIT_ASSERT_MESSAGE(std::string() + "duplicate msg:" + id->toString(), !audit.isDuplicate(id));
+        }
+    }
+
+    for (int i = 0; i < producers; i++) {
+        CPPUNIT_ASSERT_EQUAL((long long)(count - 1), audit.getLastSeqId(pids.get(i)));
+
+        Pointer<MessageId> id(new MessageId);
+        id->setProducerId(pids.get(i));
+        id->setProducerSequenceId(count - 1);
+        CPPUNIT_ASSERT(audit.isDuplicate(id));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQMessageAuditTest::testMaximumProducersToTrack() {
+
+    int producers = 10;
+    ActiveMQMessageAudit audit(ActiveMQMessageAudit::DEFAULT_WINDOW_SIZE, producers);
+
+    ArrayList<Pointer<MessageId> > list;
+    for (int i = 0; i < producers * 2; i++) {
+        Pointer<ProducerId> pid(new ProducerId);
+        pid->setConnectionId("test");
+        pid->setSessionId(0);
+        pid->setValue(i);
+
+        Pointer<MessageId> id(new MessageId);
+        id->setProducerId(pid);
+        id->setProducerSequenceId(1);
+        list.add(id);
+
+        CPPUNIT_ASSERT(!audit.isDuplicate(id));
+    }
+
+    // The oldest producers have been evicted and start over.
+    for (int i = 0; i < producers; i++) {
+        CPPUNIT_ASSERT_EQUAL(-1LL, audit.getLastSeqId(list.get(i)->getProducerId()));
+    }
+
+    for (int i = producers; i < producers * 2; i++) {
+        CPPUNIT_ASSERT(audit.isDuplicate(list.get(i)));
+    }
+
+    audit.getMaximumNumberOfProducersToTrack(1);
+    CPPUNIT_ASSERT_EQUAL(1, audit.getMaximumNumberOfProducersToTrack());
+    CPPUNIT_ASSERT_EQUAL(1LL, audit.getLastSeqId(list.get(producers * 2 - 1)->getProducerId()));
+    CPPUNIT_ASSERT_EQUAL(-1LL, audit.getLastSeqId(list.get(producers)->getProducerId()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQMessageAuditTest::testSequenceGap() {
+
+    ActiveMQMessageAudit audit;
+
+    Pointer<ProducerId> pid(new ProducerId);
+    pid->setConnectionId("test");
+    pid->setSessionId(0);
+    pid->setValue(1);
+
+    Pointer<MessageId> id(new MessageId);
+    id->setProducerId(pid);
+
+    id->setProducerSequenceId(10);
+    CPPUNIT_ASSERT(!audit.isDuplicate(id));
+    CPPUNIT_ASSERT(audit.isDuplicate(id));
+
+    long long jump = 10LL * Integer::MAX_VALUE;
+    id->setProducerSequenceId(jump);
+    CPPUNIT_ASSERT(!audit.isDuplicate(id));
+    CPPUNIT_ASSERT(audit.isDuplicate(id));
+    CPPUNIT_ASSERT(audit.isInOrder(id));
+    CPPUNIT_ASSERT_EQUAL(jump, audit.getLastSeqId(pid));
+
+    // Ids that fell behind the window are no longer tracked.
+    id->setProducerSequenceId(10);
+    CPPUNIT_ASSERT(!audit.isDuplicate(id));
+    CPPUNIT_ASSERT(!audit.isInOrder(id));
+
+    id->setProducerSequenceId(jump);
+    audit.rollback(id);
+    CPPUNIT_ASSERT(!audit.isDuplicate(id));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQMessageAuditTest::testStringAndMessageIdShareProducer() {
+
+    ActiveMQMessageAudit audit;
+
+    Pointer<ProducerId> pid(new ProducerId);
+    pid->setConnectionId("ID:test-connection:1");
+    pid->setSessionId(2);
+    pid->setValue(3);
+    pid->afterUnmarshal(NULL);
+
+    Pointer<MessageId> id(new MessageId(pid, 1));
+
+    // Both forms of the id are recorded against the same producer.
+    CPPUNIT_ASSERT(!audit.isDuplicate(id));
+    CPPUNIT_ASSERT(audit.isDuplicate(id->toString()));
+    CPPUNIT_ASSERT(audit.isDuplicate(std::string("ID:test-connection:1:2:3:1")));
+
+    CPPUNIT_ASSERT(!audit.isDuplicate(std::string("ID:test-connection:1:2:3:2")));
+    CPPUNIT_ASSERT_EQUAL(2LL, audit.getLastSeqId(pid));
+
+    audit.rollback(std::string("ID:test-connection:1:2:3:2"));
+    CPPUNIT_ASSERT_EQUAL(1LL, audit.getLastSeqId(pid));
+
+    id->setProducerSequenceId(2);
+    CPPUNIT_ASSERT(!audit.isDuplicate(id));
+    CPPUNIT_ASSERT(audit.isDuplicate(id->toString()));
+
+    // A producer id whose key is stale finds the same entry.
+    Pointer<ProducerId> stale(new ProducerId);
+    stale->setConnectionId("ID:test-connection:1");
+    stale->setSessionId(2);
+    stale->setValue(3);
+    CPPUNIT_ASSERT(stale->getCachedKey() == NULL);
+    CPPUNIT_ASSERT_EQUAL(2LL, audit.getLastSeqId(stale));
+
+    // Other producers of the same session are kept apart.
+    CPPUNIT_ASSERT(!audit.isDuplicate(std::string("ID:test-connection:1:2:4:1")));
+    CPPUNIT_ASSERT(!audit.isDuplicate(std::string("ID:test-connection:1:2:34:1")));
+}
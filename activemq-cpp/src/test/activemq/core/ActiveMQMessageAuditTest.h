@@ -34,6 +34,10 @@ namespace core {
         CPPUNIT_TEST( testRollbackString );
         CPPUNIT_TEST( testRollbackMessageId );
         CPPUNIT_TEST( testGetLastSeqId );
+        CPPUNIT_TEST( testMultipleProducers );
+        CPPUNIT_TEST( testMaximumProducersToTrack );
+        CPPUNIT_TEST( testSequenceGap );
+        CPPUNIT_TEST( testStringAndMessageIdShareProducer );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -48,6 +52,10 @@ namespace core {
         void testRollbackString();
         void testRollbackMessageId();
         void testGetLastSeqId();
+        void testMultipleProducers();
+        void testMaximumProducersToTrack();
+        void testSequenceGap();
+        void testStringAndMessageIdShareProducer();
 
     };
 
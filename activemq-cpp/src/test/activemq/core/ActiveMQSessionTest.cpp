@@ -18,19 +18,32 @@
 #include "ActiveMQSessionTest.h"
 
 #include <cms/ExceptionListener.h>
+#include <cms/IllegalStateException.h>
+#include <cms/ProducerWindowListener.h>
 #include <activemq/transport/mock/MockTransportFactory.h>
 #include <activemq/transport/TransportRegistry.h>
+#include <activemq/transport/DefaultTransportListener.h>
 #include <activemq/commands/ActiveMQTextMessage.h>
 #include <activemq/commands/ConsumerId.h>
+#include <activemq/commands/MessageAck.h>
 #include <activemq/commands/MessageDispatch.h>
+#include <activemq/commands/ProducerAck.h>
+#include <activemq/commands/RemoveInfo.h>
 #include <activemq/core/ActiveMQConnectionFactory.h>
+#include <activemq/core/ActiveMQConstants.h>
 #include <activemq/core/ActiveMQSession.h>
 #include <activemq/core/ActiveMQConsumer.h>
 #include <activemq/core/ActiveMQProducer.h>
+#include <activemq/core/DispatchKeyFunction.h>
+#include <activemq/core/PrefetchPolicy.h>
+#include <activemq/core/RedeliveryPolicy.h>
+#include <activemq/core/TopicFanOut.h>
 #include <decaf/util/Properties.h>
+#include <decaf/lang/Integer.h>
 #include <decaf/lang/System.h>
 #include <decaf/lang/Pointer.h>
 #include <decaf/lang/Thread.h>
+#include <decaf/lang/exceptions/RuntimeException.h>
 #include <decaf/net/Socket.h>
 #include <decaf/net/ServerSocket.h>
 
@@ -101,6 +114,167 @@ namespace core {
             AMQ_CATCHALL_THROW( activemq::exceptions::ActiveMQException )
         }
     };
+
+    class MyAsyncCallback : public cms::AsyncCallback {
+    public:
+
+        int successes;
+        int failures;
+        decaf::util::concurrent::Mutex mutex;
+
+    public:
+
+        MyAsyncCallback() : successes(0), failures(0), mutex() {
+        }
+
+        virtual ~MyAsyncCallback() {
+        }
+
+        virtual void onSuccess() {
+            synchronized( &mutex ) {
+                successes++;
+                mutex.notifyAll();
+            }
+        }
+
+        virtual void onException(const cms::CMSException& ex AMQCPP_UNUSED) {
+            synchronized( &mutex ) {
+                failures++;
+                mutex.notifyAll();
+            }
+        }
+
+        int waitForCompletions( int count ) {
+
+            synchronized( &mutex ) {
+                int stopAtZero = 10;
+
+                while( successes + failures < count && --stopAtZero > 0 ) {
+                    mutex.wait( 500 );
+                }
+
+                return successes;
+            }
+
+            return 0;
+        }
+    };
+
+    class MyModuloKeyFunction : public DispatchKeyFunction {
+    public:
+
+        int modulus;
+
+        MyModuloKeyFunction(int modulus) : modulus(modulus) {}
+        virtual ~MyModuloKeyFunction() {}
+
+        virtual std::string getKey(const cms::Message* message) {
+            const cms::TextMessage* text = dynamic_cast<const cms::TextMessage*>(message);
+            return Integer::toString(Integer::parseInt(text->getText()) % modulus);
+        }
+    };
+
+    class MySlowKeyListener : public MyCMSMessageListener {
+    public:
+
+        MySlowKeyListener() : MyCMSMessageListener() {}
+        virtual ~MySlowKeyListener() {}
+
+        virtual void onMessage(const cms::Message* message) {
+            const cms::TextMessage* text = dynamic_cast<const cms::TextMessage*>(message);
+            if (Integer::parseInt(text->getText()) % 3 == 0) {
+                Thread::sleep(5);
+            }
+
+            MyCMSMessageListener::onMessage(message);
+        }
+    };
+
+    class MyFailOnceKeyListener : public MyCMSMessageListener {
+    public:
+
+        std::string failOn;
+
+        MyFailOnceKeyListener(const std::string& failOn) : MyCMSMessageListener(), failOn(failOn) {}
+        virtual ~MyFailOnceKeyListener() {}
+
+        virtual void onMessage(const cms::Message* message) {
+            const cms::TextMessage* text = dynamic_cast<const cms::TextMessage*>(message);
+            if (text->getText() == failOn) {
+                failOn = "";
+                // Give the later messages with the same key time to queue behind this one.
+                Thread::sleep(20);
+                throw decaf::lang::exceptions::RuntimeException(__FILE__, __LINE__, "Listener failure");
+            }
+
+            MyCMSMessageListener::onMessage(message);
+        }
+    };
+
+    class MyFanOutRecorder : public transport::DefaultTransportListener {
+    public:
+
+        decaf::util::concurrent::Mutex mutex;
+        std::vector< Pointer<ConsumerInfo> > consumers;
+        std::vector< Pointer<RemoveInfo> > removes;
+        std::vector< Pointer<MessageAck> > acks;
+
+        MyFanOutRecorder() : mutex(), consumers(), removes(), acks() {}
+        virtual ~MyFanOutRecorder() {}
+
+        virtual void onCommand(const Pointer<Command> command) {
+            synchronized( &mutex ) {
+                if (command->isConsumerInfo()) {
+                    consumers.push_back(command.dynamicCast<ConsumerInfo>());
+                } else if (command->isRemoveInfo()) {
+                    removes.push_back(command.dynamicCast<RemoveInfo>());
+                } else if (command->isMessageAck()) {
+                    acks.push_back(command.dynamicCast<MessageAck>());
+                }
+            }
+        }
+
+        int getAckedCount() {
+            int count = 0;
+            synchronized( &mutex ) {
+                for (std::size_t i = 0; i < acks.size(); ++i) {
+                    count += acks[i]->getMessageCount();
+                }
+            }
+            return count;
+        }
+    };
+
+    class MyWindowListener : public cms::ProducerWindowListener {
+    public:
+
+        int notifications;
+
+        MyWindowListener() : notifications(0) {}
+        virtual ~MyWindowListener() {}
+
+        virtual void onWindowAvailable(cms::MessageProducer* producer AMQCPP_UNUSED) {
+            notifications++;
+        }
+    };
+
+    class MyAckRecorder : public transport::DefaultTransportListener {
+    public:
+
+        decaf::util::concurrent::Mutex mutex;
+        std::vector< Pointer<MessageAck> > acks;
+
+        MyAckRecorder() : mutex(), acks() {}
+        virtual ~MyAckRecorder() {}
+
+        virtual void onCommand(const Pointer<Command> command) {
+            if (command->isMessageAck()) {
+                synchronized( &mutex ) {
+                    acks.push_back(command.dynamicCast<MessageAck>());
+                }
+            }
+        }
+    };
 }}
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -510,6 +684,66 @@ void ActiveMQSessionTest::testTransactionRollbackTwoConsumer() {
     session->commit();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testTransactionCommitAsync() {
+
+    static const int BATCH_COUNT = 5;
+    static const int BATCH_SIZE = 10;
+
+    MyAsyncCallback callback;
+
+    CPPUNIT_ASSERT( connection.get() != NULL );
+
+    std::auto_ptr<ActiveMQSession> session(
+        dynamic_cast<ActiveMQSession*>( connection->createSession( cms::Session::SESSION_TRANSACTED ) ) );
+    CPPUNIT_ASSERT( session.get() != NULL );
+
+    std::auto_ptr<cms::Topic> topic1( session->createTopic( "TestTopic1" ) );
+    std::auto_ptr<cms::MessageProducer> producer( session->createProducer( topic1.get() ) );
+    std::auto_ptr<cms::TextMessage> message( session->createTextMessage( "batch" ) );
+
+    // Each batch starts its own transaction while the last commit is still outstanding.
+    for( int batch = 0; batch < BATCH_COUNT; ++batch ) {
+        for( int i = 0; i < BATCH_SIZE; ++i ) {
+            producer->send( message.get() );
+        }
+
+        session->commit( &callback );
+    }
+
+    CPPUNIT_ASSERT_EQUAL( BATCH_COUNT, callback.waitForCompletions( BATCH_COUNT ) );
+    CPPUNIT_ASSERT_EQUAL( 0, callback.failures );
+
+    producer->send( message.get() );
+    session->rollback( &callback );
+    CPPUNIT_ASSERT_EQUAL( BATCH_COUNT + 1, callback.waitForCompletions( BATCH_COUNT + 1 ) );
+
+    // With nothing to commit the callback hears about it right away.
+    session->commit( &callback );
+    CPPUNIT_ASSERT_EQUAL( BATCH_COUNT + 2, callback.successes );
+
+    // A transaction holding consumed messages is still committed, just synchronously.
+    MyCMSMessageListener msgListener;
+    std::auto_ptr<cms::MessageConsumer> consumer( session->createConsumer( topic1.get() ) );
+    consumer->setMessageListener( &msgListener );
+
+    ActiveMQConsumer* amqConsumer = dynamic_cast<ActiveMQConsumer*>( consumer.get() );
+    injectTextMessage( "This is a Test 1" , *topic1, *( amqConsumer->getConsumerId() ) );
+    msgListener.asyncWaitForMessages( 1 );
+    CPPUNIT_ASSERT_EQUAL( 1, (int)msgListener.messages.size() );
+
+    session->commit( &callback );
+    CPPUNIT_ASSERT_EQUAL( BATCH_COUNT + 3, callback.successes );
+
+    session->close();
+
+    std::auto_ptr<cms::Session> autoAck( connection->createSession() );
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a CMSException",
+        dynamic_cast<ActiveMQSession*>( autoAck.get() )->commit( &callback ),
+        cms::CMSException );
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQSessionTest::testTransactionCloseWithoutCommit() {
 
@@ -694,6 +928,372 @@ void ActiveMQSessionTest::testCreateTempTopicByName() {
     CPPUNIT_ASSERT(topic->getDestinationType() == cms::Destination::TEMPORARY_TOPIC);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testReceiveBatch() {
+
+    MyAckRecorder ackRecorder;
+
+    CPPUNIT_ASSERT( connection.get() != NULL );
+
+    // Create an Auto Ack Session
+    std::auto_ptr<cms::Session> session( connection->createSession() );
+    std::auto_ptr<cms::Queue> queue( session->createQueue( "TestBatchQueue" ) );
+    std::auto_ptr<ActiveMQConsumer> consumer(
+        dynamic_cast<ActiveMQConsumer*>( session->createConsumer( queue.get() ) ) );
+    CPPUNIT_ASSERT( consumer.get() != NULL );
+
+    CPPUNIT_ASSERT( consumer->receiveBatch( 5, -1 ).empty() );
+    CPPUNIT_ASSERT_THROW( consumer->receiveBatch( 0, -1 ), cms::CMSException );
+
+    dTransport->setOutgoingListener( &ackRecorder );
+
+    for( int i = 1; i <= 8; ++i ) {
+        injectTextMessage( Integer::toString( i ), *queue, *( consumer->getConsumerId() ), -1, -1, i );
+    }
+
+    for( int i = 0; i < 100 && consumer->getMessageAvailableCount() < 8; ++i ) {
+        Thread::sleep( 10 );
+    }
+    CPPUNIT_ASSERT_EQUAL( 8, consumer->getMessageAvailableCount() );
+
+    std::vector<cms::Message*> first = consumer->receiveBatch( 5, 1000 );
+    std::vector<cms::Message*> second = consumer->receiveBatch( 5, 1000 );
+    CPPUNIT_ASSERT( consumer->receiveBatch( 5, -1 ).empty() );
+
+    dTransport->setOutgoingListener( NULL );
+
+    CPPUNIT_ASSERT_EQUAL( (std::size_t) 5, first.size() );
+    CPPUNIT_ASSERT_EQUAL( (std::size_t) 3, second.size() );
+
+    for( std::size_t i = 0; i < first.size(); ++i ) {
+        cms::TextMessage* text = dynamic_cast<cms::TextMessage*>( first[i] );
+        CPPUNIT_ASSERT( text != NULL );
+        CPPUNIT_ASSERT_EQUAL( Integer::toString( (int) i + 1 ), text->getText() );
+        delete first[i];
+    }
+    for( std::size_t i = 0; i < second.size(); ++i ) {
+        cms::TextMessage* text = dynamic_cast<cms::TextMessage*>( second[i] );
+        CPPUNIT_ASSERT( text != NULL );
+        CPPUNIT_ASSERT_EQUAL( Integer::toString( (int) i + 6 ), text->getText() );
+        delete second[i];
+    }
+
+    // Each batch is acknowledged with one range ack.
+    CPPUNIT_ASSERT_EQUAL( (std::size_t) 2, ackRecorder.acks.size() );
+    Pointer<MessageAck> ack = ackRecorder.acks[0];
+    CPPUNIT_ASSERT_EQUAL( (int) ActiveMQConstants::ACK_TYPE_CONSUMED, (int) ack->getAckType() );
+    CPPUNIT_ASSERT_EQUAL( 5, ack->getMessageCount() );
+    CPPUNIT_ASSERT_EQUAL( 1LL, ack->getFirstMessageId()->getProducerSequenceId() );
+    CPPUNIT_ASSERT_EQUAL( 5LL, ack->getLastMessageId()->getProducerSequenceId() );
+    ack = ackRecorder.acks[1];
+    CPPUNIT_ASSERT_EQUAL( 3, ack->getMessageCount() );
+    CPPUNIT_ASSERT_EQUAL( 6LL, ack->getFirstMessageId()->getProducerSequenceId() );
+    CPPUNIT_ASSERT_EQUAL( 8LL, ack->getLastMessageId()->getProducerSequenceId() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testParallelDispatch() {
+
+    MyAckRecorder ackRecorder;
+    MyModuloKeyFunction keyFunction( 3 );
+    MySlowKeyListener msgListener;
+
+    CPPUNIT_ASSERT( connection.get() != NULL );
+
+    // Only auto ack style sessions can acknowledge out of order deliveries.
+    std::auto_ptr<cms::Session> transacted( connection->createSession( cms::Session::SESSION_TRANSACTED ) );
+    CPPUNIT_ASSERT_THROW( dynamic_cast<ActiveMQSession*>( transacted.get() )->setParallelDispatch( 4 ),
+                          cms::IllegalStateException );
+    std::auto_ptr<cms::Session> clientAck( connection->createSession( cms::Session::CLIENT_ACKNOWLEDGE ) );
+    CPPUNIT_ASSERT_THROW( dynamic_cast<ActiveMQSession*>( clientAck.get() )->setParallelDispatch( 4 ),
+                          cms::IllegalStateException );
+
+    // Create an Auto Ack Session
+    std::auto_ptr<cms::Session> session( connection->createSession() );
+    ActiveMQSession* amqSession = dynamic_cast<ActiveMQSession*>( session.get() );
+    CPPUNIT_ASSERT( amqSession != NULL );
+    amqSession->setParallelDispatch( 4, &keyFunction );
+
+    std::auto_ptr<cms::Queue> queue( session->createQueue( "TestParallelQueue" ) );
+    std::auto_ptr<ActiveMQConsumer> consumer(
+        dynamic_cast<ActiveMQConsumer*>( session->createConsumer( queue.get() ) ) );
+    CPPUNIT_ASSERT( consumer.get() != NULL );
+    consumer->setMessageListener( &msgListener );
+
+    CPPUNIT_ASSERT_THROW( amqSession->setParallelDispatch( 2 ), cms::IllegalStateException );
+
+    dTransport->setOutgoingListener( &ackRecorder );
+
+    const int count = 30;
+    for( int i = 1; i <= count; ++i ) {
+        injectTextMessage( Integer::toString( i ), *queue, *( consumer->getConsumerId() ), -1, -1, i );
+    }
+
+    msgListener.asyncWaitForMessages( count );
+
+    long long acked = 0;
+    for( int i = 0; i < 100 && acked < count; ++i ) {
+        synchronized( &ackRecorder.mutex ) {
+            if( !ackRecorder.acks.empty() ) {
+                acked = ackRecorder.acks.back()->getLastMessageId()->getProducerSequenceId();
+            }
+        }
+        Thread::sleep( 10 );
+    }
+
+    dTransport->setOutgoingListener( NULL );
+
+    CPPUNIT_ASSERT_EQUAL( (std::size_t) count, msgListener.messages.size() );
+
+    // Messages with the same key are delivered in the order they were dispatched.
+    int last[3] = { 0, 0, 0 };
+    for( std::size_t i = 0; i < msgListener.messages.size(); ++i ) {
+        cms::TextMessage* text = dynamic_cast<cms::TextMessage*>( msgListener.messages[i].get() );
+        int value = Integer::parseInt( text->getText() );
+        CPPUNIT_ASSERT( value > last[value % 3] );
+        last[value % 3] = value;
+    }
+
+    // Acks follow the dispatch order even though the listeners complete out of order.
+    long long previous = 0;
+    for( std::size_t i = 0; i < ackRecorder.acks.size(); ++i ) {
+        long long sequence = ackRecorder.acks[i]->getLastMessageId()->getProducerSequenceId();
+        CPPUNIT_ASSERT( sequence > previous );
+        previous = sequence;
+    }
+    CPPUNIT_ASSERT_EQUAL( (long long) count, previous );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testParallelDispatchFailure() {
+
+    MyModuloKeyFunction keyFunction( 3 );
+    MyFailOnceKeyListener msgListener( "2" );
+
+    CPPUNIT_ASSERT( connection.get() != NULL );
+    connection->getRedeliveryPolicy()->setInitialRedeliveryDelay( 0 );
+
+    std::auto_ptr<cms::Session> session( connection->createSession() );
+    ActiveMQSession* amqSession = dynamic_cast<ActiveMQSession*>( session.get() );
+    CPPUNIT_ASSERT( amqSession != NULL );
+    amqSession->setParallelDispatch( 3, &keyFunction );
+
+    std::auto_ptr<cms::Queue> queue( session->createQueue( "TestParallelFailureQueue" ) );
+    std::auto_ptr<ActiveMQConsumer> consumer(
+        dynamic_cast<ActiveMQConsumer*>( session->createConsumer( queue.get() ) ) );
+    CPPUNIT_ASSERT( consumer.get() != NULL );
+    consumer->setMessageListener( &msgListener );
+
+    const int count = 9;
+    for( int i = 1; i <= count; ++i ) {
+        injectTextMessage( Integer::toString( i ), *queue, *( consumer->getConsumerId() ), -1, -1, i );
+    }
+
+    msgListener.asyncWaitForMessages( count );
+    consumer->close();
+
+    CPPUNIT_ASSERT_EQUAL( (std::size_t) count, msgListener.messages.size() );
+
+    // The messages queued behind the failed one are held back until it is redelivered.
+    int last[3] = { 0, 0, 0 };
+    for( std::size_t i = 0; i < msgListener.messages.size(); ++i ) {
+        cms::TextMessage* text = dynamic_cast<cms::TextMessage*>( msgListener.messages[i].get() );
+        int value = Integer::parseInt( text->getText() );
+        CPPUNIT_ASSERT( value > last[value % 3] );
+        last[value % 3] = value;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testTopicFanOut() {
+
+    MyFanOutRecorder recorder;
+    MyCMSMessageListener listener1;
+    MyCMSMessageListener listener2;
+
+    connection->setTopicFanOut( true );
+    connection->getPrefetchPolicy()->setTopicPrefetch( 4 );
+    dTransport->setOutgoingListener( &recorder );
+
+    std::auto_ptr<cms::Session> session( connection->createSession() );
+    std::auto_ptr<cms::Topic> topic( session->createTopic( "TestFanOutTopic" ) );
+
+    std::auto_ptr<ActiveMQConsumer> consumer1(
+        dynamic_cast<ActiveMQConsumer*>( session->createConsumer( topic.get() ) ) );
+    std::auto_ptr<ActiveMQConsumer> consumer2(
+        dynamic_cast<ActiveMQConsumer*>( session->createConsumer( topic.get() ) ) );
+    std::auto_ptr<cms::MessageConsumer> filtered( session->createConsumer( topic.get(), "color = 'red'" ) );
+    consumer1->setMessageListener( &listener1 );
+    consumer2->setMessageListener( &listener2 );
+
+    // Only one subscription per topic and selector reaches the broker.
+    TopicFanOut* fanOut = connection->getTopicFanOut();
+    CPPUNIT_ASSERT_EQUAL( 2, fanOut->getSubscriptionCount() );
+    CPPUNIT_ASSERT_EQUAL( 3, fanOut->getMemberCount() );
+    CPPUNIT_ASSERT_EQUAL( (std::size_t) 2, recorder.consumers.size() );
+
+    Pointer<ConsumerId> sharedId = recorder.consumers[0]->getConsumerId();
+    CPPUNIT_ASSERT_EQUAL( -1LL, sharedId->getSessionId() );
+    CPPUNIT_ASSERT( !sharedId->equals( *consumer1->getConsumerId() ) );
+
+    const int count = 4;
+    for( int i = 1; i <= count; ++i ) {
+        injectTextMessage( Integer::toString( i ), *topic, *sharedId, -1, -1, i );
+    }
+
+    listener1.asyncWaitForMessages( count );
+    listener2.asyncWaitForMessages( count );
+    CPPUNIT_ASSERT_EQUAL( (std::size_t) count, listener1.messages.size() );
+    CPPUNIT_ASSERT_EQUAL( (std::size_t) count, listener2.messages.size() );
+
+    // The broker subscription is acked once both consumers have consumed.
+    for( int i = 0; i < 100 && recorder.getAckedCount() < count; ++i ) {
+        Thread::sleep( 10 );
+    }
+    CPPUNIT_ASSERT_EQUAL( count, recorder.getAckedCount() );
+    synchronized( &recorder.mutex ) {
+        for( std::size_t i = 0; i < recorder.acks.size(); ++i ) {
+            CPPUNIT_ASSERT( recorder.acks[i]->getConsumerId()->equals( *sharedId ) );
+        }
+    }
+
+    // Members leave without telling the broker until the last one is gone.
+    consumer2->close();
+    CPPUNIT_ASSERT( recorder.removes.empty() );
+    consumer1->close();
+    CPPUNIT_ASSERT_EQUAL( (std::size_t) 1, recorder.removes.size() );
+    CPPUNIT_ASSERT( recorder.removes[0]->getObjectId()->equals( sharedId.get() ) );
+    CPPUNIT_ASSERT_EQUAL( 1, fanOut->getSubscriptionCount() );
+
+    dTransport->setOutgoingListener( NULL );
+    session->close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testTopicFanOutAcks() {
+
+    MyFanOutRecorder recorder;
+    MyCMSMessageListener listener1;
+    MyCMSMessageListener listener2;
+
+    connection->setTopicFanOut( true );
+    connection->getPrefetchPolicy()->setTopicPrefetch( 10 );
+    dTransport->setOutgoingListener( &recorder );
+
+    // The members don't send delivered acks of their own for less than half the prefetch.
+    std::auto_ptr<cms::Session> session( connection->createSession( cms::Session::CLIENT_ACKNOWLEDGE ) );
+    std::auto_ptr<cms::Topic> topic( session->createTopic( "TestFanOutAckTopic" ) );
+
+    std::auto_ptr<ActiveMQConsumer> consumer1(
+        dynamic_cast<ActiveMQConsumer*>( session->createConsumer( topic.get() ) ) );
+    std::auto_ptr<ActiveMQConsumer> consumer2(
+        dynamic_cast<ActiveMQConsumer*>( session->createConsumer( topic.get() ) ) );
+    consumer1->setMessageListener( &listener1 );
+    consumer2->setMessageListener( &listener2 );
+
+    CPPUNIT_ASSERT_EQUAL( (std::size_t) 1, recorder.consumers.size() );
+    Pointer<ConsumerId> sharedId = recorder.consumers[0]->getConsumerId();
+
+    for( int i = 1; i <= 2; ++i ) {
+        injectTextMessage( Integer::toString( i ), *topic, *sharedId, -1, -1, i );
+    }
+
+    listener1.asyncWaitForMessages( 2 );
+    listener2.asyncWaitForMessages( 2 );
+    CPPUNIT_ASSERT_EQUAL( (std::size_t) 2, listener1.messages.size() );
+
+    Pointer<MessageId> first =
+        dynamic_cast<commands::Message*>( listener1.messages[0].get() )->getMessageId();
+    Pointer<MessageId> second =
+        dynamic_cast<commands::Message*>( listener1.messages[1].get() )->getMessageId();
+
+    TopicFanOut* fanOut = connection->getTopicFanOut();
+
+    // A poison ack is forwarded for the shared subscription the first time only.
+    for( int i = 0; i < 2; ++i ) {
+        Pointer<MessageAck> poison( new MessageAck() );
+        poison->setAckType( ActiveMQConstants::ACK_TYPE_POISON );
+        poison->setConsumerId( i == 0 ? consumer1->getConsumerId() : consumer2->getConsumerId() );
+        poison->setFirstMessageId( first );
+        poison->setLastMessageId( first );
+        poison->setMessageCount( 1 );
+        CPPUNIT_ASSERT( fanOut->acknowledge( poison ) );
+    }
+
+    synchronized( &recorder.mutex ) {
+        CPPUNIT_ASSERT_EQUAL( (std::size_t) 1, recorder.acks.size() );
+        CPPUNIT_ASSERT_EQUAL( (int) ActiveMQConstants::ACK_TYPE_POISON, (int) recorder.acks[0]->getAckType() );
+        CPPUNIT_ASSERT( recorder.acks[0]->getConsumerId()->equals( *sharedId ) );
+        CPPUNIT_ASSERT( recorder.acks[0]->getLastMessageId()->equals( *first ) );
+    }
+
+    // The delivered window is extended once both members got that far.
+    for( int i = 0; i < 2; ++i ) {
+        Pointer<MessageAck> delivered( new MessageAck() );
+        delivered->setAckType( ActiveMQConstants::ACK_TYPE_DELIVERED );
+        delivered->setConsumerId( i == 0 ? consumer1->getConsumerId() : consumer2->getConsumerId() );
+        delivered->setLastMessageId( second );
+        delivered->setMessageCount( 1 );
+        CPPUNIT_ASSERT( fanOut->acknowledge( delivered ) );
+
+        synchronized( &recorder.mutex ) {
+            CPPUNIT_ASSERT_EQUAL( (std::size_t) ( i + 1 ), recorder.acks.size() );
+        }
+    }
+
+    synchronized( &recorder.mutex ) {
+        Pointer<MessageAck> ack = recorder.acks[1];
+        CPPUNIT_ASSERT_EQUAL( (int) ActiveMQConstants::ACK_TYPE_DELIVERED, (int) ack->getAckType() );
+        CPPUNIT_ASSERT( ack->getConsumerId()->equals( *sharedId ) );
+        CPPUNIT_ASSERT_EQUAL( 1, ack->getMessageCount() );
+        CPPUNIT_ASSERT( ack->getLastMessageId()->equals( *second ) );
+    }
+
+    dTransport->setOutgoingListener( NULL );
+    session->close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testProducerTrySend() {
+
+    connection->setProducerWindowSize(1024);
+
+    std::auto_ptr<cms::Session> session(connection->createSession(cms::Session::AUTO_ACKNOWLEDGE));
+    std::auto_ptr<cms::Topic> topic(session->createTopic("TrySend"));
+    std::auto_ptr<cms::MessageProducer> producer(session->createProducer(topic.get()));
+    producer->setDeliveryMode(cms::DeliveryMode::NON_PERSISTENT);
+
+    MyWindowListener listener;
+    producer->setProducerWindowListener(&listener);
+    CPPUNIT_ASSERT(producer->getProducerWindowListener() == &listener);
+
+    std::auto_ptr<cms::TextMessage> message(session->createTextMessage(std::string(2048, 'a')));
+
+    // The first send fills the window, the ones after it must not block.
+    CPPUNIT_ASSERT(producer->trySend(message.get()));
+    CPPUNIT_ASSERT(!producer->trySend(message.get()));
+    CPPUNIT_ASSERT(!producer->trySend(message.get()));
+    CPPUNIT_ASSERT_EQUAL(0, listener.notifications);
+
+    ActiveMQProducer* amqProducer = dynamic_cast<ActiveMQProducer*>(producer.get());
+    CPPUNIT_ASSERT(amqProducer != NULL);
+
+    Pointer<ProducerAck> ack(new ProducerAck());
+    ack->setProducerId(Pointer<ProducerId>(amqProducer->getProducerId()->cloneDataStructure()));
+    ack->setSize(64 * 1024);
+    dTransport->fireCommand(ack);
+
+    CPPUNIT_ASSERT_EQUAL(1, listener.notifications);
+    CPPUNIT_ASSERT(producer->trySend(message.get()));
+
+    // Only a producer that was refused gets told about the window opening.
+    dTransport->fireCommand(ack);
+    CPPUNIT_ASSERT_EQUAL(1, listener.notifications);
+
+    producer->setProducerWindowListener(NULL);
+    session->close();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQSessionTest::setUp() {
 
@@ -725,7 +1325,8 @@ void ActiveMQSessionTest::injectTextMessage(const std::string message,
                                             const cms::Destination& destination,
                                             const commands::ConsumerId& id,
                                             const long long timeStamp,
-                                            const long long timeToLive) {
+                                            const long long timeToLive,
+                                            const long long sequenceId) {
 
     Pointer<ActiveMQTextMessage> msg(new ActiveMQTextMessage());
 
@@ -736,7 +1337,7 @@ void ActiveMQSessionTest::injectTextMessage(const std::string message,
 
     Pointer<MessageId> messageId(new MessageId());
     messageId->setProducerId(producerId);
-    messageId->setProducerSequenceId(2);
+    messageId->setProducerSequenceId(sequenceId);
 
     // Init Message
     msg->setText(message.c_str());
@@ -47,7 +47,14 @@ namespace core{
         CPPUNIT_TEST( testTransactionRollbackOneConsumer );
         CPPUNIT_TEST( testTransactionRollbackTwoConsumer );
         CPPUNIT_TEST( testTransactionCloseWithoutCommit );
+        CPPUNIT_TEST( testTransactionCommitAsync );
         CPPUNIT_TEST( testExpiration );
+        CPPUNIT_TEST( testReceiveBatch );
+        CPPUNIT_TEST( testParallelDispatch );
+        CPPUNIT_TEST( testParallelDispatchFailure );
+        CPPUNIT_TEST( testProducerTrySend );
+        CPPUNIT_TEST( testTopicFanOut );
+        CPPUNIT_TEST( testTopicFanOutAcks );
         CPPUNIT_TEST( testCreateManyConsumersAndSetListeners );
         CPPUNIT_TEST( testCreateTempQueueByName );
         CPPUNIT_TEST( testCreateTempTopicByName );
@@ -88,7 +95,8 @@ namespace core{
                                const cms::Destination& destination,
                                const commands::ConsumerId& id,
                                const long long timeStamp = -1,
-                               const long long timeToLive = -1);
+                               const long long timeToLive = -1,
+                               const long long sequenceId = 2);
 
     public:
 
@@ -103,8 +111,15 @@ namespace core{
         void testTransactionRollbackOneConsumer();
         void testTransactionRollbackTwoConsumer();
         void testTransactionCloseWithoutCommit();
+        void testTransactionCommitAsync();
         void testTransactionCommitAfterConsumerClosed();
         void testExpiration();
+        void testReceiveBatch();
+        void testParallelDispatch();
+        void testParallelDispatchFailure();
+        void testProducerTrySend();
+        void testTopicFanOut();
+        void testTopicFanOutAcks();
         void testCreateTempQueueByName();
         void testCreateTempTopicByName();
 
@@ -0,0 +1,334 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AdaptivePrefetchControllerTest.h"
+
+#include <activemq/core/AdaptivePrefetchController.h>
+#include <activemq/core/ActiveMQConnection.h>
+#include <activemq/core/ActiveMQConnectionFactory.h>
+#include <activemq/core/ActiveMQConstants.h>
+#include <activemq/core/ActiveMQConsumer.h>
+#include <activemq/core/PrefetchPolicy.h>
+#include <activemq/commands/ActiveMQTextMessage.h>
+#include <activemq/commands/ConsumerControl.h>
+#include <activemq/commands/MessageAck.h>
+#include <activemq/commands/MessageDispatch.h>
+#include <activemq/transport/DefaultTransportListener.h>
+#include <activemq/transport/mock/MockTransport.h>
+
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+
+#include <map>
+#include <memory>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace activemq::transport;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::atomic;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    /**
+     * Plays the broker's part of the prefetch contract, a consumer may have at most
+     * its current prefetch window of dispatched but unacknowledged messages.
+     */
+    class SimulatedBroker : public DefaultTransportListener {
+    private:
+
+        Mutex mutex;
+        std::map<std::string, int> windows;
+        std::map<std::string, int> inFlight;
+
+    public:
+
+        SimulatedBroker() : mutex(), windows(), inFlight() {}
+
+        virtual ~SimulatedBroker() {}
+
+        void addConsumer(const ActiveMQConsumer* consumer) {
+            synchronized(&mutex) {
+                windows[consumer->getConsumerId()->toString()] = consumer->getConsumerInfo()->getPrefetchSize();
+            }
+        }
+
+        int getWindow(const ActiveMQConsumer* consumer) {
+            synchronized(&mutex) {
+                return windows[consumer->getConsumerId()->toString()];
+            }
+
+            return 0;
+        }
+
+        bool reserve(const ActiveMQConsumer* consumer) {
+            synchronized(&mutex) {
+                std::string id = consumer->getConsumerId()->toString();
+                if (inFlight[id] < windows[id]) {
+                    inFlight[id]++;
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        virtual void onCommand(const Pointer<Command> command) {
+            synchronized(&mutex) {
+                if (command->isConsumerControl()) {
+                    Pointer<ConsumerControl> control = command.dynamicCast<ConsumerControl>();
+                    windows[control->getConsumerId()->toString()] = control->getPrefetch();
+                } else if (command->isMessageAck()) {
+                    Pointer<MessageAck> ack = command.dynamicCast<MessageAck>();
+                    if (ack->getAckType() == ActiveMQConstants::ACK_TYPE_CONSUMED) {
+                        inFlight[ack->getConsumerId()->toString()] -= ack->getMessageCount();
+                    }
+                }
+            }
+        }
+    };
+
+    class ProcessingListener : public cms::MessageListener {
+    private:
+
+        long long processingTime;
+
+    public:
+
+        AtomicInteger received;
+
+        ProcessingListener(long long processingTime) : processingTime(processingTime), received() {}
+
+        virtual ~ProcessingListener() {}
+
+        virtual void onMessage(const cms::Message* message AMQCPP_UNUSED) {
+            if (processingTime > 0) {
+                Thread::sleep(processingTime);
+            }
+            received.incrementAndGet();
+        }
+    };
+
+    void dispatchTo(transport::mock::MockTransport* transport, const ActiveMQConsumer* consumer,
+                    const cms::Destination* destination, const Pointer<ProducerId>& producerId,
+                    long long sequenceId) {
+
+        Pointer<MessageId> messageId(new MessageId());
+        messageId->setProducerId(producerId);
+        messageId->setProducerSequenceId(sequenceId);
+
+        Pointer<ActiveMQTextMessage> message(new ActiveMQTextMessage());
+        message->setText("adaptive");
+        message->setCMSDestination(destination);
+        message->setMessageId(messageId);
+
+        Pointer<MessageDispatch> dispatch(new MessageDispatch());
+        dispatch->setMessage(message);
+        dispatch->setConsumerId(consumer->getConsumerId());
+        transport->fireCommand(dispatch);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+AdaptivePrefetchControllerTest::AdaptivePrefetchControllerTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+AdaptivePrefetchControllerTest::~AdaptivePrefetchControllerTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AdaptivePrefetchControllerTest::testBounds() {
+
+    AdaptivePrefetchController controller(0, 0, 0);
+    CPPUNIT_ASSERT_EQUAL(1, controller.getMinimumPrefetch());
+    CPPUNIT_ASSERT_EQUAL(1, controller.getMaximumPrefetch());
+    CPPUNIT_ASSERT_EQUAL(1LL, controller.getTargetLatency());
+    CPPUNIT_ASSERT_EQUAL(1, controller.getPrefetchSize());
+
+    AdaptivePrefetchController bounded(10, 20, 100);
+    CPPUNIT_ASSERT_EQUAL(10, bounded.getPrefetchSize());
+
+    // Way more than the maximum can be consumed within the target latency.
+    long long now = 0;
+    for (int i = 0; i < 10000; ++i) {
+        bounded.messageConsumed(now++, 0);
+    }
+    CPPUNIT_ASSERT_EQUAL(20, bounded.getPrefetchSize());
+
+    // Nothing gets consumed within the target latency.
+    for (int i = 0; i < 10; ++i) {
+        now += 10000;
+        bounded.messageConsumed(now, 5);
+    }
+    CPPUNIT_ASSERT_EQUAL(10, bounded.getPrefetchSize());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AdaptivePrefetchControllerTest::testFastConsumerGrows() {
+
+    AdaptivePrefetchController controller(1, 1000, 50);
+    CPPUNIT_ASSERT_EQUAL(1, controller.getPrefetchSize());
+
+    // Every millisecond the broker refills the window and the consumer drains it.
+    int changes = 0;
+    for (long long now = 0; now < 1000; ++now) {
+        int window = controller.getPrefetchSize();
+        for (int backlog = window - 1; backlog >= 0; --backlog) {
+            if (controller.messageConsumed(now, backlog)) {
+                changes++;
+            }
+        }
+    }
+
+    CPPUNIT_ASSERT_EQUAL(1000, controller.getPrefetchSize());
+    CPPUNIT_ASSERT(changes > 0);
+    CPPUNIT_ASSERT(controller.getConsumeRate() > 1.0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AdaptivePrefetchControllerTest::testSlowConsumerStaysSmall() {
+
+    AdaptivePrefetchController controller(1, 1000, 50);
+
+    // One message every 10ms with the broker keeping the window full, within 50ms
+    // the consumer only gets through about five messages.
+    for (long long now = 0; now < 2000; now += 10) {
+        controller.messageConsumed(now, controller.getPrefetchSize() - 1);
+    }
+
+    CPPUNIT_ASSERT(controller.getPrefetchSize() >= 4);
+    CPPUNIT_ASSERT(controller.getPrefetchSize() <= 6);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AdaptivePrefetchControllerTest::testShrinksWhenConsumerSlowsDown() {
+
+    AdaptivePrefetchController controller(1, 500, 50);
+
+    long long now = 0;
+    for (; now < 500; ++now) {
+        int window = controller.getPrefetchSize();
+        for (int backlog = window - 1; backlog >= 0; --backlog) {
+            controller.messageConsumed(now, backlog);
+        }
+    }
+    CPPUNIT_ASSERT_EQUAL(500, controller.getPrefetchSize());
+
+    bool shrunk = false;
+    for (long long end = now + 2000; now < end; now += 25) {
+        if (controller.messageConsumed(now, controller.getPrefetchSize() - 1)) {
+            shrunk = true;
+        }
+    }
+
+    CPPUNIT_ASSERT(shrunk);
+    CPPUNIT_ASSERT(controller.getPrefetchSize() <= 3);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AdaptivePrefetchControllerTest::testIdleConsumerDoesNotGrow() {
+
+    AdaptivePrefetchController controller(4, 1000, 50);
+
+    // A trickle of messages leaves the buffer empty every time, but the consumer
+    // never gets through a whole window so there is no reason to grow it.
+    for (long long now = 0; now < 10000; now += 200) {
+        CPPUNIT_ASSERT(!controller.messageConsumed(now, 0));
+    }
+
+    CPPUNIT_ASSERT_EQUAL(4, controller.getPrefetchSize());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AdaptivePrefetchControllerTest::testSlowAndFastConsumersOverMockTransport() {
+
+    ActiveMQConnectionFactory factory(
+        "mock://127.0.0.1:12345?wireFormat=openwire"
+        "&cms.prefetchPolicy.adaptive=true&cms.prefetchPolicy.adaptiveTargetLatency=50");
+
+    std::auto_ptr<ActiveMQConnection> connection(
+        dynamic_cast<ActiveMQConnection*>(factory.createConnection()));
+    CPPUNIT_ASSERT(connection->getPrefetchPolicy()->isAdaptive());
+    CPPUNIT_ASSERT_EQUAL(50LL, connection->getPrefetchPolicy()->getAdaptiveTargetLatency());
+
+    transport::mock::MockTransport* transport = dynamic_cast<transport::mock::MockTransport*>(
+        connection->getTransport().narrow(typeid(transport::mock::MockTransport)));
+    CPPUNIT_ASSERT(transport != NULL);
+
+    SimulatedBroker broker;
+    transport->setOutgoingListener(&broker);
+
+    ProcessingListener slowListener(10);
+    ProcessingListener fastListener(0);
+
+    std::auto_ptr<cms::Session> slowSession(connection->createSession());
+    std::auto_ptr<cms::Session> fastSession(connection->createSession());
+    std::auto_ptr<cms::Queue> queue(slowSession->createQueue("AdaptivePrefetch"));
+    std::auto_ptr<cms::MessageConsumer> slowConsumer(slowSession->createConsumer(queue.get()));
+    std::auto_ptr<cms::MessageConsumer> fastConsumer(fastSession->createConsumer(queue.get()));
+    slowConsumer->setMessageListener(&slowListener);
+    fastConsumer->setMessageListener(&fastListener);
+
+    const ActiveMQConsumer* slow = dynamic_cast<ActiveMQConsumer*>(slowConsumer.get());
+    const ActiveMQConsumer* fast = dynamic_cast<ActiveMQConsumer*>(fastConsumer.get());
+    CPPUNIT_ASSERT(slow != NULL && fast != NULL);
+
+    // Both start out with the smallest window rather than the configured prefetch.
+    broker.addConsumer(slow);
+    broker.addConsumer(fast);
+    CPPUNIT_ASSERT_EQUAL(1, broker.getWindow(slow));
+    CPPUNIT_ASSERT_EQUAL(1, broker.getWindow(fast));
+
+    connection->start();
+
+    Pointer<ProducerId> producerId(new ProducerId());
+    producerId->setConnectionId(connection->getConnectionInfo().getConnectionId()->getValue());
+    producerId->setSessionId(1);
+    producerId->setValue(1);
+
+    long long sequenceId = 1;
+    long long end = System::currentTimeMillis() + 1500;
+    while (System::currentTimeMillis() < end) {
+        while (broker.reserve(slow)) {
+            dispatchTo(transport, slow, queue.get(), producerId, sequenceId++);
+        }
+        while (broker.reserve(fast)) {
+            dispatchTo(transport, fast, queue.get(), producerId, sequenceId++);
+        }
+        Thread::sleep(1);
+    }
+
+    int slowWindow = broker.getWindow(slow);
+    int fastWindow = broker.getWindow(fast);
+
+    transport->setOutgoingListener(NULL);
+    connection->close();
+
+    CPPUNIT_ASSERT(slowListener.received.get() > 0);
+    CPPUNIT_ASSERT(fastListener.received.get() > slowListener.received.get());
+    CPPUNIT_ASSERT_MESSAGE("slow consumer window should stay small", slowWindow <= 10);
+    CPPUNIT_ASSERT_MESSAGE("fast consumer window should grow", fastWindow >= 100);
+    CPPUNIT_ASSERT(fastWindow <= connection->getPrefetchPolicy()->getQueuePrefetch());
+}
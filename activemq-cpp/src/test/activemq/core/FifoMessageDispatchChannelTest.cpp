@@ -209,6 +209,41 @@ void FifoMessageDispatchChannelTest::testDequeue() {
     CPPUNIT_ASSERT( channel.isEmpty() == true );
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void FifoMessageDispatchChannelTest::testDequeueBatch() {
+
+    FifoMessageDispatchChannel channel;
+
+    Pointer<MessageDispatch> dispatch1( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch2( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch3( new MessageDispatch() );
+
+    CPPUNIT_ASSERT( channel.dequeueBatch( 2, 0 ).empty() );
+
+    channel.enqueue( dispatch1 );
+    channel.enqueue( dispatch2 );
+    channel.enqueue( dispatch3 );
+
+    CPPUNIT_ASSERT( channel.dequeueBatch( 2, 0 ).empty() );
+    channel.start();
+
+    std::vector< Pointer<MessageDispatch> > batch = channel.dequeueBatch( 2, 0 );
+    CPPUNIT_ASSERT( batch.size() == 2 );
+    CPPUNIT_ASSERT( batch[0] == dispatch1 );
+    CPPUNIT_ASSERT( batch[1] == dispatch2 );
+
+    batch = channel.dequeueBatch( 2, 1000 );
+    CPPUNIT_ASSERT( batch.size() == 1 );
+    CPPUNIT_ASSERT( batch[0] == dispatch3 );
+
+    long long startTime = System::currentTimeMillis();
+    CPPUNIT_ASSERT( channel.dequeueBatch( 2, 100 ).empty() );
+    CPPUNIT_ASSERT( System::currentTimeMillis() - startTime >= 90 );
+
+    channel.close();
+    CPPUNIT_ASSERT( channel.dequeueBatch( 2, -1 ).empty() );
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void FifoMessageDispatchChannelTest::testRemoveAll() {
 
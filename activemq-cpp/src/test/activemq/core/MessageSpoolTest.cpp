@@ -0,0 +1,364 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MessageSpoolTest.h"
+
+#include <activemq/core/MessageSpool.h>
+#include <activemq/commands/ActiveMQQueue.h>
+#include <activemq/commands/ActiveMQTextMessage.h>
+#include <activemq/commands/MessageId.h>
+#include <activemq/commands/ProducerId.h>
+
+#include <decaf/internal/io/FileSystem.h>
+#include <decaf/internal/nio/MappedFile.h>
+#include <decaf/io/IOException.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/exceptions/IllegalStateException.h>
+#include <decaf/util/UUID.h>
+
+#include <vector>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+using namespace decaf::internal::io;
+using namespace decaf::internal::nio;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    Pointer<Message> createMessage(int sequence, const std::string& text = "") {
+
+        Pointer<ProducerId> producerId(new ProducerId());
+        producerId->setConnectionId("MessageSpoolTest");
+        producerId->setSessionId(1);
+        producerId->setValue(1);
+
+        Pointer<MessageId> id(new MessageId());
+        id->setProducerId(producerId);
+        id->setProducerSequenceId(sequence);
+
+        Pointer<ActiveMQTextMessage> message(new ActiveMQTextMessage());
+        message->setMessageId(id);
+        message->setProducerId(producerId);
+        message->setDestination(Pointer<ActiveMQDestination>(new ActiveMQQueue("MessageSpoolTest")));
+        message->setText(text.empty() ? std::string("Message #") + Integer::toString(sequence) : text);
+        message->setIntProperty("sequence", sequence);
+
+        return message;
+    }
+
+    int sequenceOf(const Pointer<Message>& message) {
+        CPPUNIT_ASSERT(message != NULL);
+        return (int) message->getMessageId()->getProducerSequenceId();
+    }
+
+    std::string onlySegment(const std::string& directory) {
+        std::vector<std::string> names = FileSystem::list(directory);
+        CPPUNIT_ASSERT_EQUAL((std::size_t) 1, names.size());
+        return directory + "/" + names[0];
+    }
+
+    int readInt(const unsigned char* address) {
+        return (int) (((unsigned int) address[0] << 24) | ((unsigned int) address[1] << 16) |
+                      ((unsigned int) address[2] << 8) | (unsigned int) address[3]);
+    }
+
+    /**
+     * Walks the records of a segment file and returns the offset of the last one.
+     */
+    int lastRecordOffset(const unsigned char* address, long long size) {
+        int offset = 16;
+        int last = -1;
+        while (offset + 8 <= size) {
+            int length = readInt(address + offset);
+            if (length <= 0) {
+                break;
+            }
+            last = offset;
+            offset += 8 + length;
+        }
+        return last;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MessageSpoolTest::MessageSpoolTest() : directory() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MessageSpoolTest::~MessageSpoolTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpoolTest::setUp() {
+    this->directory = std::string("MessageSpoolTest-") + UUID::randomUUID().toString();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpoolTest::tearDown() {
+
+    if (FileSystem::exists(this->directory)) {
+        std::vector<std::string> names = FileSystem::list(this->directory);
+        for (std::size_t i = 0; i < names.size(); ++i) {
+            FileSystem::remove(this->directory + "/" + names[i]);
+        }
+        FileSystem::removeDirectory(this->directory);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpoolTest::testAppendAndPeek() {
+
+    MessageSpool spool(this->directory);
+    spool.open();
+
+    CPPUNIT_ASSERT(spool.isOpen());
+    CPPUNIT_ASSERT(spool.isEmpty());
+    CPPUNIT_ASSERT(spool.peek() == NULL);
+
+    for (int i = 0; i < 3; ++i) {
+        spool.append(createMessage(i));
+    }
+
+    CPPUNIT_ASSERT_EQUAL(3, spool.size());
+
+    Pointer<Message> first = spool.peek();
+    CPPUNIT_ASSERT_EQUAL(0, sequenceOf(first));
+    CPPUNIT_ASSERT(first == spool.peek());
+
+    Pointer<ActiveMQTextMessage> text = first.dynamicCast<ActiveMQTextMessage>();
+    CPPUNIT_ASSERT_EQUAL(std::string("Message #0"), text->getText());
+    CPPUNIT_ASSERT_EQUAL(0, text->getIntProperty("sequence"));
+    CPPUNIT_ASSERT_EQUAL(std::string("MessageSpoolTest"), text->getDestination()->getPhysicalName());
+
+    for (int i = 0; i < 3; ++i) {
+        CPPUNIT_ASSERT_EQUAL(i, sequenceOf(spool.peek()));
+        spool.remove();
+    }
+
+    CPPUNIT_ASSERT(spool.isEmpty());
+    CPPUNIT_ASSERT(spool.peek() == NULL);
+    CPPUNIT_ASSERT_NO_THROW(spool.remove());
+
+    spool.close();
+    CPPUNIT_ASSERT(!spool.isOpen());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpoolTest::testNotOpen() {
+
+    MessageSpool spool(this->directory);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalStateException",
+        spool.append(createMessage(1)),
+        IllegalStateException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalStateException",
+        spool.peek(),
+        IllegalStateException);
+
+    CPPUNIT_ASSERT(!FileSystem::exists(this->directory));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpoolTest::testSegmentRoll() {
+
+    const int COUNT = 200;
+
+    MessageSpool spool(this->directory, 4096);
+    spool.open();
+
+    for (int i = 0; i < COUNT; ++i) {
+        spool.append(createMessage(i));
+    }
+
+    CPPUNIT_ASSERT_EQUAL(COUNT, spool.size());
+    CPPUNIT_ASSERT(FileSystem::list(this->directory).size() > 1);
+
+    for (int i = 0; i < COUNT; ++i) {
+        CPPUNIT_ASSERT_EQUAL(i, sequenceOf(spool.peek()));
+        spool.remove();
+    }
+
+    // Replayed segments are deleted, only the one being written remains.
+    CPPUNIT_ASSERT(spool.isEmpty());
+    CPPUNIT_ASSERT_EQUAL((std::size_t) 1, FileSystem::list(this->directory).size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpoolTest::testMessageLargerThanSegment() {
+
+    MessageSpool spool(this->directory, 1024);
+    spool.open();
+
+    spool.append(createMessage(1));
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        spool.append(createMessage(2, std::string(4096, 'x'))),
+        IOException);
+
+    // The spool is still usable afterwards.
+    spool.append(createMessage(3));
+    CPPUNIT_ASSERT_EQUAL(2, spool.size());
+    CPPUNIT_ASSERT_EQUAL(1, sequenceOf(spool.peek()));
+    spool.remove();
+    CPPUNIT_ASSERT_EQUAL(3, sequenceOf(spool.peek()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpoolTest::testRecoverAfterClose() {
+
+    {
+        MessageSpool spool(this->directory, 4096);
+        spool.open();
+
+        for (int i = 0; i < 60; ++i) {
+            spool.append(createMessage(i));
+        }
+
+        for (int i = 0; i < 25; ++i) {
+            spool.remove();
+        }
+
+        spool.close();
+    }
+
+    MessageSpool spool(this->directory, 4096);
+    spool.open();
+
+    CPPUNIT_ASSERT_EQUAL(35, spool.size());
+
+    // New messages go behind the recovered ones.
+    spool.append(createMessage(60));
+
+    for (int i = 25; i <= 60; ++i) {
+        CPPUNIT_ASSERT_EQUAL(i, sequenceOf(spool.peek()));
+        spool.remove();
+    }
+
+    CPPUNIT_ASSERT(spool.isEmpty());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpoolTest::testRecoverTornRecord() {
+
+    {
+        MessageSpool spool(this->directory);
+        spool.open();
+        for (int i = 0; i < 5; ++i) {
+            spool.append(createMessage(i));
+        }
+        spool.close();
+    }
+
+    // Simulate a crash in the middle of an append, the length made it to the file
+    // but the payload and checksum did not.
+    {
+        MappedFile segment(onlySegment(this->directory), 0);
+        unsigned char* address = segment.getAddress();
+        int last = lastRecordOffset(address, segment.getSize());
+        CPPUNIT_ASSERT(last > 0);
+
+        int end = last + 8 + readInt(address + last);
+        address[end] = 0;
+        address[end + 1] = 0;
+        address[end + 2] = 1;
+        address[end + 3] = 0;
+    }
+
+    MessageSpool spool(this->directory);
+    spool.open();
+
+    CPPUNIT_ASSERT_EQUAL(5, spool.size());
+
+    spool.append(createMessage(5));
+    CPPUNIT_ASSERT_EQUAL(6, spool.size());
+
+    for (int i = 0; i < 6; ++i) {
+        CPPUNIT_ASSERT_EQUAL(i, sequenceOf(spool.peek()));
+        spool.remove();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpoolTest::testRecoverCorruptRecord() {
+
+    {
+        MessageSpool spool(this->directory);
+        spool.open();
+        for (int i = 0; i < 5; ++i) {
+            spool.append(createMessage(i));
+        }
+        spool.remove();
+        spool.close();
+    }
+
+    // Damage the payload of the last record, its checksum no longer matches.
+    {
+        MappedFile segment(onlySegment(this->directory), 0);
+        unsigned char* address = segment.getAddress();
+        int last = lastRecordOffset(address, segment.getSize());
+        CPPUNIT_ASSERT(last > 0);
+        address[last + 8 + 4] ^= 0xFF;
+    }
+
+    MessageSpool spool(this->directory);
+    spool.open();
+
+    // One was replayed before the crash and the damaged one is dropped.
+    CPPUNIT_ASSERT_EQUAL(3, spool.size());
+
+    for (int i = 1; i < 4; ++i) {
+        CPPUNIT_ASSERT_EQUAL(i, sequenceOf(spool.peek()));
+        spool.remove();
+    }
+
+    CPPUNIT_ASSERT(spool.peek() == NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MessageSpoolTest::testRecoverDiscardsForeignFiles() {
+
+    FileSystem::makeDirectories(this->directory);
+
+    // A segment that never got its header and an unrelated file.
+    {
+        MappedFile junk(this->directory + "/spool-7.log", 1024);
+        MappedFile other(this->directory + "/notes.txt", 16);
+        other.getAddress()[0] = 'x';
+    }
+
+    MessageSpool spool(this->directory);
+    spool.open();
+
+    CPPUNIT_ASSERT(spool.isEmpty());
+    CPPUNIT_ASSERT(!FileSystem::exists(this->directory + "/spool-7.log"));
+    CPPUNIT_ASSERT(FileSystem::exists(this->directory + "/notes.txt"));
+
+    spool.append(createMessage(1));
+    CPPUNIT_ASSERT_EQUAL(1, sequenceOf(spool.peek()));
+}
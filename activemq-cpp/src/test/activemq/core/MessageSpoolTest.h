@@ -0,0 +1,67 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CORE_MESSAGESPOOLTEST_H_
+#define _ACTIVEMQ_CORE_MESSAGESPOOLTEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <string>
+
+namespace activemq {
+namespace core {
+
+    class MessageSpoolTest : public CppUnit::TestFixture {
+
+        CPPUNIT_TEST_SUITE( MessageSpoolTest );
+        CPPUNIT_TEST( testAppendAndPeek );
+        CPPUNIT_TEST( testNotOpen );
+        CPPUNIT_TEST( testSegmentRoll );
+        CPPUNIT_TEST( testMessageLargerThanSegment );
+        CPPUNIT_TEST( testRecoverAfterClose );
+        CPPUNIT_TEST( testRecoverTornRecord );
+        CPPUNIT_TEST( testRecoverCorruptRecord );
+        CPPUNIT_TEST( testRecoverDiscardsForeignFiles );
+        CPPUNIT_TEST_SUITE_END();
+
+    private:
+
+        std::string directory;
+
+    public:
+
+        MessageSpoolTest();
+        virtual ~MessageSpoolTest();
+
+        virtual void setUp();
+        virtual void tearDown();
+
+        void testAppendAndPeek();
+        void testNotOpen();
+        void testSegmentRoll();
+        void testMessageLargerThanSegment();
+        void testRecoverAfterClose();
+        void testRecoverTornRecord();
+        void testRecoverCorruptRecord();
+        void testRecoverDiscardsForeignFiles();
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_CORE_MESSAGESPOOLTEST_H_ */
@@ -0,0 +1,163 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ParallelDispatcherTest.h"
+
+#include <activemq/core/ParallelDispatcher.h>
+#include <activemq/core/DispatchKeyFunction.h>
+#include <activemq/commands/ActiveMQTextMessage.h>
+
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/util/concurrent/Mutex.h>
+
+#include <map>
+#include <vector>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class TextKeyFunction : public DispatchKeyFunction {
+    public:
+
+        virtual ~TextKeyFunction() {}
+
+        virtual std::string getKey(const cms::Message* message) {
+            const cms::TextMessage* text = dynamic_cast<const cms::TextMessage*>(message);
+            return text != NULL ? text->getText() : std::string();
+        }
+    };
+
+    class Recorder {
+    public:
+
+        Mutex mutex;
+        std::map<std::string, std::vector<int> > sequences;
+
+        Recorder() : mutex(), sequences() {}
+    };
+
+    class RecordingTask : public Runnable {
+    private:
+
+        Recorder* recorder;
+        std::string group;
+        int sequence;
+
+    private:
+
+        RecordingTask(const RecordingTask&);
+        RecordingTask& operator=(const RecordingTask&);
+
+    public:
+
+        RecordingTask(Recorder* recorder, const std::string& group, int sequence) :
+            Runnable(), recorder(recorder), group(group), sequence(sequence) {}
+        virtual ~RecordingTask() {}
+
+        virtual void run() {
+            // Give the other workers a chance to interleave with this one.
+            if (sequence % 7 == 0) {
+                Thread::sleep(1);
+            }
+
+            synchronized(&recorder->mutex) {
+                recorder->sequences[group].push_back(sequence);
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ParallelDispatcherTest::ParallelDispatcherTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ParallelDispatcherTest::~ParallelDispatcherTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ParallelDispatcherTest::testConstructor() {
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        ParallelDispatcher(0, NULL),
+        IllegalArgumentException);
+
+    TextKeyFunction keyFunction;
+    ParallelDispatcher dispatcher(3, &keyFunction);
+    CPPUNIT_ASSERT_EQUAL(3, dispatcher.getWorkerCount());
+    CPPUNIT_ASSERT(dispatcher.getKeyFunction() == &keyFunction);
+    dispatcher.close(1000);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ParallelDispatcherTest::testGetKey() {
+
+    ActiveMQTextMessage message;
+    message.setText("text");
+
+    ParallelDispatcher byGroup(1, NULL);
+    CPPUNIT_ASSERT_EQUAL(std::string(), byGroup.getKey(&message));
+    message.setGroupID("group");
+    CPPUNIT_ASSERT_EQUAL(std::string("group"), byGroup.getKey(&message));
+    CPPUNIT_ASSERT_EQUAL(std::string("group"), ParallelDispatcher::getGroupId(&message));
+
+    TextKeyFunction keyFunction;
+    ParallelDispatcher byFunction(1, &keyFunction);
+    CPPUNIT_ASSERT_EQUAL(std::string("text"), byFunction.getKey(&message));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ParallelDispatcherTest::testPerKeyOrdering() {
+
+    const int groups = 6;
+    const int count = 50;
+
+    Recorder recorder;
+    ParallelDispatcher dispatcher(4, NULL);
+
+    ActiveMQTextMessage message;
+    for (int i = 0; i < count; ++i) {
+        for (int group = 0; group < groups; ++group) {
+            std::string groupId = "group-" + Integer::toString(group);
+            message.setGroupID(groupId);
+            dispatcher.execute(&message, new RecordingTask(&recorder, groupId, i));
+        }
+    }
+
+    dispatcher.close(5000);
+
+    CPPUNIT_ASSERT_EQUAL(groups, (int) recorder.sequences.size());
+    std::map<std::string, std::vector<int> >::const_iterator iter = recorder.sequences.begin();
+    for (; iter != recorder.sequences.end(); ++iter) {
+        CPPUNIT_ASSERT_EQUAL(count, (int) iter->second.size());
+        for (int i = 0; i < count; ++i) {
+            CPPUNIT_ASSERT_EQUAL_MESSAGE(iter->first, i, iter->second[i]);
+        }
+    }
+}
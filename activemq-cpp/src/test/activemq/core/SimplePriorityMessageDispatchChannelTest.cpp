@@ -251,6 +251,48 @@ void SimplePriorityMessageDispatchChannelTest::testDequeue() {
     CPPUNIT_ASSERT( channel.isEmpty() == true );
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void SimplePriorityMessageDispatchChannelTest::testDequeueBatch() {
+
+    SimplePriorityMessageDispatchChannel channel;
+
+    Pointer<MessageDispatch> dispatch1( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch2( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch3( new MessageDispatch() );
+
+    Pointer<Message> message1( new Message() );
+    Pointer<Message> message2( new Message() );
+    Pointer<Message> message3( new Message() );
+
+    message1->setPriority( 2 );
+    message2->setPriority( 3 );
+    message3->setPriority( 1 );
+
+    dispatch1->setMessage( message1 );
+    dispatch2->setMessage( message2 );
+    dispatch3->setMessage( message3 );
+
+    channel.enqueue( dispatch1 );
+    channel.enqueue( dispatch2 );
+    channel.enqueue( dispatch3 );
+
+    CPPUNIT_ASSERT( channel.dequeueBatch( 2, 0 ).empty() );
+    channel.start();
+
+    // Batches are taken in priority order.
+    std::vector< Pointer<MessageDispatch> > batch = channel.dequeueBatch( 2, 0 );
+    CPPUNIT_ASSERT( batch.size() == 2 );
+    CPPUNIT_ASSERT( batch[0] == dispatch2 );
+    CPPUNIT_ASSERT( batch[1] == dispatch1 );
+
+    batch = channel.dequeueBatch( 5, 1000 );
+    CPPUNIT_ASSERT( batch.size() == 1 );
+    CPPUNIT_ASSERT( batch[0] == dispatch3 );
+
+    CPPUNIT_ASSERT( channel.dequeueBatch( 5, 0 ).empty() );
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void SimplePriorityMessageDispatchChannelTest::testRemoveAll() {
 
@@ -0,0 +1,472 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MockStompBrokerService.h"
+
+#include <activemq/exceptions/ActiveMQException.h>
+#include <activemq/wireformat/stomp/StompCommandConstants.h>
+
+#include <decaf/net/ServerSocket.h>
+#include <decaf/net/Socket.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/Long.h>
+#include <decaf/lang/Math.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/util/StringTokenizer.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/Lock.h>
+#include <decaf/io/DataInputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/io/IOException.h>
+
+#include <list>
+#include <memory>
+
+using namespace activemq;
+using namespace activemq::mock;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::stomp;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::io;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::net;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace mock {
+
+    class MockStompBrokerServiceImpl : public lang::Thread {
+    private:
+
+        MockStompBrokerServiceImpl(const MockStompBrokerServiceImpl&);
+        MockStompBrokerServiceImpl& operator= (const MockStompBrokerServiceImpl&);
+
+    private:
+
+        /**
+         * Writes a heart-beat on the current connection every interval milliseconds.
+         */
+        class HeartBeatSender : public lang::Thread {
+        private:
+
+            HeartBeatSender(const HeartBeatSender&);
+            HeartBeatSender& operator= (const HeartBeatSender&);
+
+        private:
+
+            MockStompBrokerServiceImpl* parent;
+            long long interval;
+            CountDownLatch done;
+
+        public:
+
+            HeartBeatSender(MockStompBrokerServiceImpl* parent, long long interval) :
+                Thread(), parent(parent), interval(interval), done(1) {
+            }
+
+            virtual ~HeartBeatSender() {}
+
+            void shutdown() {
+                done.countDown();
+                join();
+            }
+
+            virtual void run() {
+                try {
+                    while (!done.await(interval)) {
+                        parent->writeHeartBeat();
+                    }
+                } catch (...) {
+                }
+            }
+        };
+
+    public:
+
+        volatile bool done;
+        std::string supportedVersions;
+        long long heartBeatOut;
+        long long heartBeatIn;
+        bool sendHeartBeats;
+
+        CountDownLatch started;
+        Pointer<ServerSocket> server;
+
+        mutable Mutex connectionLock;
+        Pointer<Socket> socket;
+        Pointer<DataOutputStream> output;
+        bool stomp11;
+
+        mutable Mutex framesLock;
+        std::list< Pointer<StompFrame> > frames;
+        std::string negotiatedVersion;
+        int heartBeatsReceived;
+
+    public:
+
+        MockStompBrokerServiceImpl() : Thread(), done(false), supportedVersions("1.0,1.1,1.2"),
+                                       heartBeatOut(0), heartBeatIn(0), sendHeartBeats(true),
+                                       started(1), server(), connectionLock(), socket(), output(),
+                                       stomp11(false), framesLock(), frames(), negotiatedVersion(),
+                                       heartBeatsReceived(0) {
+        }
+
+        virtual ~MockStompBrokerServiceImpl() {
+            shutdown();
+        }
+
+        void shutdown() {
+            try {
+                done = true;
+                if (server != NULL) {
+                    server->close();
+                }
+
+                synchronized(&connectionLock) {
+                    if (socket != NULL) {
+                        socket->close();
+                    }
+                }
+            } catch (...) {}
+        }
+
+        void writeFrame(const StompFrame& frame) {
+            synchronized(&connectionLock) {
+                if (output == NULL) {
+                    throw IOException(__FILE__, __LINE__, "No client is connected.");
+                }
+
+                frame.toStream(output.get(), stomp11);
+            }
+        }
+
+        void writeHeartBeat() {
+            synchronized(&connectionLock) {
+                if (output != NULL) {
+                    output->write('\n');
+                    output->flush();
+                }
+            }
+        }
+
+        void record(const Pointer<StompFrame>& frame) {
+            synchronized(&framesLock) {
+                if (frame->isHeartBeat()) {
+                    heartBeatsReceived++;
+                } else {
+                    frames.push_back(frame);
+                }
+                framesLock.notifyAll();
+            }
+        }
+
+        Pointer<StompFrame> waitForFrame(const std::string& command, long long timeout) {
+            long long deadline = System::currentTimeMillis() + timeout;
+
+            synchronized(&framesLock) {
+                while (true) {
+                    std::list< Pointer<StompFrame> >::iterator iter = frames.begin();
+                    for (; iter != frames.end(); ++iter) {
+                        if ((*iter)->getCommand() == command) {
+                            Pointer<StompFrame> result = *iter;
+                            frames.erase(iter);
+                            return result;
+                        }
+                    }
+
+                    long long remaining = deadline - System::currentTimeMillis();
+                    if (remaining <= 0) {
+                        break;
+                    }
+
+                    framesLock.wait(remaining);
+                }
+            }
+
+            return Pointer<StompFrame>();
+        }
+
+        /**
+         * Picks the highest version both sides accept, clients that don't list any
+         * versions only speak 1.0.
+         */
+        std::string negotiate(const StompFrame& connect) const {
+            std::string result = StompCommandConstants::VERSION_1_0;
+
+            if (!connect.hasProperty(StompCommandConstants::HEADER_ACCEPT_VERSION)) {
+                return result;
+            }
+
+            StringTokenizer tokenizer(connect.getProperty(StompCommandConstants::HEADER_ACCEPT_VERSION), ",");
+            while (tokenizer.hasMoreTokens()) {
+                std::string version = tokenizer.nextToken();
+                if (supportedVersions.find(version) != std::string::npos && version > result) {
+                    result = version;
+                }
+            }
+
+            return result;
+        }
+
+        /**
+         * Answers the CONNECT frame and returns the interval the broker writes heart-beats at.
+         */
+        long long onConnect(const StompFrame& connect) {
+
+            std::string version = negotiate(connect);
+
+            StompFrame connected;
+            connected.setCommand(StompCommandConstants::CONNECTED);
+            connected.setProperty(StompCommandConstants::HEADER_SESSIONID, "mock-stomp-session");
+
+            long long writeInterval = 0;
+            if (version != StompCommandConstants::VERSION_1_0) {
+                connected.setProperty(StompCommandConstants::HEADER_VERSION, version);
+                connected.setProperty(StompCommandConstants::HEADER_HEARTBEAT,
+                    Long::toString(heartBeatOut) + "," + Long::toString(heartBeatIn));
+
+                StringTokenizer tokenizer(connect.getProperty(StompCommandConstants::HEADER_HEARTBEAT, "0,0"), ",");
+                tokenizer.nextToken();
+                long long clientIncoming = Long::parseLong(tokenizer.nextToken());
+                if (heartBeatOut > 0 && clientIncoming > 0) {
+                    writeInterval = Math::max(heartBeatOut, clientIncoming);
+                }
+            }
+
+            synchronized(&framesLock) {
+                negotiatedVersion = version;
+            }
+
+            writeFrame(connected);
+
+            synchronized(&connectionLock) {
+                stomp11 = version != StompCommandConstants::VERSION_1_0;
+            }
+
+            return writeInterval;
+        }
+
+        void onFrame(const StompFrame& frame) {
+            if (frame.hasProperty(StompCommandConstants::HEADER_RECEIPT_REQUIRED)) {
+                StompFrame receipt;
+                receipt.setCommand(StompCommandConstants::RECEIPT);
+                receipt.setProperty(StompCommandConstants::HEADER_RECEIPTID,
+                                    frame.getProperty(StompCommandConstants::HEADER_RECEIPT_REQUIRED));
+                writeFrame(receipt);
+            }
+        }
+
+        void serve() {
+
+            DataInputStream dataIn(socket->getInputStream());
+            std::auto_ptr<HeartBeatSender> sender;
+
+            try {
+                while (!done) {
+                    bool readStomp11 = false;
+                    synchronized(&connectionLock) {
+                        readStomp11 = stomp11;
+                    }
+
+                    Pointer<StompFrame> frame(new StompFrame());
+                    frame->fromStream(&dataIn, readStomp11);
+                    record(frame);
+
+                    if (frame->isHeartBeat()) {
+                        continue;
+                    }
+
+                    if (frame->getCommand() == StompCommandConstants::CONNECT) {
+
+                        long long interval = onConnect(*frame);
+                        if (interval > 0 && sendHeartBeats && sender.get() == NULL) {
+                            sender.reset(new HeartBeatSender(this, interval));
+                            sender->start();
+                        }
+                    } else {
+                        onFrame(*frame);
+                    }
+
+                    if (frame->getCommand() == StompCommandConstants::DISCONNECT) {
+                        break;
+                    }
+                }
+            } catch (...) {
+            }
+
+            if (sender.get() != NULL) {
+                sender->shutdown();
+            }
+        }
+
+        virtual void run() {
+            try {
+
+                server.reset(new ServerSocket(0));
+                started.countDown();
+
+                while (!done) {
+
+                    Pointer<Socket> accepted;
+                    try {
+                        accepted.reset(server->accept());
+                    } catch (IOException& ioe) {
+                        continue;
+                    }
+
+                    accepted->setSoLinger(false, 0);
+
+                    synchronized(&connectionLock) {
+                        socket = accepted;
+                        output.reset(new DataOutputStream(accepted->getOutputStream()));
+                        stomp11 = false;
+                    }
+
+                    serve();
+
+                    synchronized(&connectionLock) {
+                        output.reset(NULL);
+                        try {
+                            socket->close();
+                        } catch (...) {}
+                        socket.reset(NULL);
+                    }
+                }
+            } catch (...) {
+            }
+
+            // Never leave a waiting test hanging if the server socket could not be bound.
+            started.countDown();
+        }
+    };
+
+}}
+
+////////////////////////////////////////////////////////////////////////////////
+MockStompBrokerService::MockStompBrokerService() : impl(new MockStompBrokerServiceImpl()) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+MockStompBrokerService::~MockStompBrokerService() {
+    try {
+        stop();
+        if (this->impl->isAlive()) {
+            waitUntilStopped();
+        }
+    }
+    AMQ_CATCHALL_NOTHROW()
+
+    try {
+        delete impl;
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MockStompBrokerService::start() {
+    this->impl->start();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MockStompBrokerService::stop() {
+    this->impl->shutdown();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MockStompBrokerService::waitUntilStarted() {
+    this->impl->started.await();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MockStompBrokerService::waitUntilStopped() {
+    this->impl->join();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int MockStompBrokerService::getPort() const {
+    if (this->impl->server != NULL) {
+        return this->impl->server->getLocalPort();
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string MockStompBrokerService::getConnectString() const {
+    return std::string("tcp://localhost:") + Integer::toString(getPort()) + "?wireFormat=stomp";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MockStompBrokerService::setSupportedVersions(const std::string& versions) {
+    this->impl->supportedVersions = versions;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MockStompBrokerService::setHeartBeat(long long outgoing, long long incoming) {
+    this->impl->heartBeatOut = outgoing;
+    this->impl->heartBeatIn = incoming;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MockStompBrokerService::setSendHeartBeats(bool value) {
+    this->impl->sendHeartBeats = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string MockStompBrokerService::getNegotiatedVersion() const {
+    synchronized(&this->impl->framesLock) {
+        return this->impl->negotiatedVersion;
+    }
+
+    return "";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int MockStompBrokerService::getHeartBeatsReceived() const {
+    synchronized(&this->impl->framesLock) {
+        return this->impl->heartBeatsReceived;
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<StompFrame> MockStompBrokerService::waitForFrame(const std::string& command, long long timeout) {
+    return this->impl->waitForFrame(command, timeout);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MockStompBrokerService::sendMessage(const std::string& subscription, const std::string& destination,
+                                         const std::string& messageId, const std::string& text) {
+
+    StompFrame frame;
+    frame.setCommand(StompCommandConstants::MESSAGE);
+    frame.setProperty(StompCommandConstants::HEADER_SUBSCRIPTION, subscription);
+    frame.setProperty(StompCommandConstants::HEADER_DESTINATION, destination);
+    frame.setProperty(StompCommandConstants::HEADER_MESSAGEID, messageId);
+    frame.setProperty(StompCommandConstants::HEADER_ACK, "ack-" + messageId);
+
+    std::vector<unsigned char> body(text.begin(), text.end());
+    body.push_back('\0');
+    frame.setBody(&body[0], body.size());
+
+    this->impl->writeFrame(frame);
+}
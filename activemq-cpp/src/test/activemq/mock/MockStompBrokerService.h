@@ -0,0 +1,115 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_MOCK_MOCKSTOMPBROKERSERVICE_H_
+#define _ACTIVEMQ_MOCK_MOCKSTOMPBROKERSERVICE_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/wireformat/stomp/StompFrame.h>
+
+#include <decaf/lang/Pointer.h>
+
+#include <string>
+
+namespace activemq {
+namespace mock {
+
+    class MockStompBrokerServiceImpl;
+
+    /**
+     * A stand-in for a STOMP broker that accepts one client at a time.  It negotiates
+     * the protocol version and heart-beats, answers receipts, records the frames it is
+     * sent and can push MESSAGE frames and heart-beats back to the client.
+     */
+    class MockStompBrokerService {
+    private:
+
+        MockStompBrokerService(const MockStompBrokerService&);
+        MockStompBrokerService& operator= (const MockStompBrokerService&);
+
+    private:
+
+        MockStompBrokerServiceImpl* impl;
+
+    public:
+
+        MockStompBrokerService();
+
+        virtual ~MockStompBrokerService();
+
+    public:
+
+        void start();
+
+        void stop();
+
+        void waitUntilStarted();
+
+        void waitUntilStopped();
+
+        /**
+         * @return a tcp URI with the stomp wire format set for connecting to this broker.
+         */
+        std::string getConnectString() const;
+
+        int getPort() const;
+
+        /**
+         * Sets the versions this broker speaks, the highest one the client also accepts
+         * is used.  Defaults to 1.0,1.1,1.2.
+         */
+        void setSupportedVersions(const std::string& versions);
+
+        /**
+         * Sets the heart-beat header this broker answers the CONNECT frame with.
+         */
+        void setHeartBeat(long long outgoing, long long incoming);
+
+        /**
+         * Sets whether the broker really sends the heart-beats it offered, defaults to true.
+         */
+        void setSendHeartBeats(bool value);
+
+        /**
+         * @return the version agreed on with the last client to connect.
+         */
+        std::string getNegotiatedVersion() const;
+
+        /**
+         * @return number of heart-beats read from the client.
+         */
+        int getHeartBeatsReceived() const;
+
+        /**
+         * Waits for the client to send a frame with the given command, frames that have
+         * been returned by an earlier call are not returned again.
+         *
+         * @return the frame or NULL if none arrived before the timeout.
+         */
+        decaf::lang::Pointer<wireformat::stomp::StompFrame> waitForFrame(const std::string& command, long long timeout);
+
+        /**
+         * Sends a text MESSAGE frame to the connected client.
+         */
+        void sendMessage(const std::string& subscription, const std::string& destination,
+                         const std::string& messageId, const std::string& text);
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_MOCK_MOCKSTOMPBROKERSERVICE_H_ */
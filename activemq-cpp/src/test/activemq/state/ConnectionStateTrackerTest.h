@@ -30,6 +30,9 @@ namespace state {
         CPPUNIT_TEST( test );
         CPPUNIT_TEST( testMessageCache );
         CPPUNIT_TEST( testMessagePullCache );
+        CPPUNIT_TEST( testMessageCacheResend );
+        CPPUNIT_TEST( testTrackedMessageNotCopied );
+        CPPUNIT_TEST( testRestoreOverSlowTransport );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -40,6 +43,9 @@ namespace state {
         void test();
         void testMessageCache();
         void testMessagePullCache();
+        void testMessageCacheResend();
+        void testTrackedMessageNotCopied();
+        void testRestoreOverSlowTransport();
 
     };
 
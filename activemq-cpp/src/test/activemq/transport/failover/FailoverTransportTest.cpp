@@ -27,8 +27,10 @@
 #include <decaf/util/concurrent/CountDownLatch.h>
 #include <decaf/util/concurrent/Mutex.h>
 #include <decaf/lang/Pointer.h>
+#include <decaf/lang/System.h>
 #include <decaf/lang/Thread.h>
 #include <decaf/util/UUID.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
 
 using namespace activemq;
 using namespace activemq::mock;
@@ -1036,3 +1038,105 @@ void FailoverTransportTest::testConnectsToPriorityAfterInitialBackupFails() {
     broker3->stop();
     broker3->waitUntilStopped();
 }
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    std::string getConnectedMockName(Pointer<Transport>& transport) {
+        MockTransport* mock = dynamic_cast<MockTransport*>(transport->narrow(typeid(MockTransport)));
+        return mock != NULL ? mock->getName() : std::string();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransportTest::testLatencyAwareReconnectsToFastestBroker() {
+
+    // The slow broker is first and unmeasured so it is connected to initially, the
+    // backups then measure the other two which are listed slowest first.
+    std::string uri = "failover://(mock://localhost:61616?name=slow&startDelay=300&failOnSendMessage=true,"
+                                  "mock://localhost:61617?name=medium&startDelay=150,"
+                                  "mock://localhost:61618?name=fast&startDelay=10)?"
+                      "randomize=false&backup=true&backupPoolSize=2&"
+                      "latencyAware=true&latencyDecayTime=600000&latencyFailurePenalty=2000";
+
+    Pointer<ActiveMQMessage> message(new ActiveMQMessage());
+
+    DefaultTransportListener listener;
+    FailoverTransportFactory factory;
+
+    Pointer<Transport> transport(factory.create(uri));
+    CPPUNIT_ASSERT(transport != NULL);
+    transport->setTransportListener(&listener);
+
+    FailoverTransport* failover =
+        dynamic_cast<FailoverTransport*>(transport->narrow(typeid(FailoverTransport)));
+
+    CPPUNIT_ASSERT(failover != NULL);
+    CPPUNIT_ASSERT(failover->isLatencyAware() == true);
+    CPPUNIT_ASSERT(failover->getLatencyDecayTime() == 600000);
+    CPPUNIT_ASSERT(failover->getLatencyFailurePenalty() == 2000);
+
+    transport->start();
+
+    Thread::sleep(2000);
+    CPPUNIT_ASSERT(failover->isConnected() == true);
+    CPPUNIT_ASSERT_EQUAL(std::string("slow"), getConnectedMockName(transport));
+
+    // Failing the send drops the slow broker, the fastest backup should be taken
+    // even though the medium one was connected first.
+    transport->oneway(message);
+
+    int count = 0;
+    while (getConnectedMockName(transport) != "fast" && count++ < 50) {
+        Thread::sleep(100);
+    }
+
+    CPPUNIT_ASSERT(failover->isConnected() == true);
+    CPPUNIT_ASSERT_EQUAL(std::string("fast"), getConnectedMockName(transport));
+
+    transport->close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FailoverTransportTest::testReconnectRaceUsesFirstToConnect() {
+
+    // Tried in order the first two brokers would cost over two seconds before the
+    // third was reached, raced the third one wins straight away.
+    std::string uri = "failover://(mock://localhost:61616?name=broken&failOnCreate=true,"
+                                  "mock://localhost:61617?name=slow&startDelay=2500,"
+                                  "mock://localhost:61618?name=fast&startDelay=50)?"
+                      "randomize=false&reconnectRace=true&reconnectRaceSize=3";
+
+    DefaultTransportListener listener;
+    FailoverTransportFactory factory;
+
+    Pointer<Transport> transport(factory.create(uri));
+    CPPUNIT_ASSERT(transport != NULL);
+    transport->setTransportListener(&listener);
+
+    FailoverTransport* failover =
+        dynamic_cast<FailoverTransport*>(transport->narrow(typeid(FailoverTransport)));
+
+    CPPUNIT_ASSERT(failover != NULL);
+    CPPUNIT_ASSERT(failover->isReconnectRace() == true);
+    CPPUNIT_ASSERT(failover->getReconnectRaceSize() == 3);
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        failover->setReconnectRaceSize(0),
+        decaf::lang::exceptions::IllegalArgumentException);
+
+    long long start = System::currentTimeMillis();
+
+    transport->start();
+
+    int count = 0;
+    while (!failover->isConnected() && count++ < 100) {
+        Thread::sleep(20);
+    }
+
+    CPPUNIT_ASSERT(failover->isConnected() == true);
+    CPPUNIT_ASSERT(System::currentTimeMillis() - start < 1500);
+    CPPUNIT_ASSERT_EQUAL(std::string("fast"), getConnectedMockName(transport));
+
+    transport->close();
+}
@@ -60,6 +60,8 @@ namespace failover {
         CPPUNIT_TEST( testConnectedToPriorityOnFirstTryThenFailover );
         CPPUNIT_TEST( testConnectsToPriorityOnceStarted );
         //CPPUNIT_TEST( testConnectsToPriorityAfterInitialBackupFails );
+        CPPUNIT_TEST( testLatencyAwareReconnectsToFastestBroker );
+        CPPUNIT_TEST( testReconnectRaceUsesFirstToConnect );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -87,6 +89,8 @@ namespace failover {
         void testConnectedToPriorityOnFirstTryThenFailover();
         void testConnectsToPriorityOnceStarted();
         void testConnectsToPriorityAfterInitialBackupFails();
+        void testLatencyAwareReconnectsToFastestBroker();
+        void testReconnectRaceUsesFirstToConnect();
 
     private:
 
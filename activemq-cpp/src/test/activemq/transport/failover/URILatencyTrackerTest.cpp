@@ -0,0 +1,195 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "URILatencyTrackerTest.h"
+
+#include <activemq/transport/failover/URILatencyTracker.h>
+#include <activemq/transport/failover/URIPool.h>
+
+#include <decaf/lang/Thread.h>
+#include <decaf/util/LinkedList.h>
+
+using namespace activemq;
+using namespace activemq::transport;
+using namespace activemq::transport::failover;
+using namespace decaf::lang;
+using namespace decaf::net;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+URILatencyTrackerTest::URILatencyTrackerTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+URILatencyTrackerTest::~URILatencyTrackerTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void URILatencyTrackerTest::testUnscoredURIsPreferred() {
+
+    URILatencyTracker tracker;
+    URI uri1("mock://localhost:61616");
+    URI uri2("mock://localhost:61617");
+
+    LinkedList<URI> uris;
+    uris.add(uri1);
+    uris.add(uri2);
+
+    CPPUNIT_ASSERT_EQUAL(0, tracker.selectBest(uris));
+    CPPUNIT_ASSERT_EQUAL(-1, tracker.selectBest(LinkedList<URI>()));
+
+    tracker.recordLatency(uri1, 5);
+
+    CPPUNIT_ASSERT(tracker.isScored(uri1));
+    CPPUNIT_ASSERT(!tracker.isScored(uri2));
+    CPPUNIT_ASSERT_EQUAL(0.0, tracker.getScore(uri2));
+    CPPUNIT_ASSERT_EQUAL(1, tracker.selectBest(uris));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void URILatencyTrackerTest::testSelectsLowestLatency() {
+
+    URILatencyTracker tracker;
+    URI uri1("mock://localhost:61616");
+    URI uri2("mock://localhost:61617");
+    URI uri3("mock://localhost:61618");
+
+    tracker.recordLatency(uri1, 200);
+    tracker.recordLatency(uri2, 20);
+    tracker.recordLatency(uri3, 80);
+
+    LinkedList<URI> uris;
+    uris.add(uri1);
+    uris.add(uri2);
+    uris.add(uri3);
+
+    CPPUNIT_ASSERT_EQUAL(1, tracker.selectBest(uris));
+
+    uris.remove(uri2);
+    CPPUNIT_ASSERT_EQUAL(1, tracker.selectBest(uris));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void URILatencyTrackerTest::testSmoothing() {
+
+    URILatencyTracker tracker;
+    tracker.setDecayTime(0);
+
+    URI uri("mock://localhost:61616");
+
+    tracker.recordLatency(uri, 100);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(100.0, tracker.getScore(uri), 0.001);
+
+    // A single outlier moves the score only part of the way.
+    tracker.recordLatency(uri, 1100);
+    CPPUNIT_ASSERT(tracker.getScore(uri) > 100.0);
+    CPPUNIT_ASSERT(tracker.getScore(uri) < 1100.0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void URILatencyTrackerTest::testFailurePenalty() {
+
+    URILatencyTracker tracker;
+    tracker.setDecayTime(0);
+    tracker.setFailurePenalty(1000);
+
+    CPPUNIT_ASSERT_EQUAL(1000LL, tracker.getFailurePenalty());
+
+    URI uri1("mock://localhost:61616");
+    URI uri2("mock://localhost:61617");
+
+    tracker.recordLatency(uri1, 200);
+    tracker.recordLatency(uri2, 50);
+    tracker.recordFailure(uri2);
+
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1050.0, tracker.getScore(uri2), 0.001);
+
+    LinkedList<URI> uris;
+    uris.add(uri1);
+    uris.add(uri2);
+
+    CPPUNIT_ASSERT_EQUAL(0, tracker.selectBest(uris));
+
+    // A URI that has only ever failed is scored too.
+    URI uri3("mock://localhost:61618");
+    tracker.recordFailure(uri3);
+    CPPUNIT_ASSERT(tracker.isScored(uri3));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1000.0, tracker.getScore(uri3), 0.001);
+
+    tracker.clear();
+    CPPUNIT_ASSERT(!tracker.isScored(uri1));
+    CPPUNIT_ASSERT(!tracker.isScored(uri3));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void URILatencyTrackerTest::testScoresDecay() {
+
+    URILatencyTracker tracker;
+    tracker.setDecayTime(100);
+
+    CPPUNIT_ASSERT_EQUAL(100LL, tracker.getDecayTime());
+
+    URI uri1("mock://localhost:61616");
+    URI uri2("mock://localhost:61617");
+
+    tracker.recordFailure(uri1);
+    Thread::sleep(400);
+    tracker.recordLatency(uri2, 500);
+
+    // The old failure has decayed below the fresh but slow measurement.
+    CPPUNIT_ASSERT(tracker.getScore(uri1) < 500.0);
+
+    LinkedList<URI> uris;
+    uris.add(uri2);
+    uris.add(uri1);
+
+    CPPUNIT_ASSERT_EQUAL(1, tracker.selectBest(uris));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void URILatencyTrackerTest::testURIPoolSelection() {
+
+    URI uri1("mock://localhost:61616");
+    URI uri2("mock://localhost:61617");
+    URI uri3("mock://localhost:61618");
+
+    LinkedList<URI> uris;
+    uris.add(uri1);
+    uris.add(uri2);
+    uris.add(uri3);
+
+    URIPool pool(uris);
+
+    Pointer<URILatencyTracker> tracker(new URILatencyTracker());
+    tracker->setDecayTime(0);
+    tracker->recordLatency(uri1, 300);
+    tracker->recordLatency(uri2, 100);
+    tracker->recordLatency(uri3, 10);
+
+    pool.setLatencyTracker(tracker);
+    CPPUNIT_ASSERT(pool.getLatencyTracker() == tracker);
+
+    CPPUNIT_ASSERT(pool.getURI().equals(uri3));
+    CPPUNIT_ASSERT(pool.getURI().equals(uri2));
+    CPPUNIT_ASSERT(pool.getURI().equals(uri1));
+    CPPUNIT_ASSERT(pool.isEmpty());
+
+    // Without a tracker URIs come back in order again.
+    pool.setLatencyTracker(Pointer<URILatencyTracker>());
+    pool.addURIs(uris);
+    CPPUNIT_ASSERT(pool.getURI().equals(uri1));
+}
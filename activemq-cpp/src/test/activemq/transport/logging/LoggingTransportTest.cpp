@@ -0,0 +1,311 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LoggingTransportTest.h"
+
+#include <activemq/transport/logging/LoggingTransport.h>
+#include <activemq/transport/mock/MockTransport.h>
+#include <activemq/transport/mock/MockTransportFactory.h>
+#include <activemq/transport/DefaultTransportListener.h>
+#include <activemq/commands/ActiveMQTextMessage.h>
+#include <activemq/commands/ActiveMQQueue.h>
+#include <activemq/commands/ConsumerInfo.h>
+#include <activemq/commands/KeepAliveInfo.h>
+#include <activemq/commands/MessageAck.h>
+#include <activemq/commands/MessageDispatch.h>
+
+#include <decaf/net/URI.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/util/Properties.h>
+#include <decaf/util/concurrent/Concurrent.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+
+#include <typeinfo>
+#include <vector>
+
+using namespace activemq;
+using namespace activemq::commands;
+using namespace activemq::transport;
+using namespace activemq::transport::mock;
+using namespace activemq::transport::logging;
+using namespace decaf;
+using namespace decaf::net;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class RecordingLoggingTransport : public LoggingTransport {
+    private:
+
+        Mutex lock;
+        std::vector<std::string> lines;
+
+    public:
+
+        RecordingLoggingTransport(const Pointer<Transport> next) :
+            LoggingTransport(next), lock(), lines() {
+        }
+
+        virtual ~RecordingLoggingTransport() {}
+
+        std::vector<std::string> getLines() {
+            std::vector<std::string> result;
+            synchronized(&lock) {
+                result = lines;
+            }
+            return result;
+        }
+
+    protected:
+
+        virtual void log(const std::string& line) {
+            synchronized(&lock) {
+                lines.push_back(line);
+            }
+        }
+    };
+
+    Pointer<Transport> createMockTransport() {
+        MockTransportFactory factory;
+        return factory.createComposite(URI("mock://mock?wireformat=openwire"));
+    }
+
+    Pointer<ConsumerId> createConsumerId() {
+        Pointer<ConsumerId> id(new ConsumerId);
+        id->setConnectionId("ID:test-1:0");
+        id->setSessionId(1);
+        id->setValue(2);
+        return id;
+    }
+
+    Pointer<ActiveMQTextMessage> createMessage() {
+
+        Pointer<ProducerId> producer(new ProducerId);
+        producer->setConnectionId("ID:test-1:0");
+        producer->setSessionId(1);
+        producer->setValue(3);
+
+        Pointer<MessageId> id(new MessageId);
+        id->setProducerId(producer);
+        id->setProducerSequenceId(42);
+
+        Pointer<ActiveMQTextMessage> message(new ActiveMQTextMessage);
+        message->setMessageId(id);
+        message->setDestination(Pointer<ActiveMQDestination>(new ActiveMQQueue("TEST.QUEUE")));
+        message->setText("secret payload");
+        message->setCommandId(5);
+
+        return message;
+    }
+
+    bool contains(const std::string& line, const std::string& part) {
+        return line.find(part) != std::string::npos;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LoggingTransportTest::LoggingTransportTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LoggingTransportTest::~LoggingTransportTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LoggingTransportTest::testSummarize() {
+
+    Pointer<ActiveMQTextMessage> message = createMessage();
+
+    std::string summary = LoggingTransport::summarize(*message);
+    CPPUNIT_ASSERT_MESSAGE(summary, contains(summary, "Message id=5"));
+    CPPUNIT_ASSERT_MESSAGE(summary, contains(summary, "message=" + message->getMessageId()->toString()));
+    CPPUNIT_ASSERT_MESSAGE(summary, contains(summary, "destination=queue://TEST.QUEUE"));
+    CPPUNIT_ASSERT_MESSAGE(summary, contains(summary, "size="));
+    CPPUNIT_ASSERT_MESSAGE(summary, !contains(summary, "secret payload"));
+
+    MessageDispatch dispatch;
+    dispatch.setConsumerId(createConsumerId());
+    dispatch.setMessage(message);
+    dispatch.setRedeliveryCounter(2);
+    summary = LoggingTransport::summarize(dispatch);
+    CPPUNIT_ASSERT_MESSAGE(summary, contains(summary, "MessageDispatch id=0"));
+    CPPUNIT_ASSERT_MESSAGE(summary, contains(summary, "consumer=" + createConsumerId()->toString()));
+    CPPUNIT_ASSERT_MESSAGE(summary, contains(summary, "redeliveries=2"));
+
+    MessageAck ack;
+    ack.setConsumerId(createConsumerId());
+    ack.setAckType(2);
+    ack.setMessageCount(10);
+    ack.setResponseRequired(true);
+    summary = LoggingTransport::summarize(ack);
+    CPPUNIT_ASSERT_MESSAGE(summary, contains(summary, "MessageAck id=0 responseRequired"));
+    CPPUNIT_ASSERT_MESSAGE(summary, contains(summary, "ackType=2 count=10"));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LoggingTransportTest::testFullMode() {
+
+    RecordingLoggingTransport transport(createMockTransport());
+    CPPUNIT_ASSERT_EQUAL(LoggingTransport::FULL, transport.getLogMode());
+
+    Pointer<ActiveMQTextMessage> message = createMessage();
+    transport.oneway(message);
+
+    std::vector<std::string> lines = transport.getLines();
+    CPPUNIT_ASSERT_EQUAL(1, (int) lines.size());
+    CPPUNIT_ASSERT_EQUAL("SEND: " + message->toString(), lines[0]);
+    CPPUNIT_ASSERT_EQUAL(1LL, transport.getLoggedCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LoggingTransportTest::testToggleAtRuntime() {
+
+    Pointer<Transport> chain(new RecordingLoggingTransport(createMockTransport()));
+
+    LoggingTransport* logging = dynamic_cast<LoggingTransport*>(chain->narrow(typeid(LoggingTransport)));
+    CPPUNIT_ASSERT(logging != NULL);
+
+    RecordingLoggingTransport* recorder = dynamic_cast<RecordingLoggingTransport*>(logging);
+
+    logging->setLogMode(LoggingTransport::OFF);
+    chain->oneway(Pointer<Command>(new KeepAliveInfo()));
+    CPPUNIT_ASSERT_EQUAL(0, (int) recorder->getLines().size());
+
+    logging->setLogMode(LoggingTransport::SUMMARY);
+    chain->oneway(Pointer<Command>(new KeepAliveInfo()));
+
+    std::vector<std::string> lines = recorder->getLines();
+    CPPUNIT_ASSERT_EQUAL(1, (int) lines.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("SEND: KeepAliveInfo id=0"), lines[0]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LoggingTransportTest::testSampleRate() {
+
+    RecordingLoggingTransport transport(createMockTransport());
+    transport.setLogMode(LoggingTransport::SUMMARY);
+    transport.setSampleRate(3);
+
+    for (int i = 0; i < 9; ++i) {
+        Pointer<KeepAliveInfo> command(new KeepAliveInfo());
+        command->setCommandId(i);
+        transport.oneway(command);
+    }
+
+    std::vector<std::string> lines = transport.getLines();
+    CPPUNIT_ASSERT_EQUAL(3, (int) lines.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("SEND: KeepAliveInfo id=0"), lines[0]);
+    CPPUNIT_ASSERT_EQUAL(std::string("SEND: KeepAliveInfo id=3"), lines[1]);
+    CPPUNIT_ASSERT_EQUAL(std::string("SEND: KeepAliveInfo id=6"), lines[2]);
+    CPPUNIT_ASSERT_EQUAL(3LL, transport.getLoggedCount());
+    CPPUNIT_ASSERT_EQUAL(6LL, transport.getSuppressedCount());
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        transport.setSampleRate(0),
+        IllegalArgumentException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LoggingTransportTest::testMaxPerSecond() {
+
+    RecordingLoggingTransport transport(createMockTransport());
+    transport.setLogMode(LoggingTransport::SUMMARY);
+    transport.setMaxPerSecond(5);
+
+    for (int i = 0; i < 20; ++i) {
+        transport.oneway(Pointer<Command>(new KeepAliveInfo()));
+    }
+
+    // A slow machine may straddle a window boundary, never more than two windows.
+    long long logged = transport.getLoggedCount();
+    CPPUNIT_ASSERT(logged >= 5 && logged <= 10);
+    CPPUNIT_ASSERT_EQUAL(20LL, logged + transport.getSuppressedCount());
+
+    transport.setMaxPerSecond(0);
+    CPPUNIT_ASSERT_EQUAL(0, transport.getMaxPerSecond());
+    transport.oneway(Pointer<Command>(new KeepAliveInfo()));
+    CPPUNIT_ASSERT_EQUAL(logged + 1, transport.getLoggedCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LoggingTransportTest::testResponseLatency() {
+
+    DefaultTransportListener listener;
+    RecordingLoggingTransport transport(createMockTransport());
+    transport.setLogMode(LoggingTransport::SUMMARY);
+    transport.setTransportListener(&listener);
+    transport.start();
+
+    Pointer<ConsumerInfo> info(new ConsumerInfo());
+    info->setConsumerId(createConsumerId());
+    info->setCommandId(7);
+    info->setResponseRequired(true);
+
+    // Responses that pair with a logged request are kept even when sampling.
+    transport.setSampleRate(1000);
+    transport.oneway(info);
+
+    std::vector<std::string> lines;
+    for (int i = 0; i < 100; ++i) {
+        lines = transport.getLines();
+        if (lines.size() >= 2) {
+            break;
+        }
+        Thread::sleep(20);
+    }
+
+    transport.close();
+
+    CPPUNIT_ASSERT_EQUAL(2, (int) lines.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("SEND: ConsumerInfo id=7 responseRequired"), lines[0]);
+    CPPUNIT_ASSERT_MESSAGE(lines[1], contains(lines[1], "RECV: Response"));
+    CPPUNIT_ASSERT_MESSAGE(lines[1], contains(lines[1], "correlationId=7"));
+    CPPUNIT_ASSERT_MESSAGE(lines[1], contains(lines[1], "latency="));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LoggingTransportTest::testProperties() {
+
+    Properties properties;
+    properties.setProperty("transport.logMode", "summary");
+    properties.setProperty("transport.logSampleRate", "4");
+    properties.setProperty("transport.logMaxPerSecond", "100");
+
+    LoggingTransport transport(createMockTransport(), properties);
+    CPPUNIT_ASSERT_EQUAL(LoggingTransport::SUMMARY, transport.getLogMode());
+    CPPUNIT_ASSERT_EQUAL(4, transport.getSampleRate());
+    CPPUNIT_ASSERT_EQUAL(100, transport.getMaxPerSecond());
+
+    properties.setProperty("transport.logMode", "verbose");
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        LoggingTransport(createMockTransport(), properties),
+        IllegalArgumentException);
+
+    // Setting a mode makes the factory install the filter, even when it is off.
+    MockTransportFactory factory;
+    Pointer<Transport> chain = factory.create(URI("mock://mock?wireformat=openwire&transport.logMode=off"));
+    LoggingTransport* logging = dynamic_cast<LoggingTransport*>(chain->narrow(typeid(LoggingTransport)));
+    CPPUNIT_ASSERT(logging != NULL);
+    CPPUNIT_ASSERT_EQUAL(LoggingTransport::OFF, logging->getLogMode());
+}
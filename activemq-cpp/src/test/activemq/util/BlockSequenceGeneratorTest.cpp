@@ -0,0 +1,154 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "BlockSequenceGeneratorTest.h"
+
+#include <activemq/util/BlockSequenceGenerator.h>
+
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+
+#include <set>
+#include <vector>
+
+using namespace activemq;
+using namespace activemq::util;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class GeneratorThread : public Thread {
+    private:
+
+        BlockSequenceGenerator* generator;
+        int count;
+
+    public:
+
+        std::vector<long long> ids;
+
+        GeneratorThread(BlockSequenceGenerator* generator, int count) :
+            Thread(), generator(generator), count(count), ids() {
+        }
+
+        virtual void run() {
+            for (int i = 0; i < count; ++i) {
+                ids.push_back(generator->getNextSequenceId());
+            }
+        }
+
+    };
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void BlockSequenceGeneratorTest::testSingleThread() {
+
+    BlockSequenceGenerator sequence;
+
+    CPPUNIT_ASSERT_EQUAL(BlockSequenceGenerator::DEFAULT_BLOCK_SIZE, sequence.getBlockSize());
+
+    long long last = sequence.getNextSequenceId();
+    CPPUNIT_ASSERT(last > 0);
+
+    for (int i = 0; i < BlockSequenceGenerator::DEFAULT_BLOCK_SIZE * 4; ++i) {
+        long long next = sequence.getNextSequenceId();
+        CPPUNIT_ASSERT(last < next);
+        last = next;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void BlockSequenceGeneratorTest::testInvalidBlockSize() {
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        BlockSequenceGenerator(0),
+        IllegalArgumentException);
+
+    BlockSequenceGenerator sequence(1);
+    CPPUNIT_ASSERT_EQUAL(1, sequence.getBlockSize());
+    CPPUNIT_ASSERT(sequence.getNextSequenceId() < sequence.getNextSequenceId());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void BlockSequenceGeneratorTest::testSeparateGenerators() {
+
+    // More generators than a thread caches blocks for, each must still keep
+    // its own sequence without repeating a value.
+    static const int COUNT = 40;
+
+    std::vector<BlockSequenceGenerator*> generators;
+    std::vector<std::set<long long> > values(COUNT);
+
+    for (int i = 0; i < COUNT; ++i) {
+        generators.push_back(new BlockSequenceGenerator(8));
+    }
+
+    for (int round = 0; round < 20; ++round) {
+        for (int i = 0; i < COUNT; ++i) {
+            CPPUNIT_ASSERT(values[i].insert(generators[i]->getNextSequenceId()).second);
+        }
+    }
+
+    for (int i = 0; i < COUNT; ++i) {
+        delete generators[i];
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void BlockSequenceGeneratorTest::testThreadSafety() {
+
+    static const int THREADS = 10;
+    static const int COUNT = 1000;
+
+    BlockSequenceGenerator sequence(16);
+    std::vector<GeneratorThread*> threads;
+
+    for (int i = 0; i < THREADS; ++i) {
+        threads.push_back(new GeneratorThread(&sequence, COUNT));
+    }
+
+    for (int i = 0; i < THREADS; ++i) {
+        threads[i]->start();
+    }
+
+    for (int i = 0; i < THREADS; ++i) {
+        threads[i]->join();
+    }
+
+    std::set<long long> values;
+
+    for (int i = 0; i < THREADS; ++i) {
+        std::vector<long long>& ids = threads[i]->ids;
+        CPPUNIT_ASSERT_EQUAL(COUNT, (int) ids.size());
+
+        for (int j = 0; j < COUNT; ++j) {
+            if (j > 0) {
+                CPPUNIT_ASSERT(ids[j - 1] < ids[j]);
+            }
+            CPPUNIT_ASSERT(values.insert(ids[j]).second);
+        }
+
+        delete threads[i];
+    }
+
+    CPPUNIT_ASSERT_EQUAL(THREADS * COUNT, (int) values.size());
+}
@@ -0,0 +1,94 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "IdPrefixTableTest.h"
+
+#include <activemq/util/IdPrefixTable.h>
+#include <activemq/commands/ConsumerId.h>
+#include <activemq/commands/MessageId.h>
+#include <activemq/commands/ProducerId.h>
+#include <activemq/commands/SessionId.h>
+
+using namespace activemq;
+using namespace activemq::util;
+using namespace activemq::commands;
+using namespace decaf;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+void IdPrefixTableTest::testIntern() {
+
+    Pointer<const IdPrefix> prefix1 = IdPrefixTable::intern("ID:test-connection:1", 1);
+    Pointer<const IdPrefix> prefix2 = IdPrefixTable::intern("ID:test-connection:1", 1);
+    Pointer<const IdPrefix> prefix3 = IdPrefixTable::intern("ID:test-connection:1", 2);
+    Pointer<const IdPrefix> prefix4 = IdPrefixTable::intern("ID:test-connection:2", 1);
+
+    CPPUNIT_ASSERT(prefix1.get() == prefix2.get());
+    CPPUNIT_ASSERT(prefix1.get() != prefix3.get());
+    CPPUNIT_ASSERT(prefix1.get() != prefix4.get());
+    CPPUNIT_ASSERT(IdPrefixTable::size() >= 3);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IdPrefixTableTest::testPrefix() {
+
+    Pointer<const IdPrefix> prefix = IdPrefixTable::intern("ID:test-connection:1", 5);
+
+    CPPUNIT_ASSERT_EQUAL(std::string("ID:test-connection:1:5"), prefix->getText());
+    CPPUNIT_ASSERT_EQUAL(std::string("ID:test-connection:1:5:7"), prefix->formatKey(7));
+    CPPUNIT_ASSERT(prefix->matches("ID:test-connection:1", 5));
+    CPPUNIT_ASSERT(!prefix->matches("ID:test-connection:1", 6));
+    CPPUNIT_ASSERT(!prefix->matches("ID:test-connection:2", 5));
+    CPPUNIT_ASSERT(!prefix->matches("ID:test-connection:12", 5));
+
+    ProducerId producerId;
+    producerId.setConnectionId("ID:test-connection:1");
+    producerId.setSessionId(5);
+    producerId.setValue(7);
+
+    CPPUNIT_ASSERT_EQUAL(producerId.toString(), prefix->formatKey(7));
+    CPPUNIT_ASSERT_EQUAL(producerId.getHashCode(), prefix->hashKey(7));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IdPrefixTableTest::testSharedByIds() {
+
+    ConnectionId connectionId;
+    connectionId.setValue("ID:test-connection:3");
+
+    SessionId sessionId(&connectionId, 1);
+    ProducerId producerId1(sessionId, 1);
+    ProducerId producerId2(sessionId, 2);
+    ConsumerId consumerId(sessionId, 1);
+
+    CPPUNIT_ASSERT_EQUAL(std::string("ID:test-connection:3:1"), sessionId.toString());
+    CPPUNIT_ASSERT_EQUAL(std::string("ID:test-connection:3:1:1"), producerId1.toString());
+    CPPUNIT_ASSERT_EQUAL(std::string("ID:test-connection:3:1:2"), producerId2.toString());
+    CPPUNIT_ASSERT_EQUAL(std::string("ID:test-connection:3:1:1"), consumerId.toString());
+
+    ProducerId unmarshaled;
+    unmarshaled.setConnectionId("ID:test-connection:3");
+    unmarshaled.setSessionId(1);
+    unmarshaled.setValue(2);
+    unmarshaled.afterUnmarshal(NULL);
+
+    CPPUNIT_ASSERT(producerId2.equals(&unmarshaled));
+    CPPUNIT_ASSERT_EQUAL(producerId2.getHashCode(), unmarshaled.getHashCode());
+
+    MessageId messageId(Pointer<ProducerId>(producerId1.cloneDataStructure()), 10);
+    CPPUNIT_ASSERT_EQUAL(std::string("ID:test-connection:3:1:1:10"), messageId.toString());
+}
@@ -0,0 +1,118 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LatencyHistogramTest.h"
+
+#include <activemq/util/LatencyHistogram.h>
+
+using namespace activemq;
+using namespace activemq::util;
+
+////////////////////////////////////////////////////////////////////////////////
+void LatencyHistogramTest::testEmpty() {
+
+    LatencyHistogram histogram;
+
+    CPPUNIT_ASSERT_EQUAL(0LL, histogram.getCount());
+    CPPUNIT_ASSERT_EQUAL(0LL, histogram.getMin());
+    CPPUNIT_ASSERT_EQUAL(0LL, histogram.getMax());
+    CPPUNIT_ASSERT_EQUAL(0.0, histogram.getMean());
+    CPPUNIT_ASSERT_EQUAL(0LL, histogram.getValueAtPercentile(50.0));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LatencyHistogramTest::testRecord() {
+
+    LatencyHistogram histogram;
+
+    histogram.record(7);
+    histogram.record(3);
+    histogram.record(-5);
+    histogram.record(10);
+
+    CPPUNIT_ASSERT_EQUAL(4LL, histogram.getCount());
+    CPPUNIT_ASSERT_EQUAL(0LL, histogram.getMin());
+    CPPUNIT_ASSERT_EQUAL(10LL, histogram.getMax());
+    CPPUNIT_ASSERT_EQUAL(20LL, histogram.getTotal());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(5.0, histogram.getMean(), 0.001);
+
+    // Small values have a bucket of their own so are reported exactly.
+    CPPUNIT_ASSERT_EQUAL(3LL, histogram.getValueAtPercentile(50.0));
+    CPPUNIT_ASSERT_EQUAL(10LL, histogram.getValueAtPercentile(100.0));
+
+    histogram.reset();
+    CPPUNIT_ASSERT_EQUAL(0LL, histogram.getCount());
+    CPPUNIT_ASSERT_EQUAL(0LL, histogram.getMax());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LatencyHistogramTest::testPercentiles() {
+
+    LatencyHistogram histogram;
+
+    for (long long i = 1; i <= 10000; ++i) {
+        histogram.record(i);
+    }
+
+    long long expected[] = { 5000, 9000, 9900, 9990 };
+    double percentiles[] = { 50.0, 90.0, 99.0, 99.9 };
+
+    for (int i = 0; i < 4; ++i) {
+        long long value = histogram.getValueAtPercentile(percentiles[i]);
+        CPPUNIT_ASSERT(value >= expected[i]);
+        CPPUNIT_ASSERT(value <= expected[i] + expected[i] / LatencyHistogram::SUB_BUCKET_COUNT);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(10000LL, histogram.getValueAtPercentile(100.0));
+    CPPUNIT_ASSERT_EQUAL(1LL, histogram.getValueAtPercentile(0.0));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LatencyHistogramTest::testLargeValues() {
+
+    LatencyHistogram histogram;
+
+    long long huge = 1LL << 50;
+    histogram.record(5);
+    histogram.record(huge);
+
+    CPPUNIT_ASSERT_EQUAL(huge, histogram.getMax());
+    CPPUNIT_ASSERT_EQUAL(5LL, histogram.getValueAtPercentile(50.0));
+    CPPUNIT_ASSERT_EQUAL(huge, histogram.getValueAtPercentile(100.0));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LatencyHistogramTest::testAdd() {
+
+    LatencyHistogram first;
+    LatencyHistogram second;
+
+    first.record(100);
+    second.record(2);
+    second.record(300);
+
+    first.add(second);
+
+    CPPUNIT_ASSERT_EQUAL(3LL, first.getCount());
+    CPPUNIT_ASSERT_EQUAL(2LL, first.getMin());
+    CPPUNIT_ASSERT_EQUAL(300LL, first.getMax());
+    CPPUNIT_ASSERT_EQUAL(402LL, first.getTotal());
+
+    LatencyHistogram copy(first);
+    CPPUNIT_ASSERT_EQUAL(3LL, copy.getCount());
+    CPPUNIT_ASSERT_EQUAL(300LL, copy.getValueAtPercentile(100.0));
+}
@@ -18,6 +18,7 @@
 #include "MemoryUsageTest.h"
 #include <activemq/util/MemoryUsage.h>
 
+#include <decaf/lang/Integer.h>
 #include <decaf/lang/Runnable.h>
 #include <decaf/lang/System.h>
 #include <decaf/lang/Thread.h>
@@ -121,3 +122,20 @@ void MemoryUsageTest::testWait() {
 
     myThread.join();
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void MemoryUsageTest::testUsageSaturates() {
+
+    MemoryUsage usage( 2048 );
+
+    usage.increaseUsage( (unsigned long long) Integer::MAX_VALUE + 1024 );
+    CPPUNIT_ASSERT( usage.isFull() );
+    CPPUNIT_ASSERT( usage.getUsage() == (unsigned long long) Integer::MAX_VALUE );
+
+    usage.increaseUsage( 1024 );
+    CPPUNIT_ASSERT( usage.getUsage() == (unsigned long long) Integer::MAX_VALUE );
+
+    usage.decreaseUsage( (unsigned long long) Integer::MAX_VALUE + 1024 );
+    CPPUNIT_ASSERT( !usage.isFull() );
+    CPPUNIT_ASSERT( usage.getUsage() == 0 );
+}
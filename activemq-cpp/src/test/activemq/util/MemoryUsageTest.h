@@ -31,6 +31,7 @@ namespace util {
         CPPUNIT_TEST( testUsage );
         CPPUNIT_TEST( testTimedWait );
         CPPUNIT_TEST( testWait );
+        CPPUNIT_TEST( testUsageSaturates );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -42,6 +43,7 @@ namespace util {
         void testUsage();
         void testTimedWait();
         void testWait();
+        void testUsageSaturates();
 
     };
 
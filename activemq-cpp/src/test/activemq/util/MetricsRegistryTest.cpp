@@ -0,0 +1,216 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MetricsRegistryTest.h"
+
+#include <activemq/util/MetricsRegistry.h>
+#include <activemq/util/MetricsReporter.h>
+
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+
+#include <sstream>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::util;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class Recorder : public Runnable {
+    private:
+
+        MetricsRegistry* registry;
+        int iterations;
+
+    public:
+
+        Recorder(MetricsRegistry* registry, int iterations) : Runnable(), registry(registry), iterations(iterations) {
+        }
+
+        virtual ~Recorder() {}
+
+        virtual void run() {
+            for (int i = 0; i < iterations; ++i) {
+                registry->increment(MetricsRegistry::MESSAGES_SENT);
+                registry->increment(MetricsRegistry::BYTES_SENT, 10);
+                registry->record(MetricsRegistry::SEND_LATENCY, i % 100);
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MetricsRegistryTest::testCounters() {
+
+    MetricsRegistry registry;
+
+    registry.increment(MetricsRegistry::MESSAGES_RECEIVED);
+    registry.increment(MetricsRegistry::MESSAGES_RECEIVED);
+    registry.increment(MetricsRegistry::BYTES_RECEIVED, 512);
+
+    MetricsSnapshot snapshot = registry.snapshot();
+    CPPUNIT_ASSERT_EQUAL(2LL, snapshot.getCounter(MetricsRegistry::MESSAGES_RECEIVED));
+    CPPUNIT_ASSERT_EQUAL(512LL, snapshot.getCounter(MetricsRegistry::BYTES_RECEIVED));
+    CPPUNIT_ASSERT_EQUAL(0LL, snapshot.getCounter(MetricsRegistry::RECONNECTS));
+    CPPUNIT_ASSERT_EQUAL(0LL, snapshot.getCounter(MetricsRegistry::COUNTER_COUNT));
+    CPPUNIT_ASSERT(snapshot.getTimestamp() > 0);
+
+    registry.reset();
+    CPPUNIT_ASSERT_EQUAL(0LL, registry.snapshot().getCounter(MetricsRegistry::MESSAGES_RECEIVED));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MetricsRegistryTest::testHistograms() {
+
+    MetricsRegistry registry;
+
+    for (int i = 1; i <= 100; ++i) {
+        registry.record(MetricsRegistry::ACK_LATENCY, i);
+    }
+
+    MetricsSnapshot::Summary summary = registry.snapshot().getHistogram(MetricsRegistry::ACK_LATENCY);
+    CPPUNIT_ASSERT_EQUAL(100LL, summary.count);
+    CPPUNIT_ASSERT_EQUAL(1LL, summary.min);
+    CPPUNIT_ASSERT_EQUAL(100LL, summary.max);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(50.5, summary.mean, 0.001);
+    CPPUNIT_ASSERT(summary.p50 >= 50 && summary.p50 <= 53);
+    CPPUNIT_ASSERT(summary.p99 >= 99 && summary.p99 <= 100);
+
+    summary = registry.snapshot().getHistogram(MetricsRegistry::LISTENER_TIME);
+    CPPUNIT_ASSERT_EQUAL(0LL, summary.count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MetricsRegistryTest::testConcurrentUpdates() {
+
+    static const int THREADS = 8;
+    static const int ITERATIONS = 5000;
+
+    MetricsRegistry registry;
+    Recorder recorder(&registry, ITERATIONS);
+
+    Thread* threads[THREADS];
+    for (int i = 0; i < THREADS; ++i) {
+        threads[i] = new Thread(&recorder);
+        threads[i]->start();
+    }
+
+    for (int i = 0; i < THREADS; ++i) {
+        threads[i]->join();
+        delete threads[i];
+    }
+
+    MetricsSnapshot snapshot = registry.snapshot();
+    CPPUNIT_ASSERT_EQUAL((long long) THREADS * ITERATIONS, snapshot.getCounter(MetricsRegistry::MESSAGES_SENT));
+    CPPUNIT_ASSERT_EQUAL((long long) THREADS * ITERATIONS * 10, snapshot.getCounter(MetricsRegistry::BYTES_SENT));
+    CPPUNIT_ASSERT_EQUAL((long long) THREADS * ITERATIONS, snapshot.getHistogram(MetricsRegistry::SEND_LATENCY).count);
+    CPPUNIT_ASSERT_EQUAL(99LL, snapshot.getHistogram(MetricsRegistry::SEND_LATENCY).max);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MetricsRegistryTest::testManyRegistries() {
+
+    static const int REGISTRIES = 40;
+
+    MetricsRegistry registries[REGISTRIES];
+
+    // Every registry keeps its own stripes for the same thread slot.
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < REGISTRIES; ++i) {
+            registries[i].increment(MetricsRegistry::MESSAGES_SENT, i + 1);
+        }
+    }
+
+    for (int i = 0; i < REGISTRIES; ++i) {
+        CPPUNIT_ASSERT_EQUAL(3LL * (i + 1), registries[i].snapshot().getCounter(MetricsRegistry::MESSAGES_SENT));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MetricsRegistryTest::testShortLivedThreads() {
+
+    static const int ROUNDS = 50;
+    static const int THREADS = 4;
+    static const int ITERATIONS = 10;
+
+    MetricsRegistry registry;
+    Recorder recorder(&registry, ITERATIONS);
+
+    // Far more threads come and go than there are stripes, exited threads give
+    // their slot back so the stripes are reused rather than added.
+    for (int round = 0; round < ROUNDS; ++round) {
+        Thread* threads[THREADS];
+        for (int i = 0; i < THREADS; ++i) {
+            threads[i] = new Thread(&recorder);
+            threads[i]->start();
+        }
+        for (int i = 0; i < THREADS; ++i) {
+            threads[i]->join();
+            delete threads[i];
+        }
+
+        CPPUNIT_ASSERT(registry.getStripeCount() <= MetricsRegistry::MAX_STRIPES);
+    }
+
+    MetricsSnapshot snapshot = registry.snapshot();
+    CPPUNIT_ASSERT_EQUAL((long long) ROUNDS * THREADS * ITERATIONS, snapshot.getCounter(MetricsRegistry::MESSAGES_SENT));
+    CPPUNIT_ASSERT_EQUAL((long long) ROUNDS * THREADS * ITERATIONS, snapshot.getHistogram(MetricsRegistry::SEND_LATENCY).count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MetricsRegistryTest::testSnapshotFormats() {
+
+    MetricsRegistry registry;
+    registry.increment(MetricsRegistry::ACKS_SENT, 3);
+    registry.record(MetricsRegistry::MARSHAL_TIME, 12);
+
+    MetricsSnapshot snapshot = registry.snapshot();
+
+    std::string text = snapshot.toText();
+    CPPUNIT_ASSERT(text.find("acksSent=3") != std::string::npos);
+    CPPUNIT_ASSERT(text.find("marshalTimeMicros={count=1") != std::string::npos);
+
+    std::string json = snapshot.toJSON();
+    CPPUNIT_ASSERT_EQUAL('{', json[0]);
+    CPPUNIT_ASSERT_EQUAL('}', json[json.length() - 1]);
+    CPPUNIT_ASSERT(json.find("\"acksSent\":3") != std::string::npos);
+    CPPUNIT_ASSERT(json.find("\"marshalTimeMicros\":{\"count\":1,\"min\":12") != std::string::npos);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MetricsRegistryTest::testReporter() {
+
+    decaf::lang::Pointer<MetricsRegistry> registry(new MetricsRegistry());
+    registry->increment(MetricsRegistry::RECONNECTS);
+
+    std::ostringstream stream;
+    MetricsReporter reporter(registry, &stream, MetricsReporter::parseFormat("JSON"));
+    reporter.run();
+
+    CPPUNIT_ASSERT(stream.str().find("\"reconnects\":1") != std::string::npos);
+    CPPUNIT_ASSERT_EQUAL(MetricsReporter::TEXT, MetricsReporter::parseFormat("text"));
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        MetricsReporter::parseFormat("xml"),
+        IllegalArgumentException);
+}
@@ -225,6 +225,26 @@ void PrimitiveMapTest::testCopy(){
     CPPUNIT_ASSERT( pmap.equals( copy1 ) );
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void PrimitiveMapTest::testPutValue(){
+
+    PrimitiveMap pmap;
+    PrimitiveValueNode value( std::string( "first" ) );
+
+    pmap.putValue( "key", value );
+    CPPUNIT_ASSERT( value.getType() == PrimitiveValueNode::NULL_TYPE );
+    CPPUNIT_ASSERT( pmap.getString( "key" ) == "first" );
+
+    value.setInt( 10 );
+    pmap.putValue( "key", value );
+    CPPUNIT_ASSERT( pmap.getInt( "key" ) == 10 );
+    CPPUNIT_ASSERT( value.getString() == "first" );
+
+    pmap.setString( "key", "second" );
+    CPPUNIT_ASSERT( pmap.getString( "key" ) == "second" );
+    CPPUNIT_ASSERT( pmap.size() == 1 );
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void PrimitiveMapTest::testClear(){
 
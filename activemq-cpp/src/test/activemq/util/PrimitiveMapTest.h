@@ -35,6 +35,7 @@ namespace util{
         CPPUNIT_TEST( testCount );
         CPPUNIT_TEST( testClear );
         CPPUNIT_TEST( testCopy );
+        CPPUNIT_TEST( testPutValue );
         CPPUNIT_TEST( testContains );
         CPPUNIT_TEST( testGetKeys );
         CPPUNIT_TEST_SUITE_END();
@@ -49,6 +50,7 @@ namespace util{
         void testRemove();
         void testCount();
         void testCopy();
+        void testPutValue();
         void testClear();
         void testContains();
         void testGetKeys();
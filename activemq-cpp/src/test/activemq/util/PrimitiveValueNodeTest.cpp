@@ -120,3 +120,39 @@ void PrimitiveValueNodeTest::testValueNodeCtors(){
     CPPUNIT_ASSERT( strValue.getType() == PrimitiveValueNode::STRING_TYPE );
     CPPUNIT_ASSERT( bArrayValue.getType() == PrimitiveValueNode::BYTE_ARRAY_TYPE );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void PrimitiveValueNodeTest::testSwap(){
+
+    std::vector<unsigned char> bytes;
+    bytes.push_back( 1 );
+    bytes.push_back( 2 );
+
+    PrimitiveValueNode strValue = "short";
+    PrimitiveValueNode bArrayValue = bytes;
+    PrimitiveValueNode ivalue = (int)42;
+
+    strValue.swap( bArrayValue );
+    CPPUNIT_ASSERT( strValue.getType() == PrimitiveValueNode::BYTE_ARRAY_TYPE );
+    CPPUNIT_ASSERT( strValue.getByteArray() == bytes );
+    CPPUNIT_ASSERT( bArrayValue.getType() == PrimitiveValueNode::STRING_TYPE );
+    CPPUNIT_ASSERT( bArrayValue.getString() == "short" );
+
+    ivalue.swap( bArrayValue );
+    CPPUNIT_ASSERT( ivalue.getString() == "short" );
+    CPPUNIT_ASSERT( bArrayValue.getInt() == 42 );
+
+    // Overwriting a string in place must keep the value intact.
+    std::string longText( 256, 'x' );
+    ivalue.setString( longText );
+    CPPUNIT_ASSERT( ivalue.getString() == longText );
+    ivalue.setString( "s" );
+    CPPUNIT_ASSERT( ivalue.getString() == "s" );
+
+    PrimitiveValueNode copy = ivalue;
+    ivalue.setInt( 1 );
+    CPPUNIT_ASSERT( copy.getString() == "s" );
+
+    copy = copy;
+    CPPUNIT_ASSERT( copy.getString() == "s" );
+}
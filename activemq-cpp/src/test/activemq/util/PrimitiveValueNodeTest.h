@@ -31,6 +31,7 @@ namespace util{
         CPPUNIT_TEST_SUITE( PrimitiveValueNodeTest );
         CPPUNIT_TEST( testValueNode );
         CPPUNIT_TEST( testValueNodeCtors );
+        CPPUNIT_TEST( testSwap );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -40,6 +41,7 @@ namespace util{
 
         void testValueNode();
         void testValueNodeCtors();
+        void testSwap();
 
     };
 
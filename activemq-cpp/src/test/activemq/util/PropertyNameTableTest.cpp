@@ -0,0 +1,177 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PropertyNameTableTest.h"
+
+#include <activemq/util/PropertyNameTable.h>
+#include <activemq/util/PrimitiveMap.h>
+#include <activemq/wireformat/openwire/marshal/PrimitiveTypesMarshaller.h>
+
+#include <decaf/io/ByteArrayInputStream.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataInputStream.h>
+#include <decaf/io/DataOutputStream.h>
+
+#include <vector>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::util;
+using namespace activemq::wireformat::openwire::marshal;
+using namespace decaf::io;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class NameReader : public PrimitiveTypesMarshaller {
+    public:
+
+        static const std::string* read(DataInputStream& dataIn, std::string& scratch) {
+            return PrimitiveTypesMarshaller::unmarshalPropertyName(dataIn, scratch);
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PropertyNameTableTest::PropertyNameTableTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PropertyNameTableTest::~PropertyNameTableTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PropertyNameTableTest::testIntern() {
+
+    std::string name = "PropertyNameTableTest.testIntern";
+
+    const std::string* first = PropertyNameTable::intern(name);
+    CPPUNIT_ASSERT(first != NULL);
+    CPPUNIT_ASSERT_EQUAL(name, *first);
+
+    int size = PropertyNameTable::size();
+
+    const std::string* second = PropertyNameTable::intern(name.c_str(), name.length());
+    CPPUNIT_ASSERT(first == second);
+    CPPUNIT_ASSERT_EQUAL(size, PropertyNameTable::size());
+
+    // Only the given number of characters take part in the name.
+    const std::string* prefix = PropertyNameTable::intern(name.c_str(), 8);
+    CPPUNIT_ASSERT(prefix != NULL);
+    CPPUNIT_ASSERT(prefix != first);
+    CPPUNIT_ASSERT_EQUAL(std::string("Property"), *prefix);
+
+    const std::string* empty = PropertyNameTable::intern(std::string());
+    CPPUNIT_ASSERT(empty != NULL);
+    CPPUNIT_ASSERT(empty->empty());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PropertyNameTableTest::testLookup() {
+
+    CPPUNIT_ASSERT(PropertyNameTable::lookup("PropertyNameTableTest.testLookup") == NULL);
+
+    const std::string* name = PropertyNameTable::intern("PropertyNameTableTest.testLookup");
+    CPPUNIT_ASSERT(name != NULL);
+    CPPUNIT_ASSERT(PropertyNameTable::lookup("PropertyNameTableTest.testLookup") == name);
+
+    // The reserved JMSX names are always present.
+    CPPUNIT_ASSERT(PropertyNameTable::lookup("JMSXGroupID") != NULL);
+    CPPUNIT_ASSERT(PropertyNameTable::lookup("JMSXDeliveryCount") != NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PropertyNameTableTest::testNameTooLong() {
+
+    std::string name(PropertyNameTable::MAX_NAME_LENGTH + 1, 'x');
+
+    int size = PropertyNameTable::size();
+    CPPUNIT_ASSERT(PropertyNameTable::intern(name) == NULL);
+    CPPUNIT_ASSERT(PropertyNameTable::lookup(name) == NULL);
+    CPPUNIT_ASSERT_EQUAL(size, PropertyNameTable::size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PropertyNameTableTest::testUnmarshalSharesNames() {
+
+    std::string accented = "caf";
+    accented += (char) 0xE9;
+
+    PrimitiveMap source;
+    source.setString("PropertyNameTableTest.header", "value");
+    source.setInt(accented, 42);
+
+    std::vector<unsigned char> buffer;
+    PrimitiveTypesMarshaller::marshal(&source, buffer);
+
+    PrimitiveMap first;
+    PrimitiveMap second;
+    PrimitiveTypesMarshaller::unmarshal(&first, buffer);
+    PrimitiveTypesMarshaller::unmarshal(&second, buffer);
+
+    CPPUNIT_ASSERT(source.equals(first));
+    CPPUNIT_ASSERT(source.equals(second));
+    CPPUNIT_ASSERT_EQUAL(42, first.getInt(accented));
+
+    CPPUNIT_ASSERT(PropertyNameTable::lookup("PropertyNameTableTest.header") != NULL);
+    CPPUNIT_ASSERT(PropertyNameTable::lookup(accented) != NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PropertyNameTableTest::testRepeatedNamesShareAtom() {
+
+    std::string tooLong(PropertyNameTable::MAX_NAME_LENGTH + 1, 'x');
+
+    ByteArrayOutputStream bytesOut;
+    DataOutputStream dataOut(&bytesOut);
+    dataOut.writeUTF("PropertyNameTableTest.repeated");
+    dataOut.writeUTF("PropertyNameTableTest.other");
+    dataOut.writeUTF("PropertyNameTableTest.repeated");
+    dataOut.writeUTF(tooLong);
+    dataOut.close();
+
+    std::pair<unsigned char*, int> array = bytesOut.toByteArray();
+    ByteArrayInputStream bytesIn(array.first, array.second, true);
+    DataInputStream dataIn(&bytesIn);
+
+    std::string scratch;
+    const std::string* first = NameReader::read(dataIn, scratch);
+    const std::string* other = NameReader::read(dataIn, scratch);
+    const std::string* second = NameReader::read(dataIn, scratch);
+
+    CPPUNIT_ASSERT(first != NULL);
+    CPPUNIT_ASSERT(other != NULL);
+    CPPUNIT_ASSERT(first == second);
+    CPPUNIT_ASSERT(first != other);
+    CPPUNIT_ASSERT(first == PropertyNameTable::lookup("PropertyNameTableTest.repeated"));
+
+    // Names that can't be interned are still decoded into the scratch string.
+    CPPUNIT_ASSERT(NameReader::read(dataIn, scratch) == NULL);
+    CPPUNIT_ASSERT_EQUAL(tooLong, scratch);
+
+    // The map finds the node for an atom it has seen by its address.
+    PrimitiveMap map;
+    PrimitiveValueNode& node = map.getInternedValueNode(first);
+    node.setInt(1);
+    CPPUNIT_ASSERT(&map.getInternedValueNode(second) == &node);
+    CPPUNIT_ASSERT_EQUAL(1, map.getInt("PropertyNameTableTest.repeated"));
+    CPPUNIT_ASSERT_EQUAL(1, map.size());
+
+    map.remove("PropertyNameTableTest.repeated");
+    CPPUNIT_ASSERT(map.getInternedValueNode(first).getType() == PrimitiveValueNode::NULL_TYPE);
+    CPPUNIT_ASSERT_EQUAL(1, map.size());
+}
@@ -22,11 +22,28 @@
 #include <activemq/wireformat/openwire/OpenWireFormat.h>
 
 #include <activemq/core/ActiveMQConnectionMetaData.h>
+#include <activemq/commands/ActiveMQQueue.h>
+#include <activemq/commands/ActiveMQTextMessage.h>
+#include <activemq/commands/BrokerId.h>
+#include <activemq/commands/ConsumerId.h>
+#include <activemq/commands/MessageDispatch.h>
+#include <activemq/commands/MessageId.h>
+#include <activemq/commands/ProducerId.h>
+#include <activemq/transport/mock/MockTransport.h>
+#include <activemq/wireformat/openwire/OpenWireResponseBuilder.h>
+
+#include <decaf/io/ByteArrayInputStream.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataInputStream.h>
+#include <decaf/io/DataOutputStream.h>
 
 using namespace std;
 using namespace activemq;
 using namespace activemq::util;
 using namespace activemq::core;
+using namespace activemq::commands;
+using namespace activemq::transport;
+using namespace activemq::transport::mock;
 using namespace decaf::io;
 using namespace decaf::lang;
 using namespace decaf::util;
@@ -50,3 +67,155 @@ void OpenWireFormatTest::testProviderInfoInWireFormat() {
             myWireFormat->getPreferedWireFormatInfo()->getProperties().getString("ProviderVersion"));
     CPPUNIT_ASSERT(!myWireFormat->getPreferedWireFormatInfo()->getProperties().getString("PlatformDetails").empty());
 }
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    Pointer<Command> createDispatch() {
+
+        Pointer<ProducerId> producerId(new ProducerId());
+        producerId->setConnectionId("ID:fast-path-test");
+        producerId->setSessionId(1);
+        producerId->setValue(2);
+
+        Pointer<MessageId> messageId(new MessageId());
+        messageId->setProducerId(producerId);
+        messageId->setProducerSequenceId(123456789012LL);
+
+        Pointer<ActiveMQTextMessage> message(new ActiveMQTextMessage());
+        message->setMessageId(messageId);
+        message->setDestination(Pointer<ActiveMQDestination>(new ActiveMQQueue("fast.path")));
+        message->setText("A message body long enough to need more than a few bytes of frame.");
+        message->setIntProperty("count", 42);
+        message->setStringProperty("name", "value");
+        message->setTimestamp(1234567890123LL);
+        message->setExpiration(65535);
+        message->setPriority(7);
+
+        Pointer<BrokerId> brokerId(new BrokerId());
+        brokerId->setValue("broker-1");
+        message->getBrokerPath().push_back(brokerId);
+
+        Pointer<ConsumerId> consumerId(new ConsumerId());
+        consumerId->setConnectionId("ID:fast-path-test");
+        consumerId->setSessionId(1);
+        consumerId->setValue(3);
+
+        Pointer<MessageDispatch> dispatch(new MessageDispatch());
+        dispatch->setConsumerId(consumerId);
+        dispatch->setDestination(message->getDestination());
+        dispatch->setMessage(message);
+        dispatch->setRedeliveryCounter(2);
+
+        return dispatch;
+    }
+
+    Pointer<OpenWireFormat> createTightFormat(bool sizePrefixDisabled) {
+        Properties properties;
+        Pointer<OpenWireFormat> format(new OpenWireFormat(properties));
+        format->setVersion(OpenWireFormat::MAX_SUPPORTED_VERSION);
+        format->setTightEncodingEnabled(true);
+        format->setSizePrefixDisabled(sizePrefixDisabled);
+        return format;
+    }
+
+    std::vector<unsigned char> marshalCommand(const Pointer<OpenWireFormat>& format, const Pointer<Command>& command) {
+
+        MockTransport transport(format, Pointer<ResponseBuilder>(new OpenWireResponseBuilder()));
+
+        ByteArrayOutputStream bytesOut;
+        DataOutputStream dataOut(&bytesOut);
+        format->marshal(command, &transport, &dataOut);
+
+        std::pair<unsigned char*, int> array = bytesOut.toByteArray();
+        std::vector<unsigned char> result(array.first, array.first + array.second);
+        delete [] array.first;
+        return result;
+    }
+
+    Pointer<Command> unmarshalCommand(const Pointer<OpenWireFormat>& format, const std::vector<unsigned char>& bytes) {
+
+        MockTransport transport(format, Pointer<ResponseBuilder>(new OpenWireResponseBuilder()));
+
+        ByteArrayInputStream bytesIn(bytes);
+        DataInputStream dataIn(&bytesIn);
+        return format->unmarshal(&transport, &dataIn);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::testTightFramesMatchStreamEncoding() {
+
+    // Size prefixed tight frames go through the buffered fast path while frames
+    // without a size prefix still use the stream marshalers, both must produce
+    // the same encoding.
+    Pointer<OpenWireFormat> fastFormat = createTightFormat(false);
+    Pointer<OpenWireFormat> streamFormat = createTightFormat(true);
+
+    Pointer<Command> command = createDispatch();
+
+    std::vector<unsigned char> fastBytes = marshalCommand(fastFormat, command);
+    std::vector<unsigned char> streamBytes = marshalCommand(streamFormat, command);
+
+    CPPUNIT_ASSERT_EQUAL(streamBytes.size() + 4, fastBytes.size());
+    CPPUNIT_ASSERT(std::equal(streamBytes.begin(), streamBytes.end(), fastBytes.begin() + 4));
+
+    int size = (fastBytes[0] << 24) | (fastBytes[1] << 16) | (fastBytes[2] << 8) | fastBytes[3];
+    CPPUNIT_ASSERT_EQUAL((int) streamBytes.size(), size);
+
+    Pointer<Command> fastResult = unmarshalCommand(fastFormat, fastBytes);
+    Pointer<Command> streamResult = unmarshalCommand(streamFormat, streamBytes);
+
+    CPPUNIT_ASSERT(fastResult->equals(command.get()));
+    CPPUNIT_ASSERT(streamResult->equals(fastResult.get()));
+
+    Pointer<MessageDispatch> dispatch = fastResult.dynamicCast<MessageDispatch>();
+    Pointer<ActiveMQTextMessage> message = dispatch->getMessage().dynamicCast<ActiveMQTextMessage>();
+    CPPUNIT_ASSERT_EQUAL(std::string("A message body long enough to need more than a few bytes of frame."), message->getText());
+    CPPUNIT_ASSERT_EQUAL(42, message->getIntProperty("count"));
+    CPPUNIT_ASSERT_EQUAL(std::string("value"), message->getStringProperty("name"));
+    CPPUNIT_ASSERT_EQUAL(std::string("broker-1"), message->getBrokerPath()[0]->getValue());
+    CPPUNIT_ASSERT_EQUAL(2, dispatch->getRedeliveryCounter());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::testTruncatedTightFrame() {
+
+    Pointer<OpenWireFormat> format = createTightFormat(false);
+
+    std::vector<unsigned char> bytes = marshalCommand(format, createDispatch());
+
+    // Shorten the frame and its size prefix so the frame itself is complete
+    // but ends before the last fields of the command.
+    int size = (int) bytes.size() - 4 - 8;
+    bytes.resize(bytes.size() - 8);
+    bytes[0] = (unsigned char) (size >> 24);
+    bytes[1] = (unsigned char) (size >> 16);
+    bytes[2] = (unsigned char) (size >> 8);
+    bytes[3] = (unsigned char) size;
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        unmarshalCommand(format, bytes),
+        IOException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::testOversizedFrameRejected() {
+
+    Pointer<OpenWireFormat> format = createTightFormat(false);
+    format->setMaxFrameSize(1024);
+
+    // Only the size prefix is sent, the format must refuse it without trying
+    // to read or buffer the claimed frame.
+    std::vector<unsigned char> bytes(4);
+    bytes[0] = 0x7F;
+    bytes[1] = 0xFF;
+    bytes[2] = 0xFF;
+    bytes[3] = 0xFF;
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        unmarshalCommand(format, bytes),
+        IOException);
+}
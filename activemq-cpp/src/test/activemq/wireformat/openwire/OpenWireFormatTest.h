@@ -29,6 +29,9 @@ namespace openwire {
 
         CPPUNIT_TEST_SUITE( OpenWireFormatTest );
         CPPUNIT_TEST( testProviderInfoInWireFormat );
+        CPPUNIT_TEST( testTightFramesMatchStreamEncoding );
+        CPPUNIT_TEST( testTruncatedTightFrame );
+        CPPUNIT_TEST( testOversizedFrameRejected );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -37,6 +40,9 @@ namespace openwire {
         virtual ~OpenWireFormatTest() {}
 
         virtual void testProviderInfoInWireFormat();
+        virtual void testTightFramesMatchStreamEncoding();
+        virtual void testTruncatedTightFrame();
+        virtual void testOversizedFrameRejected();
 
     };
 
@@ -0,0 +1,109 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FrameReaderTest.h"
+
+#include <activemq/wireformat/openwire/utils/FrameReader.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/io/IOException.h>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::io;
+using namespace activemq;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace activemq::wireformat::openwire::utils;
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameReaderTest::testMatchesDataInputStream() {
+
+    ByteArrayOutputStream bytesOut;
+    DataOutputStream dataOut(&bytesOut);
+
+    std::string utf("caf\xE9");
+    const unsigned char raw[] = { 1, 2, 3, 4 };
+
+    dataOut.writeBoolean(true);
+    dataOut.writeByte(0xF0);
+    dataOut.writeShort(-2);
+    dataOut.writeShort((short) 0xFFFE);
+    dataOut.writeInt(-123456789);
+    dataOut.writeLong(-1234567890123456789LL);
+    dataOut.writeUTF(utf);
+    dataOut.writeShort(5);
+    dataOut.writeBytes("ascii");
+    dataOut.write(raw, 4, 0, 4);
+
+    std::pair<unsigned char*, int> array = bytesOut.toByteArray();
+    std::vector<unsigned char> frame(array.first, array.first + array.second);
+    delete [] array.first;
+
+    FrameReader reader(&frame[0], (int) frame.size());
+
+    CPPUNIT_ASSERT_EQUAL(true, reader.readBoolean());
+    CPPUNIT_ASSERT_EQUAL((unsigned char) 0xF0, reader.readByte());
+    CPPUNIT_ASSERT_EQUAL((short) -2, reader.readShort());
+    CPPUNIT_ASSERT_EQUAL((unsigned short) 0xFFFE, reader.readUnsignedShort());
+    CPPUNIT_ASSERT_EQUAL(-123456789, reader.readInt());
+    CPPUNIT_ASSERT_EQUAL(-1234567890123456789LL, reader.readLong());
+    CPPUNIT_ASSERT_EQUAL(utf, reader.readUTF());
+    CPPUNIT_ASSERT_EQUAL(std::string("ascii"), reader.readString(reader.readShort()));
+
+    unsigned char buffer[4] = { 0 };
+    reader.readFully(buffer, 4);
+    CPPUNIT_ASSERT(std::equal(buffer, buffer + 4, raw));
+
+    CPPUNIT_ASSERT_EQUAL(0, reader.remaining());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameReaderTest::testUnderflow() {
+
+    const unsigned char frame[] = { 0, 0, 0, 1, 9, 9, 9 };
+
+    FrameReader reader(frame, 7);
+    CPPUNIT_ASSERT_EQUAL(1, reader.readInt());
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        reader.readInt(),
+        IOException);
+
+    // A failed read consumes nothing.
+    CPPUNIT_ASSERT_EQUAL(3, reader.remaining());
+
+    unsigned char buffer[8];
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        reader.readFully(buffer, 8),
+        IOException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        reader.readFully(buffer, -1),
+        IOException);
+
+    // A UTF string whose length runs past the end of the frame.
+    const unsigned char utf[] = { 0, 9, 'a', 'b' };
+    FrameReader utfReader(utf, 4);
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        utfReader.readUTF(),
+        IOException);
+}
@@ -0,0 +1,102 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FrameWriterTest.h"
+
+#include <activemq/wireformat/openwire/utils/FrameWriter.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/io/IOException.h>
+#include <decaf/lang/exceptions/IndexOutOfBoundsException.h>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang::exceptions;
+using namespace activemq;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace activemq::wireformat::openwire::utils;
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameWriterTest::testMatchesDataOutputStream() {
+
+    std::string utf("caf\xE9");
+    const unsigned char raw[] = { 1, 2, 3, 4, 5, 6 };
+
+    ByteArrayOutputStream bytesOut;
+    DataOutputStream dataOut(&bytesOut);
+
+    dataOut.writeBoolean(true);
+    dataOut.writeByte(0xF0);
+    dataOut.writeShort(-2);
+    dataOut.writeInt(-123456789);
+    dataOut.writeLong(-1234567890123456789LL);
+    dataOut.writeUTF(utf);
+    dataOut.writeBytes("ascii");
+    dataOut.write(raw, 6, 2, 3);
+
+    std::pair<unsigned char*, int> array = bytesOut.toByteArray();
+    std::vector<unsigned char> expected(array.first, array.first + array.second);
+    delete [] array.first;
+
+    std::vector<unsigned char> frame(expected.size());
+    FrameWriter writer(&frame[0], (int) frame.size());
+
+    writer.writeBoolean(true);
+    writer.writeByte(0xF0);
+    writer.writeShort(-2);
+    writer.writeInt(-123456789);
+    writer.writeLong(-1234567890123456789LL);
+    writer.writeUTF(utf);
+    writer.writeBytes("ascii");
+    writer.write(raw, 6, 2, 3);
+
+    CPPUNIT_ASSERT_EQUAL(0, writer.remaining());
+    CPPUNIT_ASSERT(expected == frame);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FrameWriterTest::testOverflow() {
+
+    unsigned char frame[6];
+    FrameWriter writer(frame, 6);
+
+    writer.writeInt(1);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        writer.writeInt(2),
+        IOException);
+
+    // A failed write leaves the remaining space untouched.
+    CPPUNIT_ASSERT_EQUAL(2, writer.remaining());
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        writer.writeUTF("abc"),
+        IOException);
+
+    const unsigned char raw[] = { 1, 2 };
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IndexOutOfBoundsException",
+        writer.write(raw, 2, 1, 2),
+        IndexOutOfBoundsException);
+
+    writer.writeShort(3);
+    CPPUNIT_ASSERT_EQUAL(0, writer.remaining());
+}
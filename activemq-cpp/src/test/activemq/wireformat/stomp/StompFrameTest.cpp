@@ -0,0 +1,333 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StompFrameTest.h"
+
+#include <activemq/wireformat/stomp/StompFrame.h>
+#include <activemq/wireformat/stomp/StompCommandConstants.h>
+
+#include <decaf/io/BufferedInputStream.h>
+#include <decaf/io/ByteArrayInputStream.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataInputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/lang/Integer.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::stomp;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    std::vector<unsigned char> toBytes(const std::string& value) {
+        return std::vector<unsigned char>(value.begin(), value.end());
+    }
+
+    std::vector<unsigned char> marshal(const StompFrame& frame, bool stomp11 = false) {
+        ByteArrayOutputStream bytesOut;
+        DataOutputStream dataOut(&bytesOut);
+        frame.toStream(&dataOut, stomp11);
+
+        std::pair<unsigned char*, int> array = bytesOut.toByteArray();
+        std::vector<unsigned char> result(array.first, array.first + array.second);
+        delete [] array.first;
+        return result;
+    }
+
+    void readFrames(DataInputStream& dataIn) {
+
+        StompFrame first;
+        first.fromStream(&dataIn);
+        CPPUNIT_ASSERT_EQUAL(std::string("MESSAGE"), first.getCommand());
+        CPPUNIT_ASSERT_EQUAL(std::string("/queue/a"), first.getProperty("destination"));
+        CPPUNIT_ASSERT_EQUAL((std::size_t) 6, first.getBodyLength());
+        CPPUNIT_ASSERT(first.getBody() == toBytes(std::string("hi", 2) + std::string(1, '\0') + "you"));
+
+        StompFrame second;
+        second.fromStream(&dataIn);
+        CPPUNIT_ASSERT_EQUAL(std::string("RECEIPT"), second.getCommand());
+        CPPUNIT_ASSERT_EQUAL(std::string("77"), second.getProperty("receipt-id"));
+        CPPUNIT_ASSERT_EQUAL((std::size_t) 1, second.getBodyLength());
+
+        StompFrame third;
+        third.fromStream(&dataIn);
+        CPPUNIT_ASSERT_EQUAL(std::string("MESSAGE"), third.getCommand());
+        CPPUNIT_ASSERT_EQUAL(std::string("text"), third.getProperty("type"));
+        CPPUNIT_ASSERT(third.getBody() == toBytes(std::string("plain text") + std::string(1, '\0')));
+
+        CPPUNIT_ASSERT_EQUAL(std::string("tail"), dataIn.readLine());
+    }
+
+    std::vector<unsigned char> consecutiveFrames() {
+        std::string frames;
+        frames += "\n\n";
+        frames += "MESSAGE\ndestination:/queue/a\ncontent-length:6\n\nhi";
+        frames += '\0';
+        frames += "you";
+        frames += '\0';
+        frames += "\n";
+        frames += "RECEIPT\nreceipt-id:77\n\n";
+        frames += '\0';
+        frames += "\n\n";
+        frames += "MESSAGE\ntype:text\n\nplain text";
+        frames += '\0';
+        frames += "\ntail\n";
+        return toBytes(frames);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+StompFrameTest::StompFrameTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+StompFrameTest::~StompFrameTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameTest::testRoundTrip() {
+
+    StompFrame frame;
+    frame.setCommand("SEND");
+    frame.setProperty("destination", "/queue/test");
+    frame.setProperty("persistent", "true");
+    frame.setProperty("persistent", "false");
+    frame.setProperty(StompCommandConstants::HEADER_CONTENTLENGTH, "5");
+    frame.setBody((const unsigned char*) "hello", 5);
+
+    CPPUNIT_ASSERT_EQUAL((std::size_t) 3, frame.getHeaders().size());
+    CPPUNIT_ASSERT_EQUAL(std::string("false"), frame.getProperty("persistent"));
+    CPPUNIT_ASSERT_EQUAL(std::string("fallback"), frame.getProperty("missing", "fallback"));
+
+    std::vector<unsigned char> bytes = marshal(frame);
+    CPPUNIT_ASSERT(bytes == toBytes(std::string(
+        "SEND\ndestination:/queue/test\npersistent:false\ncontent-length:5\n\nhello") + std::string(1, '\0') + "\n"));
+
+    ByteArrayInputStream bytesIn(bytes);
+    DataInputStream dataIn(&bytesIn);
+
+    StompFrame result;
+    result.fromStream(&dataIn);
+
+    CPPUNIT_ASSERT_EQUAL(frame.getCommand(), result.getCommand());
+    CPPUNIT_ASSERT(frame.getHeaders() == result.getHeaders());
+    CPPUNIT_ASSERT(frame.getBody() == result.getBody());
+    CPPUNIT_ASSERT_EQUAL(1, dataIn.available());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameTest::testLastHeaderWins() {
+
+    std::string input = "MESSAGE\nfoo:first\nnot a header\nfoo:second\nbar:a:b\n\n";
+    input += '\0';
+
+    ByteArrayInputStream bytesIn(toBytes(input));
+    DataInputStream dataIn(&bytesIn);
+
+    StompFrame frame;
+    frame.fromStream(&dataIn);
+
+    CPPUNIT_ASSERT_EQUAL((std::size_t) 2, frame.getHeaders().size());
+    CPPUNIT_ASSERT_EQUAL(std::string("second"), frame.getProperty("foo"));
+    CPPUNIT_ASSERT_EQUAL(std::string("a:b"), frame.getProperty("bar"));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameTest::testGetProperties() {
+
+    StompFrame frame;
+    frame.setCommand("SEND");
+    frame.setProperty("destination", "/queue/test");
+    frame.setProperty("persistent", "true");
+
+    decaf::util::Properties& properties = frame.getProperties();
+    CPPUNIT_ASSERT_EQUAL(2, properties.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("/queue/test"), properties.getProperty("destination", ""));
+
+    // Changes go both ways, the order of the remaining headers is kept.
+    properties.setProperty("persistent", "false");
+    properties.setProperty("priority", "4");
+    CPPUNIT_ASSERT_EQUAL(std::string("4"), frame.getProperty("priority"));
+
+    frame.setProperty("expires", "0");
+    CPPUNIT_ASSERT_EQUAL(std::string("0"), properties.getProperty("expires", ""));
+
+    properties.remove("destination");
+    CPPUNIT_ASSERT(!frame.hasProperty("destination"));
+    CPPUNIT_ASSERT_EQUAL((std::size_t) 3, frame.getHeaders().size());
+
+    std::vector<unsigned char> bytes = marshal(frame);
+    CPPUNIT_ASSERT(bytes == toBytes(std::string(
+        "SEND\npersistent:false\npriority:4\nexpires:0\n\n") + std::string(1, '\0') + "\n"));
+
+    // Reading a frame replaces what the Properties hold.
+    ByteArrayInputStream bytesIn(toBytes(std::string("MESSAGE\nfoo:bar\n\n") + std::string(1, '\0')));
+    DataInputStream dataIn(&bytesIn);
+    frame.fromStream(&dataIn);
+
+    CPPUNIT_ASSERT_EQUAL(1, properties.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("bar"), properties.getProperty("foo", ""));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameTest::testConsecutiveFrames() {
+
+    ByteArrayInputStream bytesIn(consecutiveFrames());
+    DataInputStream dataIn(&bytesIn);
+
+    readFrames(dataIn);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameTest::testConsecutiveFramesBuffered() {
+
+    // A tiny buffer forces frames to span several refills of the stream.
+    ByteArrayInputStream bytesIn(consecutiveFrames());
+    BufferedInputStream bufferedIn(&bytesIn, 7);
+    DataInputStream dataIn(&bufferedIn);
+
+    readFrames(dataIn);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameTest::testLargeBody() {
+
+    std::vector<unsigned char> content(100000);
+    for (std::size_t ix = 0; ix < content.size(); ++ix) {
+        content[ix] = (unsigned char) ('a' + ix % 26);
+    }
+
+    StompFrame withLength;
+    withLength.setCommand("MESSAGE");
+    withLength.setProperty(StompCommandConstants::HEADER_CONTENTLENGTH, Integer::toString((int) content.size()));
+    withLength.setBody(&content[0], content.size());
+
+    // Without a content-length the body carries its own terminating null.
+    std::vector<unsigned char> terminated(content);
+    terminated.push_back('\0');
+
+    StompFrame withoutLength;
+    withoutLength.setCommand("MESSAGE");
+    withoutLength.setBody(&terminated[0], terminated.size());
+
+    std::vector<unsigned char> bytes = marshal(withLength);
+    std::vector<unsigned char> more = marshal(withoutLength);
+    bytes.insert(bytes.end(), more.begin(), more.end());
+
+    ByteArrayInputStream bytesIn(bytes);
+    BufferedInputStream bufferedIn(&bytesIn);
+    DataInputStream dataIn(&bufferedIn);
+
+    StompFrame first;
+    first.fromStream(&dataIn);
+    CPPUNIT_ASSERT(content == first.getBody());
+
+    StompFrame second;
+    second.fromStream(&dataIn);
+    CPPUNIT_ASSERT(terminated == second.getBody());
+    CPPUNIT_ASSERT_EQUAL(1, dataIn.available());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameTest::testHeaderEscaping() {
+
+    StompFrame frame;
+    frame.setCommand("SEND");
+    frame.setProperty("key:name", "line\none:two\\three\r");
+    frame.setProperty("plain", "value");
+
+    std::vector<unsigned char> bytes = marshal(frame, true);
+    std::string expected = "SEND\nkey\\cname:line\\none\\ctwo\\\\three\\r\nplain:value\n\n";
+    expected += '\0';
+    expected += "\n";
+    CPPUNIT_ASSERT(bytes == toBytes(expected));
+
+    ByteArrayInputStream bytesIn(bytes);
+    DataInputStream dataIn(&bytesIn);
+
+    StompFrame result;
+    result.fromStream(&dataIn, true);
+    CPPUNIT_ASSERT(frame.getHeaders() == result.getHeaders());
+
+    // Carriage returns ending a line are dropped, an undefined escape is an error.
+    std::string input = "MESSAGE\r\nfoo:a\\rb\r\n\r\n";
+    input += '\0';
+    input += "MESSAGE\nfoo:\\t\n\n";
+    input += '\0';
+
+    ByteArrayInputStream moreIn(toBytes(input));
+    DataInputStream moreDataIn(&moreIn);
+
+    StompFrame crlf;
+    crlf.fromStream(&moreDataIn, true);
+    CPPUNIT_ASSERT_EQUAL(std::string("MESSAGE"), crlf.getCommand());
+    CPPUNIT_ASSERT_EQUAL(std::string("a\rb"), crlf.getProperty("foo"));
+
+    StompFrame invalid;
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        invalid.fromStream(&moreDataIn, true),
+        IOException);
+
+    // A 1.0 frame keeps the value as it was sent.
+    ByteArrayInputStream oldIn(bytes);
+    DataInputStream oldDataIn(&oldIn);
+
+    StompFrame old;
+    old.fromStream(&oldDataIn);
+    CPPUNIT_ASSERT_EQUAL(std::string("value"), old.getProperty("plain"));
+    CPPUNIT_ASSERT_EQUAL(std::string("line\\none\\ctwo\\\\three"), old.getProperty("key\\cname"));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompFrameTest::testHeartBeat() {
+
+    std::string input = "\n\r\nSEND\ndestination:/queue/a\n\n";
+    input += '\0';
+    input += "\n";
+
+    ByteArrayInputStream bytesIn(toBytes(input));
+    DataInputStream dataIn(&bytesIn);
+
+    StompFrame first;
+    first.fromStream(&dataIn, true);
+    CPPUNIT_ASSERT(first.isHeartBeat());
+
+    StompFrame second;
+    second.fromStream(&dataIn, true);
+    CPPUNIT_ASSERT(second.isHeartBeat());
+
+    StompFrame third;
+    third.fromStream(&dataIn, true);
+    CPPUNIT_ASSERT(!third.isHeartBeat());
+    CPPUNIT_ASSERT_EQUAL(std::string("SEND"), third.getCommand());
+    CPPUNIT_ASSERT_EQUAL(std::string("/queue/a"), third.getProperty("destination"));
+    CPPUNIT_ASSERT_EQUAL(0, dataIn.available());
+
+    // Before 1.1 the blank lines are skipped over.
+    ByteArrayInputStream oldIn(toBytes(input));
+    DataInputStream oldDataIn(&oldIn);
+
+    StompFrame old;
+    old.fromStream(&oldDataIn);
+    CPPUNIT_ASSERT_EQUAL(std::string("SEND"), old.getCommand());
+}
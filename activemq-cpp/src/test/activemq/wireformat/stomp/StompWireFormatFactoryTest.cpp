@@ -43,10 +43,18 @@ void StompWireFormatFactoryTest::testCreateWireFormat() {
     StompWireFormatFactory factory;
 
     Properties properties;
+
+    // Newer protocol versions are only offered when asked for.
+    Pointer<StompWireFormat> defaults = factory.createWireFormat(properties).dynamicCast<StompWireFormat>();
+    CPPUNIT_ASSERT_EQUAL(std::string("1.0"), defaults->getAcceptVersion());
+
     properties.setProperty("wireFormat.topicPrefix", "/test-topic/");
     properties.setProperty("wireFormat.queuePrefix", "/test-queue/");
     properties.setProperty("wireFormat.tempTopicPrefix", "/test-temp-topic/");
     properties.setProperty("wireFormat.tempQueuePrefix", "/test-temp-queue/");
+    properties.setProperty("wireFormat.acceptVersion", "1.1");
+    properties.setProperty("wireFormat.outgoingHeartBeat", "1000");
+    properties.setProperty("wireFormat.incomingHeartBeat", "2000");
 
     Pointer<WireFormat> format(factory.createWireFormat(properties));
 
@@ -56,4 +64,8 @@ void StompWireFormatFactoryTest::testCreateWireFormat() {
     CPPUNIT_ASSERT_EQUAL(std::string("/test-queue/"), stomp->getQueuePrefix());
     CPPUNIT_ASSERT_EQUAL(std::string("/test-temp-topic/"), stomp->getTempTopicPrefix());
     CPPUNIT_ASSERT_EQUAL(std::string("/test-temp-queue/"), stomp->getTempQueuePrefix());
+    CPPUNIT_ASSERT_EQUAL(std::string("1.1"), stomp->getAcceptVersion());
+    CPPUNIT_ASSERT_EQUAL(1000LL, stomp->getOutgoingHeartBeat());
+    CPPUNIT_ASSERT_EQUAL(2000LL, stomp->getIncomingHeartBeat());
+    CPPUNIT_ASSERT_EQUAL(std::string("1.0"), stomp->getProtocolVersion());
 }
@@ -20,10 +20,134 @@
 #include <activemq/wireformat/stomp/StompFrame.h>
 #include <activemq/wireformat/stomp/StompHelper.h>
 #include <activemq/wireformat/stomp/StompWireFormat.h>
+#include <activemq/wireformat/stomp/StompCommandConstants.h>
+#include <activemq/core/ActiveMQConstants.h>
+#include <activemq/commands/ConnectionInfo.h>
+#include <activemq/commands/KeepAliveInfo.h>
+#include <activemq/commands/MessageAck.h>
+#include <activemq/commands/MessageDispatch.h>
+#include <activemq/commands/Response.h>
+#include <activemq/commands/WireFormatInfo.h>
+#include <activemq/transport/mock/MockTransport.h>
+#include <activemq/wireformat/openwire/OpenWireResponseBuilder.h>
+
+#include <decaf/io/ByteArrayInputStream.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataInputStream.h>
+#include <decaf/io/DataOutputStream.h>
 
 using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace activemq::transport::mock;
 using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
 using namespace activemq::wireformat::stomp;
+using namespace decaf::io;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    /**
+     * Drives a StompWireFormat over in memory streams.
+     */
+    class WireFormatHarness {
+    private:
+
+        WireFormatHarness(const WireFormatHarness&);
+        WireFormatHarness& operator= (const WireFormatHarness&);
+
+    public:
+
+        Pointer<StompWireFormat> wireFormat;
+        MockTransport transport;
+
+    public:
+
+        WireFormatHarness() : wireFormat(new StompWireFormat()),
+                              transport(wireFormat, Pointer<ResponseBuilder>(new OpenWireResponseBuilder())) {
+        }
+
+        std::string marshal(const Pointer<Command>& command) {
+            ByteArrayOutputStream bytesOut;
+            DataOutputStream dataOut(&bytesOut);
+            wireFormat->marshal(command, &transport, &dataOut);
+
+            if (bytesOut.size() == 0) {
+                return std::string();
+            }
+
+            std::pair<unsigned char*, int> array = bytesOut.toByteArray();
+            std::string result((const char*) array.first, (std::size_t) array.second);
+            delete [] array.first;
+            return result;
+        }
+
+        std::vector< Pointer<StompFrame> > marshalFrames(const Pointer<Command>& command) {
+            std::string bytes = marshal(command);
+            ByteArrayInputStream bytesIn(std::vector<unsigned char>(bytes.begin(), bytes.end()));
+            DataInputStream dataIn(&bytesIn);
+
+            std::vector< Pointer<StompFrame> > frames;
+            while (dataIn.available() > 0) {
+                Pointer<StompFrame> frame(new StompFrame());
+                frame->fromStream(&dataIn, true);
+                if (!frame->isHeartBeat()) {
+                    frames.push_back(frame);
+                }
+            }
+
+            return frames;
+        }
+
+        std::vector< Pointer<Command> > unmarshal(const std::string& bytes, int expected) {
+            ByteArrayInputStream bytesIn(std::vector<unsigned char>(bytes.begin(), bytes.end()));
+            DataInputStream dataIn(&bytesIn);
+
+            std::vector< Pointer<Command> > commands;
+            for (int i = 0; i < expected; ++i) {
+                commands.push_back(wireFormat->unmarshal(&transport, &dataIn));
+            }
+
+            return commands;
+        }
+
+        void connect(const std::string& connected) {
+            Pointer<ConnectionInfo> info(new ConnectionInfo());
+            info->setCommandId(1);
+            info->setClientId("client");
+            marshal(info);
+
+            std::string frame = connected;
+            frame += '\0';
+            frame += '\n';
+
+            std::vector< Pointer<Command> > commands = unmarshal(frame, 1);
+            if (commands[0]->isWireFormatInfo()) {
+                unmarshal("", 1);
+            }
+        }
+    };
+
+    std::string messageFrame(const std::string& id) {
+        std::string frame = "MESSAGE\nsubscription:conn:1:1\ndestination:/queue/test\nmessage-id:" + id +
+                            "\nack:ack-" + id + "\n\nbody";
+        frame += '\0';
+        frame += '\n';
+        return frame;
+    }
+
+    Pointer<MessageAck> createAck(const Pointer<Command>& command, int type) {
+        Pointer<MessageDispatch> dispatch = command.dynamicCast<MessageDispatch>();
+
+        Pointer<MessageAck> ack(new MessageAck());
+        ack->setConsumerId(dispatch->getConsumerId());
+        ack->setLastMessageId(dispatch->getMessage()->getMessageId());
+        ack->setAckType((unsigned char) type);
+        return ack;
+    }
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 StompWireFormatTest::StompWireFormatTest() {
@@ -46,3 +170,129 @@ void StompWireFormatTest::testChangeDestinationPrefix() {
     frame.setProperty("subscription", "connection:1:1:0:1");
     frame.setProperty("message-id", "connection:1:1:0:1");
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void StompWireFormatTest::testConnectNegotiation() {
+
+    WireFormatHarness harness;
+    harness.wireFormat->setOutgoingHeartBeat(1000);
+    harness.wireFormat->setIncomingHeartBeat(2000);
+    harness.wireFormat->setHost("broker.example.com");
+
+    Pointer<ConnectionInfo> info(new ConnectionInfo());
+    info->setCommandId(1);
+    info->setClientId("client");
+
+    std::vector< Pointer<StompFrame> > frames = harness.marshalFrames(info);
+    CPPUNIT_ASSERT_EQUAL((std::size_t) 1, frames.size());
+    CPPUNIT_ASSERT_EQUAL(StompCommandConstants::CONNECT, frames[0]->getCommand());
+    CPPUNIT_ASSERT_EQUAL(std::string("1.0,1.1,1.2"), frames[0]->getProperty(StompCommandConstants::HEADER_ACCEPT_VERSION));
+    CPPUNIT_ASSERT_EQUAL(std::string("1000,2000"), frames[0]->getProperty(StompCommandConstants::HEADER_HEARTBEAT));
+    CPPUNIT_ASSERT_EQUAL(std::string("broker.example.com"), frames[0]->getProperty(StompCommandConstants::HEADER_HOST));
+
+    std::string connected = "CONNECTED\nversion:1.2\nheart-beat:3000,500\n\n";
+    connected += '\0';
+    connected += '\n';
+
+    // The heart-beat agreement is handed up ahead of the connect response.
+    std::vector< Pointer<Command> > commands = harness.unmarshal(connected, 2);
+    CPPUNIT_ASSERT(commands[0]->isWireFormatInfo());
+    CPPUNIT_ASSERT(commands[1]->isResponse());
+    CPPUNIT_ASSERT_EQUAL(1, commands[1].dynamicCast<Response>()->getCorrelationId());
+
+    Pointer<WireFormatInfo> agreed = commands[0].dynamicCast<WireFormatInfo>();
+    CPPUNIT_ASSERT_EQUAL(4500LL, agreed->getMaxInactivityDuration());
+    CPPUNIT_ASSERT_EQUAL(500LL, agreed->getProperties().getLong("WriteCheckTime"));
+    CPPUNIT_ASSERT(agreed->getProperties().getBool("TransportOnly"));
+    CPPUNIT_ASSERT_EQUAL(std::string("1.2"), harness.wireFormat->getProtocolVersion());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompWireFormatTest::testConnectStomp10() {
+
+    WireFormatHarness harness;
+    harness.wireFormat->setOutgoingHeartBeat(1000);
+    harness.wireFormat->setIncomingHeartBeat(1000);
+
+    std::string connected = "CONNECTED\nsession:1\n\n";
+    connected += '\0';
+    connected += '\n';
+    harness.connect(connected);
+
+    CPPUNIT_ASSERT_EQUAL(std::string("1.0"), harness.wireFormat->getProtocolVersion());
+
+    // A 1.0 broker only understands the old single ACK and never sees heart-beats.
+    std::vector< Pointer<Command> > messages = harness.unmarshal(messageFrame("1"), 1);
+    std::vector< Pointer<StompFrame> > frames =
+        harness.marshalFrames(createAck(messages[0], ActiveMQConstants::ACK_TYPE_CONSUMED));
+    CPPUNIT_ASSERT_EQUAL((std::size_t) 1, frames.size());
+    CPPUNIT_ASSERT_EQUAL(StompCommandConstants::ACK, frames[0]->getCommand());
+    CPPUNIT_ASSERT(!frames[0]->hasProperty(StompCommandConstants::HEADER_SUBSCRIPTION));
+
+    CPPUNIT_ASSERT_EQUAL(std::string(), harness.marshal(Pointer<Command>(new KeepAliveInfo())));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompWireFormatTest::testAcksStomp12() {
+
+    WireFormatHarness harness;
+
+    std::string connected = "CONNECTED\nversion:1.2\n\n";
+    connected += '\0';
+    connected += '\n';
+    harness.connect(connected);
+
+    std::vector< Pointer<Command> > messages =
+        harness.unmarshal(messageFrame("1") + messageFrame("2") + messageFrame("3") + messageFrame("4"), 4);
+
+    // Delivered acks only open the prefetch window.
+    CPPUNIT_ASSERT(harness.marshalFrames(createAck(messages[0], ActiveMQConstants::ACK_TYPE_DELIVERED)).empty());
+
+    // A poison ack rejects only the named message, the ones before it stay pending.
+    Pointer<MessageAck> poison = createAck(messages[1], ActiveMQConstants::ACK_TYPE_POISON);
+    poison->setResponseRequired(true);
+    poison->setCommandId(7);
+
+    std::vector< Pointer<StompFrame> > frames = harness.marshalFrames(poison);
+    CPPUNIT_ASSERT_EQUAL((std::size_t) 1, frames.size());
+    CPPUNIT_ASSERT_EQUAL(StompCommandConstants::NACK, frames[0]->getCommand());
+    CPPUNIT_ASSERT_EQUAL(std::string("ack-2"), frames[0]->getProperty(StompCommandConstants::HEADER_ID));
+    CPPUNIT_ASSERT_EQUAL(std::string("2"), frames[0]->getProperty(StompCommandConstants::HEADER_MESSAGEID));
+    CPPUNIT_ASSERT_EQUAL(std::string("ignore:7"), frames[0]->getProperty(StompCommandConstants::HEADER_RECEIPT_REQUIRED));
+
+    // An individual ack leaves the messages before it alone.
+    frames = harness.marshalFrames(createAck(messages[3], ActiveMQConstants::ACK_TYPE_INDIVIDUAL));
+    CPPUNIT_ASSERT_EQUAL((std::size_t) 1, frames.size());
+    CPPUNIT_ASSERT_EQUAL(StompCommandConstants::ACK, frames[0]->getCommand());
+    CPPUNIT_ASSERT_EQUAL(std::string("ack-4"), frames[0]->getProperty(StompCommandConstants::HEADER_ID));
+    CPPUNIT_ASSERT_EQUAL(std::string("conn:1:1"), frames[0]->getProperty(StompCommandConstants::HEADER_SUBSCRIPTION));
+
+    frames = harness.marshalFrames(createAck(messages[2], ActiveMQConstants::ACK_TYPE_CONSUMED));
+    CPPUNIT_ASSERT_EQUAL((std::size_t) 2, frames.size());
+    CPPUNIT_ASSERT_EQUAL(StompCommandConstants::ACK, frames[0]->getCommand());
+    CPPUNIT_ASSERT_EQUAL(std::string("ack-1"), frames[0]->getProperty(StompCommandConstants::HEADER_ID));
+    CPPUNIT_ASSERT_EQUAL(StompCommandConstants::ACK, frames[1]->getCommand());
+    CPPUNIT_ASSERT_EQUAL(std::string("ack-3"), frames[1]->getProperty(StompCommandConstants::HEADER_ID));
+
+    // Once answered a message falls back to its own id.
+    frames = harness.marshalFrames(createAck(messages[2], ActiveMQConstants::ACK_TYPE_CONSUMED));
+    CPPUNIT_ASSERT_EQUAL((std::size_t) 1, frames.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("3"), frames[0]->getProperty(StompCommandConstants::HEADER_ID));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StompWireFormatTest::testHeartBeats() {
+
+    WireFormatHarness harness;
+
+    std::string connected = "CONNECTED\nversion:1.1\n\n";
+    connected += '\0';
+    connected += '\n';
+    harness.connect(connected);
+
+    CPPUNIT_ASSERT_EQUAL(std::string("\n"), harness.marshal(Pointer<Command>(new KeepAliveInfo())));
+
+    std::vector< Pointer<Command> > commands = harness.unmarshal("\n\r\n", 2);
+    CPPUNIT_ASSERT(commands[0]->isKeepAliveInfo());
+    CPPUNIT_ASSERT(commands[1]->isKeepAliveInfo());
+}
@@ -29,6 +29,10 @@ namespace stomp {
 
         CPPUNIT_TEST_SUITE( StompWireFormatTest );
         CPPUNIT_TEST( testChangeDestinationPrefix );
+        CPPUNIT_TEST( testConnectNegotiation );
+        CPPUNIT_TEST( testConnectStomp10 );
+        CPPUNIT_TEST( testAcksStomp12 );
+        CPPUNIT_TEST( testHeartBeats );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -37,6 +41,10 @@ namespace stomp {
         virtual ~StompWireFormatTest();
 
         virtual void testChangeDestinationPrefix();
+        virtual void testConnectNegotiation();
+        virtual void testConnectStomp10();
+        virtual void testAcksStomp12();
+        virtual void testHeartBeats();
 
     };
 
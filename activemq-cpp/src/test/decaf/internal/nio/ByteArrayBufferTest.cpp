@@ -19,7 +19,15 @@
 #include <decaf/lang/Integer.h>
 #include <decaf/lang/Double.h>
 #include <decaf/lang/Float.h>
+#include <decaf/lang/exceptions/UnsupportedOperationException.h>
+#include <decaf/nio/CharBuffer.h>
+#include <decaf/nio/DoubleBuffer.h>
+#include <decaf/nio/FloatBuffer.h>
+#include <decaf/nio/IntBuffer.h>
+#include <decaf/nio/LongBuffer.h>
+#include <decaf/nio/ShortBuffer.h>
 #include <string.h>
+#include <memory>
 
 using namespace std;
 using namespace decaf;
@@ -1234,3 +1242,144 @@ void ByteArrayBufferTest::testWrapNullArray() {
         testBuffer1->wrap( NULL, 0, 0, 3 ),
         NullPointerException );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void ByteArrayBufferTest::testAllocateDirect() {
+
+    CPPUNIT_ASSERT( !testBuffer1->isDirect() );
+
+    std::auto_ptr<ByteBuffer> direct( ByteBuffer::allocateDirect( testData1Size ) );
+    CPPUNIT_ASSERT( direct->isDirect() );
+    CPPUNIT_ASSERT_EQUAL( testData1Size, direct->capacity() );
+    CPPUNIT_ASSERT_EQUAL( 0, direct->position() );
+    CPPUNIT_ASSERT_EQUAL( testData1Size, direct->limit() );
+    CPPUNIT_ASSERT_EQUAL( (std::size_t)0, (std::size_t)direct->array() % 64 );
+
+    for( int ix = 0; ix < testData1Size; ++ix ) {
+        CPPUNIT_ASSERT_EQUAL( 0, (int)direct->get( ix ) );
+    }
+
+    direct->put( testData1, testData1Size, 0, testData1Size );
+    direct->flip();
+    CPPUNIT_ASSERT( memcmp( direct->array(), testData1, testData1Size ) == 0 );
+
+    // Slices and duplicates share the direct memory.
+    direct->position( 10 );
+    std::auto_ptr<ByteBuffer> slice( direct->slice() );
+    std::auto_ptr<ByteBuffer> readOnly( direct->asReadOnlyBuffer() );
+    CPPUNIT_ASSERT( slice->isDirect() );
+    CPPUNIT_ASSERT( readOnly->isDirect() );
+    CPPUNIT_ASSERT_EQUAL( testData1[10], slice->get( 0 ) );
+
+    std::auto_ptr<ByteBuffer> page( ByteBuffer::allocateDirect( 16, 4096 ) );
+    CPPUNIT_ASSERT_EQUAL( (std::size_t)0, (std::size_t)page->array() % 4096 );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a IllegalArgumentException",
+        ByteBuffer::allocateDirect( 16, 3 ),
+        IllegalArgumentException );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a IllegalArgumentException",
+        ByteBuffer::allocateDirect( -1 ),
+        IllegalArgumentException );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ByteArrayBufferTest::testAsIntBuffer() {
+
+    std::auto_ptr<ByteBuffer> buffer( ByteBuffer::allocateDirect( 64 ) );
+    buffer->position( 8 );
+
+    std::auto_ptr<IntBuffer> view( buffer->asIntBuffer() );
+    CPPUNIT_ASSERT_EQUAL( 14, view->capacity() );
+    CPPUNIT_ASSERT_EQUAL( 0, view->position() );
+    CPPUNIT_ASSERT( !view->isReadOnly() );
+
+    // Changes are visible through both buffers in the big-endian order of the byte buffer.
+    view->put( 0, 0x01020304 );
+    CPPUNIT_ASSERT_EQUAL( 0x01020304, buffer->getInt( 8 ) );
+    CPPUNIT_ASSERT_EQUAL( (unsigned char)0x01, buffer->get( 8 ) );
+    CPPUNIT_ASSERT_EQUAL( (unsigned char)0x04, buffer->get( 11 ) );
+
+    buffer->putInt( 12, 42 );
+    CPPUNIT_ASSERT_EQUAL( 42, view->get( 1 ) );
+
+    // The view's elements are not in native order so it exposes no backing array.
+    CPPUNIT_ASSERT( !view->hasArray() );
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a UnsupportedOperationException",
+        view->array(),
+        UnsupportedOperationException );
+
+    std::auto_ptr<ByteBuffer> readOnly( buffer->asReadOnlyBuffer() );
+    std::auto_ptr<IntBuffer> readOnlyView( readOnly->asIntBuffer() );
+    CPPUNIT_ASSERT( readOnlyView->isReadOnly() );
+    CPPUNIT_ASSERT_EQUAL( 42, readOnlyView->get( 1 ) );
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a ReadOnlyBufferException",
+        readOnlyView->put( 0, 1 ),
+        ReadOnlyBufferException );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ByteArrayBufferTest::testAsTypedViews() {
+
+    testBuffer1->clear();
+
+    std::auto_ptr<CharBuffer> chars( testBuffer1->asCharBuffer() );
+    std::auto_ptr<ShortBuffer> shorts( testBuffer1->asShortBuffer() );
+    std::auto_ptr<LongBuffer> longs( testBuffer1->asLongBuffer() );
+    std::auto_ptr<FloatBuffer> floats( testBuffer1->asFloatBuffer() );
+    std::auto_ptr<DoubleBuffer> doubles( testBuffer1->asDoubleBuffer() );
+
+    CPPUNIT_ASSERT_EQUAL( testData1Size, chars->capacity() );
+    CPPUNIT_ASSERT_EQUAL( testData1Size / (int)sizeof( short ), shorts->capacity() );
+    CPPUNIT_ASSERT_EQUAL( testData1Size / (int)sizeof( long long ), longs->capacity() );
+    CPPUNIT_ASSERT_EQUAL( testData1Size / (int)sizeof( float ), floats->capacity() );
+    CPPUNIT_ASSERT_EQUAL( testData1Size / (int)sizeof( double ), doubles->capacity() );
+
+    chars->put( 0, 'a' );
+    CPPUNIT_ASSERT_EQUAL( 'a', (char)testBuffer1->get( 0 ) );
+
+    shorts->put( 1, (short)-2 );
+    CPPUNIT_ASSERT_EQUAL( (short)-2, testBuffer1->getShort( 2 ) );
+
+    longs->put( 1, 123456789012345LL );
+    CPPUNIT_ASSERT_EQUAL( 123456789012345LL, testBuffer1->getLong( 8 ) );
+
+    floats->put( 6, 1.25f );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL( 1.25f, testBuffer1->getFloat( 24 ), 0.0f );
+
+    doubles->put( 2, 3.5 );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL( 3.5, doubles->get( 2 ), 0.0 );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL( 3.5, testBuffer1->getDouble( 16 ), 0.0 );
+
+    // The views start at the position of the byte buffer.
+    testBuffer1->position( 16 );
+    std::auto_ptr<DoubleBuffer> tail( testBuffer1->asDoubleBuffer() );
+    CPPUNIT_ASSERT_EQUAL( ( testData1Size - 16 ) / (int)sizeof( double ), tail->capacity() );
+    CPPUNIT_ASSERT_DOUBLES_EQUAL( 3.5, tail->get( 0 ), 0.0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ByteArrayBufferTest::testUnalignedView() {
+
+    testBuffer1->clear();
+    testBuffer1->putInt( 3, 0x0A0B0C0D );
+    testBuffer1->putLong( 7, 987654321987LL );
+    testBuffer1->position( 3 );
+
+    // Views need no alignment, they start at any position of the byte buffer.
+    std::auto_ptr<IntBuffer> ints( testBuffer1->asIntBuffer() );
+    CPPUNIT_ASSERT_EQUAL( ( testData1Size - 3 ) / (int)sizeof( int ), ints->capacity() );
+    CPPUNIT_ASSERT_EQUAL( 0x0A0B0C0D, ints->get( 0 ) );
+
+    std::auto_ptr<LongBuffer> longs( testBuffer1->asLongBuffer() );
+    CPPUNIT_ASSERT_EQUAL( ( testData1Size - 3 ) / (int)sizeof( long long ), longs->capacity() );
+    longs->put( 1, 42LL );
+    CPPUNIT_ASSERT_EQUAL( 42LL, testBuffer1->getLong( 11 ) );
+
+    std::auto_ptr<CharBuffer> chars( testBuffer1->asCharBuffer() );
+    CPPUNIT_ASSERT_EQUAL( testData1Size - 3, chars->capacity() );
+}
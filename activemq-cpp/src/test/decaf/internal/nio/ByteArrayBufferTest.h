@@ -75,6 +75,10 @@ namespace nio{
         CPPUNIT_TEST( testPutShort );
         CPPUNIT_TEST( testPutShort2 );
         CPPUNIT_TEST( testWrapNullArray );
+        CPPUNIT_TEST( testAllocateDirect );
+        CPPUNIT_TEST( testAsIntBuffer );
+        CPPUNIT_TEST( testAsTypedViews );
+        CPPUNIT_TEST( testUnalignedView );
         CPPUNIT_TEST_SUITE_END();
 
     private:
@@ -155,6 +159,10 @@ namespace nio{
         void testPutShort();
         void testPutShort2();
         void testWrapNullArray();
+        void testAllocateDirect();
+        void testAsIntBuffer();
+        void testAsTypedViews();
+        void testUnalignedView();
 
     };
 
@@ -0,0 +1,187 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MappedFileTest.h"
+
+#include <decaf/internal/nio/MappedFile.h>
+#include <decaf/internal/io/FileSystem.h>
+#include <decaf/io/IOException.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/util/UUID.h>
+
+#include <memory>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+using namespace decaf::internal::io;
+using namespace decaf::internal::nio;
+
+////////////////////////////////////////////////////////////////////////////////
+void MappedFileTest::setUp() {
+    this->path = std::string("MappedFileTest-") + UUID::randomUUID().toString() + ".dat";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MappedFileTest::tearDown() {
+    FileSystem::remove(this->path);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MappedFileTest::testCreate() {
+
+    CPPUNIT_ASSERT(!FileSystem::exists(this->path));
+
+    MappedFile file(this->path, 4096);
+
+    CPPUNIT_ASSERT(FileSystem::exists(this->path));
+    CPPUNIT_ASSERT(file.isOpen());
+    CPPUNIT_ASSERT_EQUAL(4096LL, file.getSize());
+    CPPUNIT_ASSERT_EQUAL(this->path, file.getPath());
+    CPPUNIT_ASSERT(file.getAddress() != NULL);
+
+    // A new file is zero filled.
+    for (int i = 0; i < 4096; ++i) {
+        CPPUNIT_ASSERT_EQUAL((int) 0, (int) file.getAddress()[i]);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MappedFileTest::testContentSurvivesReopen() {
+
+    {
+        MappedFile file(this->path, 1024);
+        for (int i = 0; i < 1024; ++i) {
+            file.getAddress()[i] = (unsigned char) (i % 251);
+        }
+        file.force();
+    }
+
+    MappedFile file(this->path, 0);
+    CPPUNIT_ASSERT_EQUAL(1024LL, file.getSize());
+    for (int i = 0; i < 1024; ++i) {
+        CPPUNIT_ASSERT_EQUAL(i % 251, (int) file.getAddress()[i]);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MappedFileTest::testGrowExisting() {
+
+    {
+        MappedFile file(this->path, 512);
+        file.getAddress()[511] = 42;
+    }
+
+    MappedFile file(this->path, 2048);
+    CPPUNIT_ASSERT_EQUAL(2048LL, file.getSize());
+    CPPUNIT_ASSERT_EQUAL(42, (int) file.getAddress()[511]);
+    CPPUNIT_ASSERT_EQUAL(0, (int) file.getAddress()[2047]);
+
+    // Asking for less than the file holds maps all of it.
+    file.close();
+    MappedFile larger(this->path, 16);
+    CPPUNIT_ASSERT_EQUAL(2048LL, larger.getSize());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MappedFileTest::testMapEmptyFileFails() {
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        MappedFile(this->path, 0),
+        IOException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MappedFileTest::testClose() {
+
+    MappedFile file(this->path, 128);
+    file.close();
+
+    CPPUNIT_ASSERT(!file.isOpen());
+    CPPUNIT_ASSERT(file.getAddress() == NULL);
+    CPPUNIT_ASSERT_NO_THROW(file.close());
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        file.force(),
+        IOException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MappedFileTest::testMapRegion() {
+
+    {
+        MappedFile file(this->path, 10000);
+        for (int i = 0; i < 10000; ++i) {
+            file.getAddress()[i] = (unsigned char) (i % 251);
+        }
+    }
+
+    MappedFile region(this->path, 5000, 100, false);
+    CPPUNIT_ASSERT_EQUAL(5000LL, region.getOffset());
+    CPPUNIT_ASSERT_EQUAL(100LL, region.getSize());
+    CPPUNIT_ASSERT(!region.isReadOnly());
+
+    for (int i = 0; i < 100; ++i) {
+        CPPUNIT_ASSERT_EQUAL((5000 + i) % 251, (int) region.getAddress()[i]);
+    }
+
+    region.getAddress()[0] = 7;
+    region.load();
+    region.force();
+    region.close();
+
+    // A writable region past the end grows the file.
+    MappedFile grown(this->path, 12000, 50, false);
+    grown.close();
+
+    MappedFile whole(this->path, 0);
+    CPPUNIT_ASSERT_EQUAL(12050LL, whole.getSize());
+    CPPUNIT_ASSERT_EQUAL(7, (int) whole.getAddress()[5000]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MappedFileTest::testMapReadOnlyRegion() {
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        MappedFile(this->path, 0, 10, true),
+        IOException);
+
+    {
+        MappedFile file(this->path, 100);
+        file.getAddress()[99] = 3;
+    }
+
+    MappedFile region(this->path, 90, 10, true);
+    CPPUNIT_ASSERT(region.isReadOnly());
+    CPPUNIT_ASSERT_EQUAL(3, (int) region.getAddress()[9]);
+    CPPUNIT_ASSERT_NO_THROW(region.force());
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        MappedFile(this->path, 90, 20, true),
+        IOException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        MappedFile(this->path, -1, 20, true),
+        IllegalArgumentException);
+}
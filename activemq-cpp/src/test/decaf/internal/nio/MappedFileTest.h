@@ -0,0 +1,66 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_INTERNAL_NIO_MAPPEDFILETEST_H_
+#define _DECAF_INTERNAL_NIO_MAPPEDFILETEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <string>
+
+namespace decaf{
+namespace internal{
+namespace nio{
+
+    class MappedFileTest : public CppUnit::TestFixture {
+
+        CPPUNIT_TEST_SUITE( MappedFileTest );
+        CPPUNIT_TEST( testCreate );
+        CPPUNIT_TEST( testContentSurvivesReopen );
+        CPPUNIT_TEST( testGrowExisting );
+        CPPUNIT_TEST( testMapEmptyFileFails );
+        CPPUNIT_TEST( testClose );
+        CPPUNIT_TEST( testMapRegion );
+        CPPUNIT_TEST( testMapReadOnlyRegion );
+        CPPUNIT_TEST_SUITE_END();
+
+    private:
+
+        std::string path;
+
+    public:
+
+        MappedFileTest() : path() {}
+        virtual ~MappedFileTest() {}
+
+        virtual void setUp();
+        virtual void tearDown();
+
+        void testCreate();
+        void testContentSurvivesReopen();
+        void testGrowExisting();
+        void testMapEmptyFileFails();
+        void testClose();
+        void testMapRegion();
+        void testMapReadOnlyRegion();
+
+    };
+
+}}}
+
+#endif /*_DECAF_INTERNAL_NIO_MAPPEDFILETEST_H_*/
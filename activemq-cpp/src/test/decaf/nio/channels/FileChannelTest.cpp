@@ -0,0 +1,425 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FileChannelTest.h"
+
+#include <decaf/nio/channels/FileChannel.h>
+#include <decaf/nio/IntBuffer.h>
+#include <decaf/nio/ReadOnlyBufferException.h>
+#include <decaf/internal/io/FileSystem.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/IOException.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/util/UUID.h>
+
+#include <memory>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::nio;
+using namespace decaf::nio::channels;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+using namespace decaf::internal::io;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    void fill(FileChannel& channel, int size) {
+        std::auto_ptr<ByteBuffer> buffer(ByteBuffer::allocate(size));
+        for (int i = 0; i < size; ++i) {
+            buffer->put((unsigned char) (i % 251));
+        }
+        buffer->flip();
+        channel.write(*buffer);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+FileChannelTest::FileChannelTest() : path(), otherPath() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+FileChannelTest::~FileChannelTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileChannelTest::setUp() {
+    std::string id = UUID::randomUUID().toString();
+    this->path = std::string("FileChannelTest-") + id + ".dat";
+    this->otherPath = std::string("FileChannelTest-") + id + "-other.dat";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileChannelTest::tearDown() {
+    FileSystem::remove(this->path);
+    FileSystem::remove(this->otherPath);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileChannelTest::testOpen() {
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        FileChannel(this->path, "r"),
+        IOException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        FileChannel(this->path, "w"),
+        IllegalArgumentException);
+
+    FileChannel channel(this->path, "rw");
+    CPPUNIT_ASSERT(channel.isOpen());
+    CPPUNIT_ASSERT(!channel.isReadOnly());
+    CPPUNIT_ASSERT_EQUAL(this->path, channel.getPath());
+    CPPUNIT_ASSERT_EQUAL(0LL, channel.size());
+    CPPUNIT_ASSERT_EQUAL(0LL, channel.position());
+
+    FileChannel reader(this->path, "r");
+    CPPUNIT_ASSERT(reader.isReadOnly());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileChannelTest::testReadWrite() {
+
+    FileChannel channel(this->path, "rw");
+
+    fill(channel, 1000);
+    CPPUNIT_ASSERT_EQUAL(1000LL, channel.position());
+    CPPUNIT_ASSERT_EQUAL(1000LL, channel.size());
+
+    channel.position(0);
+    std::auto_ptr<ByteBuffer> buffer(ByteBuffer::allocateDirect(600));
+
+    CPPUNIT_ASSERT_EQUAL(600, channel.read(*buffer));
+    CPPUNIT_ASSERT_EQUAL(600, buffer->position());
+    CPPUNIT_ASSERT_EQUAL(600LL, channel.position());
+    CPPUNIT_ASSERT_EQUAL(599 % 251, (int) buffer->get(599));
+
+    buffer->clear();
+    CPPUNIT_ASSERT_EQUAL(400, channel.read(*buffer));
+    CPPUNIT_ASSERT_EQUAL(600 % 251, (int) buffer->get(0));
+
+    buffer->clear();
+    CPPUNIT_ASSERT_EQUAL(-1, channel.read(*buffer));
+
+    std::auto_ptr<ByteBuffer> readOnly(buffer->asReadOnlyBuffer());
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a ReadOnlyBufferException",
+        channel.read(*readOnly),
+        ReadOnlyBufferException);
+
+    // Writing from a read-only buffer is fine.
+    channel.position(0);
+    readOnly->clear();
+    CPPUNIT_ASSERT_EQUAL(600, channel.write(*readOnly));
+    CPPUNIT_ASSERT_EQUAL(600, readOnly->position());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileChannelTest::testPositionalReadWrite() {
+
+    FileChannel channel(this->path, "rw");
+    fill(channel, 100);
+    channel.position(10);
+
+    std::auto_ptr<ByteBuffer> buffer(ByteBuffer::allocate(4));
+    buffer->putInt(0x0A0B0C0D);
+    buffer->flip();
+
+    CPPUNIT_ASSERT_EQUAL(4, channel.write(*buffer, 200));
+    CPPUNIT_ASSERT_EQUAL(10LL, channel.position());
+    CPPUNIT_ASSERT_EQUAL(204LL, channel.size());
+
+    buffer->clear();
+    CPPUNIT_ASSERT_EQUAL(4, channel.read(*buffer, 200));
+    CPPUNIT_ASSERT_EQUAL(0x0A0B0C0D, buffer->getInt(0));
+    CPPUNIT_ASSERT_EQUAL(10LL, channel.position());
+
+    buffer->clear();
+    CPPUNIT_ASSERT_EQUAL(-1, channel.read(*buffer, 500));
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        channel.read(*buffer, -1),
+        IllegalArgumentException);
+
+    FileChannel reader(this->path, "r");
+    buffer->clear();
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        reader.write(*buffer),
+        IOException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileChannelTest::testTruncate() {
+
+    FileChannel channel(this->path, "rw");
+    fill(channel, 100);
+
+    channel.truncate(200);
+    CPPUNIT_ASSERT_EQUAL(100LL, channel.size());
+    CPPUNIT_ASSERT_EQUAL(100LL, channel.position());
+
+    channel.truncate(40);
+    CPPUNIT_ASSERT_EQUAL(40LL, channel.size());
+    CPPUNIT_ASSERT_EQUAL(40LL, channel.position());
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        channel.truncate(-1),
+        IllegalArgumentException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileChannelTest::testMapReadWrite() {
+
+    FileChannel channel(this->path, "rw");
+
+    std::auto_ptr<MappedByteBuffer> mapped(channel.map(FileChannel::READ_WRITE, 0, 4096));
+    CPPUNIT_ASSERT(mapped->isDirect());
+    CPPUNIT_ASSERT(!mapped->isReadOnly());
+    CPPUNIT_ASSERT_EQUAL(4096, mapped->capacity());
+    CPPUNIT_ASSERT_EQUAL(4096LL, channel.size());
+
+    mapped->putInt(0x01020304);
+    mapped->put(100, (unsigned char) 42);
+    mapped->force();
+    mapped->load();
+
+    // Writes through the mapping are visible to the channel.
+    std::auto_ptr<ByteBuffer> buffer(ByteBuffer::allocate(4));
+    CPPUNIT_ASSERT_EQUAL(4, channel.read(*buffer, 0));
+    CPPUNIT_ASSERT_EQUAL(0x01020304, buffer->getInt(0));
+
+    // And writes through the channel are visible in the mapping.
+    buffer->clear();
+    buffer->putInt(0x7F7F7F7F);
+    buffer->flip();
+    channel.write(*buffer, 200);
+    CPPUNIT_ASSERT_EQUAL(0x7F7F7F7F, mapped->getInt(200));
+
+    mapped->position(100);
+    std::auto_ptr<MappedByteBuffer> slice(mapped->slice());
+    CPPUNIT_ASSERT_EQUAL(3996, slice->capacity());
+    CPPUNIT_ASSERT_EQUAL(42, (int) slice->get(0));
+    slice->force();
+
+    mapped->position(256);
+    std::auto_ptr<IntBuffer> ints(mapped->asIntBuffer());
+    ints->put(0, 77);
+    CPPUNIT_ASSERT_EQUAL(77, mapped->getInt(256));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileChannelTest::testMapReadOnly() {
+
+    {
+        FileChannel channel(this->path, "rw");
+        fill(channel, 1024);
+    }
+
+    FileChannel channel(this->path, "r");
+
+    std::auto_ptr<MappedByteBuffer> mapped(channel.map(FileChannel::READ_ONLY, 0, 1024));
+    CPPUNIT_ASSERT(mapped->isReadOnly());
+    CPPUNIT_ASSERT_EQUAL(1023 % 251, (int) mapped->get(1023));
+    CPPUNIT_ASSERT_NO_THROW(mapped->force());
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a ReadOnlyBufferException",
+        mapped->put((unsigned char) 1),
+        ReadOnlyBufferException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        channel.map(FileChannel::READ_ONLY, 1000, 100),
+        IOException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        channel.map(FileChannel::READ_WRITE, 0, 100),
+        IOException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        channel.map(FileChannel::READ_ONLY, 0, 0),
+        IllegalArgumentException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileChannelTest::testMapUnalignedPosition() {
+
+    FileChannel channel(this->path, "rw");
+    fill(channel, 20000);
+
+    std::auto_ptr<MappedByteBuffer> mapped(channel.map(FileChannel::READ_ONLY, 12345, 100));
+    CPPUNIT_ASSERT_EQUAL(100, mapped->capacity());
+
+    for (int i = 0; i < 100; ++i) {
+        CPPUNIT_ASSERT_EQUAL((12345 + i) % 251, (int) mapped->get(i));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileChannelTest::testMappedBufferOutlivesChannel() {
+
+    std::auto_ptr<MappedByteBuffer> mapped;
+    {
+        FileChannel channel(this->path, "rw");
+        mapped.reset(channel.map(FileChannel::READ_WRITE, 0, 64));
+    }
+
+    mapped->putLong(0, 123456789LL);
+    std::auto_ptr<ByteBuffer> duplicate(mapped->duplicate());
+    mapped.reset();
+
+    CPPUNIT_ASSERT_EQUAL(123456789LL, duplicate->getLong(0));
+
+    FileChannel channel(this->path, "r");
+    std::auto_ptr<ByteBuffer> buffer(ByteBuffer::allocate(8));
+    channel.read(*buffer);
+    CPPUNIT_ASSERT_EQUAL(123456789LL, buffer->getLong(0));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileChannelTest::testMapUsesOpenFile() {
+
+    FileChannel channel(this->path, "rw");
+    fill(channel, 1024);
+
+    // Where the platform lets an open file be removed the channel must still map and
+    // transfer the file it has open rather than look it up again by path.
+    if (!FileSystem::remove(this->path)) {
+        return;
+    }
+
+    std::auto_ptr<MappedByteBuffer> mapped(channel.map(FileChannel::READ_ONLY, 0, 1024));
+    CPPUNIT_ASSERT_EQUAL(1000 % 251, (int) mapped->get(1000));
+
+    ByteArrayOutputStream target;
+    CPPUNIT_ASSERT_EQUAL(1024LL, channel.transferTo(0, 1024, target));
+    CPPUNIT_ASSERT_EQUAL(1024LL, target.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileChannelTest::testTransferTo() {
+
+    FileChannel source(this->path, "rw");
+    fill(source, 10000);
+
+    FileChannel target(this->otherPath, "rw");
+    target.position(5);
+
+    CPPUNIT_ASSERT_EQUAL(3000LL, source.transferTo(1000, 3000, target));
+    CPPUNIT_ASSERT_EQUAL(3005LL, target.position());
+    CPPUNIT_ASSERT_EQUAL(10000LL, source.position());
+
+    // Only what's left of the source is transferred.
+    CPPUNIT_ASSERT_EQUAL(1000LL, source.transferTo(9000, 5000, target));
+    CPPUNIT_ASSERT_EQUAL(0LL, source.transferTo(10000, 5000, target));
+    CPPUNIT_ASSERT_EQUAL(4005LL, target.size());
+
+    std::auto_ptr<ByteBuffer> buffer(ByteBuffer::allocate(4000));
+    CPPUNIT_ASSERT_EQUAL(4000, target.read(*buffer, 5));
+    for (int i = 0; i < 3000; ++i) {
+        CPPUNIT_ASSERT_EQUAL((1000 + i) % 251, (int) buffer->get(i));
+    }
+    for (int i = 0; i < 1000; ++i) {
+        CPPUNIT_ASSERT_EQUAL((9000 + i) % 251, (int) buffer->get(3000 + i));
+    }
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        source.transferTo(0, 10, source),
+        IllegalArgumentException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileChannelTest::testTransferToStream() {
+
+    FileChannel source(this->path, "rw");
+    fill(source, 500);
+
+    ByteArrayOutputStream stream;
+    CPPUNIT_ASSERT_EQUAL(200LL, source.transferTo(100, 200, stream));
+    CPPUNIT_ASSERT_EQUAL(200LL, stream.size());
+
+    std::pair<unsigned char*, int> bytes = stream.toByteArray();
+    for (int i = 0; i < bytes.second; ++i) {
+        CPPUNIT_ASSERT_EQUAL((100 + i) % 251, (int) bytes.first[i]);
+    }
+    delete [] bytes.first;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileChannelTest::testTransferFrom() {
+
+    FileChannel source(this->path, "rw");
+    fill(source, 1000);
+    source.position(250);
+
+    FileChannel target(this->otherPath, "rw");
+
+    CPPUNIT_ASSERT_EQUAL(500LL, target.transferFrom(source, 10, 500));
+    CPPUNIT_ASSERT_EQUAL(750LL, source.position());
+    CPPUNIT_ASSERT_EQUAL(0LL, target.position());
+    CPPUNIT_ASSERT_EQUAL(510LL, target.size());
+
+    std::auto_ptr<MappedByteBuffer> mapped(target.map(FileChannel::READ_ONLY, 10, 500));
+    for (int i = 0; i < 500; ++i) {
+        CPPUNIT_ASSERT_EQUAL((250 + i) % 251, (int) mapped->get(i));
+    }
+
+    FileChannel reader(this->otherPath, "r");
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        reader.transferFrom(source, 0, 10),
+        IOException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void FileChannelTest::testClosed() {
+
+    FileChannel channel(this->path, "rw");
+    fill(channel, 10);
+    channel.close();
+
+    CPPUNIT_ASSERT(!channel.isOpen());
+    CPPUNIT_ASSERT_NO_THROW(channel.close());
+
+    std::auto_ptr<ByteBuffer> buffer(ByteBuffer::allocate(10));
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        channel.read(*buffer),
+        IOException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        channel.size(),
+        IOException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        channel.map(FileChannel::READ_ONLY, 0, 10),
+        IOException);
+}
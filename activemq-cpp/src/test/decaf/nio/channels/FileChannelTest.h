@@ -0,0 +1,79 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_NIO_CHANNELS_FILECHANNELTEST_H_
+#define _DECAF_NIO_CHANNELS_FILECHANNELTEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <string>
+
+namespace decaf {
+namespace nio {
+namespace channels {
+
+    class FileChannelTest : public CppUnit::TestFixture {
+
+        CPPUNIT_TEST_SUITE( FileChannelTest );
+        CPPUNIT_TEST( testOpen );
+        CPPUNIT_TEST( testReadWrite );
+        CPPUNIT_TEST( testPositionalReadWrite );
+        CPPUNIT_TEST( testTruncate );
+        CPPUNIT_TEST( testMapReadWrite );
+        CPPUNIT_TEST( testMapReadOnly );
+        CPPUNIT_TEST( testMapUnalignedPosition );
+        CPPUNIT_TEST( testMappedBufferOutlivesChannel );
+        CPPUNIT_TEST( testMapUsesOpenFile );
+        CPPUNIT_TEST( testTransferTo );
+        CPPUNIT_TEST( testTransferToStream );
+        CPPUNIT_TEST( testTransferFrom );
+        CPPUNIT_TEST( testClosed );
+        CPPUNIT_TEST_SUITE_END();
+
+    private:
+
+        std::string path;
+        std::string otherPath;
+
+    public:
+
+        FileChannelTest();
+        virtual ~FileChannelTest();
+
+        virtual void setUp();
+        virtual void tearDown();
+
+        void testOpen();
+        void testReadWrite();
+        void testPositionalReadWrite();
+        void testTruncate();
+        void testMapReadWrite();
+        void testMapReadOnly();
+        void testMapUnalignedPosition();
+        void testMappedBufferOutlivesChannel();
+        void testMapUsesOpenFile();
+        void testTransferTo();
+        void testTransferToStream();
+        void testTransferFrom();
+        void testClosed();
+
+    };
+
+}}}
+
+#endif /* _DECAF_NIO_CHANNELS_FILECHANNELTEST_H_ */
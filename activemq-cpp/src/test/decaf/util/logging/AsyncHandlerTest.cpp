@@ -0,0 +1,356 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AsyncHandlerTest.h"
+
+#include <decaf/util/logging/AsyncHandler.h>
+#include <decaf/util/logging/Level.h>
+#include <decaf/util/logging/LogRecord.h>
+#include <decaf/util/concurrent/Concurrent.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::logging;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class RecordingHandler : public Handler {
+    private:
+
+        RecordingHandler(const RecordingHandler&);
+        RecordingHandler& operator= (const RecordingHandler&);
+
+    public:
+
+        Mutex lock;
+        std::vector<std::string> messages;
+        CountDownLatch entered;
+        CountDownLatch* gate;
+        bool closed;
+
+    public:
+
+        RecordingHandler(CountDownLatch* gate = NULL) :
+            Handler(), lock(), messages(), entered(1), gate(gate), closed(false) {
+        }
+
+        virtual ~RecordingHandler() {}
+
+        virtual void close() {
+            this->closed = true;
+        }
+
+        virtual void flush() {
+        }
+
+        virtual void publish(const LogRecord& record) {
+
+            this->entered.countDown();
+            if (this->gate != NULL) {
+                this->gate->await();
+            }
+
+            synchronized(&this->lock) {
+                this->messages.push_back(record.getMessage());
+            }
+        }
+
+        std::vector<std::string> getMessages() {
+            std::vector<std::string> result;
+            synchronized(&this->lock) {
+                result = this->messages;
+            }
+            return result;
+        }
+    };
+
+    void publish(Handler& handler, const std::string& message, const Level& level = Level::INFO) {
+        LogRecord record;
+        record.setLevel(level);
+        record.setMessage(message);
+        handler.publish(record);
+    }
+
+    class Publisher : public Runnable {
+    private:
+
+        Handler* handler;
+        std::string prefix;
+        int count;
+
+    public:
+
+        Publisher(Handler* handler, const std::string& prefix, int count) :
+            Runnable(), handler(handler), prefix(prefix), count(count) {
+        }
+
+        virtual ~Publisher() {}
+
+        virtual void run() {
+            for (int i = 0; i < count; ++i) {
+                publish(*handler, prefix + Integer::toString(i));
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+AsyncHandlerTest::AsyncHandlerTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+AsyncHandlerTest::~AsyncHandlerTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandlerTest::testConstructor() {
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a NullPointerException",
+        AsyncHandler(NULL),
+        NullPointerException);
+
+    RecordingHandler* target = new RecordingHandler();
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        AsyncHandler(target, 0),
+        IllegalArgumentException);
+    delete target;
+
+    AsyncHandler handler(new RecordingHandler(), 100, AsyncHandler::SAMPLE);
+    CPPUNIT_ASSERT_EQUAL(128, handler.getCapacity());
+    CPPUNIT_ASSERT_EQUAL(AsyncHandler::SAMPLE, handler.getOverflowPolicy());
+    CPPUNIT_ASSERT_EQUAL(AsyncHandler::DEFAULT_SAMPLE_RATE, handler.getSampleRate());
+    CPPUNIT_ASSERT(handler.getTarget() != NULL);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        handler.setSampleRate(0),
+        IllegalArgumentException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandlerTest::testPublishAndFlush() {
+
+    RecordingHandler* target = new RecordingHandler();
+    AsyncHandler handler(target);
+
+    for (int i = 0; i < 100; ++i) {
+        publish(handler, Integer::toString(i));
+    }
+
+    handler.flush();
+
+    std::vector<std::string> messages = target->getMessages();
+    CPPUNIT_ASSERT_EQUAL(100, (int) messages.size());
+    for (int i = 0; i < 100; ++i) {
+        CPPUNIT_ASSERT_EQUAL(Integer::toString(i), messages[i]);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(100LL, handler.getPublishedCount());
+    CPPUNIT_ASSERT_EQUAL(100LL, handler.getWrittenCount());
+    CPPUNIT_ASSERT_EQUAL(0LL, handler.getDroppedCount());
+    CPPUNIT_ASSERT_EQUAL(0, handler.getPendingCount());
+
+    // Records below the handler's level never reach the ring.
+    handler.setLevel(Level::WARNING);
+    publish(handler, "filtered");
+    handler.flush();
+    CPPUNIT_ASSERT_EQUAL(100LL, handler.getPublishedCount());
+    CPPUNIT_ASSERT_EQUAL(0LL, handler.getDroppedCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandlerTest::testDropWhenFull() {
+
+    CountDownLatch gate(1);
+    RecordingHandler* target = new RecordingHandler(&gate);
+    AsyncHandler handler(target, 4, AsyncHandler::DROP);
+
+    // The first record holds its slot while the writer is stuck in the target.
+    publish(handler, "0");
+    target->entered.await();
+
+    for (int i = 1; i < 10; ++i) {
+        publish(handler, Integer::toString(i));
+    }
+
+    CPPUNIT_ASSERT_EQUAL(4LL, handler.getPublishedCount());
+    CPPUNIT_ASSERT_EQUAL(6LL, handler.getDroppedCount());
+    CPPUNIT_ASSERT_EQUAL(4, handler.getPendingCount());
+
+    gate.countDown();
+    handler.flush();
+
+    std::vector<std::string> messages = target->getMessages();
+    CPPUNIT_ASSERT_EQUAL(4, (int) messages.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("3"), messages[3]);
+    CPPUNIT_ASSERT_EQUAL(4LL, handler.getWrittenCount());
+    CPPUNIT_ASSERT_EQUAL(0LL, handler.getBlockedCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandlerTest::testBlockWhenFull() {
+
+    CountDownLatch gate(1);
+    RecordingHandler* target = new RecordingHandler(&gate);
+    AsyncHandler handler(target, 2, AsyncHandler::BLOCK);
+
+    publish(handler, "0");
+    target->entered.await();
+    publish(handler, "1");
+
+    Publisher publisher(&handler, "", 4);
+    Thread thread(&publisher);
+    thread.start();
+
+    for (int i = 0; i < 100 && handler.getBlockedCount() == 0; ++i) {
+        Thread::sleep(20);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(1LL, handler.getBlockedCount());
+    CPPUNIT_ASSERT_EQUAL(2LL, handler.getPublishedCount());
+
+    gate.countDown();
+    thread.join();
+    handler.flush();
+
+    std::vector<std::string> messages = target->getMessages();
+    CPPUNIT_ASSERT_EQUAL(6, (int) messages.size());
+    CPPUNIT_ASSERT_EQUAL(6LL, handler.getWrittenCount());
+    CPPUNIT_ASSERT_EQUAL(0LL, handler.getDroppedCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandlerTest::testSampleWhenBacklogged() {
+
+    CountDownLatch gate(1);
+    RecordingHandler* target = new RecordingHandler(&gate);
+    AsyncHandler handler(target, 8, AsyncHandler::SAMPLE);
+    handler.setSampleRate(3);
+
+    publish(handler, "0");
+    target->entered.await();
+
+    // Everything is kept until the ring is half full.
+    for (int i = 1; i < 4; ++i) {
+        publish(handler, Integer::toString(i));
+    }
+    CPPUNIT_ASSERT_EQUAL(4LL, handler.getPublishedCount());
+    CPPUNIT_ASSERT_EQUAL(0LL, handler.getDroppedCount());
+
+    // Then only one in three.
+    for (int i = 4; i < 13; ++i) {
+        publish(handler, Integer::toString(i));
+    }
+    CPPUNIT_ASSERT_EQUAL(7LL, handler.getPublishedCount());
+    CPPUNIT_ASSERT_EQUAL(6LL, handler.getDroppedCount());
+
+    // Severe records bypass sampling but still need a free slot.
+    publish(handler, "severe-1", Level::SEVERE);
+    publish(handler, "severe-2", Level::SEVERE);
+    CPPUNIT_ASSERT_EQUAL(8LL, handler.getPublishedCount());
+    CPPUNIT_ASSERT_EQUAL(7LL, handler.getDroppedCount());
+
+    gate.countDown();
+    handler.flush();
+
+    std::vector<std::string> messages = target->getMessages();
+    CPPUNIT_ASSERT_EQUAL(8, (int) messages.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("4"), messages[4]);
+    CPPUNIT_ASSERT_EQUAL(std::string("7"), messages[5]);
+    CPPUNIT_ASSERT_EQUAL(std::string("10"), messages[6]);
+    CPPUNIT_ASSERT_EQUAL(std::string("severe-1"), messages[7]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandlerTest::testClose() {
+
+    RecordingHandler* target = new RecordingHandler();
+    AsyncHandler handler(target);
+
+    for (int i = 0; i < 10; ++i) {
+        publish(handler, Integer::toString(i));
+    }
+
+    handler.close();
+    CPPUNIT_ASSERT(target->closed);
+    CPPUNIT_ASSERT_EQUAL(10, (int) target->getMessages().size());
+    CPPUNIT_ASSERT_EQUAL(10LL, handler.getWrittenCount());
+
+    publish(handler, "late");
+    handler.flush();
+    CPPUNIT_ASSERT_EQUAL(10, (int) target->getMessages().size());
+    CPPUNIT_ASSERT_EQUAL(1LL, handler.getDroppedCount());
+
+    CPPUNIT_ASSERT_NO_THROW(handler.close());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncHandlerTest::testMultipleProducers() {
+
+    static const int PRODUCERS = 4;
+    static const int COUNT = 1000;
+
+    RecordingHandler* target = new RecordingHandler();
+    AsyncHandler handler(target, 16, AsyncHandler::BLOCK);
+
+    std::vector<Publisher*> publishers;
+    std::vector<Thread*> threads;
+    for (int i = 0; i < PRODUCERS; ++i) {
+        publishers.push_back(new Publisher(&handler, Integer::toString(i) + ":", COUNT));
+        threads.push_back(new Thread(publishers.back()));
+        threads.back()->start();
+    }
+
+    for (int i = 0; i < PRODUCERS; ++i) {
+        threads[i]->join();
+        delete threads[i];
+        delete publishers[i];
+    }
+
+    handler.flush();
+
+    CPPUNIT_ASSERT_EQUAL((long long) PRODUCERS * COUNT, handler.getWrittenCount());
+    CPPUNIT_ASSERT_EQUAL(0LL, handler.getDroppedCount());
+
+    // Each producer's records come out in the order it published them.
+    std::vector<int> next(PRODUCERS, 0);
+    std::vector<std::string> messages = target->getMessages();
+    for (std::size_t i = 0; i < messages.size(); ++i) {
+        std::size_t split = messages[i].find(':');
+        int producer = Integer::parseInt(messages[i].substr(0, split));
+        int sequence = Integer::parseInt(messages[i].substr(split + 1));
+        CPPUNIT_ASSERT_EQUAL(next[producer], sequence);
+        next[producer]++;
+    }
+}
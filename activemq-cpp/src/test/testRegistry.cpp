@@ -44,6 +44,8 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::commands::ActiveMQBytesMessageTest );
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::commands::ActiveMQStreamMessageTest );
 #include <activemq/commands/XATransactionIdTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::commands::XATransactionIdTest );
+#include <activemq/commands/MessageIdTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::commands::MessageIdTest );
 
 #include <activemq/wireformat/openwire/marshal/BaseDataStreamMarshallerTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::openwire::marshal::BaseDataStreamMarshallerTest );
@@ -52,6 +54,10 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::openwire::marshal::Primit
 
 #include <activemq/wireformat/openwire/utils/BooleanStreamTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::openwire::utils::BooleanStreamTest );
+#include <activemq/wireformat/openwire/utils/FrameReaderTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::openwire::utils::FrameReaderTest );
+#include <activemq/wireformat/openwire/utils/FrameWriterTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::openwire::utils::FrameWriterTest );
 #include <activemq/wireformat/openwire/utils/HexTableTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::openwire::utils::HexTableTest );
 #include <activemq/wireformat/openwire/utils/MessagePropertyInterceptorTest.h>
@@ -60,6 +66,8 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::openwire::utils::MessageP
 #include <activemq/wireformat/openwire/OpenWireFormatTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::openwire::OpenWireFormatTest );
 
+#include <activemq/wireformat/stomp/StompFrameTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::stomp::StompFrameTest );
 #include <activemq/wireformat/stomp/StompHelperTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::stomp::StompHelperTest );
 #include <activemq/wireformat/stomp/StompWireFormatTest.h>
@@ -75,6 +83,8 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::cmsutil::CmsDestinationAccessorTest )
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::cmsutil::CmsTemplateTest );
 #include <activemq/cmsutil/DynamicDestinationResolverTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::cmsutil::DynamicDestinationResolverTest );
+#include <activemq/cmsutil/PooledConnectionFactoryTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::cmsutil::PooledConnectionFactoryTest );
 #include <activemq/cmsutil/SessionPoolTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::cmsutil::SessionPoolTest );
 
@@ -92,6 +102,12 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::SimplePriorityMessageDispatchCh
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::ActiveMQMessageAuditTest );
 #include <activemq/core/ConnectionAuditTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::ConnectionAuditTest );
+#include <activemq/core/MessageSpoolTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::MessageSpoolTest );
+#include <activemq/core/AdaptivePrefetchControllerTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::AdaptivePrefetchControllerTest );
+#include <activemq/core/ParallelDispatcherTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::ParallelDispatcherTest );
 
 #include <activemq/state/ConnectionStateTrackerTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::state::ConnectionStateTrackerTest );
@@ -108,6 +124,8 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::state::TransactionStateTest );
 
 #include <activemq/transport/failover/FailoverTransportTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::failover::FailoverTransportTest );
+#include <activemq/transport/failover/URILatencyTrackerTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::failover::URILatencyTrackerTest );
 
 #include <activemq/transport/tcp/TcpTransportTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::tcp::TcpTransportTest );
@@ -120,6 +138,8 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::mock::MockTransportFactory
 
 #include <activemq/transport/inactivity/InactivityMonitorTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::inactivity::InactivityMonitorTest );
+#include <activemq/transport/logging/LoggingTransportTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::logging::LoggingTransportTest );
 
 #include <activemq/transport/TransportRegistryTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::TransportRegistryTest );
@@ -133,6 +153,8 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::exceptions::ActiveMQExceptionTest );
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::util::AdvisorySupportTest );
 #include <activemq/util/ActiveMQMessageTransformationTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::util::ActiveMQMessageTransformationTest );
+#include <activemq/util/BlockSequenceGeneratorTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::util::BlockSequenceGeneratorTest );
 #include <activemq/util/IdGeneratorTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::util::IdGeneratorTest );
 #include <activemq/util/LongSequenceGeneratorTest.h>
@@ -151,6 +173,14 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::util::URISupportTest );
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::util::MemoryUsageTest );
 #include <activemq/util/MarshallingSupportTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::util::MarshallingSupportTest );
+#include <activemq/util/LatencyHistogramTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::util::LatencyHistogramTest );
+#include <activemq/util/MetricsRegistryTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::util::MetricsRegistryTest );
+#include <activemq/util/IdPrefixTableTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::util::IdPrefixTableTest );
+#include <activemq/util/PropertyNameTableTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::util::PropertyNameTableTest );
 
 #include <activemq/threads/SchedulerTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::threads::SchedulerTest );
@@ -186,6 +216,8 @@ CPPUNIT_TEST_SUITE_REGISTRATION( decaf::internal::nio::LongArrayBufferTest );
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::internal::nio::IntArrayBufferTest );
 #include <decaf/internal/nio/ShortArrayBufferTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::internal::nio::ShortArrayBufferTest );
+#include <decaf/internal/nio/MappedFileTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::internal::nio::MappedFileTest );
 
 #include <decaf/internal/net/URIEncoderDecoderTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::internal::net::URIEncoderDecoderTest );
@@ -194,6 +226,8 @@ CPPUNIT_TEST_SUITE_REGISTRATION( decaf::internal::net::URIHelperTest );
 
 #include <decaf/nio/BufferTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::nio::BufferTest );
+#include <decaf/nio/channels/FileChannelTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::nio::channels::FileChannelTest );
 
 #include <decaf/io/InputStreamTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::io::InputStreamTest );
@@ -332,6 +366,9 @@ CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::concurrent::locks::ReentrantLockTe
 #include <decaf/util/concurrent/locks/ReentrantReadWriteLockTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::concurrent::locks::ReentrantReadWriteLockTest );
 
+#include <decaf/util/logging/AsyncHandlerTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::logging::AsyncHandlerTest );
+
 #include <decaf/util/CollectionsTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::CollectionsTest );
 #include <decaf/util/HashCodeTest.h>